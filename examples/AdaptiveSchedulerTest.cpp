@@ -0,0 +1,253 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "../include/sequencer/AdaptiveSequencer.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Adaptive sequencer scheduling test
+ *
+ * Checks the beat-keyed event heap (ordering, relative scheduling, events
+ * scheduled from listeners, cancellation), the audio-thread queue that
+ * defers listeners, sample-clock timing through processBlock(), and that parameter changes only re-evaluate the
+ * transitions that depend on them. Ends with tick and evaluation cost.
+ */
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+void testEventHeap() {
+    std::cout << "\n=== Event scheduling ===" << std::endl;
+
+    EventSystem events;
+    std::vector<std::string> fired;
+    auto record = [&fired](const std::string& name, const EventSystem::EventData& data) {
+        auto it = data.find("n");
+        fired.push_back(it != data.end() ? name + std::to_string(static_cast<int>(it->second)) : name);
+    };
+    events.addListener("a", record);
+    events.addListener("b", record);
+
+    const int a = events.getEventId("a");
+    const int b = events.getEventId("b");
+    check(a != b && events.getEventId("a") == a, "Event names intern to stable IDs");
+
+    events.scheduleEventAt(a, 3.0, {{"n", 3}});
+    events.scheduleEventAt(b, 1.0, {{"n", 1}});
+    events.scheduleEventAt(a, 2.0, {{"n", 1}});
+    events.scheduleEventAt(b, 2.0, {{"n", 2}});
+
+    events.processTick(1.5);
+    check(fired.size() == 1 && fired[0] == "b1", "Only events at or before the tick fire");
+
+    events.processTick(2.0);
+    check(fired.size() == 3 && fired[1] == "a1" && fired[2] == "b2", "Equal beats fire in schedule order");
+
+    events.scheduleEvent("b", 0.5f);
+    events.processTick(2.4);
+    check(fired.size() == 3, "Relative delay counts from the last tick");
+    events.processTick(2.5);
+    check(fired.size() == 4 && fired[3] == "b", "...and fires when reached");
+
+    // A listener that reschedules itself fires once per tick, not in a loop
+    int repeats = 0;
+    events.addListener("repeat", [&](const std::string&, const EventSystem::EventData&) {
+        ++repeats;
+        events.scheduleEvent("repeat", 0.0f);
+    });
+    events.scheduleEvent("repeat", 0.0f);
+    events.processTick(2.5);
+    events.processTick(2.6);
+    check(repeats == 2, "Events scheduled by listeners wait for the next tick");
+
+    events.cancelScheduledEvents("repeat");
+    events.cancelScheduledEvents("a");
+    events.processTick(10.0);
+    check(repeats == 2 && fired.size() == 4 && events.getScheduledEventCount() == 0,
+          "Cancelled events never fire");
+}
+
+void testAudioQueue() {
+    std::cout << "\n=== Audio-thread queue ===" << std::endl;
+
+    EventSystem events;
+    std::vector<int> fired;
+    events.addListener("note", [&fired](const std::string&, const EventSystem::EventData& data) {
+        fired.push_back(static_cast<int>(data.at("n")));
+    });
+    const int id = events.getEventId("note");
+
+    const int count = 300;
+    for (int i = 0; i < count; ++i) {
+        events.scheduleEventAt(id, 1.0, {{"n", static_cast<float>(i)}});
+    }
+
+    const size_t queued = events.collectDue(1.0);
+    check(queued > 0 && queued < static_cast<size_t>(count) && fired.empty(),
+          "collectDue() queues due events without running listeners");
+    check(events.getScheduledEventCount() == count - queued, "Events beyond the queue's capacity stay scheduled");
+
+    check(events.dispatchPending() == queued && fired.size() == queued, "dispatchPending() runs the queued listeners");
+    check(events.collectDue(1.0) == count - queued && events.dispatchPending() == count - queued,
+          "The rest are queued on the next block");
+
+    bool ordered = fired.size() == static_cast<size_t>(count);
+    for (int i = 0; ordered && i < count; ++i) {
+        ordered = fired[i] == i;
+    }
+    check(ordered, "Queued events keep their schedule order and data");
+}
+
+void testSampleClock() {
+    std::cout << "\n=== Sample clock ===" << std::endl;
+
+    AdaptiveSequencer sequencer;
+    sequencer.setSampleRate(48000.0);
+    sequencer.setTempo(120.0f);  // 24000 samples per beat
+
+    bool fired = false;
+    sequencer.addEventListener("downbeat", [&fired](const std::string&, const EventSystem::EventData&) {
+        fired = true;
+    });
+
+    sequencer.play();
+    sequencer.scheduleEvent("downbeat", 4.0f);
+
+    const int blockSize = 512;
+    uint64_t blockEnd = 0;
+    bool firedInBlock = false;
+    while (!fired && blockEnd < 200000) {
+        sequencer.processBlock(blockSize);
+        blockEnd += blockSize;
+        firedInBlock = firedInBlock || fired;
+        sequencer.dispatchEvents();
+    }
+    check(!firedInBlock, "processBlock() leaves listeners to dispatchEvents()");
+    uint64_t firedAt = fired ? blockEnd : 0;
+    check(firedAt >= 96000 && firedAt < 96000 + blockSize,
+          "Beat 4 event fires in the block containing sample 96000 (block ending " + std::to_string(firedAt) + ")");
+    check(sequencer.getSamplePosition() == blockEnd && std::abs(sequencer.getCurrentBeat() - blockEnd / 24000.0) < 1e-9,
+          "Beat position tracks the sample count exactly");
+
+    sequencer.stop();
+    check(sequencer.getSamplePosition() == 0 && sequencer.getCurrentBeat() == 0.0, "Stop rewinds the clock");
+    sequencer.processBlock(blockSize);
+    check(sequencer.getSamplePosition() == 0, "Stopped sequencer does not advance");
+}
+
+struct TransitionFixture {
+    std::shared_ptr<MusicState> from = std::make_shared<MusicState>("from");
+    std::shared_ptr<MusicState> to = std::make_shared<MusicState>("to");
+    std::vector<std::shared_ptr<Parameter>> params;
+    TransitionManager manager;
+
+    explicit TransitionFixture(int count) {
+        for (int i = 0; i < count; ++i) {
+            auto param = std::make_shared<Parameter>("p" + std::to_string(i));
+            from->addParameter(param);
+            params.push_back(param);
+
+            auto transition = std::make_shared<StateTransition>("t" + std::to_string(i), from, to);
+            transition->setCondition(param->getName(), 0.5f, true);
+            manager.addTransition(transition);
+        }
+    }
+};
+
+void testTransitionIndex() {
+    std::cout << "\n=== Transition conditions ===" << std::endl;
+
+    TransitionFixture fixture(200);
+    TransitionManager& manager = fixture.manager;
+
+    uint64_t before = manager.getConditionEvaluationCount();
+    check(manager.findTriggeredTransition(fixture.from) == nullptr &&
+          manager.getConditionEvaluationCount() - before == 200, "First scan evaluates every transition");
+
+    before = manager.getConditionEvaluationCount();
+    check(manager.findTriggeredTransition(fixture.from) == nullptr &&
+          manager.getConditionEvaluationCount() == before, "No parameter change, nothing evaluated");
+
+    fixture.params[7]->setValue(0.3f);
+    fixture.params[9]->setValue(0.2f);
+    fixture.params[9]->setValue(0.4f);
+    before = manager.getConditionEvaluationCount();
+    check(manager.findTriggeredTransition(fixture.from) == nullptr &&
+          manager.getConditionEvaluationCount() - before == 2, "Changes re-evaluate only dependent transitions");
+
+    fixture.params[42]->setValue(0.9f);
+    auto triggered = manager.findTriggeredTransition(fixture.from);
+    check(triggered && triggered->getName() == "t42", "Satisfied condition triggers its transition");
+
+    fixture.params[43]->setValue(0.9f);
+    check(manager.findTriggeredTransition(fixture.to) == nullptr, "Transitions out of other states are skipped");
+
+    before = manager.getConditionEvaluationCount();
+    auto full = manager.findTriggeredTransition(fixture.from, true);
+    check(full && manager.getConditionEvaluationCount() - before <= 200, "Full scan on request (state change)");
+
+    Parameter shared("p7");
+    check(shared.getId() == fixture.params[7]->getId(), "Parameters with the same name share an interned ID");
+}
+
+void testCost() {
+    std::cout << "\n=== Cost ===" << std::endl;
+
+    EventSystem events;
+    int sink = 0;
+    events.addListener("tick", [&sink](const std::string&, const EventSystem::EventData&) { ++sink; });
+    const int id = events.getEventId("tick");
+
+    // 10k pending events, one due per tick
+    const int pending = 10000;
+    for (int i = 0; i < pending; ++i) {
+        events.scheduleEventAt(id, static_cast<double>(i));
+    }
+    const int ticks = 5000;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        events.processTick(static_cast<double>(t));
+        events.scheduleEventAt(id, static_cast<double>(pending + t));
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::fixed << std::setprecision(0) << "Tick with " << pending << " pending events: "
+              << seconds * 1e9 / ticks << " ns (" << sink << " fired)" << std::endl;
+
+    TransitionFixture fixture(500);
+    fixture.manager.findTriggeredTransition(fixture.from);
+    const int changes = 20000;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < changes; ++i) {
+        fixture.params[i % 500]->setValue(static_cast<float>(i % 5) * 0.1f);
+        fixture.manager.findTriggeredTransition(fixture.from);
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Parameter change + transition check with 500 transitions: "
+              << seconds * 1e9 / changes << " ns" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Adaptive Scheduler Test ===" << std::endl;
+
+    testEventHeap();
+    testAudioQueue();
+    testSampleClock();
+    testTransitionIndex();
+    testCost();
+
+    std::cout << "\n" << (failures == 0 ? "All adaptive scheduler checks passed" : "Adaptive scheduler checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/*
+ * Allocation counter for tests that check a code path does not allocate
+ *
+ * Replaces the global operator new/delete family and counts every
+ * allocation in TestSupport::allocations (and the requested bytes in
+ * TestSupport::allocatedBytes). Replacement operators are
+ * program-wide, so include this from the test's main file only.
+ *
+ * All forms allocate and free through the two helpers below, and the
+ * operators are kept out of line: if the compiler inlined a delete into a
+ * caller it would see std::free() on a pointer from operator new and warn
+ * (-Wmismatched-new-delete).
+ */
+
+#if defined(__GNUC__)
+#define ALLOCATION_COUNTER_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define ALLOCATION_COUNTER_NOINLINE __declspec(noinline)
+#else
+#define ALLOCATION_COUNTER_NOINLINE
+#endif
+
+namespace TestSupport {
+
+inline std::atomic<size_t> allocations{0};
+inline std::atomic<size_t> allocatedBytes{0};
+
+inline void* countedAllocate(std::size_t size, std::size_t alignment) noexcept {
+    ++allocations;
+    allocatedBytes += size;
+    if (size == 0) {
+        size = 1;
+    }
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    // aligned_alloc needs the size to be a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+inline void* countedAllocateOrThrow(std::size_t size, std::size_t alignment) {
+    if (void* p = countedAllocate(size, alignment)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+inline void release(void* p) noexcept {
+    std::free(p);
+}
+
+} // namespace TestSupport
+
+ALLOCATION_COUNTER_NOINLINE void* operator new(std::size_t size) {
+    return TestSupport::countedAllocateOrThrow(size, 0);
+}
+
+ALLOCATION_COUNTER_NOINLINE void* operator new[](std::size_t size) {
+    return TestSupport::countedAllocateOrThrow(size, 0);
+}
+
+ALLOCATION_COUNTER_NOINLINE void* operator new(std::size_t size, std::align_val_t alignment) {
+    return TestSupport::countedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+ALLOCATION_COUNTER_NOINLINE void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return TestSupport::countedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+ALLOCATION_COUNTER_NOINLINE void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return TestSupport::countedAllocate(size, 0);
+}
+
+ALLOCATION_COUNTER_NOINLINE void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return TestSupport::countedAllocate(size, 0);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete(void* p) noexcept {
+    TestSupport::release(p);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete[](void* p) noexcept {
+    TestSupport::release(p);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete(void* p, std::size_t) noexcept {
+    TestSupport::release(p);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete[](void* p, std::size_t) noexcept {
+    TestSupport::release(p);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete(void* p, std::align_val_t) noexcept {
+    TestSupport::release(p);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete[](void* p, std::align_val_t) noexcept {
+    TestSupport::release(p);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    TestSupport::release(p);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    TestSupport::release(p);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete(void* p, const std::nothrow_t&) noexcept {
+    TestSupport::release(p);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    TestSupport::release(p);
+}
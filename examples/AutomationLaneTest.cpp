@@ -0,0 +1,324 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "../include/sequencer/AutomationLane.h"
+#include "../include/sequencer/MidiFile.h"
+#include "../include/sequencer/Sequencer.h"
+#include "../include/audio/ParameterStore.h"
+#include "AllocationCounter.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Automation lane test
+ *
+ * Checks that lanes render the same per-sample values as a direct lookup
+ * across blocks and loops, that a dense CC recording is thinned within its
+ * tolerance and punched into an existing curve, that playback drives a
+ * ParameterStore from the sequencer position while armed lanes stay quiet,
+ * and that lanes export as CC tracks. Ends with the cost of playing a dense
+ * lane with the cursor against a lookup per sample.
+ */
+
+namespace {
+
+using TestSupport::allocations;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+bool near(float a, float b, float tolerance = 1e-5f) {
+    return std::abs(a - b) <= tolerance;
+}
+
+using Shape = AutomationLane::Shape;
+
+// 60 BPM at 1 kHz: one beat is 1000 samples
+const int kSampleRate = 1000;
+const double kBeatsPerSample = 0.001;
+
+void testCurves() {
+    std::cout << "\n=== Curves and playback cursor ===" << std::endl;
+
+    AutomationLane lane("filter_cutoff");
+    lane.addPoint(1.0, 0.0f);
+    lane.addPoint(3.0, 1.0f, Shape::Step);
+    lane.addPoint(2.0, 0.5f);
+    lane.addPoint(4.0, 0.25f);
+    lane.addPoint(2.0, 0.75f);
+    lane.addPoint(5.0, 2.0f);
+    check(lane.getNumPoints() == 5 && lane.getPointBeat(1) == 2.0 && lane.getPointValue(1) == 0.75f,
+          "Points stay sorted; same beat replaces");
+    check(lane.getPointValue(4) == 1.0f, "Values clamp to the lane range");
+
+    check(lane.getValueAt(0.0) == 0.0f && lane.getValueAt(1.5) == 0.375f && lane.getValueAt(3.5) == 1.0f &&
+          lane.getValueAt(4.5) == 0.625f && lane.getValueAt(9.0) == 1.0f,
+          "Holds before and after, ramps on Linear, holds on Step");
+
+    // Render 6 beats in odd-sized blocks, then loop back to the start
+    bool exact = true;
+    std::vector<float> block(333);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int start = 0; start < 6000; start += 333) {
+            const int frames = std::min(333, 6000 - start);
+            lane.render(start * kBeatsPerSample, kBeatsPerSample, block.data(), frames);
+            for (int i = 0; i < frames; ++i) {
+                exact &= near(block[i], lane.getValueAt((start + i) * kBeatsPerSample));
+            }
+        }
+    }
+    check(exact, "Rendered blocks match the curve at every sample, across a loop");
+
+    lane.render(2.999, kBeatsPerSample, block.data(), 3);
+    check(near(block[0], 0.99975f) && block[1] == 1.0f && block[2] == 1.0f, "Points land on their sample");
+
+    check(lane.evaluate(4.5) == 0.625f && lane.evaluate(1.5) == 0.375f, "evaluate() seeks backwards");
+
+    lane.removePoints(2.0, 3.0);
+    check(lane.getNumPoints() == 3 && near(lane.getValueAt(2.5), 0.125f), "removePoints takes out a closed range");
+}
+
+void testRecording() {
+    std::cout << "\n=== Recording and thinning ===" << std::endl;
+
+    // 8 beats of a mod wheel at 1000 messages per beat: a slow sweep, a hold
+    // and a wobble, quantised to 7 bits like real CCs
+    std::vector<double> beats;
+    std::vector<float> values;
+    for (int i = 0; i <= 8000; ++i) {
+        const double beat = 1.0 + i * 0.001;
+        double value;
+        if (i < 3000) {
+            value = i / 3000.0;
+        } else if (i < 5000) {
+            value = 1.0;
+        } else {
+            value = 0.5 + 0.4 * std::sin((i - 5000) * 0.004);
+        }
+        beats.push_back(beat);
+        values.push_back(std::round(static_cast<float>(value) * 127.0f) / 127.0f);
+    }
+
+    const float tolerance = 1.0f / 127.0f;
+    AutomationRecorder recorder(tolerance);
+    AutomationLane lane("mod_wheel");
+    recorder.begin(1.0);
+    for (size_t i = 0; i < beats.size(); ++i) {
+        recorder.addValue(beats[i], values[i]);
+    }
+    check(recorder.getReceivedCount() == beats.size(), "Every change is received");
+    recorder.finish(9.0, lane);
+
+    float worst = 0.0f;
+    for (size_t i = 0; i < beats.size(); ++i) {
+        worst = std::max(worst, std::abs(lane.getValueAt(beats[i]) - values[i]));
+    }
+    check(worst <= tolerance + 1e-5f, "Every dropped change within tolerance (worst " + std::to_string(worst) + ")");
+    check(lane.getNumPoints() * 20 < beats.size(), std::to_string(beats.size()) + " changes kept as " +
+          std::to_string(lane.getNumPoints()) + " points");
+    std::cout << "Lane memory: " << lane.getMemoryUsage() << " bytes (unthinned "
+              << beats.size() * (sizeof(double) + sizeof(float) + 1) << ")" << std::endl;
+
+    // Punch a constant take into the middle of an existing ramp
+    AutomationLane ramp("volume");
+    ramp.addPoint(0.0, 0.0f);
+    ramp.addPoint(10.0, 1.0f);
+    recorder.setTolerance(0.0f);
+    recorder.begin(4.0);
+    recorder.addValue(4.5, 0.9f);
+    recorder.addValue(5.0, 0.9f);
+    recorder.addValue(5.0, 0.1f);
+    recorder.addValue(5.5, 0.1f);
+    recorder.finish(6.0, ramp);
+    check(near(ramp.getValueAt(3.0), 0.3f) && near(ramp.getValueAt(4.25), 0.4f), "Curve before the take holds to its first change");
+    check(ramp.getValueAt(4.75) == 0.9f && ramp.getValueAt(5.01) == 0.1f && ramp.getValueAt(5.8) == 0.1f,
+          "Same-beat changes become a step");
+    check(near(ramp.getValueAt(6.0), 0.6f) && near(ramp.getValueAt(8.0), 0.8f), "Existing curve resumes at the end of the take");
+}
+
+void testPlayer() {
+    std::cout << "\n=== Player ===" << std::endl;
+
+    ParameterStore store(64);
+    const int cutoff = store.addParameter("filter_cutoff", 0.5f);
+    const int resonance = store.addParameter("filter_resonance", 0.0f);
+
+    AutomationLane cutoffLane("filter_cutoff");
+    cutoffLane.addPoint(0.0, 0.0f);
+    cutoffLane.addPoint(4.0, 1.0f);
+
+    AutomationPlayer player(kSampleRate);
+    player.bindStore(&store);
+    player.prepare(100);
+    const int cutoffIndex = player.addLane(cutoffLane);
+    const int resonanceIndex = player.addLane(AutomationLane("filter_resonance"));
+    check(player.getLaneCount() == 2 && player.findLane("filter_resonance") == resonanceIndex,
+          "Lanes are found by parameter ID");
+
+    // 60 BPM: a 250-frame call covers a quarter beat in three chunks
+    player.process(1.0, 60.0, 250);
+    const float* buffer = player.getLaneBuffer(cutoffIndex);
+    check(buffer && near(buffer[49], (1.0f + 0.2f + 0.049f) / 4.0f), "Buffer holds the last chunk");
+    check(near(store.getValue(cutoff), 1.249f / 4.0f) && store.getValue(resonance) == 0.0f &&
+          !player.getLaneBuffer(resonanceIndex), "Store gets the block-end value; empty lanes are skipped");
+
+    // Driven by the sequencer position and tempo
+    Sequencer sequencer(120.0);
+    sequencer.setPositionInBeats(2.0);
+    player.process(sequencer, 100);
+    check(near(player.getLaneValue(cutoffIndex), (2.0f + 99 * 0.002f) / 4.0f), "Follows sequencer position and tempo");
+
+    // Record resonance while cutoff keeps playing
+    player.startRecording(resonanceIndex, 2.0);
+    player.startRecording(cutoffIndex, 2.0);
+    for (int i = 0; i <= 100; ++i) {
+        player.recordValue(resonanceIndex, 2.0 + i * 0.01, i * 0.01f);
+        player.recordValue(cutoffIndex, 2.0 + i * 0.01, 0.2f);
+    }
+    store.setValue(cutoff, 0.2f);
+    player.process(2.5, 60.0, 100);
+    check(store.getValue(cutoff) == 0.2f && !player.getLaneBuffer(cutoffIndex),
+          "An armed lane does not overwrite incoming changes");
+
+    // The transport loops back: the take so far is kept and a new one starts
+    player.recordValue(cutoffIndex, 1.0, 0.7f);
+    player.recordValue(cutoffIndex, 1.5, 0.7f);
+    player.stopRecording(cutoffIndex, 1.5);
+    player.stopRecording(resonanceIndex, 3.0);
+    const AutomationLane recorded = player.getLane(resonanceIndex);
+    check(!player.isRecording(resonanceIndex) && recorded.getNumPoints() == 2 && near(recorded.getValueAt(2.5), 0.5f),
+          "A linear take is thinned to its end points");
+    const AutomationLane looped = player.getLane(cutoffIndex);
+    check(near(looped.getValueAt(2.5), 0.2f) && near(looped.getValueAt(1.25), 0.7f),
+          "Looping while recording keeps both passes");
+
+    player.process(2.5, 60.0, 100);
+    check(near(store.getValue(resonance), 0.599f, 1e-3f) && near(store.getValue(cutoff), 0.2f),
+          "Recorded lanes play back");
+
+    player.editLane(resonanceIndex, [](AutomationLane& lane) { lane.clear(); lane.addPoint(0.0, 0.3f); });
+    player.process(2.5, 60.0, 100);
+    check(store.getValue(resonance) == 0.3f, "Edits apply at the next block");
+}
+
+void testExport() {
+    std::cout << "\n=== MIDI export ===" << std::endl;
+
+    Pattern pattern("Bass");
+    pattern.addNote(Note(36, 1.0f, 0.0, 1.0));
+
+    AutomationLane wheel("mod_wheel");
+    wheel.setMidiController(1, 2);
+    wheel.addPoint(0.0, 0.0f);
+    wheel.addPoint(1.0, 1.0f, Shape::Step);
+    wheel.addPoint(2.0, 0.5f);
+    AutomationLane unmapped("filter_cutoff");
+    unmapped.addPoint(0.0, 1.0f);
+
+    const std::string filename = "automation_lane_test.mid";
+    MidiFile midiFile;
+    check(midiFile.exportPatterns({&pattern}, {&wheel, &unmapped}, filename), "Export succeeds");
+
+    std::ifstream file(filename, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::remove(filename.c_str());
+
+    // Walk the chunks using their big-endian lengths
+    size_t pos = 14;
+    int tracks = 0;
+    bool lengthsValid = data.size() > 14 && data[11] == 3;
+    size_t lastTrack = 0;
+    while (lengthsValid && pos + 8 <= data.size()) {
+        const uint32_t length = (data[pos + 4] << 24) | (data[pos + 5] << 16) | (data[pos + 6] << 8) | data[pos + 7];
+        lengthsValid &= std::string(data.begin() + pos, data.begin() + pos + 4) == "MTrk";
+        lastTrack = pos + 8;
+        pos += 8 + length;
+        ++tracks;
+    }
+    check(lengthsValid && tracks == 3 && pos == data.size(), "Header and track lengths describe the file (3 tracks)");
+
+    // CC track: ramp 0 -> 127 over one beat, then 63
+    int controllerEvents = 0;
+    int firstValue = -1;
+    int lastValue = -1;
+    bool channelAndNumber = true;
+    for (size_t i = lastTrack; i + 2 < data.size(); ++i) {
+        if (data[i] == 0xB2) {
+            channelAndNumber &= data[i + 1] == 1;
+            if (firstValue < 0) firstValue = data[i + 2];
+            lastValue = data[i + 2];
+            ++controllerEvents;
+            i += 2;
+        }
+    }
+    check(channelAndNumber && firstValue == 0 && lastValue == 64 && controllerEvents > 40 && controllerEvents < 60,
+          "Lane written as CC 1 on channel 3 (" + std::to_string(controllerEvents) + " events)");
+}
+
+void testCost() {
+    std::cout << "\n=== Cost (1M-point lane, 256-sample blocks) ===" << std::endl;
+
+    // One point every 4 samples: an unthinned CC stream at 48 kHz
+    const double beatsPerSample = 120.0 / 60.0 / 48000.0;
+    AutomationLane dense("dense");
+    dense.reserve(1000000);
+    for (int i = 0; i < 1000000; ++i) {
+        dense.addPoint(i * 4 * beatsPerSample, 0.5f + 0.5f * std::sin(i * 0.001f));
+    }
+
+    const int blockSize = 256;
+    const int blocks = 4000;
+    std::vector<float> buffer(blockSize);
+    float sink = 0.0f;
+
+    size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < blocks; ++b) {
+        dense.render(b * blockSize * beatsPerSample, beatsPerSample, buffer.data(), blockSize);
+        sink += buffer[blockSize - 1];
+    }
+    const double cursorSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t allocated = allocations - before;
+    check(allocated == 0, "No allocations in render");
+
+    start = std::chrono::steady_clock::now();
+    for (int b = 0; b < blocks; ++b) {
+        for (int i = 0; i < blockSize; ++i) {
+            buffer[i] = dense.getValueAt((b * blockSize + i) * beatsPerSample);
+        }
+        sink += buffer[blockSize - 1];
+    }
+    const double lookupSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(1) << "Cursor render: " << cursorSeconds * 1e9 / blocks
+              << " ns per block; lookup per sample: " << lookupSeconds * 1e9 / blocks << " ns per block (checksum "
+              << sink << ")" << std::endl;
+    check(cursorSeconds < lookupSeconds, "Cursor playback is cheaper than searching every sample");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Automation Lane Test ===" << std::endl;
+
+    testCurves();
+    testRecording();
+    testPlayer();
+    testExport();
+    testCost();
+
+    std::cout << "\n" << (failures == 0 ? "All automation lane checks passed" : "Automation lane checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
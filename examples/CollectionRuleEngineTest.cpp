@@ -0,0 +1,172 @@
+#include <iostream>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../include/ai/CollectionRuleEngine.h"
+#include "../include/ai/PresetMLAnalyzer.h"
+#include "../include/ai/PresetRecommendationEngine.h"
+#include "../include/ai/SmartCollectionManager.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Smart collection membership test
+ *
+ * Checks that CollectionRuleEngine keeps membership current one preset at
+ * a time: re-indexing a preset reports exactly the collections it moved
+ * in or out of, manual collections wait for reevaluateCollection(), custom
+ * rules run once per update, and removal drops membership. Then checks
+ * that SmartCollectionManager refreshes the preset lists of every auto
+ * collection a re-index touches, including through updateCollection().
+ */
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+CollectionRule categoryRule(const std::string& category) {
+    CollectionRule rule;
+    rule.type = CollectionRule::Type::Category;
+    rule.operation = "equals";
+    rule.value = 0.0f;
+    rule.stringValue = category;
+    return rule;
+}
+
+SmartCollection makeCollection(const std::string& id, std::vector<CollectionRule> rules, bool autoUpdate = true) {
+    SmartCollection collection;
+    collection.id = id;
+    collection.name = id;
+    collection.rules = std::move(rules);
+    collection.autoUpdate = autoUpdate;
+    return collection;
+}
+
+PresetInfo makePreset(const std::string& path, const std::string& category) {
+    PresetInfo preset;
+    preset.name = path;
+    preset.filePath = path;
+    preset.category = category;
+    return preset;
+}
+
+bool contains(const std::vector<std::string>& ids, const std::string& id) {
+    return std::find(ids.begin(), ids.end(), id) != ids.end();
+}
+
+size_t memberCount(const CollectionRuleEngine& engine, const std::string& id) {
+    const PresetBitmap* members = engine.getMembers(id);
+    return members ? members->count() : 0;
+}
+
+void testIncrementalUpdates() {
+    std::cout << "\n=== Incremental membership ===" << std::endl;
+
+    CollectionRuleEngine engine;
+    const AudioFeatureVector features{};
+
+    int customCalls = 0;
+    CollectionRule custom;
+    custom.type = CollectionRule::Type::Custom;
+    custom.value = 0.0f;
+    custom.customEvaluator = [&customCalls](const PresetInfo& preset, const AudioFeatureVector&) {
+        ++customCalls;
+        return preset.name.find("wide") != std::string::npos;
+    };
+
+    engine.compileCollection(makeCollection("bass", {categoryRule("Bass")}));
+    engine.compileCollection(makeCollection("lead", {categoryRule("Lead")}));
+    engine.compileCollection(makeCollection("manual-bass", {categoryRule("Bass")}, false));
+    engine.compileCollection(makeCollection("wide", {custom}));
+
+    auto changed = engine.updatePreset(makePreset("p1", "Bass"), features);
+    check(changed.size() == 1 && contains(changed, "bass"), "New preset reports only the collection it joined");
+    check(memberCount(engine, "manual-bass") == 0, "Manual collection keeps its membership on update");
+
+    check(engine.reevaluateCollection("manual-bass") && memberCount(engine, "manual-bass") == 1,
+          "reevaluateCollection() brings the manual collection up to date");
+
+    check(engine.updatePreset(makePreset("p1", "Bass"), features).empty(), "Unchanged preset reports nothing");
+
+    changed = engine.updatePreset(makePreset("p1", "Lead"), features);
+    check(changed.size() == 2 && contains(changed, "bass") && contains(changed, "lead"),
+          "Recategorized preset reports the collection it left and the one it joined");
+    check(memberCount(engine, "bass") == 0 && memberCount(engine, "lead") == 1, "Bitmaps follow the move");
+
+    // A library of other presets is not re-evaluated when one preset changes
+    for (int i = 0; i < 1000; ++i) {
+        engine.updatePreset(makePreset("lib" + std::to_string(i), i % 2 ? "Bass" : "Pad"), features);
+    }
+    customCalls = 0;
+    changed = engine.updatePreset(makePreset("p1 wide", "Pad"), features);
+    check(customCalls == 1 && contains(changed, "wide"), "Custom rule runs once per updated preset, not per library");
+    check(memberCount(engine, "bass") == 500, "Library presets indexed into the right collection");
+
+    changed = engine.removePreset("lib1");
+    check(contains(changed, "bass") && memberCount(engine, "bass") == 499, "Removing a preset drops its membership");
+
+    std::vector<PresetInfo> remaining = {makePreset("p1", "Lead")};
+    changed = engine.retainPresets(remaining);
+    check(memberCount(engine, "bass") == 0 && memberCount(engine, "lead") == 1 &&
+          memberCount(engine, "wide") == 0 && engine.getPresetCount() == 1,
+          "retainPresets() removes everything else");
+}
+
+void testManagerRefresh() {
+    std::cout << "\n=== SmartCollectionManager refresh ===" << std::endl;
+
+    auto analyzer = std::make_shared<PresetMLAnalyzer>();
+    auto recommender = std::make_shared<PresetRecommendationEngine>(analyzer);
+    SmartCollectionManager manager(analyzer, recommender);
+
+    const std::string bassId = manager.createSmartCollection("Bass", "", {categoryRule("Bass")});
+    const std::string leadId = manager.createSmartCollection("Lead", "", {categoryRule("Lead")});
+
+    std::vector<PresetInfo> presets = {
+        makePreset("/presets/a.json", "Bass"),
+        makePreset("/presets/b.json", "Bass"),
+        makePreset("/presets/c.json", "Lead"),
+    };
+    manager.updateAllCollections(presets);
+
+    auto paths = [&manager](const std::string& id) {
+        const SmartCollection* collection = manager.getCollection(id);
+        return collection ? collection->presetPaths : std::vector<std::string>{};
+    };
+    check(paths(bassId).size() == 2 && paths(leadId).size() == 1, "Initial refresh lists every matching preset");
+
+    // Refreshing only the bass collection still moves b into lead's list
+    presets[1].category = "Lead";
+    check(manager.updateCollection(bassId, presets), "updateCollection() accepts a known collection");
+    check(paths(bassId).size() == 1, "Refreshed collection drops the recategorized preset");
+    check(paths(leadId).size() == 2 && contains(paths(leadId), "/presets/b.json"),
+          "Other auto collections changed by the re-index are refreshed too");
+
+    presets.push_back(makePreset("/presets/d.json", "Bass"));
+    auto listed = manager.addPresetToCollections(presets.back());
+    check(listed.size() == 1 && listed[0] == bassId && paths(bassId).size() == 2,
+          "addPresetToCollections() lists the new preset where it belongs");
+
+    manager.removePresetFromCollections("/presets/c.json");
+    check(paths(leadId).size() == 1 && !contains(paths(leadId), "/presets/c.json"),
+          "removePresetFromCollections() updates the lists");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Collection Rule Engine Test ===" << std::endl;
+
+    testIncrementalUpdates();
+    testManagerRefresh();
+
+    std::cout << "\n" << (failures == 0 ? "All collection rule engine checks passed"
+                                         : "Collection rule engine checks FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include "../include/ui/UIContext.h"
+#include "../include/ui/UIComponents.h"
+#include "../include/ui/PresetBrowserUIComponent.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Damage-tracked redraw benchmark
+ *
+ * Drives two identical 480x320 screens (16 knobs, a VU meter, a focused
+ * search box, a preset list and a status button) through the same script
+ * of value changes, hover, selection, list replacement and child removal.
+ * One context repaints only damaged regions, the other redraws every
+ * frame. After each frame the pixels that reached each panel must be
+ * identical; then both are timed on a steady knob + meter animation.
+ */
+
+namespace {
+
+constexpr int kWidth = 480;
+constexpr int kHeight = 320;
+constexpr int kBytesPerPixel = 4;
+
+// Records what a panel would show: the regions presented under damage
+// tracking, or the whole back buffer when it is flipped
+class PanelCapture : public DisplayManager {
+public:
+    std::vector<uint8_t> panel;
+
+    bool initialize(int width, int height) override {
+        panel.assign(static_cast<size_t>(width * height * kBytesPerPixel), 0);
+        return DisplayManager::initialize(width, height);
+    }
+
+    void swapBuffers() override {
+        if (!isDamageTracking()) {
+            std::memcpy(panel.data(), getFramebuffer(), panel.size());
+        }
+        DisplayManager::swapBuffers();
+    }
+
+protected:
+    void presentRegion(const Rect& rect) override {
+        const uint8_t* back = getFramebuffer();
+        size_t rowBytes = static_cast<size_t>(rect.width * kBytesPerPixel);
+        for (int y = rect.y; y < rect.y + rect.height; ++y) {
+            size_t offset = static_cast<size_t>((y * getWidth() + rect.x) * kBytesPerPixel);
+            std::memcpy(panel.data() + offset, back + offset, rowBytes);
+        }
+        DisplayManager::presentRegion(rect);
+    }
+};
+
+std::vector<PresetInfo> makePresets(const std::string& prefix, int count) {
+    std::vector<PresetInfo> presets;
+    for (int i = 0; i < count; ++i) {
+        PresetInfo preset;
+        preset.name = prefix + " " + std::to_string(i);
+        preset.category = i % 2 ? "Lead" : "Bass";
+        presets.push_back(preset);
+    }
+    return presets;
+}
+
+struct TestScreen {
+    UIContext context;
+    std::shared_ptr<PanelCapture> display;
+    Screen* screen = nullptr;
+    std::vector<Knob*> knobs;
+    VUMeter* meter = nullptr;
+    PresetListView* list = nullptr;
+
+    explicit TestScreen(bool damageTracking) {
+        context.initialize(kWidth, kHeight);
+        display = std::make_shared<PanelCapture>();
+        display->initialize(kWidth, kHeight);
+        display->setDamageTracking(damageTracking);
+        context.setDisplayManager(display);
+
+        auto newScreen = std::make_unique<Screen>("main");
+        newScreen->setSize(kWidth, kHeight);
+        newScreen->setBackgroundColor(Color(30, 30, 34));
+
+        for (int i = 0; i < 16; ++i) {
+            auto knob = std::make_unique<Knob>("knob" + std::to_string(i), "K" + std::to_string(i));
+            knob->setPosition(15 + (i % 4) * 70, 15 + (i / 4) * 75);
+            knob->setSize(50, 50);
+            knobs.push_back(knob.get());
+            newScreen->addChild(std::move(knob));
+        }
+
+        auto vu = std::make_unique<VUMeter>("meter");
+        vu->setPosition(300, 10);
+        vu->setSize(16, 300);
+        meter = vu.get();
+        newScreen->addChild(std::move(vu));
+
+        auto search = std::make_unique<PresetSearchBox>("search");
+        search->setPosition(330, 10);
+        search->setSize(140, 30);
+        newScreen->addChild(std::move(search));
+
+        auto presetList = std::make_unique<PresetListView>("list");
+        presetList->setPosition(330, 50);
+        presetList->setSize(140, 200);
+        presetList->setPresets(makePresets("Init", 12));
+        list = presetList.get();
+        newScreen->addChild(std::move(presetList));
+
+        auto status = std::make_unique<Button>("status", "READY");
+        status->setPosition(330, 270);
+        status->setSize(140, 20);
+        newScreen->addChild(std::move(status));
+
+        screen = newScreen.get();
+        context.addScreen(std::move(newScreen));
+        context.setActiveScreen("main");
+    }
+
+    void frame(float deltaTime) {
+        context.update(deltaTime);
+        context.render();
+    }
+};
+
+// The same change script for both screens; frame numbers pick the event
+void applyScript(TestScreen& test, int frame) {
+    test.knobs[frame % 16]->setValue(((frame * 37) % 100) / 100.0f);
+    test.meter->setLevel(((frame * 13) % 100) / 100.0f);
+
+    if (frame == 5) {
+        // Focus the search box so its cursor starts blinking
+        test.context.handleInput(InputEvent(InputEventType::TouchPress, 0, 340, 20));
+    }
+    if (frame % 10 == 3) {
+        // Hover moves down the list
+        test.context.handleInput(InputEvent(InputEventType::TouchMove, 1, 360, 55 + (frame / 10) % 6 * 30));
+    }
+    if (frame % 25 == 0) {
+        test.list->selectPreset((frame / 25) % 12);
+    }
+    if (frame == 50) {
+        test.list->setPresets(makePresets("Bank B", 3));
+    }
+    if (frame == 60) {
+        test.screen->removeChild("status");
+    }
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Damage-Tracked Redraw Benchmark ===" << std::endl;
+
+    TestScreen tracked(true);
+    TestScreen full(false);
+
+    // Identical output: compare the panels after every scripted frame
+    const float deltaTime = 1.0f / 60.0f;
+    const int scriptFrames = 120;
+    int mismatchedFrames = 0;
+    int firstMismatch = -1;
+    for (int frame = 0; frame < scriptFrames; ++frame) {
+        applyScript(tracked, frame);
+        applyScript(full, frame);
+        tracked.frame(deltaTime);
+        full.frame(deltaTime);
+        if (tracked.display->panel != full.display->panel) {
+            if (firstMismatch < 0) firstMismatch = frame;
+            ++mismatchedFrames;
+        }
+    }
+
+    bool ok = mismatchedFrames == 0;
+    std::cout << (ok ? "✅" : "❌") << " Damage-tracked panel matches full redraw: "
+              << scriptFrames - mismatchedFrames << "/" << scriptFrames << " frames identical";
+    if (!ok) {
+        std::cout << " (first difference at frame " << firstMismatch << ")";
+    }
+    std::cout << std::endl;
+
+    // Timing: one knob and the meter move each frame
+    auto timeFrames = [&](TestScreen& test) {
+        const int frames = 500;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            test.knobs[frame % 16]->setValue(((frame * 37) % 100) / 100.0f);
+            test.meter->setLevel(((frame * 13) % 100) / 100.0f);
+            test.frame(deltaTime);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / frames;
+    };
+
+    double fullMs = timeFrames(full);
+    double trackedMs = timeFrames(tracked);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\n=== " << kWidth << "x" << kHeight << ", 16 knobs + VU meter animating ===" << std::endl;
+    std::cout << "Full redraw:    " << fullMs << " ms/frame" << std::endl;
+    std::cout << "Damage-tracked: " << trackedMs << " ms/frame" << std::endl;
+    std::cout << (trackedMs < fullMs ? "✅" : "⚠️ ") << " Speedup: " << std::setprecision(1)
+              << fullMs / trackedMs << "x" << std::endl;
+
+    return ok ? 0 : 1;
+}
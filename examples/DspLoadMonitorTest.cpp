@@ -0,0 +1,233 @@
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/audio/DspLoadMonitor.h"
+#include "../include/audio/Synthesizer.h"
+#include "AllocationCounter.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * DSP load monitor test
+ *
+ * Checks that histogram buckets keep loads to within 1/64, that percentiles
+ * and near-miss counts match a known distribution of block loads, that
+ * subsystem time is reported as its own share of the deadline, that a
+ * reset lands at the next block, that recording a block allocates nothing,
+ * and that statistics can be read while the audio thread records. Reports
+ * the measured load distribution of a Synthesizer.
+ */
+
+namespace {
+
+using TestSupport::allocations;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+// Duration that is a given percentage of a block's deadline at 48 kHz
+std::chrono::nanoseconds loadOf(double percent, int numFrames) {
+    return std::chrono::nanoseconds(static_cast<int64_t>(percent / 100.0 * numFrames * 1e9 / 48000.0));
+}
+
+void testBuckets() {
+    std::cout << "\n=== Buckets ===" << std::endl;
+
+    bool exact = true;
+    for (uint32_t v = 0; v < 128; ++v) {
+        exact &= DspLoadMonitor::highestValueInBucket(DspLoadMonitor::bucketForValue(v)) == v;
+    }
+    check(exact, "Loads below 1.28% have a bucket each");
+
+    bool contained = true;
+    bool precise = true;
+    bool monotonic = true;
+    int previous = -1;
+    for (uint32_t v = 0; v <= DspLoadMonitor::kMaxValue; ++v) {
+        const int bucket = DspLoadMonitor::bucketForValue(v);
+        const uint32_t highest = DspLoadMonitor::highestValueInBucket(bucket);
+        contained &= highest >= v;
+        precise &= highest - v <= v / 64;
+        monotonic &= bucket == previous || bucket == previous + 1;
+        previous = bucket;
+    }
+    check(contained, "Every load falls at or below its bucket's highest value");
+    check(precise, "Bucket width stays within 1/64 of the load");
+    check(monotonic, "Buckets are contiguous and ordered");
+}
+
+void testDistribution() {
+    std::cout << "\n=== Distribution ===" << std::endl;
+
+    const int blockSize = 256;
+    DspLoadMonitor monitor(48000);
+
+    // 10000 blocks: 9000 at 40%, 900 at 70%, 85 at 85%, 10 at 95%, 5 at 120%
+    for (int i = 0; i < 9000; ++i) monitor.endBlock(loadOf(40.0, blockSize), blockSize);
+    for (int i = 0; i < 900; ++i) monitor.endBlock(loadOf(70.0, blockSize), blockSize);
+    for (int i = 0; i < 85; ++i) monitor.endBlock(loadOf(85.0, blockSize), blockSize);
+    for (int i = 0; i < 10; ++i) monitor.endBlock(loadOf(95.0, blockSize), blockSize);
+    for (int i = 0; i < 5; ++i) monitor.endBlock(loadOf(120.0, blockSize), blockSize);
+
+    const auto stats = monitor.getStatistics();
+    auto near = [](double value, double expected) { return value >= expected - 0.02 && value <= expected * 1.016 + 0.02; };
+
+    check(stats.blocks == 10000, "Every block is counted");
+    check(near(stats.p50, 40.0) && near(stats.p90, 40.0), "p50 and p90 are 40%");
+    check(near(stats.p99, 70.0), "p99 is 70% (" + std::to_string(stats.p99) + ")");
+    check(near(stats.p999, 95.0), "p99.9 is 95% (" + std::to_string(stats.p999) + ")");
+    check(near(stats.max, 120.0), "Max is 120%");
+    check(std::fabs(stats.mean - 43.18) < 0.05, "Mean is 43.18% (" + std::to_string(stats.mean) + ")");
+    check(stats.over80 == 100 && stats.over90 == 15 && stats.over100 == 5,
+          "Blocks above 80, 90 and 100% are counted");
+    check(std::fabs(monitor.getLastLoad() - 120.0f) < 0.1f, "The last block's load is kept");
+
+    // The deadline follows the block length
+    DspLoadMonitor varying(48000);
+    varying.endBlock(loadOf(50.0, 512), 128);
+    check(varying.getStatistics().over100 == 1, "A short block has a shorter deadline");
+}
+
+void testSubsystems() {
+    std::cout << "\n=== Subsystems ===" << std::endl;
+
+    const int blockSize = 128;
+    DspLoadMonitor monitor(48000);
+    const int synth = monitor.addSubsystem("synth");
+    const int effects = monitor.addSubsystem("effects");
+    check(synth == 0 && effects == 1 && monitor.addSubsystem("synth") == 0, "Subsystems are registered once by name");
+
+    for (int i = 0; i < 100; ++i) {
+        monitor.addSubsystemTime(synth, loadOf(30.0, blockSize));
+        monitor.addSubsystemTime(synth, loadOf(20.0, blockSize));
+        if (i % 2 == 0) {
+            monitor.addSubsystemTime(effects, loadOf(10.0, blockSize));
+        }
+        monitor.endBlock(loadOf(65.0, blockSize), blockSize);
+    }
+
+    const auto subsystems = monitor.getSubsystemStatistics();
+    check(subsystems.size() == 2 && subsystems[0].name == "synth" && subsystems[1].name == "effects",
+          "Subsystems are reported in registration order");
+    check(subsystems.size() == 2 && std::fabs(subsystems[0].load.p50 - 50.0) < 1.0,
+          "Time within a block adds up per subsystem");
+    check(subsystems.size() == 2 && subsystems[1].load.blocks == 100 && std::fabs(subsystems[1].load.mean - 5.0) < 0.5,
+          "Blocks where a subsystem is idle count as zero load");
+
+    int extra = 0;
+    for (int i = 0; i < DspLoadMonitor::kMaxSubsystems; ++i) {
+        extra = monitor.addSubsystem("extra " + std::to_string(i));
+    }
+    check(extra == -1, "Registration fails once all slots are used");
+
+    {
+        DspLoadMonitor::ScopedSubsystem scope(monitor, synth);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    monitor.endBlock(std::chrono::milliseconds(2), 48000);
+    check(monitor.getSubsystemStatistics()[0].load.max > 0.0, "A scoped subsystem records its time");
+
+    const std::string json = monitor.exportJson();
+    check(json.find("\"total\":{\"blocks\":101") != std::string::npos &&
+              json.find("\"synth\":{") != std::string::npos && json.find("\"buckets\":[[") != std::string::npos,
+          "Statistics and buckets export as JSON");
+}
+
+void testReset() {
+    std::cout << "\n=== Reset ===" << std::endl;
+
+    DspLoadMonitor monitor(48000);
+    const int synth = monitor.addSubsystem("synth");
+    for (int i = 0; i < 10; ++i) {
+        monitor.addSubsystemTime(synth, loadOf(50.0, 64));
+        monitor.endBlock(loadOf(110.0, 64), 64);
+    }
+
+    monitor.reset();
+    check(monitor.getStatistics().blocks == 10, "A reset waits for the audio thread");
+    monitor.endBlock(loadOf(20.0, 64), 64);
+    const auto stats = monitor.getStatistics();
+    check(stats.blocks == 1 && stats.over100 == 0 && stats.max < 21.0, "The next block starts from empty histograms");
+    check(monitor.getSubsystemStatistics()[0].load.blocks == 1, "Subsystem histograms are reset too");
+}
+
+void testRealtime() {
+    std::cout << "\n=== Audio thread ===" << std::endl;
+
+    DspLoadMonitor monitor(44100);
+    const int synthIndex = monitor.addSubsystem("synth");
+
+    // Record a real Synthesizer, reading statistics from another thread meanwhile
+    const int blockSize = 256;
+    const int blocks = 2000;
+    std::atomic<bool> done{false};
+    std::atomic<int> reads{0};
+    std::thread reader([&]() {
+        while (!done.load()) {
+            const auto stats = monitor.getStatistics();
+            if (stats.blocks > 0 && stats.p50 <= stats.max + 0.01) {
+                ++reads;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    });
+
+    Synthesizer synth(44100);
+    std::vector<float> buffer(blockSize * 2);
+    for (int note = 48; note < 60; ++note) {
+        synth.noteOn(note, 0.7f);
+    }
+
+    size_t allocated = 0;
+    double recordSeconds = 0.0;
+    for (int i = 0; i < blocks; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        {
+            DspLoadMonitor::ScopedSubsystem scope(monitor, synthIndex);
+            synth.process(buffer.data(), blockSize);
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        size_t before = allocations;
+        monitor.endBlock(end - start, blockSize);
+        allocated += allocations - before;
+        recordSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - end).count();
+    }
+    done.store(true);
+    reader.join();
+
+    check(allocated == 0, "Recording a block does not allocate");
+    check(reads.load() > 0, "Statistics can be read while blocks are recorded");
+
+    const auto stats = monitor.getStatistics();
+    check(stats.blocks == static_cast<uint64_t>(blocks), "Every Synthesizer block is recorded");
+    std::cout << std::fixed << std::setprecision(2) << "Synthesizer, 12 voices, " << blockSize
+              << " frames: mean " << stats.mean << "%, p50 " << stats.p50 << "%, p99 " << stats.p99
+              << "%, p99.9 " << stats.p999 << "%, max " << stats.max << "%, missed " << stats.over100 << std::endl;
+    std::cout << std::setprecision(1) << "Recording a block: " << recordSeconds * 1e9 / blocks << " ns" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== DSP Load Monitor Test ===" << std::endl;
+
+    testBuckets();
+    testDistribution();
+    testSubsystems();
+    testReset();
+    testRealtime();
+
+    std::cout << "\n" << (failures == 0 ? "All DSP load monitor checks passed" : "DSP load monitor checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -2,10 +2,24 @@
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <map>
+#include <set>
 #include "../include/ui/presets/PresetDatabase.h"
+#include "AllocationCounter.h"
 
 using namespace AIMusicHardware;
 
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+} // namespace
+
 /**
  * @brief Test the enhanced preset database with professional features
  * 
@@ -209,6 +223,91 @@ void testMetadataAnalysis(PresetDatabase& db) {
     }
 }
 
+void testColumnStore() {
+    std::cout << "\n=== Testing Columnar Store at Scale ===" << std::endl;
+    
+    PresetDatabase db;
+    const char* categories[] = {"Bass", "Lead", "Pad", "Keys", "FX"};
+    const int presetCount = 20000;
+    
+    // The same presets as whole PresetInfo objects keyed by path, the way
+    // the database held them before the column store
+    std::map<std::string, PresetInfo> objectLayout;
+    size_t objectBytes = 0;
+    
+    for (int i = 0; i < presetCount; ++i) {
+        PresetInfo info;
+        info.name = "Preset " + std::to_string(i);
+        info.filePath = "/library/" + std::string(categories[i % 5]) + "/" + info.name + ".json";
+        info.category = categories[i % 5];
+        info.author = "Author " + std::to_string(i % 40);
+        info.description = "Generated preset for scale testing";
+        info.tags = {"electronic", i % 2 ? "dark" : "bright"};
+        info.isFavorite = (i % 10) == 0;
+        info.userRating = i % 6;
+        info.audioCharacteristics.bassContent = (i % 100) / 100.0f;
+        for (int p = 0; p < 32; ++p) {
+            info.parameterData["param_" + std::to_string(p)] = p * 0.01f;
+        }
+        db.addPreset(info);
+        
+        const size_t before = TestSupport::allocatedBytes;
+        objectLayout.emplace(info.filePath, info);
+        objectBytes += TestSupport::allocatedBytes - before;
+    }
+    
+    size_t bytes = db.getMemoryUsage();
+    std::cout << "Stored " << presetCount << " presets in " << bytes / 1024 << " KB ("
+              << bytes / presetCount << " bytes/preset), " << objectBytes / 1024
+              << " KB as PresetInfo objects" << std::endl;
+    check(bytes * 2 < objectBytes, "Column store needs less than half the memory of PresetInfo objects");
+    
+    PresetFilterCriteria criteria;
+    criteria.categories = {"Bass", "Pad"};
+    criteria.searchText = "dark";
+    criteria.minRating = 2;
+    
+    std::set<std::string> expected;
+    for (int i = 0; i < presetCount; ++i) {
+        if ((i % 5 == 0 || i % 5 == 2) && i % 2 == 1 && i % 6 >= 2) {
+            expected.insert("Preset " + std::to_string(i));
+        }
+    }
+    
+    std::vector<PresetDatabase::PresetId> ids;
+    db.queryFilter(criteria, ids); // Warm up output buffer
+    
+    std::set<std::string> matched;
+    db.readStore([&](const PresetColumnStore& store) {
+        for (auto id : ids) {
+            matched.emplace(store.name(id));
+        }
+    });
+    check(ids.size() == expected.size() && matched == expected, "queryFilter() returns exactly the matching presets");
+    
+    const size_t allocationsBefore = TestSupport::allocations;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < 100; ++i) {
+        db.queryFilter(criteria, ids);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const size_t filterAllocations = TestSupport::allocations - allocationsBefore;
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    
+    std::cout << "100 ID filters over " << presetCount << " presets took: " << duration.count()
+              << " microseconds (" << ids.size() << " matches)" << std::endl;
+    check(filterAllocations == 0, "Repeated queryFilter() does not allocate");
+    
+    if (!ids.empty()) {
+        PresetInfo first = db.materialize(ids.front(), true);
+        check(first.parameterData.size() == 32, "Materialized preset keeps its parameters");
+        
+        auto listed = db.filter(criteria);
+        check(listed.size() == expected.size() && listed.front().parameterData.size() == 32,
+              "filter() returns the same presets with parameters");
+    }
+}
+
 void testStatistics(PresetDatabase& db) {
     std::cout << "\n=== Testing Statistics ===" << std::endl;
     
@@ -256,6 +355,13 @@ int main() {
         testMetadataAnalysis(db);
         testStatistics(db);
         testPerformance(db);
+        testColumnStore();
+        
+        if (failures > 0) {
+            std::cout << "\n=== Preset database checks FAILED ===" << std::endl;
+            std::filesystem::remove_all(testDir);
+            return 1;
+        }
         
         std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
         std::cout << "\nKey Features Demonstrated:" << std::endl;
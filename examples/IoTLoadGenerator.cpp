@@ -0,0 +1,441 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../include/iot/LoopbackBroker.h"
+#include "../include/iot/IoTParameterBridge.h"
+#include "../include/iot/IoTPayloadScanner.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * IoT load generator
+ *
+ * Simulates ESP32 sensor nodes publishing through the in-process loopback
+ * broker into the synth's IoT path (LoopbackIoTInterface -> IoTParameterBridge
+ * -> ParameterUpdateSystem -> simulated audio callback) and reports
+ * message->parameter latency percentiles and throughput.
+ *
+ * Latency is measured without tagging payloads: every node topic drives its
+ * own parameter, and that mapping's converter returns the per-topic message
+ * index instead of the sensor value (after parsing the payload as usual, so
+ * the parsing cost is still paid). The audio thread looks the index up in
+ * the publish time table, so the latency of each applied update is the age
+ * of the newest message it carries.
+ *
+ * Usage: IoTLoadGenerator [options]
+ *   --nodes N            simulated sensor nodes (default 8)
+ *   --rate HZ            messages per second per node (default 50)
+ *   --duration S         seconds of traffic (default 3)
+ *   --format F           firmware | json | csv | scalar (default firmware)
+ *   --control-rate HZ    bridge flush rate (default 200)
+ *   --block N            audio block size in samples at 48 kHz (default 256)
+ *   --replay FILE        replay "<time_ms> <topic> <payload>" lines instead
+ *   --speed X            replay speed multiplier (default 1)
+ *   --sweep              double --nodes until the budget is exceeded
+ *   --budget-ms MS       p99 latency budget for --sweep (default 20)
+ */
+
+namespace {
+
+struct Options {
+    int nodes = 8;
+    double rate = 50.0;
+    double duration = 3.0;
+    std::string format = "firmware";
+    float controlRate = 200.0f;
+    int blockSize = 256;
+    double sampleRate = 48000.0;
+    std::string replayFile;
+    double speed = 1.0;
+    bool sweep = false;
+    double budgetMs = 20.0;
+};
+
+struct Event {
+    uint64_t timeUs;
+    uint32_t topic;
+    uint32_t payload;
+};
+
+struct Traffic {
+    std::vector<std::string> topics;
+    std::vector<std::string> payloads;
+    std::vector<Event> events;         // Sorted by time
+    std::vector<uint32_t> publisherOf; // Publishing client per topic
+    size_t publishers = 1;
+};
+
+struct Result {
+    int nodes = 0;
+    double offeredRate = 0.0;
+    double ingestRate = 0.0;
+    uint64_t published = 0;
+    uint64_t ingested = 0;
+    uint64_t updates = 0;
+    uint64_t dropped = 0;
+    size_t maxBacklog = 0;
+    double p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;  // milliseconds
+};
+
+uint64_t nowUs() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+std::string firmwarePayload(int node, int variant) {
+    // Same document shape as publishSensorData() in firmware/esp32_sensor_node
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(2)
+         << "{\"device_id\":\"esp32_" << node << "\",\"timestamp\":" << 1000 * variant
+         << ",\"location\":\"studio\",\"environmental\":{\"temperature\":" << 21.0 + 0.1 * variant
+         << ",\"humidity\":" << 45.0 + variant << ",\"pressure\":1013.25,\"light\":" << 300 + 10 * variant
+         << "},\"motion\":{\"acceleration\":{\"x\":" << std::sin(variant * 0.7) << ",\"y\":" << std::cos(variant * 0.7)
+         << ",\"z\":9.81},\"gyroscope\":{\"x\":0.01,\"y\":-0.02,\"z\":0.00}},\"audio\":{\"level_db\":" << -30 + variant
+         << ",\"peak_frequency\":440},\"system\":{\"battery_voltage\":3.92,\"wifi_rssi\":-61,\"uptime\":" << 3600 + variant << "}}";
+    return json.str();
+}
+
+std::string syntheticPayload(const std::string& format, int node, int variant) {
+    double x = std::sin(variant * 0.7);
+    double y = std::cos(variant * 0.7);
+    std::ostringstream payload;
+    payload << std::fixed << std::setprecision(3);
+    if (format == "json") {
+        payload << "{\"x\":" << x << ",\"y\":" << y << ",\"z\":9.81}";
+    } else if (format == "csv") {
+        payload << x << "," << y << ",9.81";
+    } else if (format == "scalar") {
+        payload << 20.0 + x;
+    } else {
+        return firmwarePayload(node, variant);
+    }
+    return payload.str();
+}
+
+Traffic syntheticTraffic(const Options& options, int nodes) {
+    const int variants = 16;
+    Traffic traffic;
+    traffic.publishers = nodes;
+
+    for (int node = 0; node < nodes; ++node) {
+        traffic.topics.push_back("AIMusicHardware/sensors/esp32_" + std::to_string(node) + "/data");
+        traffic.publisherOf.push_back(node);
+        for (int v = 0; v < variants; ++v) {
+            traffic.payloads.push_back(syntheticPayload(options.format, node, v));
+        }
+    }
+
+    // Nodes are phase-offset across the period, as free-running devices are
+    double periodUs = 1e6 / options.rate;
+    size_t perNode = static_cast<size_t>(options.duration * options.rate);
+    for (size_t i = 0; i < perNode; ++i) {
+        for (int node = 0; node < nodes; ++node) {
+            uint64_t t = static_cast<uint64_t>(i * periodUs + periodUs * node / nodes);
+            traffic.events.push_back(Event{t, static_cast<uint32_t>(node),
+                                           static_cast<uint32_t>(node * variants + i % variants)});
+        }
+    }
+    std::sort(traffic.events.begin(), traffic.events.end(),
+              [](const Event& a, const Event& b) { return a.timeUs < b.timeUs; });
+    return traffic;
+}
+
+bool replayTraffic(const Options& options, Traffic& traffic) {
+    std::ifstream file(options.replayFile);
+    if (!file) {
+        std::cerr << "Cannot open replay file " << options.replayFile << std::endl;
+        return false;
+    }
+
+    std::unordered_map<std::string, uint32_t> topicIndex;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        double timeMs = 0.0;
+        std::string topic;
+        if (!(fields >> timeMs >> topic)) {
+            continue;
+        }
+        std::string payload;
+        std::getline(fields, payload);
+        payload = std::string(IoTPayloadScanner::trim(payload));
+
+        auto it = topicIndex.find(topic);
+        if (it == topicIndex.end()) {
+            it = topicIndex.emplace(topic, static_cast<uint32_t>(traffic.topics.size())).first;
+            traffic.topics.push_back(topic);
+            traffic.publisherOf.push_back(0);
+        }
+        traffic.payloads.push_back(payload);
+        traffic.events.push_back(Event{static_cast<uint64_t>(timeMs * 1000.0 / options.speed), it->second,
+                                       static_cast<uint32_t>(traffic.payloads.size() - 1)});
+    }
+    std::stable_sort(traffic.events.begin(), traffic.events.end(),
+                     [](const Event& a, const Event& b) { return a.timeUs < b.timeUs; });
+    return !traffic.events.empty();
+}
+
+IoTExtractionPlan planFor(const std::string& format) {
+    if (format == "firmware") return IoTExtractionPlan::json({"temperature", "light", "x", "y", "z"});
+    if (format == "scalar") return IoTExtractionPlan::scalar();
+    return IoTExtractionPlan::automatic({"x", "y", "z"}, {0, 1, 2});
+}
+
+double percentile(std::vector<uint32_t>& values, double p) {
+    if (values.empty()) return 0.0;
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(p * (values.size() - 1) + 0.5));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index] / 1000.0;
+}
+
+Result run(const Options& options, const Traffic& traffic) {
+    auto& updateSystem = ParameterUpdateSystem::getInstance();
+    updateSystem.processAudioUpdates([](const ParameterUpdateQueue<>::ParameterChange&) {}, 1 << 20);
+
+    auto broker = std::make_shared<LoopbackBroker>();
+    LoopbackIoTInterface synth(broker);
+    synth.connect("loopback", 1883, "synth");
+
+    // Per-topic publish times, indexed by message number on that topic
+    std::vector<std::vector<uint64_t>> publishTimes(traffic.topics.size());
+    std::vector<uint32_t> received(traffic.topics.size(), 0);
+    std::vector<uint32_t> sent(traffic.topics.size(), 0);
+    for (const auto& event : traffic.events) {
+        ++sent[event.topic];
+    }
+    for (size_t t = 0; t < traffic.topics.size(); ++t) {
+        publishTimes[t].resize(sent[t]);
+        sent[t] = 0;
+    }
+
+    IoTExtractionPlan plan = planFor(options.replayFile.empty() ? options.format : "json");
+    float checksum = 0.0f;
+    std::unordered_map<std::string, uint32_t> parameterTopic;
+
+    IoTParameterBridge bridge(updateSystem);
+    for (size_t t = 0; t < traffic.topics.size(); ++t) {
+        std::string parameterId = "load_" + std::to_string(t);
+        parameterTopic[parameterId] = static_cast<uint32_t>(t);
+        bridge.mapTopic(traffic.topics[t], parameterId, [&, t](const std::string& payload) {
+            float values[IoTExtractionPlan::kMaxFields] = {};
+            if (plan.extract(payload, values) == 0) {
+                IoTPayloadScanner::findFirstNumber(payload, values[0]);
+            }
+            checksum += values[0];
+            return static_cast<float>(received[t]++);
+        });
+    }
+    bridge.connect(&synth);
+    synth.update();
+
+    std::vector<std::unique_ptr<LoopbackIoTInterface>> nodes;
+    for (size_t i = 0; i < traffic.publishers; ++i) {
+        nodes.push_back(std::make_unique<LoopbackIoTInterface>(broker));
+        nodes.back()->connect("loopback", 1883, "esp32_" + std::to_string(i));
+    }
+
+    std::atomic<bool> running{true};
+    std::atomic<bool> generatorDone{false};
+    std::vector<uint32_t> latencies;
+    latencies.reserve(traffic.events.size());
+
+    // IoT client thread: what the MQTT network thread does for a real broker
+    std::thread iotThread([&]() {
+        while (running.load(std::memory_order_acquire)) {
+            synth.waitForMessages(std::chrono::milliseconds(1));
+            synth.update();
+        }
+        synth.update();
+    });
+
+    // Simulated audio callback, one parameter drain per block
+    auto blockPeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(options.blockSize / options.sampleRate));
+    std::thread audioThread([&]() {
+        auto next = std::chrono::steady_clock::now();
+        while (running.load(std::memory_order_acquire)) {
+            next += blockPeriod;
+            std::this_thread::sleep_until(next);
+            updateSystem.processAudioUpdates([&](const ParameterUpdateQueue<>::ParameterChange& change) {
+                auto it = parameterTopic.find(change.id);
+                if (it == parameterTopic.end()) return;
+                uint32_t index = static_cast<uint32_t>(change.value);
+                const auto& times = publishTimes[it->second];
+                if (index < times.size()) {
+                    latencies.push_back(static_cast<uint32_t>(nowUs() - times[index]));
+                }
+            }, 1 << 16);
+        }
+    });
+
+    bridge.start(options.controlRate);
+
+    uint64_t start = nowUs();
+    std::thread generator([&]() {
+        for (const auto& event : traffic.events) {
+            uint64_t due = start + event.timeUs;
+            uint64_t current = nowUs();
+            if (due > current) {
+                std::this_thread::sleep_for(std::chrono::microseconds(due - current));
+            }
+            publishTimes[event.topic][sent[event.topic]++] = nowUs();
+            nodes[traffic.publisherOf[event.topic]]->publish(traffic.topics[event.topic],
+                                                              traffic.payloads[event.payload]);
+        }
+        generatorDone.store(true, std::memory_order_release);
+    });
+    generator.join();
+    double publishSeconds = (nowUs() - start) / 1e6;
+
+    // Give the pipeline up to a second to drain what is still queued
+    uint64_t drainStart = nowUs();
+    while (nowUs() - drainStart < 1000000 &&
+           bridge.getStatistics().messagesIngested < traffic.events.size()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    double ingestSeconds = (nowUs() - start) / 1e6;
+    std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(2000.0 / options.controlRate) + 20));
+
+    bridge.stop();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    running.store(false, std::memory_order_release);
+    synth.wake();
+    iotThread.join();
+    audioThread.join();
+    bridge.disconnect();
+
+    auto bridgeStats = bridge.getStatistics();
+    Result result;
+    result.nodes = static_cast<int>(traffic.publishers);
+    result.published = traffic.events.size();
+    result.ingested = bridgeStats.messagesIngested;
+    result.updates = latencies.size();
+    result.dropped = bridgeStats.valuesDropped;
+    result.maxBacklog = synth.getMaxPendingCount();
+    result.offeredRate = result.published / std::max(publishSeconds, 1e-6);
+    result.ingestRate = result.ingested / std::max(ingestSeconds, 1e-6);
+    result.p50 = percentile(latencies, 0.50);
+    result.p90 = percentile(latencies, 0.90);
+    result.p99 = percentile(latencies, 0.99);
+    result.p999 = percentile(latencies, 0.999);
+    result.max = latencies.empty() ? 0.0 : *std::max_element(latencies.begin(), latencies.end()) / 1000.0;
+    (void)checksum;
+    return result;
+}
+
+void printHeader() {
+    std::cout << std::left << std::setw(7) << "Nodes" << std::right
+              << std::setw(12) << "Offered/s" << std::setw(12) << "Ingested/s"
+              << std::setw(10) << "Updates" << std::setw(9) << "Backlog"
+              << std::setw(9) << "p50 ms" << std::setw(9) << "p90 ms" << std::setw(9) << "p99 ms"
+              << std::setw(10) << "p99.9 ms" << std::setw(9) << "max ms" << std::endl;
+}
+
+void printResult(const Result& r) {
+    std::cout << std::fixed << std::setprecision(0)
+              << std::left << std::setw(7) << r.nodes << std::right
+              << std::setw(12) << r.offeredRate << std::setw(12) << r.ingestRate
+              << std::setw(10) << r.updates << std::setw(9) << r.maxBacklog
+              << std::setprecision(2)
+              << std::setw(9) << r.p50 << std::setw(9) << r.p90 << std::setw(9) << r.p99
+              << std::setw(10) << r.p999 << std::setw(9) << r.max << std::endl;
+    if (r.ingested < r.published || r.dropped > 0) {
+        std::cout << "  lost " << (r.published - r.ingested) << " messages, dropped "
+                  << r.dropped << " parameter updates" << std::endl;
+    }
+}
+
+bool withinBudget(const Result& r, const Options& options) {
+    return r.ingested == r.published && r.dropped == 0 && r.p99 <= options.budgetMs;
+}
+
+bool parseArguments(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : "0"; };
+        if (arg == "--nodes") options.nodes = std::max(1, std::atoi(value()));
+        else if (arg == "--rate") options.rate = std::max(0.1, std::atof(value()));
+        else if (arg == "--duration") options.duration = std::max(0.1, std::atof(value()));
+        else if (arg == "--format") options.format = value();
+        else if (arg == "--control-rate") options.controlRate = static_cast<float>(std::atof(value()));
+        else if (arg == "--block") options.blockSize = std::max(16, std::atoi(value()));
+        else if (arg == "--replay") options.replayFile = value();
+        else if (arg == "--speed") options.speed = std::max(0.01, std::atof(value()));
+        else if (arg == "--sweep") options.sweep = true;
+        else if (arg == "--budget-ms") options.budgetMs = std::atof(value());
+        else {
+            std::cerr << "Unknown option " << arg << " (see the comment at the top of IoTLoadGenerator.cpp)" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        return 1;
+    }
+
+    std::cout << "=== IoT Load Generator ===" << std::endl;
+    std::cout << "Control rate " << options.controlRate << " Hz, audio block " << options.blockSize
+              << " samples at " << options.sampleRate << " Hz" << std::endl;
+
+    if (!options.replayFile.empty()) {
+        Traffic traffic;
+        if (!replayTraffic(options, traffic)) {
+            std::cerr << "No events to replay" << std::endl;
+            return 1;
+        }
+        std::cout << "Replaying " << traffic.events.size() << " messages on " << traffic.topics.size()
+                  << " topics at " << options.speed << "x" << std::endl << std::endl;
+        printHeader();
+        printResult(run(options, traffic));
+        return 0;
+    }
+
+    std::cout << "Format " << options.format << ", " << options.rate << " Hz per node, "
+              << options.duration << " s per run" << std::endl << std::endl;
+    printHeader();
+
+    if (!options.sweep) {
+        Result result = run(options, syntheticTraffic(options, options.nodes));
+        printResult(result);
+        return result.ingested == result.published ? 0 : 1;
+    }
+
+    int capacity = 0;
+    for (int nodes = options.nodes; nodes <= 4096; nodes *= 2) {
+        Result result = run(options, syntheticTraffic(options, nodes));
+        printResult(result);
+        if (!withinBudget(result, options)) {
+            break;
+        }
+        capacity = nodes;
+    }
+
+    std::cout << std::endl;
+    if (capacity > 0) {
+        std::cout << "Capacity: " << capacity << " nodes at " << options.rate
+                  << " Hz within a p99 budget of " << options.budgetMs << " ms" << std::endl;
+    } else {
+        std::cout << "Budget exceeded at " << options.nodes << " nodes" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <string>
+#include <thread>
+#include "../include/iot/IoTParameterBridge.h"
+#include "../include/iot/DummyIoTInterface.h"
+#include "../include/iot/IoTPayloadScanner.h"
+
+using namespace AIMusicHardware;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+bool near(float a, float b) {
+    return std::abs(a - b) < 1e-4f;
+}
+
+// Drain everything the audio thread would see this block
+std::map<std::string, float> drainAudio(size_t* count = nullptr) {
+    std::map<std::string, float> values;
+    size_t processed = ParameterUpdateSystem::getInstance().processAudioUpdates(
+        [&](const ParameterUpdateQueue<>::ParameterChange& change) {
+            values[change.id] = change.value;
+        }, 4096);
+    if (count) *count = processed;
+    return values;
+}
+
+void testCoalescing() {
+    std::cout << "\n=== Coalescing modes ===" << std::endl;
+    drainAudio();
+
+    IoTParameterBridge bridge;
+    check(bridge.mapTopic("sensors/+/accel", "filter_cutoff", nullptr, IoTParameterBridge::CoalesceMode::Mean) == 0,
+          "Wildcard mapping accepted");
+    bridge.mapTopic("sensors/light", "reverb_mix");
+    bridge.mapTopic("sensors/light", "delay_feedback", nullptr, IoTParameterBridge::CoalesceMode::Max);
+    int minMapping = bridge.mapTopic("sensors/temp", "lfo_rate", nullptr, IoTParameterBridge::CoalesceMode::Min);
+    check(bridge.mapTopic("sensors/#/bad", "x") == -1, "Invalid filter rejected");
+
+    bridge.ingest("sensors/node1/accel", "1.0");
+    bridge.ingest("sensors/node2/accel", "2.0");
+    bridge.ingest("sensors/node1/accel", "6.0");
+    bridge.ingest("sensors/light", "0.2");
+    bridge.ingest("sensors/light", "0.9");
+    bridge.ingest("sensors/light", "0.4");
+    bridge.ingest("sensors/temp", "21");
+    bridge.ingest("sensors/temp", "19.5");
+    bridge.ingest("sensors/unmapped", "1");
+    bridge.ingest("sensors/temp", "not a number");
+
+    check(bridge.flush() == 4, "One value per mapping per flush");
+    size_t processed = 0;
+    auto values = drainAudio(&processed);
+    check(processed == 4, "Audio thread received 4 updates for 10 messages");
+    check(near(values["filter_cutoff"], 3.0f), "Mean of accelerometer window");
+    check(near(values["reverb_mix"], 0.4f), "Last value wins");
+    check(near(values["delay_feedback"], 0.9f), "Max of window");
+    check(near(values["lfo_rate"], 19.5f), "Min of window");
+
+    check(bridge.flush() == 0, "Empty window publishes nothing");
+
+    bridge.setCoalesceMode(minMapping, IoTParameterBridge::CoalesceMode::LastValue);
+    bridge.ingest("sensors/temp", "18");
+    bridge.ingest("sensors/temp", "25");
+    bridge.flush();
+    values = drainAudio();
+    check(values.size() == 1 && near(values["lfo_rate"], 25.0f), "Coalesce mode can be changed per mapping");
+
+    auto stats = bridge.getStatistics();
+    check(stats.messagesIngested == 12 && stats.messagesUnmatched == 1, "Ingest and unmatched counters");
+    check(stats.valuesPublished == 5 && stats.valuesDropped == 0 && stats.batchesPublished == 2, "Publish counters");
+
+    // Synthesizer parameters are resolved when mapped, so the audio thread can set them by index
+    bridge.ingest("sensors/node1/accel", "0.5");
+    bridge.ingest("sensors/light", "0.5");
+    bridge.flush();
+    std::map<std::string, int> bound;
+    ParameterUpdateSystem::getInstance().processAudioUpdates([&](const ParameterUpdateQueue<>::ParameterChange& change) {
+        bound[change.id] = change.synthParameter;
+    }, 4096);
+    check(bound.size() == 3 && bound["filter_cutoff"] == static_cast<int>(SynthParamId::FilterCutoff) &&
+          bound["reverb_mix"] == -1 && bound["delay_feedback"] == -1,
+          "Published changes carry the synthesizer parameter bound at mapping time");
+
+    // The batch queue is single-producer: a second bridge cannot claim it
+    IoTParameterBridge second;
+    second.mapTopic("sensors/light", "reverb_mix");
+    second.ingest("sensors/light", "0.7");
+    check(bridge.canPublish() && !second.canPublish() && second.flush() == 0 && drainAudio().empty(),
+          "Second bridge publishes nothing while the first holds the batch queue");
+}
+
+void testConverterAndInterface() {
+    std::cout << "\n=== Converters and interface registration ===" << std::endl;
+    drainAudio();
+
+    DummyIoTInterface iot;
+    IoTParameterBridge bridge;
+    bridge.connect(&iot);
+    bridge.mapTopic("node/co2", "filter_resonance", [](const std::string& payload) {
+        float value = 0.0f;
+        IoTPayloadScanner::parseNumber(IoTPayloadScanner::findJsonValue(payload, "co2"), value);
+        return (value - 400.0f) / 1600.0f;
+    });
+    check(bridge.getMappingCount() == 1, "Mapping added after connect");
+
+    bridge.ingest("node/co2", R"({"temp":21,"co2":1200})");
+    bridge.flush();
+    auto values = drainAudio();
+    check(near(values["filter_resonance"], 0.5f), "Custom converter applied");
+    bridge.disconnect();
+}
+
+void testControlRate() {
+    std::cout << "\n=== 1 kHz sensor stream at 200 Hz control rate ===" << std::endl;
+    drainAudio();
+
+    IoTParameterBridge bridge;
+    bridge.mapTopic("sensors/accel/x", "pitch_bend", nullptr, IoTParameterBridge::CoalesceMode::Mean);
+    bridge.mapTopic("sensors/accel/y", "mod_wheel", nullptr, IoTParameterBridge::CoalesceMode::Mean);
+
+    size_t audioUpdates = 0;
+    const int messages = 500;
+    bridge.start(200.0f);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < messages; ++i) {
+        bridge.ingest("sensors/accel/x", std::to_string(std::sin(i * 0.01)));
+        bridge.ingest("sensors/accel/y", std::to_string(std::cos(i * 0.01)));
+        if (i % 50 == 0) {
+            size_t processed = 0;
+            drainAudio(&processed);
+            audioUpdates += processed;
+        }
+        std::this_thread::sleep_until(start + std::chrono::milliseconds(i + 1));
+    }
+    bridge.stop();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t processed = 0;
+    drainAudio(&processed);
+    audioUpdates += processed;
+
+    auto stats = bridge.getStatistics();
+    double batchRate = stats.batchesPublished / seconds;
+    std::cout << std::fixed << std::setprecision(1)
+              << "Messages: " << stats.messagesIngested << ", audio updates: " << audioUpdates
+              << ", batches/s: " << batchRate << std::endl;
+
+    check(stats.messagesIngested == 2 * messages, "All messages ingested");
+    check(audioUpdates == stats.valuesPublished && stats.valuesDropped == 0, "Every published value reached the audio thread");
+    check(audioUpdates < stats.messagesIngested / 2, "Audio queue load reduced by coalescing");
+    check(batchRate <= 210.0, "Flushes bounded by the control rate");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== IoT Parameter Bridge Test ===" << std::endl;
+
+    testCoalescing();
+    testConverterAndInterface();
+    testControlRate();
+
+    std::cout << "\n" << (failures == 0 ? "All parameter bridge checks passed" : "Parameter bridge checks FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <cmath>
+#include "../include/iot/IoTParameterTypes.h"
+#include "../include/iot/IoTPayloadScanner.h"
+#include "AllocationCounter.h"
+
+using namespace AIMusicHardware;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+bool near(float a, float b) {
+    return std::abs(a - b) < 1e-3f;
+}
+
+// Regex-based parsing as it was before the scanner, kept for comparison
+namespace legacy {
+
+std::string parseJsonValue(const std::string& payload, const std::string& key) {
+    std::regex keyRegex("\"" + key + "\"\\s*:\\s*([^,}\\]]+)");
+    std::smatch match;
+    if (std::regex_search(payload, match, keyRegex) && match.size() > 1) {
+        std::string value = match[1].str();
+        value = std::regex_replace(value, std::regex("^\\s+|\\s+$"), "");
+        value = std::regex_replace(value, std::regex("^\""), "");
+        value = std::regex_replace(value, std::regex("\"$"), "");
+        return value;
+    }
+    return "";
+}
+
+std::string parseCsvValue(const std::string& payload, int index) {
+    std::stringstream ss(payload);
+    std::string item;
+    for (int i = 0; std::getline(ss, item, ','); ++i) {
+        if (i == index) return item;
+    }
+    return "";
+}
+
+float temperature(const std::string& payload) {
+    try {
+        std::regex tempRegex("([+-]?[0-9.]+)");
+        std::smatch match;
+        if (std::regex_search(payload, match, tempRegex)) return std::stof(match[1].str());
+    } catch (...) {}
+    return 20.0f;
+}
+
+float acceleration(const std::string& payload) {
+    try {
+        if (payload.find('{') != std::string::npos) {
+            float x = std::stof(parseJsonValue(payload, "x"));
+            float y = std::stof(parseJsonValue(payload, "y"));
+            float z = std::stof(parseJsonValue(payload, "z"));
+            return std::sqrt(x * x + y * y + z * z);
+        }
+        if (payload.find(',') != std::string::npos) {
+            float x = std::stof(parseCsvValue(payload, 0));
+            float y = std::stof(parseCsvValue(payload, 1));
+            float z = std::stof(parseCsvValue(payload, 2));
+            return std::sqrt(x * x + y * y + z * z);
+        }
+        return std::stof(payload);
+    } catch (...) {}
+    return 0.0f;
+}
+
+} // namespace legacy
+
+void testScanner() {
+    std::cout << "\n=== Payload scanner ===" << std::endl;
+
+    float value = 0.0f;
+    check(IoTPayloadScanner::parseNumber(" +23.5 ", value) && near(value, 23.5f), "Leading '+' and whitespace");
+    check(IoTPayloadScanner::parseNumber("\"-4e2\"", value) && near(value, -400.0f), "Quoted exponent");
+    check(IoTPayloadScanner::parseNumber("12abc", value) && near(value, 12.0f), "Trailing text ignored like stof");
+    check(IoTPayloadScanner::parseNumber("true", value) && near(value, 1.0f), "Boolean literal");
+    check(!IoTPayloadScanner::parseNumber("abc", value), "Rejects text");
+    check(IoTPayloadScanner::findFirstNumber("temp=-3.25C", value) && near(value, -3.25f), "First number in free text");
+
+    std::string json = R"({"device":"esp32-7","data":{"x": 0.5, "y":-1.5,"z":"2.0"},"name":"a\"b"})";
+    check(IoTPayloadScanner::findJsonValue(json, "device") == "esp32-7", "String value without quotes");
+    check(IoTPayloadScanner::findJsonValue(json, "y") == "-1.5", "Nested numeric value");
+    check(IoTPayloadScanner::findJsonValue(json, "missing").empty(), "Missing key is empty");
+    check(IoTPayloadScanner::csvField(" 1, 2 ,3", 1) == "2", "CSV field trimmed");
+
+    float xyz[3] = {};
+    auto plan = IoTExtractionPlan::automatic({"x", "y", "z"}, {0, 1, 2});
+    check(plan.extract(json, xyz) == 0x7u && near(xyz[0], 0.5f) && near(xyz[1], -1.5f) && near(xyz[2], 2.0f),
+          "Plan reads x/y/z from JSON in one pass");
+    check(plan.extract("3,4,12", xyz) == 0x7u && near(xyz[2], 12.0f), "Same plan reads CSV");
+    check(plan.extract("{\"x\":1}", xyz) == 0x1u, "Mask reports missing fields");
+}
+
+void testConverterCompatibility() {
+    std::cout << "\n=== Converters agree with the regex versions ===" << std::endl;
+
+    auto temperature = IoTParameterConverter::getConverter(IoTParameterConverter::SensorType::TEMPERATURE, 0, 1, false);
+    auto acceleration = IoTParameterConverter::getConverter(IoTParameterConverter::SensorType::ACCELERATION, 0, 1, false);
+    auto gps = IoTParameterConverter::getConverter(IoTParameterConverter::SensorType::GPS, 0, 1, false);
+
+    const char* temperatures[] = {"23.5", "-4.0", "temp: 19.25C", "{\"t\": 21}", "none"};
+    int mismatches = 0;
+    for (const char* payload : temperatures) {
+        if (!near(temperature(payload), legacy::temperature(payload))) ++mismatches;
+    }
+    const char* accelerations[] = {"{\"x\":1.0,\"y\":2.0,\"z\":2.0}", "3,4,0", "9.81", "{\"x\":1}", "junk"};
+    for (const char* payload : accelerations) {
+        if (!near(acceleration(payload), legacy::acceleration(payload))) ++mismatches;
+    }
+    check(mismatches == 0, "Temperature and acceleration results unchanged");
+    check(near(gps("{\"lat\": 40.0, \"lon\": -74.0}"), -17.0f), "GPS JSON averages lat/lon");
+    check(IoTParameterConverter::parseJsonValue(R"({"mode": "ambient" })", "mode") == "ambient", "parseJsonValue strips quotes");
+
+    auto field = IoTParameterConverter::createJsonFieldConverter("co2", 400.0f, 2000.0f, true);
+    check(near(field(R"({"temp":21,"co2":1200})"), 0.5f), "JSON field converter normalizes");
+}
+
+void benchmark() {
+    std::cout << "\n=== Throughput ===" << std::endl;
+
+    std::vector<std::string> payloads;
+    for (int i = 0; i < 1000; ++i) {
+        switch (i % 4) {
+            case 0: payloads.push_back(std::to_string(15.0 + (i % 100) * 0.1)); break;
+            case 1: payloads.push_back("{\"id\":\"esp32-" + std::to_string(i) + "\",\"x\":" + std::to_string(i % 7 * 0.3) +
+                                       ",\"y\":" + std::to_string(-(i % 5) * 0.2) + ",\"z\":9.81}"); break;
+            case 2: payloads.push_back(std::to_string(i % 9) + "," + std::to_string(i % 4) + ",9.81"); break;
+            case 3: payloads.push_back("temp=" + std::to_string(i % 30) + "C"); break;
+        }
+    }
+
+    auto temperature = IoTParameterConverter::getConverter(IoTParameterConverter::SensorType::TEMPERATURE, -20, 50, true);
+    auto acceleration = IoTParameterConverter::getConverter(IoTParameterConverter::SensorType::ACCELERATION, 0, 20, true);
+
+    float sink = 0.0f;
+    const int rounds = 200;
+    size_t allocationsBefore = TestSupport::allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < payloads.size(); ++i) {
+            sink += (i % 4 == 1 || i % 4 == 2) ? acceleration(payloads[i]) : temperature(payloads[i]);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    size_t allocations = TestSupport::allocations.load() - allocationsBefore;
+    double scannerSeconds = std::chrono::duration<double>(end - start).count();
+    double scannerRate = rounds * payloads.size() / scannerSeconds;
+
+    const int legacyRounds = 5;
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < legacyRounds; ++round) {
+        for (size_t i = 0; i < payloads.size(); ++i) {
+            sink += (i % 4 == 1 || i % 4 == 2) ? legacy::acceleration(payloads[i]) : legacy::temperature(payloads[i]);
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    double legacyRate = legacyRounds * payloads.size() / std::chrono::duration<double>(end - start).count();
+
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "Scanner: " << scannerRate << " messages/second" << std::endl;
+    std::cout << "Regex:   " << legacyRate << " messages/second" << std::endl;
+    std::cout << "Speedup: " << std::setprecision(1) << scannerRate / legacyRate << "x"
+              << " (checksum " << std::setprecision(2) << sink << ")" << std::endl;
+    check(allocations == 0, "Scanner path performed " + std::to_string(allocations) + " heap allocations");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== IoT Payload Parsing Benchmark ===" << std::endl;
+
+    testScanner();
+    testConverterCompatibility();
+    benchmark();
+
+    std::cout << "\n" << (failures == 0 ? "All payload parsing checks passed" : "Payload parsing checks FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
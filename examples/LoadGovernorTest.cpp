@@ -0,0 +1,300 @@
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "../include/audio/LoadGovernor.h"
+#include "../include/audio/Synthesizer.h"
+#include "../include/effects/EffectProcessor.h"
+#include "../include/synthesis/voice/stacked_voice_manager.h"
+#include "../include/synthesis/wavetable/oscillator_stack.h"
+#include "AllocationCounter.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Load governor test
+ *
+ * Checks that the governor steps quality down on overload (at once on a
+ * missed deadline, otherwise once per hold time), holds between its
+ * thresholds and steps back up one level at a time after the restore
+ * time. Checks each level's effect: oscillator oversampling, the unison
+ * subset a stack renders, early freeing and stealing of released voices,
+ * and bypassing effects with tails without replaying a stale tail. Reports
+ * what each level saves on a stacked voice manager.
+ */
+
+namespace {
+
+using TestSupport::allocations;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+using QualityLevel = LoadGovernor::QualityLevel;
+
+// Feed a number of blocks at one load
+QualityLevel feed(LoadGovernor& governor, float load, int blocks, int blockSize = 256) {
+    QualityLevel level = governor.getLevel();
+    for (int i = 0; i < blocks; ++i) {
+        level = governor.update(load, blockSize);
+    }
+    return level;
+}
+
+float peak(const std::vector<float>& buffer) {
+    float result = 0.0f;
+    for (float sample : buffer) {
+        result = std::max(result, std::fabs(sample));
+    }
+    return result;
+}
+
+void testGovernor() {
+    std::cout << "\n=== Governor ===" << std::endl;
+
+    // 256-frame blocks at 48 kHz: 5.33 ms each
+    LoadGovernor governor(48000);
+    int callbacks = 0;
+    QualityLevel applied = QualityLevel::Full;
+    governor.setLevelCallback([&](QualityLevel level) {
+        ++callbacks;
+        applied = level;
+    });
+
+    check(feed(governor, 70.0f, 1000) == QualityLevel::Full, "Load below the degrade threshold keeps full quality");
+
+    check(governor.update(90.0f, 256) == QualityLevel::NoOversampling, "A block above 85% lowers quality one level");
+    check(feed(governor, 90.0f, 9) == QualityLevel::NoOversampling, "Further steps wait for the hold time");
+    check(feed(governor, 90.0f, 1) == QualityLevel::ReducedUnison, "The next step follows after 50 ms");
+    check(governor.update(120.0f, 256) == QualityLevel::EarlyVoiceStealing,
+          "A missed deadline lowers quality without waiting");
+    check(feed(governor, 120.0f, 10) == LoadGovernor::kLowestQuality, "Quality stops at the lowest level");
+    check(callbacks == 4 && applied == LoadGovernor::kLowestQuality, "The callback sees every change");
+
+    // Hysteresis: nothing comes back between the thresholds
+    check(feed(governor, 70.0f, 2000) == LoadGovernor::kLowestQuality, "Load between 60 and 85% holds the level");
+
+    // 2 s below 60% is 375 blocks; a block in between restarts the wait
+    feed(governor, 40.0f, 370);
+    governor.update(65.0f, 256);
+    check(feed(governor, 40.0f, 370) == LoadGovernor::kLowestQuality, "A busier block restarts the restore time");
+    check(feed(governor, 40.0f, 5) == QualityLevel::EarlyVoiceStealing, "2 s below 60% restores one level");
+    check(feed(governor, 40.0f, 374) == QualityLevel::EarlyVoiceStealing, "Each level waits its own restore time");
+    feed(governor, 40.0f, 375 * 3);
+    check(governor.getLevel() == QualityLevel::Full, "Quality climbs back to full");
+    check(governor.getDegradeCount() == 4 && governor.getRestoreCount() == 4, "Changes are counted");
+
+    // Disabling restores full quality at the next block
+    governor.update(120.0f, 256);
+    governor.setEnabled(false);
+    check(governor.update(120.0f, 256) == QualityLevel::Full && applied == QualityLevel::Full,
+          "A disabled governor runs at full quality");
+    governor.setEnabled(true);
+
+    size_t before = allocations;
+    for (int i = 0; i < 1000; ++i) {
+        governor.update(i % 100 == 0 ? 120.0f : 40.0f, 64);
+    }
+    size_t allocated = allocations - before;
+    check(allocated == 0, "Updating the governor does not allocate");
+
+    const RenderQuality full = LoadGovernor::renderQualityFor(QualityLevel::Full);
+    const RenderQuality lowest = LoadGovernor::renderQualityFor(LoadGovernor::kLowestQuality);
+    check(full.oversampling && full.maxUnison == 8 && full.releaseCutoff == 0.0f &&
+              !LoadGovernor::bypassesEffectTails(QualityLevel::EarlyVoiceStealing),
+          "Full quality changes nothing");
+    check(!lowest.oversampling && lowest.maxUnison == 2 && lowest.releaseCutoff > 0.0f &&
+              LoadGovernor::bypassesEffectTails(LoadGovernor::kLowestQuality),
+          "The lowest level applies every saving");
+}
+
+void testOscillators() {
+    std::cout << "\n=== Oscillators ===" << std::endl;
+
+    auto wavetable = std::make_shared<Wavetable>();
+    wavetable->initBasicWaveforms();
+
+    WavetableOscillator oversampled(48000), plain(48000);
+    oversampled.setWavetable(wavetable);
+    plain.setWavetable(wavetable);
+    oversampled.setFrequency(1000.0f);
+    plain.setFrequency(1000.0f);
+    plain.setOversampling(false);
+    float difference = 0.0f;
+    for (int i = 0; i < 480; ++i) {
+        difference = std::max(difference, std::fabs(oversampled.generateSample() - plain.generateSample()));
+    }
+    check(oversampled.isOversampling() && !plain.isOversampling() && difference < 0.1f,
+          "Oversampling can be turned off; the waveform stays the same");
+
+    OscillatorStack stack(48000, 7);
+    stack.setWavetable(wavetable);
+    stack.configUnison(7, 20.0f, 1.0f, 0.0f);
+    stack.setUnisonLimit(2);
+    check(stack.getOscillatorCount() == 7 && stack.getRenderedOscillatorCount() == 2,
+          "A unison limit renders fewer oscillators and keeps the configuration");
+    stack.setUnisonLimit(1);
+    check(stack.getRenderedOscillatorCount() == 1, "A limit of one renders a single oscillator");
+    stack.setUnisonLimit(8);
+    check(stack.getRenderedOscillatorCount() == 7, "Raising the limit renders the whole stack again");
+
+    // The reduced stack keeps the outer oscillators, so its width stays
+    stack.setUnisonLimit(2);
+    float left = 0.0f, right = 0.0f, leftEnergy = 0.0f, rightEnergy = 0.0f;
+    for (int i = 0; i < 4800; ++i) {
+        stack.generateStereoSample(left, right);
+        leftEnergy += left * left;
+        rightEnergy += right * right;
+    }
+    check(leftEnergy > 0.0f && std::fabs(leftEnergy - rightEnergy) / (leftEnergy + rightEnergy) < 0.2f,
+          "A reduced stack stays balanced between the channels");
+
+    size_t before = allocations;
+    stack.setUnisonLimit(3);
+    stack.setOversampling(false);
+    stack.setUnisonLimit(8);
+    size_t allocated = allocations - before;
+    check(allocated == 0, "Changing the unison limit does not allocate");
+}
+
+void testVoices() {
+    std::cout << "\n=== Voices ===" << std::endl;
+
+    const int blockSize = 256;
+    std::vector<float> buffer(blockSize * 2);
+
+    // Released voices ring for the 500 ms release unless cut early
+    VoiceManager relaxed(48000, 4), governed(48000, 4);
+    governed.setRenderQuality(LoadGovernor::renderQualityFor(QualityLevel::EarlyVoiceStealing));
+    for (VoiceManager* manager : {&relaxed, &governed}) {
+        manager->noteOn(60, 0.8f);
+        for (int i = 0; i < 20; ++i) manager->process(buffer.data(), blockSize);
+        manager->noteOff(60);
+    }
+    int relaxedBlocks = 0, governedBlocks = 0;
+    for (int i = 0; i < 200 && relaxed.getActiveVoiceCount() > 0; ++i, ++relaxedBlocks) {
+        relaxed.process(buffer.data(), blockSize);
+    }
+    for (int i = 0; i < 200 && governed.getActiveVoiceCount() > 0; ++i, ++governedBlocks) {
+        governed.process(buffer.data(), blockSize);
+    }
+    check(governedBlocks < relaxedBlocks,
+          "Quiet release tails are cut early (" + std::to_string(governedBlocks) + " blocks instead of " +
+              std::to_string(relaxedBlocks) + ")");
+
+    // With every voice busy, a released voice is stolen before a held one
+    VoiceManager manager(48000, 4);
+    manager.setRenderQuality(LoadGovernor::renderQualityFor(QualityLevel::EarlyVoiceStealing));
+    for (int note = 60; note < 64; ++note) {
+        manager.noteOn(note, 0.8f);
+    }
+    manager.process(buffer.data(), blockSize);
+    manager.noteOff(63);
+    manager.process(buffer.data(), blockSize);
+    manager.noteOn(70, 0.8f);
+    bool heldNotesKept = true;
+    bool releasedStolen = true;
+    for (int i = 0; i < 4; ++i) {
+        const int note = manager.getVoice(i)->getMidiNote();
+        releasedStolen &= note != 63;
+        heldNotesKept &= note != -1;
+    }
+    check(releasedStolen && heldNotesKept, "The released voice is stolen and held notes keep playing");
+
+    // Stacked voices take the oversampling and unison limits
+    StackedVoiceManager stacked(48000, 4, 7);
+    stacked.setRenderQuality(LoadGovernor::renderQualityFor(QualityLevel::ReducedUnison));
+    OscillatorStack* stack = stacked.getStackedVoice(0)->getOscillatorStack();
+    check(stack->getRenderedOscillatorCount() == 2 && !stack->isOversampling(),
+          "Stacked voices render two oscillators without oversampling");
+    stacked.setMaxVoices(6);
+    check(!stacked.getStackedVoice(5)->getOscillatorStack()->isOversampling(),
+          "New voices start at the current quality");
+}
+
+void testEffects() {
+    std::cout << "\n=== Effect tails ===" << std::endl;
+
+    const int blockSize = 256;
+    EffectProcessor effects(48000);
+    effects.initialize();
+    auto delay = std::make_unique<Delay>(48000);
+    delay->setParameter("delayTime", 0.02f);
+    delay->setParameter("mix", 0.5f);
+    effects.addEffect(std::move(delay));
+
+    // An impulse, then silence: the echo rings on
+    std::vector<float> buffer(blockSize * 2, 0.0f);
+    buffer[0] = buffer[1] = 1.0f;
+    effects.process(buffer.data(), blockSize);
+    float echo = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+        effects.process(buffer.data(), blockSize);
+        echo = std::max(echo, peak(buffer));
+    }
+
+    effects.setTailEffectsBypassed(true);
+    std::fill(buffer.begin(), buffer.end(), 0.25f);
+    effects.process(buffer.data(), blockSize);
+    check(echo > 0.1f && buffer[100] == 0.25f, "Bypassed effects with tails pass the signal dry");
+
+    effects.setTailEffectsBypassed(false);
+    std::fill(buffer.begin(), buffer.end(), 0.0f);
+    for (int i = 0; i < 8; ++i) {
+        effects.process(buffer.data(), blockSize);
+    }
+    check(peak(buffer) == 0.0f, "Brought back, they do not replay the old tail");
+}
+
+void testSavings() {
+    std::cout << "\n=== Savings ===" << std::endl;
+
+    const int blockSize = 256;
+    const int blocks = 200;
+    std::vector<float> buffer(blockSize * 2);
+
+    auto render = [&](QualityLevel level) {
+        StackedVoiceManager manager(48000, 8, 7);
+        manager.setRenderQuality(LoadGovernor::renderQualityFor(level));
+        for (int note = 48; note < 56; ++note) {
+            manager.noteOn(note, 0.7f);
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < blocks; ++i) {
+            manager.process(buffer.data(), blockSize);
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e6 / blocks;
+    };
+
+    const double full = render(QualityLevel::Full);
+    const double noOversampling = render(QualityLevel::NoOversampling);
+    const double reducedUnison = render(QualityLevel::ReducedUnison);
+    std::cout << std::fixed << std::setprecision(1) << "8 voices x 7 unison, " << blockSize << " frames: full "
+              << full << " us, no oversampling " << noOversampling << " us, reduced unison " << reducedUnison
+              << " us" << std::endl;
+    check(reducedUnison < full, "Lower levels cost less to render");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Load Governor Test ===" << std::endl;
+
+    testGovernor();
+    testOscillators();
+    testVoices();
+    testEffects();
+    testSavings();
+
+    std::cout << "\n" << (failures == 0 ? "All load governor checks passed" : "Load governor checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
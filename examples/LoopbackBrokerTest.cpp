@@ -0,0 +1,117 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../include/iot/LoopbackBroker.h"
+
+using namespace AIMusicHardware;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+void testRouting() {
+    std::cout << "\n=== Wildcard routing ===" << std::endl;
+
+    auto broker = std::make_shared<LoopbackBroker>();
+    LoopbackIoTInterface synth(broker);
+    LoopbackIoTInterface node(broker);
+    synth.connect("loopback", 1883, "synth");
+    node.connect("loopback", 1883, "esp32_1");
+
+    std::vector<std::string> received;
+    synth.setMessageCallback([&](const std::string& topic, const std::string&) {
+        received.push_back("global:" + topic);
+    });
+    synth.setTopicCallback("sensors/+/temperature", [&](const std::string& topic, const std::string&) {
+        received.push_back("temp:" + topic);
+    });
+    synth.subscribe("sensors/#");
+
+    check(node.publish("sensors/esp32_1/temperature", "21.5"), "Publish accepted");
+    node.publish("sensors/esp32_1/light", "300");
+    node.publish("other/topic", "x");
+    check(!node.publish("sensors/+/light", "1"), "Wildcards rejected in topic names");
+
+    check(received.empty(), "Nothing dispatched before update()");
+    check(synth.getPendingCount() == 2, "Overlapping filters deliver once per client");
+    synth.update();
+    check(received.size() == 2 && received[0] == "temp:sensors/esp32_1/temperature" &&
+          received[1] == "global:sensors/esp32_1/light", "Topic callback preferred over global callback");
+
+    synth.removeTopicCallback("sensors/+/temperature");
+    received.clear();
+    node.publish("sensors/esp32_1/temperature", "22.0");
+    synth.update();
+    check(received.size() == 1 && received[0] == "global:sensors/esp32_1/temperature",
+          "Removed callback falls back to global callback");
+
+    auto stats = broker->getStatistics();
+    check(stats.messagesPublished == 4 && stats.messagesUnrouted == 1, "Broker statistics");
+}
+
+void testRetainedAndReconnect() {
+    std::cout << "\n=== Retained messages and reconnect ===" << std::endl;
+
+    auto broker = std::make_shared<LoopbackBroker>();
+    LoopbackIoTInterface node(broker);
+    node.connect("loopback", 1883, "esp32_2");
+    node.publish("sensors/esp32_2/status", "online", 1, true);
+
+    LoopbackIoTInterface synth(broker);
+    int statusMessages = 0;
+    synth.setMessageCallback([&](const std::string&, const std::string& payload) {
+        if (payload == "online") ++statusMessages;
+    });
+    synth.subscribe("sensors/+/status");
+    synth.update();
+    check(statusMessages == 0, "No delivery before connect");
+
+    synth.connect("loopback", 1883, "synth");
+    synth.update();
+    check(statusMessages == 1, "Retained message sent on subscribe");
+
+    synth.disconnect();
+    node.publish("sensors/esp32_2/status", "online");
+    synth.update();
+    check(statusMessages == 1, "Disconnected client receives nothing");
+
+    synth.connect("loopback", 1883, "synth");
+    synth.update();
+    check(statusMessages == 2, "Subscriptions restored on reconnect");
+
+    node.publish("sensors/esp32_2/status", "", 1, true);
+    check(broker->getStatistics().retainedMessages == 0, "Empty retained payload clears the topic");
+}
+
+void testLoopback() {
+    std::cout << "\n=== Private broker loopback ===" << std::endl;
+
+    LoopbackIoTInterface iot;
+    iot.connect("localhost", 1883, "loopback");
+    std::string payload;
+    iot.setTopicCallback("$SYS/#", [&](const std::string&, const std::string& p) { payload = p; });
+    iot.subscribe("#");
+    iot.publish("$SYS/uptime", "42");
+    check(iot.waitForMessages(std::chrono::milliseconds(10)), "waitForMessages sees the message");
+    iot.update();
+    check(payload == "42", "Own publication received through the '$' filter");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Loopback Broker Test ===" << std::endl;
+
+    testRouting();
+    testRetainedAndReconnect();
+    testLoopback();
+
+    std::cout << "\n" << (failures == 0 ? "All loopback broker checks passed" : "Loopback broker checks FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+#include <atomic>
+#include "../include/iot/MQTTTopicTrie.h"
+#include "AllocationCounter.h"
+
+using namespace AIMusicHardware;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+std::vector<uint32_t> collect(const MQTTTopicTrie& trie, const std::string& topic) {
+    std::vector<uint32_t> ids;
+    trie.match(topic, [&ids](uint32_t id) { ids.push_back(id); });
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+void testWildcardSemantics() {
+    std::cout << "\n=== MQTT wildcard semantics ===" << std::endl;
+
+    check(MQTTTopicTrie::matches("sensors/kitchen/temp", "sensors/+/temp"), "'+' matches one level");
+    check(!MQTTTopicTrie::matches("sensors/kitchen/a/temp", "sensors/+/temp"), "'+' does not span levels");
+    check(MQTTTopicTrie::matches("sensors/kitchen/temp", "sensors/#"), "'#' matches deeper levels");
+    check(MQTTTopicTrie::matches("sensors", "sensors/#"), "'#' matches its parent level");
+    check(!MQTTTopicTrie::matches("sensorsX/temp", "sensors/#"), "'#' does not match a longer first level");
+    check(MQTTTopicTrie::matches("anything/at/all", "#"), "'#' alone matches everything");
+    check(!MQTTTopicTrie::matches("$SYS/broker/load", "#"), "First-level wildcards skip $ topics");
+    check(MQTTTopicTrie::matches("$SYS/broker/load", "$SYS/#"), "Explicit $ filters still match");
+    check(MQTTTopicTrie::matches("a//b", "a/+/b"), "'+' matches an empty level");
+    check(!MQTTTopicTrie::isValidFilter("sensors/temp#"), "Rejects '#' inside a level");
+    check(!MQTTTopicTrie::isValidFilter("sensors/#/temp"), "Rejects '#' before the last level");
+    check(!MQTTTopicTrie::isValidFilter("sen+sors"), "Rejects '+' inside a level");
+
+    MQTTTopicTrie trie;
+    trie.insert("home/+/temp", 1);
+    trie.insert("home/#", 2);
+    trie.insert("home/kitchen/temp", 3);
+    trie.insert("#", 4);
+    trie.insert("+/+/+", 5);
+
+    check(collect(trie, "home/kitchen/temp") == std::vector<uint32_t>({1, 2, 3, 4, 5}),
+          "Every overlapping filter reported exactly once");
+    check(collect(trie, "home") == std::vector<uint32_t>({2, 4}), "Parent level reaches '#' filters only");
+
+    trie.remove("home/#", 2);
+    check(collect(trie, "home/kitchen/temp") == std::vector<uint32_t>({1, 3, 4, 5}), "Removed filter no longer matches");
+    check(trie.size() == 4, "Size tracks inserts and removes");
+}
+
+void testAgainstReference() {
+    std::cout << "\n=== Randomized trie vs single-filter matcher ===" << std::endl;
+
+    std::mt19937 rng(42);
+    const char* words[] = {"home", "garden", "temp", "light", "+", "#", "a", "$SYS", ""};
+    std::vector<std::string> filters;
+    MQTTTopicTrie trie;
+
+    for (uint32_t i = 0; i < 400; ++i) {
+        std::string filter;
+        int depth = 1 + rng() % 4;
+        for (int d = 0; d < depth; ++d) {
+            if (d) filter += '/';
+            filter += words[rng() % 9];
+        }
+        if (trie.insert(filter, i)) {
+            filters.push_back(filter);
+        } else {
+            filters.push_back("");   // keep IDs aligned with indices
+        }
+    }
+
+    int mismatches = 0;
+    for (int t = 0; t < 2000; ++t) {
+        std::string topic;
+        int depth = 1 + rng() % 4;
+        for (int d = 0; d < depth; ++d) {
+            if (d) topic += '/';
+            const char* word = words[rng() % 9];
+            if (word[0] != '+' && word[0] != '#') topic += word;
+        }
+
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < filters.size(); ++i) {
+            if (!filters[i].empty() && MQTTTopicTrie::matches(topic, filters[i])) {
+                expected.push_back(i);
+            }
+        }
+        if (collect(trie, topic) != expected) ++mismatches;
+    }
+    check(mismatches == 0, "2000 random topics agree with the reference matcher");
+}
+
+void benchmarkDispatch() {
+    std::cout << "\n=== Dispatch: 5000 device filters ===" << std::endl;
+
+    MQTTTopicTrie trie;
+    std::vector<std::string> filters;
+    for (int device = 0; device < 1000; ++device) {
+        std::string base = "farm/zone" + std::to_string(device % 20) + "/dev" + std::to_string(device);
+        filters.push_back(base + "/temperature");
+        filters.push_back(base + "/humidity");
+        filters.push_back(base + "/+");
+        filters.push_back(base + "/#");
+        filters.push_back("farm/+/dev" + std::to_string(device) + "/light");
+    }
+    for (uint32_t i = 0; i < filters.size(); ++i) {
+        trie.insert(filters[i], i);
+    }
+
+    std::vector<std::string> topics;
+    for (int i = 0; i < 1000; ++i) {
+        int device = (i * 37) % 1000;
+        topics.push_back("farm/zone" + std::to_string(device % 20) + "/dev" + std::to_string(device) +
+                         (i % 2 ? "/temperature" : "/light"));
+    }
+
+    size_t matched = 0;
+    size_t allocationsBefore = TestSupport::allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < 100; ++round) {
+        for (const auto& topic : topics) {
+            trie.match(topic, [&matched](uint32_t) { ++matched; });
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    size_t allocations = TestSupport::allocations.load() - allocationsBefore;
+    double trieNs = std::chrono::duration<double, std::nano>(end - start).count() / (100.0 * topics.size());
+
+    // The old approach: regex per wildcard filter per message (sampled, it is slow)
+    start = std::chrono::steady_clock::now();
+    size_t regexMatched = 0;
+    for (int i = 0; i < 20; ++i) {
+        const std::string& topic = topics[i];
+        for (const auto& filter : filters) {
+            std::string pattern = filter;
+            size_t pos = 0;
+            while ((pos = pattern.find('+', pos)) != std::string::npos) {
+                pattern.replace(pos, 1, "([^/]+)");
+                pos += 7;
+            }
+            if (pattern.back() == '#') {
+                pattern.replace(pattern.size() - 1, 1, ".*");
+            }
+            if (std::regex_match(topic, std::regex(pattern))) ++regexMatched;
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    double regexNs = std::chrono::duration<double, std::nano>(end - start).count() / 20.0;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Trie:  " << trieNs << " ns/message (" << matched / (100 * topics.size()) << " matches each)" << std::endl;
+    std::cout << "Regex: " << regexNs / 1000.0 << " us/message" << std::endl;
+    std::cout << "Speedup: " << std::setprecision(0) << regexNs / trieNs << "x" << std::endl;
+    check(allocations == 0, "Dispatch performed " + std::to_string(allocations) + " heap allocations");
+    check(regexMatched > 0, "Regex baseline sanity check");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== MQTT Topic Trie Test ===" << std::endl;
+
+    testWildcardSemantics();
+    testAgainstReference();
+    benchmarkDispatch();
+
+    std::cout << "\n" << (failures == 0 ? "All topic trie tests passed" : "Topic trie tests FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
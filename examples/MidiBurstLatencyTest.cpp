@@ -0,0 +1,295 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/midi/MidiInputRing.h"
+#include "../include/midi/MidiManager.h"
+#include "../include/audio/Synthesizer.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * MIDI input ring test and burst latency harness
+ *
+ * Checks MidiInputRing ordering, sample offsets and overflow accounting,
+ * that MidiManager starts a ring note on its offset in the rendered block
+ * and leaves MIDI learn for a ring CC to the UI thread,
+ * then plays bursts of notes from a producer thread (standing in for the
+ * RtMidi thread) into a consumer that wakes on an audio block clock, and
+ * reports end-to-end note latency percentiles for two ways of handling
+ * the drained messages:
+ *
+ *   block start  every message lands on sample 0 of the block (what a
+ *                callback that only sets flags for the next block gets)
+ *   timestamped  messages keep their arrival offset, one block later
+ *
+ * Options: --bursts N --burst-size N --block SAMPLES --rate HZ --gap-ms MAX
+ */
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+void pushNote(MidiInputRing& ring, uint8_t note, uint64_t timestampNs) {
+    const uint8_t bytes[3] = {0x90, note, 100};
+    ring.push(bytes, 3, timestampNs);
+}
+
+void testRing() {
+    std::cout << "\n=== Ring ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 480;                 // 10 ms
+    const uint64_t blockStart = 1000000000;    // Block period is [0.99 s, 1.0 s)
+
+    MidiInputRing ring(8);
+    pushNote(ring, 60, blockStart - 20000000);  // Before the period (late drain)
+    pushNote(ring, 61, blockStart - 10000000);  // Period start
+    pushNote(ring, 62, blockStart - 5000000);   // Halfway
+    pushNote(ring, 63, blockStart + 1000);      // After the block start
+
+    std::vector<std::pair<int, int>> received;
+    size_t handled = ring.drain(blockStart, sampleRate, blockSize, [&](const TimestampedMidi& message, int offset) {
+        received.emplace_back(message.bytes[1], offset);
+    });
+    check(handled == 3 && received.size() == 3 && received[0].first == 60 && received[2].first == 62,
+          "Messages before the block start drain in arrival order");
+    check(received.size() == 3 && received[0].second == 0 && received[1].second == 0 && received[2].second == 240,
+          "Offsets follow arrival time within the block period");
+    check(ring.size() == 1, "Message stamped after the block start waits for the next block");
+
+    received.clear();
+    ring.drain(blockStart + 10000000, sampleRate, blockSize, [&](const TimestampedMidi& message, int offset) {
+        received.emplace_back(message.bytes[1], offset);
+    });
+    check(received.size() == 1 && received[0].first == 63 && received[0].second == 0,
+          "It is delivered next block at offset 0");
+
+    MidiInputRing small(4);
+    for (int i = 0; i < 6; ++i) {
+        pushNote(small, static_cast<uint8_t>(i), 1);
+    }
+    const uint8_t sysex[5] = {0xF0, 0x7E, 0x7F, 0x06, 0xF7};
+    small.push(sysex, sizeof(sysex), 1);
+    check(small.capacity() == 4 && small.size() == 4 && small.getDroppedCount() == 3,
+          "Overflow and SysEx are dropped and counted");
+
+    TimestampedMidi bend;
+    bend.size = 3;
+    bend.bytes[0] = 0xE3;
+    bend.bytes[1] = 0x00;
+    bend.bytes[2] = 0x40;
+    MidiMessage message = MidiInputRing::toMidiMessage(bend);
+    check(message.type == MidiMessage::Type::PitchBend && message.channel == 3 && message.data2 == 0x40,
+          "Raw bytes convert to MidiMessage with 0-based channels");
+
+    // Push/drain cost on one thread
+    MidiInputRing costRing(1024);
+    const int rounds = 200000;
+    uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < 4; ++i) {
+            pushNote(costRing, static_cast<uint8_t>(i), static_cast<uint64_t>(r));
+        }
+        costRing.drain(static_cast<uint64_t>(r) + 1, sampleRate, blockSize,
+                       [&sink](const TimestampedMidi& m, int offset) { sink += m.bytes[1] + offset; });
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::fixed << std::setprecision(1) << "Push + drain: " << seconds * 1e9 / (rounds * 4.0)
+              << " ns per message (checksum " << sink << ")" << std::endl;
+}
+
+void testRender() {
+    std::cout << "\n=== Sample-accurate render ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 480;
+    const uint64_t blockStart = 1000000000;
+
+    Synthesizer synth(static_cast<int>(sampleRate));
+    synth.initialize();
+    MidiManager manager(&synth);
+    manager.enableInputRing(16);
+    pushNote(*manager.getInputRing(), 69, blockStart - 5000000);  // Offset 240
+
+    std::vector<float> buffer(blockSize * 2, 1.0f);
+    size_t handled = manager.processInputRing(buffer.data(), blockSize, blockStart, sampleRate);
+
+    auto peak = [&](int from, int to) {
+        float result = 0.0f;
+        for (int i = from * 2; i < to * 2; ++i) {
+            result = std::max(result, std::abs(buffer[i]));
+        }
+        return result;
+    };
+    check(handled == 1 && peak(0, 240) == 0.0f, "Block is silent before the note's offset");
+    check(peak(240, blockSize) > 0.0f, "Note sounds from its offset on");
+}
+
+class LearnListener : public MidiManager::Listener {
+public:
+    std::thread::id learnCompleteThread;
+
+    void parameterChangedViaMidi(const std::string& paramId, float) override {
+        if (paramId == "midi_learn_complete") {
+            learnCompleteThread = std::this_thread::get_id();
+        }
+    }
+    void pitchBendChanged(int, float) override {}
+    void modWheelChanged(int, float) override {}
+    void afterTouchChanged(int, float) override {}
+};
+
+void testLearn() {
+    std::cout << "\n=== MIDI learn from the ring ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 480;
+    const uint64_t blockStart = 1000000000;
+
+    Synthesizer synth(static_cast<int>(sampleRate));
+    synth.initialize();
+    LearnListener listener;
+    MidiManager manager(&synth, &listener);
+    manager.enableInputRing(16);
+    manager.armMidiLearn("master_volume");
+
+    const uint8_t cc[3] = {0xB2, 20, 0};
+    manager.getInputRing()->push(cc, 3, blockStart - 5000000);
+
+    // The audio thread only records the controller
+    std::vector<float> buffer(blockSize * 2);
+    std::thread audio([&]() { manager.processInputRing(buffer.data(), blockSize, blockStart, sampleRate); });
+    audio.join();
+    check(!manager.isMidiMapped("master_volume") && listener.learnCompleteThread == std::thread::id(),
+          "Audio thread leaves the learned mapping to the UI thread");
+
+    check(manager.processMidiLearn() && manager.isMidiMapped("master_volume"), "processMidiLearn() maps the captured CC");
+    check(listener.learnCompleteThread == std::this_thread::get_id(), "Learn completes on the calling thread");
+    check(synth.getParameter("master_volume") == 0.0f, "Captured value is applied to the learned parameter");
+
+    const uint8_t move[3] = {0xB2, 20, 127};
+    manager.getInputRing()->push(move, 3, blockStart + 1000000);
+    manager.processInputRing(buffer.data(), blockSize, blockStart + 10000000, sampleRate);
+    check(!manager.processMidiLearn() && synth.getParameter("master_volume") == 1.0f,
+          "Later CCs drive the mapped parameter from the ring");
+}
+
+struct Options {
+    int bursts = 200;
+    int burstSize = 16;
+    int blockSize = 128;
+    double sampleRate = 48000.0;
+    int maxGapMs = 10;
+};
+
+double percentile(std::vector<double>& values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[static_cast<size_t>(p * (values.size() - 1))];
+}
+
+void report(const std::string& name, std::vector<double>& latencyUs) {
+    double p1 = percentile(latencyUs, 0.01);
+    double p50 = percentile(latencyUs, 0.50);
+    double p99 = percentile(latencyUs, 0.99);
+    std::cout << std::fixed << std::setprecision(0) << std::setw(12) << name
+              << "  p50 " << std::setw(5) << p50 << " us  p90 " << std::setw(5) << percentile(latencyUs, 0.90)
+              << " us  p99 " << std::setw(5) << p99 << " us  max " << std::setw(5) << latencyUs.back()
+              << " us  jitter (p99-p1) " << std::setw(5) << p99 - p1 << " us" << std::endl;
+}
+
+void testBursts(const Options& options) {
+    std::cout << "\n=== Burst latency (" << options.bursts << " bursts of " << options.burstSize << ", "
+              << options.blockSize << " samples at " << options.sampleRate << " Hz) ===" << std::endl;
+
+    MidiInputRing ring(1024);
+    const uint64_t periodNs = static_cast<uint64_t>(options.blockSize * 1e9 / options.sampleRate);
+    std::atomic<bool> producing{true};
+
+    std::thread producer([&]() {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> gapUs(0, options.maxGapMs * 1000);
+        for (int b = 0; b < options.bursts; ++b) {
+            std::this_thread::sleep_for(std::chrono::microseconds(gapUs(rng)));
+            for (int i = 0; i < options.burstSize; ++i) {
+                pushNote(ring, static_cast<uint8_t>(36 + i % 64), MidiInputRing::nowNs());
+            }
+        }
+        producing.store(false);
+    });
+
+    std::vector<double> blockStartUs;
+    std::vector<double> timestampedUs;
+    std::vector<double> wakeLateUs;
+    const size_t expected = static_cast<size_t>(options.bursts) * options.burstSize;
+    blockStartUs.reserve(expected);
+    timestampedUs.reserve(expected);
+
+    // Consumer runs on an ideal block clock, like an audio callback paced by the DAC
+    uint64_t blockStart = MidiInputRing::nowNs() + periodNs;
+    while (producing.load() || ring.size() > 0) {
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(blockStart)));
+        wakeLateUs.push_back((MidiInputRing::nowNs() - blockStart) / 1000.0);
+
+        ring.drain(blockStart, options.sampleRate, options.blockSize, [&](const TimestampedMidi& message, int offset) {
+            blockStartUs.push_back((blockStart - message.timestampNs) / 1000.0);
+            double renderNs = blockStart + offset * 1e9 / options.sampleRate;
+            timestampedUs.push_back((renderNs - message.timestampNs) / 1000.0);
+        });
+        blockStart += periodNs;
+    }
+    producer.join();
+
+    check(timestampedUs.size() == expected && ring.getDroppedCount() == 0,
+          "All " + std::to_string(expected) + " notes delivered, none dropped");
+
+    std::cout << "Block period " << periodNs / 1000 << " us; consumer woke late by p99 "
+              << std::setprecision(0) << percentile(wakeLateUs, 0.99) << " us" << std::endl;
+    report("block start", blockStartUs);
+    report("timestamped", timestampedUs);
+
+    double blockJitter = percentile(blockStartUs, 0.99) - percentile(blockStartUs, 0.01);
+    double stampedJitter = percentile(timestampedUs, 0.99) - percentile(timestampedUs, 0.01);
+    check(stampedJitter < blockJitter / 2, "Timestamped delivery at least halves note jitter");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== MIDI Input Ring / Burst Latency Test ===" << std::endl;
+
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--bursts") options.bursts = std::stoi(argv[i + 1]);
+        else if (arg == "--burst-size") options.burstSize = std::stoi(argv[i + 1]);
+        else if (arg == "--block") options.blockSize = std::stoi(argv[i + 1]);
+        else if (arg == "--rate") options.sampleRate = std::stod(argv[i + 1]);
+        else if (arg == "--gap-ms") options.maxGapMs = std::stoi(argv[i + 1]);
+    }
+
+    testRing();
+    testRender();
+    testLearn();
+    testBursts(options);
+
+    std::cout << "\n" << (failures == 0 ? "All MIDI input ring checks passed" : "MIDI input ring checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
+#include <cmath>
 #include "../include/midi/MidiCCLearning.h"
 
 using namespace AIMusicHardware;
@@ -186,6 +187,83 @@ int main() {
         std::cout << "Failed to save mappings!" << std::endl;
     }
     
+    std::cout << "\n=== Test 7: Dispatch Table ===" << std::endl;
+    
+    // Precompiled table: channel-specific mappings win over "any channel" ones
+    learning.stopLearning();
+    learning.clearAllMappings();
+    
+    MidiCCLearning::CCMapping anyChannel;
+    anyChannel.channel = -1;
+    anyChannel.ccNumber = 20;
+    anyChannel.parameterId = "osc_mix";
+    anyChannel.minValue = 0.0f;
+    anyChannel.maxValue = 1.0f;
+    anyChannel.curveType = MidiCCLearning::CCMapping::CurveType::Exponential;
+    learning.createMapping(anyChannel);
+    
+    MidiCCLearning::CCMapping channelSpecific = anyChannel;
+    channelSpecific.channel = 3;
+    channelSpecific.parameterId = "filter_drive";
+    channelSpecific.minValue = 20.0f;
+    channelSpecific.maxValue = 20000.0f;
+    channelSpecific.curveType = MidiCCLearning::CCMapping::CurveType::Linear;
+    channelSpecific.inverted = true;
+    learning.createMapping(channelSpecific);
+    
+    std::string lastParam;
+    float lastValue = -1.0f;
+    int lastIndex = -1;
+    learning.setParameterChangeCallback([&](const std::string& paramId, float value) {
+        lastParam = paramId;
+        lastValue = value;
+    });
+    learning.setParameterIndexCallback([&](int parameterIndex, float) {
+        lastIndex = parameterIndex;
+    });
+    
+    bool tableOk = true;
+    for (int value = 0; value < 128; ++value) {
+        float normalized = value / 127.0f;
+        learning.processMidiCC(5, 20, value, "Test");
+        tableOk = tableOk && lastParam == "osc_mix" &&
+                  std::abs(lastValue - normalized * normalized) < 1e-5f &&
+                  lastIndex == learning.getParameterIndex("osc_mix");
+        learning.processMidiCC(3, 20, value, "Test");
+        tableOk = tableOk && lastParam == "filter_drive" &&
+                  std::abs(lastValue - (20.0f + (1.0f - normalized) * 19980.0f)) < 1e-2f &&
+                  lastIndex == learning.getParameterIndex("filter_drive");
+    }
+    std::cout << (tableOk ? "✅" : "❌") << " Table values match curves on all 128 steps" << std::endl;
+    
+    learning.processMidiCC14(3, 20, 8192);
+    bool fine = std::abs(lastValue - (20.0f + (1.0f - 8192.0f / 16383.0f) * 19980.0f)) < 1e-2f;
+    std::cout << (fine ? "✅" : "❌") << " 14-bit value bypasses 7-bit quantization: " << lastValue << std::endl;
+    
+    lastParam.clear();
+    learning.removeMapping(3, 20);
+    learning.processMidiCC(3, 20, 127, "Test");
+    bool fallback = lastParam == "osc_mix";
+    std::cout << (fallback ? "✅" : "❌") << " Removing a mapping republishes the table" << std::endl;
+    
+    // Dispatch cost per message on the MIDI thread path
+    const int messages = 1000000;
+    float sink = 0.0f;
+    learning.setParameterChangeCallback([&sink](const std::string&, float value) { sink += value; });
+    learning.setParameterIndexCallback(nullptr);
+    const std::string device = "Test";
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < messages; ++i) {
+        learning.processMidiCC(i & 15, 20, i & 127, device);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Dispatch: " << seconds * 1e9 / messages << " ns per CC (checksum " << sink << ")" << std::endl;
+    
+    if (!tableOk || !fine || !fallback) {
+        manager.shutdown();
+        return 1;
+    }
+    
     std::cout << "\n=== MIDI CC Learning Test Complete ===" << std::endl;
     
     // Shutdown manager
@@ -59,10 +59,14 @@ int main() {
     }
     std::cout << "Audio engine initialized successfully!" << std::endl;
     
+    // Queue MIDI input and apply it on the audio thread at its sample offsets
+    midiManager->enableInputRing();
+    
     // Set up audio callback
     audioEngine->setAudioCallback([&](float* outputBuffer, int numFrames) {
-        // Process synthesizer directly
-        synthesizer->process(outputBuffer, numFrames);
+        // Render the synthesizer, split at incoming MIDI events
+        midiManager->processInputRing(outputBuffer, numFrames, MidiInputRing::nowNs(),
+                                      audioEngine->getSampleRate());
     });
     
     // List available MIDI input devices
@@ -0,0 +1,226 @@
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/audio/ParameterStore.h"
+#include "../include/ui/ParameterUpdateQueue.h"
+#include "AllocationCounter.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Parameter store test
+ *
+ * Checks index registration, clamping, push-order merging across source
+ * queues and snapshot versioning, then runs four producer threads (one per
+ * source) against an audio thread and a snapshot reader to confirm nothing
+ * is lost or torn. Ends with push/apply cost next to the string-keyed
+ * ParameterUpdateSystem, and an allocation check for the audio side.
+ */
+
+namespace {
+
+using TestSupport::allocations;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+using Source = ParameterStore::ChangeSource;
+
+void testBasics() {
+    std::cout << "\n=== Registration and merging ===" << std::endl;
+
+    ParameterStore store(8);
+    int cutoff = store.addParameter("filter_cutoff", 0.5f);
+    int gain = store.addParameter("gain_db", 0.0f, -60.0f, 12.0f);
+    check(cutoff == 0 && gain == 1 && store.addParameter("filter_cutoff") == cutoff,
+          "IDs map to dense indices; re-adding returns the existing one");
+    check(store.getIndex("gain_db") == gain && store.getIndex("missing") == -1 && store.getId(gain) == "gain_db",
+          "Indices and IDs resolve both ways");
+
+    store.push(Source::UI, cutoff, 0.2f);
+    store.push(Source::MIDI, cutoff, 0.9f);
+    store.push(Source::Automation, gain, -6.0f);
+    store.push(Source::UI, cutoff, 0.4f);
+    store.push(Source::IoT, gain, 40.0f);
+    check(store.getValue(cutoff) == 0.5f && store.getQueuedCount(Source::UI) == 2, "Pushes wait for the audio thread");
+
+    size_t applied = store.processUpdates();
+    check(applied == 5 && store.getValue(cutoff) == 0.4f, "Sources merge in push order, last write wins");
+    check(store.getValue(gain) == 12.0f, "Values are clamped to the parameter range");
+    check(store.getChangedIndices().size() == 2, "Each changed parameter is listed once");
+
+    store.processUpdates();
+    check(store.getChangedIndices().empty(), "Change list resets every block");
+
+    check(!store.push(Source::UI, 7, 1.0f) && store.getDroppedCount(Source::UI) == 1, "Unknown indices are rejected");
+    int pushed = 0;
+    for (int i = 0; i < 10; ++i) {
+        pushed += store.push(Source::Preset, cutoff, 0.1f * i) ? 1 : 0;
+    }
+    check(pushed == 8 && store.getDroppedCount(Source::Preset) == 2 && store.getQueuedCount(Source::MIDI) == 0,
+          "A full queue drops only its own source's changes");
+    store.processUpdates();
+
+    std::vector<float> snapshot;
+    check(store.readSnapshot(snapshot) == 0 && snapshot.size() == 2 && snapshot[0] == 0.5f,
+          "Readers see defaults before the first publish");
+    check(store.publishSnapshot() && store.readSnapshot(snapshot) == 1 && snapshot[0] == store.getValue(cutoff),
+          "Publish makes audio values visible");
+    check(!store.publishSnapshot() && store.getSnapshotVersion() == 1, "Nothing changed, nothing published");
+    store.setValue(gain, -3.0f);
+    check(store.publishSnapshot() && store.readSnapshot(snapshot) == 2 && snapshot[1] == -3.0f,
+          "Audio-side writes publish too");
+}
+
+void testThreads() {
+    std::cout << "\n=== Concurrent producers and reader ===" << std::endl;
+
+    const int numParams = 64;
+    const int perProducer = 200000;
+    ParameterStore store(4096);
+    for (int i = 0; i < numParams; ++i) {
+        store.addParameter("p" + std::to_string(i), 0.0f, 0.0f, 1e9f);
+    }
+    // The last parameter is written only by the audio thread as a frame stamp
+    const int stamp = numParams - 1;
+
+    const Source sources[] = {Source::UI, Source::MIDI, Source::IoT, Source::Automation};
+    std::atomic<int> running{4};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < perProducer; ++i) {
+                // Each producer owns a quarter of the first 60 parameters
+                while (!store.push(sources[p], p * 15 + i % 15, static_cast<float>(i))) {
+                    std::this_thread::yield();
+                }
+            }
+            running.fetch_sub(1);
+        });
+    }
+
+    // Reader: every snapshot must be one whole audio frame
+    std::atomic<bool> reading{true};
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    uint64_t backwards = 0;
+    std::thread reader([&]() {
+        std::vector<float> values;
+        uint64_t lastVersion = 0;
+        while (reading.load()) {
+            uint64_t version = store.readSnapshot(values);
+            // Audio thread stamps parameters 60-62 and the stamp with the frame
+            if (values[60] != values[stamp] || values[61] != values[stamp] || values[62] != values[stamp]) {
+                ++torn;
+            }
+            if (version < lastVersion) {
+                ++backwards;
+            }
+            lastVersion = version;
+            ++reads;
+        }
+    });
+
+    size_t applied = 0;
+    int frame = 0;
+    while (running.load() > 0 || applied < static_cast<size_t>(4 * perProducer)) {
+        applied += store.processUpdates();
+        ++frame;
+        for (int i = 60; i < numParams; ++i) {
+            store.setValue(i, static_cast<float>(frame));
+        }
+        store.publishSnapshot();
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    reading.store(false);
+    reader.join();
+
+    check(applied == 4u * perProducer, "All " + std::to_string(4 * perProducer) + " changes from 4 producers applied");
+    bool finalValues = true;
+    for (int i = 0; i < 60; ++i) {
+        // Last value each producer wrote to parameter i
+        const int last = perProducer - 1 - ((perProducer - 1) % 15 - i % 15 + 15) % 15;
+        finalValues &= store.getValue(i) == static_cast<float>(last);
+    }
+    check(finalValues, "Every parameter ends at its producer's last value");
+    check(torn == 0 && backwards == 0, std::to_string(reads) + " snapshot reads over " + std::to_string(frame) +
+          " frames, none torn or out of order");
+}
+
+void testCost() {
+    std::cout << "\n=== Cost ===" << std::endl;
+
+    const int numParams = 256;
+    const int changesPerBlock = 64;
+    const int blocks = 20000;
+
+    ParameterStore store(1024);
+    std::vector<std::string> ids;
+    for (int i = 0; i < numParams; ++i) {
+        ids.push_back("param_" + std::to_string(i));
+        store.addParameter(ids.back());
+    }
+    store.publishSnapshot();
+
+    size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < blocks; ++b) {
+        for (int c = 0; c < changesPerBlock; ++c) {
+            store.push(c & 1 ? Source::MIDI : Source::UI, (b * 7 + c * 13) % numParams, (c & 15) / 16.0f);
+        }
+        store.processUpdates();
+        store.publishSnapshot();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t allocated = allocations - before;
+    check(allocated == 0, "No allocations in push, processUpdates or publishSnapshot");
+
+    std::cout << std::fixed << std::setprecision(1) << "ParameterStore push + apply (+ publish of " << numParams
+              << "): " << seconds * 1e9 / (blocks * changesPerBlock) << " ns per change" << std::endl;
+
+    // Same traffic through the string-keyed queue, applied by lookup
+    auto& system = ParameterUpdateSystem::getInstance();
+    std::unordered_map<std::string, float> values;
+    for (const auto& id : ids) {
+        values[id] = 0.0f;
+    }
+    before = allocations;
+    start = std::chrono::steady_clock::now();
+    for (int b = 0; b < blocks; ++b) {
+        for (int c = 0; c < changesPerBlock; ++c) {
+            system.pushToAudio(ids[(b * 7 + c * 13) % numParams], (c & 15) / 16.0f);
+        }
+        system.processAudioUpdates([&values](const ParameterUpdateQueue<>::ParameterChange& change) {
+            values[change.id] = change.value;
+        }, changesPerBlock);
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "ParameterUpdateSystem push + apply: " << seconds * 1e9 / (blocks * changesPerBlock)
+              << " ns per change, " << std::setprecision(2)
+              << static_cast<double>(allocations - before) / (blocks * changesPerBlock) << " allocations per change"
+              << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Parameter Store Test ===" << std::endl;
+
+    testBasics();
+    testThreads();
+    testCost();
+
+    std::cout << "\n" << (failures == 0 ? "All parameter store checks passed" : "Parameter store checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstring>
+#include "../include/ui/DisplayManager.h"
+#include "../include/ui/Font.h"
+#include "../include/ui/SpanRasterizer.h"
+
+using namespace AIMusicHardware;
+
+namespace {
+
+// Blocky 6x9 procedural font so text has real coverage to blend
+std::unique_ptr<Font> createTestFont() {
+    auto font = std::make_unique<Font>();
+    font->create(9);
+    for (uint32_t c = 32; c < 127; ++c) {
+        Glyph glyph;
+        glyph.codepoint = c;
+        glyph.width = 6;
+        glyph.height = 9;
+        glyph.xAdvance = 7;
+        glyph.xOffset = 0;
+        glyph.yOffset = 0;
+        glyph.bitmap.resize(54);
+        for (int i = 0; i < 54; ++i) {
+            glyph.bitmap[i] = ((c * 31 + i * 17) % 5 == 0) ? 0 : static_cast<uint8_t>((c * 7 + i * 13) % 256);
+        }
+        font->addGlyph(glyph);
+    }
+    return font;
+}
+
+bool verifyKernels() {
+    std::cout << "\n=== Span kernel verification (" << SpanRasterizer::backendName() << ") ===" << std::endl;
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> byte(0, 255);
+    int mismatches = 0;
+
+    for (int trial = 0; trial < 2000; ++trial) {
+        int count = trial % 67;
+        bool translucent = (trial % 3) == 0;
+        Color color(byte(rng), byte(rng), byte(rng), static_cast<uint8_t>(byte(rng)));
+
+        std::vector<uint8_t> a(count * 4 + 4), coverage(count + 4);
+        for (size_t i = 0; i < a.size(); ++i) {
+            a[i] = static_cast<uint8_t>(byte(rng));
+            if (i % 4 == 3 && !(translucent && byte(rng) < 64)) {
+                a[i] = 255;
+            }
+        }
+        for (auto& c : coverage) {
+            c = static_cast<uint8_t>(byte(rng) < 40 ? 0 : byte(rng));
+        }
+        std::vector<uint8_t> b = a;
+
+        SpanRasterizer::blend(a.data(), count, color);
+        SpanRasterizer::blendReference(b.data(), count, color);
+        if (a != b) ++mismatches;
+
+        SpanRasterizer::blendMask(a.data(), coverage.data(), count, color);
+        SpanRasterizer::blendMaskReference(b.data(), coverage.data(), count, color);
+        if (a != b) ++mismatches;
+    }
+
+    std::cout << (mismatches == 0 ? "✅" : "❌") << " Vector kernels match reference: "
+              << mismatches << " mismatching spans" << std::endl;
+    return mismatches == 0;
+}
+
+// One frame of a busy synth page: 24 knobs, 8 sliders, meters, buttons, labels
+void recordSynthPage(DrawBatch& batch, Font* font, int frame) {
+    batch.clear();
+    batch.fillRect(0, 0, 800, 480, Color(30, 30, 34));
+    batch.fillRect(0, 0, 800, 32, Color(45, 45, 55));
+    batch.drawText(12, 12, "AI MUSIC HARDWARE - PATCH 042 INIT LEAD", font, Color(230, 230, 230));
+
+    for (int k = 0; k < 24; ++k) {
+        int cx = 50 + (k % 8) * 90;
+        int cy = 80 + (k / 8) * 110;
+        batch.fillCircle(cx, cy, 28, Color(60, 60, 70));
+        batch.drawCircle(cx, cy, 28, Color(0, 180, 255));
+        batch.fillCircle(cx, cy, 26, Color(255, 120, 0, 48));
+        batch.drawLine(cx, cy, cx + (k * 7 + frame) % 20 - 10, cy - 20, Color(230, 230, 230));
+        batch.drawText(cx - 20, cy + 34, "CUTOFF", font, Color(200, 200, 200));
+        batch.drawText(cx - 14, cy + 46, "0.50", font, Color(150, 150, 150, 200));
+    }
+
+    for (int s = 0; s < 8; ++s) {
+        int x = 30 + s * 50;
+        batch.fillRect(x, 380, 12, 90, Color(50, 50, 60));
+        batch.fillRect(x, 380 + (s * 11 + frame) % 80, 12, 10, Color(0, 180, 255, 200));
+        batch.drawRect(x - 1, 379, 14, 92, Color(120, 120, 130));
+    }
+
+    for (int m = 0; m < 2; ++m) {
+        int level = (frame * 13 + m * 40) % 200;
+        batch.fillRect(740 + m * 24, 260, 16, 200, Color(20, 20, 20));
+        batch.fillRect(740 + m * 24, 460 - level, 16, level, Color(60, 200, 60, 220));
+    }
+
+    for (int b = 0; b < 6; ++b) {
+        batch.fillRect(450 + (b % 3) * 90, 380 + (b / 3) * 45, 80, 36, Color(70, 70, 80));
+        batch.drawRect(450 + (b % 3) * 90, 380 + (b / 3) * 45, 80, 36, Color(150, 150, 150));
+        batch.drawText(462 + (b % 3) * 90, 394 + (b / 3) * 45, "PRESET", font, Color(255, 255, 255));
+    }
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Span Rasterizer Benchmark ===" << std::endl;
+
+    bool ok = verifyKernels();
+
+    DisplayManager display;
+    display.initialize(800, 480);
+    auto font = createTestFont();
+    DrawBatch batch;
+
+    // Warm up layout cache and batch storage
+    recordSynthPage(batch, font.get(), 0);
+    display.submit(batch);
+
+    const int frames = 500;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        recordSynthPage(batch, font.get(), frame);
+        display.submit(batch);
+        display.swapBuffers();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double frameMs = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+
+    std::cout << "\n=== Full synth page (800x480, " << batch.size() << " primitives) ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Average frame: " << frameMs << " ms" << std::endl;
+    std::cout << (frameMs < 1.0 ? "✅" : "⚠️ ") << " Target: under 1 ms per full page" << std::endl;
+
+    // Per-pixel baseline for comparison: the same background fill via setPixel
+    start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < 20; ++frame) {
+        for (int y = 0; y < 480; ++y) {
+            for (int x = 0; x < 800; ++x) {
+                display.setPixel(x, y, Color(30, 30, 34, 200));
+            }
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double perPixelMs = std::chrono::duration<double, std::milli>(end - start).count() / 20;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < 20; ++frame) {
+        display.fillRect(0, 0, 800, 480, Color(30, 30, 34, 200));
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double spanMs = std::chrono::duration<double, std::milli>(end - start).count() / 20;
+
+    std::cout << "\n=== Translucent full-screen fill ===" << std::endl;
+    std::cout << "Per-pixel setPixel: " << perPixelMs << " ms" << std::endl;
+    std::cout << "Span fillRect:      " << spanMs << " ms ("
+              << std::setprecision(1) << perPixelMs / spanMs << "x)" << std::endl;
+
+    std::cout << "\n" << (ok ? "All rasterizer checks passed" : "Rasterizer checks FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
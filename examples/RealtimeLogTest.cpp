@@ -0,0 +1,271 @@
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/audio/RealtimeLog.h"
+#include "AllocationCounter.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Real-time logging test
+ *
+ * Checks that records are formatted with their arguments by the drain, that
+ * levels below AIMUSIC_RT_LOG_LEVEL are compiled out, that logging from a
+ * prepared thread allocates nothing, that concurrent threads' records all
+ * arrive in order, that a full ring drops and reports, and that drained
+ * records rotate through PresetLogger's FileLogOutput. Reports the cost of
+ * a logging call.
+ */
+
+namespace {
+
+using TestSupport::allocations;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+// Collects what a PresetLogger writes
+class CaptureOutput : public LogOutput {
+public:
+    void write(const LogEntry& entry) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.push_back(entry);
+    }
+    void flush() override {}
+    bool isEnabled() const override { return true; }
+    void setEnabled(bool) override {}
+
+    std::vector<LogEntry> take() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<LogEntry> entries;
+        entries.swap(entries_);
+        return entries;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<LogEntry> entries_;
+};
+
+struct Capture {
+    Capture() : output(std::make_shared<CaptureOutput>()) {
+        logger.setLogLevel(LogLevel::Trace);
+        LogFilter filter;
+        filter.setMinLevel(LogLevel::Trace);
+        logger.setFilter(filter);
+        logger.addOutput(output);
+    }
+
+    PresetLogger logger;
+    std::shared_ptr<CaptureOutput> output;
+};
+
+enum class Mode { Off, Mono, Poly };
+
+void testFormatting() {
+    std::cout << "\n=== Formatting ===" << std::endl;
+
+    Capture capture;
+    RealtimeLog log;
+    log.setLogger(&capture.logger);
+
+    const std::string effect = "Reverb";
+    RT_LOG_TO(log, LogLevel::Info, LogCategory::Audio, "Pitch bend {} on channel {}", 0.5f, 3);
+    RT_LOG_TO(log, LogLevel::Error, LogCategory::Audio, "Error processing effect {}: {}", effect, "bad buffer");
+    RT_LOG_TO(log, LogLevel::Warning, LogCategory::Audio, "Mode {}, sustain {}, frames {}", Mode::Poly, true, 512u);
+    RT_LOG_TO(log, LogLevel::Info, LogCategory::Audio, "{} {}", std::string(100, 'x'), "cut");
+
+    check(log.drain() == 4, "Drain hands over every queued record");
+    const auto entries = capture.output->take();
+    check(entries.size() == 4, "Every record reaches the PresetLogger outputs");
+    if (entries.size() == 4) {
+        check(entries[0].message == "Pitch bend 0.5 on channel 3" && entries[0].level == LogLevel::Info &&
+                  entries[0].category == LogCategory::Audio,
+              "Numbers, level and category come through");
+        check(entries[1].message == "Error processing effect Reverb: bad buffer" &&
+                  entries[1].function == "testFormatting" && entries[1].line > 0,
+              "Strings are copied and the call site is recorded");
+        check(entries[2].message == "Mode 2, sustain true, frames 512", "Enums, bools and unsigned values format");
+        check(entries[3].message == std::string(RealtimeLog::kMaxText, 'x') + " ",
+              "Text beyond the record's capacity is truncated");
+        check(entries[0].threadId == std::this_thread::get_id(), "Entries carry the logging thread");
+    }
+}
+
+void testCompileTimeFilter() {
+    std::cout << "\n=== Compile-time level filter ===" << std::endl;
+
+    Capture capture;
+    RealtimeLog log;
+    log.setLogger(&capture.logger);
+
+    int evaluated = 0;
+    RT_LOG_TO(log, LogLevel::Trace, LogCategory::Audio, "Trace {}", ++evaluated);
+    RT_LOG_TO(log, LogLevel::Debug, LogCategory::Audio, "Debug {}", ++evaluated);
+    RT_LOG_TO(log, LogLevel::Info, LogCategory::Audio, "Info {}", ++evaluated);
+
+    check(AIMUSIC_RT_LOG_LEVEL == static_cast<int>(LogLevel::Info), "Info is the default compiled-in level");
+    check(evaluated == 1, "Arguments of compiled-out calls are never evaluated");
+    check(log.drain() == 1 && log.getRingCount() == 1, "Only the enabled call queued a record");
+}
+
+void testAllocations() {
+    std::cout << "\n=== Allocation-free logging ===" << std::endl;
+
+    const int calls = 100000;
+    RealtimeLog log(calls);
+    log.setLogger(nullptr);
+
+    size_t allocated = 0;
+    double seconds = 0.0;
+    std::thread audio([&]() {
+        log.prepareThread();
+        const std::string effect = "Chorus";
+        size_t before = allocations;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < calls; ++i) {
+            RT_LOG_TO(log, LogLevel::Warning, LogCategory::Audio, "Block {} of {} took {} ms", i, effect, i * 0.01);
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        allocated = allocations - before;
+    });
+    audio.join();
+
+    check(allocated == 0, "Logging from a prepared thread does not allocate");
+    check(log.drain() == static_cast<size_t>(calls) && log.getDroppedCount() == 0, "Nothing was dropped");
+    std::cout << std::fixed << std::setprecision(1) << "Logging call: " << seconds * 1e9 / calls << " ns"
+              << std::endl;
+}
+
+void testThreads() {
+    std::cout << "\n=== Concurrent threads ===" << std::endl;
+
+    const int threads = 4;
+    const int perThread = 10000;
+    Capture capture;
+    RealtimeLog log(4096);
+    log.setLogger(&capture.logger);
+    log.start(std::chrono::milliseconds(1));
+
+    auto wave = [&]() {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&log, t]() {
+                for (int i = 0; i < perThread; ++i) {
+                    RT_LOG_TO(log, LogLevel::Info, LogCategory::Audio, "{} {}", t, i);
+                    // Stay within the ring between drains
+                    if ((i & 127) == 127) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    };
+
+    wave();
+    size_t ringsAfterFirst = 0;
+    // Wait for the drain to empty the exited threads' rings
+    for (int i = 0; i < 200 && log.getDrainedCount() < static_cast<uint64_t>(threads * perThread); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ringsAfterFirst = log.getRingCount();
+    wave();
+    log.stop();
+
+    const auto entries = capture.output->take();
+    std::vector<int> next(threads, 0);
+    bool ordered = true;
+    for (const auto& entry : entries) {
+        int t = 0;
+        int i = 0;
+        std::sscanf(entry.message.c_str(), "%d %d", &t, &i);
+        ordered &= t >= 0 && t < threads && i == next[t] % perThread;
+        ++next[t];
+    }
+    check(log.getDroppedCount() == 0 && entries.size() == static_cast<size_t>(2 * threads * perThread),
+          "All " + std::to_string(entries.size()) + " records from " + std::to_string(2 * threads) +
+              " threads arrived");
+    check(ordered, "Each thread's records stay in order");
+    check(ringsAfterFirst == static_cast<size_t>(threads) && log.getRingCount() == static_cast<size_t>(threads),
+          "Rings of exited threads are reused");
+    check(!log.isRunning(), "Drain thread stops");
+}
+
+void testDrops() {
+    std::cout << "\n=== Full ring ===" << std::endl;
+
+    Capture capture;
+    RealtimeLog log(8);
+    log.setLogger(&capture.logger);
+
+    for (int i = 0; i < 20; ++i) {
+        RT_LOG_TO(log, LogLevel::Info, LogCategory::Audio, "Record {}", i);
+    }
+    check(log.getDroppedCount() == 12, "Records beyond the ring capacity are dropped and counted");
+    check(log.drain() == 8, "The records that fit are kept");
+    const auto entries = capture.output->take();
+    check(entries.size() == 9 && entries.back().level == LogLevel::Warning &&
+              entries.back().message.find("dropped 12") != std::string::npos,
+          "The drain reports the drops");
+}
+
+void testRotation() {
+    std::cout << "\n=== File rotation ===" << std::endl;
+
+    const std::string path = (std::filesystem::temp_directory_path() / "realtime_log_test.log").string();
+    for (const auto& file : {path, path + ".1", path + ".2", path + ".3"}) {
+        std::filesystem::remove(file);
+    }
+
+    {
+        PresetLogger logger;
+        logger.addOutput(std::make_shared<FileLogOutput>(path, 4096, 3));
+        RealtimeLog log;
+        log.setLogger(&logger);
+        for (int i = 0; i < 200; ++i) {
+            RT_LOG_TO(log, LogLevel::Warning, LogCategory::Audio, "Buffer underrun {} at {} frames", i, 256);
+        }
+        log.drain();
+        logger.flush();
+    }
+
+    check(std::filesystem::exists(path) && std::filesystem::exists(path + ".1"),
+          "Drained records rotate through FileLogOutput");
+    check(std::filesystem::file_size(path) <= 4096 + 256, "The current file stays near its size limit");
+
+    for (const auto& file : {path, path + ".1", path + ".2", path + ".3"}) {
+        std::filesystem::remove(file);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Realtime Log Test ===" << std::endl;
+
+    testFormatting();
+    testCompileTimeFilter();
+    testAllocations();
+    testThreads();
+    testDrops();
+    testRotation();
+
+    std::cout << "\n" << (failures == 0 ? "All real-time log checks passed" : "Real-time log checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
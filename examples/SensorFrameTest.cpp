@@ -0,0 +1,263 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/iot/SensorFrameDecoder.h"
+#include "../include/iot/IoTEventAdapter.h"
+#include "../include/iot/IoTPayloadScanner.h"
+#include "../include/iot/LoopbackBroker.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Binary sensor frame test
+ *
+ * Decodes the recorded frames in test_sensor_frames/ (pass another
+ * directory as the first argument) and checks them against the readings
+ * listed in each fixture, then checks the writer, IoTEventAdapter
+ * integration and the size/CPU savings against the firmware's JSON.
+ *
+ * Fixture format: '#' comments, "payload <hex bytes>" lines (concatenated),
+ * "expect <sensor> <sequence> <timestamp ms> <values...>" per reading and an
+ * optional "status <name>" for frames that must be rejected.
+ */
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+bool near(float a, float b) {
+    return std::abs(a - b) <= 1e-4f * std::max(1.0f, std::abs(b));
+}
+
+struct Expectation {
+    std::string sensor;
+    uint16_t sequence = 0;
+    uint32_t timestampMs = 0;
+    std::vector<float> values;
+};
+
+struct Fixture {
+    std::string payload;
+    std::vector<Expectation> readings;
+    std::string status = "ok";
+};
+
+Fixture loadFixture(const std::filesystem::path& path) {
+    Fixture fixture;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string kind;
+        if (!(fields >> kind) || kind[0] == '#') {
+            continue;
+        }
+        if (kind == "payload") {
+            std::string byte;
+            while (fields >> byte) {
+                fixture.payload.push_back(static_cast<char>(std::stoi(byte, nullptr, 16)));
+            }
+        } else if (kind == "expect") {
+            Expectation expectation;
+            fields >> expectation.sensor >> expectation.sequence >> expectation.timestampMs;
+            float value;
+            while (fields >> value) {
+                expectation.values.push_back(value);
+            }
+            fixture.readings.push_back(expectation);
+        } else if (kind == "status") {
+            std::getline(fields, fixture.status);
+            fixture.status = std::string(IoTPayloadScanner::trim(fixture.status));
+        }
+    }
+    return fixture;
+}
+
+void testFixtures(const std::filesystem::path& directory) {
+    std::cout << "\n=== Recorded frames (" << directory.string() << ") ===" << std::endl;
+
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.path().extension() == ".frame") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    check(!files.empty(), "Fixtures found");
+
+    std::vector<SensorReading> readings(255);
+    for (const auto& path : files) {
+        Fixture fixture = loadFixture(path);
+        size_t count = 0;
+        auto status = SensorFrameDecoder::decode(fixture.payload, readings.data(), readings.size(), count);
+
+        bool ok = fixture.status == SensorFrameDecoder::statusName(status) && count == fixture.readings.size();
+        for (size_t i = 0; ok && i < count; ++i) {
+            const auto& expected = fixture.readings[i];
+            const auto& reading = readings[i];
+            const char* name = SensorFrame::typeName(reading.type);
+            ok = name && expected.sensor == name && expected.sequence == reading.sequence &&
+                 expected.timestampMs == reading.timestampMs && expected.values.size() == reading.valueCount;
+            for (size_t v = 0; ok && v < expected.values.size(); ++v) {
+                ok = near(reading.values[v], expected.values[v]);
+            }
+        }
+        check(ok, path.filename().string() + ": " + SensorFrameDecoder::statusName(status) +
+                  ", " + std::to_string(count) + " readings");
+    }
+}
+
+void testWriter() {
+    std::cout << "\n=== Writer ===" << std::endl;
+
+    uint8_t buffer[40];
+    SensorFrame::Writer writer(buffer, sizeof(buffer));
+    writer.begin(1000);
+    float xyz[3] = {0.25f, -40.0f, 9.81f};
+    check(writer.addInt16(SensorFrame::Acceleration, 1, 1005, xyz, 3, -3), "Record added");
+    check(!writer.addFloat(SensorFrame::Gyroscope, 1, 1005, xyz, 3), "Record that does not fit is rejected");
+    check(!writer.addInt16(SensorFrame::Temperature, 1, 999, xyz, 1, -2), "Timestamp before the base is rejected");
+    check(!writer.addInt16(SensorFrame::Temperature, 1, 1000 + 70000, xyz, 1, -2), "Offset beyond 65535 ms is rejected");
+
+    std::vector<SensorReading> readings(4);
+    size_t count = 0;
+    std::string payload(reinterpret_cast<const char*>(writer.data()), writer.size());
+    auto status = SensorFrameDecoder::decode(payload, readings.data(), readings.size(), count);
+    check(status == SensorFrameDecoder::Status::Ok && count == 1 && readings[0].timestampMs == 1005,
+          "Writer output decodes");
+    check(near(readings[0].values[0], 0.25f) && near(readings[0].values[1], -32.768f),
+          "int16 values quantize and saturate");
+
+    std::string text;
+    SensorFrameDecoder::formatValues(readings[0], text);
+    check(text == "0.25,-32.768,9.81", "Values render as CSV for text converters (" + text + ")");
+
+    check(SensorFrameDecoder::decode("{\"temperature\": 21}", readings.data(), readings.size(), count) ==
+          SensorFrameDecoder::Status::NotAFrame, "JSON payload is not a frame");
+    check(SensorFrameDecoder::decode(payload, readings.data(), 0, count) ==
+          SensorFrameDecoder::Status::TooManyRecords, "Output capacity is respected");
+}
+
+void testEventAdapter() {
+    std::cout << "\n=== IoTEventAdapter integration ===" << std::endl;
+
+    auto broker = std::make_shared<LoopbackBroker>();
+    LoopbackIoTInterface synth(broker);
+    LoopbackIoTInterface node(broker);
+    synth.connect("loopback", 1883, "synth");
+    node.connect("loopback", 1883, "node1");
+
+    FloatParameter temperature("temperature", "Temperature");
+    temperature.setRange(-40.0f, 85.0f);
+    FloatParameter motion("motion", "Motion");
+    motion.setRange(0.0f, 10.0f);
+
+    IoTEventAdapter adapter(&synth);
+    adapter.mapSensorFrames("AIMusicHardware/sensors/+/frame");
+    adapter.mapTopicToParameter("AIMusicHardware/sensors/+/frame/temperature", &temperature);
+    adapter.mapTopicToParameter("AIMusicHardware/sensors/+/frame/acceleration", &motion);
+    adapter.registerSensorType("AIMusicHardware/sensors/+/frame/acceleration",
+                               IoTParameterConverter::SensorType::ACCELERATION, 0.0f, 10.0f, false);
+    adapter.start();
+
+    uint8_t buffer[128];
+    SensorFrame::Writer writer(buffer, sizeof(buffer));
+    writer.begin(0);
+    float celsius = 21.5f;
+    float accel[3] = {3.0f, 4.0f, 0.0f};
+    writer.addFloat(SensorFrame::Temperature, 0, 0, &celsius, 1);
+    writer.addInt16(SensorFrame::Acceleration, 0, 0, accel, 3, -3);
+    node.publish("AIMusicHardware/sensors/node1/frame",
+                 std::string(reinterpret_cast<const char*>(writer.data()), writer.size()));
+    synth.update();
+
+    check(near(temperature.getValue(), 21.5f), "Temperature reading applied without text parsing");
+    check(near(motion.getValue(), 5.0f), "Acceleration reading goes through the sensor converter");
+    adapter.stop();
+}
+
+void testSavings() {
+    std::cout << "\n=== Size and decode cost versus JSON ===" << std::endl;
+
+    // Four motion snapshots, as the firmware batches them
+    uint8_t buffer[256];
+    SensorFrame::Writer writer(buffer, sizeof(buffer));
+    writer.begin(0);
+    std::vector<std::string> json;
+    for (int i = 0; i < 4; ++i) {
+        float accel[3] = {0.01f * i, -0.52f, 0.98f};
+        float gyro[3] = {1.25f, -0.5f * i, 0.03f};
+        writer.addInt16(SensorFrame::Acceleration, i, 20 * i, accel, 3, -3);
+        writer.addInt16(SensorFrame::Gyroscope, i, 20 * i, gyro, 3, -2);
+
+        std::ostringstream doc;
+        doc << std::fixed << std::setprecision(2) << "{\"device_id\":\"sensor_node_a4cf12\",\"timestamp\":" << 20 * i
+            << ",\"motion\":{\"acceleration\":{\"x\":" << accel[0] << ",\"y\":" << accel[1] << ",\"z\":" << accel[2]
+            << "},\"gyroscope\":{\"x\":" << gyro[0] << ",\"y\":" << gyro[1] << ",\"z\":" << gyro[2] << "}}}";
+        json.push_back(doc.str());
+    }
+    std::string frame(reinterpret_cast<const char*>(writer.data()), writer.size());
+
+    size_t jsonBytes = 0;
+    for (const auto& doc : json) jsonBytes += doc.size();
+    std::cout << "Binary frame: " << frame.size() << " bytes in 1 message; JSON: " << jsonBytes
+              << " bytes in " << json.size() << " messages" << std::endl;
+    check(frame.size() * 3 < jsonBytes, "Binary batch is less than a third of the JSON size");
+
+    const int rounds = 20000;
+    std::vector<SensorReading> readings(255);
+    float sink = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        size_t count = 0;
+        SensorFrameDecoder::decode(frame, readings.data(), readings.size(), count);
+        sink += readings[count - 1].values[0];
+    }
+    double binarySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto plan = IoTExtractionPlan::json({"x", "y", "z"});
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& doc : json) {
+            float values[3];
+            plan.extract(doc, values);
+            sink += values[0];
+        }
+    }
+    double jsonSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Decode: " << rounds * 8 / binarySeconds / 1e6 << "M readings/s binary, "
+              << rounds * 4 / jsonSeconds / 1e6 << "M snapshots/s JSON scan (checksum "
+              << std::setprecision(2) << sink << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Binary Sensor Frame Test ===" << std::endl;
+
+    std::filesystem::path fixtures = argc > 1 ? argv[1] : "test_sensor_frames";
+    if (argc <= 1 && !std::filesystem::exists(fixtures)) {
+        fixtures = "../test_sensor_frames";
+    }
+
+    testFixtures(fixtures);
+    testWriter();
+    testEventAdapter();
+    testSavings();
+
+    std::cout << "\n" << (failures == 0 ? "All sensor frame checks passed" : "Sensor frame checks FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/synthesis/framework/smoothing_engine.h"
+#include "../include/audio/Synthesizer.h"
+#include "../include/ui/SmoothParameter.h"
+#include "AllocationCounter.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Smoothing engine test
+ *
+ * Checks that linear and exponential ramps land on exact sample counts
+ * across blocks of any size, that retargeting and cross-thread targets
+ * start from the current value, that idle parameters are skipped, and that
+ * Synthesizer ramps master volume instead of jumping. Ends with the cost of
+ * a block for 256 parameters against per-sample SmoothParameter.
+ */
+
+namespace {
+
+using TestSupport::allocations;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+bool near(float a, float b, float tolerance = 1e-5f) {
+    return std::abs(a - b) <= tolerance;
+}
+
+using Ramp = SmoothingEngine::RampType;
+
+void testRamps() {
+    std::cout << "\n=== Ramps ===" << std::endl;
+
+    // 1000-sample ramps at 1 kHz keep the numbers readable
+    SmoothingEngine engine(1000, 8);
+    int lin = engine.addParameter(0.0f, Ramp::Linear, 1.0f);
+    int exp = engine.addParameter(0.01f, Ramp::Exponential, 1.0f);
+    int fallback = engine.addParameter(0.0f, Ramp::Exponential, 1.0f);
+    int idle = engine.addParameter(0.5f);
+
+    engine.setTarget(lin, 1.0f);
+    engine.setTarget(exp, 1.0f);
+    engine.setTarget(fallback, 1.0f);
+    check(engine.getValue(lin) == 0.0f && engine.isSmoothing(lin) && engine.getTarget(lin) == 1.0f,
+          "Targets wait for the next block");
+
+    bool linearExact = true;
+    for (int block = 1; block <= 15; ++block) {
+        engine.process(64);
+        linearExact &= near(engine.getValue(lin), block * 64 / 1000.0f);
+    }
+    check(linearExact, "Linear ramp is on its per-sample line at every block end");
+    check(near(engine.getValue(fallback), 0.96f), "Exponential ramp from zero falls back to linear");
+
+    // Geometric: value at sample k is 0.01 * 100^(k / 1000)
+    check(near(engine.getValue(exp), 0.01f * std::pow(100.0f, 0.96f), 1e-4f),
+          "Exponential ramp follows its curve (" + std::to_string(engine.getValue(exp)) + ")");
+    check(engine.getActiveCount() == 3 && !engine.hasChanged(idle) && engine.getBlockStartValue(idle) == 0.5f,
+          "Idle parameters are not touched");
+
+    // Switching block size mid-ramp keeps the sample count
+    engine.process(39);
+    check(engine.getValue(lin) == 0.999f || near(engine.getValue(lin), 0.999f), "Block size change keeps position");
+    check(engine.isSmoothing(lin), "One sample still to go at sample 999");
+    engine.process(1);
+    check(engine.getValue(lin) == 1.0f && engine.getValue(exp) == 1.0f && engine.getActiveCount() == 0,
+          "Ramps hit their targets exactly on sample 1000");
+    engine.process(64);
+    check(!engine.hasChanged(lin) && !engine.isSmoothing(lin), "Finished ramps drop out of the active set");
+
+    // Retarget mid-ramp: new ramp from where it is, full length again
+    engine.setTarget(lin, 0.0f);
+    engine.process(500);
+    engine.setTarget(lin, 1.0f);
+    engine.process(500);
+    check(near(engine.getValue(lin), 0.75f), "Retargeting ramps from the current value");
+    float ramp[500];
+    engine.fillRamp(lin, ramp, 500);
+    check(near(ramp[0], 0.5f + 0.0005f) && near(ramp[499], 0.75f), "fillRamp interpolates across the block");
+
+    engine.setImmediate(lin, 0.2f);
+    engine.process(64);
+    check(engine.getValue(lin) == 0.2f && !engine.isSmoothing(lin), "setImmediate jumps and cancels the ramp");
+
+    // A target posted from another thread is picked up at the next block
+    std::thread ui([&engine, idle]() { engine.setTarget(idle, 0.0f); });
+    ui.join();
+    engine.process(1000);
+    check(engine.getValue(idle) == 0.0f && engine.hasChanged(idle), "Cross-thread targets ramp like local ones");
+}
+
+void testSynthesizer() {
+    std::cout << "\n=== Synthesizer ===" << std::endl;
+
+    const int blockSize = 512;
+    Synthesizer synth(44100);
+    std::vector<float> buffer(blockSize * 2);
+
+    synth.noteOn(60, 0.9f);
+    for (int i = 0; i < 8; ++i) {
+        synth.process(buffer.data(), blockSize);
+    }
+
+    synth.setParameter("master_volume", 0.0f);
+    synth.setParameter("envelope_release", 2.0f);
+    check(synth.getParameter("master_volume") == 0.0f && synth.getParameter("envelope_release") == 2.0f,
+          "getParameter reports the requested values");
+
+    synth.process(buffer.data(), blockSize);
+    float firstPeak = 0.0f;
+    float lastPeak = 0.0f;
+    for (int i = 0; i < 32; ++i) {
+        firstPeak = std::max(firstPeak, std::abs(buffer[i]));
+        lastPeak = std::max(lastPeak, std::abs(buffer[blockSize * 2 - 1 - i]));
+    }
+    check(firstPeak > 0.01f && lastPeak < firstPeak, "Volume change ramps down instead of cutting");
+    check(synth.getSmoothingEngine().getActiveCount() == 2, "Volume and release are ramping");
+
+    synth.process(buffer.data(), blockSize);
+    check(synth.getSmoothingEngine().getActiveCount() == 0, "Both ramps end within 20 ms");
+    synth.process(buffer.data(), blockSize);
+    bool silent = true;
+    for (float sample : buffer) {
+        silent &= sample == 0.0f;
+    }
+    check(silent, "Silent once the volume ramp has ended");
+}
+
+void testCost() {
+    std::cout << "\n=== Cost (256 parameters, 128-sample blocks) ===" << std::endl;
+
+    const int numParams = 256;
+    const int blockSize = 128;
+    const int blocks = 20000;
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (int moving : {numParams, 16, 0}) {
+        SmoothingEngine engine(48000, numParams);
+        for (int i = 0; i < numParams; ++i) {
+            engine.addParameter(0.5f, i % 2 ? Ramp::Exponential : Ramp::Linear, 0.05f);
+        }
+
+        size_t before = allocations;
+        auto start = std::chrono::steady_clock::now();
+        for (int b = 0; b < blocks; ++b) {
+            // Keep the moving parameters moving
+            if (b % 16 == 0) {
+                for (int i = 0; i < moving; ++i) {
+                    engine.setTarget(i, (b / 16) % 2 ? 0.25f : 0.75f);
+                }
+            }
+            engine.process(blockSize);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        size_t allocated = allocations - before;
+        if (moving == numParams) {
+            check(allocated == 0, "No allocations in setTarget or process");
+        }
+        std::cout << std::setw(3) << moving << " moving: " << std::setw(8) << seconds * 1e9 / blocks
+                  << " ns per block" << std::endl;
+    }
+
+    std::vector<SmoothParameter> perSample(numParams, SmoothParameter(0.5f));
+    std::vector<float> out(blockSize);
+    float sink = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < blocks; ++b) {
+        if (b % 16 == 0) {
+            for (auto& parameter : perSample) {
+                parameter.setTarget((b / 16) % 2 ? 0.25f : 0.75f);
+            }
+        }
+        for (auto& parameter : perSample) {
+            parameter.processBuffer(out.data(), blockSize);
+            sink += out[blockSize - 1];
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "SmoothParameter::processBuffer, 256 moving: " << std::setw(8) << seconds * 1e9 / blocks
+              << " ns per block (checksum " << sink << ")" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Smoothing Engine Test ===" << std::endl;
+
+    testRamps();
+    testSynthesizer();
+    testCost();
+
+    std::cout << "\n" << (failures == 0 ? "All smoothing engine checks passed" : "Smoothing engine checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
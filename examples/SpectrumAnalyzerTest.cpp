@@ -0,0 +1,164 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <complex>
+#include <vector>
+#include <cmath>
+#include "../include/audio/FFT.h"
+#include "../include/ui/VisualizationComponents.h"
+#include "../include/ui/DisplayManager.h"
+
+using namespace AIMusicHardware;
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+void testFFTAgainstDFT() {
+    std::cout << "\n=== FFT vs direct DFT ===" << std::endl;
+
+    for (int size : {8, 64, 1024}) {
+        FFT fft(size, FFT::Window::Rectangular);
+        std::vector<float> input(size), real(fft.getNumBins()), imag(fft.getNumBins());
+        for (int i = 0; i < size; ++i) {
+            input[i] = std::sin(i * 0.37f) + 0.3f * std::cos(i * 1.9f) + 0.1f * (i % 3);
+        }
+        fft.performRealForward(input.data(), real.data(), imag.data());
+
+        double maxError = 0.0;
+        for (int k = 0; k < fft.getNumBins(); ++k) {
+            std::complex<double> sum = 0.0;
+            for (int n = 0; n < size; ++n) {
+                sum += static_cast<double>(input[n]) * std::polar(1.0, -2.0 * M_PI * k * n / size);
+            }
+            maxError = std::max(maxError, std::abs(sum - std::complex<double>(real[k], imag[k])));
+        }
+        check(maxError < 1e-3 * size, "Size " + std::to_string(size) + " matches DFT (max error " +
+              std::to_string(maxError) + ")");
+    }
+}
+
+void testSinePeak() {
+    std::cout << "\n=== Windowed sine peak ===" << std::endl;
+
+    FFT fft(1024);
+    std::vector<float> input(1024), magnitudes(fft.getNumBins());
+    for (int i = 0; i < 1024; ++i) {
+        input[i] = std::sin(2.0f * kPi * 64.0f * i / 1024.0f);
+    }
+    fft.computeMagnitudes(input.data(), magnitudes.data());
+
+    int peakBin = 0;
+    for (int k = 1; k < fft.getNumBins(); ++k) {
+        if (magnitudes[k] > magnitudes[peakBin]) peakBin = k;
+    }
+    check(peakBin == 64, "Peak lands on bin 64");
+    check(std::abs(magnitudes[64] - 1.0f) < 0.01f, "Full-scale sine reads 1.0 after window normalization");
+    check(magnitudes[80] < 1e-4f, "Hann window keeps leakage far from the peak below -80 dB");
+
+    LogFrequencyBands bands;
+    bands.configure(32, 1024, 44100.0f);
+    std::vector<float> bandValues(32);
+    bands.process(magnitudes.data(), bandValues.data());
+
+    float sineHz = fft.binFrequency(64, 44100.0f);
+    int loudest = 0;
+    for (int b = 1; b < 32; ++b) {
+        if (bandValues[b] > bandValues[loudest]) loudest = b;
+    }
+    check(std::abs(std::log2(bands.getBandCenter(loudest) / sineHz)) < 0.5,
+          "Loudest log band is centered within half an octave of " + std::to_string(static_cast<int>(sineHz)) + " Hz");
+
+    int silentBands = 0;
+    std::vector<float> flat(fft.getNumBins(), 0.5f);
+    bands.process(flat.data(), bandValues.data());
+    for (float value : bandValues) {
+        if (value <= 0.0f) ++silentBands;
+    }
+    check(silentBands == 0, "Narrow low-frequency bands are interpolated, none left empty");
+}
+
+void testConcurrentCapture() {
+    std::cout << "\n=== Audio thread capture while the UI analyses ===" << std::endl;
+
+    SpectrumAnalyzer analyzer("spectrum", 48);
+    analyzer.setSampleRate(48000.0f);
+    analyzer.setPosition(0, 0);
+    analyzer.setSize(400, 200);
+
+    DisplayManager display;
+    display.initialize(400, 200);
+
+    std::atomic<bool> running{true};
+    std::atomic<int64_t> worstPushNs{0};
+    std::atomic<int> blocks{0};
+
+    // Audio thread: 128-frame blocks of a 1 kHz sine
+    std::thread audio([&]() {
+        std::vector<float> block(128);
+        double phase = 0.0;
+        while (running.load(std::memory_order_relaxed)) {
+            for (float& sample : block) {
+                sample = static_cast<float>(0.5 * std::sin(phase));
+                phase += 2.0 * M_PI * 1000.0 / 48000.0;
+            }
+            auto start = std::chrono::steady_clock::now();
+            analyzer.pushSamples(block.data(), static_cast<int>(block.size()));
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            if (elapsed > worstPushNs.load(std::memory_order_relaxed)) {
+                worstPushNs.store(elapsed, std::memory_order_relaxed);
+            }
+            blocks.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    });
+
+    // UI thread: analyse and draw at ~60 Hz, alternating spectrum and waterfall
+    for (int frame = 0; frame < 90; ++frame) {
+        analyzer.setDisplayMode(frame < 45 ? WaveformVisualizer::DisplayMode::Spectrum
+                                           : WaveformVisualizer::DisplayMode::Waterfall);
+        analyzer.update(1.0f / 60.0f);
+        analyzer.render(&display);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    running = false;
+    audio.join();
+
+    const auto& bands = analyzer.getSpectrumBands();
+    int loudest = 0;
+    for (size_t b = 1; b < bands.size(); ++b) {
+        if (bands[b] > bands[loudest]) loudest = static_cast<int>(b);
+    }
+    LogFrequencyBands mapper;
+    mapper.configure(48, 1024, 48000.0f);
+
+    std::cout << "Audio blocks pushed: " << blocks.load() << std::endl;
+    std::cout << "Worst pushSamples call: " << worstPushNs.load() / 1000.0 << " us" << std::endl;
+    check(bands.size() == 48, "Analyzer exposes 48 log bands");
+    check(std::abs(std::log2(mapper.getBandCenter(loudest) / 1000.0f)) < 0.5f,
+          "1 kHz tone shows up in the matching band");
+    check(std::abs(bands[loudest] - 0.5f) < 0.1f, "Band level tracks the -6 dB input");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Spectrum Analyzer Test ===" << std::endl;
+
+    testFFTAgainstDFT();
+    testSinePeak();
+    testConcurrentCapture();
+
+    std::cout << "\n" << (failures == 0 ? "All spectrum analyzer tests passed"
+                                         : "Spectrum analyzer tests FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
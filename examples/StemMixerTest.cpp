@@ -0,0 +1,244 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../include/sequencer/StemMixer.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Stem mixer test and 32-layer scene benchmark
+ *
+ * Checks that snapshot gain ramps start and end on the requested samples
+ * (against a second engine rendering the same notes unscaled), that muted,
+ * soloed-out and silent stems are skipped, then times a 32-layer scene
+ * spread over two engines with all, some and no layers audible.
+ */
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+const int kSampleRate = 48000;
+
+// 16 active channels; each layer plays a small chord on its own channel
+struct Scene {
+    std::vector<std::unique_ptr<MultiTimbralEngine>> engines;
+    std::vector<std::shared_ptr<TrackLayer>> layers;
+    StemMixer mixer{kSampleRate};
+
+    Scene(int numLayers, int notesPerLayer, int blockSize) {
+        for (int e = 0; e < (numLayers + 15) / 16; ++e) {
+            auto engine = std::make_unique<MultiTimbralEngine>(kSampleRate, 16 * notesPerLayer);
+            engine->initialize();
+            for (int channel = 0; channel < 16; ++channel) {
+                engine->setChannelActive(channel, true);
+            }
+            engines.push_back(std::move(engine));
+        }
+        for (int i = 0; i < numLayers; ++i) {
+            auto layer = std::make_shared<TrackLayer>("layer" + std::to_string(i));
+            layers.push_back(layer);
+            mixer.bindLayer(layer, engines[i / 16].get(), i % 16);
+        }
+        mixer.prepare(blockSize);
+    }
+
+    void playNotes(int layer, int count) {
+        for (int n = 0; n < count; ++n) {
+            engines[layer / 16]->noteOn(48 + (layer * 5 + n * 4) % 36, 0.7f, layer % 16);
+        }
+    }
+};
+
+MixSnapshot snapshotWithAudible(int numLayers, int audible) {
+    MixSnapshot snapshot("audible" + std::to_string(audible));
+    for (int i = 0; i < numLayers; ++i) {
+        snapshot.setLayerMuted("layer" + std::to_string(i), i >= audible);
+    }
+    return snapshot;
+}
+
+void testRamps() {
+    std::cout << "\n=== Gain ramps ===" << std::endl;
+
+    const int blockSize = 1024;
+    Scene scene(1, 2, blockSize);
+    MultiTimbralEngine reference(kSampleRate, 32);
+    reference.initialize();
+    scene.playNotes(0, 2);
+    reference.noteOn(48, 0.7f, 0);
+    reference.noteOn(52, 0.7f, 0);
+
+    std::vector<float> mixed(blockSize * 2);
+    std::vector<float> raw(blockSize * 2);
+
+    // Full volume to half over 480 samples, starting 100 samples in
+    MixSnapshot half("half");
+    half.setLayerVolume("layer0", 0.5f);
+    scene.mixer.applySnapshot(half, 0.01, 100);
+    check(scene.mixer.isStemRamping(0) && scene.mixer.getStemTargetGain(0) == 0.5f, "Snapshot schedules a ramp");
+
+    scene.mixer.process(mixed.data(), blockSize);
+    reference.renderChannel(0, raw.data(), blockSize);
+
+    float maxError = 0.0f;
+    float peak = 0.0f;
+    for (int i = 0; i < blockSize; ++i) {
+        float gain = 1.0f;
+        if (i >= 100 + 480 - 1) {
+            gain = 0.5f;
+        } else if (i >= 100) {
+            gain = 1.0f - 0.5f * static_cast<float>(i - 99) / 480.0f;
+        }
+        for (int c = 0; c < 2; ++c) {
+            maxError = std::max(maxError, std::abs(mixed[i * 2 + c] - raw[i * 2 + c] * gain));
+            peak = std::max(peak, std::abs(raw[i * 2 + c]));
+        }
+    }
+    check(peak > 0.01f, "Reference channel is sounding");
+    check(maxError < 1e-6f, "Ramp starts on sample 100 and reaches 0.5 on sample 579");
+    check(!scene.mixer.isStemRamping(0) && scene.mixer.getStemGain(0) == 0.5f, "Gain settles exactly on the target");
+
+    // A ramp spanning blocks keeps its slope
+    scene.mixer.setStemGain(0, 1.0f, 1000.0 / kSampleRate);
+    scene.mixer.process(mixed.data(), 256);
+    check(std::abs(scene.mixer.getStemGain(0) - (0.5f + 0.5f * 256.0f / 1000.0f)) < 1e-6f,
+          "Ramps continue across block boundaries");
+    scene.mixer.process(mixed.data(), 744);
+    check(scene.mixer.getStemGain(0) == 1.0f, "...and end after their length");
+
+    // An offset beyond the block carries over
+    scene.mixer.setStemGain(0, 0.0f, 0.0, 1500);
+    scene.mixer.process(mixed.data(), 1024);
+    check(scene.mixer.getStemGain(0) == 1.0f && scene.mixer.isStemRamping(0), "Start offsets past the block wait");
+    scene.mixer.process(mixed.data(), 1024);
+    check(scene.mixer.getStemGain(0) == 0.0f, "...and apply in the following block");
+}
+
+void testSkipping() {
+    std::cout << "\n=== Skipping ===" << std::endl;
+
+    const int blockSize = 256;
+    Scene scene(32, 2, blockSize);
+    std::vector<float> out(blockSize * 2);
+
+    check(scene.mixer.getStemCount() == 32, "32 layers bound across two engines");
+    check(scene.mixer.bindLayer(std::make_shared<TrackLayer>("dup"), scene.engines[0].get(), 3) == -1,
+          "A channel cannot back two stems");
+
+    for (int i = 0; i < 32; ++i) {
+        if (i != 5) {
+            scene.playNotes(i, 2);
+        }
+    }
+    scene.mixer.process(out.data(), blockSize);
+    check(scene.mixer.getRenderedStemCount() == 31 && scene.mixer.getStemBuffer(5) == nullptr,
+          "Layer with no sounding voices is skipped (" + std::to_string(scene.mixer.getRenderedStemCount()) + " rendered)");
+
+    MixSnapshot snapshot = snapshotWithAudible(32, 8);
+    scene.mixer.applySnapshot(snapshot, 0.002);
+    scene.mixer.process(out.data(), blockSize);
+    check(scene.mixer.getRenderedStemCount() == 31, "Stems fading out are still rendered");
+    scene.mixer.process(out.data(), blockSize);
+    check(scene.mixer.getRenderedStemCount() == 7, "Muted stems are skipped once silent (" +
+          std::to_string(scene.mixer.getRenderedStemCount()) + " rendered)");
+
+    // Coming back in, the stem renders from the first sample of its ramp
+    scene.mixer.setStemGain(20, 1.0f, 0.001, 64);
+    scene.mixer.process(out.data(), blockSize);
+    check(scene.mixer.getStemBuffer(20) != nullptr && scene.mixer.getStemBuffer(20)[0] == 0.0f &&
+          scene.mixer.getStemBuffer(20)[127] == 0.0f, "Fade-in renders its block, silent before the offset");
+
+    scene.layers[3]->setSolo(true);
+    scene.mixer.applySnapshot(MixSnapshot("open"), 0.0);
+    scene.mixer.process(out.data(), blockSize);
+    check(scene.mixer.getRenderedStemCount() == 1 && scene.mixer.getStemBuffer(3) != nullptr,
+          "Solo leaves only the soloed layer");
+    scene.layers[3]->setSolo(false);
+
+    scene.layers[4]->setVolume(0.5f);
+    MixSnapshot quiet("quiet");
+    quiet.setLayerVolume("layer4", 0.5f);
+    scene.mixer.applySnapshot(quiet, 0.0);
+    check(scene.mixer.getStemGain(4) == 0.25f, "Layer volume scales the snapshot volume");
+}
+
+double timeBlocks(Scene& scene, int blocks, int blockSize) {
+    std::vector<float> out(blockSize * 2);
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < blocks; ++b) {
+        scene.mixer.process(out.data(), blockSize);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void testScene() {
+    std::cout << "\n=== 32-layer scene ===" << std::endl;
+
+    const int numLayers = 32;
+    const int blockSize = 256;
+    const int blocks = 200;
+    const double realTime = static_cast<double>(blocks) * blockSize / kSampleRate;
+
+    std::cout << std::fixed << std::setprecision(1);
+    double allSeconds = 0.0;
+    for (int audible : {32, 16, 8, 4, 0}) {
+        Scene scene(numLayers, 4, blockSize);
+        for (int i = 0; i < numLayers; ++i) {
+            scene.playNotes(i, 4);
+        }
+        scene.mixer.applySnapshot(snapshotWithAudible(numLayers, audible), 0.0);
+
+        double seconds = timeBlocks(scene, blocks, blockSize);
+        if (audible == numLayers) {
+            allSeconds = seconds;
+        }
+        std::cout << std::setw(2) << audible << " of " << numLayers << " audible: "
+                  << std::setw(8) << seconds * 1e6 / blocks << " us per block, "
+                  << std::setw(5) << 100.0 * seconds / realTime << "% of real time ("
+                  << scene.mixer.getRenderedStemCount() << " stems rendered)" << std::endl;
+        if (audible == 0) {
+            check(scene.mixer.getRenderedStemCount() == 0 && seconds < allSeconds / 10,
+                  "Fully muted scene costs a fraction of the full mix");
+        }
+    }
+
+    // The engines' own mix renders every active channel regardless of level
+    Scene scene(numLayers, 4, blockSize);
+    for (int i = 0; i < numLayers; ++i) {
+        scene.playNotes(i, 4);
+    }
+    std::vector<float> out(blockSize * 2);
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < blocks; ++b) {
+        for (auto& engine : scene.engines) {
+            engine->process(out.data(), blockSize);
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "MultiTimbralEngine::process, both engines: " << std::setw(8) << seconds * 1e6 / blocks
+              << " us per block" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Stem Mixer Test ===" << std::endl;
+
+    testRamps();
+    testSkipping();
+    testScene();
+
+    std::cout << "\n" << (failures == 0 ? "All stem mixer checks passed" : "Stem mixer checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/audio/Synthesizer.h"
+#include "../include/midi/MidiManager.h"
+#include "../include/ui/ParameterManager.h"
+#include "AllocationCounter.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Synthesizer parameter registry test
+ *
+ * Checks that IDs resolve at compile time, that every registered parameter
+ * round-trips through the string and indexed interfaces with clamping and
+ * stepping, that changes reach the engine at the next block, and that a
+ * storm of changes from another thread allocates nothing and ends on the
+ * last value. Then checks that MIDI mappings and ParameterManager controls
+ * bind their IDs once: CCs land in each parameter's registered range and
+ * neither mapped CCs nor automation buffers allocate. Reports the cost of
+ * a set through each interface.
+ */
+
+// IDs known at compile time cost nothing at run time
+static_assert(findSynthParameter("envelope_release") == static_cast<int>(SynthParamId::EnvelopeRelease),
+              "envelope_release resolves at compile time");
+static_assert(findSynthParameter("not_a_parameter") == -1, "unknown IDs resolve to -1");
+
+namespace {
+
+using TestSupport::allocations;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+void testRegistry() {
+    std::cout << "\n=== Registry ===" << std::endl;
+
+    Synthesizer synth(44100);
+
+    bool defaults = true;
+    for (const auto& info : kSynthParameters) {
+        defaults &= synth.getParameter(std::string(info.id)) == info.defaultValue;
+    }
+    check(defaults, "Every parameter starts at its registered default");
+
+    const auto all = synth.getAllParameters();
+    check(all.size() == static_cast<size_t>(kNumSynthParameters) && all.at("envelope_attack") == 0.01f,
+          "getAllParameters lists the whole registry");
+
+    check(synth.setParameter("oscillator_type", 2.7f) && synth.getParameter(SynthParamId::OscillatorType) == 2.0f,
+          "Stepped parameters take whole numbers");
+    synth.setParameter(SynthParamId::MasterVolume, 3.0f);
+    synth.setParameter(SynthParamId::Lfo1Rate, 50.0f);
+    check(synth.getParameter("master_volume") == 1.0f && synth.getParameter("lfo1_rate") == 20.0f,
+          "Values are clamped to the registered range");
+    check(!synth.setParameter("masterVolume", 0.5f) && synth.getParameter("masterVolume") == 0.0f,
+          "Unknown IDs are rejected");
+
+    synth.setParameter(SynthParamId::VoiceCount, 4.0f);
+    check(synth.getVoiceCount() == 4 && synth.getParameter("voice_count") == 4.0f, "Voice count applies straight away");
+}
+
+void testApplication() {
+    std::cout << "\n=== Applied at the next block ===" << std::endl;
+
+    const int blockSize = 256;
+    Synthesizer synth(44100);
+    std::vector<float> buffer(blockSize * 2);
+    const SmoothingEngine& smoothing = synth.getSmoothingEngine();
+
+    synth.setParameter(SynthParamId::OscillatorType, static_cast<float>(OscillatorType::Square));
+    synth.setParameter(SynthParamId::EnvelopeAttack, 0.5f);
+    check(synth.getParameter(SynthParamId::OscillatorFrame) == 0.0f && !smoothing.isSmoothing(0),
+          "Nothing reaches the engine before the block");
+
+    synth.process(buffer.data(), blockSize);
+    check(synth.getParameter(SynthParamId::OscillatorFrame) == 0.5f && smoothing.getActiveCount() == 2,
+          "Oscillator type moves the frame; attack and frame are ramping");
+
+    synth.setParameter(SynthParamId::FilterCutoff, 0.25f);
+    synth.process(buffer.data(), blockSize);
+    check(synth.getParameter("filter_cutoff") == 0.25f, "Parameters without a handler are stored");
+}
+
+void testStorm() {
+    std::cout << "\n=== Change storm ===" << std::endl;
+
+    const int blockSize = 256;
+    const int changes = 200000;
+    Synthesizer synth(44100);
+    std::vector<float> buffer(blockSize * 2);
+    synth.noteOn(60, 0.8f);
+
+    // One thread hammers the volume and cutoff while the audio thread runs
+    std::atomic<bool> done{false};
+    size_t stormAllocations = 0;
+    std::thread storm([&]() {
+        size_t before = allocations;
+        for (int i = 0; i < changes; ++i) {
+            synth.setParameter(SynthParamId::MasterVolume, (i % 100) / 100.0f);
+            synth.setParameter(SynthParamId::FilterCutoff, (i % 7) / 7.0f);
+        }
+        synth.setParameter(SynthParamId::MasterVolume, 0.25f);
+        stormAllocations = allocations - before;
+        done.store(true);
+    });
+    int blocks = 0;
+    while (!done.load()) {
+        synth.process(buffer.data(), blockSize);
+        ++blocks;
+    }
+    storm.join();
+    for (int i = 0; i < 8; ++i) {
+        synth.process(buffer.data(), blockSize);
+    }
+
+    // Master volume is the last smoothed parameter
+    const SmoothingEngine& smoothing = synth.getSmoothingEngine();
+    check(smoothing.getValue(smoothing.getParameterCount() - 1) == 0.25f && synth.getParameter("master_volume") == 0.25f,
+          "Engine ends on the last of " + std::to_string(2 * changes) + " changes over " + std::to_string(blocks) +
+          " blocks");
+    check(stormAllocations == 0, "Setting parameters does not allocate");
+
+    // Cost of a set, without the audio thread
+    const int calls = 1000000;
+    const std::string id = "envelope_sustain";
+    std::cout << std::fixed << std::setprecision(1);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) {
+        synth.setParameter(SynthParamId::EnvelopeSustain, (i & 127) / 127.0f);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Indexed setParameter: " << seconds * 1e9 / calls << " ns per call" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) {
+        synth.setParameter(id, (i & 127) / 127.0f);
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "String setParameter:  " << seconds * 1e9 / calls << " ns per call" << std::endl;
+}
+
+// Keeps a pointer to the ID rather than a copy, so listening does not allocate
+class RecordingListener : public MidiManager::Listener {
+public:
+    const std::string* lastId = nullptr;
+    float lastValue = 0.0f;
+
+    void parameterChangedViaMidi(const std::string& paramId, float value) override {
+        lastId = &paramId;
+        lastValue = value;
+    }
+    void pitchBendChanged(int, float) override {}
+    void modWheelChanged(int, float) override {}
+    void afterTouchChanged(int, float) override {}
+};
+
+void testBoundControls() {
+    std::cout << "\n=== Controls bound at mapping time ===" << std::endl;
+
+    Synthesizer synth(44100);
+    RecordingListener listener;
+    MidiManager midi(&synth, &listener);
+
+    MidiManager::MidiParameterMap mappings;
+    mappings[0][74] = "filter_cutoff";
+    mappings[0][71] = "oscillator_type";
+    mappings[0][91] = "effect0_mix";
+    midi.setMidiMappings(mappings);
+
+    auto controlChange = [&midi](int controller, int value) {
+        MidiMessage message{};
+        message.type = MidiMessage::Type::ControlChange;
+        message.channel = 0;
+        message.data1 = controller;
+        message.data2 = value;
+        midi.processMidiMessage(message);
+    };
+
+    controlChange(74, 64);
+    const float halfway = synth.getParameter(SynthParamId::FilterCutoff);
+    controlChange(74, 0);
+    check(halfway > 0.45f && halfway < 0.55f && synth.getParameter(SynthParamId::FilterCutoff) == 0.0f,
+          "CC sweeps filter_cutoff across its normalized range");
+
+    controlChange(71, 127);
+    const float top = synth.getParameter(SynthParamId::OscillatorType);
+    controlChange(71, 64);
+    check(top == 4.0f && synth.getParameter(SynthParamId::OscillatorType) == 2.0f,
+          "Stepped parameters take the registered steps");
+
+    controlChange(91, 127);
+    check(listener.lastId && *listener.lastId == "effect0_mix" && listener.lastValue == 1.0f,
+          "Parameters the synthesizer does not know still reach the listener");
+
+    size_t before = allocations;
+    for (int i = 0; i < 1000; ++i) {
+        controlChange(74, i & 127);
+    }
+    const size_t ccAllocations = allocations - before;
+    check(ccAllocations == 0, "Mapped CCs do not allocate");
+
+    ParameterManager parameters;
+    parameters.initialize();
+    parameters.connectSynthesizer(&synth);
+    parameters.setParameterValue("envelope_sustain", 0.2f);
+    check(synth.getParameter(SynthParamId::EnvelopeSustain) == 0.2f, "ParameterManager sets the bound parameter");
+
+    parameters.setParameterWithAutomation("envelope_sustain", 0.9f);
+    before = allocations;
+    for (int i = 0; i < 64; ++i) {
+        parameters.processAudioBuffer(256);
+    }
+    const size_t automationAllocations = allocations - before;
+    const float ramped = synth.getParameter(SynthParamId::EnvelopeSustain);
+    check(automationAllocations == 0 && ramped > 0.2f && ramped <= 0.9f,
+          "Automation buffers ramp from the set value without allocating");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Synth Parameter Test ===" << std::endl;
+
+    testRegistry();
+    testApplication();
+    testStorm();
+    testBoundControls();
+
+    std::cout << "\n" << (failures == 0 ? "All synth parameter checks passed" : "Synth parameter checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
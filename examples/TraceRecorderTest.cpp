@@ -0,0 +1,246 @@
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/audio/Synthesizer.h"
+#include "../include/audio/TraceRecorder.h"
+#include "../include/synthesis/framework/processor.h"
+#include "AllocationCounter.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Trace recorder test
+ *
+ * Checks that scopes record nothing while tracing is off, that a traced
+ * Synthesizer block shows its stages nested inside it, that per-processor
+ * markers carry the processor's name, that recording from a prepared thread
+ * allocates nothing, that rings keep the most recent events, and that the
+ * Chrome trace export is well-formed while threads keep recording. Reports
+ * the cost of a scope with tracing off and on.
+ */
+
+namespace {
+
+using TestSupport::allocations;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+size_t countOccurrences(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+// Start and end (microseconds) of the first event with a name
+bool findEvent(const std::string& json, const std::string& name, double& start, double& end) {
+    const size_t pos = json.find("{\"name\":\"" + name + "\",\"ph\":\"X\"");
+    if (pos == std::string::npos) {
+        return false;
+    }
+    double duration = 0.0;
+    const size_t ts = json.find("\"ts\":", pos);
+    std::sscanf(json.c_str() + ts, "\"ts\":%lf,\"dur\":%lf", &start, &duration);
+    end = start + duration;
+    return true;
+}
+
+class Gain : public Processor {
+public:
+    void process(float* buffer, int numFrames) override {
+        for (int i = 0; i < numFrames * 2; ++i) {
+            buffer[i] *= 0.5f;
+        }
+    }
+    std::string getName() const override { return "Gain"; }
+};
+
+void testDisabled() {
+    std::cout << "\n=== Tracing off ===" << std::endl;
+
+    TraceRecorder& recorder = TraceRecorder::getInstance();
+    TraceRecorder::setEnabled(false);
+    recorder.clear();
+
+    const int scopes = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < scopes; ++i) {
+        AIMUSIC_TRACE_SCOPE("disabled");
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    check(recorder.getEventCount() == 0, "Scopes record nothing while tracing is off");
+    std::cout << std::fixed << std::setprecision(1) << "Scope with tracing off: " << seconds * 1e9 / scopes
+              << " ns" << std::endl;
+}
+
+void testSynthesizer() {
+    std::cout << "\n=== Synthesizer block ===" << std::endl;
+
+    TraceRecorder& recorder = TraceRecorder::getInstance();
+    recorder.prepareThread("audio");
+    recorder.clear();
+
+    const int blockSize = 256;
+    Synthesizer synth(44100);
+    std::vector<float> buffer(blockSize * 2);
+    synth.noteOn(60, 0.8f);
+
+    TraceRecorder::setEnabled(true);
+    synth.process(buffer.data(), blockSize);
+    TraceRecorder::setEnabled(false);
+
+    const std::string json = recorder.exportChromeTrace();
+    double blockStart = 0.0, blockEnd = 0.0, voicesStart = 0.0, voicesEnd = 0.0, modStart = 0.0, modEnd = 0.0;
+    const bool found = findEvent(json, "Synthesizer::process", blockStart, blockEnd) &&
+                       findEvent(json, "VoiceManager::process", voicesStart, voicesEnd) &&
+                       findEvent(json, "ModulationMatrix::update", modStart, modEnd);
+    check(found, "The block, its voices and the modulation update are traced");
+    check(found && blockStart <= modStart && modEnd <= voicesStart && voicesEnd <= blockEnd + 0.001,
+          "Stages nest inside the block in processing order");
+    check(json.find("\"args\":{\"name\":\"audio\"}") != std::string::npos, "The audio thread is named");
+
+    // Processors in a router are traced by name
+    ProcessorRouter router;
+    router.addProcessor(std::make_unique<Gain>());
+    recorder.clear();
+    TraceRecorder::setEnabled(true);
+    router.process(buffer.data(), blockSize);
+    TraceRecorder::setEnabled(false);
+    check(recorder.exportChromeTrace().find("{\"name\":\"Gain\"") != std::string::npos,
+          "Router processors are traced under their names");
+}
+
+void testRecording() {
+    std::cout << "\n=== Recording ===" << std::endl;
+
+    TraceRecorder& recorder = TraceRecorder::getInstance();
+    recorder.clear();
+
+    const int scopes = 100000;
+    size_t allocated = 0;
+    double seconds = 0.0;
+    TraceRecorder::setEnabled(true);
+    std::thread audio([&]() {
+        recorder.prepareThread("recording");
+        size_t before = allocations;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < scopes; ++i) {
+            AIMUSIC_TRACE_SCOPE("block");
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        allocated = allocations - before;
+    });
+    audio.join();
+    TraceRecorder::setEnabled(false);
+
+    check(allocated == 0, "Recording from a prepared thread does not allocate");
+    check(recorder.getEventCount() == recorder.getCapacity(), "A full ring keeps its most recent events");
+    std::cout << std::fixed << std::setprecision(1) << "Scope with tracing on: " << seconds * 1e9 / scopes << " ns"
+              << std::endl;
+
+    // Capacity applies to rings created afterwards; exited threads' rings are reused
+    const size_t capacity = recorder.getCapacity();
+    recorder.setCapacity(64);
+    recorder.clear();
+    TraceRecorder::setEnabled(true);
+    std::thread small([&]() {
+        for (int i = 0; i < 200; ++i) {
+            AIMUSIC_TRACE_SCOPE("small");
+        }
+    });
+    small.join();
+    TraceRecorder::setEnabled(false);
+    check(recorder.getEventCount() == 64, "New rings take the configured capacity");
+    recorder.setCapacity(capacity);
+
+    const double rate = recorder.getTicksPerMicrosecond();
+    check(rate > 0.0, "Timestamps are calibrated (" + std::to_string(rate) + " ticks per microsecond)");
+}
+
+void testExport() {
+    std::cout << "\n=== Export while recording ===" << std::endl;
+
+    TraceRecorder& recorder = TraceRecorder::getInstance();
+    recorder.clear();
+    TraceRecorder::setEnabled(true);
+
+    const int threads = 3;
+    std::atomic<bool> stop{false};
+    std::atomic<int> running{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            recorder.prepareThread();
+            ++running;
+            while (!stop.load()) {
+                AIMUSIC_TRACE_SCOPE("outer \"quoted\"");
+                AIMUSIC_TRACE_SCOPE("inner");
+                // About a block's worth of work between blocks
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+    }
+    while (running.load() < threads) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    bool wellFormed = true;
+    size_t exported = 0;
+    for (int i = 0; i < 5; ++i) {
+        const std::string json = recorder.exportChromeTrace();
+        wellFormed &= json.rfind("{\"traceEvents\":[", 0) == 0 &&
+                      json.find("\n],\"displayTimeUnit\"") != std::string::npos;
+        wellFormed &= json.find("\"dur\":-") == std::string::npos && json.find("\"ts\":-") == std::string::npos;
+        exported = countOccurrences(json, "\"ph\":\"X\"");
+    }
+    stop.store(true);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    TraceRecorder::setEnabled(false);
+
+    check(wellFormed && exported > 0,
+          "Exports stay well-formed while " + std::to_string(threads) + " threads record (" +
+              std::to_string(exported) + " events)");
+
+    const std::string json = recorder.exportChromeTrace();
+    check(json.find("\"outer \\\"quoted\\\"\"") != std::string::npos, "Names are escaped for JSON");
+
+    const std::string path = "trace_recorder_test.json";
+    check(recorder.exportChromeTrace(path), "Trace is written to " + path);
+    std::ifstream file(path);
+    std::string first;
+    std::getline(file, first);
+    check(first == "{\"traceEvents\":[", "The file holds the trace");
+    file.close();
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Trace Recorder Test ===" << std::endl;
+
+    testDisabled();
+    testSynthesizer();
+    testRecording();
+    testExport();
+
+    std::cout << "\n" << (failures == 0 ? "All trace recorder checks passed" : "Trace recorder checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
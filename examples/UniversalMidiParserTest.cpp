@@ -0,0 +1,239 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include "../include/midi/UniversalMidiParser.h"
+#include "../include/midi/MidiCCLearning.h"
+#include "AllocationCounter.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * High resolution MIDI input test
+ *
+ * Checks the MIDI 2.0 scaling rules, 14-bit CC pairing, RPN/NRPN data
+ * entry, MIDI 2.0 channel voice packets and the CC learning hook, then
+ * measures parse cost and confirms the parser never allocates.
+ */
+
+namespace {
+
+using TestSupport::allocations;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+bool near(float a, float b) {
+    return std::abs(a - b) <= 1e-5f;
+}
+
+using Kind = UniversalMidiEvent::Kind;
+
+void testScaling() {
+    std::cout << "\n=== MIDI 2.0 scaling ===" << std::endl;
+
+    check(MidiResolution::scaleUp(0, 7, 32) == 0, "7-bit minimum maps to 0");
+    check(MidiResolution::scaleUp(64, 7, 32) == 0x80000000u, "7-bit center maps to 0x80000000");
+    check(MidiResolution::scaleUp(127, 7, 32) == 0xFFFFFFFFu, "7-bit maximum maps to 0xFFFFFFFF");
+    check(MidiResolution::scaleUp(8192, 14, 32) == 0x80000000u, "14-bit center maps to 0x80000000");
+    check(MidiResolution::scaleUp(16383, 14, 32) == 0xFFFFFFFFu, "14-bit maximum maps to 0xFFFFFFFF");
+    check(MidiResolution::scaleUp(127, 7, 16) == 0xFFFFu, "7-bit velocity maximum maps to 0xFFFF");
+
+    bool monotonic = true;
+    for (uint32_t v = 1; v < 16384; ++v) {
+        monotonic = monotonic && MidiResolution::scaleUp(v, 14, 32) > MidiResolution::scaleUp(v - 1, 14, 32);
+    }
+    check(monotonic, "14-bit upscaling is strictly increasing");
+
+    check(UniversalMidiPacket::fromMidi1(0x90, 60, 100).wordCount() == 1 &&
+          UniversalMidiPacket::midi2Note(true, 0, 60, 0xFFFF).wordCount() == 2,
+          "MIDI 1.0 packets use one word, MIDI 2.0 packets two");
+}
+
+void testControllerPairs() {
+    std::cout << "\n=== 14-bit CC pairs ===" << std::endl;
+
+    UniversalMidiParser parser;
+    UniversalMidiEvent event;
+
+    check(parser.parseMidi1(0xB2, 1, 64, event) && event.kind == Kind::ControlChange && event.channel == 2 &&
+          event.index == 1 && event.sourceBits == 7 && event.value == 0x80000000u,
+          "MSB alone is reported immediately at 7 bits");
+
+    check(parser.parseMidi1(0xB2, 33, 5, event) && event.index == 1 && event.sourceBits == 14 &&
+          event.value14() == ((64 << 7) | 5), "LSB completes the value on the MSB controller");
+
+    check(parser.parseMidi1(0xB3, 33, 5, event) && event.index == 33 && event.sourceBits == 7,
+          "LSB without a prior MSB on its channel stays a plain CC");
+
+    parser.setHighResolutionPairs(false);
+    check(parser.parseMidi1(0xB2, 33, 5, event) && event.index == 33, "Pairing can be turned off");
+    parser.setHighResolutionPairs(true);
+
+    // A sweep sent as CC 11/43 pairs keeps its resolution
+    std::set<uint32_t> distinct;
+    for (int v = 0; v < 16384; v += 4) {
+        parser.parseMidi1(0xB0, 11, static_cast<uint8_t>(v >> 7), event);
+        parser.parseMidi1(0xB0, 43, static_cast<uint8_t>(v & 0x7F), event);
+        distinct.insert(event.value);
+    }
+    check(distinct.size() == 4096, "Sweep yields " + std::to_string(distinct.size()) +
+                                   " distinct values (7-bit CC gives 128)");
+}
+
+void testParameters() {
+    std::cout << "\n=== RPN / NRPN ===" << std::endl;
+
+    UniversalMidiParser parser;
+    UniversalMidiEvent event;
+
+    check(!parser.parseMidi1(0xB0, 99, 1, event) && !parser.parseMidi1(0xB0, 98, 2, event),
+          "NRPN selection is consumed");
+    check(parser.parseMidi1(0xB0, 6, 10, event) && event.kind == Kind::AssignableParameter &&
+          event.index == 130 && event.value7() == 10, "Data entry MSB reports the NRPN");
+    check(parser.parseMidi1(0xB0, 38, 3, event) && event.sourceBits == 14 && event.value14() == ((10 << 7) | 3),
+          "Data entry LSB refines it to 14 bits");
+    check(parser.parseMidi1(0xB0, 96, 0, event) && event.value14() == ((10 << 7) | 4), "Increment steps by one");
+    check(parser.parseMidi1(0xB0, 97, 0, event) && event.value14() == ((10 << 7) | 3), "Decrement steps by one");
+
+    parser.parseMidi1(0xB0, 101, 0, event);
+    parser.parseMidi1(0xB0, 100, 6, event);
+    check(parser.parseMidi1(0xB0, 6, 7, event) && event.kind == Kind::RegisteredParameter && event.index == 6,
+          "RPN 6 (MPE configuration) is reported as registered");
+
+    parser.parseMidi1(0xB0, 101, 127, event);
+    parser.parseMidi1(0xB0, 100, 127, event);
+    check(parser.parseMidi1(0xB0, 6, 7, event) && event.kind == Kind::ControlChange && event.index == 6,
+          "After RPN null, CC 6 is a plain controller again");
+
+    check(parser.parseMidi1(0xB1, 6, 7, event) && event.kind == Kind::ControlChange,
+          "Parameter selection is per channel");
+}
+
+void testMidi2Packets() {
+    std::cout << "\n=== MIDI 2.0 packets ===" << std::endl;
+
+    UniversalMidiParser parser;
+    UniversalMidiEvent event;
+
+    auto cc = UniversalMidiPacket::midi2(UniversalMidiPacket::ControlChange, 4, 74, 0, 0x12345678u, 3);
+    check(parser.parse(cc, event) && event.kind == Kind::ControlChange && event.group == 3 &&
+          event.channel == 4 && event.index == 74 && event.value == 0x12345678u && event.sourceBits == 32,
+          "Controller keeps all 32 bits");
+
+    auto nrpn = UniversalMidiPacket::midi2(UniversalMidiPacket::AssignableController, 0, 1, 2, 0xC0000000u);
+    check(parser.parse(nrpn, event) && event.kind == Kind::AssignableParameter && event.index == 130 &&
+          near(event.unit(), 0.75f), "Assignable controller maps to the NRPN number");
+
+    auto perNote = UniversalMidiPacket::midi2(UniversalMidiPacket::AssignablePerNoteController, 1, 60, 7, 42);
+    check(parser.parse(perNote, event) && event.kind == Kind::PerNoteController && event.note == 60 &&
+          event.index == (0x100 | 7) && event.value == 42, "Per-note controller carries note and index");
+
+    auto note = UniversalMidiPacket::midi2Note(true, 0, 61, 0x8000);
+    check(parser.parse(note, event) && event.kind == Kind::NoteOn && event.note == 61 &&
+          event.value == 0x80000000u && event.sourceBits == 16, "Note on carries 16-bit velocity");
+
+    auto bend = UniversalMidiPacket::midi2(UniversalMidiPacket::PitchBend, 0, 0, 0, 0x80000000u);
+    check(parser.parse(bend, event) && event.kind == Kind::PitchBend && near(event.bipolar(), 0.0f),
+          "Pitch bend center is zero");
+
+    auto program = UniversalMidiPacket::midi2(UniversalMidiPacket::ProgramChange, 0, 0, 0, 12u << 24);
+    check(parser.parse(program, event) && event.kind == Kind::ProgramChange && event.index == 12,
+          "Program change number comes from the data word");
+
+    auto midi1 = UniversalMidiPacket::fromMidi1(0xE5, 0x00, 0x40);
+    check(parser.parse(midi1, event) && event.kind == Kind::PitchBend && event.channel == 5 &&
+          near(event.bipolar(), 0.0f), "MIDI 1.0 packet decodes like raw bytes");
+
+    MidiMessage message;
+    message.type = MidiMessage::Type::NoteOn;
+    message.channel = 9;
+    message.data1 = 36;
+    message.data2 = 0;
+    check(parser.parse(message, event) && event.kind == Kind::NoteOff && event.channel == 9,
+          "Legacy MidiMessage note on with velocity 0 is a note off");
+
+    UniversalMidiPacket sysex;
+    sysex.words[0] = 0x30000000u;
+    check(!parser.parse(sysex, event), "Non channel voice packets are skipped");
+}
+
+void testCCLearning() {
+    std::cout << "\n=== CC learning at 14 bits ===" << std::endl;
+
+    MidiCCLearning learning;
+    MidiCCLearning::CCMapping mapping;
+    mapping.channel = 0;
+    mapping.ccNumber = 1;
+    mapping.parameterId = "filter_cutoff";
+    learning.createMapping(mapping);
+
+    float received = -1.0f;
+    learning.setParameterChangeCallback([&received](const std::string&, float value) { received = value; });
+
+    UniversalMidiParser parser;
+    UniversalMidiEvent event;
+    parser.parseMidi1(0xB0, 1, 100, event);
+    learning.processUniversalEvent(event);
+    check(near(received, event.value14() / 16383.0f) && std::abs(received - 100 / 127.0f) < 0.5f / 127.0f,
+          "MSB drives the mapping");
+
+    parser.parseMidi1(0xB0, 33, 77, event);
+    learning.processUniversalEvent(event);
+    check(near(received, ((100 << 7) | 77) / 16383.0f), "LSB refines the mapped value");
+
+    learning.clearAllMappings();
+}
+
+void testCost() {
+    std::cout << "\n=== Parse cost ===" << std::endl;
+
+    UniversalMidiParser parser;
+    UniversalMidiEvent event;
+    const int messages = 1000000;
+    uint64_t sink = 0;
+
+    size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < messages; ++i) {
+        const uint8_t value = static_cast<uint8_t>(i & 0x7F);
+        if (parser.parseMidi1(static_cast<uint8_t>(0xB0 | (i & 15)), (i & 1) ? 33 : 1, value, event)) {
+            sink += event.value;
+        }
+        auto packet = UniversalMidiPacket::midi2(UniversalMidiPacket::ControlChange, i & 15, 74, 0,
+                                                 static_cast<uint32_t>(i) * 4099u);
+        if (parser.parse(packet, event)) {
+            sink += event.value;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t allocated = allocations - before;
+
+    check(allocated == 0, "No allocations while parsing");
+    std::cout << std::fixed << std::setprecision(1) << "Parse: " << seconds * 1e9 / (2.0 * messages)
+              << " ns per message (checksum " << (sink & 0xFFFF) << ")" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Universal MIDI Parser Test ===" << std::endl;
+
+    testScaling();
+    testControllerPairs();
+    testParameters();
+    testMidi2Packets();
+    testCCLearning();
+    testCost();
+
+    std::cout << "\n" << (failures == 0 ? "All universal MIDI checks passed" : "Universal MIDI checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <set>
+#include <string>
+#include "../include/synthesis/voice/voice_manager.h"
+#include "AllocationCounter.h"
+
+using namespace AIMusicHardware;
+
+/*
+ * Voice manager bookkeeping test
+ *
+ * Checks note lookup, sustain, per-channel note off and the three steal
+ * modes, then confirms note on/off, controllers and stealing never
+ * allocate and measures their cost.
+ */
+
+namespace {
+
+using TestSupport::allocations;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    std::cout << (condition ? "✅ " : "❌ ") << message << std::endl;
+    if (!condition) ++failures;
+}
+
+// Voice currently holding a note, found through the public voice accessor
+Voice* voiceFor(VoiceManager& manager, int note, int channel) {
+    for (int i = 0; i < manager.getMaxVoices(); ++i) {
+        Voice* voice = manager.getVoice(i);
+        if (voice->isActive() && !voice->isReleased() && voice->getMidiNote() == note &&
+            voice->getChannel() == channel) {
+            return voice;
+        }
+    }
+    return nullptr;
+}
+
+void testNotes() {
+    std::cout << "\n=== Notes and sustain ===" << std::endl;
+
+    VoiceManager manager(44100, 8);
+
+    manager.noteOn(60, 0.8f, 0);
+    manager.noteOn(60, 0.8f, 1);
+    Voice* a = voiceFor(manager, 60, 0);
+    Voice* b = voiceFor(manager, 60, 1);
+    check(a && b && a != b, "Same note on two channels uses two voices");
+
+    manager.noteOn(60, 0.5f, 0);
+    check(voiceFor(manager, 60, 0) == a, "Re-striking a held note retriggers its voice");
+
+    manager.noteOff(60, 0);
+    check(a && a->isReleased() && voiceFor(manager, 60, 1) == b, "Note off releases only its channel");
+
+    manager.sustainOn(1);
+    manager.noteOff(60, 1);
+    check(b && !b->isReleased(), "Sustain holds the note after note off");
+    manager.sustainOff(1);
+    check(b && b->isReleased(), "Sustain off releases held notes");
+
+    manager.noteOn(64, 0.8f, 16);
+    check(voiceFor(manager, 64, 16) != nullptr, "Channel 16 (MPE upper zone numbering) is accepted");
+    manager.noteOn(64, 0.8f, 17);
+    manager.noteOn(128, 0.8f, 0);
+    check(voiceFor(manager, 64, 17) == nullptr && voiceFor(manager, 128, 0) == nullptr,
+          "Out of range channels and notes are ignored");
+
+    manager.noteOn(67, 0.8f, 2);
+    manager.noteOn(69, 0.8f, 2);
+    manager.allNotesOff(2);
+    check(!voiceFor(manager, 67, 2) && !voiceFor(manager, 69, 2) && voiceFor(manager, 64, 16),
+          "All notes off for one channel leaves the others");
+
+    manager.setPitchBend(1.0f, 16);
+    manager.noteOff(64, 16);
+    manager.noteOn(64, 0.8f, 16);
+    check(voiceFor(manager, 64, 16) != nullptr, "New note after release gets a voice");
+}
+
+void testStealing() {
+    std::cout << "\n=== Stealing ===" << std::endl;
+
+    VoiceManager manager(44100, 4);
+    for (int note = 60; note < 64; ++note) {
+        manager.noteOn(note, 0.8f, 0);
+    }
+    Voice* oldest = voiceFor(manager, 60, 0);
+    manager.noteOn(64, 0.8f, 0);
+    check(voiceFor(manager, 64, 0) == oldest && !voiceFor(manager, 60, 0), "Oldest note is stolen first");
+    manager.noteOff(60, 0);
+    check(voiceFor(manager, 64, 0) == oldest && !oldest->isReleased(),
+          "Note off for the stolen note leaves the new one playing");
+
+    // Released voices are not stolen while playing ones remain
+    manager.noteOff(62, 0);
+    manager.noteOn(65, 0.8f, 0);
+    Voice* stolen = voiceFor(manager, 65, 0);
+    check(stolen && !voiceFor(manager, 61, 0) && stolen != voiceFor(manager, 64, 0),
+          "Next steal takes the oldest voice not in release");
+
+    manager.setStealMode(VoiceManager::StealMode::Random);
+    std::set<int> victims;
+    for (int round = 0; round < 64; ++round) {
+        manager.allNotesOff();
+        for (int note = 60; note < 64; ++note) {
+            manager.noteOn(note, 0.8f, 0);
+        }
+        manager.noteOn(72, 0.8f, 0);
+        for (int note = 60; note < 64; ++note) {
+            if (!voiceFor(manager, note, 0)) {
+                victims.insert(note);
+            }
+        }
+    }
+    check(victims.size() == 4, "Random stealing reaches every voice (" + std::to_string(victims.size()) + " of 4)");
+
+    manager.setStealMode(VoiceManager::StealMode::Quietest);
+    manager.allNotesOff();
+    manager.noteOn(60, 0.9f, 0);
+    manager.noteOn(61, 0.1f, 0);
+    manager.noteOn(62, 0.9f, 0);
+    manager.noteOn(63, 0.9f, 0);
+    float buffer[256 * 2];
+    manager.process(buffer, 256);
+    manager.noteOn(64, 0.9f, 0);
+    check(!voiceFor(manager, 61, 0) && voiceFor(manager, 64, 0), "Quietest mode steals the softest note");
+
+    manager.setMaxVoices(2);
+    manager.allNotesOff();
+    manager.noteOn(50, 0.8f, 0);
+    manager.noteOn(51, 0.8f, 0);
+    manager.noteOn(52, 0.8f, 0);
+    check(voiceFor(manager, 52, 0) != nullptr && manager.getMaxVoices() == 2,
+          "Resizing the voice pool keeps allocation working");
+}
+
+void testCost() {
+    std::cout << "\n=== Cost ===" << std::endl;
+
+    VoiceManager manager(44100, 16);
+    manager.setStealMode(VoiceManager::StealMode::Random);
+    manager.noteOn(0, 0.5f, 0);
+    manager.noteOff(0, 0);
+
+    const int rounds = 200000;
+    size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        const int channel = r & 15;
+        const int note = 36 + (r * 7) % 60;
+        manager.noteOn(note, 0.8f, channel);
+        manager.setAftertouch(note, 0.5f, channel);
+        if (r % 8 == 0) {
+            manager.setPitchBend(0.1f, channel);
+            manager.sustainOn(channel);
+        }
+        if (r % 3 == 0) {
+            manager.noteOff(note, channel);
+        }
+        if (r % 8 == 4) {
+            manager.sustainOff(channel);
+        }
+        if (r == rounds / 2) {
+            manager.setStealMode(VoiceManager::StealMode::Oldest);
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t allocated = allocations - before;
+
+    check(allocated == 0, "No allocations in note on/off, controllers or stealing");
+    std::cout << std::fixed << std::setprecision(1) << "Note on + aftertouch (+ off): "
+              << seconds * 1e9 / rounds << " ns per note" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Voice Manager Test ===" << std::endl;
+
+    testNotes();
+    testStealing();
+    testCost();
+
+    std::cout << "\n" << (failures == 0 ? "All voice manager checks passed" : "Voice manager checks FAILED")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -40,6 +40,15 @@
 #define LED_NORMAL_BLINK_MS 50
 #define LED_ERROR_BLINK_MS 200
 
+// Sensor Payload Format
+// 0: one JSON document per wake-up on .../data, then deep sleep
+// 1: stream binary frames (include/iot/SensorFrameFormat.h) on .../frame,
+//    batching several motion snapshots per message; the node stays awake
+#define SENSOR_PAYLOAD_BINARY 0
+#define BINARY_BATCH_SNAPSHOTS 4        // Motion snapshots per published frame
+#define BINARY_SAMPLE_INTERVAL_MS 20    // Motion sampling period in binary mode
+#define BINARY_FRAME_BUFFER_SIZE 512    // Bytes; must fit one frame
+
 // Sensor Calibration
 #define CALIBRATION_SAMPLES 100
 #define TEMPERATURE_OFFSET 0.0  // Celsius
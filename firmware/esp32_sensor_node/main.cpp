@@ -17,6 +17,7 @@
 #include <esp_sleep.h>
 #include <esp_wifi.h>
 #include "config.h"
+#include "SensorFrameFormat.h"
 
 // Hardware configuration
 #define I2C_SDA 21
@@ -80,6 +81,16 @@ struct SensorData {
     unsigned long timestamp;
 };
 
+#if SENSOR_PAYLOAD_BINARY
+using namespace AIMusicHardware;
+
+// Binary frame being batched, and per-sensor sequence numbers
+uint8_t frameBuffer[BINARY_FRAME_BUFFER_SIZE];
+SensorFrame::Writer frameWriter(frameBuffer, sizeof(frameBuffer));
+uint16_t sensorSequence[16] = {0};
+int snapshotsInFrame = 0;
+#endif
+
 void setup() {
     Serial.begin(115200);
     Serial.println("ESP32 Sensor Node Starting...");
@@ -105,6 +116,30 @@ void setup() {
 }
 
 void loop() {
+#if SENSOR_PAYLOAD_BINARY
+    // Streaming mode: the slow environmental sensors are read once per frame,
+    // motion is sampled every BINARY_SAMPLE_INTERVAL_MS and batched
+    static SensorData data;
+    if (snapshotsInFrame == 0) {
+        data = collectSensorData();
+        frameWriter.begin(millis());
+        appendEnvironmentReadings(data);
+    } else {
+        readMotionSensors(data);
+    }
+    appendMotionReadings(data);
+    
+    if (++snapshotsInFrame >= BINARY_BATCH_SNAPSHOTS) {
+        publishSensorFrame();
+        snapshotsInFrame = 0;
+        checkBatteryLevel();
+    }
+    
+    mqttClient.loop();
+    delay(BINARY_SAMPLE_INTERVAL_MS);
+    return;
+#endif
+
     // Collect sensor data
     SensorData data = collectSensorData();
     
@@ -253,6 +288,11 @@ void connectMQTT() {
             Serial.println();
             Serial.println("MQTT connected!");
             
+#if SENSOR_PAYLOAD_BINARY
+            // PubSubClient's default 256-byte packet buffer is too small for a batch
+            mqttClient.setBufferSize(BINARY_FRAME_BUFFER_SIZE + 128);
+#endif
+            
             // Subscribe to control topics
             String controlTopic = "AIMusicHardware/control/" + config.deviceId;
             mqttClient.subscribe(controlTopic.c_str());
@@ -312,15 +352,7 @@ SensorData collectSensorData() {
     data.lightLevel = veml.readLux();
     
     // Motion sensors
-    int16_t ax, ay, az, gx, gy, gz;
-    mpu.getMotion6(&ax, &ay, &az, &gx, &gy, &gz);
-    
-    data.accelX = ax / 16384.0; // Convert to g
-    data.accelY = ay / 16384.0;
-    data.accelZ = az / 16384.0;
-    data.gyroX = gx / 131.0; // Convert to degrees/sec
-    data.gyroY = gy / 131.0;
-    data.gyroZ = gz / 131.0;
+    readMotionSensors(data);
     
     // Audio level measurement
     data.audioLevelDB = measureAudioLevel();
@@ -356,6 +388,58 @@ float measureAudioLevel() {
     return dB;
 }
 
+void readMotionSensors(SensorData& data) {
+    int16_t ax, ay, az, gx, gy, gz;
+    mpu.getMotion6(&ax, &ay, &az, &gx, &gy, &gz);
+    
+    data.accelX = ax / 16384.0; // Convert to g
+    data.accelY = ay / 16384.0;
+    data.accelZ = az / 16384.0;
+    data.gyroX = gx / 131.0; // Convert to degrees/sec
+    data.gyroY = gy / 131.0;
+    data.gyroZ = gz / 131.0;
+}
+
+#if SENSOR_PAYLOAD_BINARY
+void appendEnvironmentReadings(const SensorData& data) {
+    uint32_t now = millis();
+    float environment[] = {data.temperature, data.humidity, data.pressure, data.lightLevel};
+    uint8_t types[] = {SensorFrame::Temperature, SensorFrame::Humidity, SensorFrame::Pressure, SensorFrame::Light};
+    for (int i = 0; i < 4; i++) {
+        frameWriter.addFloat(types[i], sensorSequence[types[i]]++, now, &environment[i], 1);
+    }
+    
+    // Slowly varying values quantized to int16: dB at 0.01, volts at 0.001
+    frameWriter.addInt16(SensorFrame::SoundLevel, sensorSequence[SensorFrame::SoundLevel]++, now,
+                         &data.audioLevelDB, 1, -2);
+    frameWriter.addInt16(SensorFrame::Battery, sensorSequence[SensorFrame::Battery]++, now,
+                         &data.batteryVoltage, 1, -3);
+}
+
+void appendMotionReadings(const SensorData& data) {
+    uint32_t now = millis();
+    float accel[] = {data.accelX, data.accelY, data.accelZ};
+    float gyro[] = {data.gyroX, data.gyroY, data.gyroZ};
+    
+    // int16 at 0.001 g covers +/-32 g; 0.01 deg/s covers +/-327 deg/s
+    frameWriter.addInt16(SensorFrame::Acceleration, sensorSequence[SensorFrame::Acceleration]++, now,
+                         accel, 3, -3);
+    frameWriter.addInt16(SensorFrame::Gyroscope, sensorSequence[SensorFrame::Gyroscope]++, now,
+                         gyro, 3, -2);
+}
+
+void publishSensorFrame() {
+    if (frameWriter.empty()) {
+        return;
+    }
+    
+    String topic = "AIMusicHardware/sensors/" + config.deviceId + "/frame";
+    if (!mqttClient.publish(topic.c_str(), frameWriter.data(), frameWriter.size())) {
+        Serial.println("Failed to publish sensor frame (" + String(frameWriter.size()) + " bytes)");
+    }
+}
+#endif
+
 void publishSensorData(const SensorData& data) {
     DynamicJsonDocument doc(1024);
     
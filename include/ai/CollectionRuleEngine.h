@@ -0,0 +1,257 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+#include "ai/PresetMLAnalyzer.h"
+#include "ui/presets/PresetInfo.h"
+
+namespace AIMusicHardware {
+
+struct CollectionRule;
+struct SmartCollection;
+
+/**
+ * @brief Dense bitset over preset IDs
+ *
+ * Used for materialized collection membership. Preset IDs are assigned
+ * densely by CollectionRuleEngine, so a plain word array is smaller and
+ * faster to intersect than a sparse container for libraries of this size.
+ */
+class PresetBitmap {
+public:
+    void set(uint32_t id);
+    void reset(uint32_t id);
+    bool test(uint32_t id) const;
+    void clear();
+
+    /**
+     * @brief Number of set bits (maintained incrementally, O(1))
+     */
+    size_t count() const { return count_; }
+
+    /**
+     * @brief Count bits set in both bitmaps
+     */
+    size_t intersectionCount(const PresetBitmap& other) const;
+
+    /**
+     * @brief Count bits set in either bitmap
+     */
+    size_t unionCount(const PresetBitmap& other) const;
+
+    /**
+     * @brief Visit every set bit in ascending ID order
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t w = 0; w < words_.size(); ++w) {
+            uint64_t word = words_[w];
+            while (word != 0) {
+                int bit = __builtin_ctzll(word);
+                fn(static_cast<uint32_t>(w * 64 + bit));
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    std::vector<uint64_t> words_;
+    size_t count_ = 0;
+};
+
+/**
+ * @brief Incremental membership engine for smart collections
+ *
+ * Rules are compiled once into predicates over indexed preset fields
+ * (interned category/author/tag IDs, a fixed array of numeric features and
+ * user flags). Each preset is evaluated against every compiled collection
+ * when it is added or changed, and the result is kept as a membership
+ * bitmap plus a per-preset score column, so refreshing one preset never
+ * touches the rest of the library.
+ */
+class CollectionRuleEngine {
+public:
+    using PresetId = uint32_t;
+    static constexpr PresetId kInvalidPreset = 0xFFFFFFFFu;
+
+    CollectionRuleEngine() = default;
+
+    // Collection management
+
+    /**
+     * @brief Compile (or recompile) the rules of a collection
+     *
+     * Membership is rebuilt from the indexed preset records. Custom rules
+     * reuse the result of their last evaluation against each preset, so a
+     * newly compiled custom rule matches nothing until presets are pushed
+     * through updatePreset().
+     * @param collection Collection whose rules and thresholds to compile
+     */
+    void compileCollection(const SmartCollection& collection);
+
+    /**
+     * @brief Drop a compiled collection
+     * @param collectionId ID of collection to remove
+     */
+    void removeCollection(const std::string& collectionId);
+
+    /**
+     * @brief Re-evaluate every indexed preset for one collection
+     * @param collectionId ID of collection to re-evaluate
+     * @return true if membership changed
+     */
+    bool reevaluateCollection(const std::string& collectionId);
+
+    /**
+     * @brief Re-evaluate all auto-updating collections
+     *
+     * Only needed for time-dependent (Temporal) rules; all other rules are
+     * kept current by updatePreset()/removePreset().
+     * @return IDs of collections whose membership changed
+     */
+    std::vector<std::string> reevaluateTemporal();
+
+    // Preset indexing
+
+    /**
+     * @brief Index a new or changed preset and re-evaluate it
+     *
+     * Only auto-updating collections are re-evaluated; manual collections
+     * keep their membership until reevaluateCollection().
+     * @param preset Preset to index
+     * @param features Audio features of the preset
+     * @return IDs of auto-updating collections whose membership changed
+     */
+    std::vector<std::string> updatePreset(const PresetInfo& preset,
+                                          const AudioFeatureVector& features);
+
+    /**
+     * @brief Remove a preset from the index and every collection
+     * @param presetPath Path of preset to remove
+     * @return IDs of collections whose membership changed
+     */
+    std::vector<std::string> removePreset(const std::string& presetPath);
+
+    /**
+     * @brief Remove every indexed preset not present in the given set
+     * @param presets Presets that still exist
+     * @return IDs of collections whose membership changed
+     */
+    std::vector<std::string> retainPresets(const std::vector<PresetInfo>& presets);
+
+    // Queries
+
+    PresetId findPreset(const std::string& presetPath) const;
+    const std::string& getPresetPath(PresetId id) const;
+    size_t getPresetCount() const { return pathToId_.size(); }
+
+    /**
+     * @brief Presets qualifying for a collection (score >= minScore)
+     * @return Membership bitmap, nullptr if collection unknown
+     */
+    const PresetBitmap* getMembers(const std::string& collectionId) const;
+
+    /**
+     * @brief Presets listed in a collection (top maxSize of members)
+     * @return Listing bitmap, nullptr if collection unknown
+     */
+    const PresetBitmap* getListed(const std::string& collectionId) const;
+
+    /**
+     * @brief Score of a preset in a collection (0 if not a member)
+     */
+    float getScore(const std::string& collectionId, PresetId id) const;
+
+    /**
+     * @brief Rank members by score and refresh the listing bitmap
+     * @param collectionId Collection to materialize
+     * @return Listed (preset ID, score) pairs, best first, at most maxSize
+     */
+    std::vector<std::pair<PresetId, float>> materialize(const std::string& collectionId);
+
+    /**
+     * @brief Collections whose listing contains a preset
+     */
+    std::vector<std::string> findCollectionsListing(const std::string& presetPath) const;
+
+private:
+    // Numeric fields available to AudioCharacteristic rules
+    enum class Feature : uint8_t {
+        Brightness,
+        Warmth,
+        BassContent,
+        Complexity,
+        FilterResonance,
+        LfoDepth,
+        Count
+    };
+
+    struct CompiledRule {
+        enum class Field : uint8_t {
+            Feature, Favorite, Rating, PlayCount, AgeHours,
+            Category, Author, Tag, Custom, Never
+        };
+        enum class Op : uint8_t { Greater, Less, Near, Range, Equals, Contains };
+
+        Field field = Field::Never;
+        Op op = Op::Equals;
+        Feature feature = Feature::Brightness;
+        float lo = 0.0f;
+        float hi = 0.0f;
+        float weight = 1.0f;
+        uint32_t stringId = 0;                // Equals on interned strings
+        std::string needle;                   // Contains on interned strings
+        mutable std::vector<int8_t> containsCache; // per string ID: -1 unknown, 0/1
+        std::function<bool(const PresetInfo&, const AudioFeatureVector&)> customEvaluator;
+        PresetBitmap customMatches;           // last custom result per preset
+    };
+
+    struct CompiledCollection {
+        std::vector<CompiledRule> rules;
+        float totalWeight = 0.0f;
+        float minScore = 0.0f;
+        int maxSize = 0;
+        bool autoUpdate = true;
+        bool hasTemporal = false;
+        PresetBitmap members;
+        PresetBitmap listed;
+        std::vector<float> scores;            // indexed by PresetId
+    };
+
+    struct PresetRecord {
+        bool live = false;
+        uint32_t category = 0;
+        uint32_t author = 0;
+        std::vector<uint32_t> tags;           // sorted interned IDs
+        std::array<float, static_cast<size_t>(Feature::Count)> features{};
+        bool favorite = false;
+        int rating = 0;
+        int playCount = 0;
+        std::chrono::system_clock::time_point created;
+    };
+
+    uint32_t intern(const std::string& value);
+    CompiledRule compileRule(const CollectionRule& rule);
+    bool matchesContains(const CompiledRule& rule, uint32_t stringId) const;
+    float evaluateRule(const CompiledRule& rule, PresetId id, const PresetRecord& record,
+                       std::chrono::system_clock::time_point now) const;
+    bool evaluateInto(CompiledCollection& collection, PresetId id, const PresetRecord& record,
+                      std::chrono::system_clock::time_point now);
+
+    std::unordered_map<std::string, uint32_t> stringIds_;
+    std::vector<std::string> strings_;
+
+    std::unordered_map<std::string, PresetId> pathToId_;
+    std::vector<std::string> paths_;
+    std::vector<PresetRecord> records_;
+    std::vector<PresetId> freeIds_;
+
+    std::unordered_map<std::string, CompiledCollection> collections_;
+};
+
+} // namespace AIMusicHardware
@@ -9,6 +9,7 @@
 #include <set>
 #include "PresetMLAnalyzer.h"
 #include "PresetRecommendationEngine.h"
+#include "CollectionRuleEngine.h"
 #include "ui/presets/PresetInfo.h"
 
 namespace AIMusicHardware {
@@ -254,8 +255,11 @@ public:
                          const std::vector<PresetInfo>& presets);
     
     /**
-     * @brief Add new preset to relevant collections
-     * @param preset New preset to evaluate
+     * @brief Add new or changed preset to relevant collections
+     * 
+     * Only this preset is re-evaluated; collection membership for every
+     * other preset is kept from the rule engine's bitmaps.
+     * @param preset New or changed preset to evaluate
      * @return Vector of collection IDs that included the preset
      */
     std::vector<std::string> addPresetToCollections(const PresetInfo& preset);
@@ -427,6 +431,7 @@ private:
     
     // Data storage
     std::unordered_map<std::string, SmartCollection> collections_;
+    CollectionRuleEngine ruleEngine_;       // Compiled rules and membership bitmaps
     std::unordered_map<std::string, SmartPlaylist> playlists_;
     std::unordered_map<std::string, CollectionTemplate> templates_;
     
@@ -451,6 +456,18 @@ private:
      */
     std::string generatePlaylistId();
     
+    /**
+     * @brief Rebuild a collection's preset list from its membership bitmap
+     * @param collection Collection to refresh
+     */
+    void materializeCollection(SmartCollection& collection);
+    
+    /**
+     * @brief Materialize every collection in a list of changed IDs
+     * @param collectionIds IDs reported as changed by the rule engine
+     */
+    void materializeCollections(const std::vector<std::string>& collectionIds);
+    
     /**
      * @brief Update collection statistics
      */
@@ -8,6 +8,9 @@
 #include <atomic>
 #include <chrono>
 #include "AudioErrorHandler.h"
+#include "DspLoadMonitor.h"
+#include "LoadGovernor.h"
+#include "ParameterStore.h"
 
 namespace AIMusicHardware {
 
@@ -59,9 +62,49 @@ public:
         int overrunCount = 0;
         double uptime = 0.0;
         bool isHealthy = true;
+
+        // Per-block load distribution and deadline misses since the last reset
+        DspLoadMonitor::LoadStatistics dspLoad;
+        std::vector<DspLoadMonitor::SubsystemStatistics> subsystemLoad;
+        
+        // Quality the load governor has settled on, and how often it changed
+        LoadGovernor::QualityLevel qualityLevel = LoadGovernor::QualityLevel::Full;
+        uint64_t qualityDegradations = 0;
+        uint64_t qualityRestorations = 0;
     };
     PerformanceMetrics getPerformanceMetrics() const;
     
+    /**
+     * @brief Get the per-block DSP load monitor
+     *
+     * The engine times its own "parameters" (parameter store update and
+     * snapshot) and "callback" (the whole user callback) subsystems.
+     * Register finer-grained subsystems here at setup and time them from
+     * the audio callback; exportJson() gives the full histograms.
+     */
+    DspLoadMonitor& getLoadMonitor() { return loadMonitor_; }
+    const DspLoadMonitor& getLoadMonitor() const { return loadMonitor_; }
+    
+    /**
+     * @brief Get the load governor fed by every callback's load
+     *
+     * Read getLevel() at the start of each block to apply the quality level
+     * to the synthesizer and effects; the level changes on the audio thread
+     * after a block.
+     */
+    LoadGovernor& getLoadGovernor() { return loadGovernor_; }
+    
+    /**
+     * @brief Get the audio-side parameter store
+     *
+     * Register parameters and bind producers (ParameterBridge,
+     * AutomationPlayer) at setup. Every callback applies the queued changes
+     * before the audio callback runs, so it reads this block's values and
+     * getChangedIndices(), and publishes a snapshot for readers afterwards.
+     */
+    ParameterStore& getParameterStore() { return parameterStore_; }
+    const ParameterStore& getParameterStore() const { return parameterStore_; }
+    
     /**
      * @brief Enable/disable performance monitoring
      * @param enabled Whether to enable monitoring
@@ -112,6 +155,7 @@ private:
     mutable std::mutex performanceMutex_;
     std::atomic<bool> performanceMonitoringEnabled_{true};
     std::atomic<bool> audioSafetyEnabled_{true};
+    std::atomic<bool> audioThreadPrepared_{false};
     std::chrono::steady_clock::time_point startTime_;
     
     // Performance metrics (atomic for thread safety)
@@ -127,6 +171,11 @@ private:
     std::chrono::steady_clock::time_point lastCallbackTime_;
     std::chrono::microseconds lastCallbackDuration_{0};
     float cpuLoadSmoothingFactor_ = 0.95f; // For exponential smoothing
+    DspLoadMonitor loadMonitor_;
+    const int parametersSubsystem_;
+    const int callbackSubsystem_;
+    LoadGovernor loadGovernor_;
+    ParameterStore parameterStore_;
     
     class Impl;
     std::unique_ptr<Impl> pimpl_;
@@ -134,7 +183,8 @@ private:
     // Internal methods for performance monitoring
     void updatePerformanceMetrics();
     void measureCallbackPerformance(const std::chrono::steady_clock::time_point& start,
-                                   const std::chrono::steady_clock::time_point& end);
+                                   const std::chrono::steady_clock::time_point& end,
+                                   int numFrames);
     void checkAudioSafety(float* outputBuffer, int numFrames);
     
     // Friend function for callback access to private methods
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AIMusicHardware {
+
+/**
+ * @brief Distribution of per-block DSP load, and what took the time
+ *
+ * Every block the audio thread reports how long it took; the load is that
+ * duration as a percentage of the block's deadline (its length in time).
+ * Loads go into log-linear (HDR-style) histograms: exact below 1.28%,
+ * within 1/64 of the value above that, up to 10000%. That is enough to
+ * read p99.9 to a fraction of a percent, which a smoothed average hides.
+ * Blocks above 80, 90 and 100% of the deadline are counted separately.
+ *
+ * Subsystems registered at setup (synth, effects, sequencer, ...) report
+ * their own time within a block, with addSubsystemTime() or a
+ * ScopedSubsystem; each gets a histogram of its share of the deadline.
+ *
+ * The audio thread is the only writer: recording is a handful of relaxed
+ * atomic stores, with no locks or allocation. Readers copy the counters
+ * from any thread; a snapshot taken mid-block can be one block out of
+ * step between counters. reset() is applied by the audio thread at the
+ * next block.
+ */
+class DspLoadMonitor {
+public:
+    static constexpr int kMaxSubsystems = 8;
+
+    /**
+     * @brief Load figures of one histogram, in percent of the deadline
+     *
+     * Percentiles are the highest load that falls in the same bucket, so
+     * they never understate the load.
+     */
+    struct LoadStatistics {
+        uint64_t blocks = 0;
+        double mean = 0.0;
+        double max = 0.0;
+        double p50 = 0.0;
+        double p90 = 0.0;
+        double p99 = 0.0;
+        double p999 = 0.0;
+
+        uint64_t over80 = 0;   // Blocks above 80% of the deadline
+        uint64_t over90 = 0;
+        uint64_t over100 = 0;  // Missed deadlines
+    };
+
+    struct SubsystemStatistics {
+        std::string name;
+        LoadStatistics load;
+    };
+
+    explicit DspLoadMonitor(int sampleRate = 44100);
+    ~DspLoadMonitor();
+
+    //--------------------------------------------------------------------------
+    // Setup
+    //--------------------------------------------------------------------------
+
+    void setSampleRate(int sampleRate);
+    int getSampleRate() const { return sampleRate_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Register a subsystem to break the load down by
+     * @return Its index, the existing index for a known name, or -1 when full
+     */
+    int addSubsystem(const std::string& name);
+    int getSubsystemCount() const { return subsystemCount_.load(std::memory_order_acquire); }
+
+    //--------------------------------------------------------------------------
+    // Audio thread
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Add time a subsystem spent in the current block
+     */
+    void addSubsystemTime(int index, std::chrono::nanoseconds duration);
+
+    /**
+     * @brief Record a finished block
+     * @param duration Time the whole block took
+     * @param numFrames Block length, which sets its deadline
+     * @return The block's load in percent
+     */
+    float endBlock(std::chrono::nanoseconds duration, int numFrames);
+
+    /**
+     * @brief Times the enclosing scope for a subsystem
+     */
+    class ScopedSubsystem {
+    public:
+        ScopedSubsystem(DspLoadMonitor& monitor, int index)
+            : monitor_(monitor), index_(index), start_(std::chrono::steady_clock::now()) {}
+        ~ScopedSubsystem() { monitor_.addSubsystemTime(index_, std::chrono::steady_clock::now() - start_); }
+
+        ScopedSubsystem(const ScopedSubsystem&) = delete;
+        ScopedSubsystem& operator=(const ScopedSubsystem&) = delete;
+
+    private:
+        DspLoadMonitor& monitor_;
+        int index_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    //--------------------------------------------------------------------------
+    // Readers (any thread)
+    //--------------------------------------------------------------------------
+
+    LoadStatistics getStatistics() const;
+    std::vector<SubsystemStatistics> getSubsystemStatistics() const;
+
+    /**
+     * @brief Load of the last finished block, in percent
+     */
+    float getLastLoad() const { return lastLoad_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Clear every histogram and counter at the next block
+     */
+    void reset();
+
+    /**
+     * @brief Statistics and non-empty histogram buckets as JSON
+     */
+    std::string exportJson() const;
+
+    // Histogram layout, exposed for tests and exporters
+    static constexpr int kSubBucketBits = 7;
+    static constexpr uint32_t kMaxValue = (1u << 20) - 1;  // In hundredths of a percent
+    static int bucketForValue(uint32_t hundredths);
+    static uint32_t highestValueInBucket(int bucket);
+
+private:
+    static constexpr uint32_t kSubBuckets = 1u << kSubBucketBits;
+    static constexpr uint32_t kHalfSubBuckets = kSubBuckets / 2;
+    static constexpr int kNumBuckets = static_cast<int>(kSubBuckets + (20 - kSubBucketBits) * kHalfSubBuckets);
+
+    struct Histogram {
+        std::array<std::atomic<uint64_t>, kNumBuckets> counts{};
+        std::atomic<uint64_t> blocks{0};
+        std::atomic<uint64_t> sum{0};  // Hundredths of a percent
+        std::atomic<uint32_t> max{0};
+        std::atomic<uint64_t> over80{0};
+        std::atomic<uint64_t> over90{0};
+        std::atomic<uint64_t> over100{0};
+
+        void record(uint32_t hundredths);
+        void clear();
+        LoadStatistics statistics() const;
+    };
+
+    std::atomic<int> sampleRate_;
+
+    Histogram total_;
+    std::array<Histogram, kMaxSubsystems> subsystems_;
+    std::array<std::string, kMaxSubsystems> subsystemNames_;
+    std::atomic<int> subsystemCount_{0};
+
+    // Audio thread: subsystem nanoseconds accumulated in the current block
+    std::array<int64_t, kMaxSubsystems> blockTime_{};
+
+    std::atomic<float> lastLoad_{0.0f};
+    std::atomic<uint64_t> resetRequests_{0};
+    uint64_t resetsApplied_ = 0;
+};
+
+} // namespace AIMusicHardware
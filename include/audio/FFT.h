@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vector>
+
+namespace AIMusicHardware {
+
+/**
+ * @brief Radix-2 real-input FFT with precomputed tables
+ *
+ * Transforms N real samples by packing them into an N/2-point complex
+ * transform and splitting the result, so a real spectrum costs roughly
+ * half of a full complex FFT. Twiddle factors, the bit-reversal table,
+ * the analysis window and all scratch space are allocated in the
+ * constructor; the transform calls themselves never allocate.
+ *
+ * An instance is not thread-safe (it owns scratch buffers); give each
+ * thread that needs spectra its own FFT.
+ */
+class FFT {
+public:
+    enum class Window {
+        Rectangular,
+        Hann,
+        BlackmanHarris
+    };
+
+    /**
+     * @brief Create an FFT of the given size
+     * @param size Transform length; rounded down to a power of two (minimum 4)
+     * @param window Analysis window applied by computeMagnitudes()
+     */
+    explicit FFT(int size, Window window = Window::Hann);
+
+    int getSize() const { return size_; }
+
+    /**
+     * @brief Number of spectrum bins produced (size / 2 + 1, DC to Nyquist)
+     */
+    int getNumBins() const { return size_ / 2 + 1; }
+
+    void setWindow(Window window);
+    Window getWindow() const { return window_; }
+
+    /**
+     * @brief Forward transform of real input, no windowing
+     * @param input getSize() real samples
+     * @param real Receives getNumBins() real parts
+     * @param imag Receives getNumBins() imaginary parts
+     */
+    void performRealForward(const float* input, float* real, float* imag);
+
+    /**
+     * @brief Windowed magnitude spectrum
+     *
+     * Magnitudes are normalized by the window gain so a full-scale sine
+     * that lands on a bin reads 1.0.
+     *
+     * @param input getSize() real samples
+     * @param magnitudes Receives getNumBins() linear magnitudes
+     */
+    void computeMagnitudes(const float* input, float* magnitudes);
+
+    /**
+     * @brief In-place complex transform of getSize() / 2 points
+     *
+     * Exposed for modules that need a complex FFT of that length.
+     */
+    void transformComplex(float* real, float* imag);
+
+    /**
+     * @brief Frequency in Hz of a bin for the given sample rate
+     */
+    float binFrequency(int bin, float sampleRate) const {
+        return static_cast<float>(bin) * sampleRate / static_cast<float>(size_);
+    }
+
+    static bool isPowerOfTwo(int value) { return value > 0 && (value & (value - 1)) == 0; }
+
+private:
+    int size_;
+    int halfSize_;
+    Window window_;
+    float windowGain_ = 1.0f;
+
+    std::vector<float> windowTable_;
+    std::vector<int> bitReverse_;
+    std::vector<float> twiddleCos_;   // complex stage twiddles (halfSize_ / 2)
+    std::vector<float> twiddleSin_;
+    std::vector<float> splitCos_;     // real split twiddles (halfSize_ + 1)
+    std::vector<float> splitSin_;
+
+    // Scratch
+    std::vector<float> windowed_;
+    std::vector<float> workReal_;
+    std::vector<float> workImag_;
+    std::vector<float> binReal_;
+    std::vector<float> binImag_;
+};
+
+/**
+ * @brief Maps linear FFT bins onto logarithmically spaced bands
+ *
+ * Band edges are spaced evenly in octaves between a minimum and maximum
+ * frequency. Bands wide enough to contain whole bins take the peak bin
+ * magnitude; narrow low-frequency bands that fall between bins are
+ * interpolated at their center frequency, so no band is left empty.
+ */
+class LogFrequencyBands {
+public:
+    LogFrequencyBands() = default;
+
+    /**
+     * @brief Precompute band-to-bin tables
+     * @param numBands Number of output bands
+     * @param fftSize Size of the FFT producing the magnitudes
+     * @param sampleRate Sample rate of the analysed audio
+     * @param minFrequency Lower edge of the first band in Hz
+     * @param maxFrequency Upper edge of the last band (clamped to Nyquist)
+     */
+    void configure(int numBands, int fftSize, float sampleRate,
+                   float minFrequency = 20.0f, float maxFrequency = 20000.0f);
+
+    /**
+     * @brief Reduce fftSize / 2 + 1 magnitudes into getNumBands() values
+     */
+    void process(const float* magnitudes, float* bands) const;
+
+    int getNumBands() const { return static_cast<int>(bands_.size()); }
+    float getBandCenter(int band) const { return bands_[band].centerHz; }
+
+private:
+    struct Band {
+        int firstBin;       // inclusive
+        int lastBin;        // exclusive; equal to firstBin when interpolated
+        float centerBin;    // fractional bin at band center
+        float centerHz;
+    };
+
+    std::vector<Band> bands_;
+    int numBins_ = 0;
+};
+
+} // namespace AIMusicHardware
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "../synthesis/voice/voice_manager.h"
+
+namespace AIMusicHardware {
+
+/**
+ * @brief Lowers render quality while the audio callback nears its deadline
+ *
+ * Fed the load of every block (percent of its deadline, as returned by
+ * DspLoadMonitor::endBlock), it steps through quality levels, cheapest
+ * savings first. A block above the degrade threshold lowers quality one
+ * level, at most once per hold time so the previous step can take effect;
+ * a missed deadline lowers it straight away. Quality comes back one level
+ * at a time, only after the load has stayed below the lower restore
+ * threshold for the restore time, so it does not flap around a threshold.
+ *
+ * update() runs on the audio thread and does not lock or allocate, as
+ * long as the thread's RealtimeLog ring is prepared (level changes are
+ * logged; AudioEngine prepares its callback thread). The simplest consumer
+ * reads getLevel() at the start of each block and applies it with
+ * renderQualityFor() and bypassesEffectTails(). The optional level
+ * callback is called from update() when the level changes, so it must
+ * follow the same rules as update(). Thresholds and the callback are set
+ * up before audio starts.
+ */
+class LoadGovernor {
+public:
+    enum class QualityLevel {
+        Full,               // Everything on
+        NoOversampling,     // Oscillators stop oversampling
+        ReducedUnison,      // Stacked voices render two oscillators
+        EarlyVoiceStealing, // Quiet release tails are cut, released voices stolen first
+        NoEffectTails       // Delays and reverbs are bypassed
+    };
+    static constexpr QualityLevel kLowestQuality = QualityLevel::NoEffectTails;
+
+    struct Thresholds {
+        float degradeLoad = 85.0f;      // Percent of the deadline
+        float restoreLoad = 60.0f;
+        double degradeHoldSeconds = 0.05;
+        double restoreSeconds = 2.0;
+    };
+
+    using LevelCallback = std::function<void(QualityLevel)>;
+
+    explicit LoadGovernor(int sampleRate = 44100);
+
+    void setSampleRate(int sampleRate);
+    void setThresholds(const Thresholds& thresholds) { thresholds_ = thresholds; }
+    const Thresholds& getThresholds() const { return thresholds_; }
+    void setLevelCallback(LevelCallback callback) { levelCallback_ = std::move(callback); }
+
+    /**
+     * @brief Enable or disable the governor; disabling restores full quality at the next block
+     */
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Account for a finished block (audio thread)
+     * @param loadPercent Block duration in percent of its deadline
+     * @param numFrames Block length
+     * @return The quality level for the next block
+     */
+    QualityLevel update(float loadPercent, int numFrames);
+
+    QualityLevel getLevel() const { return level_.load(std::memory_order_relaxed); }
+    uint64_t getDegradeCount() const { return degradeCount_.load(std::memory_order_relaxed); }
+    uint64_t getRestoreCount() const { return restoreCount_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Voice render quality at a level
+     */
+    static RenderQuality renderQualityFor(QualityLevel level);
+
+    /**
+     * @brief Whether effects with tails are bypassed at a level
+     */
+    static bool bypassesEffectTails(QualityLevel level) { return level >= QualityLevel::NoEffectTails; }
+
+    static const char* levelName(QualityLevel level);
+
+private:
+    void changeLevel(QualityLevel level, float loadPercent);
+
+    std::atomic<int> sampleRate_;
+    std::atomic<bool> enabled_{true};
+    Thresholds thresholds_;
+    LevelCallback levelCallback_;
+
+    std::atomic<QualityLevel> level_{QualityLevel::Full};
+    std::atomic<uint64_t> degradeCount_{0};
+    std::atomic<uint64_t> restoreCount_{0};
+
+    // Audio thread: frames since the last level change, and spent below the restore threshold
+    int64_t framesSinceChange_ = 0;
+    int64_t framesBelowRestore_ = 0;
+};
+
+} // namespace AIMusicHardware
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AIMusicHardware {
+
+/**
+ * @brief Audio-side parameter values with lock-free input and output
+ *
+ * Parameters are registered once by string ID and addressed afterwards by
+ * a dense integer index, so nothing on the hot path copies or hashes
+ * strings.
+ *
+ * Input: every change source (UI, MIDI, IoT, automation, ...) has its own
+ * wait-free single-producer single-consumer ring, so each producer thread
+ * really is the only writer of its queue. Changes carry a global sequence
+ * number and processUpdates() merges the rings on the audio thread in push
+ * order, so the latest write to a parameter wins whichever source it came
+ * from.
+ *
+ * Output: publishSnapshot() copies the audio thread's values into one of
+ * two snapshot buffers and bumps a version. readSnapshot() copies the
+ * latest published buffer from any thread without locking and retries if
+ * the audio thread overwrote it mid-copy; the audio thread never waits.
+ *
+ * Threading: addParameter() is setup-only, before producers, the audio
+ * thread or readers start. push() may be called concurrently for different
+ * sources, but from at most one thread per source. processUpdates(),
+ * setValue(), getValue() and publishSnapshot() belong to the audio thread.
+ * Nothing after setup allocates.
+ */
+class ParameterStore {
+public:
+    /**
+     * @brief Producer of a change; each source has its own queue
+     */
+    enum class ChangeSource {
+        UI,
+        MIDI,
+        IoT,
+        Automation,
+        Preset,
+        Internal
+    };
+    static constexpr int kNumSources = 6;
+
+    /**
+     * @param queueCapacity Changes per source queue; rounded up to a power of two
+     */
+    explicit ParameterStore(size_t queueCapacity = 1024);
+
+    //--------------------------------------------------------------------------
+    // Setup
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Register a parameter
+     * @return Its index, or the existing index if the ID is already registered
+     */
+    int addParameter(const std::string& id, float defaultValue = 0.0f, float minValue = 0.0f, float maxValue = 1.0f);
+
+    /**
+     * @brief Index for a parameter ID, or -1 (resolve once, not per change)
+     */
+    int getIndex(const std::string& id) const;
+
+    const std::string& getId(int index) const;
+    int getParameterCount() const { return static_cast<int>(ids_.size()); }
+
+    //--------------------------------------------------------------------------
+    // Producers
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Queue a change from a source (one thread per source)
+     * @return false if the index is invalid or the source's queue is full;
+     *         both are counted in getDroppedCount()
+     */
+    bool push(ChangeSource source, int index, float value);
+
+    //--------------------------------------------------------------------------
+    // Audio thread
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Apply every change queued before the call, in push order
+     *
+     * Values are clamped to the parameter range. The indices that changed
+     * are listed once each in getChangedIndices() until the next call.
+     *
+     * @return Number of queued changes applied
+     */
+    size_t processUpdates();
+
+    float getValue(int index) const { return values_[static_cast<size_t>(index)]; }
+    const float* getValues() const { return values_.data(); }
+
+    /**
+     * @brief Set a value directly from the audio thread (e.g. engine-driven)
+     */
+    void setValue(int index, float value);
+
+    /**
+     * @brief Parameters changed by the last processUpdates() or since by setValue()
+     */
+    const std::vector<int>& getChangedIndices() const { return changedIndices_; }
+
+    /**
+     * @brief Publish current values to readers if anything changed since the last publish
+     * @return true if a new snapshot version was published
+     */
+    bool publishSnapshot();
+
+    //--------------------------------------------------------------------------
+    // Readers (any thread)
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Version of the latest published snapshot (0 before the first publish)
+     */
+    uint64_t getSnapshotVersion() const { return version_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Copy the latest consistent snapshot
+     *
+     * Before the first publish this returns the registered defaults.
+     *
+     * @param out Receives one value per parameter, resized if needed
+     * @return Version of the copied snapshot
+     */
+    uint64_t readSnapshot(std::vector<float>& out) const;
+
+    uint64_t getDroppedCount(ChangeSource source) const;
+    size_t getQueuedCount(ChangeSource source) const;
+
+private:
+    struct Change {
+        uint64_t sequence;
+        int32_t index;
+        float value;
+    };
+
+    struct SourceQueue {
+        std::vector<Change> buffer;
+
+        // Monotonic counters, wrapped with mask_; kept on separate cache lines
+        alignas(64) std::atomic<size_t> writeIndex{0};
+        alignas(64) std::atomic<size_t> readIndex{0};
+        alignas(64) std::atomic<uint64_t> dropped{0};
+    };
+
+    void markChanged(int index);
+
+    // Registration
+    std::vector<std::string> ids_;
+    std::unordered_map<std::string, int> indexById_;
+    std::vector<float> minValues_;
+    std::vector<float> maxValues_;
+
+    // Input
+    std::array<SourceQueue, kNumSources> queues_;
+    size_t mask_;
+    alignas(64) std::atomic<uint64_t> sequence_{0};
+
+    // Audio thread state
+    std::vector<float> values_;
+    std::vector<uint8_t> changedFlags_;
+    std::vector<int> changedIndices_;
+    bool dirty_ = false;
+
+    // Double-buffered output; writing_ is the version being written, so a
+    // reader of version v knows its buffer was reused once writing_ > v + 1
+    std::array<std::vector<std::atomic<float>>, 2> snapshots_;
+    alignas(64) std::atomic<uint64_t> version_{0};
+    alignas(64) std::atomic<uint64_t> writing_{0};
+};
+
+} // namespace AIMusicHardware
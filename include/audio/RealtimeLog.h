@@ -0,0 +1,257 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "../ui/presets/PresetLogger.h"
+
+/**
+ * @brief Lowest level compiled into RT_LOG_* calls (a LogLevel value)
+ *
+ * Calls below it are discarded at compile time: their arguments are not
+ * evaluated and no code is generated. Defaults to Info; define it as 0 or 1
+ * to get trace or debug logging from the audio and MIDI paths.
+ */
+#ifndef AIMUSIC_RT_LOG_LEVEL
+#define AIMUSIC_RT_LOG_LEVEL 2
+#endif
+
+namespace AIMusicHardware {
+
+/**
+ * @brief Static description of one logging call site
+ *
+ * Each RT_LOG_* call defines one of these; its address is the format ID a
+ * record carries, so nothing about the message is copied per call.
+ */
+struct RealtimeLogSite {
+    LogLevel level;
+    LogCategory category;
+    const char* format;   // "{}" marks each argument
+    const char* function;
+    const char* file;
+    int line;
+};
+
+/**
+ * @brief Logging that is safe to call from the audio and MIDI threads
+ *
+ * A call copies a fixed-size binary record (call site, timestamp and raw
+ * arguments) into a single-producer single-consumer ring owned by the
+ * calling thread: no locks, no allocation, no formatting and no I/O. A
+ * background thread drains every ring, formats the records in timestamp
+ * order and hands them to a PresetLogger, so they reach the same outputs,
+ * filter and rotating FileLogOutput as the rest of the application's logs.
+ *
+ * Arguments may be integers, enums, bools, floating point values or
+ * strings; strings are copied into the record and truncated to what is
+ * left of its kMaxText bytes. A full ring drops the record and counts it;
+ * the drain reports the count.
+ *
+ * Each thread gets its ring on its first call, which allocates; call
+ * prepareThread() from the audio thread's setup to take that out of the
+ * callback. Rings of threads that have exited are reused.
+ */
+class RealtimeLog {
+public:
+    static constexpr int kMaxArgs = 6;
+    static constexpr size_t kMaxText = 64;
+
+    enum class ArgType : uint8_t {
+        Int,
+        UInt,
+        Double,
+        Bool,
+        Text
+    };
+
+    /**
+     * @brief One logged call, as stored in a ring
+     */
+    struct Record {
+        const RealtimeLogSite* site;
+        int64_t time;  // system_clock ticks
+        uint8_t numArgs;
+        uint8_t textUsed;
+        ArgType types[kMaxArgs];
+        union Value {
+            int64_t i;
+            uint64_t u;
+            double d;
+        } values[kMaxArgs];  // Text: offset into text in the low 16 bits, length above
+        char text[kMaxText];
+    };
+
+    /**
+     * @param ringCapacity Records per thread ring; rounded up to a power of two
+     */
+    explicit RealtimeLog(size_t ringCapacity = 1024);
+    ~RealtimeLog();
+
+    RealtimeLog(const RealtimeLog&) = delete;
+    RealtimeLog& operator=(const RealtimeLog&) = delete;
+
+    /**
+     * @brief Shared instance used by the RT_LOG_* macros
+     *
+     * Drains into PresetLogger::getInstance() on a background thread.
+     */
+    static RealtimeLog& getInstance();
+
+    //--------------------------------------------------------------------------
+    // Producers (any thread)
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Queue a record for a call site; use the RT_LOG_* macros instead
+     */
+    template <typename... Args>
+    void write(const RealtimeLogSite& site, const Args&... args) {
+        static_assert(sizeof...(Args) <= kMaxArgs, "Too many arguments for a real-time log record");
+        Record record;
+        record.site = &site;
+        record.time = std::chrono::system_clock::now().time_since_epoch().count();
+        record.numArgs = 0;
+        record.textUsed = 0;
+        (encodeArg(record, args), ...);
+        push(record);
+    }
+
+    /**
+     * @brief Allocate the calling thread's ring now rather than at its first record
+     */
+    void prepareThread();
+
+    //--------------------------------------------------------------------------
+    // Consumer
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Where drained records go (nullptr discards them)
+     */
+    void setLogger(PresetLogger* logger);
+
+    /**
+     * @brief Drain on a background thread every interval
+     */
+    void start(std::chrono::milliseconds interval = std::chrono::milliseconds(20));
+
+    /**
+     * @brief Stop the background thread, draining what is left
+     */
+    void stop();
+
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Format and hand over every queued record now
+     * @return Number of records drained
+     */
+    size_t drain();
+
+    /**
+     * @brief Text of a record, with its arguments in place of the "{}" markers
+     */
+    static std::string format(const Record& record);
+
+    uint64_t getDroppedCount() const;
+    uint64_t getDrainedCount() const { return drained_.load(std::memory_order_relaxed); }
+    size_t getRingCount() const;
+
+private:
+    struct Ring;
+
+    template <typename T>
+    static void encodeArg(Record& record, const T& value) {
+        const int index = record.numArgs++;
+        if constexpr (std::is_same_v<T, bool>) {
+            record.types[index] = ArgType::Bool;
+            record.values[index].u = value ? 1 : 0;
+        } else if constexpr (std::is_enum_v<T>) {
+            record.types[index] = ArgType::Int;
+            record.values[index].i = static_cast<int64_t>(value);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            record.types[index] = ArgType::Int;
+            record.values[index].i = value;
+        } else if constexpr (std::is_integral_v<T>) {
+            record.types[index] = ArgType::UInt;
+            record.values[index].u = value;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            record.types[index] = ArgType::Double;
+            record.values[index].d = value;
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            encodeText(record, index, value.data(), value.size());
+        } else {
+            static_assert(std::is_convertible_v<T, const char*>, "Unsupported real-time log argument type");
+            const char* text = value;
+            encodeText(record, index, text ? text : "(null)", text ? std::strlen(text) : 6);
+        }
+    }
+
+    static void encodeText(Record& record, int index, const char* text, size_t length);
+
+    void push(const Record& record);
+    Ring* getThreadRing();
+    void drainThread(std::chrono::milliseconds interval);
+
+    const size_t ringCapacity_;
+    const uint64_t instanceId_;
+
+    // Rings are only added or reused under ringsMutex_; producers never take it
+    // once they have their ring
+    std::vector<std::shared_ptr<Ring>> rings_;
+    mutable std::mutex ringsMutex_;
+
+    // Drain state
+    std::mutex drainMutex_;
+    PresetLogger* logger_ = nullptr;
+    std::vector<Record> pending_;
+    std::vector<std::thread::id> pendingThreads_;
+    std::vector<size_t> order_;
+    std::atomic<uint64_t> drained_{0};
+
+    std::thread thread_;
+    std::mutex threadMutex_;
+    std::condition_variable wake_;
+    std::atomic<bool> running_{false};
+    bool stopRequested_ = false;
+};
+
+} // namespace AIMusicHardware
+
+/**
+ * @brief Log to a given RealtimeLog if the level is compiled in
+ *
+ * The format is a string literal with "{}" for each argument, e.g.
+ * RT_LOG_TO(log, LogLevel::Debug, LogCategory::Audio, "Pitch bend {} on channel {}", value, channel).
+ */
+#define RT_LOG_TO(log, level, category, format, ...)                                                    \
+    do {                                                                                                \
+        if constexpr (static_cast<int>(level) >= AIMUSIC_RT_LOG_LEVEL) {                                \
+            static const ::AIMusicHardware::RealtimeLogSite rtLogSite{level, category, format,          \
+                                                                      __FUNCTION__, __FILE__, __LINE__}; \
+            (log).write(rtLogSite, ##__VA_ARGS__);                                                      \
+        }                                                                                               \
+    } while (0)
+
+#define RT_LOG(level, category, format, ...) \
+    RT_LOG_TO(::AIMusicHardware::RealtimeLog::getInstance(), level, category, format, ##__VA_ARGS__)
+
+#define RT_LOG_TRACE(category, format, ...) RT_LOG(::AIMusicHardware::LogLevel::Trace, category, format, ##__VA_ARGS__)
+#define RT_LOG_DEBUG(category, format, ...) RT_LOG(::AIMusicHardware::LogLevel::Debug, category, format, ##__VA_ARGS__)
+#define RT_LOG_INFO(category, format, ...) RT_LOG(::AIMusicHardware::LogLevel::Info, category, format, ##__VA_ARGS__)
+#define RT_LOG_WARNING(category, format, ...) \
+    RT_LOG(::AIMusicHardware::LogLevel::Warning, category, format, ##__VA_ARGS__)
+#define RT_LOG_ERROR(category, format, ...) RT_LOG(::AIMusicHardware::LogLevel::Error, category, format, ##__VA_ARGS__)
+#define RT_LOG_CRITICAL(category, format, ...) \
+    RT_LOG(::AIMusicHardware::LogLevel::Critical, category, format, ##__VA_ARGS__)
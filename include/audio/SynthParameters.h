@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace AIMusicHardware {
+
+/**
+ * @brief Every parameter Synthesizer::setParameter() understands
+ *
+ * Values index kSynthParameters. Resolve string IDs to these once, when a
+ * control, MIDI mapping or IoT topic is bound, with findSynthParameter();
+ * after that setting a parameter is an indexed store with no string work.
+ */
+enum class SynthParamId : uint8_t {
+    OscillatorType,
+    OscillatorFrame,
+    FilterCutoff,
+    FilterResonance,
+    MasterVolume,
+    EnvelopeAttack,
+    EnvelopeDecay,
+    EnvelopeSustain,
+    EnvelopeRelease,
+    VoiceCount,
+    Lfo1Rate,
+    Lfo1Shape,
+    Lfo2Rate,
+    Lfo2Shape,
+    Count
+};
+
+constexpr int kNumSynthParameters = static_cast<int>(SynthParamId::Count);
+
+/**
+ * @brief Static description of a synthesizer parameter
+ */
+struct SynthParameterInfo {
+    SynthParamId parameter;
+    std::string_view id;
+    float minValue;
+    float maxValue;
+    float defaultValue;
+    bool stepped;  // Whole numbers only (types, shapes, counts)
+};
+
+/**
+ * @brief The parameter registry, in SynthParamId order
+ */
+constexpr std::array<SynthParameterInfo, kNumSynthParameters> kSynthParameters = {{
+    {SynthParamId::OscillatorType,  "oscillator_type",  0.0f,   4.0f,    0.0f,  true},
+    {SynthParamId::OscillatorFrame, "oscillator_frame", 0.0f,   1.0f,    0.0f,  false},
+    {SynthParamId::FilterCutoff,    "filter_cutoff",    0.0f,   1.0f,    1.0f,  false},
+    {SynthParamId::FilterResonance, "filter_resonance", 0.0f,   1.0f,    0.5f,  false},
+    {SynthParamId::MasterVolume,    "master_volume",    0.0f,   1.0f,    0.7f,  false},
+    {SynthParamId::EnvelopeAttack,  "envelope_attack",  0.001f, 30.0f,   0.01f, false},
+    {SynthParamId::EnvelopeDecay,   "envelope_decay",   0.001f, 30.0f,   0.1f,  false},
+    {SynthParamId::EnvelopeSustain, "envelope_sustain", 0.0f,   1.0f,    0.7f,  false},
+    {SynthParamId::EnvelopeRelease, "envelope_release", 0.001f, 30.0f,   0.5f,  false},
+    {SynthParamId::VoiceCount,      "voice_count",      1.0f,   128.0f,  16.0f, true},
+    {SynthParamId::Lfo1Rate,        "lfo1_rate",        0.01f,  20.0f,   1.0f,  false},
+    {SynthParamId::Lfo1Shape,       "lfo1_shape",       0.0f,   4.0f,    0.0f,  true},
+    {SynthParamId::Lfo2Rate,        "lfo2_rate",        0.01f,  20.0f,   0.5f,  false},
+    {SynthParamId::Lfo2Shape,       "lfo2_shape",       0.0f,   4.0f,    0.0f,  true},
+}};
+
+constexpr bool synthParameterTableIsOrdered() {
+    for (int i = 0; i < kNumSynthParameters; ++i) {
+        if (static_cast<int>(kSynthParameters[static_cast<size_t>(i)].parameter) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(synthParameterTableIsOrdered(), "kSynthParameters must list parameters in SynthParamId order");
+
+/**
+ * @brief Index of a parameter ID, or -1 if the synthesizer has no such parameter
+ *
+ * constexpr, so IDs known at compile time resolve at compile time.
+ */
+constexpr int findSynthParameter(std::string_view id) {
+    for (int i = 0; i < kNumSynthParameters; ++i) {
+        if (kSynthParameters[static_cast<size_t>(i)].id == id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+constexpr const SynthParameterInfo& getSynthParameterInfo(SynthParamId parameter) {
+    return kSynthParameters[static_cast<size_t>(parameter)];
+}
+
+} // namespace AIMusicHardware
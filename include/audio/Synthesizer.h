@@ -2,14 +2,17 @@
 
 #include <vector>
 #include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <map>
 #include "../sequencer/Sequencer.h" // Include for Envelope struct
+#include "SynthParameters.h"
 
 // Include the new architecture
 #include "../synthesis/framework/processor.h"
+#include "../synthesis/framework/smoothing_engine.h"
 #include "../synthesis/voice/voice_manager.h"
 #include "../synthesis/wavetable/wavetable.h"
 #include "../synthesis/modulators/envelope.h"
@@ -26,6 +29,8 @@ enum class OscillatorType {
     Noise
 };
 
+class LfoSource;
+
 /**
  * Enhanced Synthesizer class using the new architecture.
  * This is a top-level wrapper that coordinates all components.
@@ -51,9 +56,17 @@ public:
     void setChannelPressure(float pressure, int channel = 0);
     void resetAllControllers();
     
-    // Parameter system
-    void setParameter(const std::string& paramId, float value);
+    // Parameter system. Setting stores the clamped value by index (any thread) and
+    // the audio thread applies it at the start of the next block; voice_count is
+    // applied straight away because it reallocates voices. Hot paths should resolve
+    // IDs once with findSynthParameter() and use the indexed overloads.
+    void setParameter(SynthParamId parameter, float value);
+    float getParameter(SynthParamId parameter) const;
+    bool setParameter(const std::string& paramId, float value);  // false for unknown IDs
     float getParameter(const std::string& paramId) const;
+    
+    // Requested values, indexed by SynthParamId
+    std::array<float, kNumSynthParameters> getParameterValues() const;
 
     // Parameter methods for preset management
     std::map<std::string, float> getAllParameters() const;
@@ -69,10 +82,17 @@ public:
     // Voice management
     void setVoiceCount(int count);
     int getVoiceCount() const;
+    int getActiveVoiceCount() const;  // Voices playing or releasing
+    
+    // Voice render quality, lowered under CPU load (see LoadGovernor)
+    void setRenderQuality(const RenderQuality& quality);
     
     // Modulation system
     ModulationMatrix* getModulationMatrix() { return &modulationMatrix_; }
     
+    // Ramps for envelope times, oscillator frame and master volume
+    const SmoothingEngine& getSmoothingEngine() const { return smoothing_; }
+    
     // Processor implementation
     void process(float* buffer, int numFrames) override;
     void reset() override;
@@ -96,11 +116,45 @@ private:
     void legacyEnvelopeToNew(const AIMusicHardware::Envelope& legacyEnv, 
                              AIMusicHardware::ModEnvelope* newEnv);
     
+    // Smoothed parameters, in the order they are added to smoothing_
+    enum SmoothedParameter {
+        kSmoothAttack,
+        kSmoothDecay,
+        kSmoothSustain,
+        kSmoothRelease,
+        kSmoothFrame,
+        kSmoothVolume
+    };
+    
+    // Push smoothed values that moved in the last block to every voice (all values if force)
+    void applySmoothedParameters(bool force);
+    
+    // Hand parameters set since the last block to their handlers (audio thread)
+    void applyParameterChanges();
+    
+    // Per-parameter handlers, indexed by SynthParamId (nullptr: stored only)
+    using ParameterHandler = void (Synthesizer::*)(float);
+    static const std::array<ParameterHandler, kNumSynthParameters> kParameterHandlers;
+    
+    template <int Index>
+    void setSmoothedTarget(float value) { smoothing_.setTarget(Index, value); }
+    template <int Lfo>
+    void applyLfoRate(float value);
+    template <int Lfo>
+    void applyLfoShape(float value);
+    void applyOscillatorType(float value);
+    
     // Components
     std::unique_ptr<VoiceManager> voiceManager_;
     std::shared_ptr<Wavetable> currentWavetable_;
     ProcessorRouter effectChain_;
     ModulationMatrix modulationMatrix_;
+    SmoothingEngine smoothing_;
+    std::array<LfoSource*, 2> lfos_{};
+    
+    // Requested parameter values and the ones not yet applied (one bit each)
+    std::array<std::atomic<float>, kNumSynthParameters> parameterValues_;
+    std::atomic<uint32_t> changedParameters_{0};
     
     // Legacy compatibility
     OscillatorType currentOscType_;
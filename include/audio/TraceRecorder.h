@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Set to 0 to compile every AIMUSIC_TRACE_SCOPE out
+ */
+#ifndef AIMUSIC_TRACING
+#define AIMUSIC_TRACING 1
+#endif
+
+namespace AIMusicHardware {
+
+/**
+ * @brief Raw timestamp for trace events: the TSC on x86, the virtual
+ * counter on AArch64, steady_clock nanoseconds elsewhere
+ */
+inline uint64_t readTraceTimestamp() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * @brief Flight recorder for timed scopes on the audio hot path
+ *
+ * Each thread that records gets its own ring of events (name, start and
+ * end timestamps). The ring overwrites its oldest events, so it always
+ * holds the most recent ones. Recording is wait-free and does not allocate
+ * once the thread has its ring. While tracing is disabled a scope costs
+ * one relaxed atomic load.
+ *
+ * exportChromeTrace() writes every ring as Chrome trace event JSON, which
+ * chrome://tracing and ui.perfetto.dev open directly. It may run while
+ * threads keep recording; events overwritten during the export are left
+ * out.
+ *
+ * Event names are not copied: pass string literals, or names from
+ * internName() for names built at run time.
+ */
+class TraceRecorder {
+public:
+    static TraceRecorder& getInstance();
+
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * @brief Events per thread ring, for rings created after the call
+     */
+    void setCapacity(size_t eventsPerThread);
+    size_t getCapacity() const;
+
+    /**
+     * @brief Give the calling thread its ring (and a name in the trace) now
+     *
+     * Otherwise the ring is allocated by the thread's first event.
+     */
+    void prepareThread(const std::string& name = "");
+
+    /**
+     * @brief Stable copy of a run-time name (setup only; takes a lock)
+     */
+    const char* internName(const std::string& name);
+
+    /**
+     * @brief Record a finished scope for the calling thread
+     */
+    void record(const char* name, uint64_t start, uint64_t end);
+
+    /**
+     * @brief Forget recorded events; rings and thread names are kept
+     */
+    void clear();
+
+    /**
+     * @brief Events currently held across all rings
+     */
+    size_t getEventCount() const;
+
+    /**
+     * @brief Timestamp ticks per microsecond, measured against steady_clock
+     */
+    double getTicksPerMicrosecond() const;
+
+    /**
+     * @brief Recorded events as Chrome trace event JSON
+     */
+    std::string exportChromeTrace() const;
+    bool exportChromeTrace(const std::string& filename) const;
+
+private:
+    struct Ring;
+
+    TraceRecorder();
+    ~TraceRecorder();
+
+    Ring* getThreadRing();
+
+    inline static std::atomic<bool> enabled_{false};
+
+    std::vector<std::shared_ptr<Ring>> rings_;
+    mutable std::mutex ringsMutex_;
+    size_t capacity_ = 16384;
+
+    std::unordered_set<std::string> names_;
+    std::mutex namesMutex_;
+
+    // Calibration origin for converting ticks to time
+    uint64_t originTicks_;
+    std::chrono::steady_clock::time_point originTime_;
+};
+
+/**
+ * @brief Records the enclosing scope as one trace event while tracing is on
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : name_(TraceRecorder::isEnabled() ? name : nullptr), start_(name_ ? readTraceTimestamp() : 0) {}
+
+    ~TraceScope() {
+        if (name_) {
+            TraceRecorder::getInstance().record(name_, start_, readTraceTimestamp());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+    uint64_t start_;
+};
+
+} // namespace AIMusicHardware
+
+#define AIMUSIC_TRACE_CONCAT_INNER(a, b) a##b
+#define AIMUSIC_TRACE_CONCAT(a, b) AIMUSIC_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Trace the rest of the enclosing scope under a name
+ */
+#if AIMUSIC_TRACING
+#define AIMUSIC_TRACE_SCOPE(name) \
+    ::AIMusicHardware::TraceScope AIMUSIC_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#else
+#define AIMUSIC_TRACE_SCOPE(name) ((void)0)
+#endif
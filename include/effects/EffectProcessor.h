@@ -21,6 +21,13 @@ public:
     
     virtual std::string getName() const = 0;
     
+    // Effects whose output rings on after the input stops (delays, reverbs);
+    // these are bypassed first when the audio thread runs short of time
+    virtual bool hasTail() const { return false; }
+    
+    // Clear internal state such as delay lines (no allocation)
+    virtual void reset() {}
+    
 protected:
     int sampleRate_;
 };
@@ -41,10 +48,17 @@ public:
     void process(float* buffer, int numFrames);
     void setSampleRate(int sampleRate);
     
+    // Skip effects with tails; they are reset when brought back so no stale
+    // tail replays. Safe to change from the audio thread between blocks.
+    void setTailEffectsBypassed(bool bypassed) { tailEffectsBypassed_ = bypassed; }
+    bool areTailEffectsBypassed() const { return tailEffectsBypassed_; }
+    
 private:
     std::vector<std::unique_ptr<Effect>> effects_;
     int sampleRate_;
     std::vector<float> tempBuffer_;
+    bool tailEffectsBypassed_ = false;
+    bool tailEffectsWereBypassed_ = false;
 };
 
 // Time-based effects
@@ -57,6 +71,8 @@ public:
     void setParameter(const std::string& name, float value) override;
     float getParameter(const std::string& name) const override;
     std::string getName() const override { return "Delay"; }
+    bool hasTail() const override { return true; }
+    void reset() override;
     
 private:
     float delayTime_; // in seconds
@@ -75,6 +91,8 @@ public:
     void setParameter(const std::string& name, float value) override;
     float getParameter(const std::string& name) const override;
     std::string getName() const override { return "Reverb"; }
+    bool hasTail() const override { return true; }
+    void reset() override;
     
 private:
     float roomSize_;
@@ -99,16 +99,28 @@ public:
      */
     std::string getEffectType(size_t index) const;
     
+    /**
+     * Bypass effects with tails (delays, reverbs) to save CPU under load.
+     * They are reset when brought back, so no stale tail replays.
+     * Safe to change from the audio thread between blocks.
+     * @param bypassed Whether effects with tails are skipped
+     */
+    void setTailEffectsBypassed(bool bypassed) { tailEffectsBypassed_ = bypassed; }
+    bool areTailEffectsBypassed() const { return tailEffectsBypassed_; }
+    
 private:
     struct EffectInfo {
         std::unique_ptr<Effect> effect;
         std::string type;
         bool enabled;
+        const char* traceName; // Interned type, for trace events
     };
     
     std::vector<EffectInfo> effects_;
     int sampleRate_;
     std::vector<float> tempBuffer_;
+    bool tailEffectsBypassed_ = false;
+    bool tailEffectsWereBypassed_ = false;
 };
 
 } // namespace AIMusicHardware
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "IoTInterface.h"
 #include "IoTParameterTypes.h"
+#include "MQTTTopicTrie.h"
+#include "SensorFrameDecoder.h"
 #include "../ui/parameters/Parameter.h"
 #include "../ui/parameters/ParameterGroup.h"
 #include "../events/EventBus.h"
@@ -59,6 +61,22 @@ public:
      */
     void mapTopicToParameter(const std::string& topic, Parameter* parameter);
     
+    /**
+     * @brief Subscribe to topics carrying binary sensor frames
+     * 
+     * Frames (see SensorFrameFormat.h) are decoded and each reading is
+     * handled as if it had arrived as a text message on
+     * "<frame topic>/<sensor name>", e.g. a frame published to
+     * "AIMusicHardware/sensors/node1/frame" yields
+     * "AIMusicHardware/sensors/node1/frame/temperature" with payload "21.5",
+     * and an acceleration reading yields "x,y,z". Map those reading topics
+     * with mapTopicToEvent/mapTopicToParameter as usual; parameter mappings
+     * without a converter take the first value without any text parsing.
+     * 
+     * @param topic Topic filter the frames are published on
+     */
+    void mapSensorFrames(const std::string& topic);
+    
     /**
      * @brief Set a message converter for a topic-to-event mapping
      * 
@@ -173,12 +191,25 @@ private:
     
     std::vector<TopicEventMapping> eventMappings_;
     std::vector<TopicParameterMapping> parameterMappings_;
+    std::vector<std::string> frameTopics_;
     
-    // Topic pattern matching
-    bool matchTopicPattern(const std::string& topic, const std::string& pattern) const;
+    // Compiled topic filters; IDs index into the mapping vectors above
+    MQTTTopicTrie eventTrie_;
+    MQTTTopicTrie parameterTrie_;
     
     // Handle incoming messages
     void onIoTMessage(const std::string& topic, const std::string& payload);
+    void dispatchMappedEvent(const TopicEventMapping& mapping, const std::string& topic,
+                             const std::string& payload);
+    void applyParameterMapping(const TopicParameterMapping& mapping, const std::string& payload);
+    void setParameterValue(Parameter* parameter, float value);
+    
+    // Binary sensor frames; scratch buffers are reused across frames
+    void onSensorFrame(const std::string& topic, const std::string& payload);
+    void dispatchMessage(const std::string& topic, const std::string& payload);
+    std::vector<SensorReading> frameReadings_;
+    std::string readingTopic_;
+    std::string readingPayload_;
     
     // Helper to find mappings for a topic
     TopicEventMapping* findEventMapping(const std::string& topic);
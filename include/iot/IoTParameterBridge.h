@@ -0,0 +1,171 @@
+#pragma once
+
+#include "IoTInterface.h"
+#include "MQTTTopicTrie.h"
+#include "../ui/ParameterUpdateQueue.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AIMusicHardware {
+
+/**
+ * @brief Coalescing bridge from high-rate IoT sensor topics to the audio thread
+ *
+ * Messages are ingested on the IoT callback thread and folded into one
+ * accumulator per mapping (last value, or a min/max/mean window) instead
+ * of being applied one by one. A control-rate flush, either from the
+ * bridge's own thread or from a caller-driven tick, publishes at most one
+ * value per mapping per period through the update system's batch queue.
+ * A 1 kHz accelerometer therefore costs the audio queue one update per
+ * control period, and the messages never reach the EventBus.
+ *
+ * The batch queue has a single producer: the bridge claims it on
+ * construction, and a second bridge on the same system publishes nothing.
+ *
+ * When connected to an IoTInterface the bridge registers topic callbacks
+ * for its filters, so matching messages bypass the interface's global
+ * callback (and with it IoTEventAdapter's per-message event dispatch).
+ */
+class IoTParameterBridge {
+public:
+    /**
+     * @brief How messages arriving within one control period are combined
+     */
+    enum class CoalesceMode {
+        LastValue,  // Most recent value wins
+        Mean,       // Average of the window
+        Min,        // Smallest value of the window
+        Max         // Largest value of the window
+    };
+
+    using Converter = std::function<float(const std::string&)>;
+
+    /**
+     * @brief Counters for sizing and diagnostics
+     */
+    struct Statistics {
+        uint64_t messagesIngested;
+        uint64_t messagesUnmatched;
+        uint64_t valuesPublished;
+        uint64_t batchesPublished;
+        uint64_t valuesDropped;
+    };
+
+    explicit IoTParameterBridge(ParameterUpdateSystem& updateSystem = ParameterUpdateSystem::getInstance());
+    ~IoTParameterBridge();
+
+    IoTParameterBridge(const IoTParameterBridge&) = delete;
+    IoTParameterBridge& operator=(const IoTParameterBridge&) = delete;
+
+    /**
+     * @brief Whether this bridge owns the update system's batch queue
+     */
+    bool canPublish() const { return static_cast<bool>(batchProducer_); }
+
+    /**
+     * @brief Map a topic filter to a parameter
+     * @param topicFilter MQTT topic filter (wildcards allowed)
+     * @param parameterId Parameter to drive on the audio thread; resolved
+     *        against the synthesizer registry here, and published changes
+     *        carry the index so the audio thread can set it without string work
+     * @param converter Payload to value conversion; plain number parsing if empty
+     * @param mode How values within one control period are combined
+     * @return Mapping index, or -1 if the filter is invalid
+     */
+    int mapTopic(const std::string& topicFilter, const Parameter::ParameterId& parameterId,
+                 Converter converter = nullptr, CoalesceMode mode = CoalesceMode::LastValue);
+
+    /**
+     * @brief Change the coalescing mode of a mapping
+     */
+    void setCoalesceMode(int mapping, CoalesceMode mode);
+
+    /**
+     * @brief Register topic callbacks for all current and future mappings
+     * @param iotInterface Interface delivering messages (not owned)
+     */
+    void connect(IoTInterface* iotInterface);
+
+    /**
+     * @brief Remove the topic callbacks registered by connect()
+     */
+    void disconnect();
+
+    /**
+     * @brief Fold one message into the matching accumulators (IoT thread)
+     */
+    void ingest(const std::string& topic, const std::string& payload);
+
+    /**
+     * @brief Publish coalesced values and reset the windows
+     *
+     * Called by the control thread started with start(), or directly when
+     * the caller owns the control-rate tick. Only one thread may flush.
+     *
+     * @return Number of values pushed to the audio queue
+     */
+    size_t flush();
+
+    /**
+     * @brief Start a thread that flushes at a fixed control rate
+     * @param controlRateHz Flushes per second
+     */
+    void start(float controlRateHz = 200.0f);
+
+    /**
+     * @brief Stop the control thread (pending values are flushed once more)
+     */
+    void stop();
+
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+    size_t getMappingCount() const;
+
+    Statistics getStatistics() const;
+    void resetStatistics();
+
+private:
+    struct Mapping {
+        std::string topicFilter;
+        Parameter::ParameterId parameterId;
+        int synthParameter = -1;  // SynthParamId index, or -1
+        Converter converter;
+        CoalesceMode mode;
+
+        // Window accumulated since the last flush
+        float last = 0.0f;
+        float minimum = 0.0f;
+        float maximum = 0.0f;
+        double sum = 0.0;
+        uint32_t count = 0;
+        uint64_t lastTimestamp = 0;
+    };
+
+    void registerCallback(const std::string& topicFilter);
+    static uint64_t now();
+
+    ParameterUpdateSystem::BatchProducer batchProducer_;
+    IoTInterface* iotInterface_ = nullptr;
+
+    mutable std::mutex mutex_;       // guards mappings_, trie_ and windows
+    std::vector<Mapping> mappings_;
+    MQTTTopicTrie trie_;
+    std::vector<std::string> registeredFilters_;
+
+    // Flush-side scratch, reused so steady-state flushes do not allocate
+    std::vector<ParameterUpdateQueue<>::ParameterChange> batch_;
+
+    std::thread controlThread_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> messagesIngested_{0};
+    std::atomic<uint64_t> messagesUnmatched_{0};
+    std::atomic<uint64_t> valuesPublished_{0};
+    std::atomic<uint64_t> batchesPublished_{0};
+    std::atomic<uint64_t> valuesDropped_{0};
+};
+
+} // namespace AIMusicHardware
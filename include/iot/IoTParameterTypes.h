@@ -76,6 +76,34 @@ public:
         bool normalized = true
     );
     
+    /**
+     * @brief Create a converter that reads one JSON key
+     * 
+     * The key lookup is compiled into an extraction plan once; each call
+     * scans the payload without allocating.
+     * 
+     * @param key JSON key holding the numeric value
+     * @param minValue Minimum expected value
+     * @param maxValue Maximum expected value
+     * @param normalized Whether to normalize the output to 0.0-1.0 range
+     */
+    static std::function<float(const std::string&)> createJsonFieldConverter(
+        const std::string& key,
+        float minValue = 0.0f,
+        float maxValue = 1.0f,
+        bool normalized = true
+    );
+    
+    /**
+     * @brief Create a converter that reads one CSV column (0-based)
+     */
+    static std::function<float(const std::string&)> createCsvFieldConverter(
+        int index,
+        float minValue = 0.0f,
+        float maxValue = 1.0f,
+        bool normalized = true
+    );
+    
     /**
      * @brief Parse JSON payload
      * 
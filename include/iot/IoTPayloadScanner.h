@@ -0,0 +1,121 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <array>
+#include <initializer_list>
+#include <cstdint>
+
+namespace AIMusicHardware {
+
+/**
+ * @brief Non-allocating scanners for IoT message payloads
+ *
+ * All functions work on std::string_view, parse numbers with
+ * std::from_chars and never touch the heap, so they are safe to call for
+ * every message on a busy sensor topic.
+ */
+class IoTPayloadScanner {
+public:
+    /**
+     * @brief Parse a number at the start of a value
+     *
+     * Leading whitespace, a leading '+' and surrounding quotes are skipped;
+     * trailing text after the number is ignored (like std::stof). The
+     * literals true/false/on/off parse as 1 and 0.
+     *
+     * @return false if no number could be read
+     */
+    static bool parseNumber(std::string_view text, float& value);
+
+    /**
+     * @brief Find and parse the first number anywhere in the text
+     *
+     * Used for free-form payloads such as "23.5C" or "temp=21".
+     */
+    static bool findFirstNumber(std::string_view text, float& value);
+
+    /**
+     * @brief Locate the value of a JSON key
+     *
+     * Flat scan that also finds keys in nested objects. String values are
+     * returned without their quotes; other values are returned up to the
+     * next ',', '}' or ']' with surrounding whitespace trimmed.
+     *
+     * @return View into payload, empty if the key is absent
+     */
+    static std::string_view findJsonValue(std::string_view payload, std::string_view key);
+
+    /**
+     * @brief Return a comma-separated field (0-based), whitespace trimmed
+     */
+    static std::string_view csvField(std::string_view payload, int index);
+
+    /**
+     * @brief Trim spaces, tabs and line breaks from both ends
+     */
+    static std::string_view trim(std::string_view text);
+};
+
+/**
+ * @brief Precompiled description of which values to pull out of a payload
+ *
+ * A plan names up to kMaxFields JSON keys or CSV column indices and is
+ * built once per mapping (when a topic is mapped), then applied to every
+ * message with extract(), which reads all requested fields in a single
+ * pass over the payload.
+ *
+ * Auto plans carry both keys and indices and pick JSON, CSV or a plain
+ * scalar per payload, matching how sensors report vectors in practice.
+ */
+class IoTExtractionPlan {
+public:
+    static constexpr size_t kMaxFields = 8;
+
+    enum class Format {
+        Scalar,     // Whole payload is one number
+        Json,       // Values of named keys
+        Csv,        // Values of column indices
+        Auto        // JSON if the payload has '{', CSV if it has ',', else scalar
+    };
+
+    IoTExtractionPlan() = default;
+
+    static IoTExtractionPlan scalar();
+    static IoTExtractionPlan json(std::initializer_list<std::string_view> keys);
+    static IoTExtractionPlan csv(std::initializer_list<int> columns);
+
+    /**
+     * @brief JSON keys and CSV columns for the same fields, chosen per payload
+     */
+    static IoTExtractionPlan automatic(std::initializer_list<std::string_view> keys,
+                                       std::initializer_list<int> columns);
+
+    Format getFormat() const { return format_; }
+    size_t getFieldCount() const { return fieldCount_; }
+
+    /**
+     * @brief Pull every field of the plan out of a payload
+     * @param payload Message payload
+     * @param values Receives getFieldCount() values (untouched where missing)
+     * @return Bit i set if field i was found and parsed
+     */
+    uint32_t extract(std::string_view payload, float* values) const;
+
+    /**
+     * @brief Mask with one bit per field, for comparing against extract()
+     */
+    uint32_t allFieldsMask() const { return fieldCount_ >= 32 ? 0xFFFFFFFFu : (1u << fieldCount_) - 1u; }
+
+private:
+    uint32_t extractJson(std::string_view payload, float* values) const;
+    uint32_t extractCsv(std::string_view payload, float* values) const;
+
+    Format format_ = Format::Scalar;
+    size_t fieldCount_ = 1;
+    std::array<std::string, kMaxFields> keys_;
+    std::array<int, kMaxFields> columns_{{-1, -1, -1, -1, -1, -1, -1, -1}};
+    int maxColumn_ = -1;
+};
+
+} // namespace AIMusicHardware
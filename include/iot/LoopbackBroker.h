@@ -0,0 +1,182 @@
+#pragma once
+
+#include "IoTInterface.h"
+#include "MQTTTopicTrie.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace AIMusicHardware {
+
+class LoopbackIoTInterface;
+
+/**
+ * @brief In-process MQTT broker stand-in
+ *
+ * Routes published messages to every attached client with a matching
+ * subscription, using MQTT 3.1.1 wildcard rules ('+', '#', '$' topics) via
+ * MQTTTopicTrie. Retained messages are stored and replayed to new
+ * subscriptions. Each client receives a message at most once even when
+ * several of its filters overlap. QoS is accepted but ignored: delivery is
+ * always exactly once, in publish order per publisher.
+ *
+ * Delivery only enqueues into the client's inbox; callbacks run when the
+ * client calls update(), as they would on a network client's thread.
+ */
+class LoopbackBroker {
+public:
+    struct Statistics {
+        uint64_t messagesPublished;
+        uint64_t messagesDelivered;  // Sum over receiving clients
+        uint64_t messagesUnrouted;   // Published with no matching subscriber
+        size_t retainedMessages;
+        size_t subscriptions;
+    };
+
+    LoopbackBroker() = default;
+    LoopbackBroker(const LoopbackBroker&) = delete;
+    LoopbackBroker& operator=(const LoopbackBroker&) = delete;
+
+    /**
+     * @brief Route a message to all matching subscribers
+     * @param topic Topic name (no wildcards)
+     * @param payload Message payload
+     * @param retain Store as the topic's retained message (empty payload clears it)
+     * @return false if the topic is not a valid topic name
+     */
+    bool publish(const std::string& topic, const std::string& payload, bool retain = false);
+
+    Statistics getStatistics() const;
+
+private:
+    friend class LoopbackIoTInterface;
+
+    struct Subscription {
+        LoopbackIoTInterface* client = nullptr;
+        std::string filter;
+    };
+
+    bool subscribe(LoopbackIoTInterface* client, const std::string& filter);
+    bool unsubscribe(LoopbackIoTInterface* client, const std::string& filter);
+    void unsubscribeAll(LoopbackIoTInterface* client);
+
+    mutable std::mutex mutex_;  // guards everything below; taken before a client's inbox lock
+    MQTTTopicTrie trie_;
+    std::vector<Subscription> subscriptions_;
+    std::vector<MQTTTopicTrie::SubscriptionId> freeSubscriptions_;
+    std::map<std::pair<LoopbackIoTInterface*, std::string>, MQTTTopicTrie::SubscriptionId> subscriptionIds_;
+    std::map<std::string, std::string> retained_;
+    std::vector<LoopbackIoTInterface*> recipients_;  // publish scratch
+
+    uint64_t messagesPublished_ = 0;
+    uint64_t messagesDelivered_ = 0;
+    uint64_t messagesUnrouted_ = 0;
+};
+
+/**
+ * @brief IoTInterface client of a LoopbackBroker
+ *
+ * Drop-in replacement for MQTTInterface in tests, examples and load
+ * generation: no network and no external broker. Several clients can share
+ * one broker (e.g. simulated sensor nodes publishing to the synth), or a
+ * client can own a private broker and receive its own publications.
+ *
+ * Messages queue in the client's inbox until update() dispatches them; a
+ * consumer thread can block in waitForMessages() between updates. Topic
+ * callbacks take precedence over the global callback, choosing the exact
+ * filter or else the lexically smallest matching one, as MQTTInterface does.
+ */
+class LoopbackIoTInterface : public IoTInterface {
+public:
+    /**
+     * @param broker Broker to attach to; a private one is created if null
+     */
+    explicit LoopbackIoTInterface(std::shared_ptr<LoopbackBroker> broker = nullptr);
+    ~LoopbackIoTInterface() override;
+
+    LoopbackIoTInterface(const LoopbackIoTInterface&) = delete;
+    LoopbackIoTInterface& operator=(const LoopbackIoTInterface&) = delete;
+
+    // IoTInterface implementation
+    bool connect(const std::string& host, int port, const std::string& clientId) override;
+    void disconnect() override;
+    bool isConnected() const override;
+    void update() override;
+    bool subscribe(const std::string& topic) override;
+    bool unsubscribe(const std::string& topic) override;
+    bool publish(const std::string& topic, const std::string& payload) override;
+    bool publish(const std::string& topic, const std::string& payload,
+                 int qos, bool retain) override;
+    void setMessageCallback(MessageCallback callback) override;
+    void setTopicCallback(const std::string& topic, MessageCallback callback) override;
+    void removeTopicCallback(const std::string& topic) override;
+
+    /**
+     * @brief Block until the inbox is non-empty or the timeout expires
+     * @return true if messages are pending
+     */
+    bool waitForMessages(std::chrono::microseconds timeout);
+
+    /**
+     * @brief Wake a thread blocked in waitForMessages()
+     */
+    void wake();
+
+    size_t getPendingCount() const;
+
+    /**
+     * @brief Largest inbox depth seen, a measure of dispatch backlog
+     */
+    size_t getMaxPendingCount() const { return maxPending_.load(std::memory_order_relaxed); }
+
+    const std::string& getClientId() const { return clientId_; }
+    std::shared_ptr<LoopbackBroker> getBroker() const { return broker_; }
+
+private:
+    friend class LoopbackBroker;
+
+    struct Message {
+        std::string topic;
+        std::string payload;
+    };
+
+    struct TopicCallbackSlot {
+        std::string filter;
+        std::shared_ptr<const MessageCallback> callback;
+    };
+
+    // Called by the broker with its lock held
+    void enqueue(const std::string& topic, const std::string& payload);
+    void dispatch(const Message& message);
+
+    std::shared_ptr<LoopbackBroker> broker_;
+    std::string clientId_;
+    std::atomic<bool> connected_{false};
+
+    // Subscriptions survive disconnect() and are restored by connect()
+    mutable std::mutex subscriptionMutex_;
+    std::set<std::string> subscriptions_;
+
+    mutable std::mutex callbackMutex_;
+    MessageCallback globalMessageCallback_;
+    std::map<std::string, MQTTTopicTrie::SubscriptionId> topicCallbackIds_;
+    std::vector<TopicCallbackSlot> topicCallbackSlots_;
+    std::vector<MQTTTopicTrie::SubscriptionId> freeCallbackSlots_;
+    MQTTTopicTrie topicCallbackTrie_;
+
+    mutable std::mutex inboxMutex_;
+    std::condition_variable inboxCondition_;
+    std::vector<Message> inbox_;
+    std::vector<Message> dispatching_;  // swapped with inbox_ so capacity is reused
+    bool wakeRequested_ = false;
+    std::atomic<size_t> maxPending_{0};
+};
+
+} // namespace AIMusicHardware
@@ -2,10 +2,12 @@
 
 #include "IoTInterface.h"
 #include "mqtt_include.h"
+#include "MQTTTopicTrie.h"
 #include <memory>
 #include <string>
 #include <map>
 #include <set>
+#include <vector>
 #include <mutex>
 
 namespace AIMusicHardware {
@@ -89,9 +91,18 @@ private:
     std::string clientId_;
     bool isConnected_ = false;
     
-    // Message handling
+    // Message handling. Topic callbacks live in slots indexed by their
+    // subscription ID in topicCallbackTrie_; slots of removed filters are reused.
+    struct TopicCallbackSlot {
+        std::string filter;
+        std::shared_ptr<const MessageCallback> callback;
+    };
+    
     MessageCallback globalMessageCallback_;
-    std::map<std::string, MessageCallback> topicCallbacks_;
+    std::map<std::string, MQTTTopicTrie::SubscriptionId> topicCallbackIds_;
+    std::vector<TopicCallbackSlot> topicCallbackSlots_;
+    std::vector<MQTTTopicTrie::SubscriptionId> freeCallbackSlots_;
+    MQTTTopicTrie topicCallbackTrie_;
     
     // Connection options
     int keepAliveInterval_ = 60;  // seconds
@@ -116,7 +127,6 @@ private:
     
     // Internal callback handlers
     void onMessage(const mqtt::const_message_ptr& msg);
-    bool matchTopicPattern(const std::string& topic, const std::string& pattern) const;
     
     // Reconnection handling
     void reconnect();
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace AIMusicHardware {
+
+/**
+ * @brief Subscription trie for MQTT topic filters
+ *
+ * Topic filters are split into levels once, at subscription time, and
+ * stored as a tree whose edges are literal levels plus one dedicated
+ * child for the single-level wildcard '+'. Multi-level wildcards ('#')
+ * are recorded on the node they follow. Matching a topic walks the tree
+ * level by level, so the cost depends on topic depth and the number of
+ * wildcard branches taken, not on the number of subscriptions, and it
+ * never allocates or builds a regex.
+ *
+ * Matching follows the MQTT 3.1.1 rules: "a/#" also matches "a", and
+ * wildcards in the first level do not match topics starting with '$'.
+ *
+ * Not thread-safe; owners serialize insert/remove against match().
+ */
+class MQTTTopicTrie {
+public:
+    using SubscriptionId = uint32_t;
+
+    MQTTTopicTrie();
+
+    /**
+     * @brief Add a topic filter
+     * @param filter Topic filter, may contain '+' and a trailing '#'
+     * @param id Value reported by match() for topics the filter covers
+     * @return false if the filter is not a valid MQTT topic filter
+     */
+    bool insert(std::string_view filter, SubscriptionId id);
+
+    /**
+     * @brief Remove one (filter, id) pair
+     * @return true if it was present
+     */
+    bool remove(std::string_view filter, SubscriptionId id);
+
+    /**
+     * @brief Remove all filters
+     */
+    void clear();
+
+    /**
+     * @brief Number of (filter, id) pairs stored
+     */
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Invoke fn(SubscriptionId) for every filter matching a topic
+     *
+     * Each stored (filter, id) pair is reported at most once per call.
+     */
+    template <typename Fn>
+    void match(std::string_view topic, Fn&& fn) const {
+        bool system = !topic.empty() && topic.front() == '$';
+        matchNode(0, topic, 0, system, fn);
+    }
+
+    /**
+     * @brief Check whether any filter matches a topic
+     */
+    bool matchesAny(std::string_view topic) const {
+        bool found = false;
+        match(topic, [&found](SubscriptionId) { found = true; });
+        return found;
+    }
+
+    /**
+     * @brief Validate a topic filter ('+' and '#' must fill a whole level,
+     *        '#' only as the last level)
+     */
+    static bool isValidFilter(std::string_view filter);
+
+    /**
+     * @brief Match one topic against one filter without building a trie
+     *
+     * Allocation-free; used where a single ad-hoc comparison is needed.
+     */
+    static bool matches(std::string_view topic, std::string_view filter);
+
+private:
+    static constexpr uint32_t kNoNode = 0xFFFFFFFFu;
+    static constexpr size_t kEndOfTopic = static_cast<size_t>(-1);
+
+    struct Node {
+        std::string label;
+        std::vector<uint32_t> children;           // literal children, sorted by label
+        uint32_t wildcardChild = kNoNode;          // '+'
+        std::vector<SubscriptionId> exact;         // filters ending at this node
+        std::vector<SubscriptionId> multiLevel;    // filters ending in "/#" below this node
+    };
+
+    uint32_t findChild(const Node& node, std::string_view label) const;
+    uint32_t findOrCreateChild(uint32_t nodeIndex, std::string_view label);
+    uint32_t walk(std::string_view filter, bool create, bool& multiLevel);
+
+    template <typename Fn>
+    void matchNode(uint32_t nodeIndex, std::string_view topic, size_t pos, bool system, Fn& fn) const {
+        const Node& node = nodes_[nodeIndex];
+        bool firstLevel = nodeIndex == 0;
+
+        // '#' also covers its parent level, so it fires before consuming anything
+        if (!(firstLevel && system)) {
+            for (SubscriptionId id : node.multiLevel) {
+                fn(id);
+            }
+        }
+
+        if (pos == kEndOfTopic) {
+            for (SubscriptionId id : node.exact) {
+                fn(id);
+            }
+            return;
+        }
+
+        size_t slash = topic.find('/', pos);
+        std::string_view level = topic.substr(pos, slash == std::string_view::npos ? std::string_view::npos : slash - pos);
+        size_t next = slash == std::string_view::npos ? kEndOfTopic : slash + 1;
+
+        uint32_t literal = findChild(node, level);
+        if (literal != kNoNode) {
+            matchNode(literal, topic, next, system, fn);
+        }
+        if (node.wildcardChild != kNoNode && !(firstLevel && system)) {
+            matchNode(node.wildcardChild, topic, next, system, fn);
+        }
+    }
+
+    std::vector<Node> nodes_;   // nodes_[0] is the root
+    size_t size_ = 0;
+};
+
+} // namespace AIMusicHardware
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "SensorFrameFormat.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace AIMusicHardware {
+
+/**
+ * @brief One decoded reading from a binary sensor frame
+ */
+struct SensorReading {
+    uint8_t type = 0;           // SensorFrame::Type
+    uint16_t sequence = 0;
+    uint32_t timestampMs = 0;   // Device time (frame base + record offset)
+    uint8_t valueCount = 0;
+    float values[SensorFrame::kMaxValues] = {};
+};
+
+/**
+ * @brief Host-side decoder for the binary frames in SensorFrameFormat.h
+ *
+ * Decoding validates the whole frame before returning any reading, works
+ * into a caller-provided array and never allocates.
+ */
+class SensorFrameDecoder {
+public:
+    enum class Status {
+        Ok,
+        NotAFrame,          // Text payload or wrong magic byte
+        UnsupportedVersion,
+        Truncated,          // Frame shorter than its records claim
+        BadRecord,          // Zero values or more than kMaxValues
+        TooManyRecords      // More records than the output array holds
+    };
+
+    /**
+     * @brief Cheap check for the frame magic, used to route payloads
+     */
+    static bool isFrame(std::string_view payload) {
+        return payload.size() >= SensorFrame::kFrameHeaderSize &&
+               static_cast<uint8_t>(payload[0]) == SensorFrame::kMagic;
+    }
+
+    /**
+     * @brief Decode every record of a frame
+     * @param payload Raw MQTT payload
+     * @param readings Output array
+     * @param maxReadings Capacity of readings
+     * @param count Receives the number of readings decoded (0 on error)
+     */
+    static Status decode(std::string_view payload, SensorReading* readings, size_t maxReadings, size_t& count);
+
+    /**
+     * @brief Render reading values as text ("23.5" or "0.1,-0.2,9.81")
+     *
+     * Multi-value readings use the CSV form the text converters already
+     * accept, so existing sensor converters work on binary frames.
+     *
+     * @param out Replaced with the text; its capacity is reused
+     */
+    static void formatValues(const SensorReading& reading, std::string& out);
+
+    static const char* statusName(Status status);
+};
+
+} // namespace AIMusicHardware
@@ -0,0 +1,217 @@
+#pragma once
+
+/**
+ * Compact binary sensor frame format
+ *
+ * Shared between the ESP32 sensor node firmware (which includes this header
+ * directly, see firmware/esp32_sensor_node/platformio.ini) and the host
+ * decoder, so it depends on nothing beyond the C standard headers and never
+ * allocates.
+ *
+ * One MQTT message carries one frame; all multi-byte fields are little-endian.
+ *
+ *   Frame header (8 bytes)
+ *     0  u8   magic (0xA5, never the first byte of a text payload)
+ *     1  u8   version in the high nibble, flags in the low nibble (0)
+ *     2  u8   record count
+ *     3  u8   reserved (0)
+ *     4  u32  base timestamp, device milliseconds
+ *
+ *   Record header (8 bytes), repeated record count times
+ *     0  u8   sensor type ID (SensorFrame::Type)
+ *     1  u8   layout: value count in bits 0-3, bit 4 set for int16 values
+ *     2  i8   power-of-ten scale for int16 values (value = raw * 10^scale)
+ *     3  u8   reserved (0)
+ *     4  u16  sequence number, per sensor type, wrapping
+ *     6  u16  timestamp offset from the frame base, milliseconds
+ *
+ *   followed by value count float32 or int16 values.
+ *
+ * Batching several readings of the same sensor in one frame is done by
+ * repeating records with increasing sequence numbers and offsets.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+namespace AIMusicHardware {
+
+namespace SensorFrame {
+
+constexpr uint8_t kMagic = 0xA5;
+constexpr uint8_t kVersion = 1;
+constexpr size_t kFrameHeaderSize = 8;
+constexpr size_t kRecordHeaderSize = 8;
+constexpr uint8_t kMaxValues = 15;
+constexpr uint8_t kInt16Flag = 0x10;
+constexpr uint8_t kValueCountMask = 0x0F;
+
+/**
+ * Sensor type IDs on the wire; values are stable and must not be reused
+ */
+enum Type : uint8_t {
+    Temperature = 1,    // Celsius
+    Humidity = 2,       // Percent
+    Pressure = 3,       // hPa
+    Light = 4,          // Lux
+    Acceleration = 5,   // x, y, z in g
+    Gyroscope = 6,      // x, y, z in degrees/second
+    Magnetometer = 7,   // x, y, z in microtesla
+    SoundLevel = 8,     // dB
+    PeakFrequency = 9,  // Hz
+    Battery = 10,       // Volts
+    SignalStrength = 11,// RSSI in dBm
+    AirQuality = 12,    // TVOC ppb, CO2 ppm
+    Analog = 13,        // Generic analog reading
+    Digital = 14        // Button or digital input
+};
+
+/**
+ * Topic suffix for a sensor type ("temperature", "acceleration", ...),
+ * nullptr for unknown IDs
+ */
+inline const char* typeName(uint8_t type) {
+    switch (type) {
+        case Temperature: return "temperature";
+        case Humidity: return "humidity";
+        case Pressure: return "pressure";
+        case Light: return "light";
+        case Acceleration: return "acceleration";
+        case Gyroscope: return "gyroscope";
+        case Magnetometer: return "magnetometer";
+        case SoundLevel: return "sound";
+        case PeakFrequency: return "frequency";
+        case Battery: return "battery";
+        case SignalStrength: return "rssi";
+        case AirQuality: return "air_quality";
+        case Analog: return "analog";
+        case Digital: return "digital";
+        default: return nullptr;
+    }
+}
+
+inline void writeU16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+inline void writeU32(uint8_t* out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+inline uint16_t readU16(const uint8_t* in) {
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+inline uint32_t readU32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+           (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+/**
+ * Builds a frame into a caller-owned buffer
+ *
+ * Records that do not fit are rejected rather than truncated, so a full
+ * writer can be published and restarted with begin().
+ */
+class Writer {
+public:
+    Writer(uint8_t* buffer, size_t capacity) : buffer_(buffer), capacity_(capacity) {}
+
+    /**
+     * Start a new frame; timestamps of added records are relative to base
+     */
+    void begin(uint32_t baseTimestampMs) {
+        size_ = 0;
+        records_ = 0;
+        base_ = baseTimestampMs;
+        if (capacity_ < kFrameHeaderSize) {
+            return;
+        }
+        buffer_[0] = kMagic;
+        buffer_[1] = static_cast<uint8_t>(kVersion << 4);
+        buffer_[2] = 0;
+        buffer_[3] = 0;
+        writeU32(buffer_ + 4, base_);
+        size_ = kFrameHeaderSize;
+    }
+
+    /**
+     * Add a reading with full float32 precision
+     */
+    bool addFloat(uint8_t type, uint16_t sequence, uint32_t timestampMs, const float* values, uint8_t count) {
+        uint8_t* out = reserve(type, count, false, 0, sequence, timestampMs, count * 4);
+        if (!out) {
+            return false;
+        }
+        for (uint8_t i = 0; i < count; ++i) {
+            uint32_t bits;
+            memcpy(&bits, &values[i], sizeof(bits));
+            writeU32(out + 4 * i, bits);
+        }
+        return true;
+    }
+
+    /**
+     * Add a reading quantized to int16 at a power-of-ten scale
+     *
+     * For example scale -2 stores 23.45 as 2345. Values outside the int16
+     * range saturate.
+     */
+    bool addInt16(uint8_t type, uint16_t sequence, uint32_t timestampMs, const float* values, uint8_t count,
+                  int8_t scale) {
+        uint8_t* out = reserve(type, count, true, scale, sequence, timestampMs, count * 2);
+        if (!out) {
+            return false;
+        }
+        float factor = powf(10.0f, -static_cast<float>(scale));
+        for (uint8_t i = 0; i < count; ++i) {
+            float scaled = roundf(values[i] * factor);
+            if (scaled > 32767.0f) scaled = 32767.0f;
+            if (scaled < -32768.0f) scaled = -32768.0f;
+            writeU16(out + 2 * i, static_cast<uint16_t>(static_cast<int16_t>(scaled)));
+        }
+        return true;
+    }
+
+    const uint8_t* data() const { return buffer_; }
+    size_t size() const { return size_; }
+    uint8_t recordCount() const { return records_; }
+    bool empty() const { return records_ == 0; }
+
+private:
+    uint8_t* reserve(uint8_t type, uint8_t count, bool int16, int8_t scale, uint16_t sequence,
+                     uint32_t timestampMs, size_t valueBytes) {
+        if (size_ < kFrameHeaderSize || records_ == 255 || count == 0 || count > kMaxValues ||
+            timestampMs < base_ || timestampMs - base_ > 0xFFFF ||
+            size_ + kRecordHeaderSize + valueBytes > capacity_) {
+            return nullptr;
+        }
+
+        uint8_t* record = buffer_ + size_;
+        record[0] = type;
+        record[1] = static_cast<uint8_t>(count | (int16 ? kInt16Flag : 0));
+        record[2] = static_cast<uint8_t>(scale);
+        record[3] = 0;
+        writeU16(record + 4, sequence);
+        writeU16(record + 6, static_cast<uint16_t>(timestampMs - base_));
+
+        size_ += kRecordHeaderSize + valueBytes;
+        buffer_[2] = ++records_;
+        return record + kRecordHeaderSize;
+    }
+
+    uint8_t* buffer_;
+    size_t capacity_;
+    size_t size_ = 0;
+    uint8_t records_ = 0;
+    uint32_t base_ = 0;
+};
+
+} // namespace SensorFrame
+
+} // namespace AIMusicHardware
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <map>
+#include <array>
+#include <deque>
 #include <vector>
 #include <functional>
 #include <memory>
@@ -8,6 +10,7 @@
 #include <atomic>
 #include <mutex>
 #include <chrono>
+#include "UniversalMidiParser.h"
 
 namespace AIMusicHardware {
 
@@ -128,6 +131,27 @@ public:
      */
     void processMidiCC(int channel, int ccNumber, int value, const std::string& deviceName = "");
     
+    /**
+     * @brief Process a high-resolution controller value (14-bit CC pair or NRPN)
+     * 
+     * Dispatched through the same mappings as processMidiCC, with the curve
+     * evaluated at full resolution. Ignored while learning.
+     * 
+     * @param channel MIDI channel (0-15)
+     * @param ccNumber Controller number the mapping is registered under (0-127)
+     * @param value Controller value (0-16383)
+     */
+    void processMidiCC14(int channel, int ccNumber, int value);
+    
+    /**
+     * @brief Process a controller event from UniversalMidiParser
+     * 
+     * Controller events are dispatched at 14 bits through processMidiCC14;
+     * while learning they go through processMidiCC at 7 bits so 14-bit
+     * controllers can be learned. Other event kinds are ignored.
+     */
+    void processUniversalEvent(const UniversalMidiEvent& event);
+    
     // Mapping management
     
     /**
@@ -221,6 +245,13 @@ public:
      */
     using ParameterChangeCallback = std::function<void(const std::string& parameterId, float value)>;
     
+    /**
+     * @brief Callback for parameter changes by interned parameter index
+     * 
+     * Avoids passing strings on the MIDI thread; see getParameterIndex().
+     */
+    using ParameterIndexCallback = std::function<void(int parameterIndex, float value)>;
+    
     /**
      * @brief Callback for learning state changes
      */
@@ -236,6 +267,17 @@ public:
      */
     void setParameterChangeCallback(ParameterChangeCallback callback) { parameterChangeCallback_ = callback; }
     
+    /**
+     * @brief Set callback for parameter changes by index (called before the string callback)
+     */
+    void setParameterIndexCallback(ParameterIndexCallback callback) { parameterIndexCallback_ = callback; }
+    
+    /**
+     * @brief Interned index of a parameter ID, stable for the lifetime of this object
+     * @return Index, or -1 if no mapping has ever referenced the parameter
+     */
+    int getParameterIndex(const std::string& parameterId) const;
+    
     /**
      * @brief Set callback for learning state changes
      */
@@ -314,19 +356,57 @@ private:
     std::map<std::pair<int, int>, CCMapping> mappings_; // (channel, cc) -> mapping
     std::map<std::string, std::pair<int, int>> parameterToCC_; // parameter -> (channel, cc)
     
+    // Precompiled dispatch table read by processMidiCC without locking.
+    // Rebuilt from mappings_ (under mappingsMutex_) whenever they change and
+    // published with a pointer swap; "any channel" mappings are expanded into
+    // every channel without a specific mapping.
+    struct CurveTable {
+        std::array<float, 128> values;  // Final parameter value per 7-bit CC value
+        float minValue;
+        float maxValue;
+        bool inverted;
+        CCMapping::CurveType curveType;
+    };
+    
+    struct DispatchEntry {
+        int32_t parameterIndex = -1;    // -1 = unmapped
+        int32_t curveIndex = -1;
+        const std::string* parameterId = nullptr;  // Interned, never moves
+    };
+    
+    struct DispatchTable {
+        std::array<DispatchEntry, 16 * 128> entries;
+        std::vector<CurveTable> curves;
+    };
+    
+    std::atomic<const DispatchTable*> dispatchTable_{nullptr};
+    std::atomic<int> dispatchReaders_{0};
+    std::unique_ptr<const DispatchTable> currentTable_;
+    std::vector<std::unique_ptr<const DispatchTable>> retiredTables_;  // freed once no reader is active
+    
+    // Interned parameter IDs; append-only so indices and addresses stay valid
+    std::deque<std::string> parameterIds_;
+    std::map<std::string, int> parameterIndices_;
+    
     // Callbacks
     MappingCallback mappingCreatedCallback_;
     ParameterChangeCallback parameterChangeCallback_;
+    ParameterIndexCallback parameterIndexCallback_;
     LearningStateCallback learningStateCallback_;
     
-    // Statistics
+    // Statistics; per-message counters are atomics so the CC path takes no lock
     mutable std::mutex statsMutex_;
     LearningStats stats_;
+    std::atomic<int> messagesProcessed_{0};
+    std::array<std::atomic<int>, 128> ccUsageCount_{};
+    std::atomic<int64_t> lastActivityTicks_{0};
     
     // Internal methods
     void updateLearningState(LearningState newState, const std::string& message = "");
     void processLearningCC(int channel, int ccNumber, int value, const std::string& deviceName);
     void processNormalCC(int channel, int ccNumber, int value);
+    void rebuildDispatchTable();  // Caller holds mappingsMutex_
+    int internParameter(const std::string& parameterId);  // Caller holds mappingsMutex_
     float convertCCValue(int ccValue, const CCMapping& mapping) const;
     float applyCurve(float normalizedValue, CCMapping::CurveType curveType) const;
     CCMapping::CurveType detectOptimalCurve(const std::string& parameterId) const;
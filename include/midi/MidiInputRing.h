@@ -0,0 +1,145 @@
+#pragma once
+
+#include "MidiInterface.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AIMusicHardware {
+
+/**
+ * @brief One MIDI message as received, with its arrival time
+ *
+ * Channel voice and single-byte real-time messages fit in three bytes;
+ * longer messages (SysEx) are not carried.
+ */
+struct TimestampedMidi {
+    uint64_t timestampNs = 0;   // MidiInputRing::nowNs() at arrival
+    uint8_t bytes[3] = {0, 0, 0};
+    uint8_t size = 0;
+};
+
+/**
+ * @brief Wait-free single-producer single-consumer ring between a MIDI input
+ *        thread and the audio thread
+ *
+ * The input thread pushes raw bytes stamped with a steady clock; the audio
+ * thread drains once per block. Draining converts each timestamp to a
+ * sample offset inside the block, so notes keep their relative timing
+ * instead of all landing on the block boundary: a message that arrived a
+ * third of the way into the previous block period is rendered a third of
+ * the way into the current block. The cost is a constant one-block delay
+ * in place of up to one block of jitter.
+ *
+ * Storage is allocated once in the constructor; push and drain never
+ * allocate, lock or block.
+ */
+class MidiInputRing {
+public:
+    /**
+     * @param capacity Number of messages; rounded up to a power of two
+     */
+    explicit MidiInputRing(size_t capacity = 1024);
+
+    /**
+     * @brief Steady clock in nanoseconds, the time base for timestamps and block starts
+     */
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @brief Queue a message (producer side)
+     * @return false if the message is longer than 3 bytes or the ring is full;
+     *         both are counted in getDroppedCount()
+     */
+    bool push(const uint8_t* bytes, size_t size, uint64_t timestampNs) {
+        if (size == 0 || size > 3) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const size_t write = writeIndex_.load(std::memory_order_relaxed);
+        if (write - readIndex_.load(std::memory_order_acquire) >= buffer_.size()) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        TimestampedMidi& slot = buffer_[write & mask_];
+        slot.timestampNs = timestampNs;
+        slot.size = static_cast<uint8_t>(size);
+        std::copy(bytes, bytes + size, slot.bytes);
+        writeIndex_.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Hand every message received before blockStartNs to handler (consumer side)
+     *
+     * The block covers the period [blockStartNs - blockDuration, blockStartNs);
+     * handler(const TimestampedMidi&, int sampleOffset) is called in arrival
+     * order with offsets in [0, blockSize). Messages stamped at or after
+     * blockStartNs stay queued for the next block; messages older than the
+     * period (after an audio dropout) get offset 0.
+     *
+     * @return Number of messages handled
+     */
+    template <typename Handler>
+    size_t drain(uint64_t blockStartNs, double sampleRate, int blockSize, Handler&& handler) {
+        const size_t write = writeIndex_.load(std::memory_order_acquire);
+        size_t read = readIndex_.load(std::memory_order_relaxed);
+        const size_t start = read;
+
+        const double samplesPerNs = sampleRate * 1e-9;
+        const uint64_t periodNs = static_cast<uint64_t>(blockSize / samplesPerNs);
+        const uint64_t windowStart = blockStartNs > periodNs ? blockStartNs - periodNs : 0;
+
+        while (read != write) {
+            const TimestampedMidi& message = buffer_[read & mask_];
+            if (message.timestampNs >= blockStartNs) {
+                break;
+            }
+            int offset = 0;
+            if (message.timestampNs > windowStart) {
+                offset = static_cast<int>(static_cast<double>(message.timestampNs - windowStart) * samplesPerNs);
+                offset = std::min(offset, blockSize - 1);
+            }
+            handler(message, offset);
+            ++read;
+        }
+
+        readIndex_.store(read, std::memory_order_release);
+        return read - start;
+    }
+
+    /**
+     * @brief Convert a queued message to the engine's MidiMessage (channel 0-15)
+     */
+    static MidiMessage toMidiMessage(const TimestampedMidi& message);
+
+    size_t capacity() const { return buffer_.size(); }
+
+    /**
+     * @brief Approximate number of queued messages
+     */
+    size_t size() const {
+        return writeIndex_.load(std::memory_order_acquire) - readIndex_.load(std::memory_order_acquire);
+    }
+
+    uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<TimestampedMidi> buffer_;
+    size_t mask_;
+
+    // Monotonic counters, wrapped with mask_; kept on separate cache lines
+    alignas(64) std::atomic<size_t> writeIndex_{0};
+    alignas(64) std::atomic<size_t> readIndex_{0};
+    alignas(64) std::atomic<uint64_t> dropped_{0};
+};
+
+} // namespace AIMusicHardware
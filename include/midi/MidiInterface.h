@@ -7,6 +7,8 @@
 
 namespace AIMusicHardware {
 
+class MidiInputRing;
+
 struct MidiMessage {
     enum class Type {
         NoteOn,
@@ -46,6 +48,16 @@ public:
     
     void setCallback(MidiInputCallback* callback);
     
+    /**
+     * @brief Queue incoming messages into a ring instead of calling back
+     *
+     * While a ring is set, the MIDI thread only timestamps and pushes raw
+     * bytes; the consumer drains the ring (typically once per audio block).
+     * Pass nullptr to go back to callback delivery. The ring must outlive
+     * its use here.
+     */
+    void setRing(MidiInputRing* ring);
+    
 private:
     class Impl;
     std::unique_ptr<Impl> pimpl_;
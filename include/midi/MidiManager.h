@@ -1,8 +1,14 @@
 #pragma once
 
 #include "MidiInterface.h"
+#include "MidiInputRing.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
 #include <string>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <functional>
@@ -90,11 +96,52 @@ public:
     // MidiInputCallback implementation
     void handleIncomingMidiMessage(const MidiMessage& message) override;
 
-    // Process a MIDI message (can be called directly or via callback)
-    void processMidiMessage(const MidiMessage& message, int samplePosition = 0);
+    // Process a MIDI message now (can be called directly or via callback);
+    // processInputRing renders up to a message's sample offset before calling this
+    void processMidiMessage(const MidiMessage& message);
+
+    /**
+     * Buffer MIDI input in a MidiInputRing instead of processing it on the
+     * MIDI thread. Messages are then only delivered by processInputRing,
+     * which the audio callback must call in place of Synthesizer::process,
+     * and MIDI learn completes only when processMidiLearn is called.
+     * Can be called before or after openMidiInput.
+     * @param capacity Ring size in messages
+     */
+    void enableInputRing(size_t capacity = 1024);
+
+    /**
+     * Drain the input ring and render one audio block (audio thread)
+     *
+     * The synthesizer renders the block in segments split at each message's
+     * sample offset, so a note starts on the sample it was timestamped for
+     * rather than on the block boundary. Without an input ring the block is
+     * rendered in one piece.
+     * @param buffer Interleaved stereo output, as for Synthesizer::process
+     * @param numFrames Samples in this block
+     * @param blockStartNs MidiInputRing::nowNs() at the start of the audio callback
+     * @param sampleRate Current sample rate
+     * @return Number of messages processed
+     */
+    size_t processInputRing(float* buffer, int numFrames, uint64_t blockStartNs, double sampleRate);
+
+    // Ring created by enableInputRing, or nullptr
+    MidiInputRing* getInputRing() { return inputRing_.get(); }
 
     // Parameter MIDI learn functionality
     void armMidiLearn(const std::string& paramId);
+
+    /**
+     * Map the controller captured for MIDI learn (MIDI or UI thread)
+     *
+     * While learn is armed, processControlChange only records the first
+     * controller it sees, since with an input ring it runs on the audio
+     * thread. handleIncomingMidiMessage applies the capture itself; with an
+     * input ring, call this from the UI loop.
+     * @return true if a mapping was created
+     */
+    bool processMidiLearn();
+
     void cancelMidiLearn();
     void clearMidiLearn(const std::string& paramId);
     bool isMidiMapped(const std::string& paramId) const;
@@ -113,14 +160,14 @@ public:
     void setMidiMappings(const MidiParameterMap& mappings);
     
     // Message type processors
-    void processNoteOn(const MidiMessage& message, int samplePosition);
-    void processNoteOff(const MidiMessage& message, int samplePosition);
-    void processControlChange(const MidiMessage& message, int samplePosition);
-    void processPitchBend(const MidiMessage& message, int samplePosition);
-    void processAfterTouch(const MidiMessage& message, int samplePosition);
-    void processChannelPressure(const MidiMessage& message, int samplePosition);
-    void processAllNotesOff(const MidiMessage& message, int samplePosition);
-    void processSustain(const MidiMessage& message, int samplePosition);
+    void processNoteOn(const MidiMessage& message);
+    void processNoteOff(const MidiMessage& message);
+    void processControlChange(const MidiMessage& message);
+    void processPitchBend(const MidiMessage& message);
+    void processAfterTouch(const MidiMessage& message);
+    void processChannelPressure(const MidiMessage& message);
+    void processAllNotesOff(const MidiMessage& message);
+    void processSustain(const MidiMessage& message);
 
 public:
     // Different scaling types for MIDI to parameter conversion
@@ -153,19 +200,54 @@ private:
     
     // Handles parameter mapping for learning and updates
     void updateMappedParameter(int channel, int controller, int value);
+    
+    // Precompiled dispatch table read by updateMappedParameter without
+    // locking. Rebuilt from midiMappings_ (under mappingMutex_) whenever they
+    // change and published with a pointer swap; each entry carries the
+    // parameter resolved at bind time, so a CC costs no string work.
+    struct DispatchEntry {
+        const std::string* paramId = nullptr;  // Interned, never moves; nullptr = unmapped
+        int synthParameter = -1;               // SynthParamId index, -1 = listener only
+        ParameterScaling scaling = ParameterScaling::Linear;
+        float min = 0.0f;
+        float max = 1.0f;
+        int steps = 0;
+    };
+    
+    struct DispatchTable {
+        std::array<DispatchEntry, 16 * 128> entries;
+    };
+    
+    // Resolve a parameter ID to its dispatch entry (range and scaling from
+    // the synthesizer's parameter registry); call with mappingMutex_ held
+    DispatchEntry bindParameter(const std::string& paramId);
+    void rebuildDispatchTable();
 
     Synthesizer* synthesizer_;
     Listener* listener_;
     
     std::unique_ptr<MidiInput> midiInput_;
     std::unique_ptr<MidiOutput> midiOutput_;
+    std::unique_ptr<MidiInputRing> inputRing_;
+    std::vector<std::pair<MidiMessage, int>> ringEvents_;  // One drained block, sized to the ring
     
     // Parameter being learned
     std::string learnParamId_;
     
+    // Set by armMidiLearn; the first CC clears it and stores itself in
+    // learnCapture_ (channel << 16 | controller << 8 | value, -1 = none)
+    std::atomic<bool> learnArmed_{false};
+    std::atomic<int32_t> learnCapture_{-1};
+    
     // MIDI parameter mappings: channel -> (controller -> parameter ID)
     MidiParameterMap midiMappings_;
     
+    std::atomic<const DispatchTable*> dispatchTable_{nullptr};
+    std::atomic<int> dispatchReaders_{0};
+    std::unique_ptr<const DispatchTable> currentTable_;
+    std::vector<std::unique_ptr<const DispatchTable>> retiredTables_;  // freed once no reader is active
+    std::deque<std::string> parameterIds_;  // Interned IDs; append-only so addresses stay valid
+    
     // Thread safety
     mutable std::mutex mappingMutex_;
     mutable std::mutex learnMutex_;
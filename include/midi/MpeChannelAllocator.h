@@ -2,8 +2,6 @@
 
 #include "MpeConfiguration.h"
 #include <array>
-#include <mutex>
-#include <unordered_map>
 #include <cstdint>
 
 namespace AIMusicHardware {
@@ -14,6 +12,15 @@ namespace AIMusicHardware {
  * 
  * This class is responsible for allocating MIDI channels to notes in MPE mode,
  * handling channel rotation, and tracking which notes are assigned to which channels.
+ *
+ * Every operation is O(1) and lock-free: each zone keeps an intrusive free
+ * list (least recently released first, so release tails keep ringing) and
+ * a busy list (oldest allocation first, the steal candidate), linked
+ * through fixed per-channel arrays. Zone layouts are cached and refreshed
+ * when MpeConfiguration::getLayoutVersion() changes.
+ *
+ * Single writer: allocate, release and expression updates must come from
+ * one thread (the one handling MIDI input).
  */
 class MpeChannelAllocator {
 public:
@@ -95,12 +102,42 @@ public:
     bool updateExpression(int channel, float pitchBend, float timbre, float pressure);
 
 private:
+    static constexpr int kNumChannels = 16;
+    static constexpr int8_t kNone = -1;
+    
+    // Doubly linked list of channels threaded through prev_/next_
+    struct ChannelList {
+        int8_t head = kNone;
+        int8_t tail = kNone;
+    };
+    
+    // Cached zone layout plus its free and busy lists
+    struct ZoneLists {
+        bool active = false;
+        int startChannel = 0;   // 0-based
+        int endChannel = 0;
+        ChannelList free;       // Least recently released first
+        ChannelList busy;       // Oldest allocation first
+    };
+    
+    void refreshZones();
+    void rebuildZone(int zoneIndex, const MpeConfiguration::Zone& zone);
+    void unlink(ChannelList& list, int channel);
+    void pushBack(ChannelList& list, int channel);
+    void assignChannel(int channel, int note, int velocity);
+    static void clearChannelState(ChannelState& state);
+    
     const MpeConfiguration& mpeConfig_;
     std::array<ChannelState, 16> channelStates_;
-    std::unordered_map<int, int> noteToChannelMap_;  // Maps note to channel
+    std::array<int8_t, 128> noteToChannel_;     // Maps note to channel, kNone if unallocated
     uint32_t messageCounter_ = 0;  // For timestamps
     
-    mutable std::mutex allocationMutex_;
+    std::array<ZoneLists, 2> zones_;            // Lower, upper
+    std::array<int8_t, kNumChannels> channelZone_;
+    std::array<int8_t, kNumChannels> prev_;
+    std::array<int8_t, kNumChannels> next_;
+    uint32_t layoutVersion_ = 0;
+    bool layoutValid_ = false;
 };
 
 } // namespace AIMusicHardware
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <mutex>
 
@@ -67,6 +69,14 @@ public:
      */
     Zone getUpperZone() const;
     
+    /**
+     * @brief Counter bumped whenever a zone layout changes
+     *
+     * Lets hot paths cache zone layouts and refresh them only when this
+     * value moves, instead of copying zones under the lock per message.
+     */
+    uint32_t getLayoutVersion() const { return layoutVersion_.load(std::memory_order_acquire); }
+    
     /**
      * @brief Check if MPE mode is currently active
      * 
@@ -162,6 +172,8 @@ private:
     Zone upperZone_;
     std::array<bool, 16> activeChannels_;
     
+    std::atomic<uint32_t> layoutVersion_{0};
+    
     mutable std::mutex configMutex_;
 };
 
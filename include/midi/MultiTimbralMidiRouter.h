@@ -3,6 +3,7 @@
 #include "MidiInterface.h"
 #include "MpeConfiguration.h"
 #include "MpeChannelAllocator.h"
+#include "UniversalMidiParser.h"
 #include <string>
 #include <map>
 #include <mutex>
@@ -70,6 +71,20 @@ public:
     // Process a MIDI message (can be called directly or via callback)
     void processMidiMessage(const MidiMessage& message);
 
+    /**
+     * @brief Process a Universal MIDI Packet (MIDI 1.0 or MIDI 2.0 channel voice)
+     *
+     * MIDI 1.0 packets go through the router's UniversalMidiParser, so
+     * 14-bit CC pairs and RPN data entry LSBs are reassembled. Pressure,
+     * aftertouch and MPE timbre reach the engine at full resolution.
+     */
+    void processUniversalPacket(const UniversalMidiPacket& packet);
+
+    /**
+     * @brief Process an already parsed high resolution event
+     */
+    void processUniversalEvent(const UniversalMidiEvent& event);
+
     //----------------------------------------------------------------------
     // Standard multi-timbral mode message processors
     //----------------------------------------------------------------------
@@ -254,6 +269,14 @@ private:
     // Checks if a channel is valid (0-15)
     bool isValidChannel(int channel) const;
 
+    // Shared by the MidiMessage and UniversalMidiEvent paths
+    void applyPitchBend(int channel, float normalizedValue);
+    void applyAfterTouch(int channel, int note, float pressure);
+    void applyChannelPressure(int channel, float pressure);
+    void applyMpePitchBend(int channel, float normalizedValue);
+    void applyMpeTimbre(int channel, int value, float normalizedValue);
+    void applyMpePressure(int channel, float normalizedValue);
+
     // Expression scaling utilities
     float scalePitchBend(int rawValue) const;
     float scaleTimbre(int rawValue) const;
@@ -280,6 +303,9 @@ private:
     };
     std::array<RpnState, 16> rpnStates_;
 
+    // High resolution parser for processUniversalPacket
+    UniversalMidiParser universalParser_;
+
     // MIDI channel enabling/filtering for standard mode
     std::array<bool, 16> channelEnabled_;
 
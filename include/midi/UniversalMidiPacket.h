@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+
+namespace AIMusicHardware {
+
+/**
+ * @brief One Universal MIDI Packet (UMP) as defined by MIDI 2.0
+ *
+ * Plain 64-bit value type: MIDI 1.0 channel voice messages use one 32-bit
+ * word (message type 0x2), MIDI 2.0 channel voice messages use two words
+ * (message type 0x4). Unused words are zero. Packets are trivially
+ * copyable, so they can travel through lock-free queues and be stored in
+ * fixed arrays without allocation.
+ *
+ *   word 0: [type:4][group:4][status:4][channel:4][byte 2:8][byte 3:8]
+ *   word 1: 32-bit data (MIDI 2.0 messages only)
+ */
+struct UniversalMidiPacket {
+    enum MessageType : uint8_t {
+        Utility = 0x0,
+        System = 0x1,
+        Midi1ChannelVoice = 0x2,
+        SysEx7 = 0x3,
+        Midi2ChannelVoice = 0x4
+    };
+
+    /**
+     * @brief MIDI 2.0 channel voice opcodes (status nibble of a type 0x4 packet)
+     */
+    enum Opcode : uint8_t {
+        RegisteredPerNoteController = 0x0,
+        AssignablePerNoteController = 0x1,
+        RegisteredController = 0x2,     // RPN
+        AssignableController = 0x3,     // NRPN
+        PerNotePitchBend = 0x6,
+        NoteOff = 0x8,
+        NoteOn = 0x9,
+        PolyPressure = 0xA,
+        ControlChange = 0xB,
+        ProgramChange = 0xC,
+        ChannelPressure = 0xD,
+        PitchBend = 0xE
+    };
+
+    uint32_t words[2] = {0, 0};
+
+    uint8_t messageType() const { return static_cast<uint8_t>(words[0] >> 28); }
+    uint8_t group() const { return static_cast<uint8_t>((words[0] >> 24) & 0x0F); }
+    uint8_t status() const { return static_cast<uint8_t>((words[0] >> 20) & 0x0F); }
+    uint8_t channel() const { return static_cast<uint8_t>((words[0] >> 16) & 0x0F); }
+    uint8_t byte2() const { return static_cast<uint8_t>((words[0] >> 8) & 0xFF); }
+    uint8_t byte3() const { return static_cast<uint8_t>(words[0] & 0xFF); }
+    uint32_t data() const { return words[1]; }
+
+    /**
+     * @brief Number of 32-bit words used by this packet's message type
+     */
+    int wordCount() const {
+        static constexpr uint8_t sizes[16] = {1, 1, 1, 2, 2, 4, 1, 1, 2, 2, 2, 3, 3, 4, 4, 4};
+        return sizes[messageType()];
+    }
+
+    /**
+     * @brief Wrap a MIDI 1.0 channel voice message (status byte plus data bytes)
+     */
+    static UniversalMidiPacket fromMidi1(uint8_t statusByte, uint8_t data1, uint8_t data2, uint8_t group = 0) {
+        UniversalMidiPacket packet;
+        packet.words[0] = (static_cast<uint32_t>(Midi1ChannelVoice) << 28) |
+                          (static_cast<uint32_t>(group & 0x0F) << 24) |
+                          (static_cast<uint32_t>(statusByte) << 16) |
+                          (static_cast<uint32_t>(data1 & 0x7F) << 8) |
+                          static_cast<uint32_t>(data2 & 0x7F);
+        return packet;
+    }
+
+    /**
+     * @brief Build a MIDI 2.0 channel voice message
+     * @param opcode One of Opcode
+     * @param index1 Note, controller number or bank, depending on opcode
+     * @param index2 Attribute type, controller index or zero
+     * @param value 32-bit data word
+     */
+    static UniversalMidiPacket midi2(uint8_t opcode, uint8_t channel, uint8_t index1, uint8_t index2,
+                                     uint32_t value, uint8_t group = 0) {
+        UniversalMidiPacket packet;
+        packet.words[0] = (static_cast<uint32_t>(Midi2ChannelVoice) << 28) |
+                          (static_cast<uint32_t>(group & 0x0F) << 24) |
+                          (static_cast<uint32_t>(opcode & 0x0F) << 20) |
+                          (static_cast<uint32_t>(channel & 0x0F) << 16) |
+                          (static_cast<uint32_t>(index1) << 8) |
+                          static_cast<uint32_t>(index2);
+        packet.words[1] = value;
+        return packet;
+    }
+
+    /**
+     * @brief MIDI 2.0 note on/off; velocity is 16-bit in the high half of the data word
+     */
+    static UniversalMidiPacket midi2Note(bool on, uint8_t channel, uint8_t note, uint16_t velocity,
+                                         uint8_t group = 0) {
+        return midi2(on ? NoteOn : NoteOff, channel, note & 0x7F, 0,
+                     static_cast<uint32_t>(velocity) << 16, group);
+    }
+};
+
+static_assert(sizeof(UniversalMidiPacket) == 8, "UniversalMidiPacket must stay a 64-bit POD");
+
+namespace MidiResolution {
+
+/**
+ * @brief Scale a value to a wider resolution with the MIDI 2.0 min-center-max rule
+ *
+ * Zero stays zero, the source center maps to the exact destination center
+ * and the source maximum maps to the destination maximum, so 7-bit 64 and
+ * 14-bit 8192 both become 0x80000000 at 32 bits.
+ */
+constexpr uint32_t scaleUp(uint32_t value, int sourceBits, int destinationBits) {
+    if (sourceBits >= destinationBits) {
+        return value;
+    }
+    const int scaleBits = destinationBits - sourceBits;
+    uint64_t shifted = static_cast<uint64_t>(value) << scaleBits;
+    const uint32_t center = 1u << (sourceBits - 1);
+    if (value <= center || sourceBits < 2) {
+        return static_cast<uint32_t>(shifted);
+    }
+
+    const int repeatBits = sourceBits - 1;
+    uint64_t repeat = value & ((1u << repeatBits) - 1);
+    repeat = scaleBits > repeatBits ? repeat << (scaleBits - repeatBits) : repeat >> (repeatBits - scaleBits);
+    while (repeat != 0) {
+        shifted |= repeat;
+        repeat >>= repeatBits;
+    }
+    return static_cast<uint32_t>(shifted);
+}
+
+/**
+ * @brief Drop low bits to get back to a narrower resolution
+ */
+constexpr uint32_t scaleDown(uint32_t value, int sourceBits, int destinationBits) {
+    return sourceBits > destinationBits ? value >> (sourceBits - destinationBits) : value;
+}
+
+/**
+ * @brief Map a 32-bit value onto 0.0-1.0
+ */
+constexpr float toUnit(uint32_t value) {
+    return static_cast<float>(static_cast<double>(value) / 4294967295.0);
+}
+
+/**
+ * @brief Map a 32-bit bipolar value (center 0x80000000) onto -1.0 to +1.0
+ */
+constexpr float toBipolar(uint32_t value) {
+    return static_cast<float>((static_cast<double>(value) - 2147483648.0) / 2147483648.0);
+}
+
+} // namespace MidiResolution
+
+} // namespace AIMusicHardware
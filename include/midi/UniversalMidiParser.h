@@ -0,0 +1,125 @@
+#pragma once
+
+#include "MidiInterface.h"
+#include "UniversalMidiPacket.h"
+#include <array>
+#include <cstdint>
+
+namespace AIMusicHardware {
+
+/**
+ * @brief A decoded channel voice event at MIDI 2.0 resolution
+ *
+ * Every value is carried as 32 bits regardless of what the sender used,
+ * so 7-bit CC, 14-bit CC pairs, NRPN data entry and MIDI 2.0 controllers
+ * all reach consumers through the same field. sourceBits records the
+ * sender's resolution for consumers that care about it.
+ */
+struct UniversalMidiEvent {
+    enum class Kind : uint8_t {
+        NoteOn,
+        NoteOff,
+        ControlChange,          // index = controller number (0-127)
+        RegisteredParameter,    // index = 14-bit RPN number
+        AssignableParameter,    // index = 14-bit NRPN number
+        PerNoteController,      // note + index = per-note controller (bit 8 set for assignable)
+        PolyPressure,
+        ChannelPressure,
+        PitchBend,              // bipolar, center 0x80000000
+        PerNotePitchBend,       // bipolar, center 0x80000000
+        ProgramChange           // index = program
+    };
+
+    Kind kind = Kind::ControlChange;
+    uint8_t group = 0;
+    uint8_t channel = 0;        // 0-15
+    uint8_t note = 0;           // Note events and per-note messages
+    uint8_t sourceBits = 7;     // 7, 14, 16 or 32
+    uint16_t index = 0;
+    uint32_t value = 0;         // Full 32-bit range; velocity for notes
+
+    float unit() const { return MidiResolution::toUnit(value); }
+    float bipolar() const { return MidiResolution::toBipolar(value); }
+
+    /**
+     * @brief Value reduced to the 7-bit range used by legacy consumers
+     */
+    int value7() const { return static_cast<int>(value >> 25); }
+
+    /**
+     * @brief Value reduced to the 14-bit range (0-16383)
+     */
+    int value14() const { return static_cast<int>(value >> 18); }
+};
+
+/**
+ * @brief Turns MIDI 1.0 byte messages and UMP packets into UniversalMidiEvents
+ *
+ * Tracks the per-channel state needed to reassemble high resolution data
+ * from MIDI 1.0 streams: CC 0-31 paired with their LSB controllers 32-63,
+ * and RPN/NRPN parameter selection with data entry (CC 6/38) and
+ * increment/decrement (CC 96/97). MIDI 2.0 packets carry full resolution
+ * directly and pass through statelessly.
+ *
+ * Parsing fills a caller-provided event, never allocates and never calls
+ * back, so it is safe on the MIDI input thread and on the audio
+ * thread. One instance per input stream; not thread-safe.
+ */
+class UniversalMidiParser {
+public:
+    UniversalMidiParser();
+
+    /**
+     * @brief Parse a UMP (MIDI 1.0 or MIDI 2.0 channel voice)
+     * @param event Receives the decoded event
+     * @return false for messages that were consumed (RPN/NRPN selection)
+     *         or are not channel voice messages
+     */
+    bool parse(const UniversalMidiPacket& packet, UniversalMidiEvent& event);
+
+    /**
+     * @brief Parse a legacy MidiMessage as delivered by MidiInput
+     */
+    bool parse(const MidiMessage& message, UniversalMidiEvent& event);
+
+    /**
+     * @brief Parse a raw MIDI 1.0 channel voice message
+     */
+    bool parseMidi1(uint8_t status, uint8_t data1, uint8_t data2, UniversalMidiEvent& event,
+                    uint8_t group = 0);
+
+    /**
+     * @brief Pair CC 0-31 with CC 32-63 into 14-bit values (default on)
+     *
+     * Turn off for controllers that use 32-63 as independent 7-bit CCs.
+     */
+    void setHighResolutionPairs(bool enabled) { pairControllers_ = enabled; }
+    bool getHighResolutionPairs() const { return pairControllers_; }
+
+    /**
+     * @brief Forget pending MSBs and parameter selections on every channel
+     */
+    void reset();
+
+private:
+    static constexpr uint16_t kNullParameter = 0x3FFF;
+
+    struct ChannelState {
+        std::array<uint8_t, 32> controllerMsb{};    // Last MSB of CC 0-31
+        uint32_t msbSeen = 0;                       // Bit per CC 0-31
+        uint16_t parameter = kNullParameter;        // Selected RPN/NRPN
+        uint8_t parameterMsb = 0x7F;
+        uint8_t parameterLsb = 0x7F;
+        bool registered = true;                     // RPN (101/100) or NRPN (99/98)
+        uint16_t dataEntry = 0;                     // 14-bit data entry value
+    };
+
+    bool parseControlChange(uint8_t controller, uint8_t value, UniversalMidiEvent& event);
+    bool emitParameter(const ChannelState& state, int sourceBits, UniversalMidiEvent& event);
+    bool parseMidi2(const UniversalMidiPacket& packet, UniversalMidiEvent& event);
+
+    std::array<ChannelState, 16> channels_;
+    bool pairControllers_ = true;
+};
+
+} // namespace AIMusicHardware
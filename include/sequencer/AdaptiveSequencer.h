@@ -2,11 +2,15 @@
 
 #include <string>
 #include <vector>
+#include <array>
+#include <deque>
 #include <map>
+#include <unordered_map>
 #include <memory>
 #include <functional>
 #include <mutex>
 #include <atomic>
+#include <cstdint>
 
 #include "Sequencer.h"
 #include "../audio/AudioEngine.h"
@@ -48,7 +52,16 @@ class Parameter {
 public:
     Parameter(const std::string& name, float defaultValue = 0.0f, float minValue = 0.0f, float maxValue = 1.0f);
     
+    /**
+     * @brief Process-wide interned ID for a parameter name
+     *
+     * Parameters with the same name share an ID, so state and global
+     * parameters can be matched without string compares.
+     */
+    static uint32_t internId(const std::string& name);
+    
     std::string getName() const;
+    uint32_t getId() const { return id_; }
     float getValue() const;
     void setValue(float value);
     float getMin() const;
@@ -61,23 +74,44 @@ public:
     using ChangeCallback = std::function<void(const Parameter&, float oldValue, float newValue)>;
     void setChangeCallback(ChangeCallback callback);
     
+    /**
+     * @brief Notify an observer (e.g. a TransitionManager) on every value change
+     *
+     * Independent of the change callback; one notifier per owner.
+     */
+    using DependencyNotifier = std::function<void(uint32_t parameterId)>;
+    void addDependencyNotifier(const void* owner, DependencyNotifier notifier);
+    void removeDependencyNotifier(const void* owner);
+    
 private:
     std::string name_;
+    uint32_t id_;
     float value_;
     float defaultValue_;
     float minValue_;
     float maxValue_;
     bool bipolar_;
     ChangeCallback changeCallback_;
+    std::vector<std::pair<const void*, DependencyNotifier>> dependencyNotifiers_;
     mutable std::mutex mutex_; // Make mutex mutable so it can be locked in const methods
 };
 
 /**
  * @brief Event system for trigger events
+ *
+ * Event names are interned to integer IDs; listeners are stored per ID and
+ * scheduled events sit in a binary heap keyed by beat, so processTick()
+ * only touches events that are due. The mutex is recursive so listeners
+ * may trigger or schedule events.
+ *
+ * The audio thread uses collectDue() instead of processTick(): it moves
+ * due events to a lock-free queue without blocking or allocating, and
+ * dispatchPending() runs their listeners on another thread.
  */
 class EventSystem {
 public:
     using EventCallback = std::function<void(const std::string& eventName, const std::map<std::string, float>& eventData)>;
+    using EventData = std::map<std::string, float>;
     
     EventSystem();
     
@@ -85,27 +119,100 @@ public:
     void unregisterEvent(const std::string& eventName);
     bool isEventRegistered(const std::string& eventName) const;
     
+    /**
+     * @brief Interned ID for an event name, creating it if needed
+     */
+    int getEventId(const std::string& eventName);
+    
     void addListener(const std::string& eventName, EventCallback callback);
     void removeListener(const std::string& eventName, void* owner);
     
     void triggerEvent(const std::string& eventName, const std::map<std::string, float>& eventData = {});
+    void triggerEvent(int eventId, const std::map<std::string, float>& eventData = {});
     
     // Time-based event scheduling
     void scheduleEvent(const std::string& eventName, float delayInBeats, 
                        const std::map<std::string, float>& eventData = {});
+    
+    /**
+     * @brief Schedule an event at an absolute beat position
+     *
+     * Events due at the same beat fire in the order they were scheduled.
+     */
+    void scheduleEventAt(int eventId, double beat, const std::map<std::string, float>& eventData = {});
+    
     void cancelScheduledEvents(const std::string& eventName);
-    void processTick(float beatPosition);
+    
+    /**
+     * @brief Fire every scheduled event due at or before beatPosition
+     *
+     * Events scheduled by listeners during this call wait for the next tick.
+     */
+    void processTick(double beatPosition);
+    
+    /**
+     * @brief Queue every scheduled event due at or before beatPosition (audio thread)
+     *
+     * Never blocks or allocates: if another thread holds the event lock the
+     * due events are picked up by the next call, and events that do not fit
+     * the queue stay scheduled. Listeners run in dispatchPending().
+     *
+     * @return Number of events queued
+     */
+    size_t collectDue(double beatPosition);
+    
+    /**
+     * @brief Run listeners for the events queued by collectDue()
+     *
+     * Call from a control or UI thread, never from the audio thread.
+     *
+     * @return Number of events dispatched
+     */
+    size_t dispatchPending();
+    
+    size_t getScheduledEventCount() const;
     
 private:
     struct ScheduledEvent {
-        std::string eventName;
-        float triggerBeat;
-        std::map<std::string, float> eventData;
+        double triggerBeat;
+        uint64_t sequence;  // Tie-break so equal beats fire in schedule order
+        int eventId;
+        int payload;        // Index into payloads_, -1 for no data
     };
     
-    std::map<std::string, std::vector<EventCallback>> eventListeners_;
-    std::vector<ScheduledEvent> scheduledEvents_;
-    mutable std::mutex mutex_; // Make mutex mutable so it can be locked in const methods
+    // Min-heap order on (triggerBeat, sequence)
+    struct Later {
+        bool operator()(const ScheduledEvent& a, const ScheduledEvent& b) const {
+            return a.triggerBeat != b.triggerBeat ? a.triggerBeat > b.triggerBeat : a.sequence > b.sequence;
+        }
+    };
+    
+    int findEventId(const std::string& eventName) const;
+    void dispatch(int eventId, const EventData& eventData);
+    
+    std::unordered_map<std::string, int> eventIds_;
+    std::deque<std::string> eventNames_;                // Indexed by ID; deque keeps names stable for listeners
+    std::vector<std::vector<EventCallback>> listeners_; // Indexed by ID
+    std::vector<bool> registered_;                      // Indexed by ID
+    
+    std::vector<ScheduledEvent> scheduledEvents_;       // Binary heap
+    std::vector<ScheduledEvent> deferredEvents_;        // Scheduled during processTick()
+    std::deque<EventData> payloads_;                    // Event data pool, reused through freePayloads_
+    std::vector<int> freePayloads_;
+    uint64_t nextSequence_ = 0;
+    double currentBeat_ = 0.0;
+    
+    // Due events handed from collectDue() to dispatchPending()
+    struct DueEvent {
+        int eventId;
+        int payload;
+    };
+    static constexpr size_t kDueQueueSize = 256;  // Power of two
+    std::array<DueEvent, kDueQueueSize> dueEvents_;
+    alignas(64) std::atomic<size_t> dueWrite_{0};
+    alignas(64) std::atomic<size_t> dueRead_{0};
+    
+    mutable std::recursive_mutex mutex_; // Make mutex mutable so it can be locked in const methods
 };
 
 /**
@@ -250,6 +357,16 @@ public:
     void clearCondition(const std::string& paramName);
     bool checkConditions() const;
     
+    /**
+     * @brief IDs of the parameters this transition's conditions read
+     */
+    std::vector<uint32_t> getConditionParameterIds() const;
+    
+    /**
+     * @brief Parameters this transition's conditions read (expired ones skipped)
+     */
+    std::vector<std::shared_ptr<Parameter>> getConditionParameters() const;
+    
 private:
     std::string name_;
     std::weak_ptr<MusicState> fromState_;
@@ -270,6 +387,13 @@ private:
 
 /**
  * @brief Manages transitions between states
+ *
+ * Transitions are indexed by the parameters their conditions read. Each
+ * indexed parameter notifies the manager when it changes, and
+ * findTriggeredTransition() re-evaluates only the transitions that depend
+ * on parameters changed since the last call. Conditions are indexed when a
+ * transition is added; call refreshIndex() after changing the conditions
+ * of a transition that is already added.
  */
 class TransitionManager {
 public:
@@ -287,11 +411,49 @@ public:
     
     void update(float deltaTime);
     
+    /**
+     * @brief Rebuild the parameter index from the current transition conditions
+     */
+    void refreshIndex();
+    
+    /**
+     * @brief Find a transition out of fromState whose conditions now hold
+     *
+     * Evaluates every transition from fromState when fullScan is set (or the
+     * index changed); otherwise only those depending on changed parameters.
+     *
+     * @return The first satisfied transition, or nullptr
+     */
+    std::shared_ptr<StateTransition> findTriggeredTransition(const std::shared_ptr<MusicState>& fromState,
+                                                             bool fullScan = false);
+    
+    /**
+     * @brief Total checkConditions() calls made by findTriggeredTransition()
+     */
+    uint64_t getConditionEvaluationCount() const { return conditionEvaluations_; }
+    
 private:
+    void markParameterChanged(uint32_t parameterId);
+    void rebuildIndexLocked();
+    void detachNotifiersLocked();
+    
     std::map<std::string, std::shared_ptr<StateTransition>> transitions_;
     std::shared_ptr<StateTransition> activeTransition_;
     float transitionProgress_;
     mutable std::mutex mutex_; // Make mutex mutable so it can be locked in const methods
+    
+    // Transitions by condition parameter ID, and the parameters notifying us
+    std::unordered_map<uint32_t, std::vector<std::shared_ptr<StateTransition>>> transitionsByParameter_;
+    std::vector<std::weak_ptr<Parameter>> observedParameters_;
+    bool indexChanged_ = true;
+    
+    // Parameters changed since the last evaluation; separate lock so
+    // notifications never wait on evaluation
+    std::mutex changedMutex_;
+    std::vector<uint32_t> changedParameters_;
+    std::vector<uint32_t> evaluatingParameters_;
+    
+    uint64_t conditionEvaluations_ = 0;
 };
 
 /**
@@ -333,6 +495,13 @@ public:
     void registerEvent(const std::string& eventName);
     void addEventListener(const std::string& eventName, EventSystem::EventCallback callback);
     
+    /**
+     * @brief Schedule an event relative to the current beat
+     */
+    void scheduleEvent(const std::string& eventName, float delayInBeats,
+                       const std::map<std::string, float>& data = {});
+    EventSystem& getEventSystem() { return *eventSystem_; }
+    
     // Transport control
     void play();
     void stop();
@@ -350,6 +519,39 @@ public:
     // Update function to be called regularly
     void update(float deltaTime);
     
+    /**
+     * @brief Sample rate of the audio clock driving processBlock()
+     */
+    void setSampleRate(double sampleRate);
+    double getSampleRate() const { return sampleRate_; }
+    
+    /**
+     * @brief Advance by one audio block (call from the audio callback)
+     *
+     * The beat position is derived from the running sample count, so timing
+     * follows the audio clock and does not drift with the caller's
+     * scheduling the way update(deltaTime) does. Events due before the end
+     * of the block are queued for dispatchEvents(); listeners never run on
+     * the audio thread. If a control thread holds the sequencer lock, the
+     * block's frames are carried over to the next call instead of waiting.
+     *
+     * @param numFrames Number of frames in the block
+     */
+    void processBlock(int numFrames);
+    
+    /**
+     * @brief Run listeners for events queued by processBlock()
+     *
+     * Call regularly from a control or UI thread while the audio callback
+     * drives the sequencer.
+     *
+     * @return Number of events dispatched
+     */
+    size_t dispatchEvents();
+    
+    double getCurrentBeat() const;
+    uint64_t getSamplePosition() const;
+    
 private:
     std::shared_ptr<AudioEngine> audioEngine_;
     std::shared_ptr<Synthesizer> synthesizer_;
@@ -366,10 +568,22 @@ private:
     
     bool isPlaying_;
     float tempo_;
-    float currentBeat_;
+    double currentBeat_;
+    
+    // Audio clock
+    double sampleRate_;
+    uint64_t samplePosition_;
+    int pendingFrames_ = 0;  // Audio thread only: frames of blocks that could not take the lock
+    
+    // Active state seen by the last transition scan; a change forces a full scan
+    std::shared_ptr<MusicState> scannedState_;
     
     mutable std::mutex mutex_; // Make mutex mutable so it can be locked in const methods
     
+    // Shared by update() and processBlock(); the audio path queues due
+    // events instead of dispatching them
+    void advance(double beats, bool queueEvents);
+    
     // Hardware control callbacks
     void onControlChange(int controllerId, float value);
     void onButtonPress(int buttonId, bool isPressed);
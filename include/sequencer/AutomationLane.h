@@ -0,0 +1,373 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AIMusicHardware {
+
+class ParameterStore;
+class Sequencer;
+
+/**
+ * @brief Breakpoint curve for one parameter over sequencer beats
+ *
+ * Points are kept sorted in parallel arrays (beat, value, shape), so a lane
+ * costs 13 bytes per point and is scanned without pointer chasing. Each
+ * point's shape describes the segment that starts at it: Linear ramps to the
+ * next point, Step holds until the next point. Before the first point the
+ * lane holds the first value, after the last point the last value.
+ *
+ * getValueAt() is a binary search and safe to call from any thread while
+ * nobody edits the lane. evaluate() and render() keep a cursor on the
+ * current segment, so playing forward costs O(1) per block however dense the
+ * lane is; jumps backwards or far ahead fall back to a binary search.
+ *
+ * Not thread-safe; AutomationPlayer serialises edits against playback.
+ */
+class AutomationLane {
+public:
+    enum class Shape : uint8_t {
+        Linear,
+        Step
+    };
+
+    AutomationLane(const std::string& parameterId = "", float minValue = 0.0f, float maxValue = 1.0f);
+    ~AutomationLane();
+
+    const std::string& getParameterId() const { return parameterId_; }
+    float getMinValue() const { return minValue_; }
+    float getMaxValue() const { return maxValue_; }
+
+    /**
+     * @brief Controller written by MidiFile export (-1 to leave the lane out)
+     */
+    void setMidiController(int controller, int channel = 0);
+    int getMidiController() const { return midiController_; }
+    int getMidiChannel() const { return midiChannel_; }
+
+    //--------------------------------------------------------------------------
+    // Editing
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Insert a point, replacing any point at the same beat
+     *
+     * Values are clamped to the lane range. Appending after the last point
+     * is O(1); inserting elsewhere moves the points after it.
+     */
+    void addPoint(double beat, float value, Shape shape = Shape::Linear);
+
+    /**
+     * @brief Remove points with startBeat <= beat <= endBeat
+     */
+    void removePoints(double startBeat, double endBeat);
+
+    /**
+     * @brief Replace the points in [startBeat, endBeat] with sorted points
+     *
+     * Used to punch a recorded take into the lane. Points outside the range
+     * must not be passed; missing shapes default to Linear.
+     */
+    void replacePoints(double startBeat, double endBeat, const std::vector<double>& beats,
+                       const std::vector<float>& values, const std::vector<Shape>& shapes = {});
+
+    void clear();
+    void reserve(size_t numPoints);
+
+    size_t getNumPoints() const { return beats_.size(); }
+    bool isEmpty() const { return beats_.empty(); }
+    double getPointBeat(size_t index) const { return beats_[index]; }
+    float getPointValue(size_t index) const { return values_[index]; }
+    Shape getPointShape(size_t index) const { return shapes_[index]; }
+
+    // Bytes held by the point arrays
+    size_t getMemoryUsage() const;
+
+    //--------------------------------------------------------------------------
+    // Evaluation
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Value at a beat, by binary search (the range minimum if empty)
+     */
+    float getValueAt(double beat) const;
+
+    /**
+     * @brief Value at a beat, moving the playback cursor
+     */
+    float evaluate(double beat);
+
+    /**
+     * @brief Per-sample values for a block, moving the playback cursor
+     *
+     * @param startBeat Beat of the first sample
+     * @param beatsPerSample Beats advanced per sample (tempo / 60 / sample rate)
+     * @param output numFrames values
+     * @param numFrames Number of samples
+     */
+    void render(double startBeat, double beatsPerSample, float* output, int numFrames);
+
+    /**
+     * @brief Forget the cursor, e.g. after a locate
+     */
+    void resetCursor() { cursor_ = -1; }
+
+private:
+    // Index of the last point at or before beat, or -1 if beat is before the first
+    long findSegment(double beat) const;
+
+    // Move the cursor to the segment containing beat
+    long seek(double beat);
+
+    float segmentValue(long segment, double beat) const;
+
+    std::string parameterId_;
+    float minValue_;
+    float maxValue_;
+    int midiController_ = -1;
+    int midiChannel_ = 0;
+
+    std::vector<double> beats_;
+    std::vector<float> values_;
+    std::vector<Shape> shapes_;
+
+    long cursor_ = -1;
+};
+
+/**
+ * @brief Thins a stream of parameter changes into lane points as they arrive
+ *
+ * Uses a swing-door filter: a change is only kept when the straight line
+ * from the last kept point can no longer pass within the tolerance of every
+ * change dropped since. Dense CC streams and UI drags that move smoothly
+ * collapse to a handful of points, with every dropped value still within
+ * tolerance of the recorded curve. Each change is O(1).
+ */
+class AutomationRecorder {
+public:
+    /**
+     * @param tolerance Maximum deviation of a dropped change, in parameter units
+     */
+    explicit AutomationRecorder(float tolerance = 0.0f);
+
+    void setTolerance(float tolerance);
+    float getTolerance() const { return tolerance_; }
+
+    /**
+     * @brief Start a take; earlier points of the take are discarded
+     */
+    void begin(double beat);
+
+    /**
+     * @brief Add a change to the take
+     *
+     * Changes must not go backwards in time; a change at the same beat as
+     * the previous one lands a fraction of a sample after it, so a jump
+     * becomes a step.
+     *
+     * @return false if no take is running or beat is before the last change
+     */
+    bool addValue(double beat, float value);
+
+    /**
+     * @brief End the take and punch it into a lane
+     *
+     * Points of the lane between the take's first beat and endBeat are
+     * replaced by the take. If the lane already had points, its value at
+     * the take's start is held up to the first recorded point, and the last
+     * recorded value is held until endBeat, where the existing curve resumes.
+     */
+    void finish(double endBeat, AutomationLane& lane);
+
+    /**
+     * @brief Drop the take without touching any lane
+     */
+    void cancel();
+
+    bool isRecording() const { return recording_; }
+    size_t getReceivedCount() const { return received_; }
+    size_t getKeptCount() const { return beats_.size() + (hasPending_ ? 1 : 0); }
+
+private:
+    void keep(double beat, float value);
+
+    float tolerance_;
+    bool recording_ = false;
+    double startBeat_ = 0.0;
+    size_t received_ = 0;
+
+    // Kept points of the take
+    std::vector<double> beats_;
+    std::vector<float> values_;
+
+    // Latest change, not yet known to be needed
+    bool hasPending_ = false;
+    double pendingBeat_ = 0.0;
+    float pendingValue_ = 0.0f;
+
+    // Slopes from the last kept point that stay within tolerance of every
+    // change dropped since
+    double slopeLow_ = 0.0;
+    double slopeHigh_ = 0.0;
+};
+
+/**
+ * @brief Plays and records automation lanes against the sequencer clock
+ *
+ * Playback runs on the audio thread: process() renders each lane's
+ * per-sample values for the block from the beat position and tempo (or
+ * straight from a Sequencer) and writes the block-end value to the bound
+ * ParameterStore, so automation goes through the same index-addressed path
+ * as every other change source. Consumers that need sample accuracy read
+ * getLaneBuffer().
+ *
+ * Recording runs on MIDI or UI threads: startRecording() arms a lane, whose
+ * playback is then suspended so it does not fight the incoming changes;
+ * recordValue() feeds the lane's AutomationRecorder; stopRecording() punches
+ * the thinned take into the lane.
+ *
+ * Lane edits take the lane mutex. The audio thread only try-locks it and
+ * holds the previous values for a block if an edit is in progress, so it
+ * never waits. Recording has a mutex per lane and does not touch the lane
+ * mutex until the take is punched in.
+ */
+class AutomationPlayer {
+public:
+    AutomationPlayer(int sampleRate = 44100);
+    ~AutomationPlayer();
+
+    //--------------------------------------------------------------------------
+    // Setup and editing (not the audio thread)
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Add a lane (setup, before audio starts)
+     *
+     * Its parameter ID is resolved in the bound store.
+     *
+     * @return Lane index
+     */
+    int addLane(const AutomationLane& lane);
+
+    int getLaneCount() const;
+    int findLane(const std::string& parameterId) const;
+
+    /**
+     * @brief Edit a lane under the lane mutex
+     * @return false if the index is invalid
+     */
+    bool editLane(int index, const std::function<void(AutomationLane&)>& edit);
+
+    /**
+     * @brief Copy of a lane, e.g. for export
+     */
+    AutomationLane getLane(int index) const;
+
+    /**
+     * @brief Write lane values to a store (parameters are matched by ID)
+     */
+    void bindStore(ParameterStore* store);
+
+    /**
+     * @brief Allocate lane buffers for blocks of up to maxBlockSize frames
+     *
+     * Larger blocks passed to process() are rendered in maxBlockSize chunks;
+     * getLaneBuffer() then holds the last chunk.
+     */
+    void prepare(int maxBlockSize);
+
+    void setSampleRate(int sampleRate);
+    int getSampleRate() const { return sampleRate_; }
+
+    //--------------------------------------------------------------------------
+    // Recording (MIDI or UI thread)
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Arm a lane and start a take at a beat
+     *
+     * @param tolerance Thinning tolerance as a fraction of the lane range
+     */
+    bool startRecording(int index, double beat, float tolerance = 0.002f);
+
+    /**
+     * @brief Record a change on an armed lane
+     *
+     * A change earlier than the last one (the transport looped or was
+     * located) punches in the take so far and starts a new one.
+     */
+    bool recordValue(int index, double beat, float value);
+
+    /**
+     * @brief Punch the take into the lane and resume its playback
+     */
+    bool stopRecording(int index, double beat);
+
+    bool isRecording(int index) const;
+
+    //--------------------------------------------------------------------------
+    // Audio thread
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Render every playing lane for a block
+     *
+     * @param startBeat Beat position of the block's first sample
+     * @param tempo Beats per minute
+     * @param numFrames Block length
+     */
+    void process(double startBeat, double tempo, int numFrames);
+
+    /**
+     * @brief Render a block at the sequencer's current position and tempo
+     */
+    void process(const Sequencer& sequencer, int numFrames);
+
+    /**
+     * @brief Per-sample values of a lane for the last rendered chunk
+     * @return nullptr if the lane was not rendered (empty, recording or invalid)
+     */
+    const float* getLaneBuffer(int index) const;
+
+    /**
+     * @brief Lane value at the end of the last rendered chunk
+     */
+    float getLaneValue(int index) const;
+
+    // Chunks held because an edit had the lane mutex, for profiling
+    uint64_t getSkippedBlocks() const { return skippedBlocks_; }
+
+private:
+    struct Slot {
+        AutomationLane lane;
+        int storeIndex = -1;
+
+        std::vector<float> buffer;
+        float value = 0.0f;
+        bool rendered = false;
+
+        std::atomic<bool> recording{false};
+        std::mutex recordMutex;
+        AutomationRecorder recorder;
+    };
+
+    void processChunk(double startBeat, double beatsPerSample, int numFrames);
+    bool isValidLane(int index) const;
+
+    // Slots are never moved, so the atomics and mutexes stay put
+    std::vector<std::unique_ptr<Slot>> slots_;
+    mutable std::mutex laneMutex_;
+
+    ParameterStore* store_ = nullptr;
+    int sampleRate_;
+    int maxBlockSize_;
+    uint64_t skippedBlocks_ = 0;
+};
+
+} // namespace AIMusicHardware
@@ -7,6 +7,8 @@
 
 namespace AIMusicHardware {
 
+class AutomationLane;
+
 // Simple class for MIDI file export
 class MidiFile {
 public:
@@ -19,6 +21,10 @@ public:
     // Export multiple patterns as separate tracks in a MIDI file
     bool exportPatterns(const std::vector<Pattern*>& patterns, const std::string& filename, double tempo = 120.0);
     
+    // Export patterns plus automation lanes, each lane with a MIDI controller as a CC track
+    bool exportPatterns(const std::vector<Pattern*>& patterns, const std::vector<const AutomationLane*>& lanes,
+                        const std::string& filename, double tempo = 120.0);
+    
 private:
     // MIDI file writing utilities
     void writeHeader(std::ofstream& file, uint16_t format, uint16_t numTracks, uint16_t ticksPerQuarterNote);
@@ -27,9 +33,14 @@ private:
     void writeEvent(std::ofstream& file, uint32_t deltaTime, uint8_t eventType, uint8_t data1, uint8_t data2);
     void writeMetaEvent(std::ofstream& file, uint32_t deltaTime, uint8_t metaType, const std::vector<uint8_t>& data);
     void writeVarLen(std::ofstream& file, uint32_t value);
+    void writeAutomationTrack(std::ofstream& file, const AutomationLane& lane);
+    
+    // Fill in the length of the track whose header starts at trackStartPos
+    void patchTrackLength(std::ofstream& file, long trackStartPos);
     
     // Constants for MIDI file format
     static constexpr uint16_t PPQN = 480; // Pulses (ticks) per quarter note
+    static constexpr uint32_t AUTOMATION_TICKS = PPQN / 48; // Tick spacing of CCs along a ramp
 };
 
 } // namespace AIMusicHardware
\ No newline at end of file
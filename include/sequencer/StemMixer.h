@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AdaptiveSequencer.h"
+#include "../synthesis/multitimbral/MultiTimbralEngine.h"
+
+namespace AIMusicHardware {
+
+/**
+ * @brief Renders TrackLayers as stems and mixes them with per-stem gain ramps
+ *
+ * Each layer is bound to one MultiTimbralEngine channel and renders into its
+ * own stem buffer. Mix snapshots become linear gain ramps that start at an
+ * exact sample offset, so vertical remixes and crossfades line up with the
+ * sequencer clock. A stem whose gain is and stays at zero, or whose channel
+ * has no sounding voices, is not rendered at all, so the cost of a scene
+ * follows the number of audible layers rather than the number of bound ones.
+ *
+ * A skipped channel's voices do not advance while skipped; they resume where
+ * they stopped when the stem becomes audible again.
+ *
+ * Not thread-safe. Bind layers and call prepare() before audio starts; call
+ * applySnapshot() and process() from the audio thread, e.g. from an
+ * AdaptiveSequencer listener fired inside processBlock().
+ */
+class StemMixer {
+public:
+    StemMixer(int sampleRate = 44100);
+    ~StemMixer();
+
+    /**
+     * @brief Bind a layer to an engine channel
+     *
+     * The stem starts at the layer's own volume (0 if muted). Each engine
+     * channel can back one stem only, so scenes with more than 16 layers
+     * spread across several engines.
+     *
+     * @return Stem index, or -1 if the layer, engine or channel is invalid or
+     *         the channel is already bound
+     */
+    int bindLayer(std::shared_ptr<TrackLayer> layer, MultiTimbralEngine* engine, int channel);
+
+    /**
+     * @brief Remove all stems
+     */
+    void clear();
+
+    int getStemCount() const;
+    int findStem(const std::string& layerName) const;
+
+    /**
+     * @brief Allocate stem buffers for blocks of up to maxBlockSize frames
+     *
+     * Larger blocks passed to process() are rendered in maxBlockSize chunks.
+     */
+    void prepare(int maxBlockSize);
+
+    void setSampleRate(int sampleRate);
+    int getSampleRate() const;
+
+    /**
+     * @brief Ramp every stem to the gains described by a snapshot
+     *
+     * Target gain is the layer volume times the snapshot volume; layers
+     * muted in either place go to zero, and while any bound layer is soloed
+     * the others go to zero too.
+     *
+     * @param snapshot Mix to move to
+     * @param rampSeconds Ramp length; 0 jumps at the start offset
+     * @param startOffset Frames into the next process() call at which the
+     *        ramp starts; earlier ramps continue until then
+     */
+    void applySnapshot(const MixSnapshot& snapshot, double rampSeconds, int startOffset = 0);
+
+    /**
+     * @brief Ramp a single stem to a gain
+     */
+    void setStemGain(int index, float gain, double rampSeconds, int startOffset = 0);
+
+    /**
+     * @brief Render audible stems and sum them into a stereo interleaved buffer
+     *
+     * @param outputBuffer numFrames * 2 samples, overwritten
+     * @param numFrames Number of frames to render
+     */
+    void process(float* outputBuffer, int numFrames);
+
+    float getStemGain(int index) const;
+    float getStemTargetGain(int index) const;
+    bool isStemRamping(int index) const;
+
+    /**
+     * @brief Gain-applied output of a stem for the last rendered chunk
+     *
+     * @return Stereo interleaved samples, or nullptr if the stem was skipped
+     */
+    const float* getStemBuffer(int index) const;
+
+    // Stems rendered and skipped in the last rendered chunk
+    int getRenderedStemCount() const { return renderedStems_; }
+    int getSkippedStemCount() const { return static_cast<int>(stems_.size()) - renderedStems_; }
+
+    // Totals over all chunks since construction, for profiling
+    uint64_t getTotalRenderedStems() const { return totalRenderedStems_; }
+    uint64_t getTotalSkippedStems() const { return totalSkippedStems_; }
+
+private:
+    struct Stem {
+        std::shared_ptr<TrackLayer> layer;
+        MultiTimbralEngine* engine = nullptr;
+        int channel = 0;
+
+        // Current gain and the ramp running towards target
+        float gain = 0.0f;
+        float target = 0.0f;
+        float rampStart = 0.0f;
+        float rampStep = 0.0f;
+        int rampLength = 0;
+        int rampPosition = 0;
+
+        // Ramp waiting for its start offset (pendingDelay < 0 means none)
+        float pendingTarget = 0.0f;
+        int pendingLength = 0;
+        int pendingDelay = -1;
+
+        bool rendered = false;
+        std::vector<float> buffer;
+    };
+
+    // Schedule a ramp from whatever the gain is at startOffset
+    void scheduleRamp(Stem& stem, float target, double rampSeconds, int startOffset);
+    void startRamp(Stem& stem, float target, int length);
+
+    // True when the stem cannot be heard at any point of the next numFrames
+    bool isGainSilent(const Stem& stem, int numFrames) const;
+
+    // Advance the gain state by numFrames, scaling buffer if given
+    void applyGain(Stem& stem, float* buffer, int numFrames);
+
+    void processChunk(float* outputBuffer, int numFrames);
+
+    bool isValidStem(int index) const;
+
+    std::vector<Stem> stems_;
+    int sampleRate_;
+    int maxBlockSize_;
+
+    int renderedStems_ = 0;
+    uint64_t totalRenderedStems_ = 0;
+    uint64_t totalSkippedStems_ = 0;
+};
+
+} // namespace AIMusicHardware
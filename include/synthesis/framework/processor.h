@@ -76,6 +76,7 @@ public:
     
 private:
     std::vector<std::unique_ptr<Processor>> processors_;
+    std::vector<const char*> traceNames_; // Interned processor names, for trace events
     std::vector<float> tempBuffer_;
 };
 
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace AIMusicHardware {
+
+/**
+ * Block-rate ramps for every smoothed parameter of a processor.
+ *
+ * Parameters live in structure-of-arrays form and are advanced once per
+ * audio block, four at a time with SSE2/NEON (scalar elsewhere). Each
+ * ramp has an exact length in samples: the value at the end of a block is
+ * the value the per-sample ramp would have there, and the target is hit
+ * exactly on the ramp's last sample. Linear ramps suit levels and
+ * positions; exponential ramps suit times and frequencies, and fall back to
+ * linear when either end is zero or the signs differ.
+ *
+ * An active-set bitmap tracks which parameters are still moving; groups of
+ * four with nothing moving are skipped, so a block with no ramps costs a
+ * scan of a few words.
+ *
+ * setTarget() may be called from any thread; the ramp starts at the next
+ * process(). Everything else belongs to the audio thread (or to setup,
+ * before audio starts). Nothing allocates after construction.
+ */
+class SmoothingEngine {
+public:
+    enum class RampType {
+        Linear,
+        Exponential
+    };
+
+    SmoothingEngine(int sampleRate = 44100, int maxParameters = 64);
+    ~SmoothingEngine();
+
+    // Setup
+    int addParameter(float initialValue, RampType type = RampType::Linear, float rampSeconds = 0.02f);
+    int getParameterCount() const { return count_; }
+    void setRampTime(int index, float seconds);
+    void setSampleRate(int sampleRate);
+
+    // Request a ramp to value (any thread; latest request wins)
+    void setTarget(int index, float value);
+    float getTarget(int index) const;
+
+    // Jump without ramping (audio thread)
+    void setImmediate(int index, float value);
+
+    // Advance every moving parameter by one block (audio thread)
+    void process(int numFrames);
+
+    // Value at the end and start of the last processed block
+    float getValue(int index) const { return current_[static_cast<size_t>(index)]; }
+    float getBlockStartValue(int index) const;
+    bool hasChanged(int index) const { return getBlockStartValue(index) != getValue(index); }
+
+    bool isSmoothing(int index) const;
+    int getActiveCount() const;
+
+    // Per-sample values across the last block, interpolated from its start to end
+    void fillRamp(int index, float* output, int numFrames) const;
+
+private:
+    void startRamp(int index, float target);
+    void updateBlockFactors(int index);
+
+    // Advance parameters base..base+3; returns a 4-bit mask of ramps that finished
+    int processGroup(int base, int numFrames);
+
+    int sampleRate_;
+    int capacity_;
+    int count_ = 0;
+    int blockSize_ = 0;
+    uint32_t blockCounter_ = 0;
+
+    // Per parameter
+    std::vector<float> current_;
+    std::vector<float> target_;
+    std::vector<float> blockStart_;
+    std::vector<float> linearStep_;   // Per-sample increment (linear ramps)
+    std::vector<float> logStep_;      // Per-sample log ratio (exponential ramps)
+    std::vector<float> blockMul_;     // next = current * blockMul + blockAdd
+    std::vector<float> blockAdd_;
+    std::vector<int32_t> remaining_;  // Samples left in the ramp
+    std::vector<int32_t> rampSamples_;
+    std::vector<RampType> types_;
+
+    // Block in which each group of four was last advanced
+    std::vector<uint32_t> groupStamp_;
+
+    // One bit per parameter: ramping, and target posted but not yet started
+    std::vector<uint64_t> active_;
+    std::unique_ptr<std::atomic<uint64_t>[]> pending_;
+    std::unique_ptr<std::atomic<float>[]> requested_;
+};
+
+} // namespace AIMusicHardware
@@ -275,6 +275,29 @@ public:
      */
     void process(float* outputBuffer, int numFrames);
     
+    /**
+     * Check whether a channel has voices that are still sounding
+     * 
+     * @param channel MIDI channel (0-15)
+     * @return true if the channel is active and has playing or releasing voices
+     */
+    bool isChannelSounding(int channel) const;
+    
+    /**
+     * Render one channel on its own, without channel volume, pan or master gain
+     * 
+     * Used by stem mixers that apply their own gain per channel. Silent or
+     * inactive channels are not rendered and the buffer is left untouched.
+     * Call from the audio thread only, and not for channels that process()
+     * also renders in the same block.
+     * 
+     * @param channel MIDI channel (0-15)
+     * @param buffer Stereo interleaved buffer of numFrames * 2 samples
+     * @param numFrames Number of audio frames to render
+     * @return true if the channel was rendered into the buffer
+     */
+    bool renderChannel(int channel, float* buffer, int numFrames);
+    
     /**
      * Set the audio sample rate
      * 
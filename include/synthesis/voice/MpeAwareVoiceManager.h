@@ -4,8 +4,10 @@
 #include "MpeVoice.h"
 #include "../../../include/midi/MpeConfiguration.h"
 #include "../../../include/midi/MpeChannelAllocator.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <unordered_map>
 #include <mutex>
 
 namespace AIMusicHardware {
@@ -17,9 +19,25 @@ namespace AIMusicHardware {
  * Extends the standard VoiceManager with MPE capabilities, handling the three
  * expression dimensions (pitch bend, timbre/CC74, pressure) on a per-note basis
  * and managing voice allocation according to MPE rules.
+ *
+ * Each member channel maps straight to its voice through a fixed slot table,
+ * so expression lookups are a single array read. The update*() methods apply
+ * immediately under the same lock as note on/off. A single MIDI input thread
+ * can instead use queueNoteExpression(), which is wait-free and drained once
+ * per process() call with only the latest value per channel and dimension
+ * applied.
  */
 class MpeAwareVoiceManager : public VoiceManager {
 public:
+    /**
+     * @brief Expression dimension carried by a queued update
+     */
+    enum class ExpressionDimension : uint8_t {
+        PitchBend,  // -1.0 to 1.0, scaled by the zone's pitch bend range
+        Timbre,     // 0.0 to 1.0
+        Pressure    // 0.0 to 1.0
+    };
+
     /**
      * @brief Constructor
      *
@@ -32,7 +50,7 @@ public:
     /**
      * @brief Destructor
      */
-    ~MpeAwareVoiceManager();
+    ~MpeAwareVoiceManager() override;
 
     /**
      * @brief Specialized note on handling for MPE with expression values
@@ -54,7 +72,7 @@ public:
      * @param velocity Note velocity (0.0 to 1.0)
      * @param channel MIDI channel
      */
-    void noteOn(int midiNote, float velocity, int channel = 0);
+    void noteOn(int midiNote, float velocity, int channel = 0) override;
 
     /**
      * @brief Override standard note off to handle MPE channels properly
@@ -62,7 +80,7 @@ public:
      * @param midiNote MIDI note number
      * @param channel MIDI channel
      */
-    void noteOff(int midiNote, int channel = 0);
+    void noteOff(int midiNote, int channel = 0) override;
 
     /**
      * @brief Update pitch bend for a specific MPE channel
@@ -98,6 +116,36 @@ public:
      */
     void updateNoteExpression(int channel, float pitchBend, float timbre, float pressure);
 
+    /**
+     * @brief Queue an expression update from a non-audio thread
+     *
+     * Wait-free; a single producer thread is supported.
+     *
+     * @param channel MPE member channel
+     * @param dimension Which expression value to set
+     * @param value New value in the dimension's range
+     * @return false if the queue is full and the update was dropped
+     */
+    bool queueNoteExpression(int channel, ExpressionDimension dimension, float value);
+
+    /**
+     * @brief Apply queued expression updates (audio thread)
+     *
+     * Called by process(); only the most recent value per channel and
+     * dimension is applied.
+     *
+     * @return Number of voice updates applied after coalescing
+     */
+    int applyQueuedExpression();
+
+    /**
+     * @brief Apply queued expression, then render all voices
+     *
+     * @param buffer Interleaved stereo output buffer
+     * @param numFrames Number of frames to process
+     */
+    void process(float* buffer, int numFrames) override;
+
     /**
      * @brief Set the MPE configuration reference
      *
@@ -127,20 +175,38 @@ protected:
      *
      * @return A new MPE voice
      */
-    std::unique_ptr<Voice> createVoice();
+    std::unique_ptr<Voice> createVoice() override;
 
 private:
     // Reference to MPE configuration
     const MpeConfiguration* mpeConfig_;
 
-    // Channel to voice mapping for quick lookups
-    std::unordered_map<int, MpeVoice*> channelToVoiceMap_;
+    // Channel to voice slots, indexed by MIDI channel (1-16 in MPE zones)
+    static constexpr int kChannelSlots = 17;
+    static constexpr int kNumDimensions = 3;
+    std::array<MpeVoice*, kChannelSlots> channelVoices_{};
+
+    // Expression queue from the MIDI/UI thread to the audio thread
+    struct QueuedExpression {
+        uint8_t channel;
+        uint8_t dimension;
+        float value;
+    };
+    static constexpr size_t kExpressionQueueSize = 1024;  // Power of two
+    std::array<QueuedExpression, kExpressionQueueSize> expressionQueue_;
+    alignas(64) std::atomic<size_t> expressionWrite_{0};
+    alignas(64) std::atomic<size_t> expressionRead_{0};
+
+    // Coalescing scratch used while draining the queue
+    std::array<std::array<float, kNumDimensions>, kChannelSlots> pendingExpression_;
+    std::array<uint8_t, kChannelSlots> pendingMask_{};
 
     // Pitch bend range for each zone
     float lowerZonePitchBendRange_ = 48.0f;  // Default ±48 semitones for MPE
     float upperZonePitchBendRange_ = 48.0f;
 
-    // Thread safety
+    // Guards note on/off, direct expression updates and configuration;
+    // queued expression does not lock
     std::mutex mpeMutex_;
 
     // Helper to determine if a channel is an MPE master channel
@@ -157,6 +223,9 @@ private:
 
     // Helper for safer casting
     MpeVoice* castToMpeVoice(Voice* voice);
+
+    // Convert normalized pitch bend to semitones for the channel's zone
+    float pitchBendToSemitones(int channel, float pitchBend) const;
 };
 
 } // namespace AIMusicHardware
\ No newline at end of file
@@ -141,6 +141,16 @@ public:
      */
     void setSampleRate(int sampleRate) override;
     
+    /**
+     * @brief Set render quality
+     * 
+     * Applies oversampling to every oscillator in the stack and limits how
+     * many of them are rendered; the unison configuration is kept.
+     * 
+     * @param quality Render quality
+     */
+    void setRenderQuality(const RenderQuality& quality) override;
+    
 protected:
     /**
      * @brief Update the base frequency
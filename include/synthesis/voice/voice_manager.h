@@ -1,8 +1,10 @@
 #pragma once
 
+#include <array>
+#include <bitset>
+#include <cstdint>
 #include <vector>
 #include <memory>
-#include <unordered_map>
 #include "../wavetable/wavetable.h"  // For Wavetable class
 
 namespace AIMusicHardware {
@@ -12,8 +14,23 @@ class Voice;
 class WavetableOscillator;
 class ModEnvelope;
 
+/**
+ * How much work voices spend per sample. Full quality by default; a load
+ * governor lowers it while the audio callback nears its deadline.
+ */
+struct RenderQuality {
+    bool oversampling = true;     // Oscillator oversampling
+    int maxUnison = 8;            // Oscillators rendered per stacked voice
+    float releaseCutoff = 0.0f;   // Free released voices below this amplitude (0 = let them finish)
+};
+
 /**
  * Voice allocation and management system.
+ *
+ * Note bookkeeping lives in fixed tables (voice per channel and note, sustain
+ * bitsets, an intrusive LRU list for stealing), so note on/off, controllers
+ * and stealing never allocate or hash. Channels outside 0-16 and notes
+ * outside 0-127 are ignored.
  */
 class VoiceManager {
 public:
@@ -24,11 +41,11 @@ public:
     };
     
     VoiceManager(int sampleRate = 44100, int maxVoices = 16);
-    ~VoiceManager();
+    virtual ~VoiceManager();
     
     // Voice control
-    void noteOn(int midiNote, float velocity, int channel = 0);
-    void noteOff(int midiNote, int channel = 0);
+    virtual void noteOn(int midiNote, float velocity, int channel = 0);
+    virtual void noteOff(int midiNote, int channel = 0);
     void allNotesOff(int channel = -1); // -1 for all channels
     
     // MIDI-specific control methods
@@ -40,14 +57,21 @@ public:
     void resetAllControllers();
     
     // Voice processing
-    void process(float* buffer, int numFrames);
+    virtual void process(float* buffer, int numFrames);
     
     // Voice allocation settings
     void setMaxVoices(int maxVoices);
     int getMaxVoices() const { return maxVoices_; }
+    int getActiveVoiceCount() const;  // Voices still producing sound, including releases
     void setStealMode(StealMode mode) { stealMode_ = mode; }
     StealMode getStealMode() const { return stealMode_; }
     
+    // Render quality for every voice; does not allocate, so the audio thread
+    // may change it between blocks. With a release cutoff set, quiet released
+    // voices are freed early and are the first to be stolen.
+    void setRenderQuality(const RenderQuality& quality);
+    const RenderQuality& getRenderQuality() const { return renderQuality_; }
+    
     // Sample rate control
     virtual void setSampleRate(int sampleRate);
     int getSampleRate() const { return sampleRate_; }
@@ -68,8 +92,16 @@ public:
     }
     
 private:
-    // Find voice to steal based on current policy
-    Voice* findVoiceToSteal();
+    // Channels 0-15, plus 16 because MPE zone channels are numbered 1-16
+    static constexpr int kMaxChannels = 17;
+    static constexpr int kNumNotes = 128;
+    static constexpr int16_t kNoVoice = -1;
+
+    // Find voice to steal based on current policy (index into voices_, -1 if none)
+    int findVoiceToSteal();
+    
+    // Quietest voice in its release stage, -1 if none
+    int findReleasedVoiceToSteal() const;
     
     // Find existing voice for a note
     Voice* findVoiceForNote(int midiNote, int channel = 0);
@@ -77,17 +109,43 @@ private:
     // Create a new voice instance
     virtual std::unique_ptr<Voice> createVoice();
 
+    // Note table helpers
+    static bool isValidKey(int midiNote, int channel) {
+        return midiNote >= 0 && midiNote < kNumNotes && channel >= 0 && channel < kMaxChannels;
+    }
+    int findVoiceIndexForNote(int midiNote, int channel) const;
+    void releaseNote(int midiNote, int channel);
+
+    // Move a voice to the most recently used end of the LRU list
+    void touchVoice(int index);
+
+    // Rebuild the LRU list and note table after voices_ changes size
+    void rebuildVoiceTables();
+
+    // Per-engine xorshift generator for StealMode::Random
+    uint32_t nextRandom();
+
 protected:
     // Voice management (made protected for derived classes)
     std::vector<std::unique_ptr<Voice>> voices_;
 
 private:
-    std::unordered_map<int, Voice*> activeNotes_; // Maps MIDI note to active voice
+    // Voice index playing each (channel, note), kNoVoice if none. Entries can
+    // go stale when a voice finishes or is stolen; lookups validate them.
+    std::array<std::array<int16_t, kNumNotes>, kMaxChannels> noteVoices_;
+
+    // Voices ordered by note on, least recent at the head
+    std::vector<int16_t> lruPrev_;
+    std::vector<int16_t> lruNext_;
+    int lruHead_ = kNoVoice;
+    int lruTail_ = kNoVoice;
     
     // Basic settings
     int sampleRate_;
     int maxVoices_;
     StealMode stealMode_;
+    uint32_t randomState_ = 0x9E3779B9u;
+    RenderQuality renderQuality_;
     
     // Shared resources for all voices
     std::shared_ptr<Wavetable> currentWavetable_;
@@ -97,11 +155,11 @@ private:
         bool sustainPedalDown = false;
         float pitchBendValue = 0.0f;        // -1.0 to 1.0
         float channelPressure = 0.0f;       // 0.0 to 1.0
-        std::unordered_map<int, bool> sustainedNotes;  // Notes held by sustain
-        std::unordered_map<int, float> noteAftertouch;  // Per-note aftertouch
+        std::bitset<kNumNotes> sustainedNotes;        // Notes held by sustain
+        std::array<float, kNumNotes> noteAftertouch{};  // Per-note aftertouch
     };
     
-    std::unordered_map<int, ChannelState> channelStates_;  // Maps channel to state
+    std::array<ChannelState, kMaxChannels> channelStates_;  // Indexed by channel
     
     // Pitch bend settings
     float pitchBendRange_ = 2.0f;  // Default +/- 2 semitones
@@ -162,6 +220,9 @@ public:
     
     // Sample rate control
     virtual void setSampleRate(int sampleRate);
+    
+    // Render quality (oscillator oversampling, unison for stacked voices)
+    virtual void setRenderQuality(const RenderQuality& quality);
 
 protected:
     // Voice components that derived classes might need access to
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "wavetable.h"
+#include <array>
 #include <vector>
 #include <memory>
 #include <functional>
@@ -24,6 +25,8 @@ struct OscillatorConfig {
  */
 class OscillatorStack {
 public:
+    static constexpr int kMaxOscillators = 8;
+    
     /**
      * @brief Construct a new Oscillator Stack
      * 
@@ -51,6 +54,32 @@ public:
      */
     int getOscillatorCount() const { return static_cast<int>(oscillators_.size()); }
     
+    /**
+     * @brief Limit how many oscillators are rendered
+     * 
+     * Renders an evenly spread subset that keeps both detune extremes, so a
+     * reduced stack keeps its pitch centre and width. The configured count
+     * and settings are kept; raising the limit brings the others back.
+     * Does not allocate, so it can be changed from the audio thread.
+     * 
+     * @param limit Maximum number of oscillators rendered (1-8)
+     */
+    void setUnisonLimit(int limit);
+    int getUnisonLimit() const { return unisonLimit_; }
+    
+    /**
+     * @brief Get the number of oscillators currently rendered
+     */
+    int getRenderedOscillatorCount() const { return numRendered_; }
+    
+    /**
+     * @brief Enable or disable oversampling on every oscillator
+     * 
+     * @param enabled Whether oscillators oversample (default: true)
+     */
+    void setOversampling(bool enabled);
+    bool isOversampling() const { return oversampling_; }
+    
     /**
      * @brief Set the base frequency for all oscillators
      * 
@@ -207,6 +236,9 @@ private:
     
     // Create a new oscillator with default settings
     std::unique_ptr<WavetableOscillator> createOscillator();
+    
+    // Pick the oscillators rendered under the unison limit
+    void updateRenderedOscillators();
 
     std::vector<std::unique_ptr<WavetableOscillator>> oscillators_;
     std::vector<OscillatorConfig> configs_;
@@ -214,6 +246,12 @@ private:
     float baseFrequency_ = 440.0f;
     int sampleRate_ = 44100;
     std::shared_ptr<Wavetable> wavetable_;
+    
+    // Indices of the oscillators rendered, in order
+    std::array<int, kMaxOscillators> rendered_{};
+    int numRendered_ = 0;
+    int unisonLimit_ = kMaxOscillators;
+    bool oversampling_ = true;
 };
 
 } // namespace AIMusicHardware
\ No newline at end of file
@@ -85,6 +85,10 @@ public:
     // Set sample rate
     void setSampleRate(int sampleRate);
     
+    // 2x oversampling, on by default; turning it off halves the cost per sample
+    void setOversampling(bool enabled) { oversample_ = enabled; }
+    bool isOversampling() const { return oversample_; }
+    
 private:
     std::shared_ptr<Wavetable> wavetable_;
     float frequency_;
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <memory>
+#include <algorithm>
 #include <cstdint>
 #include <string>
 
@@ -54,11 +55,79 @@ struct Rect {
         return !(x + width <= other.x || other.x + other.width <= x ||
                  y + height <= other.y || other.y + other.height <= y);
     }
+    
+    bool isEmpty() const { return width <= 0 || height <= 0; }
+    int area() const { return isEmpty() ? 0 : width * height; }
+    
+    // Smallest rectangle containing both (empty rectangles are ignored)
+    Rect united(const Rect& other) const {
+        if (isEmpty()) return other;
+        if (other.isEmpty()) return *this;
+        int x1 = std::min(x, other.x);
+        int y1 = std::min(y, other.y);
+        int x2 = std::max(x + width, other.x + other.width);
+        int y2 = std::max(y + height, other.y + other.height);
+        return Rect(x1, y1, x2 - x1, y2 - y1);
+    }
+    
+    // Overlapping part of both (empty if they do not intersect)
+    Rect intersected(const Rect& other) const {
+        int x1 = std::max(x, other.x);
+        int y1 = std::max(y, other.y);
+        int x2 = std::min(x + width, other.x + other.width);
+        int y2 = std::min(y + height, other.y + other.height);
+        if (x2 <= x1 || y2 <= y1) return Rect();
+        return Rect(x1, y1, x2 - x1, y2 - y1);
+    }
 };
 
 // Forward declaration
 class Font;
 
+// Primitives recorded for submission to a DisplayManager in one call.
+// Reusing a batch across frames keeps its storage, so recording does not
+// allocate once it has warmed up.
+class DrawBatch {
+public:
+    enum class Type : uint8_t {
+        FillRect,
+        DrawRect,
+        FillCircle,
+        DrawCircle,
+        Line,
+        Text
+    };
+    
+    struct Command {
+        Type type;
+        int x, y;
+        int x2, y2;         // width/height for rects, radius in x2 for circles, end point for lines
+        Color color;
+        Font* font;         // Text only
+        size_t textIndex;   // Text only
+    };
+    
+    void fillRect(int x, int y, int width, int height, const Color& color);
+    void drawRect(int x, int y, int width, int height, const Color& color);
+    void fillCircle(int x, int y, int radius, const Color& color);
+    void drawCircle(int x, int y, int radius, const Color& color);
+    void drawLine(int x1, int y1, int x2, int y2, const Color& color);
+    void drawText(int x, int y, const std::string& text, Font* font, const Color& color);
+    
+    // Drop all commands but keep allocated storage
+    void clear();
+    
+    size_t size() const { return commands_.size(); }
+    bool empty() const { return commands_.empty(); }
+    const std::vector<Command>& getCommands() const { return commands_; }
+    const std::string& getText(const Command& command) const { return texts_[command.textIndex]; }
+    
+private:
+    std::vector<Command> commands_;
+    std::vector<std::string> texts_;  // grows only; entries reused after clear()
+    size_t textCount_ = 0;
+};
+
 // DisplayManager class - abstraction for framebuffer access
 class DisplayManager {
 public:
@@ -87,6 +156,11 @@ public:
     // Text rendering (will work with Font class)
     virtual void drawText(int x, int y, const std::string& text, Font* font, const Color& color);
     
+    // Draw a recorded batch. The default culls each command against the
+    // clip once and then draws it through the primitives above; backends
+    // that can batch natively may override this.
+    virtual void submit(const DrawBatch& batch);
+    
     // Blending modes
     enum class BlendMode {
         None,       // Overwrite destination
@@ -107,6 +181,28 @@ public:
     virtual void clearClipRect();
     virtual Rect getClipRect() const;
     
+    // True if any part of rect survives the current clip (cheap reject test)
+    bool intersectsClip(const Rect& rect) const;
+    
+    // Damage tracking
+    //
+    // When enabled, callers report changed screen areas with addDamage(),
+    // draw each damage region between beginDamageRegion()/endDamageRegion()
+    // (which clips every primitive to it), and swapBuffers() presents only
+    // those regions instead of flipping the whole frame. The back buffer
+    // then always holds the complete current frame.
+    virtual void setDamageTracking(bool enabled);
+    bool isDamageTracking() const { return damageTracking_; }
+    void addDamage(const Rect& rect);
+    void addFullDamage();
+    void clearDamage();
+    bool hasDamage() const { return !damageRegions_.empty(); }
+    const std::vector<Rect>& getDamageRegions() const { return damageRegions_; }
+    
+    // Restrict drawing to one damage region; setClipRect() intersects with it
+    void beginDamageRegion(const Rect& rect);
+    void endDamageRegion();
+    
     // Utility
     virtual int getWidth() const { return width_; }
     virtual int getHeight() const { return height_; }
@@ -114,7 +210,16 @@ public:
     // Direct access to framebuffer (use with care)
     uint8_t* getFramebuffer();
     
+protected:
+    // Push one changed region of the back buffer to the display. The default
+    // copies it into the front buffer; panel drivers override this to send
+    // just that window over the bus.
+    virtual void presentRegion(const Rect& rect);
+    
 private:
+    // Damage list is merged down to this many regions at most
+    static constexpr size_t kMaxDamageRegions = 16;
+    
     int width_;
     int height_;
     int bytesPerPixel_;
@@ -123,11 +228,22 @@ private:
     Rect clipRect_;
     bool hasClipRect_;
     
+    bool damageTracking_;
+    std::vector<Rect> damageRegions_;
+    Rect damageClip_;
+    bool hasDamageClip_;
+    
     std::vector<uint8_t> frontBuffer_;
     std::vector<uint8_t> backBuffer_;
     
+    // Scratch row extents for fillCircle
+    std::vector<int> circleSpans_;
+    
     // Utility functions
     void blendPixel(int x, int y, const Color& color);
+    void fillSpan(int y, int x1, int x2, const Color& color);   // [x1, x2) on row y, clipped here
+    void applySpan(uint8_t* dst, int count, const Color& color); // no clipping
+    Rect drawableArea() const;
     bool isInClipRect(int x, int y) const;
     void fillFlatBottomTriangle(int x1, int y1, int x2, int y2, int x3, int y3, const Color& color);
     void fillFlatTopTriangle(int x1, int y1, int x2, int y2, int x3, int y3, const Color& color);
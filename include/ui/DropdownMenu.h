@@ -32,6 +32,7 @@ public:
     void update(float deltaTime) override;
     void render(DisplayManager* display) override;
     bool handleInput(const InputEvent& event) override;
+    Rect getPaintBounds() const override;
     
     // Special rendering for dropdown list (to be called after all other components)
     void renderDropdownList(DisplayManager* display);
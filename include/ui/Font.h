@@ -22,6 +22,29 @@ struct Glyph {
     std::vector<uint8_t> bitmap; // Bitmap data (one byte per pixel, 0-255 alpha)
 };
 
+// Glyph as stored in a font's coverage atlas
+struct AtlasGlyph {
+    int atlasX;            // Position of the bitmap inside the atlas
+    int atlasY;
+    int width;
+    int height;
+    int xOffset;
+    int yOffset;
+    int xAdvance;
+};
+
+// Glyph positions for one string, relative to the draw origin
+struct TextLayout {
+    struct Placement {
+        int x;
+        int y;
+        const AtlasGlyph* glyph;
+    };
+    
+    std::vector<Placement> glyphs;
+    int width = 0;
+};
+
 // Font class for text rendering
 class Font {
 public:
@@ -54,7 +77,24 @@ public:
     int getKerning(uint32_t first, uint32_t second) const;
     int getFontSize() const;
     
+    // Glyph atlas: every glyph bitmap packed into one 8-bit coverage image,
+    // rebuilt on first use after glyphs change
+    const uint8_t* getAtlasPixels() const;
+    int getAtlasWidth() const;
+    int getAtlasHeight() const;
+    
+    // Positioned glyph run for a string, cached so that redrawing the same
+    // label does no glyph lookups or kerning. The reference stays valid
+    // until the font changes or the cache is trimmed by a later call.
+    const TextLayout& layoutText(const std::string& text) const;
+    
 private:
+    // Cached layouts are dropped wholesale once this many strings are held
+    static constexpr size_t kMaxCachedLayouts = 512;
+    static constexpr int kAtlasWidth = 512;
+    
+    void buildAtlas() const;
+    
     int fontSize_;
     int lineHeight_;
     int baseline_;
@@ -63,6 +103,14 @@ private:
     std::unordered_map<uint32_t, Glyph> glyphs_;
     std::unordered_map<uint64_t, int> kerningPairs_;
     
+    // Atlas and layout cache (derived data, rebuilt lazily)
+    mutable bool atlasValid_ = false;
+    mutable std::vector<uint8_t> atlasPixels_;
+    mutable int atlasHeight_ = 0;
+    mutable std::vector<AtlasGlyph> atlasGlyphs_;
+    mutable std::unordered_map<uint32_t, size_t> atlasIndex_;
+    mutable std::unordered_map<std::string, TextLayout> layoutCache_;
+    
     // Utility function to create a 64-bit key from two 32-bit codepoints
     static uint64_t makeKerningKey(uint32_t first, uint32_t second) {
         return (static_cast<uint64_t>(first) << 32) | static_cast<uint64_t>(second);
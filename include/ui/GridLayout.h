@@ -64,6 +64,7 @@ public:
     void update(float deltaTime) override;
     void render(DisplayManager* display) override;
     bool handleInput(const InputEvent& event) override;
+    void collectDamage(DisplayManager* display) override;
     
     // Override setSize to trigger relayout
     void setSize(int width, int height) {
@@ -9,6 +9,8 @@
 
 namespace AIMusicHardware {
 
+class ParameterStore;
+
 /**
  * @brief Bridge between UI controls and synthesizer parameters
  * 
@@ -94,6 +96,19 @@ public:
      */
     void setValueFromUI(float normalized, ChangeSource source = ChangeSource::UI);
 
+    /**
+     * @brief Forward values set through setValueFromUI() to an audio-side store
+     * 
+     * Each change is pushed to the store queue for its source, so the audio
+     * thread picks it up by index without going through listeners. The
+     * caller of setValueFromUI() for a given source must be that source's
+     * only producer thread.
+     * 
+     * @param store Store to push to (nullptr to unbind)
+     * @param index Parameter index in the store
+     */
+    void bindStore(ParameterStore* store, int index);
+
     /**
      * @brief Set value from engine (actual value)
      * @param value The actual parameter value
@@ -166,6 +181,10 @@ private:
     UIComponent* control_;
     ScaleType scaleType_;
     
+    // Audio-side store fed by setValueFromUI
+    ParameterStore* store_ = nullptr;
+    int storeIndex_ = -1;
+    
     // Thread-safe value storage
     std::atomic<float> currentValue_;
     std::atomic<float> targetValue_;
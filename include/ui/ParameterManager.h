@@ -7,6 +7,7 @@
 #include <memory>
 #include <unordered_map>
 #include "ui/SmoothParameter.h"
+#include "audio/SynthParameters.h"
 
 namespace AIMusicHardware {
 
@@ -208,11 +209,18 @@ private:
     std::vector<ModulationRouting> modulations_;
     ParameterChangedCallback parameterChangedCallback_;
     
-    // Smooth parameter automation
-    std::unordered_map<std::string, SmoothParameter> smooth_parameters_;
-    std::unordered_map<std::string, bool> automation_enabled_;
+    // Smooth parameter automation. The synthesizer parameter is resolved
+    // when an entry is created, so per-change and per-buffer updates use the
+    // indexed Synthesizer::setParameter
+    struct AutomatedParameter {
+        SmoothParameter smoother;
+        int synthParameter = -1;  // SynthParamId index, -1 if the synthesizer has no such parameter
+        bool enabled = false;
+    };
+    std::unordered_map<std::string, AutomatedParameter> smooth_parameters_;
     
     // Helper methods
+    AutomatedParameter& bindParameter(const std::string& parameterId);
     void initializeDefaultParameters();
     void updateSynthesizer(const std::string& parameterId);
     bool isValidParameter(const std::string& parameterId) const;
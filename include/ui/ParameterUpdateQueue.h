@@ -1,8 +1,10 @@
 #pragma once
 
 #include "parameters/Parameter.h"
+#include "../audio/SynthParameters.h"
 #include <atomic>
 #include <array>
+#include <algorithm>
 #include <functional>
 #include <memory>
 
@@ -39,6 +41,7 @@ public:
         float value;
         ChangeSource source;
         uint64_t timestamp; // For timing analysis
+        int synthParameter = -1; // SynthParamId index resolved when the source was bound, or -1
     };
 
     ParameterUpdateQueue() : writeIndex_(0), readIndex_(0) {}
@@ -66,6 +69,29 @@ public:
         return true;
     }
 
+    /**
+     * @brief Push several updates with a single index publish (producer side)
+     * @param changes Updates to push, in order
+     * @param count Number of updates
+     * @return Number pushed; fewer than count if the queue filled up
+     */
+    size_t pushBatch(const ParameterChange* changes, size_t count) {
+        size_t currentWrite = writeIndex_.load(std::memory_order_relaxed);
+        size_t read = readIndex_.load(std::memory_order_acquire);
+        size_t used = currentWrite >= read ? currentWrite - read : Capacity - read + currentWrite;
+        size_t toPush = std::min(count, Capacity - 1 - used);
+        
+        for (size_t i = 0; i < toPush; ++i) {
+            buffer_[currentWrite] = changes[i];
+            currentWrite = (currentWrite + 1) % Capacity;
+        }
+        
+        // Consumer sees the whole batch at once
+        writeIndex_.store(currentWrite, std::memory_order_release);
+        
+        return toPush;
+    }
+
     /**
      * @brief Pop a parameter update (consumer side)
      * @param change Output parameter for the change
@@ -150,6 +176,51 @@ public:
                      ParameterUpdateQueue<>::ChangeSource source = 
                      ParameterUpdateQueue<>::ChangeSource::UI);
 
+    /**
+     * @brief Exclusive right to push batches to the audio thread
+     *
+     * Used by control-rate producers (e.g. coalesced IoT sensor values) so
+     * the audio thread sees a consistent set of changes per block. Batches
+     * travel on their own single-producer queue, so only one BatchProducer
+     * exists at a time; it releases the queue when destroyed. Pushes must
+     * not overlap, so the owner calls push() from one thread at a time.
+     */
+    class BatchProducer {
+    public:
+        BatchProducer() = default;
+        ~BatchProducer();
+        BatchProducer(BatchProducer&& other) noexcept;
+        BatchProducer& operator=(BatchProducer&& other) noexcept;
+        BatchProducer(const BatchProducer&) = delete;
+        BatchProducer& operator=(const BatchProducer&) = delete;
+
+        /**
+         * @brief Whether this handle owns the batch queue
+         */
+        explicit operator bool() const { return system_ != nullptr; }
+
+        /**
+         * @brief Push a batch of updates to the audio thread in one publish
+         * @param changes Updates to push (timestamps are kept as given)
+         * @param count Number of updates
+         * @return Number of updates queued; the rest are counted as dropped
+         */
+        size_t push(const ParameterUpdateQueue<>::ParameterChange* changes, size_t count);
+
+    private:
+        friend class ParameterUpdateSystem;
+        explicit BatchProducer(ParameterUpdateSystem* system) : system_(system) {}
+        void release();
+
+        ParameterUpdateSystem* system_ = nullptr;
+    };
+
+    /**
+     * @brief Claim the batch queue
+     * @return Owning handle, or an empty one if another producer holds the queue
+     */
+    BatchProducer acquireBatchProducer();
+
     /**
      * @brief Push update from audio thread to UI thread
      * @param id Parameter ID
@@ -208,6 +279,7 @@ private:
 
     // Queues for bidirectional communication
     ParameterUpdateQueue<> audioQueue_; // UI -> Audio
+    ParameterUpdateQueue<> batchQueue_; // Control-rate batches -> Audio
     ParameterUpdateQueue<> uiQueue_;    // Audio -> UI
     
     // Statistics
@@ -219,7 +291,10 @@ private:
     // Debug logging
     std::atomic<bool> loggingEnabled_{false};
     
+    std::atomic<bool> batchProducerHeld_{false};
+    
     // Helper methods
+    size_t pushToAudioBatch(const ParameterUpdateQueue<>::ParameterChange* changes, size_t count);
     uint64_t getCurrentTimestamp() const;
     void logUpdate(const ParameterUpdateQueue<>::ParameterChange& change, bool toAudio);
 };
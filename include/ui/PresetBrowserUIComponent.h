@@ -18,7 +18,7 @@ class PresetListItem : public UIComponent {
 public:
     PresetListItem(const std::string& id, const PresetInfo& preset, int index);
     
-    void setSelected(bool selected) { isSelected_ = selected; }
+    void setSelected(bool selected) { if (isSelected_ != selected) { isSelected_ = selected; markDirty(); } }
     bool isSelected() const { return isSelected_; }
     
     const PresetInfo& getPreset() const { return preset_; }
@@ -63,6 +63,7 @@ public:
     void update(float deltaTime) override;
     void render(DisplayManager* display) override;
     bool handleInput(const InputEvent& event) override;
+    void collectDamage(DisplayManager* display) override;
     
     // Callback when selection changes
     using SelectionCallback = std::function<void(const PresetInfo&)>;
@@ -75,8 +76,10 @@ private:
     float maxScroll_ = 0.0f;
     SelectionCallback selectionCallback_;
     
+    void layoutItems();
     void updateScrollBounds();
     void ensureSelectedVisible();
+    void discardItems();
 };
 
 /**
@@ -86,10 +89,10 @@ class PresetSearchBox : public UIComponent {
 public:
     PresetSearchBox(const std::string& id);
     
-    void setText(const std::string& text) { searchText_ = text; }
+    void setText(const std::string& text) { if (searchText_ != text) { searchText_ = text; markDirty(); } }
     const std::string& getText() const { return searchText_; }
     
-    void setPlaceholder(const std::string& placeholder) { placeholder_ = placeholder; }
+    void setPlaceholder(const std::string& placeholder) { placeholder_ = placeholder; markDirty(); }
     
     void update(float deltaTime) override;
     void render(DisplayManager* display) override;
@@ -121,6 +124,7 @@ public:
     void update(float deltaTime) override;
     void render(DisplayManager* display) override;
     bool handleInput(const InputEvent& event) override;
+    void collectDamage(DisplayManager* display) override;
     
     // Callback when category changes
     using CategoryCallback = std::function<void(const std::string&)>;
@@ -170,6 +174,7 @@ public:
     void update(float deltaTime) override;
     void render(DisplayManager* display) override;
     bool handleInput(const InputEvent& event) override;
+    void collectDamage(DisplayManager* display) override;
     
     // Override setPosition to re-layout components
     void setPosition(int x, int y) {
@@ -236,6 +241,7 @@ public:
     void update(float deltaTime) override;
     void render(DisplayManager* display) override;
     bool handleInput(const InputEvent& event) override;
+    void collectDamage(DisplayManager* display) override;
     
     // Callback when save is confirmed
     using SaveCallback = std::function<void(const std::string& name, const std::string& category, const std::string& description)>;
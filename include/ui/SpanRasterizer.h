@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+namespace AIMusicHardware {
+
+struct Color;
+
+/**
+ * @brief Horizontal span kernels for RGBA8 framebuffers
+ *
+ * DisplayManager breaks every filled primitive into horizontal spans that
+ * are already clipped, and hands each span to one of these kernels. The
+ * kernels process several pixels per instruction (SSE2 on x86-64, NEON on
+ * AArch64) and fall back to plain loops elsewhere.
+ *
+ * Alpha blending uses integer source-over with exact rounding division by
+ * 255 for opaque destination pixels, which is what a UI framebuffer holds
+ * after the first clear. Translucent destination pixels take the exact
+ * floating-point path that DisplayManager has always used.
+ */
+class SpanRasterizer {
+public:
+    /**
+     * @brief Overwrite a span with a solid color
+     * @param dst First pixel of the span (4 bytes per pixel, RGBA order)
+     * @param count Number of pixels
+     * @param color Color to write, alpha included
+     */
+    static void fill(uint8_t* dst, int count, const Color& color);
+
+    /**
+     * @brief Alpha-blend a constant color over a span
+     */
+    static void blend(uint8_t* dst, int count, const Color& color);
+
+    /**
+     * @brief Alpha-blend a color modulated by per-pixel coverage (glyphs)
+     * @param coverage One 0-255 coverage byte per pixel
+     */
+    static void blendMask(uint8_t* dst, const uint8_t* coverage, int count, const Color& color);
+
+    /**
+     * @brief Additive blend of a constant color over a span
+     */
+    static void add(uint8_t* dst, int count, const Color& color);
+
+    /**
+     * @brief Multiplicative blend of a constant color over a span
+     */
+    static void multiply(uint8_t* dst, int count, const Color& color);
+
+    /**
+     * @brief Name of the vector instruction set compiled in
+     * @return "SSE2", "NEON" or "scalar"
+     */
+    static const char* backendName();
+
+    /**
+     * @brief Portable one-pixel-at-a-time versions of the blend kernels
+     *
+     * Produce bit-identical results to the vectorized kernels; used to
+     * verify them headlessly.
+     */
+    static void blendReference(uint8_t* dst, int count, const Color& color);
+    static void blendMaskReference(uint8_t* dst, const uint8_t* coverage, int count, const Color& color);
+};
+
+} // namespace AIMusicHardware
@@ -117,6 +117,12 @@ public:
      */
     void render(DisplayManager* displayManager) override;
 
+    /**
+     * @brief Area drawn by the knob, including the value tooltip above it
+     * @return Paint bounds used for damage tracking
+     */
+    Rect getPaintBounds() const override;
+
     /**
      * @brief Reset to default value
      */
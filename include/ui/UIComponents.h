@@ -154,6 +154,7 @@ public:
     virtual void update(float deltaTime) override;
     virtual void render(DisplayManager* display) override;
     virtual bool handleInput(const InputEvent& event) override;
+    virtual Rect getPaintBounds() const override;
     
 private:
     std::string label_;
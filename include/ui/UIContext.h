@@ -53,16 +53,34 @@ public:
     
     // Basic properties
     const std::string& getId() const { return id_; }
-    void setPosition(int x, int y) { x_ = x; y_ = y; }
-    void setSize(int width, int height) { width_ = width; height_ = height; }
+    void setPosition(int x, int y) { if (x_ != x || y_ != y) { x_ = x; y_ = y; markDirty(); } }
+    void setSize(int width, int height) { if (width_ != width || height_ != height) { width_ = width; height_ = height; markDirty(); } }
     Rect getBounds() const { return Rect(x_, y_, width_, height_); }
     
+    // Area the component actually draws into. The default allows for
+    // borders and markers a couple of pixels outside the layout bounds;
+    // override when rendering extends further (e.g. labels under a knob).
+    virtual Rect getPaintBounds() const {
+        return Rect(x_ - 2, y_ - 2, width_ + 4, height_ + 4);
+    }
+    
     // Visibility and enable state
-    void setVisible(bool visible) { visible_ = visible; }
+    void setVisible(bool visible) { if (visible_ != visible) { visible_ = visible; markDirty(); } }
     bool isVisible() const { return visible_; }
-    void setEnabled(bool enabled) { enabled_ = enabled; }
+    void setEnabled(bool enabled) { if (enabled_ != enabled) { enabled_ = enabled; markDirty(); } }
     bool isEnabled() const { return enabled_; }
     
+    // Damage tracking: call markDirty() whenever something that affects
+    // render() changes. New components start dirty.
+    void markDirty() { dirty_ = true; }
+    bool isDirty() const { return dirty_; }
+    
+    // Report this component's (and its children's) changed areas to the
+    // display: both where it was last painted and where it paints now.
+    // Components that own parts outside children_ override this to
+    // report those parts as well.
+    virtual void collectDamage(DisplayManager* display);
+    
     // Core methods
     virtual void update(float deltaTime) = 0;
     virtual void render(DisplayManager* display) = 0;
@@ -79,9 +97,17 @@ protected:
     int width_, height_;
     bool visible_;
     bool enabled_;
+    bool dirty_;
+    Rect paintedBounds_;
+    Rect removedArea_;        // where removed parts were painted, reported next frame
+    bool removedUnbounded_;   // a removed part had no layout size
     std::vector<std::unique_ptr<UIComponent>> children_;
     
-    // Helper for rendering children
+    // Call before destroying a part (child or owned sub-component) so the
+    // area it was painted in is repainted
+    void discardPaintedArea(const UIComponent& removed);
+    
+    // Helper for rendering children (skips children outside the clip)
     void renderChildren(DisplayManager* display);
     
     // Helper for processing input to children
@@ -95,7 +121,7 @@ public:
     virtual ~Screen();
     
     // Screen can set its own background color
-    void setBackgroundColor(const Color& color) { backgroundColor_ = color; }
+    void setBackgroundColor(const Color& color) { backgroundColor_ = color; markDirty(); }
     const Color& getBackgroundColor() const { return backgroundColor_; }
     
     // Screen activation/deactivation
@@ -128,6 +154,10 @@ public:
     const std::string& getActiveScreenId() const { return activeScreenId_; }
     
     // Update and render
+    //
+    // When the display manager has damage tracking enabled (the default for
+    // the built-in framebuffer), render() only repaints the areas of dirty
+    // components and leaves the rest of the previous frame in place.
     void update(float deltaTime);
     void render();
     
@@ -167,10 +197,12 @@ public:
     void setDisplayManager(std::shared_ptr<DisplayManager> displayManager) {
         if (displayManager) {
             displayManager_ = displayManager;
+            renderedScreen_ = nullptr;
         }
     }
 
 private:
+    void renderDamage(Screen* activeScreen);
 
     // Display manager for drawing
     std::shared_ptr<DisplayManager> displayManager_;
@@ -178,6 +210,7 @@ private:
     // Screen management
     std::unordered_map<std::string, std::unique_ptr<Screen>> screens_;
     std::string activeScreenId_;
+    const Screen* renderedScreen_;  // screen shown by the last damage-tracked frame
     
     // Fonts
     std::unordered_map<std::string, std::unique_ptr<Font>> fonts_;
@@ -2,11 +2,13 @@
 
 #include "UIComponents.h"
 #include "../synthesis/modulators/envelope.h"
+#include "../audio/FFT.h"
 #include <vector>
-#include <deque>
+#include <memory>
 #include <cmath>
 #include <mutex>
 #include <atomic>
+#include <cstdint>
 
 namespace AIMusicHardware {
 
@@ -29,14 +31,33 @@ public:
     
     /**
      * @brief Push audio samples for visualization
-     * Thread-safe - can be called from audio thread
+     * Lock-free and wait-free for a single producer (the audio thread).
+     * Samples are written into a capture ring that the UI thread snapshots
+     * in update(); the newest samples overwrite the oldest, so the audio
+     * thread never waits on the display.
      */
     void pushSamples(const float* samples, int numSamples, int channels = 1);
     
+    /**
+     * @brief Sample rate of the pushed audio (used for log-frequency mapping)
+     */
+    void setSampleRate(float sampleRate);
+    float getSampleRate() const { return sampleRate_; }
+    
+    /**
+     * @brief Log-spaced band magnitudes of the latest spectrum (UI thread)
+     */
+    const std::vector<float>& getSpectrumBands() const { return spectrumBands_; }
+    
+    /**
+     * @brief Linear bin magnitudes of the latest spectrum (UI thread)
+     */
+    const std::vector<float>& getSpectrumBins() const { return fftMagnitudes_; }
+    
     /**
      * @brief Set display mode
      */
-    void setDisplayMode(DisplayMode mode) { displayMode_ = mode; }
+    void setDisplayMode(DisplayMode mode) { displayMode_ = mode; markDirty(); }
     DisplayMode getDisplayMode() const { return displayMode_; }
     
     /**
@@ -58,13 +79,37 @@ public:
     void render(DisplayManager* display) override;
     bool handleInput(const InputEvent& event) override;
     
+protected:
+    /**
+     * @brief Number of log-frequency bands used by spectrum and waterfall modes
+     */
+    void setSpectrumBandCount(int bands);
+    
+    // Display state shared with subclasses (UI thread only)
+    std::vector<float> spectrumBands_;
+    
 private:
-    // Audio buffer (ring buffer for thread safety)
+    // Capture ring (stereo, power-of-two frames). The audio thread is the
+    // only writer; writeCount_ counts frames ever written. Each frame is a
+    // seqlock: sequence is odd while frame n is being written and 2n + 2
+    // once it holds frame n, so the UI can tell a complete frame from one
+    // that is being overwritten.
+    struct CaptureFrame {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<float> left{0.0f};
+        std::atomic<float> right{0.0f};
+    };
+    std::unique_ptr<CaptureFrame[]> captureRing_;
+    uint32_t captureMask_;
+    std::atomic<uint64_t> writeCount_{0};
+    
+    // UI-thread snapshot of the newest bufferSize_ frames, filled through
+    // snapshotScratch_ so a failed capture keeps the previous one
     std::vector<float> audioBuffer_;
+    std::vector<float> snapshotScratch_;
+    std::vector<float> monoBuffer_;
     int bufferSize_;
-    std::atomic<int> writePos_{0};
-    std::atomic<int> readPos_{0};
-    mutable std::mutex bufferMutex_;
+    uint64_t lastSnapshotCount_ = 0;
     
     // Display settings
     DisplayMode displayMode_ = DisplayMode::Waveform;
@@ -77,12 +122,16 @@ private:
     float yScale_ = 1.0f;
     
     // FFT data for spectrum mode
+    FFT fft_;
+    LogFrequencyBands bandMapper_;
     std::vector<float> fftMagnitudes_;
-    std::vector<float> fftPhases_;
+    float sampleRate_ = 44100.0f;
     
-    // Waterfall data
-    std::deque<std::vector<float>> waterfallHistory_;
+    // Waterfall data: fixed ring of band rows, oldest row at waterfallHead_
     static constexpr int WATERFALL_HISTORY_SIZE = 100;
+    std::vector<float> waterfallRows_;
+    int waterfallHead_ = 0;
+    int waterfallCount_ = 0;
     
     // Helper methods
     void drawWaveform(DisplayManager* display);
@@ -90,7 +139,9 @@ private:
     void drawWaterfall(DisplayManager* display);
     void drawLissajous(DisplayManager* display);
     void drawGrid(DisplayManager* display);
+    bool captureSnapshot();
     void performFFT();
+    void pushWaterfallRow();
 };
 
 /**
@@ -218,12 +269,16 @@ public:
     SpectrumAnalyzer(const std::string& id, int numBands = 32)
         : WaveformVisualizer(id, 1024), numBands_(numBands) {
         setDisplayMode(DisplayMode::Spectrum);
+        setNumBands(numBands);
     }
     
     /**
      * @brief Set number of frequency bands
      */
-    void setNumBands(int bands) { numBands_ = std::max(8, std::min(128, bands)); }
+    void setNumBands(int bands) {
+        numBands_ = std::max(8, std::min(128, bands));
+        setSpectrumBandCount(numBands_);
+    }
     
     /**
      * @brief Set bar style (true=bars, false=line)
@@ -235,6 +290,7 @@ public:
      */
     void setPeakHoldTime(float seconds) { peakHoldTime_ = seconds; }
     
+    void update(float deltaTime) override;
     void render(DisplayManager* display) override;
     
 private:
@@ -3,6 +3,7 @@
 #include "Parameter.h"
 #include "ParameterGroup.h"
 #include "../../iot/IoTEventAdapter.h"
+#include "../../audio/SynthParameters.h"
 #include <map>
 #include <string>
 #include <functional>
@@ -201,6 +202,15 @@ private:
     };
     
     std::vector<SmoothingInfo> smoothingParameters_;
+    
+    // Registered parameters the synthesizer understands, resolved at
+    // registration so syncToSynthesizer sets them by index
+    struct SynthBinding {
+        Parameter* parameter;
+        SynthParamId synthParameter;
+    };
+    
+    std::vector<SynthBinding> synthBindings_;
     float totalTime_ = 0.0f;  // seconds since start
     
     // Helper methods
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "PresetInfo.h"
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <array>
+#include <cstdint>
+
+namespace AIMusicHardware {
+
+/**
+ * @brief Columnar in-memory storage for preset metadata
+ *
+ * Each preset gets a dense ID. Text fields live in one shared character
+ * arena, categories/authors/tags are interned once, numeric fields are
+ * kept in per-field columns, and parameter data is either stored as
+ * packed MessagePack or, for presets backed by a file, not held at all
+ * and re-read from disk when explicitly requested. Queries write
+ * preset IDs into caller-owned buffers or return spans over internal
+ * posting lists, so steady-state browsing does not allocate.
+ *
+ * Not thread-safe: PresetDatabase serializes access with its data mutex.
+ * Spans and string views stay valid until the next mutating call.
+ */
+class PresetColumnStore {
+public:
+    using PresetId = uint32_t;
+    static constexpr PresetId kInvalidId = 0xFFFFFFFFu;
+
+    /**
+     * @brief Non-owning view of a contiguous run of preset IDs
+     */
+    struct IdSpan {
+        const PresetId* data = nullptr;
+        size_t size = 0;
+
+        const PresetId* begin() const { return data; }
+        const PresetId* end() const { return data + size; }
+        bool empty() const { return size == 0; }
+    };
+
+    PresetColumnStore() = default;
+
+    // Mutation
+
+    /**
+     * @brief Insert a preset or overwrite the one with the same file path
+     * @param info Preset to store
+     * @param fileBacked Drop parameter data and reload it from filePath on demand
+     * @return Dense ID of the stored preset
+     */
+    PresetId upsert(const PresetInfo& info, bool fileBacked = false);
+
+    /**
+     * @brief Remove a preset; its ID is recycled by later inserts
+     * @return true if the ID was live
+     */
+    bool remove(PresetId id);
+
+    /**
+     * @brief Remove all presets and release arena memory
+     */
+    void clear();
+
+    /**
+     * @brief Reclaim arena space left behind by overwritten/removed presets
+     */
+    void compact();
+
+    // Lookup
+
+    PresetId find(const std::string& filePath) const;
+    bool isLive(PresetId id) const;
+    bool isFileBacked(PresetId id) const;
+    size_t size() const { return liveIds_.size(); }
+
+    // Column accessors (views valid until next mutation)
+
+    std::string_view name(PresetId id) const;
+    std::string_view filePath(PresetId id) const;
+    std::string_view category(PresetId id) const;
+    std::string_view author(PresetId id) const;
+    std::string_view license(PresetId id) const;
+    std::string_view description(PresetId id) const;
+    size_t tagCount(PresetId id) const;
+    std::string_view tag(PresetId id, size_t index) const;
+    bool isFavorite(PresetId id) const;
+    int userRating(PresetId id) const;
+    int playCount(PresetId id) const;
+    std::size_t fileSize(PresetId id) const;
+    std::chrono::system_clock::time_point created(PresetId id) const;
+    std::chrono::system_clock::time_point modified(PresetId id) const;
+    PresetInfo::AudioCharacteristics audioCharacteristics(PresetId id) const;
+
+    /**
+     * @brief Decode (or, for file-backed presets, reload) parameter data
+     * @return Parameter JSON (null if none stored)
+     */
+    nlohmann::json parameters(PresetId id) const;
+
+    /**
+     * @brief Rebuild a full PresetInfo from the columns
+     * @param id Preset to materialize
+     * @param includeParameters Decode parameter data as well
+     */
+    PresetInfo materialize(PresetId id, bool includeParameters = true) const;
+
+    // Indexed queries
+
+    /**
+     * @brief All live preset IDs in ascending order
+     */
+    IdSpan all() const { return {liveIds_.data(), liveIds_.size()}; }
+
+    IdSpan byCategory(const std::string& category) const;
+    IdSpan byAuthor(const std::string& author) const;
+    IdSpan byTag(const std::string& tag) const;
+    IdSpan favorites() const { return {favoriteIds_.data(), favoriteIds_.size()}; }
+
+    /**
+     * @brief Case-insensitive name search; exact matches come first
+     * @param query Search text
+     * @param out Receives matching IDs (cleared first, capacity reused)
+     */
+    void searchName(const std::string& query, std::vector<PresetId>& out) const;
+
+    /**
+     * @brief Apply filter criteria over the columns
+     * @param criteria Filter criteria
+     * @param out Receives matching IDs (cleared first, capacity reused)
+     */
+    void filter(const PresetFilterCriteria& criteria, std::vector<PresetId>& out) const;
+
+    /**
+     * @brief Sort IDs by a column
+     */
+    void sort(std::vector<PresetId>& ids, PresetSortCriteria criteria,
+              SortDirection direction = SortDirection::Ascending) const;
+
+    /**
+     * @brief Visit the distinct non-empty values of an interned field
+     */
+    template <typename Fn> void forEachCategory(Fn&& fn) const { forEachPosting(categoryPostings_, fn); }
+    template <typename Fn> void forEachAuthor(Fn&& fn) const { forEachPosting(authorPostings_, fn); }
+    template <typename Fn> void forEachTag(Fn&& fn) const { forEachPosting(tagPostings_, fn); }
+
+    size_t categoryCount() const { return countPostings(categoryPostings_); }
+    size_t authorCount() const { return countPostings(authorPostings_); }
+
+    /**
+     * @brief Approximate heap bytes held by the store
+     */
+    size_t memoryUsage() const;
+
+private:
+    struct TextRef {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    enum Flags : uint8_t {
+        kLive = 1 << 0,
+        kFavorite = 1 << 1,
+        kHasArpeggiator = 1 << 2,
+        kHasSequencer = 1 << 3,
+        kMetadataCached = 1 << 4,
+        kNeedsAnalysis = 1 << 5,
+        kFileBacked = 1 << 6
+    };
+
+    static constexpr uint32_t kNoString = 0xFFFFFFFFu;
+
+    TextRef appendText(std::string_view text);
+    TextRef appendLowercase(std::string_view text);
+    std::string_view text(TextRef ref) const;
+    uint32_t intern(const std::string& value);
+    uint32_t lookup(const std::string& value) const;
+    void releaseText(PresetId id);
+    void unlinkPostings(PresetId id);
+    bool containsFolded(std::string_view haystack, std::string_view foldedNeedle) const;
+
+    static void insertSorted(std::vector<PresetId>& ids, PresetId id);
+    static void eraseSorted(std::vector<PresetId>& ids, PresetId id);
+    IdSpan postingSpan(const std::vector<std::vector<PresetId>>& postings, uint32_t stringId) const;
+
+    template <typename Fn>
+    void forEachPosting(const std::vector<std::vector<PresetId>>& postings, Fn& fn) const {
+        for (size_t i = 0; i < postings.size(); ++i) {
+            if (!postings[i].empty() && !strings_[i].empty()) {
+                fn(std::string_view(strings_[i]));
+            }
+        }
+    }
+
+    size_t countPostings(const std::vector<std::vector<PresetId>>& postings) const;
+
+    // Shared storage
+    std::string textArena_;                    // names, paths, descriptions...
+    std::vector<uint8_t> blobArena_;           // packed parameter data
+    std::vector<uint32_t> tagPool_;            // interned tag IDs
+    size_t garbageBytes_ = 0;
+
+    // Interned strings (categories, authors, tags)
+    std::vector<std::string> strings_;
+    std::vector<std::string> foldedStrings_;   // lowercase copies for search
+    std::unordered_map<std::string, uint32_t> stringIds_;
+
+    // Per-preset columns, indexed by PresetId
+    std::vector<TextRef> names_;
+    std::vector<TextRef> foldedNames_;
+    std::vector<TextRef> paths_;
+    std::vector<TextRef> licenses_;
+    std::vector<TextRef> descriptions_;
+    std::vector<TextRef> foldedDescriptions_;
+    std::vector<TextRef> tagRanges_;           // offset/count into tagPool_
+    std::vector<TextRef> parameterBlobs_;      // offset/length into blobArena_
+    std::vector<uint32_t> categories_;
+    std::vector<uint32_t> authors_;
+    std::vector<int64_t> created_;
+    std::vector<int64_t> modified_;
+    std::vector<int64_t> lastAccessed_;
+    std::vector<uint64_t> fileSizes_;
+    std::vector<uint8_t> flags_;
+    std::vector<int16_t> ratings_;
+    std::vector<int32_t> playCounts_;
+    std::vector<int16_t> modulationCounts_;
+    std::vector<std::array<float, 6>> characteristics_;
+
+    // Indices
+    std::unordered_map<std::string, PresetId> pathIndex_;
+    std::vector<PresetId> freeIds_;
+    std::vector<PresetId> liveIds_;            // sorted
+    std::vector<PresetId> favoriteIds_;        // sorted
+    std::vector<std::vector<PresetId>> categoryPostings_; // by string ID
+    std::vector<std::vector<PresetId>> authorPostings_;
+    std::vector<std::vector<PresetId>> tagPostings_;
+
+    // Query scratch space (reused so filter() does not allocate)
+    mutable std::string foldedQuery_;
+    mutable std::vector<uint32_t> scratchCategories_;
+    mutable std::vector<uint32_t> scratchAuthors_;
+    mutable std::vector<uint32_t> scratchTags_;
+};
+
+} // namespace AIMusicHardware
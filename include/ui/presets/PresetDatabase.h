@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PresetInfo.h"
+#include "PresetColumnStore.h"
 #include <vector>
 #include <map>
 #include <set>
@@ -19,6 +20,9 @@ namespace AIMusicHardware {
  * 
  * Inspired by Vital's PresetInfoCache, this class provides fast lookup
  * operations for large preset collections with background indexing.
+ * Metadata is held in a PresetColumnStore; the ID-based query methods
+ * avoid materializing PresetInfo copies and should be preferred by
+ * browsers and other per-frame callers.
  */
 class PresetDatabase {
 public:
@@ -58,9 +62,11 @@ public:
      */
     void removeDirectory(const std::string& directory);
     
+    using PresetId = PresetColumnStore::PresetId;
+    
     /**
      * @brief Get all presets in the database
-     * @return Vector of all cached preset info
+     * @return Vector of all presets, parameters included (use queryAll() to avoid copies)
      */
     std::vector<PresetInfo> getAllPresets() const;
     
@@ -109,7 +115,7 @@ public:
               SortDirection direction = SortDirection::Ascending) const;
     
     /**
-     * @brief Get a specific preset by file path
+     * @brief Get a specific preset by file path, parameters included
      * @param filePath Path to the preset file
      * @return Preset info if found, nullptr otherwise
      */
@@ -142,6 +148,65 @@ public:
      */
     void rebuildIndices();
     
+    // ID-based queries (no PresetInfo copies; output buffers are reused)
+    
+    /**
+     * @brief Get IDs of all presets
+     * @param out Receives preset IDs (cleared first)
+     */
+    void queryAll(std::vector<PresetId>& out) const;
+    
+    /**
+     * @brief Get IDs of presets matching filter criteria
+     * @param criteria Filter criteria
+     * @param out Receives preset IDs (cleared first)
+     */
+    void queryFilter(const PresetFilterCriteria& criteria, std::vector<PresetId>& out) const;
+    
+    /**
+     * @brief Get IDs of presets in a category
+     * @param category Category to filter by
+     * @param out Receives preset IDs (cleared first)
+     */
+    void queryCategory(const std::string& category, std::vector<PresetId>& out) const;
+    
+    /**
+     * @brief Get IDs of presets whose name matches a query
+     * @param query Search query string
+     * @param out Receives preset IDs (cleared first)
+     */
+    void querySearch(const std::string& query, std::vector<PresetId>& out) const;
+    
+    /**
+     * @brief Sort preset IDs by specified criteria
+     */
+    void sortIds(std::vector<PresetId>& ids,
+                 PresetSortCriteria criteria,
+                 SortDirection direction = SortDirection::Ascending) const;
+    
+    /**
+     * @brief Materialize one preset from the column store
+     * @param id Preset ID from a query
+     * @param includeParameters Decode parameter data as well
+     * @return Preset info (empty if the ID is no longer valid)
+     */
+    PresetInfo materialize(PresetId id, bool includeParameters = false) const;
+    
+    /**
+     * @brief Read column values directly while holding the data lock
+     * @param reader Callback receiving the store; views must not escape it
+     */
+    template <typename Reader>
+    void readStore(Reader&& reader) const {
+        std::lock_guard<std::mutex> lock(dataMutex_);
+        reader(store_);
+    }
+    
+    /**
+     * @brief Approximate bytes used by preset metadata
+     */
+    size_t getMemoryUsage() const;
+    
     /**
      * @brief Get all unique categories in the database
      * @return Set of category strings
@@ -168,7 +233,7 @@ public:
         size_t totalCategories;
         size_t totalAuthors;
         size_t totalFavorites;
-        size_t cacheHitRate;  // Percentage 0-100
+        size_t cacheHitRate;  // Percentage 0-100 of parameter loads served from memory
         std::chrono::milliseconds lastUpdateTime;
     };
     Statistics getStatistics() const;
@@ -193,19 +258,11 @@ public:
     bool waitForUpdate(int timeoutMs = 5000) const;
     
 private:
-    // Core data storage
+    // Core data storage (columns, interned strings and indices)
     mutable std::mutex dataMutex_;
-    std::map<std::string, PresetInfo> presets_;  // filePath -> PresetInfo
+    PresetColumnStore store_;
     std::vector<std::string> watchedDirectories_;
     
-    // Performance indices (rebuilt when data changes)
-    mutable std::mutex indexMutex_;
-    std::multimap<std::string, std::string> nameIndex_;     // lowercase name -> filePath
-    std::multimap<std::string, std::string> categoryIndex_; // category -> filePath
-    std::multimap<std::string, std::string> authorIndex_;   // author -> filePath
-    std::multimap<std::string, std::string> tagIndex_;     // tag -> filePath
-    std::set<std::string> favoriteIndex_;                  // filePath of favorites
-    
     // Background scanning
     std::atomic<bool> isScanning_{false};
     std::atomic<bool> shouldStopScanning_{false};
@@ -213,9 +270,7 @@ private:
     mutable std::condition_variable updateCondition_;
     mutable std::mutex updateMutex_;
     
-    // Cache management
-    mutable std::map<std::string, PresetInfo> metadataCache_;
-    mutable std::mutex cacheMutex_;
+    // Parameter loads served from the store vs. read back from disk
     mutable std::atomic<size_t> cacheHits_{0};
     mutable std::atomic<size_t> cacheMisses_{0};
     
@@ -227,17 +282,10 @@ private:
     void scanDirectory(const std::string& directory, bool recursive);
     void processPresetFile(const std::string& filePath);
     void rebuildIndicesInternal();
-    void addToIndices(const PresetInfo& preset);
-    void removeFromIndices(const std::string& filePath);
-    
-    // String utilities for searching
-    std::string toLowercase(const std::string& str) const;
-    bool matchesSearch(const std::string& text, const std::string& query) const;
-    bool matchesFilter(const PresetInfo& preset, const PresetFilterCriteria& criteria) const;
-    
-    // Cache management
-    PresetInfo loadPresetMetadata(const std::string& filePath) const;
-    void updateCache(const PresetInfo& preset) const;
+    std::vector<PresetInfo> materializeAll(PresetColumnStore::IdSpan ids,
+                                           std::unique_lock<std::mutex>& lock) const;
+    void loadParametersFromDisk(std::vector<PresetInfo>& presets,
+                                const std::vector<size_t>& indices) const;
     
     // Validation
     bool isValidPresetFile(const std::string& filePath) const;
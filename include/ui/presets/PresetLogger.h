@@ -225,6 +225,11 @@ public:
              const std::map<std::string, std::string>& metadata,
              const std::string& function = "", const std::string& file = "", int line = 0);
     
+    /**
+     * @brief Log a prepared entry (e.g. one drained from RealtimeLog)
+     */
+    void log(const LogEntry& entry);
+    
     /**
      * @brief Log with performance metrics
      */
@@ -368,6 +373,8 @@ public:
     static std::string defaultFormatter(const LogEntry& entry);
 
 private:
+    friend class PerformanceTimer;
+    
     std::vector<std::shared_ptr<LogOutput>> outputs_;
     LogFilter filter_;
     LogFormatter formatter_;
@@ -75,6 +75,7 @@ private:
     bool prevButtonPressed_ = false;
     bool nextButtonPressed_ = false;
     bool saveButtonPressed_ = false;
+    std::string displayedName_;  // preset name shown by the last render
     
     // Helper methods
     void updateLayout();
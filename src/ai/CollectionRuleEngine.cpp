@@ -0,0 +1,537 @@
+#include "ai/CollectionRuleEngine.h"
+#include "ai/SmartCollectionManager.h"
+#include <algorithm>
+#include <cmath>
+
+namespace AIMusicHardware {
+
+// PresetBitmap implementation
+
+void PresetBitmap::set(uint32_t id) {
+    size_t word = id / 64;
+    if (word >= words_.size()) {
+        words_.resize(word + 1, 0);
+    }
+    uint64_t mask = uint64_t{1} << (id % 64);
+    if ((words_[word] & mask) == 0) {
+        words_[word] |= mask;
+        ++count_;
+    }
+}
+
+void PresetBitmap::reset(uint32_t id) {
+    size_t word = id / 64;
+    if (word >= words_.size()) return;
+    uint64_t mask = uint64_t{1} << (id % 64);
+    if ((words_[word] & mask) != 0) {
+        words_[word] &= ~mask;
+        --count_;
+    }
+}
+
+bool PresetBitmap::test(uint32_t id) const {
+    size_t word = id / 64;
+    return word < words_.size() && (words_[word] & (uint64_t{1} << (id % 64))) != 0;
+}
+
+void PresetBitmap::clear() {
+    std::fill(words_.begin(), words_.end(), 0);
+    count_ = 0;
+}
+
+size_t PresetBitmap::intersectionCount(const PresetBitmap& other) const {
+    size_t n = std::min(words_.size(), other.words_.size());
+    size_t result = 0;
+    for (size_t i = 0; i < n; ++i) {
+        result += static_cast<size_t>(__builtin_popcountll(words_[i] & other.words_[i]));
+    }
+    return result;
+}
+
+size_t PresetBitmap::unionCount(const PresetBitmap& other) const {
+    return count_ + other.count_ - intersectionCount(other);
+}
+
+// CollectionRuleEngine implementation
+
+void CollectionRuleEngine::compileCollection(const SmartCollection& collection) {
+    CompiledCollection compiled;
+    compiled.minScore = collection.minScore;
+    compiled.maxSize = collection.maxSize;
+    compiled.autoUpdate = collection.autoUpdate;
+    compiled.rules.reserve(collection.rules.size());
+
+    for (const auto& rule : collection.rules) {
+        compiled.rules.push_back(compileRule(rule));
+        compiled.totalWeight += rule.weight;
+        if (compiled.rules.back().field == CompiledRule::Field::AgeHours) {
+            compiled.hasTemporal = true;
+        }
+    }
+
+    compiled.scores.assign(records_.size(), 0.0f);
+    auto now = std::chrono::system_clock::now();
+    for (PresetId id = 0; id < records_.size(); ++id) {
+        if (records_[id].live) {
+            evaluateInto(compiled, id, records_[id], now);
+        }
+    }
+
+    collections_[collection.id] = std::move(compiled);
+}
+
+void CollectionRuleEngine::removeCollection(const std::string& collectionId) {
+    collections_.erase(collectionId);
+}
+
+bool CollectionRuleEngine::reevaluateCollection(const std::string& collectionId) {
+    auto it = collections_.find(collectionId);
+    if (it == collections_.end()) {
+        return false;
+    }
+
+    bool changed = false;
+    auto now = std::chrono::system_clock::now();
+    for (PresetId id = 0; id < records_.size(); ++id) {
+        if (records_[id].live) {
+            changed |= evaluateInto(it->second, id, records_[id], now);
+        }
+    }
+    return changed;
+}
+
+std::vector<std::string> CollectionRuleEngine::reevaluateTemporal() {
+    std::vector<std::string> changed;
+    for (auto& [id, collection] : collections_) {
+        if (collection.autoUpdate && collection.hasTemporal && reevaluateCollection(id)) {
+            changed.push_back(id);
+        }
+    }
+    return changed;
+}
+
+std::vector<std::string> CollectionRuleEngine::updatePreset(const PresetInfo& preset,
+                                                            const AudioFeatureVector& features) {
+    PresetId id;
+    auto found = pathToId_.find(preset.filePath);
+    if (found != pathToId_.end()) {
+        id = found->second;
+    } else if (!freeIds_.empty()) {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+        paths_[id] = preset.filePath;
+        pathToId_[preset.filePath] = id;
+    } else {
+        id = static_cast<PresetId>(records_.size());
+        records_.emplace_back();
+        paths_.push_back(preset.filePath);
+        pathToId_[preset.filePath] = id;
+    }
+
+    // Re-index the record from the preset fields rules can reference
+    PresetRecord& record = records_[id];
+    record.live = true;
+    record.category = intern(preset.category);
+    record.author = intern(preset.author);
+    record.tags.clear();
+    for (const auto& tag : preset.tags) {
+        record.tags.push_back(intern(tag));
+    }
+    std::sort(record.tags.begin(), record.tags.end());
+
+    auto& f = record.features;
+    f[static_cast<size_t>(Feature::Brightness)] = features.brightness;
+    f[static_cast<size_t>(Feature::Warmth)] = features.warmth;
+    f[static_cast<size_t>(Feature::BassContent)] = features.energyBands[0] + features.energyBands[1];
+    f[static_cast<size_t>(Feature::Complexity)] = features.oscillatorComplexity;
+    f[static_cast<size_t>(Feature::FilterResonance)] = features.filterResonance;
+    f[static_cast<size_t>(Feature::LfoDepth)] = features.lfoDepth;
+
+    record.favorite = preset.isFavorite;
+    record.rating = preset.userRating;
+    record.playCount = preset.playCount;
+    record.created = preset.created;
+
+    std::vector<std::string> changed;
+    auto now = std::chrono::system_clock::now();
+
+    for (auto& [collectionId, collection] : collections_) {
+        // Custom callbacks need the full preset, so cache their result here
+        // for every collection; manual ones read it on reevaluateCollection()
+        for (auto& rule : collection.rules) {
+            if (rule.field == CompiledRule::Field::Custom) {
+                if (rule.customEvaluator && rule.customEvaluator(preset, features)) {
+                    rule.customMatches.set(id);
+                } else {
+                    rule.customMatches.reset(id);
+                }
+            }
+        }
+
+        if (collection.autoUpdate && evaluateInto(collection, id, record, now)) {
+            changed.push_back(collectionId);
+        }
+    }
+
+    return changed;
+}
+
+std::vector<std::string> CollectionRuleEngine::removePreset(const std::string& presetPath) {
+    std::vector<std::string> changed;
+    auto found = pathToId_.find(presetPath);
+    if (found == pathToId_.end()) {
+        return changed;
+    }
+
+    PresetId id = found->second;
+    for (auto& [collectionId, collection] : collections_) {
+        if (collection.members.test(id) || collection.listed.test(id)) {
+            changed.push_back(collectionId);
+        }
+        collection.members.reset(id);
+        collection.listed.reset(id);
+        if (id < collection.scores.size()) {
+            collection.scores[id] = 0.0f;
+        }
+        for (auto& rule : collection.rules) {
+            rule.customMatches.reset(id);
+        }
+    }
+
+    records_[id] = PresetRecord();
+    paths_[id].clear();
+    pathToId_.erase(found);
+    freeIds_.push_back(id);
+
+    return changed;
+}
+
+std::vector<std::string> CollectionRuleEngine::retainPresets(const std::vector<PresetInfo>& presets) {
+    std::unordered_map<std::string, bool> live;
+    live.reserve(presets.size());
+    for (const auto& preset : presets) {
+        live[preset.filePath] = true;
+    }
+
+    std::vector<std::string> stale;
+    for (const auto& [path, id] : pathToId_) {
+        if (live.find(path) == live.end()) {
+            stale.push_back(path);
+        }
+    }
+
+    std::vector<std::string> changed;
+    for (const auto& path : stale) {
+        for (auto& collectionId : removePreset(path)) {
+            if (std::find(changed.begin(), changed.end(), collectionId) == changed.end()) {
+                changed.push_back(std::move(collectionId));
+            }
+        }
+    }
+    return changed;
+}
+
+CollectionRuleEngine::PresetId CollectionRuleEngine::findPreset(const std::string& presetPath) const {
+    auto it = pathToId_.find(presetPath);
+    return it != pathToId_.end() ? it->second : kInvalidPreset;
+}
+
+const std::string& CollectionRuleEngine::getPresetPath(PresetId id) const {
+    static const std::string empty;
+    return id < paths_.size() ? paths_[id] : empty;
+}
+
+const PresetBitmap* CollectionRuleEngine::getMembers(const std::string& collectionId) const {
+    auto it = collections_.find(collectionId);
+    return it != collections_.end() ? &it->second.members : nullptr;
+}
+
+const PresetBitmap* CollectionRuleEngine::getListed(const std::string& collectionId) const {
+    auto it = collections_.find(collectionId);
+    return it != collections_.end() ? &it->second.listed : nullptr;
+}
+
+float CollectionRuleEngine::getScore(const std::string& collectionId, PresetId id) const {
+    auto it = collections_.find(collectionId);
+    if (it == collections_.end() || !it->second.members.test(id)) {
+        return 0.0f;
+    }
+    return it->second.scores[id];
+}
+
+std::vector<std::pair<CollectionRuleEngine::PresetId, float>>
+CollectionRuleEngine::materialize(const std::string& collectionId) {
+    std::vector<std::pair<PresetId, float>> ranked;
+    auto it = collections_.find(collectionId);
+    if (it == collections_.end()) {
+        return ranked;
+    }
+
+    CompiledCollection& collection = it->second;
+    ranked.reserve(collection.members.count());
+    collection.members.forEach([&](PresetId id) {
+        ranked.emplace_back(id, collection.scores[id]);
+    });
+
+    auto byScore = [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    };
+
+    size_t limit = static_cast<size_t>(std::max(collection.maxSize, 0));
+    if (ranked.size() > limit) {
+        std::partial_sort(ranked.begin(), ranked.begin() + limit, ranked.end(), byScore);
+        ranked.resize(limit);
+    } else {
+        std::sort(ranked.begin(), ranked.end(), byScore);
+    }
+
+    collection.listed.clear();
+    for (const auto& [id, score] : ranked) {
+        collection.listed.set(id);
+    }
+
+    return ranked;
+}
+
+std::vector<std::string> CollectionRuleEngine::findCollectionsListing(const std::string& presetPath) const {
+    std::vector<std::string> result;
+    PresetId id = findPreset(presetPath);
+    if (id == kInvalidPreset) {
+        return result;
+    }
+
+    for (const auto& [collectionId, collection] : collections_) {
+        if (collection.listed.test(id)) {
+            result.push_back(collectionId);
+        }
+    }
+    return result;
+}
+
+// Private helpers
+
+uint32_t CollectionRuleEngine::intern(const std::string& value) {
+    auto it = stringIds_.find(value);
+    if (it != stringIds_.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(strings_.size());
+    strings_.push_back(value);
+    stringIds_.emplace(value, id);
+    return id;
+}
+
+CollectionRuleEngine::CompiledRule CollectionRuleEngine::compileRule(const CollectionRule& rule) {
+    using Field = CompiledRule::Field;
+    using Op = CompiledRule::Op;
+
+    CompiledRule compiled;
+    compiled.weight = rule.weight;
+    compiled.lo = rule.value;
+
+    auto numericOp = [&](bool allowNear) {
+        if (rule.operation == "greater_than") compiled.op = Op::Greater;
+        else if (rule.operation == "less_than") compiled.op = Op::Less;
+        else if (rule.operation == "equals") compiled.op = allowNear ? Op::Near : Op::Equals;
+        else if (rule.operation == "range" && allowNear) {
+            try {
+                compiled.hi = std::stof(rule.stringValue);
+                compiled.op = Op::Range;
+            } catch (const std::exception&) {
+                compiled.field = Field::Never;
+            }
+        } else {
+            compiled.field = Field::Never;
+        }
+    };
+
+    auto stringOp = [&](Field field) {
+        compiled.field = field;
+        if (rule.operation == "equals") {
+            compiled.op = Op::Equals;
+            compiled.stringId = intern(rule.stringValue);
+        } else if (rule.operation == "contains") {
+            compiled.op = Op::Contains;
+            compiled.needle = rule.stringValue;
+        } else {
+            compiled.field = Field::Never;
+        }
+    };
+
+    switch (rule.type) {
+        case CollectionRule::Type::AudioCharacteristic: {
+            compiled.field = Field::Feature;
+            if (rule.parameter == "brightness") compiled.feature = Feature::Brightness;
+            else if (rule.parameter == "warmth") compiled.feature = Feature::Warmth;
+            else if (rule.parameter == "bassContent") compiled.feature = Feature::BassContent;
+            else if (rule.parameter == "complexity") compiled.feature = Feature::Complexity;
+            else if (rule.parameter == "filterResonance") compiled.feature = Feature::FilterResonance;
+            else if (rule.parameter == "lfoDepth") compiled.feature = Feature::LfoDepth;
+            else {
+                compiled.field = Field::Never;
+                break;
+            }
+            numericOp(true);
+            break;
+        }
+
+        case CollectionRule::Type::Category:
+            stringOp(Field::Category);
+            break;
+
+        case CollectionRule::Type::Author:
+            stringOp(Field::Author);
+            break;
+
+        case CollectionRule::Type::Tag:
+            stringOp(Field::Tag);
+            break;
+
+        case CollectionRule::Type::UserBehavior: {
+            if (rule.parameter == "favorite") {
+                compiled.field = Field::Favorite;
+            } else if (rule.parameter == "rating") {
+                compiled.field = Field::Rating;
+                compiled.lo = static_cast<float>(static_cast<int>(rule.value));
+                numericOp(false);
+                if (compiled.op == Op::Less) compiled.field = Field::Never;
+            } else if (rule.parameter == "playCount") {
+                compiled.field = Field::PlayCount;
+                compiled.lo = static_cast<float>(static_cast<int>(rule.value));
+                numericOp(false);
+                if (compiled.op != Op::Greater) compiled.field = Field::Never;
+            }
+            break;
+        }
+
+        case CollectionRule::Type::Temporal: {
+            if (rule.parameter == "age_hours") {
+                compiled.field = Field::AgeHours;
+                numericOp(false);
+                if (compiled.op == Op::Equals) compiled.field = Field::Never;
+            }
+            break;
+        }
+
+        case CollectionRule::Type::Custom:
+            if (rule.customEvaluator) {
+                compiled.field = Field::Custom;
+                compiled.customEvaluator = rule.customEvaluator;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return compiled;
+}
+
+bool CollectionRuleEngine::matchesContains(const CompiledRule& rule, uint32_t stringId) const {
+    if (stringId >= rule.containsCache.size()) {
+        rule.containsCache.resize(strings_.size(), -1);
+    }
+    int8_t& cached = rule.containsCache[stringId];
+    if (cached < 0) {
+        cached = strings_[stringId].find(rule.needle) != std::string::npos ? 1 : 0;
+    }
+    return cached == 1;
+}
+
+float CollectionRuleEngine::evaluateRule(const CompiledRule& rule, PresetId id,
+                                         const PresetRecord& record,
+                                         std::chrono::system_clock::time_point now) const {
+    using Field = CompiledRule::Field;
+    using Op = CompiledRule::Op;
+
+    auto compareNumeric = [&](float x) {
+        switch (rule.op) {
+            case Op::Greater: return x > rule.lo;
+            case Op::Less:    return x < rule.lo;
+            case Op::Near:    return std::abs(x - rule.lo) < 0.1f;
+            case Op::Range:   return x >= rule.lo && x <= rule.hi;
+            case Op::Equals:  return x == rule.lo;
+            default:          return false;
+        }
+    };
+
+    auto compareString = [&](uint32_t stringId) {
+        return rule.op == Op::Equals ? stringId == rule.stringId
+                                     : matchesContains(rule, stringId);
+    };
+
+    bool match = false;
+    switch (rule.field) {
+        case Field::Feature:
+            match = compareNumeric(record.features[static_cast<size_t>(rule.feature)]);
+            break;
+        case Field::Favorite:
+            match = record.favorite;
+            break;
+        case Field::Rating:
+            match = compareNumeric(static_cast<float>(record.rating));
+            break;
+        case Field::PlayCount:
+            match = compareNumeric(static_cast<float>(record.playCount));
+            break;
+        case Field::AgeHours: {
+            auto ageHours = std::chrono::duration_cast<std::chrono::hours>(now - record.created).count();
+            match = compareNumeric(static_cast<float>(ageHours));
+            break;
+        }
+        case Field::Category:
+            match = compareString(record.category);
+            break;
+        case Field::Author:
+            match = compareString(record.author);
+            break;
+        case Field::Tag:
+            if (rule.op == Op::Equals) {
+                match = std::binary_search(record.tags.begin(), record.tags.end(), rule.stringId);
+            } else {
+                for (uint32_t tag : record.tags) {
+                    if (matchesContains(rule, tag)) {
+                        match = true;
+                        break;
+                    }
+                }
+            }
+            break;
+        case Field::Custom:
+            match = rule.customMatches.test(id);
+            break;
+        case Field::Never:
+            break;
+    }
+
+    return match ? 1.0f : 0.0f;
+}
+
+bool CollectionRuleEngine::evaluateInto(CompiledCollection& collection, PresetId id,
+                                        const PresetRecord& record,
+                                        std::chrono::system_clock::time_point now) {
+    float totalScore = 0.0f;
+    for (const auto& rule : collection.rules) {
+        totalScore += evaluateRule(rule, id, record, now) * rule.weight;
+    }
+    float score = collection.totalWeight > 0.0f ? totalScore / collection.totalWeight : 0.0f;
+
+    if (id >= collection.scores.size()) {
+        collection.scores.resize(records_.size(), 0.0f);
+    }
+
+    bool wasMember = collection.members.test(id);
+    bool isMember = score >= collection.minScore;
+    bool scoreChanged = collection.scores[id] != score;
+    collection.scores[id] = score;
+
+    if (isMember) {
+        collection.members.set(id);
+    } else {
+        collection.members.reset(id);
+    }
+
+    return wasMember != isMember || (isMember && scoreChanged);
+}
+
+} // namespace AIMusicHardware
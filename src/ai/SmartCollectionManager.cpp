@@ -246,6 +246,8 @@ std::string SmartCollectionManager::createSmartCollection(const std::string& nam
     collection.rules = rules;
     collection.lastUpdated = std::chrono::system_clock::now();
     
+    ruleEngine_.compileCollection(collection);
+    materializeCollection(collection);
     collections_[collection.id] = collection;
     updateStatistics();
     
@@ -262,6 +264,8 @@ std::string SmartCollectionManager::createFromTemplate(const std::string& templa
     SmartCollection collection = it->second.createCollection(collectionName);
     collection.id = generateCollectionId();
     
+    ruleEngine_.compileCollection(collection);
+    materializeCollection(collection);
     collections_[collection.id] = collection;
     updateStatistics();
     
@@ -276,7 +280,8 @@ bool SmartCollectionManager::updateCollectionRules(const std::string& collection
     }
     
     it->second.rules = rules;
-    it->second.lastUpdated = std::chrono::system_clock::now();
+    ruleEngine_.compileCollection(it->second);
+    materializeCollection(it->second);
     
     return true;
 }
@@ -287,6 +292,7 @@ bool SmartCollectionManager::deleteSmartCollection(const std::string& collection
         return false; // Not found or system collection
     }
     
+    ruleEngine_.removeCollection(collectionId);
     collections_.erase(it);
     updateStatistics();
     
@@ -320,11 +326,15 @@ const SmartCollection* SmartCollectionManager::getCollection(const std::string&
 void SmartCollectionManager::updateAllCollections(const std::vector<PresetInfo>& presets,
                                                   std::function<void(int, int)> progressCallback) {
     int current = 0;
-    int total = static_cast<int>(collections_.size());
+    int total = static_cast<int>(presets.size());
     
-    for (auto& [id, collection] : collections_) {
-        if (collection.autoUpdate) {
-            updateCollection(id, presets);
+    // Drop presets that no longer exist, then re-index the rest
+    std::vector<std::string> changed = ruleEngine_.retainPresets(presets);
+    
+    for (const auto& preset : presets) {
+        AudioFeatureVector features = analyzer_->extractFeatures(preset);
+        for (auto& id : ruleEngine_.updatePreset(preset, features)) {
+            changed.push_back(std::move(id));
         }
         
         if (progressCallback) {
@@ -332,6 +342,19 @@ void SmartCollectionManager::updateAllCollections(const std::vector<PresetInfo>&
         }
     }
     
+    for (auto& id : ruleEngine_.reevaluateTemporal()) {
+        changed.push_back(std::move(id));
+    }
+    
+    // Manual collections only change through updateCollection()
+    changed.erase(std::remove_if(changed.begin(), changed.end(), [this](const std::string& id) {
+        auto it = collections_.find(id);
+        return it == collections_.end() || !it->second.autoUpdate;
+    }), changed.end());
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    materializeCollections(changed);
+    
     updateStatistics();
 }
 
@@ -342,41 +365,22 @@ bool SmartCollectionManager::updateCollection(const std::string& collectionId,
         return false;
     }
     
-    SmartCollection& collection = it->second;
-    
-    // Clear current contents
-    collection.presetPaths.clear();
-    collection.presetScores.clear();
-    
-    // Evaluate each preset against collection rules
-    std::vector<std::pair<std::string, float>> scoredPresets;
-    
+    // Re-indexing also moves auto-updating collections; their bitmaps are
+    // already updated, so materialize them now or they never refresh
+    std::vector<std::string> changed;
     for (const auto& preset : presets) {
         AudioFeatureVector features = analyzer_->extractFeatures(preset);
-        
-        if (collection.shouldInclude(preset, features)) {
-            float score = collection.calculateScore(preset, features);
-            scoredPresets.emplace_back(preset.filePath, score);
-            collection.presetScores[preset.filePath] = score;
+        for (auto& id : ruleEngine_.updatePreset(preset, features)) {
+            changed.push_back(std::move(id));
         }
     }
     
-    // Sort by score (descending)
-    std::sort(scoredPresets.begin(), scoredPresets.end(),
-        [](const auto& a, const auto& b) { return a.second > b.second; });
-    
-    // Limit to max size
-    if (static_cast<int>(scoredPresets.size()) > collection.maxSize) {
-        scoredPresets.resize(collection.maxSize);
-    }
-    
-    // Extract preset paths
-    collection.presetPaths.reserve(scoredPresets.size());
-    for (const auto& [presetPath, score] : scoredPresets) {
-        collection.presetPaths.push_back(presetPath);
-    }
+    ruleEngine_.reevaluateCollection(collectionId);
+    changed.push_back(collectionId);
     
-    collection.lastUpdated = std::chrono::system_clock::now();
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    materializeCollections(changed);
     
     return true;
 }
@@ -385,33 +389,14 @@ std::vector<std::string> SmartCollectionManager::addPresetToCollections(const Pr
     std::vector<std::string> updatedCollections;
     AudioFeatureVector features = analyzer_->extractFeatures(preset);
     
-    for (auto& [id, collection] : collections_) {
-        if (collection.autoUpdate && collection.shouldInclude(preset, features)) {
-            float score = collection.calculateScore(preset, features);
-            
-            // Check if collection is at max size
-            if (static_cast<int>(collection.presetPaths.size()) >= collection.maxSize) {
-                // Find lowest scoring preset and replace if new preset scores higher
-                auto minIt = std::min_element(collection.presetScores.begin(), collection.presetScores.end(),
-                    [](const auto& a, const auto& b) { return a.second < b.second; });
-                
-                if (minIt != collection.presetScores.end() && score > minIt->second) {
-                    // Remove lowest scoring preset
-                    auto removeIt = std::find(collection.presetPaths.begin(), collection.presetPaths.end(), minIt->first);
-                    if (removeIt != collection.presetPaths.end()) {
-                        collection.presetPaths.erase(removeIt);
-                    }
-                    collection.presetScores.erase(minIt);
-                }
-            }
-            
-            // Add new preset if there's room or we made room
-            if (static_cast<int>(collection.presetPaths.size()) < collection.maxSize) {
-                collection.presetPaths.push_back(preset.filePath);
-                collection.presetScores[preset.filePath] = score;
-                collection.lastUpdated = std::chrono::system_clock::now();
-                updatedCollections.push_back(id);
-            }
+    std::vector<std::string> changed = ruleEngine_.updatePreset(preset, features);
+    materializeCollections(changed);
+    
+    CollectionRuleEngine::PresetId presetId = ruleEngine_.findPreset(preset.filePath);
+    for (const auto& id : changed) {
+        const PresetBitmap* listed = ruleEngine_.getListed(id);
+        if (listed && listed->test(presetId)) {
+            updatedCollections.push_back(id);
         }
     }
     
@@ -419,14 +404,7 @@ std::vector<std::string> SmartCollectionManager::addPresetToCollections(const Pr
 }
 
 void SmartCollectionManager::removePresetFromCollections(const std::string& presetPath) {
-    for (auto& [id, collection] : collections_) {
-        auto it = std::find(collection.presetPaths.begin(), collection.presetPaths.end(), presetPath);
-        if (it != collection.presetPaths.end()) {
-            collection.presetPaths.erase(it);
-            collection.presetScores.erase(presetPath);
-            collection.lastUpdated = std::chrono::system_clock::now();
-        }
-    }
+    materializeCollections(ruleEngine_.removePreset(presetPath));
 }
 
 // Smart playlist methods
@@ -651,16 +629,7 @@ void SmartCollectionManager::createDefaultTemplates() {
 // Search and discovery methods
 
 std::vector<std::string> SmartCollectionManager::findCollectionsWithPreset(const std::string& presetPath) const {
-    std::vector<std::string> result;
-    
-    for (const auto& [id, collection] : collections_) {
-        auto it = std::find(collection.presetPaths.begin(), collection.presetPaths.end(), presetPath);
-        if (it != collection.presetPaths.end()) {
-            result.push_back(id);
-        }
-    }
-    
-    return result;
+    return ruleEngine_.findCollectionsListing(presetPath);
 }
 
 std::vector<std::string> SmartCollectionManager::searchCollections(const std::string& query) const {
@@ -827,6 +796,8 @@ bool SmartCollectionManager::importData(const nlohmann::json& data) {
                     }
                 }
                 
+                ruleEngine_.compileCollection(collection);
+                materializeCollection(collection);
                 collections_[collection.id] = collection;
             }
         }
@@ -893,6 +864,31 @@ std::string SmartCollectionManager::generatePlaylistId() {
     return "playlist_" + std::to_string(nextPlaylistId_++);
 }
 
+void SmartCollectionManager::materializeCollection(SmartCollection& collection) {
+    auto ranked = ruleEngine_.materialize(collection.id);
+    
+    collection.presetPaths.clear();
+    collection.presetScores.clear();
+    collection.presetPaths.reserve(ranked.size());
+    
+    for (const auto& [presetId, score] : ranked) {
+        const std::string& path = ruleEngine_.getPresetPath(presetId);
+        collection.presetPaths.push_back(path);
+        collection.presetScores[path] = score;
+    }
+    
+    collection.lastUpdated = std::chrono::system_clock::now();
+}
+
+void SmartCollectionManager::materializeCollections(const std::vector<std::string>& collectionIds) {
+    for (const auto& id : collectionIds) {
+        auto it = collections_.find(id);
+        if (it != collections_.end()) {
+            materializeCollection(it->second);
+        }
+    }
+}
+
 void SmartCollectionManager::updateStatistics() const {
     stats_.totalCollections = static_cast<int>(collections_.size());
     stats_.totalPlaylists = static_cast<int>(playlists_.size());
@@ -917,23 +913,18 @@ void SmartCollectionManager::updateStatistics() const {
 
 float SmartCollectionManager::calculateCollectionSimilarity(const SmartCollection& collection1,
                                                            const SmartCollection& collection2) const {
-    // Calculate similarity based on content overlap
-    std::set<std::string> set1(collection1.presetPaths.begin(), collection1.presetPaths.end());
-    std::set<std::string> set2(collection2.presetPaths.begin(), collection2.presetPaths.end());
-    
-    std::set<std::string> intersection;
-    std::set_intersection(set1.begin(), set1.end(),
-                         set2.begin(), set2.end(),
-                         std::inserter(intersection, intersection.begin()));
+    // Calculate similarity based on content overlap of the listing bitmaps
+    const PresetBitmap* set1 = ruleEngine_.getListed(collection1.id);
+    const PresetBitmap* set2 = ruleEngine_.getListed(collection2.id);
+    if (!set1 || !set2) {
+        return 0.0f;
+    }
     
-    std::set<std::string> unionSet;
-    std::set_union(set1.begin(), set1.end(),
-                   set2.begin(), set2.end(),
-                   std::inserter(unionSet, unionSet.begin()));
+    size_t unionSize = set1->unionCount(*set2);
     
     // Jaccard similarity coefficient
-    return unionSet.empty() ? 0.0f : 
-           static_cast<float>(intersection.size()) / static_cast<float>(unionSet.size());
+    return unionSize == 0 ? 0.0f :
+           static_cast<float>(set1->intersectionCount(*set2)) / static_cast<float>(unionSize);
 }
 
 std::vector<std::string> SmartCollectionManager::generateInsights(const SmartCollection& collection) const {
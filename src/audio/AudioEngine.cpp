@@ -1,6 +1,8 @@
 #include "../../include/audio/AudioEngine.h"
 #include "../../include/sequencer/Sequencer.h" // Include Sequencer.h early to avoid forward declaration issues
 #include "../../include/audio/AudioErrorHandler.h"
+#include "../../include/audio/TraceRecorder.h"
+#include "../../include/audio/RealtimeLog.h"
 
 // RtAudio header can be in different locations depending on installation method
 // Try standard includes first, then fallback to rtaudio subdirectory
@@ -72,6 +74,7 @@ using RtAudioStreamStatus = unsigned int;
 int audioCallback(void* outputBuffer, void* inputBuffer, unsigned int nFrames,
                  double streamTime, RtAudioStreamStatus status, void* userData) {
     
+    AIMUSIC_TRACE_SCOPE("audioCallback");
     auto callbackStart = std::chrono::steady_clock::now();
     
     // Cast user data to AudioEngine instance
@@ -81,6 +84,13 @@ int audioCallback(void* outputBuffer, void* inputBuffer, unsigned int nFrames,
         return 1;  // Return error code
     }
     
+    // Allocate this thread's real-time log ring once at stream start,
+    // not at its first RT_LOG_* call in the middle of playback
+    if (!engine->audioThreadPrepared_.load(std::memory_order_relaxed)) {
+        RealtimeLog::getInstance().prepareThread();
+        engine->audioThreadPrepared_.store(true, std::memory_order_relaxed);
+    }
+    
     // Update stream time in error handler
     engine->getErrorHandler().updateStreamTime(streamTime);
     
@@ -115,14 +125,32 @@ int audioCallback(void* outputBuffer, void* inputBuffer, unsigned int nFrames,
     // Zero output buffer first with correct channel count
     std::memset(outputBuffer, 0, nFrames * numChannels * sizeof(float));
     
+    // Subsystem times are only collected when the block will be recorded
+    const bool monitoring = engine->performanceMonitoringEnabled_.load();
+    const int parametersTiming = monitoring ? engine->parametersSubsystem_ : -1;
+    const int callbackTiming = monitoring ? engine->callbackSubsystem_ : -1;
+    
     try {
+        {
+            // Apply parameter changes queued since the last block
+            DspLoadMonitor::ScopedSubsystem timing(engine->loadMonitor_, parametersTiming);
+            engine->parameterStore_.processUpdates();
+        }
+        
         // Access the callback through a thread-safe getter
         AudioEngine::AudioCallback callback = engine->getCallback();
         if (callback) {
             // Execute the callback with error handling
+            DspLoadMonitor::ScopedSubsystem timing(engine->loadMonitor_, callbackTiming);
             callback(static_cast<float*>(outputBuffer), nFrames);
         }
         
+        {
+            // Let UI and other readers see this block's values
+            DspLoadMonitor::ScopedSubsystem timing(engine->loadMonitor_, parametersTiming);
+            engine->parameterStore_.publishSnapshot();
+        }
+        
         // Check audio safety if enabled
         if (engine->audioSafetyEnabled_.load()) {
             engine->checkAudioSafety(static_cast<float*>(outputBuffer), nFrames * numChannels);
@@ -151,9 +179,9 @@ int audioCallback(void* outputBuffer, void* inputBuffer, unsigned int nFrames,
     }
     
     // Measure callback performance if monitoring is enabled
-    if (engine->performanceMonitoringEnabled_.load()) {
+    if (monitoring) {
         auto callbackEnd = std::chrono::steady_clock::now();
-        engine->measureCallbackPerformance(callbackStart, callbackEnd);
+        engine->measureCallbackPerformance(callbackStart, callbackEnd, static_cast<int>(nFrames));
     }
     
     return 0;
@@ -281,6 +309,10 @@ AudioEngine::AudioEngine(int sampleRate, int bufferSize)
       bufferSize_(bufferSize),
       startTime_(std::chrono::steady_clock::now()),
       lastCallbackTime_(std::chrono::steady_clock::now()),
+      loadMonitor_(sampleRate),
+      parametersSubsystem_(loadMonitor_.addSubsystem("parameters")),
+      callbackSubsystem_(loadMonitor_.addSubsystem("callback")),
+      loadGovernor_(sampleRate),
       // Create implementation with parent pointer already set
       pimpl_(new Impl(sampleRate, bufferSize, this)) {
     
@@ -316,6 +348,10 @@ bool AudioEngine::initialize() {
         return true;
     }
     
+    // Start the real-time log drain thread before the stream can call RT_LOG_*
+    RealtimeLog::getInstance();
+    audioThreadPrepared_.store(false, std::memory_order_relaxed);
+    
     bool success = pimpl_->initialize();
     isInitialized_.store(success, std::memory_order_release);
     return success;
@@ -385,6 +421,12 @@ AudioEngine::PerformanceMetrics AudioEngine::getPerformanceMetrics() const {
     auto now = std::chrono::steady_clock::now();
     metrics.uptime = std::chrono::duration<double>(now - startTime_).count();
     
+    metrics.dspLoad = loadMonitor_.getStatistics();
+    metrics.subsystemLoad = loadMonitor_.getSubsystemStatistics();
+    metrics.qualityLevel = loadGovernor_.getLevel();
+    metrics.qualityDegradations = loadGovernor_.getDegradeCount();
+    metrics.qualityRestorations = loadGovernor_.getRestoreCount();
+    
     return metrics;
 }
 
@@ -459,10 +501,16 @@ void AudioEngine::updatePerformanceMetrics() {
 }
 
 void AudioEngine::measureCallbackPerformance(const std::chrono::steady_clock::time_point& start,
-                                            const std::chrono::steady_clock::time_point& end) {
+                                            const std::chrono::steady_clock::time_point& end,
+                                            int numFrames) {
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
     lastCallbackDuration_ = duration;
     
+    // Unsmoothed per-block load, against this block's own length; the
+    // governor adjusts quality for the next block
+    const float blockLoad = loadMonitor_.endBlock(end - start, numFrames);
+    loadGovernor_.update(blockLoad, numFrames);
+    
     // Calculate jitter (variation in callback timing)
     auto timeSinceLastCallback = std::chrono::duration_cast<std::chrono::microseconds>(start - lastCallbackTime_);
     auto expectedCallbackInterval = std::chrono::microseconds{static_cast<long>((bufferSize_ / static_cast<double>(sampleRate_)) * 1000000.0)};
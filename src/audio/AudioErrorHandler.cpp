@@ -1,4 +1,5 @@
 #include "../../include/audio/AudioErrorHandler.h"
+#include "../../include/audio/RealtimeLog.h"
 #include <algorithm>
 #include <iostream>
 #include <thread>
@@ -110,6 +111,9 @@ void AudioErrorHandler::reportCriticalError(const AudioError& error) {
 }
 
 void AudioErrorHandler::reportRealTimeError(AudioErrorCode code, const std::string& message) {
+    RT_LOG_WARNING(LogCategory::Audio, "Real-time audio error {} at stream time {}: {}", static_cast<int>(code),
+                   streamTime_.load(), message);
+
     // Lock-free error reporting for real-time contexts
     size_t writeIndex = rtErrorWriteIndex_.load();
     size_t nextIndex = (writeIndex + 1) % RT_ERROR_QUEUE_SIZE;
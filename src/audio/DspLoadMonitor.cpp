@@ -0,0 +1,245 @@
+#include "../../include/audio/DspLoadMonitor.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace AIMusicHardware {
+
+namespace {
+
+constexpr uint32_t kOver80 = 8000;
+constexpr uint32_t kOver90 = 9000;
+constexpr uint32_t kOver100 = 10000;
+
+int highestBit(uint32_t value) {
+    int bit = 0;
+    while (value >>= 1) {
+        ++bit;
+    }
+    return bit;
+}
+
+// Single-writer increment without a locked read-modify-write
+void bump(std::atomic<uint64_t>& counter, uint64_t amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Histogram layout
+//------------------------------------------------------------------------------
+
+int DspLoadMonitor::bucketForValue(uint32_t hundredths) {
+    hundredths = std::min(hundredths, kMaxValue);
+    if (hundredths < kSubBuckets) {
+        return static_cast<int>(hundredths);
+    }
+    // Keep the top kSubBucketBits bits: 64 buckets per power of two
+    const int shift = highestBit(hundredths) - (kSubBucketBits - 1);
+    return static_cast<int>(kSubBuckets + (shift - 1) * kHalfSubBuckets + ((hundredths >> shift) - kHalfSubBuckets));
+}
+
+uint32_t DspLoadMonitor::highestValueInBucket(int bucket) {
+    if (bucket < static_cast<int>(kSubBuckets)) {
+        return static_cast<uint32_t>(bucket);
+    }
+    const uint32_t offset = static_cast<uint32_t>(bucket) - kSubBuckets;
+    const int shift = static_cast<int>(offset / kHalfSubBuckets) + 1;
+    const uint32_t lowest = (kHalfSubBuckets + offset % kHalfSubBuckets) << shift;
+    return lowest + (1u << shift) - 1;
+}
+
+void DspLoadMonitor::Histogram::record(uint32_t hundredths) {
+    hundredths = std::min(hundredths, kMaxValue);
+    bump(counts[static_cast<size_t>(bucketForValue(hundredths))]);
+    bump(blocks);
+    bump(sum, hundredths);
+    if (hundredths > max.load(std::memory_order_relaxed)) {
+        max.store(hundredths, std::memory_order_relaxed);
+    }
+    if (hundredths > kOver80) {
+        bump(over80);
+        if (hundredths > kOver90) {
+            bump(over90);
+            if (hundredths > kOver100) {
+                bump(over100);
+            }
+        }
+    }
+}
+
+void DspLoadMonitor::Histogram::clear() {
+    for (auto& count : counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    blocks.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+    over80.store(0, std::memory_order_relaxed);
+    over90.store(0, std::memory_order_relaxed);
+    over100.store(0, std::memory_order_relaxed);
+}
+
+DspLoadMonitor::LoadStatistics DspLoadMonitor::Histogram::statistics() const {
+    std::array<uint64_t, kNumBuckets> copy;
+    uint64_t total = 0;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        copy[static_cast<size_t>(i)] = counts[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+        total += copy[static_cast<size_t>(i)];
+    }
+
+    LoadStatistics stats;
+    stats.blocks = total;
+    stats.over80 = over80.load(std::memory_order_relaxed);
+    stats.over90 = over90.load(std::memory_order_relaxed);
+    stats.over100 = over100.load(std::memory_order_relaxed);
+    if (total == 0) {
+        return stats;
+    }
+
+    const uint32_t maxValue = max.load(std::memory_order_relaxed);
+    stats.max = maxValue / 100.0;
+    stats.mean = static_cast<double>(sum.load(std::memory_order_relaxed)) / 100.0 /
+                 static_cast<double>(std::max<uint64_t>(blocks.load(std::memory_order_relaxed), 1));
+
+    // Walk the buckets once for every percentile, in increasing order
+    const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+    double* results[] = {&stats.p50, &stats.p90, &stats.p99, &stats.p999};
+    uint64_t seen = 0;
+    int bucket = 0;
+    for (int q = 0; q < 4; ++q) {
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(quantiles[q] * static_cast<double>(total) + 0.5));
+        while (bucket < kNumBuckets && seen + copy[static_cast<size_t>(bucket)] < rank) {
+            seen += copy[static_cast<size_t>(bucket)];
+            ++bucket;
+        }
+        const uint32_t value = std::min(highestValueInBucket(std::min(bucket, kNumBuckets - 1)), maxValue);
+        *results[q] = value / 100.0;
+    }
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+// DspLoadMonitor
+//------------------------------------------------------------------------------
+
+DspLoadMonitor::DspLoadMonitor(int sampleRate)
+    : sampleRate_(sampleRate > 0 ? sampleRate : 44100) {
+}
+
+DspLoadMonitor::~DspLoadMonitor() = default;
+
+void DspLoadMonitor::setSampleRate(int sampleRate) {
+    if (sampleRate > 0) {
+        sampleRate_.store(sampleRate, std::memory_order_relaxed);
+    }
+}
+
+int DspLoadMonitor::addSubsystem(const std::string& name) {
+    const int count = subsystemCount_.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i) {
+        if (subsystemNames_[static_cast<size_t>(i)] == name) {
+            return i;
+        }
+    }
+    if (count >= kMaxSubsystems) {
+        return -1;
+    }
+    subsystemNames_[static_cast<size_t>(count)] = name;
+    subsystemCount_.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+void DspLoadMonitor::addSubsystemTime(int index, std::chrono::nanoseconds duration) {
+    if (index >= 0 && index < kMaxSubsystems) {
+        blockTime_[static_cast<size_t>(index)] += duration.count();
+    }
+}
+
+float DspLoadMonitor::endBlock(std::chrono::nanoseconds duration, int numFrames) {
+    const uint64_t requests = resetRequests_.load(std::memory_order_acquire);
+    if (requests != resetsApplied_) {
+        total_.clear();
+        for (auto& histogram : subsystems_) {
+            histogram.clear();
+        }
+        resetsApplied_ = requests;
+    }
+
+    // Hundredths of a percent per nanosecond of this block's deadline
+    const double deadlineNs = numFrames > 0
+        ? static_cast<double>(numFrames) * 1e9 / sampleRate_.load(std::memory_order_relaxed)
+        : 1.0;
+    const double scale = 10000.0 / deadlineNs;
+    auto toHundredths = [scale](int64_t nanoseconds) {
+        const double value = std::max(0.0, static_cast<double>(nanoseconds) * scale);
+        return static_cast<uint32_t>(std::min(value, static_cast<double>(kMaxValue)));
+    };
+
+    const uint32_t load = toHundredths(duration.count());
+    total_.record(load);
+
+    const int count = subsystemCount_.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        subsystems_[static_cast<size_t>(i)].record(toHundredths(blockTime_[static_cast<size_t>(i)]));
+        blockTime_[static_cast<size_t>(i)] = 0;
+    }
+
+    const float percent = load / 100.0f;
+    lastLoad_.store(percent, std::memory_order_relaxed);
+    return percent;
+}
+
+DspLoadMonitor::LoadStatistics DspLoadMonitor::getStatistics() const {
+    return total_.statistics();
+}
+
+std::vector<DspLoadMonitor::SubsystemStatistics> DspLoadMonitor::getSubsystemStatistics() const {
+    std::vector<SubsystemStatistics> result;
+    const int count = subsystemCount_.load(std::memory_order_acquire);
+    result.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        result.push_back({subsystemNames_[static_cast<size_t>(i)], subsystems_[static_cast<size_t>(i)].statistics()});
+    }
+    return result;
+}
+
+void DspLoadMonitor::reset() {
+    resetRequests_.fetch_add(1, std::memory_order_release);
+}
+
+std::string DspLoadMonitor::exportJson() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+
+    auto writeHistogram = [&out](const Histogram& histogram) {
+        const LoadStatistics stats = histogram.statistics();
+        out << "{\"blocks\":" << stats.blocks << ",\"mean\":" << stats.mean << ",\"max\":" << stats.max
+            << ",\"p50\":" << stats.p50 << ",\"p90\":" << stats.p90 << ",\"p99\":" << stats.p99
+            << ",\"p999\":" << stats.p999 << ",\"over80\":" << stats.over80 << ",\"over90\":" << stats.over90
+            << ",\"over100\":" << stats.over100 << ",\"buckets\":[";
+        bool first = true;
+        for (int i = 0; i < kNumBuckets; ++i) {
+            const uint64_t count = histogram.counts[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+            if (count > 0) {
+                out << (first ? "" : ",") << "[" << highestValueInBucket(i) / 100.0 << "," << count << "]";
+                first = false;
+            }
+        }
+        out << "]}";
+    };
+
+    out << "{\"unit\":\"percent of deadline\",\"total\":";
+    writeHistogram(total_);
+    out << ",\"subsystems\":{";
+    const int count = subsystemCount_.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        out << (i ? "," : "") << "\"" << subsystemNames_[static_cast<size_t>(i)] << "\":";
+        writeHistogram(subsystems_[static_cast<size_t>(i)]);
+    }
+    out << "}}";
+    return out.str();
+}
+
+} // namespace AIMusicHardware
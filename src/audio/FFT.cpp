@@ -0,0 +1,224 @@
+#include "../../include/audio/FFT.h"
+#include <algorithm>
+#include <cmath>
+
+namespace AIMusicHardware {
+
+namespace {
+constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+int floorPowerOfTwo(int value) {
+    int result = 4;
+    while (result * 2 <= value) {
+        result *= 2;
+    }
+    return result;
+}
+} // namespace
+
+FFT::FFT(int size, Window window)
+    : size_(floorPowerOfTwo(size))
+    , halfSize_(size_ / 2)
+    , window_(window) {
+
+    // Bit-reversal permutation for the half-size complex transform
+    int bits = 0;
+    while ((1 << bits) < halfSize_) {
+        ++bits;
+    }
+    bitReverse_.resize(halfSize_);
+    for (int i = 0; i < halfSize_; ++i) {
+        int reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            if (i & (1 << b)) {
+                reversed |= 1 << (bits - 1 - b);
+            }
+        }
+        bitReverse_[i] = reversed;
+    }
+
+    // exp(-2*pi*i*k/M) for the butterfly stages
+    twiddleCos_.resize(std::max(1, halfSize_ / 2));
+    twiddleSin_.resize(twiddleCos_.size());
+    for (size_t k = 0; k < twiddleCos_.size(); ++k) {
+        double angle = -kTwoPi * static_cast<double>(k) / halfSize_;
+        twiddleCos_[k] = static_cast<float>(std::cos(angle));
+        twiddleSin_[k] = static_cast<float>(std::sin(angle));
+    }
+
+    // exp(-2*pi*i*k/N) for splitting the packed real transform
+    splitCos_.resize(halfSize_ + 1);
+    splitSin_.resize(halfSize_ + 1);
+    for (int k = 0; k <= halfSize_; ++k) {
+        double angle = -kTwoPi * static_cast<double>(k) / size_;
+        splitCos_[k] = static_cast<float>(std::cos(angle));
+        splitSin_[k] = static_cast<float>(std::sin(angle));
+    }
+
+    windowed_.resize(size_);
+    workReal_.resize(halfSize_);
+    workImag_.resize(halfSize_);
+    binReal_.resize(halfSize_ + 1);
+    binImag_.resize(halfSize_ + 1);
+
+    setWindow(window);
+}
+
+void FFT::setWindow(Window window) {
+    window_ = window;
+    windowTable_.resize(size_);
+
+    double sum = 0.0;
+    for (int n = 0; n < size_; ++n) {
+        double phase = kTwoPi * static_cast<double>(n) / size_;
+        double w = 1.0;
+        switch (window) {
+            case Window::Rectangular:
+                w = 1.0;
+                break;
+            case Window::Hann:
+                w = 0.5 - 0.5 * std::cos(phase);
+                break;
+            case Window::BlackmanHarris:
+                w = 0.35875 - 0.48829 * std::cos(phase)
+                    + 0.14128 * std::cos(2.0 * phase)
+                    - 0.01168 * std::cos(3.0 * phase);
+                break;
+        }
+        windowTable_[n] = static_cast<float>(w);
+        sum += w;
+    }
+    windowGain_ = static_cast<float>(sum);
+}
+
+void FFT::transformComplex(float* real, float* imag) {
+    const int n = halfSize_;
+
+    for (int i = 0; i < n; ++i) {
+        int j = bitReverse_[i];
+        if (j > i) {
+            std::swap(real[i], real[j]);
+            std::swap(imag[i], imag[j]);
+        }
+    }
+
+    for (int length = 2; length <= n; length <<= 1) {
+        int half = length >> 1;
+        int step = n / length;
+        for (int start = 0; start < n; start += length) {
+            for (int j = 0; j < half; ++j) {
+                float wr = twiddleCos_[j * step];
+                float wi = twiddleSin_[j * step];
+                int a = start + j;
+                int b = a + half;
+
+                float tr = wr * real[b] - wi * imag[b];
+                float ti = wr * imag[b] + wi * real[b];
+                real[b] = real[a] - tr;
+                imag[b] = imag[a] - ti;
+                real[a] += tr;
+                imag[a] += ti;
+            }
+        }
+    }
+}
+
+void FFT::performRealForward(const float* input, float* real, float* imag) {
+    // Pack even samples into the real part and odd samples into the imaginary part
+    for (int i = 0; i < halfSize_; ++i) {
+        workReal_[i] = input[2 * i];
+        workImag_[i] = input[2 * i + 1];
+    }
+
+    transformComplex(workReal_.data(), workImag_.data());
+
+    // X[k] = E[k] + W^k O[k], where E/O are recovered from Z[k] and conj(Z[M-k])
+    for (int k = 0; k <= halfSize_; ++k) {
+        int index = k % halfSize_;
+        int mirror = (halfSize_ - k) % halfSize_;
+        float a = workReal_[index];
+        float b = workImag_[index];
+        float c = workReal_[mirror];
+        float d = workImag_[mirror];
+
+        float evenReal = 0.5f * (a + c);
+        float evenImag = 0.5f * (b - d);
+        float oddReal = 0.5f * (b + d);
+        float oddImag = 0.5f * (c - a);
+
+        float wr = splitCos_[k];
+        float wi = splitSin_[k];
+        real[k] = evenReal + wr * oddReal - wi * oddImag;
+        imag[k] = evenImag + wr * oddImag + wi * oddReal;
+    }
+}
+
+void FFT::computeMagnitudes(const float* input, float* magnitudes) {
+    for (int i = 0; i < size_; ++i) {
+        windowed_[i] = input[i] * windowTable_[i];
+    }
+
+    performRealForward(windowed_.data(), binReal_.data(), binImag_.data());
+
+    // One-sided spectrum: interior bins carry half the energy of each component
+    float scale = windowGain_ > 0.0f ? 2.0f / windowGain_ : 0.0f;
+    for (int k = 0; k <= halfSize_; ++k) {
+        float magnitude = std::sqrt(binReal_[k] * binReal_[k] + binImag_[k] * binImag_[k]);
+        magnitudes[k] = magnitude * ((k == 0 || k == halfSize_) ? 0.5f * scale : scale);
+    }
+}
+
+// LogFrequencyBands implementation
+void LogFrequencyBands::configure(int numBands, int fftSize, float sampleRate,
+                                  float minFrequency, float maxFrequency) {
+    numBands = std::max(1, numBands);
+    numBins_ = fftSize / 2 + 1;
+    bands_.assign(numBands, Band{0, 0, 0.0f, 0.0f});
+    if (fftSize <= 0 || sampleRate <= 0.0f) {
+        return;
+    }
+
+    float nyquist = sampleRate * 0.5f;
+    float binHz = sampleRate / static_cast<float>(fftSize);
+    maxFrequency = std::min(maxFrequency, nyquist);
+    minFrequency = std::clamp(minFrequency, binHz * 0.5f, maxFrequency * 0.5f);
+    float ratio = maxFrequency / minFrequency;
+
+    for (int b = 0; b < numBands; ++b) {
+        float lowHz = minFrequency * std::pow(ratio, static_cast<float>(b) / numBands);
+        float highHz = minFrequency * std::pow(ratio, static_cast<float>(b + 1) / numBands);
+        float centerHz = std::sqrt(lowHz * highHz);
+
+        Band& band = bands_[b];
+        band.firstBin = std::min(numBins_ - 1, static_cast<int>(std::ceil(lowHz / binHz)));
+        band.lastBin = std::min(numBins_, static_cast<int>(std::floor(highHz / binHz)) + 1);
+        band.lastBin = std::max(band.lastBin, band.firstBin);
+        band.centerBin = std::min(static_cast<float>(numBins_ - 1), centerHz / binHz);
+        band.centerHz = centerHz;
+
+        // Band lies entirely between two bins: interpolate instead of reading one of them twice
+        if (static_cast<float>(band.firstBin) * binHz >= highHz) {
+            band.lastBin = band.firstBin;
+        }
+    }
+}
+
+void LogFrequencyBands::process(const float* magnitudes, float* bands) const {
+    for (size_t b = 0; b < bands_.size(); ++b) {
+        const Band& band = bands_[b];
+        if (band.lastBin > band.firstBin) {
+            float peak = 0.0f;
+            for (int bin = band.firstBin; bin < band.lastBin; ++bin) {
+                peak = std::max(peak, magnitudes[bin]);
+            }
+            bands[b] = peak;
+        } else {
+            int lower = static_cast<int>(band.centerBin);
+            int upper = std::min(lower + 1, numBins_ - 1);
+            float fraction = band.centerBin - static_cast<float>(lower);
+            bands[b] = magnitudes[lower] + (magnitudes[upper] - magnitudes[lower]) * fraction;
+        }
+    }
+}
+
+} // namespace AIMusicHardware
@@ -0,0 +1,95 @@
+#include "../../include/audio/LoadGovernor.h"
+#include "../../include/audio/RealtimeLog.h"
+#include <algorithm>
+#include <limits>
+
+namespace AIMusicHardware {
+
+namespace {
+
+// Frames counted since a change stop growing here, well past any hold time
+constexpr int64_t kFramesSaturate = std::numeric_limits<int64_t>::max() / 2;
+
+} // namespace
+
+LoadGovernor::LoadGovernor(int sampleRate)
+    : sampleRate_(sampleRate > 0 ? sampleRate : 44100),
+      framesSinceChange_(kFramesSaturate) {
+}
+
+void LoadGovernor::setSampleRate(int sampleRate) {
+    if (sampleRate > 0) {
+        sampleRate_.store(sampleRate, std::memory_order_relaxed);
+    }
+}
+
+LoadGovernor::QualityLevel LoadGovernor::update(float loadPercent, int numFrames) {
+    const QualityLevel level = level_.load(std::memory_order_relaxed);
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        if (level != QualityLevel::Full) {
+            changeLevel(QualityLevel::Full, loadPercent);
+        }
+        return QualityLevel::Full;
+    }
+
+    const double sampleRate = sampleRate_.load(std::memory_order_relaxed);
+    const int64_t frames = std::max(numFrames, 0);
+    framesSinceChange_ = std::min(framesSinceChange_ + frames, kFramesSaturate);
+
+    if (loadPercent >= thresholds_.degradeLoad) {
+        framesBelowRestore_ = 0;
+        const auto holdFrames = static_cast<int64_t>(thresholds_.degradeHoldSeconds * sampleRate);
+        if (level < kLowestQuality && (loadPercent >= 100.0f || framesSinceChange_ >= holdFrames)) {
+            changeLevel(static_cast<QualityLevel>(static_cast<int>(level) + 1), loadPercent);
+        }
+    } else if (loadPercent < thresholds_.restoreLoad && level > QualityLevel::Full) {
+        framesBelowRestore_ += frames;
+        if (framesBelowRestore_ >= static_cast<int64_t>(thresholds_.restoreSeconds * sampleRate)) {
+            changeLevel(static_cast<QualityLevel>(static_cast<int>(level) - 1), loadPercent);
+        }
+    } else {
+        // Between the thresholds: hold the level, restart the restore time
+        framesBelowRestore_ = 0;
+    }
+
+    return level_.load(std::memory_order_relaxed);
+}
+
+void LoadGovernor::changeLevel(QualityLevel level, float loadPercent) {
+    const QualityLevel previous = level_.load(std::memory_order_relaxed);
+    level_.store(level, std::memory_order_relaxed);
+    if (level > previous) {
+        degradeCount_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        restoreCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+    framesSinceChange_ = 0;
+    framesBelowRestore_ = 0;
+
+    RT_LOG_INFO(LogCategory::Audio, "Load governor: {} at {}% load", levelName(level), loadPercent);
+
+    if (levelCallback_) {
+        levelCallback_(level);
+    }
+}
+
+RenderQuality LoadGovernor::renderQualityFor(QualityLevel level) {
+    RenderQuality quality;
+    quality.oversampling = level < QualityLevel::NoOversampling;
+    quality.maxUnison = level >= QualityLevel::ReducedUnison ? 2 : 8;
+    quality.releaseCutoff = level >= QualityLevel::EarlyVoiceStealing ? 0.1f : 0.0f;
+    return quality;
+}
+
+const char* LoadGovernor::levelName(QualityLevel level) {
+    switch (level) {
+        case QualityLevel::Full:               return "full quality";
+        case QualityLevel::NoOversampling:     return "no oversampling";
+        case QualityLevel::ReducedUnison:      return "reduced unison";
+        case QualityLevel::EarlyVoiceStealing: return "early voice stealing";
+        case QualityLevel::NoEffectTails:      return "no effect tails";
+    }
+    return "unknown";
+}
+
+} // namespace AIMusicHardware
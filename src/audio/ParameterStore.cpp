@@ -0,0 +1,198 @@
+#include "../../include/audio/ParameterStore.h"
+#include <algorithm>
+
+namespace AIMusicHardware {
+
+ParameterStore::ParameterStore(size_t queueCapacity) {
+    size_t capacity = 1;
+    while (capacity < queueCapacity) {
+        capacity <<= 1;
+    }
+    mask_ = capacity - 1;
+
+    for (auto& queue : queues_) {
+        queue.buffer.resize(capacity);
+    }
+}
+
+int ParameterStore::addParameter(const std::string& id, float defaultValue, float minValue, float maxValue) {
+    auto it = indexById_.find(id);
+    if (it != indexById_.end()) {
+        return it->second;
+    }
+
+    if (maxValue < minValue) {
+        std::swap(minValue, maxValue);
+    }
+    const float value = std::clamp(defaultValue, minValue, maxValue);
+    const int index = static_cast<int>(ids_.size());
+
+    ids_.push_back(id);
+    indexById_.emplace(id, index);
+    minValues_.push_back(minValue);
+    maxValues_.push_back(maxValue);
+    values_.push_back(value);
+    changedFlags_.push_back(0);
+    changedIndices_.reserve(ids_.size());
+
+    // Atomics cannot be moved, so the snapshot buffers are rebuilt
+    for (auto& snapshot : snapshots_) {
+        std::vector<std::atomic<float>> resized(ids_.size());
+        for (size_t i = 0; i < ids_.size(); ++i) {
+            resized[i].store(values_[i], std::memory_order_relaxed);
+        }
+        snapshot.swap(resized);
+    }
+
+    return index;
+}
+
+int ParameterStore::getIndex(const std::string& id) const {
+    auto it = indexById_.find(id);
+    return it != indexById_.end() ? it->second : -1;
+}
+
+const std::string& ParameterStore::getId(int index) const {
+    static const std::string empty;
+    if (index < 0 || index >= getParameterCount()) {
+        return empty;
+    }
+    return ids_[static_cast<size_t>(index)];
+}
+
+bool ParameterStore::push(ChangeSource source, int index, float value) {
+    SourceQueue& queue = queues_[static_cast<size_t>(source)];
+    if (index < 0 || index >= getParameterCount()) {
+        queue.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const size_t write = queue.writeIndex.load(std::memory_order_relaxed);
+    if (write - queue.readIndex.load(std::memory_order_acquire) > mask_) {
+        queue.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Change& slot = queue.buffer[write & mask_];
+    slot.sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    slot.index = index;
+    slot.value = value;
+    queue.writeIndex.store(write + 1, std::memory_order_release);
+    return true;
+}
+
+size_t ParameterStore::processUpdates() {
+    for (int index : changedIndices_) {
+        changedFlags_[static_cast<size_t>(index)] = 0;
+    }
+    changedIndices_.clear();
+
+    // Only what was queued before now; later pushes wait for the next block
+    std::array<size_t, kNumSources> read;
+    std::array<size_t, kNumSources> end;
+    for (int s = 0; s < kNumSources; ++s) {
+        read[s] = queues_[s].readIndex.load(std::memory_order_relaxed);
+        end[s] = queues_[s].writeIndex.load(std::memory_order_acquire);
+    }
+
+    size_t applied = 0;
+    for (;;) {
+        // Next change in push order is the lowest sequence at any queue head
+        int next = -1;
+        uint64_t lowest = 0;
+        for (int s = 0; s < kNumSources; ++s) {
+            if (read[s] != end[s]) {
+                const uint64_t sequence = queues_[s].buffer[read[s] & mask_].sequence;
+                if (next < 0 || sequence < lowest) {
+                    next = s;
+                    lowest = sequence;
+                }
+            }
+        }
+        if (next < 0) {
+            break;
+        }
+
+        const Change& change = queues_[next].buffer[read[next] & mask_];
+        setValue(change.index, change.value);
+        ++read[next];
+        ++applied;
+    }
+
+    for (int s = 0; s < kNumSources; ++s) {
+        queues_[s].readIndex.store(read[s], std::memory_order_release);
+    }
+    return applied;
+}
+
+void ParameterStore::setValue(int index, float value) {
+    if (index < 0 || index >= getParameterCount()) {
+        return;
+    }
+    const size_t i = static_cast<size_t>(index);
+    value = std::clamp(value, minValues_[i], maxValues_[i]);
+    if (values_[i] != value) {
+        values_[i] = value;
+        markChanged(index);
+    }
+}
+
+void ParameterStore::markChanged(int index) {
+    dirty_ = true;
+    uint8_t& flag = changedFlags_[static_cast<size_t>(index)];
+    if (!flag) {
+        flag = 1;
+        changedIndices_.push_back(index);
+    }
+}
+
+bool ParameterStore::publishSnapshot() {
+    if (!dirty_) {
+        return false;
+    }
+    dirty_ = false;
+
+    // Announce the write before touching the buffer a reader of the
+    // previous-but-one version may still be copying
+    const uint64_t next = version_.load(std::memory_order_relaxed) + 1;
+    writing_.store(next, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto& snapshot = snapshots_[next & 1];
+    for (size_t i = 0; i < values_.size(); ++i) {
+        snapshot[i].store(values_[i], std::memory_order_relaxed);
+    }
+
+    version_.store(next, std::memory_order_release);
+    return true;
+}
+
+uint64_t ParameterStore::readSnapshot(std::vector<float>& out) const {
+    const size_t count = ids_.size();
+    out.resize(count);
+
+    for (;;) {
+        const uint64_t version = version_.load(std::memory_order_acquire);
+        const auto& snapshot = snapshots_[version & 1];
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = snapshot[i].load(std::memory_order_relaxed);
+        }
+
+        // If the audio thread started reusing this buffer, copy again
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (writing_.load(std::memory_order_relaxed) <= version + 1) {
+            return version;
+        }
+    }
+}
+
+uint64_t ParameterStore::getDroppedCount(ChangeSource source) const {
+    return queues_[static_cast<size_t>(source)].dropped.load(std::memory_order_relaxed);
+}
+
+size_t ParameterStore::getQueuedCount(ChangeSource source) const {
+    const SourceQueue& queue = queues_[static_cast<size_t>(source)];
+    return queue.writeIndex.load(std::memory_order_acquire) - queue.readIndex.load(std::memory_order_acquire);
+}
+
+} // namespace AIMusicHardware
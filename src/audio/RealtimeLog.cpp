@@ -0,0 +1,271 @@
+#include "../../include/audio/RealtimeLog.h"
+#include <algorithm>
+#include <sstream>
+
+namespace AIMusicHardware {
+
+namespace {
+
+std::atomic<uint64_t> nextInstanceId{1};
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+struct RealtimeLog::Ring {
+    explicit Ring(size_t capacity) : records(capacity) {}
+
+    std::vector<Record> records;
+    std::thread::id threadId;
+    uint64_t reportedDrops = 0;  // Drain thread only
+
+    // Monotonic counters, wrapped with the capacity; kept on separate cache lines
+    alignas(64) std::atomic<size_t> writeIndex{0};
+    alignas(64) std::atomic<size_t> readIndex{0};
+    alignas(64) std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> retired{false};
+};
+
+RealtimeLog::RealtimeLog(size_t ringCapacity)
+    : ringCapacity_(roundUpToPowerOfTwo(std::max<size_t>(ringCapacity, 2))),
+      instanceId_(nextInstanceId.fetch_add(1)),
+      logger_(&PresetLogger::getInstance()) {
+}
+
+RealtimeLog::~RealtimeLog() {
+    stop();
+    drain();
+}
+
+RealtimeLog& RealtimeLog::getInstance() {
+    static RealtimeLog instance;
+    static const bool started = (instance.start(), true);
+    (void)started;
+    return instance;
+}
+
+//------------------------------------------------------------------------------
+// Producers
+//------------------------------------------------------------------------------
+
+void RealtimeLog::encodeText(Record& record, int index, const char* text, size_t length) {
+    const size_t offset = record.textUsed;
+    length = std::min(length, kMaxText - offset);
+    std::memcpy(record.text + offset, text, length);
+    record.textUsed = static_cast<uint8_t>(offset + length);
+    record.types[index] = ArgType::Text;
+    record.values[index].u = offset | (static_cast<uint64_t>(length) << 16);
+}
+
+void RealtimeLog::push(const Record& record) {
+    Ring* ring = getThreadRing();
+
+    const size_t write = ring->writeIndex.load(std::memory_order_relaxed);
+    if (write - ring->readIndex.load(std::memory_order_acquire) >= ring->records.size()) {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring->records[write & (ring->records.size() - 1)] = record;
+    ring->writeIndex.store(write + 1, std::memory_order_release);
+}
+
+RealtimeLog::Ring* RealtimeLog::getThreadRing() {
+    // The calling thread's ring; retired when the thread exits so another can reuse it
+    struct ThreadRing {
+        uint64_t instanceId = 0;
+        std::shared_ptr<Ring> ring;
+
+        ~ThreadRing() {
+            if (ring) {
+                ring->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+    thread_local ThreadRing current;
+
+    if (current.instanceId == instanceId_) {
+        return current.ring.get();
+    }
+
+    // First record from this thread to this log
+    if (current.ring) {
+        current.ring->retired.store(true, std::memory_order_release);
+    }
+
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    std::shared_ptr<Ring> ring;
+    for (const auto& candidate : rings_) {
+        if (candidate->retired.load(std::memory_order_acquire) &&
+            candidate->readIndex.load(std::memory_order_acquire) ==
+                candidate->writeIndex.load(std::memory_order_relaxed)) {
+            ring = candidate;
+            break;
+        }
+    }
+    if (!ring) {
+        ring = std::make_shared<Ring>(ringCapacity_);
+        rings_.push_back(ring);
+    }
+    ring->threadId = std::this_thread::get_id();
+    ring->retired.store(false, std::memory_order_release);
+
+    current.instanceId = instanceId_;
+    current.ring = ring;
+    return ring.get();
+}
+
+void RealtimeLog::prepareThread() {
+    getThreadRing();
+}
+
+//------------------------------------------------------------------------------
+// Consumer
+//------------------------------------------------------------------------------
+
+void RealtimeLog::setLogger(PresetLogger* logger) {
+    std::lock_guard<std::mutex> lock(drainMutex_);
+    logger_ = logger;
+}
+
+void RealtimeLog::start(std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(threadMutex_);
+    if (running_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    stopRequested_ = false;
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&RealtimeLog::drainThread, this, interval);
+}
+
+void RealtimeLog::stop() {
+    {
+        std::lock_guard<std::mutex> lock(threadMutex_);
+        if (!running_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        stopRequested_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    running_.store(false, std::memory_order_release);
+}
+
+void RealtimeLog::drainThread(std::chrono::milliseconds interval) {
+    std::unique_lock<std::mutex> lock(threadMutex_);
+    while (!stopRequested_) {
+        wake_.wait_for(lock, interval, [this] { return stopRequested_; });
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+    lock.unlock();
+
+    // stop() may have been requested while the last pass was running; take
+    // whatever was written after that pass looked at the rings
+    drain();
+}
+
+size_t RealtimeLog::drain() {
+    std::lock_guard<std::mutex> drainLock(drainMutex_);
+
+    pending_.clear();
+    pendingThreads_.clear();
+    std::vector<std::pair<std::thread::id, uint64_t>> drops;
+
+    // Take everything queued so far; producers keep writing behind us
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex_);
+        for (const auto& ring : rings_) {
+            const size_t end = ring->writeIndex.load(std::memory_order_acquire);
+            const size_t mask = ring->records.size() - 1;
+            size_t read = ring->readIndex.load(std::memory_order_relaxed);
+            for (; read != end; ++read) {
+                pending_.push_back(ring->records[read & mask]);
+                pendingThreads_.push_back(ring->threadId);
+            }
+            ring->readIndex.store(read, std::memory_order_release);
+
+            const uint64_t dropped = ring->dropped.load(std::memory_order_relaxed);
+            if (dropped != ring->reportedDrops) {
+                drops.emplace_back(ring->threadId, dropped - ring->reportedDrops);
+                ring->reportedDrops = dropped;
+            }
+        }
+    }
+
+    // Interleave the threads' records by time
+    order_.resize(pending_.size());
+    for (size_t i = 0; i < order_.size(); ++i) {
+        order_[i] = i;
+    }
+    std::stable_sort(order_.begin(), order_.end(),
+                     [this](size_t a, size_t b) { return pending_[a].time < pending_[b].time; });
+
+    if (logger_) {
+        for (size_t i : order_) {
+            const Record& record = pending_[i];
+            const RealtimeLogSite& site = *record.site;
+            LogEntry entry(site.level, site.category, format(record), site.function, site.file, site.line);
+            entry.timestamp = std::chrono::system_clock::time_point(std::chrono::system_clock::duration(record.time));
+            entry.threadId = pendingThreads_[i];
+            logger_->log(entry);
+        }
+        for (const auto& drop : drops) {
+            LogEntry entry(LogLevel::Warning, LogCategory::Audio,
+                           "Real-time log ring full, dropped " + std::to_string(drop.second) + " records");
+            entry.threadId = drop.first;
+            logger_->log(entry);
+        }
+    }
+
+    drained_.fetch_add(pending_.size(), std::memory_order_relaxed);
+    return pending_.size();
+}
+
+std::string RealtimeLog::format(const Record& record) {
+    std::ostringstream out;
+    int arg = 0;
+    for (const char* c = record.site->format; *c; ++c) {
+        if (c[0] != '{' || c[1] != '}' || arg >= record.numArgs) {
+            out << *c;
+            continue;
+        }
+        const Record::Value& value = record.values[arg];
+        switch (record.types[arg]) {
+            case ArgType::Int:    out << value.i; break;
+            case ArgType::UInt:   out << value.u; break;
+            case ArgType::Double: out << value.d; break;
+            case ArgType::Bool:   out << (value.u ? "true" : "false"); break;
+            case ArgType::Text:
+                out.write(record.text + (value.u & 0xffff), static_cast<std::streamsize>(value.u >> 16));
+                break;
+        }
+        ++arg;
+        ++c;
+    }
+    return out.str();
+}
+
+uint64_t RealtimeLog::getDroppedCount() const {
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    uint64_t dropped = 0;
+    for (const auto& ring : rings_) {
+        dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+size_t RealtimeLog::getRingCount() const {
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    return rings_.size();
+}
+
+} // namespace AIMusicHardware
@@ -1,9 +1,10 @@
 #include "../../include/audio/Synthesizer.h"
+#include "../../include/audio/RealtimeLog.h"
+#include "../../include/audio/TraceRecorder.h"
 #include "../../include/sequencer/Sequencer.h"
 #include <cmath>
 #include <algorithm>
 #include <random>
-#include <iostream>
 
 namespace AIMusicHardware {
 
@@ -96,11 +97,25 @@ private:
 // Synthesizer implementation
 Synthesizer::Synthesizer(int sampleRate)
     : Processor(sampleRate),
+      smoothing_(sampleRate, 8),
       currentOscType_(OscillatorType::Sine) {
       
     // Create VoiceManager
     voiceManager_ = std::make_unique<VoiceManager>(sampleRate);
     
+    // Parameters that click when they jump ramp on the audio clock instead;
+    // initial values match the ModEnvelope and oscillator defaults
+    smoothing_.addParameter(0.01f, SmoothingEngine::RampType::Exponential);  // kSmoothAttack
+    smoothing_.addParameter(0.1f, SmoothingEngine::RampType::Exponential);   // kSmoothDecay
+    smoothing_.addParameter(0.7f);                                           // kSmoothSustain
+    smoothing_.addParameter(0.5f, SmoothingEngine::RampType::Exponential);   // kSmoothRelease
+    smoothing_.addParameter(oscTypeToFramePosition(currentOscType_));        // kSmoothFrame
+    smoothing_.addParameter(0.7f);                                           // kSmoothVolume
+    
+    for (const auto& info : kSynthParameters) {
+        parameterValues_[static_cast<size_t>(info.parameter)].store(info.defaultValue, std::memory_order_relaxed);
+    }
+    
     // Create default wavetable
     createDefaultWavetable();
     
@@ -139,6 +154,9 @@ void Synthesizer::createModulationSources() {
     lfo1->setFrequency(1.0f);  // 1 Hz
     lfo2->setFrequency(0.5f);  // 0.5 Hz
     
+    // Kept for parameter changes, which must not look sources up by name
+    lfos_ = {lfo1.get(), lfo2.get()};
+    
     // Add to modulation matrix
     modulationMatrix_.addSource(std::move(lfo1));
     modulationMatrix_.addSource(std::move(lfo2));
@@ -154,14 +172,13 @@ void Synthesizer::setSampleRate(int sampleRate) {
     }
 
     effectChain_.setSampleRate(sampleRate);
+    smoothing_.setSampleRate(sampleRate);
     
     // Update LFOs
-    if (auto lfo1 = dynamic_cast<LfoSource*>(modulationMatrix_.getSource("LFO1"))) {
-        lfo1->setSampleRate(sampleRate);
-    }
-    
-    if (auto lfo2 = dynamic_cast<LfoSource*>(modulationMatrix_.getSource("LFO2"))) {
-        lfo2->setSampleRate(sampleRate);
+    for (auto* lfo : lfos_) {
+        if (lfo) {
+            lfo->setSampleRate(sampleRate);
+        }
     }
 }
 
@@ -198,259 +215,125 @@ void Synthesizer::allNotesOff(int channel) {
 void Synthesizer::sustainOn(int channel) {
     if (voiceManager_) {
         voiceManager_->sustainOn(channel);
-        std::cout << "Sustain pedal on for channel " << channel << std::endl;
+        RT_LOG_DEBUG(LogCategory::Audio, "Sustain pedal on for channel {}", channel);
     }
 }
 
 void Synthesizer::sustainOff(int channel) {
     if (voiceManager_) {
         voiceManager_->sustainOff(channel);
-        std::cout << "Sustain pedal off for channel " << channel << std::endl;
+        RT_LOG_DEBUG(LogCategory::Audio, "Sustain pedal off for channel {}", channel);
     }
 }
 
 void Synthesizer::setPitchBend(float value, int channel) {
     if (voiceManager_) {
         voiceManager_->setPitchBend(value, channel);
-        std::cout << "Pitch bend value " << value << " for channel " << channel << std::endl;
+        RT_LOG_DEBUG(LogCategory::Audio, "Pitch bend value {} for channel {}", value, channel);
     }
 }
 
 void Synthesizer::setAftertouch(int note, float pressure, int channel) {
     if (voiceManager_) {
         voiceManager_->setAftertouch(note, pressure, channel);
-        std::cout << "Aftertouch for note " << note << " with pressure " << pressure 
-                  << " on channel " << channel << std::endl;
+        RT_LOG_DEBUG(LogCategory::Audio, "Aftertouch for note {} with pressure {} on channel {}", note, pressure,
+                     channel);
     }
 }
 
 void Synthesizer::setChannelPressure(float pressure, int channel) {
     if (voiceManager_) {
         voiceManager_->setChannelPressure(pressure, channel);
-        std::cout << "Channel pressure " << pressure << " for channel " << channel << std::endl;
+        RT_LOG_DEBUG(LogCategory::Audio, "Channel pressure {} for channel {}", pressure, channel);
     }
 }
 
 void Synthesizer::resetAllControllers() {
     if (voiceManager_) {
         voiceManager_->resetAllControllers();
-        std::cout << "Resetting all controllers" << std::endl;
+        RT_LOG_DEBUG(LogCategory::Audio, "Resetting all controllers");
+    }
+}
+
+static_assert(kNumSynthParameters <= 32, "changedParameters_ has one bit per parameter");
+
+const std::array<Synthesizer::ParameterHandler, kNumSynthParameters> Synthesizer::kParameterHandlers = {{
+    &Synthesizer::applyOscillatorType,                  // OscillatorType
+    &Synthesizer::setSmoothedTarget<kSmoothFrame>,      // OscillatorFrame
+    nullptr,                                            // FilterCutoff (no filter in VoiceManager yet)
+    nullptr,                                            // FilterResonance
+    &Synthesizer::setSmoothedTarget<kSmoothVolume>,     // MasterVolume
+    &Synthesizer::setSmoothedTarget<kSmoothAttack>,     // EnvelopeAttack
+    &Synthesizer::setSmoothedTarget<kSmoothDecay>,      // EnvelopeDecay
+    &Synthesizer::setSmoothedTarget<kSmoothSustain>,    // EnvelopeSustain
+    &Synthesizer::setSmoothedTarget<kSmoothRelease>,    // EnvelopeRelease
+    nullptr,                                            // VoiceCount (applied by setParameter)
+    &Synthesizer::applyLfoRate<0>,                      // Lfo1Rate
+    &Synthesizer::applyLfoShape<0>,                     // Lfo1Shape
+    &Synthesizer::applyLfoRate<1>,                      // Lfo2Rate
+    &Synthesizer::applyLfoShape<1>,                     // Lfo2Shape
+}};
+
+void Synthesizer::setParameter(SynthParamId parameter, float value) {
+    const int index = static_cast<int>(parameter);
+    if (index < 0 || index >= kNumSynthParameters) {
+        return;
     }
-}
 
-void Synthesizer::setParameter(const std::string& paramId, float value) {
-    // We'll need a parameter system for this in the future
-    // For now, just handle a few basic parameters
-
-    if (paramId == "oscillator_frame") {
-        if (voiceManager_) {
-            // Update oscillator frame position in all voices
-            for (int i = 0; i < voiceManager_->getMaxVoices(); ++i) {
-                if (auto* voice = voiceManager_->getVoice(i)) {
-                    if (auto* osc = voice->getOscillator()) {
-                        osc->setFramePosition(value);
-                    }
-                }
-            }
-            std::cout << "Setting oscillator frame to " << value << std::endl;
-        }
+    const SynthParameterInfo& info = kSynthParameters[static_cast<size_t>(index)];
+    value = std::clamp(value, info.minValue, info.maxValue);
+    if (info.stepped) {
+        value = std::floor(value);
     }
-    else if (paramId == "oscillator_type") {
-        // Convert 0-4 float value to oscillator type
-        int typeIndex = static_cast<int>(value);
-        if (typeIndex >= 0 && typeIndex <= 4) {
-            setOscillatorType(static_cast<OscillatorType>(typeIndex));
-        }
-    }
-    else if (paramId == "filter_cutoff") {
-        // For future implementation - will need to add filter to VoiceManager
-        std::cout << "Setting filter cutoff to " << value << std::endl;
-    }
-    else if (paramId == "filter_resonance") {
-        // For future implementation - will need to add filter to VoiceManager
-        std::cout << "Setting filter resonance to " << value << std::endl;
-    }
-    else if (paramId == "master_volume") {
-        // For future implementation - adjust master volume
-        std::cout << "Setting master volume to " << value << std::endl;
-    }
-    else if (paramId == "envelope_attack") {
-        // Update all voices' attack time
-        if (voiceManager_) {
-            for (int i = 0; i < voiceManager_->getMaxVoices(); ++i) {
-                if (auto* voice = voiceManager_->getVoice(i)) {
-                    if (auto* envelope = voice->getEnvelope()) {
-                        envelope->setAttack(value);
-                    }
-                }
-            }
-        }
-        std::cout << "Setting envelope attack to " << value << " seconds" << std::endl;
-    }
-    else if (paramId == "envelope_decay") {
-        // Update all voices' decay time
-        if (voiceManager_) {
-            for (int i = 0; i < voiceManager_->getMaxVoices(); ++i) {
-                if (auto* voice = voiceManager_->getVoice(i)) {
-                    if (auto* envelope = voice->getEnvelope()) {
-                        envelope->setDecay(value);
-                    }
-                }
-            }
-        }
-        std::cout << "Setting envelope decay to " << value << " seconds" << std::endl;
-    }
-    else if (paramId == "envelope_sustain") {
-        // Update all voices' sustain level
-        if (voiceManager_) {
-            for (int i = 0; i < voiceManager_->getMaxVoices(); ++i) {
-                if (auto* voice = voiceManager_->getVoice(i)) {
-                    if (auto* envelope = voice->getEnvelope()) {
-                        envelope->setSustain(value);
-                    }
-                }
-            }
-        }
-        std::cout << "Setting envelope sustain to " << value << std::endl;
-    }
-    else if (paramId == "envelope_release") {
-        // Update all voices' release time
-        if (voiceManager_) {
-            for (int i = 0; i < voiceManager_->getMaxVoices(); ++i) {
-                if (auto* voice = voiceManager_->getVoice(i)) {
-                    if (auto* envelope = voice->getEnvelope()) {
-                        envelope->setRelease(value);
-                    }
-                }
-            }
-        }
-        std::cout << "Setting envelope release to " << value << " seconds" << std::endl;
+    parameterValues_[static_cast<size_t>(index)].store(value, std::memory_order_relaxed);
+
+    if (parameter == SynthParamId::VoiceCount) {
+        // Reallocates voices, so never on the audio thread
+        setVoiceCount(static_cast<int>(value));
+        return;
     }
-    else if (paramId == "voice_count") {
-        // Set number of voices
-        int count = static_cast<int>(value);
-        if (count > 0) {
-            setVoiceCount(count);
-        }
+    changedParameters_.fetch_or(1u << index, std::memory_order_release);
+}
+
+float Synthesizer::getParameter(SynthParamId parameter) const {
+    if (parameter == SynthParamId::VoiceCount) {
+        return static_cast<float>(getVoiceCount());
     }
-    else if (paramId.find("lfo") == 0) {
-        // Handle LFO parameters (lfo1_rate, lfo1_shape, etc.)
-        std::cout << "Setting " << paramId << " to " << value << std::endl;
-
-        // Parse LFO index and parameter name
-        size_t underscorePos = paramId.find('_');
-        if (underscorePos != std::string::npos && underscorePos < paramId.size() - 1) {
-            std::string lfoName = paramId.substr(0, underscorePos); // "lfo1", "lfo2", etc.
-            std::string paramName = paramId.substr(underscorePos + 1); // "rate", "shape", etc.
-
-            if (auto* source = modulationMatrix_.getSource(lfoName)) {
-                if (auto* lfo = dynamic_cast<LfoSource*>(source)) {
-                    if (paramName == "rate") {
-                        lfo->setFrequency(value);
-                    }
-                    else if (paramName == "shape") {
-                        // Convert 0-4 float value to LFO shape
-                        int shapeIndex = static_cast<int>(value);
-                        if (shapeIndex >= 0 && shapeIndex <= 4) {
-                            lfo->setShape(static_cast<LfoSource::WaveShape>(shapeIndex));
-                        }
-                    }
-                }
-            }
-        }
+    const int index = static_cast<int>(parameter);
+    if (index < 0 || index >= kNumSynthParameters) {
+        return 0.0f;
     }
-    else {
-        std::cout << "Unknown parameter: " << paramId << std::endl;
+    return parameterValues_[static_cast<size_t>(index)].load(std::memory_order_relaxed);
+}
+
+bool Synthesizer::setParameter(const std::string& paramId, float value) {
+    const int index = findSynthParameter(paramId);
+    if (index < 0) {
+        return false;
     }
+    setParameter(static_cast<SynthParamId>(index), value);
+    return true;
 }
 
 float Synthesizer::getParameter(const std::string& paramId) const {
-    // Getting actual parameters
+    const int index = findSynthParameter(paramId);
+    return index >= 0 ? getParameter(static_cast<SynthParamId>(index)) : 0.0f;
+}
 
-    if (paramId == "oscillator_frame") {
-        // In a real implementation, we'd get this from the first voice or from a stored value
-        // For now, return based on current oscillator type
-        return oscTypeToFramePosition(currentOscType_);
-    }
-    else if (paramId == "oscillator_type") {
-        return static_cast<float>(currentOscType_);
-    }
-    else if (paramId == "filter_cutoff") {
-        // For future implementation - will need to add filter to VoiceManager
-        return 1.0f; // Default value
-    }
-    else if (paramId == "filter_resonance") {
-        // For future implementation - will need to add filter to VoiceManager
-        return 0.5f; // Default value
-    }
-    else if (paramId == "master_volume") {
-        // For future implementation - get master volume
-        return 0.7f; // Default value
+std::array<float, kNumSynthParameters> Synthesizer::getParameterValues() const {
+    std::array<float, kNumSynthParameters> values;
+    for (int i = 0; i < kNumSynthParameters; ++i) {
+        values[static_cast<size_t>(i)] = getParameter(static_cast<SynthParamId>(i));
     }
-    else if (paramId == "envelope_attack") {
-        return 0.01f; // Default 10ms attack
-    }
-    else if (paramId == "envelope_decay") {
-        return 0.1f; // Default 100ms decay
-    }
-    else if (paramId == "envelope_sustain") {
-        return 0.7f; // Default 70% sustain
-    }
-    else if (paramId == "envelope_release") {
-        return 0.5f; // Default 500ms release
-    }
-    else if (paramId == "voice_count") {
-        return static_cast<float>(getVoiceCount());
-    }
-    else if (paramId.find("lfo") == 0) {
-        // Handle LFO parameters (lfo1_rate, lfo1_shape, etc.)
-
-        // Parse LFO index and parameter name
-        size_t underscorePos = paramId.find('_');
-        if (underscorePos != std::string::npos && underscorePos < paramId.size() - 1) {
-            std::string lfoName = paramId.substr(0, underscorePos); // "lfo1", "lfo2", etc.
-            std::string paramName = paramId.substr(underscorePos + 1); // "rate", "shape", etc.
-
-            if (auto* source = modulationMatrix_.getSource(lfoName)) {
-                if (auto* lfo = dynamic_cast<LfoSource*>(source)) {
-                    if (paramName == "rate") {
-                        // LFO frequency is private, we would need a getter
-                        return 1.0f; // Default value
-                    }
-                    else if (paramName == "shape") {
-                        // LFO shape is private, we would need a getter
-                        return 0.0f; // Default value (sine)
-                    }
-                }
-            }
-        }
-    }
-
-    // Unknown parameter
-    return 0.0f;
+    return values;
 }
 
 std::map<std::string, float> Synthesizer::getAllParameters() const {
     std::map<std::string, float> parameters;
-
-    // Store core synthesizer parameters
-    parameters["oscillator_type"] = static_cast<float>(currentOscType_);
-    parameters["oscillator_frame"] = oscTypeToFramePosition(currentOscType_);
-    parameters["voice_count"] = static_cast<float>(getVoiceCount());
-    parameters["master_volume"] = 0.7f; // Default value for now
-
-    // Future parameters to add when implemented:
-    parameters["filter_cutoff"] = 1.0f;
-    parameters["filter_resonance"] = 0.5f;
-
-    // LFO Parameters
-    parameters["lfo1_rate"] = 1.0f;
-    parameters["lfo1_shape"] = 0.0f; // Sine
-    parameters["lfo2_rate"] = 0.5f;
-    parameters["lfo2_shape"] = 0.0f; // Sine
-
-    // Add modulation connections when implemented
-
+    const auto values = getParameterValues();
+    for (const auto& info : kSynthParameters) {
+        parameters.emplace(std::string(info.id), values[static_cast<size_t>(info.parameter)]);
+    }
     return parameters;
 }
 
@@ -461,26 +344,47 @@ void Synthesizer::setAllParameters(const std::map<std::string, float>& parameter
     }
 }
 
-void Synthesizer::setOscillatorType(OscillatorType type) {
-    currentOscType_ = type;
+void Synthesizer::applyParameterChanges() {
+    uint32_t changed = changedParameters_.exchange(0, std::memory_order_acquire);
+    for (size_t index = 0; changed; ++index, changed >>= 1) {
+        if (!(changed & 1u)) {
+            continue;
+        }
+        if (const ParameterHandler handler = kParameterHandlers[index]) {
+            (this->*handler)(parameterValues_[index].load(std::memory_order_relaxed));
+        }
+    }
+}
 
-    // Convert oscillator type to wavetable frame position
-    float framePos = oscTypeToFramePosition(type);
+void Synthesizer::applyOscillatorType(float value) {
+    currentOscType_ = static_cast<OscillatorType>(static_cast<int>(value));
 
-    // Update frame position in all active voices
-    if (voiceManager_) {
-        // Iterate through all voices and set their oscillator's frame position
-        for (int i = 0; i < voiceManager_->getMaxVoices(); ++i) {
-            if (auto* voice = voiceManager_->getVoice(i)) {
-                if (auto* osc = voice->getOscillator()) {
-                    osc->setFramePosition(framePos);
-                }
-            }
-        }
+    // The type selects a frame of the default wavetable
+    const float framePos = oscTypeToFramePosition(currentOscType_);
+    parameterValues_[static_cast<size_t>(SynthParamId::OscillatorFrame)].store(framePos, std::memory_order_relaxed);
+    smoothing_.setTarget(kSmoothFrame, framePos);
+}
+
+template <int Lfo>
+void Synthesizer::applyLfoRate(float value) {
+    if (lfos_[Lfo]) {
+        lfos_[Lfo]->setFrequency(value);
     }
+}
 
-    std::cout << "Oscillator type changed to " << static_cast<int>(type)
-              << " (frame position: " << framePos << ")" << std::endl;
+template <int Lfo>
+void Synthesizer::applyLfoShape(float value) {
+    if (lfos_[Lfo]) {
+        lfos_[Lfo]->setShape(static_cast<LfoSource::WaveShape>(static_cast<int>(value)));
+    }
+}
+
+void Synthesizer::setOscillatorType(OscillatorType type) {
+    // Frame position follows at the next block
+    setParameter(SynthParamId::OscillatorType, static_cast<float>(type));
+
+    RT_LOG_DEBUG(LogCategory::Audio, "Oscillator type changed to {} (frame position: {})", type,
+                 oscTypeToFramePosition(type));
 }
 
 float Synthesizer::oscTypeToFramePosition(OscillatorType type) const {
@@ -514,6 +418,9 @@ void Synthesizer::setWavetable(std::shared_ptr<Wavetable> wavetable) {
 void Synthesizer::setVoiceCount(int count) {
     if (voiceManager_) {
         voiceManager_->setMaxVoices(count);
+        
+        // New voices start from envelope and oscillator defaults
+        applySmoothedParameters(true);
     }
 }
 
@@ -521,10 +428,21 @@ int Synthesizer::getVoiceCount() const {
     return voiceManager_ ? voiceManager_->getMaxVoices() : 0;
 }
 
+int Synthesizer::getActiveVoiceCount() const {
+    return voiceManager_ ? voiceManager_->getActiveVoiceCount() : 0;
+}
+
+void Synthesizer::setRenderQuality(const RenderQuality& quality) {
+    if (voiceManager_) {
+        voiceManager_->setRenderQuality(quality);
+    }
+}
+
 void Synthesizer::process(float* buffer, int numFrames) {
     if (!enabled_) {
         return;
     }
+    AIMUSIC_TRACE_SCOPE("Synthesizer::process");
     
     // Clear buffer
     std::fill(buffer, buffer + numFrames * 2, 0.0f);
@@ -532,6 +450,12 @@ void Synthesizer::process(float* buffer, int numFrames) {
     // Update modulation matrix
     modulationMatrix_.update();
     
+    // Apply parameters set since the last block, advance the ramps by this
+    // block and hand the new values to the voices
+    applyParameterChanges();
+    smoothing_.process(numFrames);
+    applySmoothedParameters(false);
+    
     // Process voices through voice manager
     if (voiceManager_) {
         voiceManager_->process(buffer, numFrames);
@@ -540,11 +464,46 @@ void Synthesizer::process(float* buffer, int numFrames) {
     // Process effects chain
     effectChain_.process(buffer, numFrames);
     
-    // Final limiter to prevent clipping
-    const float masterVolume = 0.7f;
-    for (int i = 0; i < numFrames * 2; ++i) {
-        buffer[i] *= masterVolume;
-        buffer[i] = std::clamp(buffer[i], -1.0f, 1.0f);
+    // Master volume, ramped per sample across the block, then a final limiter to prevent clipping
+    const float volumeStart = smoothing_.getBlockStartValue(kSmoothVolume);
+    const float volumeStep = (smoothing_.getValue(kSmoothVolume) - volumeStart) / static_cast<float>(numFrames);
+    for (int i = 0; i < numFrames; ++i) {
+        const float masterVolume = volumeStart + volumeStep * static_cast<float>(i + 1);
+        buffer[i * 2] = std::clamp(buffer[i * 2] * masterVolume, -1.0f, 1.0f);
+        buffer[i * 2 + 1] = std::clamp(buffer[i * 2 + 1] * masterVolume, -1.0f, 1.0f);
+    }
+}
+
+void Synthesizer::applySmoothedParameters(bool force) {
+    if (!voiceManager_) {
+        return;
+    }
+    
+    const bool attack = force || smoothing_.hasChanged(kSmoothAttack);
+    const bool decay = force || smoothing_.hasChanged(kSmoothDecay);
+    const bool sustain = force || smoothing_.hasChanged(kSmoothSustain);
+    const bool release = force || smoothing_.hasChanged(kSmoothRelease);
+    const bool frame = force || smoothing_.hasChanged(kSmoothFrame);
+    if (!(attack || decay || sustain || release || frame)) {
+        return;
+    }
+    
+    for (int i = 0; i < voiceManager_->getMaxVoices(); ++i) {
+        Voice* voice = voiceManager_->getVoice(i);
+        if (!voice) {
+            continue;
+        }
+        if (auto* envelope = voice->getEnvelope()) {
+            if (attack) envelope->setAttack(smoothing_.getValue(kSmoothAttack));
+            if (decay) envelope->setDecay(smoothing_.getValue(kSmoothDecay));
+            if (sustain) envelope->setSustain(smoothing_.getValue(kSmoothSustain));
+            if (release) envelope->setRelease(smoothing_.getValue(kSmoothRelease));
+        }
+        if (frame) {
+            if (auto* osc = voice->getOscillator()) {
+                osc->setFramePosition(smoothing_.getValue(kSmoothFrame));
+            }
+        }
     }
 }
 
@@ -0,0 +1,244 @@
+#include "../../include/audio/TraceRecorder.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace AIMusicHardware {
+
+struct TraceRecorder::Ring {
+    explicit Ring(size_t capacity) : events(capacity) {}
+
+    // Fields are relaxed atomics so an export can read a slot the owner is
+    // overwriting; such slots are recognised by index and skipped
+    struct Event {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> start{0};
+        std::atomic<uint64_t> end{0};
+    };
+
+    std::vector<Event> events;
+    std::string threadName;
+    int threadId = 0;
+
+    alignas(64) std::atomic<size_t> writeIndex{0};
+    std::atomic<size_t> clearedIndex{0};
+    std::atomic<bool> retired{false};
+};
+
+namespace {
+
+struct ExportedEvent {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+    int threadId;
+};
+
+void appendJsonString(std::ostringstream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) >= 0x20) {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+TraceRecorder::TraceRecorder()
+    : originTicks_(readTraceTimestamp()),
+      originTime_(std::chrono::steady_clock::now()) {
+}
+
+TraceRecorder::~TraceRecorder() = default;
+
+TraceRecorder& TraceRecorder::getInstance() {
+    static TraceRecorder instance;
+    return instance;
+}
+
+void TraceRecorder::setCapacity(size_t eventsPerThread) {
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    capacity_ = std::max<size_t>(eventsPerThread, 16);
+}
+
+size_t TraceRecorder::getCapacity() const {
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    return capacity_;
+}
+
+TraceRecorder::Ring* TraceRecorder::getThreadRing() {
+    // The calling thread's ring; retired when the thread exits so another can reuse it
+    struct ThreadRing {
+        std::shared_ptr<Ring> ring;
+
+        ~ThreadRing() {
+            if (ring) {
+                ring->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+    thread_local ThreadRing current;
+
+    if (current.ring) {
+        return current.ring.get();
+    }
+
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    std::shared_ptr<Ring> ring;
+    for (const auto& candidate : rings_) {
+        if (candidate->retired.load(std::memory_order_acquire) && candidate->events.size() == capacity_) {
+            ring = candidate;
+            break;
+        }
+    }
+    if (ring) {
+        ring->clearedIndex.store(ring->writeIndex.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        ring->threadName.clear();
+        ring->retired.store(false, std::memory_order_release);
+    } else {
+        ring = std::make_shared<Ring>(capacity_);
+        ring->threadId = static_cast<int>(rings_.size()) + 1;
+        rings_.push_back(ring);
+    }
+
+    current.ring = ring;
+    return ring.get();
+}
+
+void TraceRecorder::prepareThread(const std::string& name) {
+    Ring* ring = getThreadRing();
+    if (!name.empty()) {
+        std::lock_guard<std::mutex> lock(ringsMutex_);
+        ring->threadName = name;
+    }
+}
+
+const char* TraceRecorder::internName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(namesMutex_);
+    // Set nodes never move, so the pointer stays valid
+    return names_.insert(name).first->c_str();
+}
+
+void TraceRecorder::record(const char* name, uint64_t start, uint64_t end) {
+    Ring* ring = getThreadRing();
+
+    const size_t write = ring->writeIndex.load(std::memory_order_relaxed);
+    Ring::Event& event = ring->events[write % ring->events.size()];
+    event.name.store(name, std::memory_order_relaxed);
+    event.start.store(start, std::memory_order_relaxed);
+    event.end.store(end, std::memory_order_relaxed);
+    ring->writeIndex.store(write + 1, std::memory_order_release);
+}
+
+void TraceRecorder::clear() {
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    for (const auto& ring : rings_) {
+        ring->clearedIndex.store(ring->writeIndex.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+size_t TraceRecorder::getEventCount() const {
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    size_t count = 0;
+    for (const auto& ring : rings_) {
+        const size_t write = ring->writeIndex.load(std::memory_order_acquire);
+        const size_t cleared = ring->clearedIndex.load(std::memory_order_relaxed);
+        count += std::min(write - cleared, ring->events.size());
+    }
+    return count;
+}
+
+double TraceRecorder::getTicksPerMicrosecond() const {
+    // Measure over at least 10 ms so the rate is accurate
+    const auto minimum = std::chrono::milliseconds(10);
+    const auto elapsed = std::chrono::steady_clock::now() - originTime_;
+    if (elapsed < minimum) {
+        std::this_thread::sleep_for(minimum - elapsed);
+    }
+    const uint64_t ticks = readTraceTimestamp();
+    const double microseconds =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - originTime_).count();
+    return static_cast<double>(ticks - originTicks_) / microseconds;
+}
+
+std::string TraceRecorder::exportChromeTrace() const {
+    const double ticksPerMicrosecond = getTicksPerMicrosecond();
+
+    std::vector<ExportedEvent> events;
+    std::vector<std::pair<int, std::string>> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex_);
+        for (const auto& ring : rings_) {
+            const size_t capacity = ring->events.size();
+            const size_t write = ring->writeIndex.load(std::memory_order_acquire);
+            const size_t cleared = ring->clearedIndex.load(std::memory_order_relaxed);
+            size_t first = write - std::min(write - cleared, capacity);
+
+            std::vector<ExportedEvent> copied;
+            copied.reserve(write - first);
+            for (size_t i = first; i < write; ++i) {
+                const Ring::Event& event = ring->events[i % capacity];
+                copied.push_back({event.name.load(std::memory_order_relaxed),
+                                  event.start.load(std::memory_order_relaxed),
+                                  event.end.load(std::memory_order_relaxed), ring->threadId});
+            }
+
+            // Slots the owner overwrote while we copied are not trustworthy
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const size_t after = ring->writeIndex.load(std::memory_order_relaxed);
+            const size_t valid = after >= capacity ? after - capacity + 1 : 0;
+            const size_t skip = valid > first ? std::min(valid - first, copied.size()) : 0;
+            events.insert(events.end(), copied.begin() + static_cast<long>(skip), copied.end());
+
+            threadNames.emplace_back(ring->threadId, ring->threadName.empty()
+                                                         ? "Thread " + std::to_string(ring->threadId)
+                                                         : ring->threadName);
+        }
+    }
+
+    std::sort(events.begin(), events.end(),
+              [](const ExportedEvent& a, const ExportedEvent& b) { return a.start < b.start; });
+    const uint64_t origin = events.empty() ? 0 : events.front().start;
+
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& thread : threadNames) {
+        out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.first
+            << ",\"args\":{\"name\":";
+        appendJsonString(out, thread.second.c_str());
+        out << "}}";
+        first = false;
+    }
+    for (const auto& event : events) {
+        if (!event.name) {
+            continue;
+        }
+        out << (first ? "" : ",") << "\n{\"name\":";
+        appendJsonString(out, event.name);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+            << ",\"ts\":" << static_cast<double>(event.start - origin) / ticksPerMicrosecond
+            << ",\"dur\":" << static_cast<double>(event.end - event.start) / ticksPerMicrosecond << "}";
+        first = false;
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return out.str();
+}
+
+bool TraceRecorder::exportChromeTrace(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file) {
+        return false;
+    }
+    file << exportChromeTrace();
+    return static_cast<bool>(file);
+}
+
+} // namespace AIMusicHardware
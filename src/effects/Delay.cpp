@@ -20,6 +20,11 @@ Delay::Delay(int sampleRate)
 Delay::~Delay() {
 }
 
+void Delay::reset() {
+    std::fill(delayBuffer_.begin(), delayBuffer_.end(), 0.0f);
+    writePos_ = 0;
+}
+
 void Delay::process(float* buffer, int numFrames) {
     // Process delay effect
     for (int i = 0; i < numFrames * 2; i += 2) { // Stereo processing
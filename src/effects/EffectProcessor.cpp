@@ -71,12 +71,25 @@ void EffectProcessor::process(float* buffer, int numFrames) {
         return;
     }
     
+    // Effects with tails come back from a bypass without their old state
+    const bool restoreTails = tailEffectsWereBypassed_ && !tailEffectsBypassed_;
+    tailEffectsWereBypassed_ = tailEffectsBypassed_;
+    
     // Process each effect in the chain
     for (auto& effect : effects_) {
         if (!effect) {
             continue; // Skip null effects
         }
         
+        if (effect->hasTail()) {
+            if (tailEffectsBypassed_) {
+                continue;
+            }
+            if (restoreTails) {
+                effect->reset();
+            }
+        }
+        
         // Make sure temp buffer is large enough - use reserve instead of resize for efficiency
         if (tempBuffer_.capacity() < static_cast<size_t>(numFrames * 2)) {
             tempBuffer_.reserve(numFrames * 2);
@@ -1,6 +1,7 @@
 #include "../../include/effects/ReorderableEffectsChain.h"
 #include "../../include/effects/AllEffects.h"
-#include <iostream>
+#include "../../include/audio/RealtimeLog.h"
+#include "../../include/audio/TraceRecorder.h"
 
 namespace AIMusicHardware {
 
@@ -15,15 +16,28 @@ ReorderableEffectsChain::~ReorderableEffectsChain() {
 }
 
 void ReorderableEffectsChain::process(float* buffer, int numFrames) {
+    // Effects with tails come back from a bypass without their old state
+    const bool restoreTails = tailEffectsWereBypassed_ && !tailEffectsBypassed_;
+    tailEffectsWereBypassed_ = tailEffectsBypassed_;
+    
     // Process each enabled effect in the chain
     for (auto& effectInfo : effects_) {
         if (effectInfo.enabled && effectInfo.effect) {
+            if (effectInfo.effect->hasTail()) {
+                if (tailEffectsBypassed_) {
+                    continue;
+                }
+                if (restoreTails) {
+                    effectInfo.effect->reset();
+                }
+            }
             try {
                 // Process the effect
+                AIMUSIC_TRACE_SCOPE(effectInfo.traceName);
                 effectInfo.effect->process(buffer, numFrames);
             } catch (const std::exception& e) {
                 // Log the error but continue processing
-                std::cerr << "Error processing effect: " << e.what() << std::endl;
+                RT_LOG_ERROR(LogCategory::Audio, "Error processing effect {}: {}", effectInfo.type, e.what());
             }
         }
     }
@@ -43,7 +57,8 @@ int ReorderableEffectsChain::addEffect(std::unique_ptr<Effect> effect, int index
     EffectInfo info = {
         std::move(effect),
         effectType,
-        true // Enable by default
+        true, // Enable by default
+        TraceRecorder::getInstance().internName(effectType)
     };
     
     // Insert at the specified position
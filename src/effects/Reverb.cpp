@@ -1,6 +1,7 @@
 #include "../../include/effects/EffectProcessor.h"
 #include "../../include/effects/EffectUtils.h"
 #include <vector>
+#include <algorithm>
 #include <cstring>
 
 namespace AIMusicHardware {
@@ -112,6 +113,17 @@ public:
         }
     }
     
+    void reset() {
+        for (auto& buffer : combBuffers) {
+            std::fill(buffer.begin(), buffer.end(), 0.0f);
+        }
+        for (auto& buffer : allpassBuffers) {
+            std::fill(buffer.begin(), buffer.end(), 0.0f);
+        }
+        std::fill(combWritePos.begin(), combWritePos.end(), 0);
+        std::fill(allpassWritePos.begin(), allpassWritePos.end(), 0);
+    }
+    
     int sampleRate;
     float roomSize;
     float damping;
@@ -143,6 +155,10 @@ void Reverb::process(float* buffer, int numFrames) {
     pimpl_->process(buffer, numFrames);
 }
 
+void Reverb::reset() {
+    pimpl_->reset();
+}
+
 void Reverb::setParameter(const std::string& name, float value) {
     if (name == "roomSize") {
         roomSize_ = clamp(value, 0.0f, 1.0f);
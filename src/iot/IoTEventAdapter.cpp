@@ -1,6 +1,6 @@
 #include "../../include/iot/IoTEventAdapter.h"
 #include "../../include/ui/ParameterManager.h"
-#include <regex>
+#include "../../include/iot/IoTPayloadScanner.h"
 #include <iostream>
 
 namespace AIMusicHardware {
@@ -12,6 +12,9 @@ IoTEventAdapter::IoTEventAdapter(IoTInterface* iotInterface, EventBus* eventBus)
     if (!iotInterface_) {
         throw std::invalid_argument("IoTInterface cannot be null");
     }
+    
+    // A frame holds at most 255 records
+    frameReadings_.resize(255);
 }
 
 IoTEventAdapter::~IoTEventAdapter() {
@@ -28,6 +31,13 @@ void IoTEventAdapter::mapTopicToEvent(const std::string& topic, const std::strin
         }
     }
     
+    // Compile the filter before storing the mapping
+    auto id = static_cast<MQTTTopicTrie::SubscriptionId>(eventMappings_.size());
+    if (!eventTrie_.insert(topic, id)) {
+        std::cerr << "Invalid MQTT topic filter for event mapping: " << topic << std::endl;
+        return;
+    }
+    
     // Create new mapping
     TopicEventMapping mapping;
     mapping.topic = topic;
@@ -53,6 +63,13 @@ void IoTEventAdapter::mapTopicToParameter(const std::string& topic, Parameter* p
         }
     }
     
+    // Compile the filter before storing the mapping
+    auto id = static_cast<MQTTTopicTrie::SubscriptionId>(parameterMappings_.size());
+    if (!parameterTrie_.insert(topic, id)) {
+        std::cerr << "Invalid MQTT topic filter for parameter mapping: " << topic << std::endl;
+        return;
+    }
+    
     // Create new mapping
     TopicParameterMapping mapping;
     mapping.topic = topic;
@@ -66,6 +83,25 @@ void IoTEventAdapter::mapTopicToParameter(const std::string& topic, Parameter* p
     }
 }
 
+void IoTEventAdapter::mapSensorFrames(const std::string& topic) {
+    if (!MQTTTopicTrie::isValidFilter(topic)) {
+        std::cerr << "Invalid MQTT topic filter for sensor frames: " << topic << std::endl;
+        return;
+    }
+    
+    for (const auto& frameTopic : frameTopics_) {
+        if (frameTopic == topic) {
+            return;
+        }
+    }
+    frameTopics_.push_back(topic);
+    
+    // If adapter is running, subscribe to topic
+    if (isRunning_ && iotInterface_) {
+        iotInterface_->subscribe(topic);
+    }
+}
+
 void IoTEventAdapter::setMessageConverter(const std::string& topic, 
                                          std::function<std::any(const std::string&)> converter) {
     // Find the event mapping
@@ -120,11 +156,8 @@ void IoTEventAdapter::setMappingMode(const std::string& topic,
             // If no converter exists, create a default string-to-float converter
             mapping->converter = IoTParameterMappings::chainConversions(
                 [](const std::string& payload) {
-                    try {
-                        return std::stof(payload);
-                    } catch (...) {
-                        return 0.0f;
-                    }
+                    float value = 0.0f;
+                    return IoTPayloadScanner::parseNumber(payload, value) ? value : 0.0f;
                 },
                 mappingFunc
             );
@@ -146,6 +179,10 @@ void IoTEventAdapter::start() {
         iotInterface_->subscribe(mapping.topic);
     }
     
+    for (const auto& topic : frameTopics_) {
+        iotInterface_->subscribe(topic);
+    }
+    
     // Set global message callback
     iotInterface_->setMessageCallback([this](const std::string& topic, const std::string& payload) {
         this->onIoTMessage(topic, payload);
@@ -165,49 +202,17 @@ void IoTEventAdapter::stop() {
     isRunning_ = false;
 }
 
-bool IoTEventAdapter::matchTopicPattern(const std::string& topic, const std::string& pattern) const {
-    // Simple wildcard matching for MQTT topics
-    // e.g., "sensors/#" matches "sensors/temp", "sensors/humidity/kitchen", etc.
-    
-    // Exact match
-    if (pattern == topic) {
-        return true;
-    }
-    
-    // Single-level wildcard +
-    if (pattern.find('+') != std::string::npos) {
-        // Replace + with regex for any non-slash sequence
-        std::string regexPattern = pattern;
-        size_t pos = 0;
-        while ((pos = regexPattern.find('+', pos)) != std::string::npos) {
-            regexPattern.replace(pos, 1, "([^/]+)");
-            pos += 7; // length of "([^/]+)"
-        }
-        
-        std::regex re(regexPattern);
-        return std::regex_match(topic, re);
-    }
-    
-    // Multi-level wildcard #
-    if (pattern.find('#') != std::string::npos) {
-        // # must be the last character and preceded by /
-        if (pattern.back() == '#') {
-            std::string prefix = pattern.substr(0, pattern.length() - 1);
-            
-            // If # is the only character, it matches everything
-            if (prefix.empty()) {
-                return true;
-            }
-            
-            // Check if topic starts with prefix
-            return topic.compare(0, prefix.length(), prefix) == 0;
-        }
+void IoTEventAdapter::onIoTMessage(const std::string& topic, const std::string& payload) {
+    // Binary sensor frames fan out into one message per reading
+    if (SensorFrameDecoder::isFrame(payload)) {
+        onSensorFrame(topic, payload);
+        return;
     }
     
-    return false;
+    dispatchMessage(topic, payload);
 }
 
-void IoTEventAdapter::onIoTMessage(const std::string& topic, const std::string& payload) {
+void IoTEventAdapter::dispatchMessage(const std::string& topic, const std::string& payload) {
     // First, create a generic IoT event for any subscribers who want all messages
     IoTEvent iotEvent(topic, payload);
     if (eventBus_) {
@@ -215,180 +220,233 @@ void IoTEventAdapter::onIoTMessage(const std::string& topic, const std::string&
     }
 
     // Handle specific event mappings
-    for (const auto& mapping : eventMappings_) {
-        if (topic == mapping.topic || matchTopicPattern(topic, mapping.topic)) {
-            // Create appropriate event type based on mapping.eventType
-            std::unique_ptr<Event> event;
-
-            if (mapping.eventType == "state_change") {
-                // Use payload as state name
-                std::string stateName = payload;
-                if (mapping.converter) {
-                    try {
-                        stateName = std::any_cast<std::string>(mapping.converter(payload));
-                    } catch (std::exception& e) {
-                        std::cerr << "Error converting payload to state name: " << e.what() << std::endl;
-                    }
-                }
-                event = std::make_unique<StateChangeEvent>(stateName);
-            }
-            else if (mapping.eventType == "pattern_control") {
-                // Parse payload for pattern ID and action
-                std::string patternId = topic; // Default to topic as pattern ID
-                PatternEvent::Action action = PatternEvent::Action::START; // Default action
-
-                // Try to extract pattern ID and action from payload if it's in format "pattern_id:action"
-                size_t colonPos = payload.find(':');
-                if (colonPos != std::string::npos) {
-                    patternId = payload.substr(0, colonPos);
-                    std::string actionStr = payload.substr(colonPos + 1);
-
-                    if (actionStr == "start") action = PatternEvent::Action::START;
-                    else if (actionStr == "stop") action = PatternEvent::Action::STOP;
-                    else if (actionStr == "pause") action = PatternEvent::Action::PAUSE;
-                    else if (actionStr == "resume") action = PatternEvent::Action::RESUME;
-                    else if (actionStr == "restart") action = PatternEvent::Action::RESTART;
-                }
+    eventTrie_.match(topic, [&](MQTTTopicTrie::SubscriptionId id) {
+        dispatchMappedEvent(eventMappings_[id], topic, payload);
+    });
+    
+    // Handle parameter mappings
+    parameterTrie_.match(topic, [&](MQTTTopicTrie::SubscriptionId id) {
+        applyParameterMapping(parameterMappings_[id], payload);
+    });
+}
 
-                event = std::make_unique<PatternEvent>(patternId, action);
+void IoTEventAdapter::onSensorFrame(const std::string& topic, const std::string& payload) {
+    size_t count = 0;
+    auto status = SensorFrameDecoder::decode(payload, frameReadings_.data(), frameReadings_.size(), count);
+    if (status != SensorFrameDecoder::Status::Ok) {
+        std::cerr << "Dropping sensor frame on " << topic << ": "
+                  << SensorFrameDecoder::statusName(status) << std::endl;
+        return;
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        const SensorReading& reading = frameReadings_[i];
+        
+        readingTopic_.assign(topic);
+        readingTopic_ += '/';
+        if (const char* name = SensorFrame::typeName(reading.type)) {
+            readingTopic_ += name;
+        } else {
+            readingTopic_ += "type_";
+            readingTopic_ += std::to_string(reading.type);
+        }
+        
+        // Text is only rendered for consumers that need a payload string
+        bool needsText = eventBus_ != nullptr || eventTrie_.matchesAny(readingTopic_);
+        parameterTrie_.match(readingTopic_, [&](MQTTTopicTrie::SubscriptionId id) {
+            needsText = needsText || static_cast<bool>(parameterMappings_[id].converter);
+        });
+        if (needsText) {
+            SensorFrameDecoder::formatValues(reading, readingPayload_);
+        }
+        
+        if (eventBus_) {
+            IoTEvent iotEvent(readingTopic_, readingPayload_);
+            eventBus_->dispatchEvent(iotEvent);
+        }
+        
+        eventTrie_.match(readingTopic_, [&](MQTTTopicTrie::SubscriptionId id) {
+            dispatchMappedEvent(eventMappings_[id], readingTopic_, readingPayload_);
+        });
+        
+        parameterTrie_.match(readingTopic_, [&](MQTTTopicTrie::SubscriptionId id) {
+            const TopicParameterMapping& mapping = parameterMappings_[id];
+            if (mapping.converter) {
+                applyParameterMapping(mapping, readingPayload_);
+            } else if (mapping.parameter) {
+                setParameterValue(mapping.parameter, reading.values[0]);
             }
-            else if (mapping.eventType == "parameter_change") {
-                // Extract parameter ID and value
-                std::string parameterId = topic; // Default to topic as parameter ID
-                float value = 0.0f;
-
-                // Try to parse payload as float
-                try {
-                    value = std::stof(payload);
-                } catch (...) {
-                    // If not a float, check if it's in format "parameter_id:value"
-                    size_t colonPos = payload.find(':');
-                    if (colonPos != std::string::npos) {
-                        parameterId = payload.substr(0, colonPos);
-                        try {
-                            value = std::stof(payload.substr(colonPos + 1));
-                        } catch (...) {
-                            // Unable to parse value
-                            std::cerr << "Unable to parse parameter value from payload: " << payload << std::endl;
-                            continue;
-                        }
-                    } else {
-                        // Unable to parse value
-                        std::cerr << "Unable to parse parameter value from payload: " << payload << std::endl;
-                        continue;
-                    }
-                }
+        });
+    }
+}
 
-                event = std::make_unique<ParameterEvent>(parameterId, value);
+void IoTEventAdapter::dispatchMappedEvent(const TopicEventMapping& mapping, const std::string& topic,
+                                          const std::string& payload) {
+    // Create appropriate event type based on mapping.eventType
+    std::unique_ptr<Event> event;
+
+    if (mapping.eventType == "state_change") {
+        // Use payload as state name
+        std::string stateName = payload;
+        if (mapping.converter) {
+            try {
+                stateName = std::any_cast<std::string>(mapping.converter(payload));
+            } catch (std::exception& e) {
+                std::cerr << "Error converting payload to state name: " << e.what() << std::endl;
             }
-            else {
-                // Generic event
-                event = std::make_unique<Event>(mapping.eventType);
-
-                // Apply payload conversion if available
-                if (mapping.converter) {
-                    try {
-                        std::any eventData = mapping.converter(payload);
-                        event->setPayload(eventData);
-                    } catch (std::exception& e) {
-                        std::cerr << "Error converting payload: " << e.what() << std::endl;
-                        // Set raw payload as string if conversion fails
-                        event->setPayload(payload);
-                    }
-                } else {
-                    // Use raw payload as string
-                    event->setPayload(payload);
+        }
+        event = std::make_unique<StateChangeEvent>(stateName);
+    }
+    else if (mapping.eventType == "pattern_control") {
+        // Parse payload for pattern ID and action
+        std::string patternId = topic; // Default to topic as pattern ID
+        PatternEvent::Action action = PatternEvent::Action::START; // Default action
+
+        // Try to extract pattern ID and action from payload if it's in format "pattern_id:action"
+        size_t colonPos = payload.find(':');
+        if (colonPos != std::string::npos) {
+            patternId = payload.substr(0, colonPos);
+            std::string actionStr = payload.substr(colonPos + 1);
+
+            if (actionStr == "start") action = PatternEvent::Action::START;
+            else if (actionStr == "stop") action = PatternEvent::Action::STOP;
+            else if (actionStr == "pause") action = PatternEvent::Action::PAUSE;
+            else if (actionStr == "resume") action = PatternEvent::Action::RESUME;
+            else if (actionStr == "restart") action = PatternEvent::Action::RESTART;
+        }
+
+        event = std::make_unique<PatternEvent>(patternId, action);
+    }
+    else if (mapping.eventType == "parameter_change") {
+        // Extract parameter ID and value
+        std::string parameterId = topic; // Default to topic as parameter ID
+        float value = 0.0f;
+
+        // Try to parse payload as float
+        if (!IoTPayloadScanner::parseNumber(payload, value)) {
+            // If not a float, check if it's in format "parameter_id:value"
+            size_t colonPos = payload.find(':');
+            if (colonPos != std::string::npos) {
+                parameterId = payload.substr(0, colonPos);
+                if (!IoTPayloadScanner::parseNumber(std::string_view(payload).substr(colonPos + 1), value)) {
+                    // Unable to parse value
+                    std::cerr << "Unable to parse parameter value from payload: " << payload << std::endl;
+                    return;
                 }
+            } else {
+                // Unable to parse value
+                std::cerr << "Unable to parse parameter value from payload: " << payload << std::endl;
+                return;
             }
+        }
 
-            // Dispatch event if event bus exists
-            if (eventBus_ && event) {
-                eventBus_->dispatchEvent(*event);
+        event = std::make_unique<ParameterEvent>(parameterId, value);
+    }
+    else {
+        // Generic event
+        event = std::make_unique<Event>(mapping.eventType);
+
+        // Apply payload conversion if available
+        if (mapping.converter) {
+            try {
+                std::any eventData = mapping.converter(payload);
+                event->setPayload(eventData);
+            } catch (std::exception& e) {
+                std::cerr << "Error converting payload: " << e.what() << std::endl;
+                // Set raw payload as string if conversion fails
+                event->setPayload(payload);
             }
+        } else {
+            // Use raw payload as string
+            event->setPayload(payload);
         }
     }
-    
-    // Handle parameter mappings
-    for (const auto& mapping : parameterMappings_) {
-        if (topic == mapping.topic || matchTopicPattern(topic, mapping.topic)) {
-            // Get parameter
-            Parameter* parameter = mapping.parameter;
-            if (!parameter) continue;
 
-            // Convert payload to parameter value
-            float value = 0.0f;
+    // Dispatch event if event bus exists
+    if (eventBus_ && event) {
+        eventBus_->dispatchEvent(*event);
+    }
+}
 
-            if (mapping.converter) {
-                // Use converter if available
-                try {
-                    value = mapping.converter(payload);
-                } catch (std::exception& e) {
-                    std::cerr << "Error converting payload for parameter: " << e.what() << std::endl;
-                    continue;
-                }
-            } else {
-                // Default conversion (try to parse as float)
-                try {
-                    value = std::stof(payload);
-                } catch (...) {
-                    continue; // Skip if conversion fails
-                }
+void IoTEventAdapter::applyParameterMapping(const TopicParameterMapping& mapping, const std::string& payload) {
+    // Get parameter
+    Parameter* parameter = mapping.parameter;
+    if (!parameter) return;
+
+    // Convert payload to parameter value
+    float value = 0.0f;
+
+    if (mapping.converter) {
+        // Use converter if available
+        try {
+            value = mapping.converter(payload);
+        } catch (std::exception& e) {
+            std::cerr << "Error converting payload for parameter: " << e.what() << std::endl;
+            return;
+        }
+    } else {
+        // Default conversion (try to parse as float)
+        if (!IoTPayloadScanner::parseNumber(payload, value)) {
+            return; // Skip if conversion fails
+        }
+    }
+
+    setParameterValue(parameter, value);
+}
+
+void IoTEventAdapter::setParameterValue(Parameter* parameter, float value) {
+    // Update parameter value based on its type
+    try {
+        switch (parameter->getType()) {
+            case Parameter::Type::FLOAT: {
+                auto* floatParam = static_cast<FloatParameter*>(parameter);
+                floatParam->setValue(value);
+                std::cout << "Setting float parameter " << parameter->getName()
+                          << " to " << value << std::endl;
+                break;
             }
 
-            // Update parameter value based on its type
-            try {
-                switch (parameter->getType()) {
-                    case Parameter::Type::FLOAT: {
-                        auto* floatParam = static_cast<FloatParameter*>(parameter);
-                        floatParam->setValue(value);
-                        std::cout << "Setting float parameter " << parameter->getName()
-                                  << " to " << value << std::endl;
-                        break;
-                    }
-
-                    case Parameter::Type::INT: {
-                        auto* intParam = static_cast<IntParameter*>(parameter);
-                        intParam->setValue(static_cast<int>(std::round(value)));
-                        std::cout << "Setting int parameter " << parameter->getName()
-                                  << " to " << static_cast<int>(std::round(value)) << std::endl;
-                        break;
-                    }
-
-                    case Parameter::Type::BOOL: {
-                        auto* boolParam = static_cast<BoolParameter*>(parameter);
-                        boolParam->setValue(value >= 0.5f);
-                        std::cout << "Setting bool parameter " << parameter->getName()
-                                  << " to " << (value >= 0.5f ? "true" : "false") << std::endl;
-                        break;
-                    }
-
-                    case Parameter::Type::ENUM: {
-                        auto* enumParam = static_cast<EnumParameter*>(parameter);
-                        // For enum parameters, we can either:
-                        // 1. Set by normalized value (0-1 maps to first-last enum value)
-                        enumParam->setFromNormalizedValue(value);
-                        std::cout << "Setting enum parameter " << parameter->getName()
-                                  << " to " << enumParam->getCurrentValueName() << std::endl;
-                        break;
-                    }
-
-                    case Parameter::Type::TRIGGER: {
-                        auto* triggerParam = static_cast<TriggerParameter*>(parameter);
-                        if (value >= 0.5f) {
-                            triggerParam->trigger();
-                            std::cout << "Triggering parameter " << parameter->getName() << std::endl;
-                        }
-                        break;
-                    }
-
-                    default:
-                        std::cerr << "Unknown parameter type for " << parameter->getName() << std::endl;
-                        break;
+            case Parameter::Type::INT: {
+                auto* intParam = static_cast<IntParameter*>(parameter);
+                intParam->setValue(static_cast<int>(std::round(value)));
+                std::cout << "Setting int parameter " << parameter->getName()
+                          << " to " << static_cast<int>(std::round(value)) << std::endl;
+                break;
+            }
+
+            case Parameter::Type::BOOL: {
+                auto* boolParam = static_cast<BoolParameter*>(parameter);
+                boolParam->setValue(value >= 0.5f);
+                std::cout << "Setting bool parameter " << parameter->getName()
+                          << " to " << (value >= 0.5f ? "true" : "false") << std::endl;
+                break;
+            }
+
+            case Parameter::Type::ENUM: {
+                auto* enumParam = static_cast<EnumParameter*>(parameter);
+                // For enum parameters, we can either:
+                // 1. Set by normalized value (0-1 maps to first-last enum value)
+                enumParam->setFromNormalizedValue(value);
+                std::cout << "Setting enum parameter " << parameter->getName()
+                          << " to " << enumParam->getCurrentValueName() << std::endl;
+                break;
+            }
+
+            case Parameter::Type::TRIGGER: {
+                auto* triggerParam = static_cast<TriggerParameter*>(parameter);
+                if (value >= 0.5f) {
+                    triggerParam->trigger();
+                    std::cout << "Triggering parameter " << parameter->getName() << std::endl;
                 }
-            } catch (const std::exception& e) {
-                std::cerr << "Error setting parameter value: " << e.what() << std::endl;
+                break;
             }
+
+            default:
+                std::cerr << "Unknown parameter type for " << parameter->getName() << std::endl;
+                break;
         }
+    } catch (const std::exception& e) {
+        std::cerr << "Error setting parameter value: " << e.what() << std::endl;
     }
 }
 
@@ -0,0 +1,273 @@
+#include "../../include/iot/IoTParameterBridge.h"
+#include "../../include/iot/IoTPayloadScanner.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace AIMusicHardware {
+
+IoTParameterBridge::IoTParameterBridge(ParameterUpdateSystem& updateSystem)
+    : batchProducer_(updateSystem.acquireBatchProducer()) {
+    if (!batchProducer_) {
+        std::cerr << "IoT parameter bridge: the audio batch queue already has a producer; "
+                  << "values will be dropped" << std::endl;
+    }
+}
+
+IoTParameterBridge::~IoTParameterBridge() {
+    stop();
+    disconnect();
+}
+
+int IoTParameterBridge::mapTopic(const std::string& topicFilter, const Parameter::ParameterId& parameterId,
+                                 Converter converter, CoalesceMode mode) {
+    bool needsCallback = false;
+    int index = -1;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        index = static_cast<int>(mappings_.size());
+        if (!trie_.insert(topicFilter, static_cast<MQTTTopicTrie::SubscriptionId>(index))) {
+            std::cerr << "Invalid MQTT topic filter for parameter bridge: " << topicFilter << std::endl;
+            return -1;
+        }
+
+        Mapping mapping;
+        mapping.topicFilter = topicFilter;
+        mapping.parameterId = parameterId;
+        mapping.synthParameter = findSynthParameter(parameterId);
+        mapping.converter = std::move(converter);
+        mapping.mode = mode;
+        mappings_.push_back(std::move(mapping));
+
+        // One batch slot per mapping, ids pre-filled so flushes reuse the strings
+        ParameterUpdateQueue<>::ParameterChange change{parameterId, 0.0f,
+            ParameterUpdateQueue<>::ChangeSource::IoT, 0, mappings_.back().synthParameter};
+        batch_.push_back(change);
+
+        needsCallback = iotInterface_ &&
+            std::find(registeredFilters_.begin(), registeredFilters_.end(), topicFilter) == registeredFilters_.end();
+    }
+
+    if (needsCallback) {
+        registerCallback(topicFilter);
+    }
+    return index;
+}
+
+void IoTParameterBridge::setCoalesceMode(int mapping, CoalesceMode mode) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (mapping >= 0 && mapping < static_cast<int>(mappings_.size())) {
+        mappings_[mapping].mode = mode;
+    }
+}
+
+void IoTParameterBridge::connect(IoTInterface* iotInterface) {
+    disconnect();
+
+    std::vector<std::string> filters;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        iotInterface_ = iotInterface;
+        for (const auto& mapping : mappings_) {
+            if (std::find(filters.begin(), filters.end(), mapping.topicFilter) == filters.end()) {
+                filters.push_back(mapping.topicFilter);
+            }
+        }
+    }
+
+    if (!iotInterface) {
+        return;
+    }
+    for (const auto& filter : filters) {
+        registerCallback(filter);
+    }
+}
+
+void IoTParameterBridge::registerCallback(const std::string& topicFilter) {
+    IoTInterface* iot = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        iot = iotInterface_;
+        registeredFilters_.push_back(topicFilter);
+    }
+
+    // Interfaces may call back synchronously, so register without holding the lock
+    iot->setTopicCallback(topicFilter, [this](const std::string& topic, const std::string& payload) {
+        ingest(topic, payload);
+    });
+}
+
+void IoTParameterBridge::disconnect() {
+    IoTInterface* iot = nullptr;
+    std::vector<std::string> filters;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        iot = iotInterface_;
+        filters.swap(registeredFilters_);
+        iotInterface_ = nullptr;
+    }
+
+    if (iot) {
+        for (const auto& filter : filters) {
+            iot->removeTopicCallback(filter);
+        }
+    }
+}
+
+void IoTParameterBridge::ingest(const std::string& topic, const std::string& payload) {
+    uint64_t timestamp = now();
+    bool matched = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        trie_.match(topic, [&](MQTTTopicTrie::SubscriptionId id) {
+            Mapping& mapping = mappings_[id];
+            matched = true;
+
+            float value = 0.0f;
+            if (mapping.converter) {
+                try {
+                    value = mapping.converter(payload);
+                } catch (const std::exception& e) {
+                    std::cerr << "Error converting payload for " << mapping.parameterId << ": " << e.what() << std::endl;
+                    return;
+                }
+            } else if (!IoTPayloadScanner::parseNumber(payload, value)) {
+                return;
+            }
+
+            if (mapping.count == 0) {
+                mapping.minimum = value;
+                mapping.maximum = value;
+                mapping.sum = 0.0;
+            } else {
+                mapping.minimum = std::min(mapping.minimum, value);
+                mapping.maximum = std::max(mapping.maximum, value);
+            }
+            mapping.last = value;
+            mapping.sum += value;
+            ++mapping.count;
+            mapping.lastTimestamp = timestamp;
+        });
+    }
+
+    messagesIngested_.fetch_add(1, std::memory_order_relaxed);
+    if (!matched) {
+        messagesUnmatched_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+size_t IoTParameterBridge::flush() {
+    size_t count = 0;
+    size_t pushed = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& mapping : mappings_) {
+            if (mapping.count == 0) {
+                continue;
+            }
+
+            float value = mapping.last;
+            switch (mapping.mode) {
+                case CoalesceMode::LastValue:
+                    value = mapping.last;
+                    break;
+                case CoalesceMode::Mean:
+                    value = static_cast<float>(mapping.sum / mapping.count);
+                    break;
+                case CoalesceMode::Min:
+                    value = mapping.minimum;
+                    break;
+                case CoalesceMode::Max:
+                    value = mapping.maximum;
+                    break;
+            }
+
+            auto& change = batch_[count++];
+            if (change.id != mapping.parameterId) {
+                change.id = mapping.parameterId;
+                change.synthParameter = mapping.synthParameter;
+            }
+            change.value = value;
+            change.timestamp = mapping.lastTimestamp;
+            mapping.count = 0;
+        }
+
+        if (count == 0) {
+            return 0;
+        }
+
+        // Lock-free push; the bridge holds the batch queue's producer handle
+        pushed = batchProducer_.push(batch_.data(), count);
+    }
+
+    valuesPublished_.fetch_add(pushed, std::memory_order_relaxed);
+    valuesDropped_.fetch_add(count - pushed, std::memory_order_relaxed);
+    batchesPublished_.fetch_add(1, std::memory_order_relaxed);
+    return pushed;
+}
+
+void IoTParameterBridge::start(float controlRateHz) {
+    if (running_.exchange(true)) {
+        return;
+    }
+
+    auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / std::max(1.0f, controlRateHz)));
+
+    controlThread_ = std::thread([this, period]() {
+        auto next = std::chrono::steady_clock::now() + period;
+        while (running_.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_until(next);
+            flush();
+
+            // Skip missed ticks instead of bursting to catch up
+            next += period;
+            auto current = std::chrono::steady_clock::now();
+            if (next < current) {
+                next = current + period;
+            }
+        }
+    });
+}
+
+void IoTParameterBridge::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (controlThread_.joinable()) {
+        controlThread_.join();
+    }
+    flush();
+}
+
+size_t IoTParameterBridge::getMappingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return mappings_.size();
+}
+
+IoTParameterBridge::Statistics IoTParameterBridge::getStatistics() const {
+    return Statistics{
+        messagesIngested_.load(std::memory_order_relaxed),
+        messagesUnmatched_.load(std::memory_order_relaxed),
+        valuesPublished_.load(std::memory_order_relaxed),
+        batchesPublished_.load(std::memory_order_relaxed),
+        valuesDropped_.load(std::memory_order_relaxed)
+    };
+}
+
+void IoTParameterBridge::resetStatistics() {
+    messagesIngested_.store(0, std::memory_order_relaxed);
+    messagesUnmatched_.store(0, std::memory_order_relaxed);
+    valuesPublished_.store(0, std::memory_order_relaxed);
+    batchesPublished_.store(0, std::memory_order_relaxed);
+    valuesDropped_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t IoTParameterBridge::now() {
+    // Same clock and unit as ParameterUpdateSystem timestamps
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace AIMusicHardware
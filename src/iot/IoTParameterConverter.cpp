@@ -1,10 +1,9 @@
 #include "../../include/iot/IoTParameterTypes.h"
+#include "../../include/iot/IoTPayloadScanner.h"
 
 #include <algorithm>
 #include <cmath>
 #include <iostream>
-#include <regex>
-#include <sstream>
 
 namespace AIMusicHardware {
 
@@ -60,26 +59,19 @@ std::function<float(const std::string&)> IoTParameterConverter::getConverter(
         case SensorType::JSON:
             // JSON requires specific key, so we'll use a default handler
             baseConverter = [](const std::string& payload) {
-                try {
-                    // Simple numeric extraction from JSON
-                    std::regex valueRegex("\"value\"\\s*:\\s*([0-9.]+)");
-                    std::smatch match;
-                    if (std::regex_search(payload, match, valueRegex) && match.size() > 1) {
-                        return std::stof(match[1].str());
-                    }
-                } catch (...) {}
-                
+                // Simple numeric extraction from JSON
+                float value = 0.0f;
+                if (IoTPayloadScanner::parseNumber(IoTPayloadScanner::findJsonValue(payload, "value"), value)) {
+                    return value;
+                }
                 return 0.0f;
             };
             break;
         case SensorType::CUSTOM:
             // For custom type, use a simple float parser as a default
             baseConverter = [](const std::string& payload) {
-                try {
-                    return std::stof(payload);
-                } catch (...) {
-                    return 0.0f;
-                }
+                float value = 0.0f;
+                return IoTPayloadScanner::parseNumber(payload, value) ? value : 0.0f;
             };
             break;
     }
@@ -110,40 +102,35 @@ std::function<float(const std::string&)> IoTParameterConverter::createCustomConv
     return converter;
 }
 
-std::string IoTParameterConverter::parseJsonValue(const std::string& payload, const std::string& key) {
-    // Simple regex-based JSON parser for specific key
-    std::string pattern = "\"" + key + "\"\\s*:\\s*([^,}\\]]+)";
-    std::regex keyRegex(pattern);
-    std::smatch match;
-    
-    if (std::regex_search(payload, match, keyRegex) && match.size() > 1) {
-        std::string value = match[1].str();
-        
-        // Clean up the value
-        value = std::regex_replace(value, std::regex("^\\s+|\\s+$"), ""); // trim
-        value = std::regex_replace(value, std::regex("^\""), ""); // remove leading quote
-        value = std::regex_replace(value, std::regex("\"$"), ""); // remove trailing quote
-        
+std::function<float(const std::string&)> IoTParameterConverter::createJsonFieldConverter(
+    const std::string& key, float minValue, float maxValue, bool normalized) {
+    
+    // The plan is built once here and reused for every message
+    auto plan = std::make_shared<const IoTExtractionPlan>(IoTExtractionPlan::json({key}));
+    return createCustomConverter([plan](const std::string& payload) {
+        float value = 0.0f;
+        plan->extract(payload, &value);
         return value;
-    }
+    }, minValue, maxValue, normalized);
+}
+
+std::function<float(const std::string&)> IoTParameterConverter::createCsvFieldConverter(
+    int index, float minValue, float maxValue, bool normalized) {
     
-    return "";
+    auto plan = std::make_shared<const IoTExtractionPlan>(IoTExtractionPlan::csv({index}));
+    return createCustomConverter([plan](const std::string& payload) {
+        float value = 0.0f;
+        plan->extract(payload, &value);
+        return value;
+    }, minValue, maxValue, normalized);
+}
+
+std::string IoTParameterConverter::parseJsonValue(const std::string& payload, const std::string& key) {
+    return std::string(IoTPayloadScanner::findJsonValue(payload, key));
 }
 
 std::string IoTParameterConverter::parseCsvValue(const std::string& payload, int index) {
-    std::stringstream ss(payload);
-    std::string item;
-    int currentIndex = 0;
-    
-    while (std::getline(ss, item, ',')) {
-        if (currentIndex == index) {
-            // Found the requested index
-            return item;
-        }
-        currentIndex++;
-    }
-    
-    return ""; // Index not found
+    return std::string(IoTPayloadScanner::csvField(payload, index));
 }
 
 float IoTParameterConverter::normalizeValue(float value, float minValue, float maxValue) {
@@ -161,124 +148,91 @@ float IoTParameterConverter::normalizeValue(float value, float minValue, float m
 
 // Converter implementations
 float IoTParameterConverter::convertTemperature(const std::string& payload) {
-    try {
-        // Extract numeric value
-        std::regex tempRegex("([+-]?[0-9.]+)");
-        std::smatch match;
-        if (std::regex_search(payload, match, tempRegex)) {
-            return std::stof(match[1].str());
-        }
-    } catch (...) {}
+    // Extract numeric value
+    float value = 0.0f;
+    if (IoTPayloadScanner::findFirstNumber(payload, value)) {
+        return value;
+    }
     
     return 20.0f; // Default room temperature
 }
 
 float IoTParameterConverter::convertHumidity(const std::string& payload) {
-    try {
-        // Extract numeric value
-        std::regex humidityRegex("([0-9.]+)");
-        std::smatch match;
-        if (std::regex_search(payload, match, humidityRegex)) {
-            return std::stof(match[1].str());
-        }
-    } catch (...) {}
+    // Extract numeric value
+    float value = 0.0f;
+    if (IoTPayloadScanner::findFirstNumber(payload, value)) {
+        return value;
+    }
     
     return 50.0f; // Default 50% humidity
 }
 
 float IoTParameterConverter::convertPressure(const std::string& payload) {
-    try {
-        // Extract numeric value
-        std::regex pressureRegex("([0-9.]+)");
-        std::smatch match;
-        if (std::regex_search(payload, match, pressureRegex)) {
-            return std::stof(match[1].str());
-        }
-    } catch (...) {}
+    // Extract numeric value
+    float value = 0.0f;
+    if (IoTPayloadScanner::findFirstNumber(payload, value)) {
+        return value;
+    }
     
     return 1013.25f; // Default sea level pressure
 }
 
 float IoTParameterConverter::convertLight(const std::string& payload) {
-    try {
-        // Extract numeric value
-        std::regex lightRegex("([0-9.]+)");
-        std::smatch match;
-        if (std::regex_search(payload, match, lightRegex)) {
-            return std::stof(match[1].str());
-        }
-    } catch (...) {}
+    // Extract numeric value
+    float value = 0.0f;
+    if (IoTPayloadScanner::findFirstNumber(payload, value)) {
+        return value;
+    }
     
     return 500.0f; // Default moderate indoor light
 }
 
 float IoTParameterConverter::convertDistance(const std::string& payload) {
-    try {
-        // Extract numeric value
-        std::regex distanceRegex("([0-9.]+)");
-        std::smatch match;
-        if (std::regex_search(payload, match, distanceRegex)) {
-            return std::stof(match[1].str());
-        }
-    } catch (...) {}
+    // Extract numeric value
+    float value = 0.0f;
+    if (IoTPayloadScanner::findFirstNumber(payload, value)) {
+        return value;
+    }
     
     return 100.0f; // Default 100cm
 }
 
 float IoTParameterConverter::convertAcceleration(const std::string& payload) {
-    try {
-        // Check for JSON format with x,y,z components
-        if (payload.find('{') != std::string::npos) {
-            float x = std::stof(parseJsonValue(payload, "x"));
-            float y = std::stof(parseJsonValue(payload, "y"));
-            float z = std::stof(parseJsonValue(payload, "z"));
-            
-            // Return magnitude of acceleration vector
-            return std::sqrt(x*x + y*y + z*z);
-        }
-        
-        // Check for CSV format x,y,z
-        if (payload.find(',') != std::string::npos) {
-            float x = std::stof(parseCsvValue(payload, 0));
-            float y = std::stof(parseCsvValue(payload, 1));
-            float z = std::stof(parseCsvValue(payload, 2));
-            
-            // Return magnitude of acceleration vector
-            return std::sqrt(x*x + y*y + z*z);
-        }
-        
-        // Simple numeric value
-        return std::stof(payload);
-    } catch (...) {}
+    // JSON {"x":..,"y":..,"z":..}, CSV "x,y,z" or a single magnitude, read in one pass
+    static const IoTExtractionPlan plan = IoTExtractionPlan::automatic({"x", "y", "z"}, {0, 1, 2});
+    
+    float xyz[3] = {0.0f, 0.0f, 0.0f};
+    uint32_t found = plan.extract(payload, xyz);
+    
+    if (found == plan.allFieldsMask()) {
+        // Return magnitude of acceleration vector
+        return std::sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1] + xyz[2] * xyz[2]);
+    }
+    
+    // Simple numeric value
+    if (found == 1u && payload.find_first_of("{,") == std::string::npos) {
+        return xyz[0];
+    }
     
     return 0.0f; // Default no acceleration
 }
 
 float IoTParameterConverter::convertGyroscope(const std::string& payload) {
-    try {
-        // Check for JSON format with x,y,z components
-        if (payload.find('{') != std::string::npos) {
-            float x = std::stof(parseJsonValue(payload, "x"));
-            float y = std::stof(parseJsonValue(payload, "y"));
-            float z = std::stof(parseJsonValue(payload, "z"));
-            
-            // Return magnitude of rotation vector
-            return std::sqrt(x*x + y*y + z*z);
-        }
-        
-        // Check for CSV format x,y,z
-        if (payload.find(',') != std::string::npos) {
-            float x = std::stof(parseCsvValue(payload, 0));
-            float y = std::stof(parseCsvValue(payload, 1));
-            float z = std::stof(parseCsvValue(payload, 2));
-            
-            // Return magnitude of rotation vector
-            return std::sqrt(x*x + y*y + z*z);
-        }
-        
-        // Simple numeric value
-        return std::stof(payload);
-    } catch (...) {}
+    // JSON {"x":..,"y":..,"z":..}, CSV "x,y,z" or a single magnitude, read in one pass
+    static const IoTExtractionPlan plan = IoTExtractionPlan::automatic({"x", "y", "z"}, {0, 1, 2});
+    
+    float xyz[3] = {0.0f, 0.0f, 0.0f};
+    uint32_t found = plan.extract(payload, xyz);
+    
+    if (found == plan.allFieldsMask()) {
+        // Return magnitude of rotation vector
+        return std::sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1] + xyz[2] * xyz[2]);
+    }
+    
+    // Simple numeric value
+    if (found == 1u && payload.find_first_of("{,") == std::string::npos) {
+        return xyz[0];
+    }
     
     return 0.0f; // Default no rotation
 }
@@ -294,51 +248,34 @@ float IoTParameterConverter::convertMotion(const std::string& payload) {
 }
 
 float IoTParameterConverter::convertSound(const std::string& payload) {
-    try {
-        // Extract numeric value
-        std::regex soundRegex("([0-9.]+)");
-        std::smatch match;
-        if (std::regex_search(payload, match, soundRegex)) {
-            return std::stof(match[1].str());
-        }
-    } catch (...) {}
+    // Extract numeric value
+    float value = 0.0f;
+    if (IoTPayloadScanner::findFirstNumber(payload, value)) {
+        return value;
+    }
     
     return 0.0f; // Default silence
 }
 
 float IoTParameterConverter::convertAirQuality(const std::string& payload) {
-    try {
-        // Extract numeric value
-        std::regex aqiRegex("([0-9.]+)");
-        std::smatch match;
-        if (std::regex_search(payload, match, aqiRegex)) {
-            return std::stof(match[1].str());
-        }
-    } catch (...) {}
+    // Extract numeric value
+    float value = 0.0f;
+    if (IoTPayloadScanner::findFirstNumber(payload, value)) {
+        return value;
+    }
     
     return 50.0f; // Default moderate air quality
 }
 
 float IoTParameterConverter::convertGps(const std::string& payload) {
-    try {
-        // Extract latitude and longitude
-        if (payload.find(',') != std::string::npos) {
-            // Format: "latitude,longitude"
-            float latitude = std::stof(parseCsvValue(payload, 0));
-            float longitude = std::stof(parseCsvValue(payload, 1));
-            
-            // Return average (not very useful but simple)
-            return (latitude + longitude) / 2.0f;
-        }
-        else if (payload.find('{') != std::string::npos) {
-            // JSON format
-            float latitude = std::stof(parseJsonValue(payload, "lat"));
-            float longitude = std::stof(parseJsonValue(payload, "lon"));
-            
-            // Return average (not very useful but simple)
-            return (latitude + longitude) / 2.0f;
-        }
-    } catch (...) {}
+    // Extract latitude and longitude: "latitude,longitude" or {"lat":..,"lon":..}
+    static const IoTExtractionPlan plan = IoTExtractionPlan::automatic({"lat", "lon"}, {0, 1});
+    
+    float position[2] = {0.0f, 0.0f};
+    if (plan.extract(payload, position) == plan.allFieldsMask()) {
+        // Return average (not very useful but simple)
+        return (position[0] + position[1]) / 2.0f;
+    }
     
     return 0.0f; // Default origin
 }
@@ -354,10 +291,11 @@ float IoTParameterConverter::convertButton(const std::string& payload) {
 }
 
 float IoTParameterConverter::convertAnalog(const std::string& payload) {
-    try {
-        // Simple numeric value
-        return std::stof(payload);
-    } catch (...) {}
+    // Simple numeric value
+    float value = 0.0f;
+    if (IoTPayloadScanner::parseNumber(payload, value)) {
+        return value;
+    }
     
     return 0.0f; // Default zero
 }
@@ -0,0 +1,276 @@
+#include "../../include/iot/IoTPayloadScanner.h"
+#include <algorithm>
+#include <charconv>
+
+namespace AIMusicHardware {
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Index of the closing quote of a JSON string whose opening quote is at
+// 'open', honoring backslash escapes; npos if unterminated
+size_t closingQuote(std::string_view text, size_t open) {
+    for (size_t i = open + 1; i < text.size(); ++i) {
+        if (text[i] == '\\') {
+            ++i;
+        } else if (text[i] == '"') {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+// Value starting at or after 'pos' (just past a key's ':')
+std::string_view valueAt(std::string_view payload, size_t pos) {
+    while (pos < payload.size() && isSpace(payload[pos])) {
+        ++pos;
+    }
+    if (pos >= payload.size()) {
+        return {};
+    }
+
+    if (payload[pos] == '"') {
+        size_t close = closingQuote(payload, pos);
+        if (close == std::string_view::npos) {
+            return payload.substr(pos + 1);
+        }
+        return payload.substr(pos + 1, close - pos - 1);
+    }
+
+    size_t end = payload.find_first_of(",}]", pos);
+    return IoTPayloadScanner::trim(payload.substr(pos, end == std::string_view::npos ? std::string_view::npos : end - pos));
+}
+
+// Walk every "key": in a JSON document, calling fn(key, valueStart);
+// fn returns false to stop
+template <typename Fn>
+void forEachJsonKey(std::string_view payload, Fn&& fn) {
+    size_t pos = 0;
+    while ((pos = payload.find('"', pos)) != std::string_view::npos) {
+        size_t close = closingQuote(payload, pos);
+        if (close == std::string_view::npos) {
+            return;
+        }
+
+        size_t after = close + 1;
+        while (after < payload.size() && isSpace(payload[after])) {
+            ++after;
+        }
+
+        if (after < payload.size() && payload[after] == ':') {
+            if (!fn(payload.substr(pos + 1, close - pos - 1), after + 1)) {
+                return;
+            }
+        }
+        pos = close + 1;
+    }
+}
+
+} // namespace
+
+std::string_view IoTPayloadScanner::trim(std::string_view text) {
+    size_t start = 0;
+    size_t end = text.size();
+    while (start < end && isSpace(text[start])) {
+        ++start;
+    }
+    while (end > start && isSpace(text[end - 1])) {
+        --end;
+    }
+    return text.substr(start, end - start);
+}
+
+bool IoTPayloadScanner::parseNumber(std::string_view text, float& value) {
+    text = trim(text);
+    if (!text.empty() && text.front() == '"') {
+        text.remove_prefix(1);
+        if (!text.empty() && text.back() == '"') {
+            text.remove_suffix(1);
+        }
+        text = trim(text);
+    }
+    if (text.empty()) {
+        return false;
+    }
+
+    std::string_view number = text.front() == '+' ? text.substr(1) : text;
+    auto result = std::from_chars(number.data(), number.data() + number.size(), value);
+    if (result.ec == std::errc()) {
+        return true;
+    }
+
+    if (text == "true" || text == "True" || text == "on") {
+        value = 1.0f;
+        return true;
+    }
+    if (text == "false" || text == "False" || text == "off") {
+        value = 0.0f;
+        return true;
+    }
+    return false;
+}
+
+bool IoTPayloadScanner::findFirstNumber(std::string_view text, float& value) {
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        char next = i + 1 < text.size() ? text[i + 1] : '\0';
+        bool startsNumber = isDigit(c)
+            || (c == '.' && isDigit(next))
+            || ((c == '-' || c == '+') && (isDigit(next) || next == '.'));
+        if (!startsNumber) {
+            continue;
+        }
+
+        const char* first = text.data() + i + (c == '+' ? 1 : 0);
+        auto result = std::from_chars(first, text.data() + text.size(), value);
+        if (result.ec == std::errc()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string_view IoTPayloadScanner::findJsonValue(std::string_view payload, std::string_view key) {
+    std::string_view found;
+    forEachJsonKey(payload, [&](std::string_view name, size_t valueStart) {
+        if (name == key) {
+            found = valueAt(payload, valueStart);
+            return false;
+        }
+        return true;
+    });
+    return found;
+}
+
+std::string_view IoTPayloadScanner::csvField(std::string_view payload, int index) {
+    if (index < 0) {
+        return {};
+    }
+
+    size_t start = 0;
+    for (int column = 0; column < index; ++column) {
+        size_t comma = payload.find(',', start);
+        if (comma == std::string_view::npos) {
+            return {};
+        }
+        start = comma + 1;
+    }
+
+    size_t end = payload.find(',', start);
+    return trim(payload.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start));
+}
+
+// IoTExtractionPlan implementation
+IoTExtractionPlan IoTExtractionPlan::scalar() {
+    return IoTExtractionPlan();
+}
+
+IoTExtractionPlan IoTExtractionPlan::json(std::initializer_list<std::string_view> keys) {
+    IoTExtractionPlan plan;
+    plan.format_ = Format::Json;
+    plan.fieldCount_ = std::min(keys.size(), kMaxFields);
+    size_t i = 0;
+    for (auto key : keys) {
+        if (i == kMaxFields) break;
+        plan.keys_[i++] = std::string(key);
+    }
+    return plan;
+}
+
+IoTExtractionPlan IoTExtractionPlan::csv(std::initializer_list<int> columns) {
+    IoTExtractionPlan plan;
+    plan.format_ = Format::Csv;
+    plan.fieldCount_ = std::min(columns.size(), kMaxFields);
+    size_t i = 0;
+    for (int column : columns) {
+        if (i == kMaxFields) break;
+        plan.columns_[i++] = column;
+        plan.maxColumn_ = std::max(plan.maxColumn_, column);
+    }
+    return plan;
+}
+
+IoTExtractionPlan IoTExtractionPlan::automatic(std::initializer_list<std::string_view> keys,
+                                               std::initializer_list<int> columns) {
+    IoTExtractionPlan plan = json(keys);
+    IoTExtractionPlan columnPlan = csv(columns);
+    plan.format_ = Format::Auto;
+    plan.fieldCount_ = std::max(plan.fieldCount_, columnPlan.fieldCount_);
+    plan.columns_ = columnPlan.columns_;
+    plan.maxColumn_ = columnPlan.maxColumn_;
+    return plan;
+}
+
+uint32_t IoTExtractionPlan::extract(std::string_view payload, float* values) const {
+    switch (format_) {
+        case Format::Scalar:
+            return IoTPayloadScanner::parseNumber(payload, values[0]) ? 1u : 0u;
+        case Format::Json:
+            return extractJson(payload, values);
+        case Format::Csv:
+            return extractCsv(payload, values);
+        case Format::Auto:
+            if (payload.find('{') != std::string_view::npos) {
+                return extractJson(payload, values);
+            }
+            if (payload.find(',') != std::string_view::npos) {
+                return extractCsv(payload, values);
+            }
+            return IoTPayloadScanner::parseNumber(payload, values[0]) ? 1u : 0u;
+    }
+    return 0;
+}
+
+uint32_t IoTExtractionPlan::extractJson(std::string_view payload, float* values) const {
+    uint32_t found = 0;
+    uint32_t wanted = 0;
+    for (size_t i = 0; i < fieldCount_; ++i) {
+        if (!keys_[i].empty()) wanted |= 1u << i;
+    }
+
+    forEachJsonKey(payload, [&](std::string_view name, size_t valueStart) {
+        for (size_t i = 0; i < fieldCount_; ++i) {
+            uint32_t bit = 1u << i;
+            if ((found & bit) || name != keys_[i]) {
+                continue;
+            }
+            if (IoTPayloadScanner::parseNumber(valueAt(payload, valueStart), values[i])) {
+                found |= bit;
+            }
+            break;
+        }
+        return found != wanted;
+    });
+    return found;
+}
+
+uint32_t IoTExtractionPlan::extractCsv(std::string_view payload, float* values) const {
+    uint32_t found = 0;
+    size_t start = 0;
+
+    for (int column = 0; column <= maxColumn_; ++column) {
+        size_t comma = payload.find(',', start);
+        std::string_view field = payload.substr(start, comma == std::string_view::npos ? std::string_view::npos : comma - start);
+
+        for (size_t i = 0; i < fieldCount_; ++i) {
+            if (columns_[i] == column && IoTPayloadScanner::parseNumber(field, values[i])) {
+                found |= 1u << i;
+            }
+        }
+
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+    return found;
+}
+
+} // namespace AIMusicHardware
@@ -0,0 +1,318 @@
+#include "../../include/iot/LoopbackBroker.h"
+#include <algorithm>
+#include <iostream>
+
+namespace AIMusicHardware {
+
+namespace {
+
+// Topic names may not be empty or contain wildcards
+bool isValidTopicName(const std::string& topic) {
+    return !topic.empty() && topic.find_first_of("+#") == std::string::npos;
+}
+
+} // namespace
+
+// LoopbackBroker implementation
+bool LoopbackBroker::publish(const std::string& topic, const std::string& payload, bool retain) {
+    if (!isValidTopicName(topic)) {
+        std::cerr << "Loopback broker: invalid topic name: " << topic << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++messagesPublished_;
+
+    if (retain) {
+        if (payload.empty()) {
+            retained_.erase(topic);
+        } else {
+            retained_[topic] = payload;
+        }
+    }
+
+    // A client with overlapping filters still receives the message once
+    recipients_.clear();
+    trie_.match(topic, [this](MQTTTopicTrie::SubscriptionId id) {
+        recipients_.push_back(subscriptions_[id].client);
+    });
+    std::sort(recipients_.begin(), recipients_.end());
+    recipients_.erase(std::unique(recipients_.begin(), recipients_.end()), recipients_.end());
+
+    if (recipients_.empty()) {
+        ++messagesUnrouted_;
+    }
+    for (auto* client : recipients_) {
+        client->enqueue(topic, payload);
+    }
+    messagesDelivered_ += recipients_.size();
+    return true;
+}
+
+LoopbackBroker::Statistics LoopbackBroker::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Statistics{
+        messagesPublished_,
+        messagesDelivered_,
+        messagesUnrouted_,
+        retained_.size(),
+        subscriptionIds_.size()
+    };
+}
+
+bool LoopbackBroker::subscribe(LoopbackIoTInterface* client, const std::string& filter) {
+    if (!MQTTTopicTrie::isValidFilter(filter)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto key = std::make_pair(client, filter);
+    if (subscriptionIds_.find(key) == subscriptionIds_.end()) {
+        MQTTTopicTrie::SubscriptionId id;
+        if (!freeSubscriptions_.empty()) {
+            id = freeSubscriptions_.back();
+            freeSubscriptions_.pop_back();
+        } else {
+            id = static_cast<MQTTTopicTrie::SubscriptionId>(subscriptions_.size());
+            subscriptions_.emplace_back();
+        }
+        trie_.insert(filter, id);
+        subscriptions_[id] = Subscription{client, filter};
+        subscriptionIds_[key] = id;
+    }
+
+    // Retained messages are sent on every subscribe, as a broker would
+    for (const auto& [topic, payload] : retained_) {
+        if (MQTTTopicTrie::matches(topic, filter)) {
+            client->enqueue(topic, payload);
+            ++messagesDelivered_;
+        }
+    }
+    return true;
+}
+
+bool LoopbackBroker::unsubscribe(LoopbackIoTInterface* client, const std::string& filter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = subscriptionIds_.find(std::make_pair(client, filter));
+    if (it == subscriptionIds_.end()) {
+        return false;
+    }
+
+    trie_.remove(filter, it->second);
+    subscriptions_[it->second] = Subscription{};
+    freeSubscriptions_.push_back(it->second);
+    subscriptionIds_.erase(it);
+    return true;
+}
+
+void LoopbackBroker::unsubscribeAll(LoopbackIoTInterface* client) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = subscriptionIds_.begin(); it != subscriptionIds_.end();) {
+        if (it->first.first != client) {
+            ++it;
+            continue;
+        }
+        trie_.remove(it->first.second, it->second);
+        subscriptions_[it->second] = Subscription{};
+        freeSubscriptions_.push_back(it->second);
+        it = subscriptionIds_.erase(it);
+    }
+}
+
+// LoopbackIoTInterface implementation
+LoopbackIoTInterface::LoopbackIoTInterface(std::shared_ptr<LoopbackBroker> broker)
+    : broker_(broker ? std::move(broker) : std::make_shared<LoopbackBroker>()) {
+}
+
+LoopbackIoTInterface::~LoopbackIoTInterface() {
+    disconnect();
+}
+
+bool LoopbackIoTInterface::connect(const std::string& host, int port, const std::string& clientId) {
+    (void)host;
+    (void)port;
+    clientId_ = clientId;
+    connected_.store(true, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    for (const auto& filter : subscriptions_) {
+        broker_->subscribe(this, filter);
+    }
+    return true;
+}
+
+void LoopbackIoTInterface::disconnect() {
+    if (!connected_.exchange(false)) {
+        return;
+    }
+    broker_->unsubscribeAll(this);
+}
+
+bool LoopbackIoTInterface::isConnected() const {
+    return connected_.load(std::memory_order_acquire);
+}
+
+void LoopbackIoTInterface::update() {
+    {
+        std::lock_guard<std::mutex> lock(inboxMutex_);
+        dispatching_.swap(inbox_);
+    }
+
+    for (const auto& message : dispatching_) {
+        dispatch(message);
+    }
+    dispatching_.clear();
+}
+
+bool LoopbackIoTInterface::subscribe(const std::string& topic) {
+    if (!MQTTTopicTrie::isValidFilter(topic)) {
+        std::cerr << "Loopback client: invalid topic filter: " << topic << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    subscriptions_.insert(topic);
+    return !isConnected() || broker_->subscribe(this, topic);
+}
+
+bool LoopbackIoTInterface::unsubscribe(const std::string& topic) {
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    if (subscriptions_.erase(topic) == 0) {
+        return false;
+    }
+    if (isConnected()) {
+        broker_->unsubscribe(this, topic);
+    }
+    return true;
+}
+
+bool LoopbackIoTInterface::publish(const std::string& topic, const std::string& payload) {
+    return publish(topic, payload, 0, false);
+}
+
+bool LoopbackIoTInterface::publish(const std::string& topic, const std::string& payload,
+                                   int qos, bool retain) {
+    (void)qos;
+    if (!isConnected()) {
+        return false;
+    }
+    return broker_->publish(topic, payload, retain);
+}
+
+void LoopbackIoTInterface::setMessageCallback(MessageCallback callback) {
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    globalMessageCallback_ = std::move(callback);
+}
+
+void LoopbackIoTInterface::setTopicCallback(const std::string& topic, MessageCallback callback) {
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex_);
+        auto shared = std::make_shared<const MessageCallback>(std::move(callback));
+
+        auto it = topicCallbackIds_.find(topic);
+        if (it != topicCallbackIds_.end()) {
+            topicCallbackSlots_[it->second].callback = std::move(shared);
+        } else {
+            MQTTTopicTrie::SubscriptionId id;
+            if (!freeCallbackSlots_.empty()) {
+                id = freeCallbackSlots_.back();
+                freeCallbackSlots_.pop_back();
+            } else {
+                id = static_cast<MQTTTopicTrie::SubscriptionId>(topicCallbackSlots_.size());
+                topicCallbackSlots_.emplace_back();
+            }
+
+            if (!topicCallbackTrie_.insert(topic, id)) {
+                std::cerr << "Loopback client: invalid topic filter: " << topic << std::endl;
+                freeCallbackSlots_.push_back(id);
+                return;
+            }
+            topicCallbackSlots_[id] = TopicCallbackSlot{topic, std::move(shared)};
+            topicCallbackIds_[topic] = id;
+        }
+    }
+
+    // Subscribe outside the callback lock; retained messages may be enqueued
+    subscribe(topic);
+}
+
+void LoopbackIoTInterface::removeTopicCallback(const std::string& topic) {
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    auto it = topicCallbackIds_.find(topic);
+    if (it == topicCallbackIds_.end()) {
+        return;
+    }
+
+    topicCallbackTrie_.remove(topic, it->second);
+    topicCallbackSlots_[it->second] = TopicCallbackSlot{};
+    freeCallbackSlots_.push_back(it->second);
+    topicCallbackIds_.erase(it);
+}
+
+bool LoopbackIoTInterface::waitForMessages(std::chrono::microseconds timeout) {
+    std::unique_lock<std::mutex> lock(inboxMutex_);
+    inboxCondition_.wait_for(lock, timeout, [this]() { return !inbox_.empty() || wakeRequested_; });
+    wakeRequested_ = false;
+    return !inbox_.empty();
+}
+
+void LoopbackIoTInterface::wake() {
+    {
+        std::lock_guard<std::mutex> lock(inboxMutex_);
+        wakeRequested_ = true;
+    }
+    inboxCondition_.notify_all();
+}
+
+size_t LoopbackIoTInterface::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(inboxMutex_);
+    return inbox_.size();
+}
+
+void LoopbackIoTInterface::enqueue(const std::string& topic, const std::string& payload) {
+    size_t pending = 0;
+    {
+        std::lock_guard<std::mutex> lock(inboxMutex_);
+        inbox_.push_back(Message{topic, payload});
+        pending = inbox_.size();
+    }
+    if (pending > maxPending_.load(std::memory_order_relaxed)) {
+        maxPending_.store(pending, std::memory_order_relaxed);
+    }
+    inboxCondition_.notify_one();
+}
+
+void LoopbackIoTInterface::dispatch(const Message& message) {
+    std::shared_ptr<const MessageCallback> topicCallback;
+    MessageCallback globalCallback;
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex_);
+
+        // An exact filter wins; otherwise the first matching filter in lexical order
+        const TopicCallbackSlot* best = nullptr;
+        topicCallbackTrie_.match(message.topic, [&](MQTTTopicTrie::SubscriptionId id) {
+            const TopicCallbackSlot& slot = topicCallbackSlots_[id];
+            if (!slot.callback || !*slot.callback) {
+                return;
+            }
+            if (!best || slot.filter == message.topic ||
+                (best->filter != message.topic && slot.filter < best->filter)) {
+                best = &slot;
+            }
+        });
+
+        if (best) {
+            topicCallback = best->callback;
+        } else if (globalMessageCallback_) {
+            globalCallback = globalMessageCallback_;
+        }
+    }
+
+    if (topicCallback) {
+        (*topicCallback)(message.topic, message.payload);
+    } else if (globalCallback) {
+        globalCallback(message.topic, message.payload);
+    }
+}
+
+} // namespace AIMusicHardware
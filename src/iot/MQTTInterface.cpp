@@ -1,7 +1,6 @@
 #include "../../include/iot/MQTTInterface.h"
 
 #include <iostream>
-#include <regex>
 #include <stdexcept>
 #include <thread>
 #include <chrono>
@@ -134,7 +133,7 @@ bool MQTTInterface::subscribe(const std::string& topic) {
     // Add to subscription list even if not connected
     subscriptions_.insert(topic);
 
-    if (!isConnected()) {
+    if (!client_ || !client_->is_connected()) {
         return false;
     }
 
@@ -154,7 +153,7 @@ bool MQTTInterface::unsubscribe(const std::string& topic) {
     // Remove from subscription list
     subscriptions_.erase(topic);
 
-    if (!isConnected()) {
+    if (!client_ || !client_->is_connected()) {
         return false;
     }
 
@@ -176,7 +175,7 @@ bool MQTTInterface::publish(const std::string& topic, const std::string& payload
                            int qos, bool retain) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    if (!isConnected()) {
+    if (!client_ || !client_->is_connected()) {
         return false;
     }
 
@@ -197,18 +196,54 @@ void MQTTInterface::setMessageCallback(MessageCallback callback) {
 }
 
 void MQTTInterface::setTopicCallback(const std::string& topic, MessageCallback callback) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    topicCallbacks_[topic] = callback;
+    bool needsSubscribe = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto shared = std::make_shared<const MessageCallback>(std::move(callback));
+        
+        auto it = topicCallbackIds_.find(topic);
+        if (it != topicCallbackIds_.end()) {
+            topicCallbackSlots_[it->second].callback = std::move(shared);
+        } else {
+            // Compile the filter into the trie once, here, rather than per message
+            MQTTTopicTrie::SubscriptionId id;
+            if (!freeCallbackSlots_.empty()) {
+                id = freeCallbackSlots_.back();
+                freeCallbackSlots_.pop_back();
+            } else {
+                id = static_cast<MQTTTopicTrie::SubscriptionId>(topicCallbackSlots_.size());
+                topicCallbackSlots_.emplace_back();
+            }
+            
+            if (!topicCallbackTrie_.insert(topic, id)) {
+                std::cerr << "Invalid MQTT topic filter: " << topic << std::endl;
+                freeCallbackSlots_.push_back(id);
+                return;
+            }
+            topicCallbackSlots_[id] = TopicCallbackSlot{topic, std::move(shared)};
+            topicCallbackIds_[topic] = id;
+        }
+        
+        needsSubscribe = subscriptions_.find(topic) == subscriptions_.end();
+    }
     
-    // Ensure we're subscribed to this topic
-    if (subscriptions_.find(topic) == subscriptions_.end()) {
+    // Ensure we're subscribed to this topic (subscribe() takes the lock itself)
+    if (needsSubscribe) {
         subscribe(topic);
     }
 }
 
 void MQTTInterface::removeTopicCallback(const std::string& topic) {
     std::lock_guard<std::mutex> lock(mutex_);
-    topicCallbacks_.erase(topic);
+    auto it = topicCallbackIds_.find(topic);
+    if (it == topicCallbackIds_.end()) {
+        return;
+    }
+    
+    topicCallbackTrie_.remove(topic, it->second);
+    topicCallbackSlots_[it->second] = TopicCallbackSlot{};
+    freeCallbackSlots_.push_back(it->second);
+    topicCallbackIds_.erase(it);
 }
 
 void MQTTInterface::setConnectionOptions(int keepAliveInterval, bool cleanSession, bool automaticReconnect) {
@@ -251,90 +286,38 @@ void MQTTInterface::onMessage(const mqtt::const_message_ptr& msg) {
     std::string topic = msg->get_topic();
     std::string payload = msg->get_payload_str();
 
-    // First check for specific topic callbacks
-    bool handledByTopicCallback = false;
+    std::shared_ptr<const MessageCallback> topicCallback;
+    MessageCallback globalCallback;
     {
         std::lock_guard<std::mutex> lock(mutex_);
 
-        // Direct topic match
-        auto it = topicCallbacks_.find(topic);
-        if (it != topicCallbacks_.end() && it->second) {
-            // Make a copy of the callback to avoid holding the lock during execution
-            MessageCallback callback = it->second;
-            lock.~lock_guard(); // Explicitly release the lock
-
-            callback(topic, payload);
-            handledByTopicCallback = true;
-        }
-        else {
-            // Check for pattern matches
-            for (const auto& [pattern, callback] : topicCallbacks_) {
-                if (matchTopicPattern(topic, pattern) && callback) {
-                    // Make a copy of the callback to avoid holding the lock during execution
-                    MessageCallback cb = callback;
-                    lock.~lock_guard(); // Explicitly release the lock
-
-                    cb(topic, payload);
-                    handledByTopicCallback = true;
-                    break;
-                }
+        // An exact filter wins; otherwise the first matching filter in lexical order
+        const TopicCallbackSlot* best = nullptr;
+        topicCallbackTrie_.match(topic, [&](MQTTTopicTrie::SubscriptionId id) {
+            const TopicCallbackSlot& slot = topicCallbackSlots_[id];
+            if (!slot.callback || !*slot.callback) {
+                return;
             }
-        }
-    }
-
-    // If not handled by a topic callback, use the global callback
-    if (!handledByTopicCallback) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (globalMessageCallback_) {
-            // Make a copy of the callback to avoid holding the lock during execution
-            MessageCallback callback = globalMessageCallback_;
-            lock.~lock_guard(); // Explicitly release the lock
+            if (!best || slot.filter == topic ||
+                (best->filter != topic && slot.filter < best->filter)) {
+                best = &slot;
+            }
+        });
 
-            callback(topic, payload);
+        // Copy the callback so it runs without holding the lock
+        if (best) {
+            topicCallback = best->callback;
+        } else if (globalMessageCallback_) {
+            globalCallback = globalMessageCallback_;
         }
     }
-}
 
-bool MQTTInterface::matchTopicPattern(const std::string& topic, const std::string& pattern) const {
-    // Simple wildcard matching for MQTT topics
-    // e.g., "sensors/#" matches "sensors/temp", "sensors/humidity/kitchen", etc.
-    
-    // Exact match
-    if (pattern == topic) {
-        return true;
-    }
-    
-    // Single-level wildcard +
-    if (pattern.find('+') != std::string::npos) {
-        // Replace + with regex for any non-slash sequence
-        std::string regexPattern = pattern;
-        size_t pos = 0;
-        while ((pos = regexPattern.find('+', pos)) != std::string::npos) {
-            regexPattern.replace(pos, 1, "([^/]+)");
-            pos += 7; // length of "([^/]+)"
-        }
-        
-        std::regex re(regexPattern);
-        return std::regex_match(topic, re);
-    }
-    
-    // Multi-level wildcard #
-    if (pattern.find('#') != std::string::npos) {
-        // # must be the last character and preceded by /
-        if (pattern.back() == '#') {
-            std::string prefix = pattern.substr(0, pattern.length() - 1);
-            
-            // If # is the only character, it matches everything
-            if (prefix.empty()) {
-                return true;
-            }
-            
-            // Check if topic starts with prefix
-            return topic.compare(0, prefix.length(), prefix) == 0;
-        }
+    // If not handled by a topic callback, use the global callback
+    if (topicCallback) {
+        (*topicCallback)(topic, payload);
+    } else if (globalCallback) {
+        globalCallback(topic, payload);
     }
-    
-    return false;
 }
 
 void MQTTInterface::reconnect() {
@@ -0,0 +1,200 @@
+#include "../../include/iot/MQTTTopicTrie.h"
+#include <algorithm>
+
+namespace AIMusicHardware {
+
+MQTTTopicTrie::MQTTTopicTrie() {
+    clear();
+}
+
+void MQTTTopicTrie::clear() {
+    nodes_.clear();
+    nodes_.emplace_back();
+    size_ = 0;
+}
+
+bool MQTTTopicTrie::isValidFilter(std::string_view filter) {
+    if (filter.empty()) {
+        return false;
+    }
+
+    size_t pos = 0;
+    while (true) {
+        size_t slash = filter.find('/', pos);
+        std::string_view level = filter.substr(pos, slash == std::string_view::npos ? std::string_view::npos : slash - pos);
+        bool last = slash == std::string_view::npos;
+
+        if (level.find_first_of("+#") != std::string_view::npos) {
+            if (level.size() != 1) {
+                return false;   // wildcard mixed with literal text, e.g. "temp+"
+            }
+            if (level[0] == '#' && !last) {
+                return false;   // '#' must be the final level
+            }
+        }
+
+        if (last) {
+            return true;
+        }
+        pos = slash + 1;
+    }
+}
+
+bool MQTTTopicTrie::matches(std::string_view topic, std::string_view filter) {
+    if (!isValidFilter(filter)) {
+        return false;
+    }
+
+    bool system = !topic.empty() && topic.front() == '$';
+    size_t topicPos = 0;
+    size_t filterPos = 0;
+    bool firstLevel = true;
+
+    while (true) {
+        size_t filterSlash = filter.find('/', filterPos);
+        std::string_view filterLevel = filter.substr(filterPos,
+            filterSlash == std::string_view::npos ? std::string_view::npos : filterSlash - filterPos);
+
+        if (filterLevel == "#") {
+            return !(firstLevel && system);
+        }
+
+        if (topicPos == kEndOfTopic) {
+            return false;   // filter has more levels than the topic
+        }
+
+        size_t topicSlash = topic.find('/', topicPos);
+        std::string_view topicLevel = topic.substr(topicPos,
+            topicSlash == std::string_view::npos ? std::string_view::npos : topicSlash - topicPos);
+
+        if (filterLevel == "+") {
+            if (firstLevel && system) {
+                return false;
+            }
+        } else if (filterLevel != topicLevel) {
+            return false;
+        }
+
+        topicPos = topicSlash == std::string_view::npos ? kEndOfTopic : topicSlash + 1;
+        firstLevel = false;
+
+        if (filterSlash == std::string_view::npos) {
+            return topicPos == kEndOfTopic;
+        }
+        filterPos = filterSlash + 1;
+
+        // "a/#" matches "a": the topic ran out right before a trailing '#'
+        if (topicPos == kEndOfTopic && filter.substr(filterPos) == "#") {
+            return true;
+        }
+    }
+}
+
+uint32_t MQTTTopicTrie::findChild(const Node& node, std::string_view label) const {
+    auto it = std::lower_bound(node.children.begin(), node.children.end(), label,
+        [this](uint32_t child, std::string_view key) {
+            return std::string_view(nodes_[child].label) < key;
+        });
+    if (it != node.children.end() && nodes_[*it].label == label) {
+        return *it;
+    }
+    return kNoNode;
+}
+
+uint32_t MQTTTopicTrie::findOrCreateChild(uint32_t nodeIndex, std::string_view label) {
+    if (label == "+") {
+        if (nodes_[nodeIndex].wildcardChild == kNoNode) {
+            uint32_t child = static_cast<uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+            nodes_[child].label = "+";
+            nodes_[nodeIndex].wildcardChild = child;
+        }
+        return nodes_[nodeIndex].wildcardChild;
+    }
+
+    uint32_t existing = findChild(nodes_[nodeIndex], label);
+    if (existing != kNoNode) {
+        return existing;
+    }
+
+    uint32_t child = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+    nodes_[child].label = std::string(label);
+
+    auto& children = nodes_[nodeIndex].children;
+    auto it = std::lower_bound(children.begin(), children.end(), label,
+        [this](uint32_t c, std::string_view key) {
+            return std::string_view(nodes_[c].label) < key;
+        });
+    children.insert(it, child);
+    return child;
+}
+
+uint32_t MQTTTopicTrie::walk(std::string_view filter, bool create, bool& multiLevel) {
+    uint32_t node = 0;
+    multiLevel = false;
+
+    size_t pos = 0;
+    while (true) {
+        size_t slash = filter.find('/', pos);
+        std::string_view level = filter.substr(pos, slash == std::string_view::npos ? std::string_view::npos : slash - pos);
+
+        if (level == "#") {
+            multiLevel = true;
+            return node;
+        }
+
+        if (create) {
+            node = findOrCreateChild(node, level);
+        } else {
+            node = level == "+" ? nodes_[node].wildcardChild : findChild(nodes_[node], level);
+            if (node == kNoNode) {
+                return kNoNode;
+            }
+        }
+
+        if (slash == std::string_view::npos) {
+            return node;
+        }
+        pos = slash + 1;
+    }
+}
+
+bool MQTTTopicTrie::insert(std::string_view filter, SubscriptionId id) {
+    if (!isValidFilter(filter)) {
+        return false;
+    }
+
+    bool multiLevel = false;
+    uint32_t node = walk(filter, true, multiLevel);
+    auto& ids = multiLevel ? nodes_[node].multiLevel : nodes_[node].exact;
+    if (std::find(ids.begin(), ids.end(), id) == ids.end()) {
+        ids.push_back(id);
+        ++size_;
+    }
+    return true;
+}
+
+bool MQTTTopicTrie::remove(std::string_view filter, SubscriptionId id) {
+    if (!isValidFilter(filter)) {
+        return false;
+    }
+
+    bool multiLevel = false;
+    uint32_t node = walk(filter, false, multiLevel);
+    if (node == kNoNode) {
+        return false;
+    }
+
+    // Nodes are kept so indices stay stable; an empty branch only costs a lookup
+    auto& ids = multiLevel ? nodes_[node].multiLevel : nodes_[node].exact;
+    auto it = std::find(ids.begin(), ids.end(), id);
+    if (it == ids.end()) {
+        return false;
+    }
+    ids.erase(it);
+    --size_;
+    return true;
+}
+
+} // namespace AIMusicHardware
@@ -0,0 +1,96 @@
+#include "../../include/iot/SensorFrameDecoder.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace AIMusicHardware {
+
+SensorFrameDecoder::Status SensorFrameDecoder::decode(std::string_view payload, SensorReading* readings,
+                                                      size_t maxReadings, size_t& count) {
+    count = 0;
+    if (!isFrame(payload)) {
+        return Status::NotAFrame;
+    }
+
+    const auto* data = reinterpret_cast<const uint8_t*>(payload.data());
+    const size_t size = payload.size();
+    if ((data[1] >> 4) != SensorFrame::kVersion) {
+        return Status::UnsupportedVersion;
+    }
+
+    const size_t records = data[2];
+    if (records > maxReadings) {
+        return Status::TooManyRecords;
+    }
+    const uint32_t base = SensorFrame::readU32(data + 4);
+
+    size_t offset = SensorFrame::kFrameHeaderSize;
+    for (size_t i = 0; i < records; ++i) {
+        if (offset + SensorFrame::kRecordHeaderSize > size) {
+            return Status::Truncated;
+        }
+        const uint8_t* record = data + offset;
+        const uint8_t valueCount = record[1] & SensorFrame::kValueCountMask;
+        const bool int16 = (record[1] & SensorFrame::kInt16Flag) != 0;
+        if (valueCount == 0) {
+            return Status::BadRecord;
+        }
+
+        const size_t valueBytes = valueCount * (int16 ? 2u : 4u);
+        if (offset + SensorFrame::kRecordHeaderSize + valueBytes > size) {
+            return Status::Truncated;
+        }
+
+        SensorReading& reading = readings[i];
+        reading.type = record[0];
+        reading.valueCount = valueCount;
+        reading.sequence = SensorFrame::readU16(record + 4);
+        reading.timestampMs = base + SensorFrame::readU16(record + 6);
+
+        const uint8_t* values = record + SensorFrame::kRecordHeaderSize;
+        if (int16) {
+            const float scale = std::pow(10.0f, static_cast<float>(static_cast<int8_t>(record[2])));
+            for (uint8_t v = 0; v < valueCount; ++v) {
+                reading.values[v] = static_cast<int16_t>(SensorFrame::readU16(values + 2 * v)) * scale;
+            }
+        } else {
+            for (uint8_t v = 0; v < valueCount; ++v) {
+                uint32_t bits = SensorFrame::readU32(values + 4 * v);
+                std::memcpy(&reading.values[v], &bits, sizeof(float));
+            }
+        }
+        offset += SensorFrame::kRecordHeaderSize + valueBytes;
+    }
+
+    // Trailing bytes mean the record count and the payload disagree
+    if (offset != size) {
+        return Status::Truncated;
+    }
+
+    count = records;
+    return Status::Ok;
+}
+
+void SensorFrameDecoder::formatValues(const SensorReading& reading, std::string& out) {
+    out.clear();
+    char buffer[24];
+    for (uint8_t v = 0; v < reading.valueCount; ++v) {
+        int length = std::snprintf(buffer, sizeof(buffer), v == 0 ? "%.7g" : ",%.7g",
+                                   static_cast<double>(reading.values[v]));
+        out.append(buffer, length > 0 ? static_cast<size_t>(length) : 0);
+    }
+}
+
+const char* SensorFrameDecoder::statusName(Status status) {
+    switch (status) {
+        case Status::Ok: return "ok";
+        case Status::NotAFrame: return "not a frame";
+        case Status::UnsupportedVersion: return "unsupported version";
+        case Status::Truncated: return "truncated";
+        case Status::BadRecord: return "bad record";
+        case Status::TooManyRecords: return "too many records";
+    }
+    return "unknown";
+}
+
+} // namespace AIMusicHardware
@@ -90,18 +90,44 @@ int main(int argc, char* argv[]) {
     // Mutex for thread safety in audio callback
     std::mutex audioMutex;
     
+    // Quality level last applied to the synthesizer and effects (audio thread only)
+    LoadGovernor::QualityLevel appliedQuality = LoadGovernor::QualityLevel::Full;
+    
+    // Break the callback's DSP load down by subsystem
+    DspLoadMonitor& loadMonitor = audioEngine->getLoadMonitor();
+    const int sequencerLoad = loadMonitor.addSubsystem("sequencer");
+    const int synthLoad = loadMonitor.addSubsystem("synth");
+    const int effectsLoad = loadMonitor.addSubsystem("effects");
+    
     // Set up audio callback with thread safety
     audioEngine->setAudioCallback([&](float* outputBuffer, int numFrames) {
         std::lock_guard<std::mutex> lock(audioMutex);
         
+        // Trade voice and effect quality for headroom when callbacks near their deadline
+        const LoadGovernor::QualityLevel quality = audioEngine->getLoadGovernor().getLevel();
+        if (quality != appliedQuality) {
+            synthesizer->setRenderQuality(LoadGovernor::renderQualityFor(quality));
+            effectProcessor->setTailEffectsBypassed(LoadGovernor::bypassesEffectTails(quality));
+            appliedQuality = quality;
+        }
+        
         // Process sequencer
-        sequencer->process(1.0 / audioEngine->getSampleRate() * numFrames);
+        {
+            DspLoadMonitor::ScopedSubsystem timing(loadMonitor, sequencerLoad);
+            sequencer->process(1.0 / audioEngine->getSampleRate() * numFrames);
+        }
         
         // Process synthesizer
-        synthesizer->process(outputBuffer, numFrames);
+        {
+            DspLoadMonitor::ScopedSubsystem timing(loadMonitor, synthLoad);
+            synthesizer->process(outputBuffer, numFrames);
+        }
         
         // Process effects
-        effectProcessor->process(outputBuffer, numFrames);
+        {
+            DspLoadMonitor::ScopedSubsystem timing(loadMonitor, effectsLoad);
+            effectProcessor->process(outputBuffer, numFrames);
+        }
     });
     
     // Set up MIDI handling with explicit lambda (clearer callback signature)
@@ -419,12 +419,14 @@ int main(int argc, char* argv[]) {
     mainScreen->addChild(std::move(vizSection));
     
     auto waveform = std::make_unique<WaveformVisualizer>("waveform", 512);
+    waveform->setSampleRate(static_cast<float>(audioEngine->getSampleRate()));
     waveform->setPosition(50, 260);
     waveform->setSize(280, 140);
     waveform->setWaveformColor(Color(0, 255, 128));
     mainScreen->addChild(std::move(waveform));
     
     auto spectrum = std::make_unique<SpectrumAnalyzer>("spectrum", 32);
+    spectrum->setSampleRate(static_cast<float>(audioEngine->getSampleRate()));
     spectrum->setPosition(350, 260);
     spectrum->setSize(280, 140);
     mainScreen->addChild(std::move(spectrum));
@@ -124,29 +124,149 @@ void MidiCCLearning::processLearningCC(int channel, int ccNumber, int value, con
 }
 
 void MidiCCLearning::processNormalCC(int channel, int ccNumber, int value) {
-    std::lock_guard<std::mutex> lock(mappingsMutex_);
+    if (channel < 0 || channel > 15 || ccNumber < 0 || ccNumber > 127) {
+        return;
+    }
+    value = std::clamp(value, 0, 127);
     
-    auto mappingKey = std::make_pair(channel, ccNumber);
-    auto it = mappings_.find(mappingKey);
+    // Announce the read before loading the table so a concurrent rebuild
+    // keeps the table alive until we are done with it
+    dispatchReaders_.fetch_add(1);
+    const DispatchTable* table = dispatchTable_.load();
     
-    // Also check for "any channel" mappings
-    if (it == mappings_.end()) {
-        mappingKey = std::make_pair(-1, ccNumber);
-        it = mappings_.find(mappingKey);
+    if (table) {
+        const DispatchEntry& entry = table->entries[channel * 128 + ccNumber];
+        if (entry.parameterIndex >= 0) {
+            float paramValue = table->curves[entry.curveIndex].values[value];
+            
+            if (parameterIndexCallback_) {
+                parameterIndexCallback_(entry.parameterIndex, paramValue);
+            }
+            notifyParameterChange(*entry.parameterId, paramValue);
+        }
     }
     
-    if (it != mappings_.end() && it->second.isActive) {
-        const CCMapping& mapping = it->second;
-        float paramValue = convertCCValue(value, mapping);
-        
-        // Apply smoothing if configured
-        if (mapping.smoothing > 0.0f) {
-            // In a real implementation, we'd track previous values for smoothing
-            // For now, apply simple smoothing concept
+    dispatchReaders_.fetch_sub(1);
+}
+
+void MidiCCLearning::processMidiCC14(int channel, int ccNumber, int value) {
+    if (!enabled_.load() || learningState_.load() != LearningState::Idle) {
+        return;
+    }
+    if (channel < 0 || channel > 15 || ccNumber < 0 || ccNumber > 127) {
+        return;
+    }
+    updateStatistics(channel, ccNumber);
+    
+    dispatchReaders_.fetch_add(1);
+    const DispatchTable* table = dispatchTable_.load();
+    
+    if (table) {
+        const DispatchEntry& entry = table->entries[channel * 128 + ccNumber];
+        if (entry.parameterIndex >= 0) {
+            // The 128-point table would quantize a 14-bit sweep, so evaluate the curve directly
+            const CurveTable& curve = table->curves[entry.curveIndex];
+            float normalized = static_cast<float>(std::clamp(value, 0, 16383)) / 16383.0f;
+            if (curve.inverted) {
+                normalized = 1.0f - normalized;
+            }
+            normalized = applyCurve(normalized, curve.curveType);
+            float paramValue = curve.minValue + normalized * (curve.maxValue - curve.minValue);
+            
+            if (parameterIndexCallback_) {
+                parameterIndexCallback_(entry.parameterIndex, paramValue);
+            }
+            notifyParameterChange(*entry.parameterId, paramValue);
         }
-        
-        notifyParameterChange(mapping.parameterId, paramValue);
     }
+    
+    dispatchReaders_.fetch_sub(1);
+}
+
+void MidiCCLearning::processUniversalEvent(const UniversalMidiEvent& event) {
+    if (event.kind != UniversalMidiEvent::Kind::ControlChange) {
+        return;
+    }
+    
+    if (learningState_.load() != LearningState::Idle) {
+        processMidiCC(event.channel, event.index, event.value7(), "UMP");
+        return;
+    }
+    processMidiCC14(event.channel, event.index, event.value14());
+}
+
+void MidiCCLearning::rebuildDispatchTable() {
+    auto table = std::make_unique<DispatchTable>();
+    
+    // Channel-specific mappings first so they take precedence over "any channel" ones
+    for (int pass = 0; pass < 2; ++pass) {
+        bool anyChannelPass = pass == 1;
+        for (const auto& pair : mappings_) {
+            const CCMapping& mapping = pair.second;
+            int channel = pair.first.first;
+            int ccNumber = pair.first.second;
+            if ((channel < 0) != anyChannelPass || !mapping.isActive ||
+                ccNumber < 0 || ccNumber > 127 || channel > 15) {
+                continue;
+            }
+            
+            CurveTable curve;
+            for (int value = 0; value < 128; ++value) {
+                curve.values[value] = convertCCValue(value, mapping);
+            }
+            curve.minValue = mapping.minValue;
+            curve.maxValue = mapping.maxValue;
+            curve.inverted = mapping.inverted;
+            curve.curveType = mapping.curveType;
+            
+            DispatchEntry entry;
+            entry.parameterIndex = internParameter(mapping.parameterId);
+            entry.parameterId = &parameterIds_[entry.parameterIndex];
+            entry.curveIndex = static_cast<int32_t>(table->curves.size());
+            table->curves.push_back(curve);
+            
+            if (!anyChannelPass) {
+                table->entries[channel * 128 + ccNumber] = entry;
+                continue;
+            }
+            for (int ch = 0; ch < 16; ++ch) {
+                DispatchEntry& slot = table->entries[ch * 128 + ccNumber];
+                if (slot.parameterIndex < 0) {
+                    slot = entry;
+                }
+            }
+        }
+    }
+    
+    // Publish, then free old tables only if no reader can still hold one
+    std::unique_ptr<const DispatchTable> published(table.release());
+    dispatchTable_.store(published.get());
+    if (currentTable_) {
+        retiredTables_.push_back(std::move(currentTable_));
+    }
+    currentTable_ = std::move(published);
+    
+    if (dispatchReaders_.load() == 0) {
+        retiredTables_.clear();
+    }
+}
+
+int MidiCCLearning::internParameter(const std::string& parameterId) {
+    auto it = parameterIndices_.find(parameterId);
+    if (it != parameterIndices_.end()) {
+        return it->second;
+    }
+    
+    int index = static_cast<int>(parameterIds_.size());
+    parameterIds_.push_back(parameterId);
+    parameterIndices_[parameterId] = index;
+    return index;
+}
+
+int MidiCCLearning::getParameterIndex(const std::string& parameterId) const {
+    std::lock_guard<std::mutex> lock(mappingsMutex_);
+    auto it = parameterIndices_.find(parameterId);
+    return it != parameterIndices_.end() ? it->second : -1;
 }
 
 float MidiCCLearning::convertCCValue(int ccValue, const CCMapping& mapping) const {
@@ -206,6 +326,7 @@ bool MidiCCLearning::createMapping(const CCMapping& mapping) {
     // Add new mapping
     mappings_[mappingKey] = mapping;
     parameterToCC_[mapping.parameterId] = mappingKey;
+    rebuildDispatchTable();
     
     // Update statistics
     {
@@ -235,6 +356,7 @@ bool MidiCCLearning::removeMapping(int channel, int ccNumber) {
         // Remove from parameter lookup
         parameterToCC_.erase(it->second.parameterId);
         mappings_.erase(it);
+        rebuildDispatchTable();
         
         // Update statistics
         {
@@ -257,6 +379,7 @@ bool MidiCCLearning::removeMapping(const std::string& parameterId) {
     if (it != parameterToCC_.end()) {
         mappings_.erase(it->second);
         parameterToCC_.erase(it);
+        rebuildDispatchTable();
         
         // Update statistics
         {
@@ -324,6 +447,7 @@ void MidiCCLearning::clearAllMappings() {
     
     mappings_.clear();
     parameterToCC_.clear();
+    rebuildDispatchTable();
     
     // Update statistics
     {
@@ -351,11 +475,13 @@ void MidiCCLearning::notifyParameterChange(const std::string& parameterId, float
 }
 
 void MidiCCLearning::updateStatistics(int channel, int ccNumber) {
-    std::lock_guard<std::mutex> lock(statsMutex_);
-    
-    stats_.messagesProcessed++;
-    stats_.lastActivity = std::chrono::system_clock::now();
-    stats_.ccUsageCount[ccNumber]++;
+    (void)channel;
+    messagesProcessed_.fetch_add(1, std::memory_order_relaxed);
+    if (ccNumber >= 0 && ccNumber < 128) {
+        ccUsageCount_[ccNumber].fetch_add(1, std::memory_order_relaxed);
+    }
+    lastActivityTicks_.store(std::chrono::system_clock::now().time_since_epoch().count(),
+                             std::memory_order_relaxed);
 }
 
 bool MidiCCLearning::isLearningTimedOut() const {
@@ -531,6 +657,7 @@ bool MidiCCLearning::loadMappings(const std::string& filePath) {
             mappings_[mappingKey] = mapping;
             parameterToCC_[mapping.parameterId] = mappingKey;
         }
+        rebuildDispatchTable();
         
         // Update statistics
         {
@@ -553,12 +680,30 @@ std::string MidiCCLearning::getDefaultMappingsPath() {
 
 MidiCCLearning::LearningStats MidiCCLearning::getStatistics() const {
     std::lock_guard<std::mutex> lock(statsMutex_);
-    return stats_;
+    LearningStats stats = stats_;
+    
+    stats.messagesProcessed = messagesProcessed_.load(std::memory_order_relaxed);
+    int64_t ticks = lastActivityTicks_.load(std::memory_order_relaxed);
+    if (ticks != 0) {
+        stats.lastActivity = std::chrono::system_clock::time_point(std::chrono::system_clock::duration(ticks));
+    }
+    for (int cc = 0; cc < 128; ++cc) {
+        int count = ccUsageCount_[cc].load(std::memory_order_relaxed);
+        if (count > 0) {
+            stats.ccUsageCount[cc] = count;
+        }
+    }
+    return stats;
 }
 
 void MidiCCLearning::resetStatistics() {
     std::lock_guard<std::mutex> lock(statsMutex_);
     stats_ = LearningStats{};
+    messagesProcessed_.store(0, std::memory_order_relaxed);
+    lastActivityTicks_.store(0, std::memory_order_relaxed);
+    for (auto& count : ccUsageCount_) {
+        count.store(0, std::memory_order_relaxed);
+    }
     
     // Preserve active mapping count
     std::lock_guard<std::mutex> mappingsLock(mappingsMutex_);
@@ -0,0 +1,53 @@
+#include "../../include/midi/MidiInputRing.h"
+
+namespace AIMusicHardware {
+
+MidiInputRing::MidiInputRing(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    buffer_.resize(size);
+    mask_ = size - 1;
+}
+
+MidiMessage MidiInputRing::toMidiMessage(const TimestampedMidi& message) {
+    MidiMessage midiMessage;
+    midiMessage.timestamp = static_cast<double>(message.timestampNs) * 1e-9;
+
+    const uint8_t status = message.bytes[0];
+    midiMessage.channel = status & 0x0F;
+    midiMessage.data1 = message.size >= 2 ? message.bytes[1] : 0;
+    midiMessage.data2 = message.size >= 3 ? message.bytes[2] : 0;
+
+    switch (status & 0xF0) {
+        case 0x80:
+            midiMessage.type = MidiMessage::Type::NoteOff;
+            break;
+        case 0x90:
+            midiMessage.type = midiMessage.data2 == 0 ? MidiMessage::Type::NoteOff : MidiMessage::Type::NoteOn;
+            break;
+        case 0xA0:
+            midiMessage.type = MidiMessage::Type::AfterTouch;
+            break;
+        case 0xB0:
+            midiMessage.type = MidiMessage::Type::ControlChange;
+            break;
+        case 0xC0:
+            midiMessage.type = MidiMessage::Type::ProgramChange;
+            break;
+        case 0xD0:
+            midiMessage.type = MidiMessage::Type::ChannelPressure;
+            break;
+        case 0xE0:
+            midiMessage.type = MidiMessage::Type::PitchBend;
+            break;
+        default:
+            midiMessage.type = MidiMessage::Type::SystemMessage;
+            midiMessage.channel = 0;
+            break;
+    }
+    return midiMessage;
+}
+
+} // namespace AIMusicHardware
@@ -1,4 +1,5 @@
 #include "../../include/midi/MidiInterface.h"
+#include "../../include/midi/MidiInputRing.h"
 #include <stdexcept>
 #include <cassert>
 #include <mutex>
@@ -79,12 +80,20 @@ void rtMidiCallback(double timeStamp, std::vector<unsigned char>* message, void*
     std::lock_guard<std::mutex> lock(callbackMutex);
     callback->handleIncomingMidiMessage(midiMessage);
 }
+
+// Ring delivery: stamp and queue the raw bytes, nothing else on the MIDI thread
+void rtMidiRingCallback(double /*timeStamp*/, std::vector<unsigned char>* message, void* userData) {
+    if (!message || !userData)
+        return;
+    
+    static_cast<MidiInputRing*>(userData)->push(message->data(), message->size(), MidiInputRing::nowNs());
+}
 #endif
 
 // MidiInput implementation with RtMidi
 class MidiInput::Impl {
 public:
-    Impl() : rtMidiIn_(nullptr), callback_(nullptr), isOpen_(false) {
+    Impl() : rtMidiIn_(nullptr), callback_(nullptr), ring_(nullptr), isOpen_(false) {
 #ifdef HAVE_RTMIDI
         try {
             rtMidiIn_ = std::make_unique<RtMidiIn>();
@@ -126,11 +135,8 @@ public:
                     rtMidiIn_->openPort(deviceIndex);
                     isOpen_ = true;
                     
-                    // Set callback if we have one
-                    if (callback_) {
-                        rtMidiIn_->setCallback(rtMidiCallback, callback_);
-                        rtMidiIn_->ignoreTypes(false, false, false); // Accept all message types
-                    }
+                    // Set callback or ring if we have one
+                    installCallback();
                     
                     return true;
                 }
@@ -161,11 +167,32 @@ public:
     
     void setCallback(MidiInputCallback* callback) {
         callback_ = callback;
-        
+        installCallback();
+    }
+    
+    void setRing(MidiInputRing* ring) {
+        ring_ = ring;
+        installCallback();
+    }
+    
+private:
+    // The ring takes precedence over the callback while set; with neither,
+    // RtMidi is left without a callback
+    void installCallback() {
 #ifdef HAVE_RTMIDI
-        if (rtMidiIn_ && isOpen_ && callback_) {
+        if (rtMidiIn_ && isOpen_) {
             try {
-                rtMidiIn_->setCallback(rtMidiCallback, callback_);
+                if (callbackInstalled_) {
+                    rtMidiIn_->cancelCallback();
+                    callbackInstalled_ = false;
+                }
+                if (ring_) {
+                    rtMidiIn_->setCallback(rtMidiRingCallback, ring_);
+                    callbackInstalled_ = true;
+                } else if (callback_) {
+                    rtMidiIn_->setCallback(rtMidiCallback, callback_);
+                    callbackInstalled_ = true;
+                }
                 rtMidiIn_->ignoreTypes(false, false, false); // Accept all message types
             } catch (RtMidiError& error) {
                 std::cerr << "Error setting MIDI callback: " << error.getMessage() << std::endl;
@@ -174,11 +201,12 @@ public:
 #endif
     }
     
-private:
 #ifdef HAVE_RTMIDI
     std::unique_ptr<RtMidiIn> rtMidiIn_;
+    bool callbackInstalled_ = false;
 #endif
     MidiInputCallback* callback_;
+    MidiInputRing* ring_;
     bool isOpen_;
 };
 
@@ -222,6 +250,10 @@ void MidiInput::setCallback(MidiInputCallback* callback) {
     pimpl_->setCallback(callback);
 }
 
+void MidiInput::setRing(MidiInputRing* ring) {
+    pimpl_->setRing(ring);
+}
+
 // MidiOutput implementation with RtMidi
 class MidiOutput::Impl {
 public:
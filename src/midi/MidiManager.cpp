@@ -1,6 +1,8 @@
 #include "../../include/midi/MidiManager.h"
 #include "../../include/audio/Synthesizer.h"
+#include "../../include/audio/SynthParameters.h"
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace AIMusicHardware {
@@ -16,38 +18,40 @@ MidiManager::~MidiManager() {
     // Ensure MIDI devices are closed properly
     closeMidiInput();
     closeMidiOutput();
+    midiInput_->setRing(nullptr);
 }
 
 void MidiManager::handleIncomingMidiMessage(const MidiMessage& message) {
-    // Process the message with sample position 0 (immediate)
-    processMidiMessage(message, 0);
+    // Process the message immediately; this is the MIDI thread, so learn can complete here too
+    processMidiMessage(message);
+    processMidiLearn();
 }
 
-void MidiManager::processMidiMessage(const MidiMessage& message, int samplePosition) {
+void MidiManager::processMidiMessage(const MidiMessage& message) {
     // Process different message types
     switch (message.type) {
         case MidiMessage::Type::NoteOn:
-            processNoteOn(message, samplePosition);
+            processNoteOn(message);
             break;
             
         case MidiMessage::Type::NoteOff:
-            processNoteOff(message, samplePosition);
+            processNoteOff(message);
             break;
             
         case MidiMessage::Type::ControlChange:
-            processControlChange(message, samplePosition);
+            processControlChange(message);
             break;
             
         case MidiMessage::Type::PitchBend:
-            processPitchBend(message, samplePosition);
+            processPitchBend(message);
             break;
             
         case MidiMessage::Type::AfterTouch:
-            processAfterTouch(message, samplePosition);
+            processAfterTouch(message);
             break;
             
         case MidiMessage::Type::ChannelPressure:
-            processChannelPressure(message, samplePosition);
+            processChannelPressure(message);
             break;
             
         default:
@@ -56,18 +60,115 @@ void MidiManager::processMidiMessage(const MidiMessage& message, int samplePosit
     }
 }
 
+void MidiManager::enableInputRing(size_t capacity) {
+    if (!inputRing_) {
+        inputRing_ = std::make_unique<MidiInputRing>(capacity);
+        ringEvents_.reserve(inputRing_->capacity());
+    }
+    midiInput_->setRing(inputRing_.get());
+}
+
+size_t MidiManager::processInputRing(float* buffer, int numFrames, uint64_t blockStartNs, double sampleRate) {
+    if (!inputRing_) {
+        if (synthesizer_) {
+            synthesizer_->process(buffer, numFrames);
+        }
+        return 0;
+    }
+    
+    // At most one ring's worth per drain, so this never grows past the reserve
+    ringEvents_.clear();
+    size_t count = inputRing_->drain(blockStartNs, sampleRate, numFrames,
+                                     [this](const TimestampedMidi& message, int sampleOffset) {
+        ringEvents_.emplace_back(MidiInputRing::toMidiMessage(message), sampleOffset);
+    });
+    
+    // Render up to each message's offset, then apply it
+    int rendered = 0;
+    for (const auto& [message, sampleOffset] : ringEvents_) {
+        if (sampleOffset > rendered && synthesizer_) {
+            synthesizer_->process(buffer + rendered * 2, sampleOffset - rendered);
+            rendered = sampleOffset;
+        }
+        processMidiMessage(message);
+    }
+    if (rendered < numFrames && synthesizer_) {
+        synthesizer_->process(buffer + rendered * 2, numFrames - rendered);
+    }
+    
+    return count;
+}
+
 void MidiManager::armMidiLearn(const std::string& paramId) {
     std::lock_guard<std::mutex> lock(learnMutex_);
     learnParamId_ = paramId;
+    learnCapture_.store(-1);
+    learnArmed_.store(true);
     std::cout << "MIDI Learn armed for parameter: " << paramId << std::endl;
 }
 
 void MidiManager::cancelMidiLearn() {
     std::lock_guard<std::mutex> lock(learnMutex_);
+    learnArmed_.store(false);
+    learnCapture_.store(-1);
     learnParamId_.clear();
     std::cout << "MIDI Learn canceled" << std::endl;
 }
 
+bool MidiManager::processMidiLearn() {
+    if (learnCapture_.load(std::memory_order_acquire) < 0) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(learnMutex_);
+    const int32_t capture = learnCapture_.exchange(-1);
+    if (capture < 0 || learnParamId_.empty()) {
+        return false;
+    }
+    const int channel = capture >> 16;
+    const int controller = (capture >> 8) & 0x7F;
+    const int value = capture & 0x7F;
+    
+    {
+        // Map this controller to the parameter being learned
+        std::lock_guard<std::mutex> mappingLock(mappingMutex_);
+        
+        // First check if this parameter is already mapped elsewhere and clear that mapping
+        for (auto& channelMap : midiMappings_) {
+            for (auto it = channelMap.second.begin(); it != channelMap.second.end(); ) {
+                if (it->second == learnParamId_) {
+                    std::cout << "Removing existing mapping for " << learnParamId_ 
+                              << " from channel " << channelMap.first 
+                              << ", controller " << it->first << std::endl;
+                    it = channelMap.second.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        
+        // Create new mapping
+        midiMappings_[channel][controller] = learnParamId_;
+        rebuildDispatchTable();
+    }
+    
+    std::cout << "MIDI Learn: Channel " << channel << ", Controller " << controller 
+              << " mapped to parameter " << learnParamId_ << std::endl;
+    
+    // Clear learn state after successful mapping
+    learnParamId_.clear();
+    
+    // Also update the parameter value
+    updateMappedParameter(channel, controller, value);
+    
+    // Notify listener if available
+    if (listener_) {
+        listener_->parameterChangedViaMidi("midi_learn_complete", 1.0f);
+    }
+    
+    return true;
+}
+
 void MidiManager::clearMidiLearn(const std::string& paramId) {
     std::lock_guard<std::mutex> lock(mappingMutex_);
     
@@ -81,6 +182,7 @@ void MidiManager::clearMidiLearn(const std::string& paramId) {
             }
         }
     }
+    rebuildDispatchTable();
     
     std::cout << "MIDI mapping cleared for parameter: " << paramId << std::endl;
 }
@@ -136,9 +238,10 @@ MidiManager::MidiParameterMap MidiManager::getMidiMappings() const {
 void MidiManager::setMidiMappings(const MidiParameterMap& mappings) {
     std::lock_guard<std::mutex> lock(mappingMutex_);
     midiMappings_ = mappings;
+    rebuildDispatchTable();
 }
 
-void MidiManager::processNoteOn(const MidiMessage& message, int samplePosition) {
+void MidiManager::processNoteOn(const MidiMessage& message) {
     if (synthesizer_) {
         int noteNumber = message.data1;
         int velocity = message.data2;
@@ -148,7 +251,7 @@ void MidiManager::processNoteOn(const MidiMessage& message, int samplePosition)
     }
 }
 
-void MidiManager::processNoteOff(const MidiMessage& message, int samplePosition) {
+void MidiManager::processNoteOff(const MidiMessage& message) {
     if (synthesizer_) {
         int noteNumber = message.data1;
         
@@ -157,61 +260,27 @@ void MidiManager::processNoteOff(const MidiMessage& message, int samplePosition)
     }
 }
 
-void MidiManager::processControlChange(const MidiMessage& message, int samplePosition) {
+void MidiManager::processControlChange(const MidiMessage& message) {
     int controller = message.data1;
     int value = message.data2;
     int channel = message.channel;
     
-    // Check for MIDI learn
-    {
-        std::lock_guard<std::mutex> lock(learnMutex_);
-        if (!learnParamId_.empty()) {
-            // Map this controller to the parameter being learned
-            std::lock_guard<std::mutex> mappingLock(mappingMutex_);
-            
-            // First check if this parameter is already mapped elsewhere and clear that mapping
-            for (auto& channelMap : midiMappings_) {
-                for (auto it = channelMap.second.begin(); it != channelMap.second.end(); ) {
-                    if (it->second == learnParamId_) {
-                        std::cout << "Removing existing mapping for " << learnParamId_ 
-                                  << " from channel " << channelMap.first 
-                                  << ", controller " << it->first << std::endl;
-                        it = channelMap.second.erase(it);
-                    } else {
-                        ++it;
-                    }
-                }
-            }
-            
-            // Create new mapping
-            midiMappings_[channel][controller] = learnParamId_;
-            
-            std::cout << "MIDI Learn: Channel " << channel << ", Controller " << controller 
-                      << " mapped to parameter " << learnParamId_ << std::endl;
-            
-            // Clear learn state after successful mapping
-            learnParamId_.clear();
-            
-            // Also update the parameter value
-            updateMappedParameter(channel, controller, value);
-            
-            // Notify listener if available
-            if (listener_) {
-                listener_->parameterChangedViaMidi("midi_learn_complete", 1.0f);
-            }
-            
-            return;
-        }
+    // MIDI learn: this may be the audio thread, so only record the
+    // controller; processMidiLearn creates the mapping
+    if (learnArmed_.load(std::memory_order_relaxed) && learnArmed_.exchange(false)) {
+        learnCapture_.store(((channel & 0xF) << 16) | ((controller & 0x7F) << 8) | (value & 0x7F),
+                            std::memory_order_release);
+        return;
     }
     
     // Handle specific controllers
     switch (controller) {
         case kSustainPedal:
-            processSustain(message, samplePosition);
+            processSustain(message);
             break;
             
         case kAllNotesOff:
-            processAllNotesOff(message, samplePosition);
+            processAllNotesOff(message);
             break;
             
         case kResetAllControllers:
@@ -247,7 +316,7 @@ void MidiManager::processControlChange(const MidiMessage& message, int samplePos
     }
 }
 
-void MidiManager::processPitchBend(const MidiMessage& message, int samplePosition) {
+void MidiManager::processPitchBend(const MidiMessage& message) {
     int channel = message.channel;
     
     // Combine MSB and LSB for 14-bit pitch bend value
@@ -265,7 +334,7 @@ void MidiManager::processPitchBend(const MidiMessage& message, int samplePositio
     }
 }
 
-void MidiManager::processAfterTouch(const MidiMessage& message, int samplePosition) {
+void MidiManager::processAfterTouch(const MidiMessage& message) {
     int channel = message.channel;
     int note = message.data1;
     int pressure = message.data2;
@@ -276,7 +345,7 @@ void MidiManager::processAfterTouch(const MidiMessage& message, int samplePositi
     }
 }
 
-void MidiManager::processChannelPressure(const MidiMessage& message, int samplePosition) {
+void MidiManager::processChannelPressure(const MidiMessage& message) {
     int channel = message.channel;
     int pressure = message.data1;
     
@@ -290,7 +359,7 @@ void MidiManager::processChannelPressure(const MidiMessage& message, int sampleP
     }
 }
 
-void MidiManager::processAllNotesOff(const MidiMessage& message, int samplePosition) {
+void MidiManager::processAllNotesOff(const MidiMessage& message) {
     int channel = message.channel;
     
     if (synthesizer_) {
@@ -298,7 +367,7 @@ void MidiManager::processAllNotesOff(const MidiMessage& message, int samplePosit
     }
 }
 
-void MidiManager::processSustain(const MidiMessage& message, int samplePosition) {
+void MidiManager::processSustain(const MidiMessage& message) {
     int channel = message.channel;
     int value = message.data2;
     
@@ -403,52 +472,100 @@ int MidiManager::parameterToMidiValue(float value) const {
 }
 
 void MidiManager::updateMappedParameter(int channel, int controller, int value) {
-    std::lock_guard<std::mutex> lock(mappingMutex_);
+    if (channel < 0 || channel > 15 || controller < 0 || controller > 127) {
+        return;
+    }
     
-    // Check if this controller is mapped to a parameter
-    auto channelIt = midiMappings_.find(channel);
-    if (channelIt != midiMappings_.end()) {
-        auto controllerIt = channelIt->second.find(controller);
-        if (controllerIt != channelIt->second.end()) {
-            // Found a mapping
-            const std::string& paramId = controllerIt->second;
-            
-            // Determine parameter range and scaling based on parameter ID
-            // This is where we would look up parameter metadata in a more complete system
-            ParameterScaling scaling = ParameterScaling::Linear;
-            float min = 0.0f;
-            float max = 1.0f;
-            int steps = 0;
-            
-            // Example parameter-specific mappings
-            // In a real implementation, this would come from a parameter registry
-            if (paramId == "filter_cutoff") {
-                scaling = ParameterScaling::Logarithmic;
-                min = 20.0f;    // 20Hz
-                max = 20000.0f; // 20kHz
-            } else if (paramId == "filter_resonance") {
-                scaling = ParameterScaling::Exponential;
-                min = 0.0f;
-                max = 0.99f;
-            } else if (paramId == "oscillator_type") {
-                scaling = ParameterScaling::Stepped;
-                steps = 5; // 5 waveform types
-            }
-            
+    // Announce the read before loading the table so a concurrent rebuild
+    // keeps the table alive until we are done with it
+    dispatchReaders_.fetch_add(1);
+    const DispatchTable* table = dispatchTable_.load();
+    
+    if (table) {
+        const DispatchEntry& entry = table->entries[channel * 128 + controller];
+        if (entry.paramId) {
             // Convert MIDI value to parameter value
-            float paramValue = midiValueToParameter(value, scaling, min, max, steps);
+            float paramValue = midiValueToParameter(value, entry.scaling, entry.min, entry.max, entry.steps);
             
             // Update the parameter in the synthesizer
-            if (synthesizer_) {
-                synthesizer_->setParameter(paramId, paramValue);
+            if (synthesizer_ && entry.synthParameter >= 0) {
+                synthesizer_->setParameter(static_cast<SynthParamId>(entry.synthParameter), paramValue);
             }
             
             // Notify the listener
             if (listener_) {
-                listener_->parameterChangedViaMidi(paramId, paramValue);
+                listener_->parameterChangedViaMidi(*entry.paramId, paramValue);
             }
         }
     }
+    
+    dispatchReaders_.fetch_sub(1);
+}
+
+MidiManager::DispatchEntry MidiManager::bindParameter(const std::string& paramId) {
+    DispatchEntry entry;
+    
+    auto interned = std::find(parameterIds_.begin(), parameterIds_.end(), paramId);
+    if (interned == parameterIds_.end()) {
+        parameterIds_.push_back(paramId);
+        interned = parameterIds_.end() - 1;
+    }
+    entry.paramId = &*interned;
+    
+    // Anything the synthesizer does not know (e.g. effect parameters) only
+    // reaches the listener, as a 0-1 value
+    entry.synthParameter = findSynthParameter(paramId);
+    if (entry.synthParameter < 0) {
+        return entry;
+    }
+    
+    const SynthParamId parameter = static_cast<SynthParamId>(entry.synthParameter);
+    const SynthParameterInfo& info = getSynthParameterInfo(parameter);
+    entry.min = info.minValue;
+    entry.max = info.maxValue;
+    
+    if (info.stepped) {
+        entry.scaling = ParameterScaling::Stepped;
+        entry.steps = static_cast<int>(info.maxValue - info.minValue) + 1;
+    } else if (parameter == SynthParamId::FilterResonance) {
+        entry.scaling = ParameterScaling::Exponential;
+        entry.max = 0.99f;
+    } else if (parameter == SynthParamId::EnvelopeAttack ||
+               parameter == SynthParamId::EnvelopeDecay ||
+               parameter == SynthParamId::EnvelopeRelease) {
+        entry.scaling = ParameterScaling::Exponential;
+    }
+    // filter_cutoff is already a normalized, log-spaced control, so it stays linear
+    
+    return entry;
+}
+
+void MidiManager::rebuildDispatchTable() {
+    auto table = std::make_unique<DispatchTable>();
+    
+    for (const auto& [channel, controllers] : midiMappings_) {
+        if (channel < 0 || channel > 15) {
+            continue;
+        }
+        for (const auto& [controller, paramId] : controllers) {
+            if (controller < 0 || controller > 127) {
+                continue;
+            }
+            table->entries[channel * 128 + controller] = bindParameter(paramId);
+        }
+    }
+    
+    // Publish, then free old tables only if no reader can still hold one
+    std::unique_ptr<const DispatchTable> published(table.release());
+    dispatchTable_.store(published.get());
+    if (currentTable_) {
+        retiredTables_.push_back(std::move(currentTable_));
+    }
+    currentTable_ = std::move(published);
+    
+    if (dispatchReaders_.load() == 0) {
+        retiredTables_.clear();
+    }
 }
 
 } // namespace AIMusicHardware
\ No newline at end of file
@@ -1,216 +1,250 @@
 #include "../../include/midi/MpeChannelAllocator.h"
 #include <algorithm>
-#include <vector>
 
 namespace AIMusicHardware {
 
 MpeChannelAllocator::MpeChannelAllocator(const MpeConfiguration& mpeConfig)
     : mpeConfig_(mpeConfig) {
-    
+
     // Initialize all channel states
     for (auto& state : channelStates_) {
-        state.inUse = false;
-        state.noteNumber = -1;
-        state.noteId = 0;
+        clearChannelState(state);
         state.timestamp = 0;
-        state.pitchBend = 0.0f;
-        state.timbre = 0.5f;
-        state.pressure = 0.0f;
     }
+    noteToChannel_.fill(kNone);
+    channelZone_.fill(kNone);
+    prev_.fill(kNone);
+    next_.fill(kNone);
 }
 
 int MpeChannelAllocator::allocateChannel(int note, int velocity, bool lowerZone) {
-    std::lock_guard<std::mutex> lock(allocationMutex_);
-    
-    // Get the appropriate zone configuration
-    const MpeConfiguration::Zone& zone = lowerZone ? 
-        mpeConfig_.getLowerZone() : mpeConfig_.getUpperZone();
-    
+    if (note < 0 || note > 127) {
+        return -1;
+    }
+
+    refreshZones();
+
+    // Get the appropriate zone
+    ZoneLists& zone = zones_[lowerZone ? 0 : 1];
     if (!zone.active) {
         return -1;  // Zone not active
     }
-    
+
     // Check if the note is already allocated
-    auto it = noteToChannelMap_.find(note);
-    if (it != noteToChannelMap_.end()) {
-        // Note already allocated, reuse the channel
-        int existingChannel = it->second;
-        
-        // Update the channel state
+    int existingChannel = noteToChannel_[note];
+    if (existingChannel >= 0) {
+        // Note already allocated, reuse the channel and mark it most recent
         channelStates_[existingChannel].timestamp = messageCounter_++;
-        
+        int owner = channelZone_[existingChannel];
+        if (owner >= 0) {
+            unlink(zones_[owner].busy, existingChannel);
+            pushBack(zones_[owner].busy, existingChannel);
+        }
         return existingChannel;
     }
-    
-    // Determine channel range (convert to 0-based)
-    int startChannel = zone.startMemberChannel - 1;
-    int endChannel = zone.endMemberChannel - 1;
-    bool ascending = zone.ascending;
-    
-    // Try to find a free channel in the zone
-    std::vector<std::pair<int, uint32_t>> candidates;  // channel, timestamp
-    
-    if (ascending) {
-        // Scan channels in ascending order
-        for (int ch = startChannel; ch <= endChannel; ch++) {
-            if (!channelStates_[ch].inUse) {
-                // Found unused channel
-                channelStates_[ch].inUse = true;
-                channelStates_[ch].noteNumber = note;
-                channelStates_[ch].timestamp = messageCounter_++;
-                channelStates_[ch].pitchBend = 0.0f;
-                channelStates_[ch].timbre = 0.5f;
-                channelStates_[ch].pressure = static_cast<float>(velocity) / 127.0f;
-                
-                // Store mapping
-                noteToChannelMap_[note] = ch;
-                
-                return ch;
-            }
-            
-            // Store as candidate for stealing if needed
-            candidates.push_back({ch, channelStates_[ch].timestamp});
-        }
+
+    // Prefer the least recently released free channel
+    int channel = zone.free.head;
+    if (channel >= 0) {
+        unlink(zone.free, channel);
     } else {
-        // Scan channels in descending order
-        for (int ch = startChannel; ch >= endChannel; ch--) {
-            if (!channelStates_[ch].inUse) {
-                // Found unused channel
-                channelStates_[ch].inUse = true;
-                channelStates_[ch].noteNumber = note;
-                channelStates_[ch].timestamp = messageCounter_++;
-                channelStates_[ch].pitchBend = 0.0f;
-                channelStates_[ch].timbre = 0.5f;
-                channelStates_[ch].pressure = static_cast<float>(velocity) / 127.0f;
-                
-                // Store mapping
-                noteToChannelMap_[note] = ch;
-                
-                return ch;
-            }
-            
-            // Store as candidate for stealing if needed
-            candidates.push_back({ch, channelStates_[ch].timestamp});
+        // No free channel, steal the oldest allocation
+        channel = zone.busy.head;
+        if (channel < 0) {
+            return -1;  // No channels available in this zone
+        }
+        unlink(zone.busy, channel);
+
+        int oldNote = channelStates_[channel].noteNumber;
+        if (oldNote >= 0 && noteToChannel_[oldNote] == channel) {
+            noteToChannel_[oldNote] = kNone;
         }
     }
-    
-    // No free channel, need to steal
-    if (candidates.empty()) {
-        return -1;  // No channels available in this zone
-    }
-    
-    // Find oldest allocated channel
-    std::sort(candidates.begin(), candidates.end(), 
-              [](const auto& a, const auto& b) { return a.second < b.second; });
-    
-    int channelToSteal = candidates[0].first;
-    
-    // Remove old mapping
-    int oldNote = channelStates_[channelToSteal].noteNumber;
-    if (oldNote >= 0) {
-        noteToChannelMap_.erase(oldNote);
-    }
-    
-    // Update channel state
-    channelStates_[channelToSteal].inUse = true;
-    channelStates_[channelToSteal].noteNumber = note;
-    channelStates_[channelToSteal].timestamp = messageCounter_++;
-    channelStates_[channelToSteal].pitchBend = 0.0f;
-    channelStates_[channelToSteal].timbre = 0.5f;
-    channelStates_[channelToSteal].pressure = static_cast<float>(velocity) / 127.0f;
-    
-    // Store new mapping
-    noteToChannelMap_[note] = channelToSteal;
-    
-    return channelToSteal;
+
+    pushBack(zone.busy, channel);
+    assignChannel(channel, note, velocity);
+    return channel;
 }
 
 void MpeChannelAllocator::releaseChannel(int channel) {
     if (channel < 0 || channel >= 16) {
         return;
     }
-    
-    std::lock_guard<std::mutex> lock(allocationMutex_);
-    
-    // Get the note assigned to this channel
-    int note = channelStates_[channel].noteNumber;
-    
+
+    ChannelState& state = channelStates_[channel];
+
     // Remove the note-to-channel mapping
-    if (note >= 0) {
-        noteToChannelMap_.erase(note);
+    if (state.noteNumber >= 0 && noteToChannel_[state.noteNumber] == channel) {
+        noteToChannel_[state.noteNumber] = kNone;
+    }
+
+    // Move to the back of the free list so it is reused last
+    int owner = channelZone_[channel];
+    if (state.inUse && owner >= 0) {
+        unlink(zones_[owner].busy, channel);
+        pushBack(zones_[owner].free, channel);
     }
-    
+
     // Reset channel state
-    channelStates_[channel].inUse = false;
-    channelStates_[channel].noteNumber = -1;
-    channelStates_[channel].noteId = 0;
-    channelStates_[channel].pitchBend = 0.0f;
-    channelStates_[channel].timbre = 0.5f;
-    channelStates_[channel].pressure = 0.0f;
+    clearChannelState(state);
 }
 
 MpeChannelAllocator::ChannelState& MpeChannelAllocator::getChannelState(int channel) {
-    std::lock_guard<std::mutex> lock(allocationMutex_);
     return channelStates_[channel];
 }
 
 int MpeChannelAllocator::getChannelForNote(int note) const {
-    std::lock_guard<std::mutex> lock(allocationMutex_);
-    
-    auto it = noteToChannelMap_.find(note);
-    if (it != noteToChannelMap_.end()) {
-        return it->second;
-    }
-    
-    return -1;  // Note not allocated
+    if (note < 0 || note > 127) {
+        return -1;
+    }
+    return noteToChannel_[note];
 }
 
 const std::array<MpeChannelAllocator::ChannelState, 16>& MpeChannelAllocator::getAllChannelStates() const {
-    std::lock_guard<std::mutex> lock(allocationMutex_);
     return channelStates_;
 }
 
 void MpeChannelAllocator::reset() {
-    std::lock_guard<std::mutex> lock(allocationMutex_);
-    
     // Clear all mappings
-    noteToChannelMap_.clear();
-    
+    noteToChannel_.fill(kNone);
+
     // Reset all channel states
     for (auto& state : channelStates_) {
-        state.inUse = false;
-        state.noteNumber = -1;
-        state.noteId = 0;
+        clearChannelState(state);
         state.timestamp = 0;
-        state.pitchBend = 0.0f;
-        state.timbre = 0.5f;
-        state.pressure = 0.0f;
     }
+
+    // Lists are rebuilt from the (now all free) states on next allocation
+    layoutValid_ = false;
 }
 
 bool MpeChannelAllocator::updateExpression(int channel, float pitchBend, float timbre, float pressure) {
     if (channel < 0 || channel >= 16) {
         return false;
     }
-    
-    std::lock_guard<std::mutex> lock(allocationMutex_);
-    
+
     // Only update expression for active channels
     if (!channelStates_[channel].inUse) {
         return false;
     }
-    
+
     // Clamp values to valid ranges
     pitchBend = std::clamp(pitchBend, -1.0f, 1.0f);
     timbre = std::clamp(timbre, 0.0f, 1.0f);
     pressure = std::clamp(pressure, 0.0f, 1.0f);
-    
+
     // Update expression values
     channelStates_[channel].pitchBend = pitchBend;
     channelStates_[channel].timbre = timbre;
     channelStates_[channel].pressure = pressure;
-    
+
     return true;
 }
 
-} // namespace AIMusicHardware
\ No newline at end of file
+void MpeChannelAllocator::refreshZones() {
+    uint32_t version = mpeConfig_.getLayoutVersion();
+    if (layoutValid_ && version == layoutVersion_) {
+        return;
+    }
+
+    channelZone_.fill(kNone);
+    prev_.fill(kNone);
+    next_.fill(kNone);
+    rebuildZone(0, mpeConfig_.getLowerZone());
+    rebuildZone(1, mpeConfig_.getUpperZone());
+
+    layoutVersion_ = version;
+    layoutValid_ = true;
+}
+
+void MpeChannelAllocator::rebuildZone(int zoneIndex, const MpeConfiguration::Zone& config) {
+    ZoneLists& zone = zones_[zoneIndex];
+    zone = ZoneLists{};
+    zone.active = config.active;
+    if (!zone.active) {
+        return;
+    }
+
+    // Determine channel range (convert to 0-based)
+    zone.startChannel = std::clamp(config.startMemberChannel - 1, 0, kNumChannels - 1);
+    zone.endChannel = std::clamp(config.endMemberChannel - 1, 0, kNumChannels - 1);
+    const int step = zone.endChannel >= zone.startChannel ? 1 : -1;
+    const int count = (zone.endChannel - zone.startChannel) * step + 1;
+
+    // Free channels in zone order so the first notes land where they always did;
+    // busy ones (held across a layout change) ordered oldest first
+    std::array<int8_t, kNumChannels> busy;
+    int busyCount = 0;
+    for (int i = 0, ch = zone.startChannel; i < count; ++i, ch += step) {
+        // Overlapping zones: the lower zone keeps shared channels
+        if (channelZone_[ch] != kNone) {
+            continue;
+        }
+        channelZone_[ch] = static_cast<int8_t>(zoneIndex);
+        if (channelStates_[ch].inUse) {
+            busy[busyCount++] = static_cast<int8_t>(ch);
+        } else {
+            pushBack(zone.free, ch);
+        }
+    }
+
+    std::sort(busy.begin(), busy.begin() + busyCount, [this](int8_t a, int8_t b) {
+        return channelStates_[a].timestamp < channelStates_[b].timestamp;
+    });
+    for (int i = 0; i < busyCount; ++i) {
+        pushBack(zone.busy, busy[i]);
+    }
+}
+
+void MpeChannelAllocator::unlink(ChannelList& list, int channel) {
+    int8_t before = prev_[channel];
+    int8_t after = next_[channel];
+
+    if (before >= 0) {
+        next_[before] = after;
+    } else {
+        list.head = after;
+    }
+    if (after >= 0) {
+        prev_[after] = before;
+    } else {
+        list.tail = before;
+    }
+    prev_[channel] = kNone;
+    next_[channel] = kNone;
+}
+
+void MpeChannelAllocator::pushBack(ChannelList& list, int channel) {
+    prev_[channel] = list.tail;
+    next_[channel] = kNone;
+    if (list.tail >= 0) {
+        next_[list.tail] = static_cast<int8_t>(channel);
+    } else {
+        list.head = static_cast<int8_t>(channel);
+    }
+    list.tail = static_cast<int8_t>(channel);
+}
+
+void MpeChannelAllocator::assignChannel(int channel, int note, int velocity) {
+    ChannelState& state = channelStates_[channel];
+    state.inUse = true;
+    state.noteNumber = note;
+    state.timestamp = messageCounter_++;
+    state.pitchBend = 0.0f;
+    state.timbre = 0.5f;
+    state.pressure = static_cast<float>(velocity) / 127.0f;
+
+    // Store mapping
+    noteToChannel_[note] = static_cast<int8_t>(channel);
+}
+
+void MpeChannelAllocator::clearChannelState(ChannelState& state) {
+    state.inUse = false;
+    state.noteNumber = -1;
+    state.noteId = 0;
+    state.pitchBend = 0.0f;
+    state.timbre = 0.5f;
+    state.pressure = 0.0f;
+}
+
+} // namespace AIMusicHardware
@@ -46,6 +46,8 @@ void MpeConfiguration::setLowerZone(bool active, int memberChannels) {
             lowerZone_.endMemberChannel = std::min(lowerZone_.endMemberChannel, maxEndChannel);
         }
     }
+    
+    layoutVersion_.fetch_add(1, std::memory_order_release);
 }
 
 void MpeConfiguration::setUpperZone(bool active, int memberChannels) {
@@ -68,6 +70,8 @@ void MpeConfiguration::setUpperZone(bool active, int memberChannels) {
             upperZone_.endMemberChannel = std::max(upperZone_.endMemberChannel, minEndChannel);
         }
     }
+    
+    layoutVersion_.fetch_add(1, std::memory_order_release);
 }
 
 MpeConfiguration::Zone MpeConfiguration::getLowerZone() const {
@@ -112,6 +112,97 @@ void MultiTimbralMidiRouter::processMidiMessage(const MidiMessage& message) {
     }
 }
 
+void MultiTimbralMidiRouter::processUniversalPacket(const UniversalMidiPacket& packet) {
+    UniversalMidiEvent event;
+    if (universalParser_.parse(packet, event)) {
+        processUniversalEvent(event);
+    }
+}
+
+void MultiTimbralMidiRouter::processUniversalEvent(const UniversalMidiEvent& event) {
+    if (!multiTimbralEngine_) {
+        return;
+    }
+    
+    const int channel = event.channel;
+    const bool mpe = operationMode_ == OperationMode::Mpe;
+    
+    switch (event.kind) {
+        case UniversalMidiEvent::Kind::RegisteredParameter:
+            // Both data bytes are available here, unlike the CC 6/38 path
+            handleRpnMessage(channel, event.index >> 7, event.index & 0x7F,
+                             event.value14() >> 7, event.value14() & 0x7F);
+            return;
+            
+        case UniversalMidiEvent::Kind::PitchBend:
+            if (mpe) {
+                applyMpePitchBend(channel, event.bipolar());
+            } else {
+                applyPitchBend(channel, event.bipolar());
+            }
+            return;
+            
+        case UniversalMidiEvent::Kind::ChannelPressure:
+            if (mpe) {
+                applyMpePressure(channel, event.unit());
+            } else {
+                applyChannelPressure(channel, event.unit());
+            }
+            return;
+            
+        case UniversalMidiEvent::Kind::PolyPressure:
+            if (!mpe) {
+                applyAfterTouch(channel, event.note, event.unit());
+            }
+            return;
+            
+        case UniversalMidiEvent::Kind::ControlChange:
+            if (mpe && event.index == 74) {
+                applyMpeTimbre(channel, event.value7(), event.unit());
+                return;
+            }
+            break;
+            
+        case UniversalMidiEvent::Kind::AssignableParameter:
+        case UniversalMidiEvent::Kind::PerNoteController:
+        case UniversalMidiEvent::Kind::PerNotePitchBend:
+            // No engine destination yet
+            return;
+            
+        default:
+            break;
+    }
+    
+    // Notes, program changes and remaining controllers take the regular path
+    MidiMessage message;
+    message.channel = channel;
+    switch (event.kind) {
+        case UniversalMidiEvent::Kind::NoteOn:
+            message.type = MidiMessage::Type::NoteOn;
+            message.data1 = event.note;
+            // Quiet 16-bit velocities must not turn into note offs
+            message.data2 = std::max(1, event.value7());
+            break;
+        case UniversalMidiEvent::Kind::NoteOff:
+            message.type = MidiMessage::Type::NoteOff;
+            message.data1 = event.note;
+            message.data2 = event.value7();
+            break;
+        case UniversalMidiEvent::Kind::ProgramChange:
+            message.type = MidiMessage::Type::ProgramChange;
+            message.data1 = event.index;
+            break;
+        case UniversalMidiEvent::Kind::ControlChange:
+            message.type = MidiMessage::Type::ControlChange;
+            message.data1 = event.index;
+            message.data2 = event.value7();
+            break;
+        default:
+            return;
+    }
+    processMidiMessage(message);
+}
+
 //----------------------------------------------------------------------
 // Standard Multi-timbral Message Processors
 //----------------------------------------------------------------------
@@ -230,17 +321,17 @@ void MultiTimbralMidiRouter::processControlChange(const MidiMessage& message) {
 }
 
 void MultiTimbralMidiRouter::processPitchBend(const MidiMessage& message) {
-    int channel = message.channel;
-    
-    if (!isChannelEnabled(channel)) {
-        return;
-    }
-    
     // Combine LSB and MSB for full 14-bit resolution
     int combined = message.data1 | (message.data2 << 7);
     
     // Convert from 0-16383 to -1.0 to +1.0
-    float normalizedValue = (combined / 8192.0f) - 1.0f;
+    applyPitchBend(message.channel, (combined / 8192.0f) - 1.0f);
+}
+
+void MultiTimbralMidiRouter::applyPitchBend(int channel, float normalizedValue) {
+    if (!isChannelEnabled(channel)) {
+        return;
+    }
     
     if (debugMode_) {
         std::cout << "MIDI IN: Pitch Bend - Ch: " << (channel + 1) 
@@ -251,10 +342,10 @@ void MultiTimbralMidiRouter::processPitchBend(const MidiMessage& message) {
 }
 
 void MultiTimbralMidiRouter::processAfterTouch(const MidiMessage& message) {
-    int channel = message.channel;
-    int note = message.data1;
-    int pressure = message.data2;
-    
+    applyAfterTouch(message.channel, message.data1, message.data2 / 127.0f);
+}
+
+void MultiTimbralMidiRouter::applyAfterTouch(int channel, int note, float pressure) {
     if (!isChannelEnabled(channel)) {
         return;
     }
@@ -264,13 +355,14 @@ void MultiTimbralMidiRouter::processAfterTouch(const MidiMessage& message) {
                   << ", Note: " << note << ", Pressure: " << pressure << std::endl;
     }
     
-    multiTimbralEngine_->aftertouch(note, pressure / 127.0f, channel);
+    multiTimbralEngine_->aftertouch(note, pressure, channel);
 }
 
 void MultiTimbralMidiRouter::processChannelPressure(const MidiMessage& message) {
-    int channel = message.channel;
-    int pressure = message.data1;
-    
+    applyChannelPressure(message.channel, message.data1 / 127.0f);
+}
+
+void MultiTimbralMidiRouter::applyChannelPressure(int channel, float pressure) {
     if (!isChannelEnabled(channel)) {
         return;
     }
@@ -280,7 +372,7 @@ void MultiTimbralMidiRouter::processChannelPressure(const MidiMessage& message)
                   << ", Pressure: " << pressure << std::endl;
     }
     
-    multiTimbralEngine_->channelPressure(pressure / 127.0f, channel);
+    multiTimbralEngine_->channelPressure(pressure, channel);
 }
 
 void MultiTimbralMidiRouter::processProgramChange(const MidiMessage& message) {
@@ -442,14 +534,14 @@ void MultiTimbralMidiRouter::processMpeNoteOff(const MidiMessage& message) {
 }
 
 void MultiTimbralMidiRouter::processMpePitchBend(const MidiMessage& message) {
-    int channel = message.channel;
-    
     // Combine LSB and MSB for full 14-bit resolution
     int combined = message.data1 | (message.data2 << 7);
     
     // Convert from 0-16383 to -1.0 to +1.0
-    float normalizedValue = (combined / 8192.0f) - 1.0f;
-    
+    applyMpePitchBend(message.channel, (combined / 8192.0f) - 1.0f);
+}
+
+void MultiTimbralMidiRouter::applyMpePitchBend(int channel, float normalizedValue) {
     if (debugMode_) {
         std::cout << "MPE IN: Pitch Bend - Ch: " << (channel + 1) 
                   << ", Value: " << normalizedValue << std::endl;
@@ -488,12 +580,11 @@ void MultiTimbralMidiRouter::processMpePitchBend(const MidiMessage& message) {
 }
 
 void MultiTimbralMidiRouter::processMpeTimbre(const MidiMessage& message) {
-    int channel = message.channel;
-    int value = message.data2;
-    
     // Normalize timbre value (0-127) to 0.0-1.0
-    float normalizedValue = value / 127.0f;
-    
+    applyMpeTimbre(message.channel, message.data2, message.data2 / 127.0f);
+}
+
+void MultiTimbralMidiRouter::applyMpeTimbre(int channel, int value, float normalizedValue) {
     if (debugMode_) {
         std::cout << "MPE IN: Timbre (CC74) - Ch: " << (channel + 1) 
                   << ", Value: " << normalizedValue << std::endl;
@@ -534,12 +625,11 @@ void MultiTimbralMidiRouter::processMpeTimbre(const MidiMessage& message) {
 }
 
 void MultiTimbralMidiRouter::processMpePressure(const MidiMessage& message) {
-    int channel = message.channel;
-    int pressure = message.data1;
-    
     // Normalize pressure value (0-127) to 0.0-1.0
-    float normalizedValue = pressure / 127.0f;
-    
+    applyMpePressure(message.channel, message.data1 / 127.0f);
+}
+
+void MultiTimbralMidiRouter::applyMpePressure(int channel, float normalizedValue) {
     if (debugMode_) {
         std::cout << "MPE IN: Channel Pressure - Ch: " << (channel + 1) 
                   << ", Value: " << normalizedValue << std::endl;
@@ -0,0 +1,269 @@
+#include "../../include/midi/UniversalMidiParser.h"
+
+namespace AIMusicHardware {
+
+namespace {
+
+constexpr uint8_t kDataEntryMsb = 6;
+constexpr uint8_t kDataEntryLsb = 38;
+constexpr uint8_t kDataIncrement = 96;
+constexpr uint8_t kDataDecrement = 97;
+constexpr uint8_t kNrpnLsb = 98;
+constexpr uint8_t kNrpnMsb = 99;
+constexpr uint8_t kRpnLsb = 100;
+constexpr uint8_t kRpnMsb = 101;
+constexpr uint8_t kResetAllControllers = 121;
+
+uint32_t velocityFrom7(uint8_t velocity) {
+    return MidiResolution::scaleUp(velocity, 7, 16) << 16;
+}
+
+} // namespace
+
+UniversalMidiParser::UniversalMidiParser() {
+    reset();
+}
+
+void UniversalMidiParser::reset() {
+    channels_.fill(ChannelState{});
+}
+
+bool UniversalMidiParser::parse(const UniversalMidiPacket& packet, UniversalMidiEvent& event) {
+    switch (packet.messageType()) {
+        case UniversalMidiPacket::Midi1ChannelVoice:
+            return parseMidi1(static_cast<uint8_t>((packet.words[0] >> 16) & 0xFF),
+                              packet.byte2(), packet.byte3(), event, packet.group());
+        case UniversalMidiPacket::Midi2ChannelVoice:
+            return parseMidi2(packet, event);
+        default:
+            return false;
+    }
+}
+
+bool UniversalMidiParser::parse(const MidiMessage& message, UniversalMidiEvent& event) {
+    uint8_t status;
+    switch (message.type) {
+        case MidiMessage::Type::NoteOn: status = 0x90; break;
+        case MidiMessage::Type::NoteOff: status = 0x80; break;
+        case MidiMessage::Type::AfterTouch: status = 0xA0; break;
+        case MidiMessage::Type::ControlChange: status = 0xB0; break;
+        case MidiMessage::Type::ProgramChange: status = 0xC0; break;
+        case MidiMessage::Type::ChannelPressure: status = 0xD0; break;
+        case MidiMessage::Type::PitchBend: status = 0xE0; break;
+        default: return false;
+    }
+    return parseMidi1(static_cast<uint8_t>(status | (message.channel & 0x0F)),
+                      static_cast<uint8_t>(message.data1 & 0x7F),
+                      static_cast<uint8_t>(message.data2 & 0x7F), event);
+}
+
+bool UniversalMidiParser::parseMidi1(uint8_t status, uint8_t data1, uint8_t data2,
+                                     UniversalMidiEvent& event, uint8_t group) {
+    event = UniversalMidiEvent{};
+    event.group = group;
+    event.channel = status & 0x0F;
+    event.sourceBits = 7;
+    data1 &= 0x7F;
+    data2 &= 0x7F;
+
+    switch (status & 0xF0) {
+        case 0x80:
+            event.kind = UniversalMidiEvent::Kind::NoteOff;
+            event.note = data1;
+            event.value = velocityFrom7(data2);
+            return true;
+
+        case 0x90:
+            // Velocity 0 is a note off in MIDI 1.0
+            event.kind = data2 == 0 ? UniversalMidiEvent::Kind::NoteOff : UniversalMidiEvent::Kind::NoteOn;
+            event.note = data1;
+            event.value = velocityFrom7(data2);
+            return true;
+
+        case 0xA0:
+            event.kind = UniversalMidiEvent::Kind::PolyPressure;
+            event.note = data1;
+            event.value = MidiResolution::scaleUp(data2, 7, 32);
+            return true;
+
+        case 0xB0:
+            return parseControlChange(data1, data2, event);
+
+        case 0xC0:
+            event.kind = UniversalMidiEvent::Kind::ProgramChange;
+            event.index = data1;
+            return true;
+
+        case 0xD0:
+            event.kind = UniversalMidiEvent::Kind::ChannelPressure;
+            event.value = MidiResolution::scaleUp(data1, 7, 32);
+            return true;
+
+        case 0xE0:
+            event.kind = UniversalMidiEvent::Kind::PitchBend;
+            event.sourceBits = 14;
+            event.value = MidiResolution::scaleUp(static_cast<uint32_t>(data1 | (data2 << 7)), 14, 32);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool UniversalMidiParser::parseControlChange(uint8_t controller, uint8_t value, UniversalMidiEvent& event) {
+    ChannelState& state = channels_[event.channel];
+    const bool parameterSelected = state.parameter != kNullParameter;
+
+    switch (controller) {
+        case kRpnMsb:
+        case kRpnLsb:
+        case kNrpnMsb:
+        case kNrpnLsb:
+            state.registered = controller == kRpnMsb || controller == kRpnLsb;
+            if (controller == kRpnMsb || controller == kNrpnMsb) {
+                state.parameterMsb = value;
+            } else {
+                state.parameterLsb = value;
+            }
+            state.parameter = static_cast<uint16_t>((state.parameterMsb << 7) | state.parameterLsb);
+            state.dataEntry = 0;
+            return false;
+
+        case kDataEntryMsb:
+            if (!parameterSelected) {
+                break;
+            }
+            // A new MSB clears the LSB; senders that follow up with CC 38 refine it
+            state.dataEntry = static_cast<uint16_t>(value << 7);
+            event.value = MidiResolution::scaleUp(value, 7, 32);
+            return emitParameter(state, 7, event);
+
+        case kDataEntryLsb:
+            if (!parameterSelected) {
+                break;
+            }
+            state.dataEntry = static_cast<uint16_t>((state.dataEntry & 0x3F80) | value);
+            event.value = MidiResolution::scaleUp(state.dataEntry, 14, 32);
+            return emitParameter(state, 14, event);
+
+        case kDataIncrement:
+        case kDataDecrement:
+            if (!parameterSelected) {
+                break;
+            }
+            if (controller == kDataIncrement && state.dataEntry < 0x3FFF) {
+                ++state.dataEntry;
+            } else if (controller == kDataDecrement && state.dataEntry > 0) {
+                --state.dataEntry;
+            }
+            event.value = MidiResolution::scaleUp(state.dataEntry, 14, 32);
+            return emitParameter(state, 14, event);
+
+        case kResetAllControllers:
+            state.msbSeen = 0;
+            break;
+
+        default:
+            break;
+    }
+
+    event.kind = UniversalMidiEvent::Kind::ControlChange;
+    event.index = controller;
+
+    if (pairControllers_ && controller < 32) {
+        state.controllerMsb[controller] = value;
+        state.msbSeen |= 1u << controller;
+    } else if (pairControllers_ && controller < 64 && (state.msbSeen & (1u << (controller - 32)))) {
+        // LSB completes the pair: report it on the MSB controller at 14 bits
+        const uint8_t msbController = static_cast<uint8_t>(controller - 32);
+        event.index = msbController;
+        event.sourceBits = 14;
+        event.value = MidiResolution::scaleUp(
+            static_cast<uint32_t>((state.controllerMsb[msbController] << 7) | value), 14, 32);
+        return true;
+    }
+
+    event.value = MidiResolution::scaleUp(value, 7, 32);
+    return true;
+}
+
+bool UniversalMidiParser::emitParameter(const ChannelState& state, int sourceBits, UniversalMidiEvent& event) {
+    event.kind = state.registered ? UniversalMidiEvent::Kind::RegisteredParameter
+                                  : UniversalMidiEvent::Kind::AssignableParameter;
+    event.index = state.parameter;
+    event.sourceBits = static_cast<uint8_t>(sourceBits);
+    return true;
+}
+
+bool UniversalMidiParser::parseMidi2(const UniversalMidiPacket& packet, UniversalMidiEvent& event) {
+    event = UniversalMidiEvent{};
+    event.group = packet.group();
+    event.channel = packet.channel();
+    event.sourceBits = 32;
+    event.value = packet.data();
+
+    const uint8_t index1 = packet.byte2() & 0x7F;
+    const uint8_t index2 = packet.byte3();
+
+    switch (packet.status()) {
+        case UniversalMidiPacket::NoteOff:
+        case UniversalMidiPacket::NoteOn:
+            event.kind = packet.status() == UniversalMidiPacket::NoteOn ? UniversalMidiEvent::Kind::NoteOn
+                                                                        : UniversalMidiEvent::Kind::NoteOff;
+            event.note = index1;
+            event.sourceBits = 16;
+            // Low half carries the attribute, which nothing here consumes
+            event.value &= 0xFFFF0000u;
+            return true;
+
+        case UniversalMidiPacket::PolyPressure:
+            event.kind = UniversalMidiEvent::Kind::PolyPressure;
+            event.note = index1;
+            return true;
+
+        case UniversalMidiPacket::ControlChange:
+            event.kind = UniversalMidiEvent::Kind::ControlChange;
+            event.index = index1;
+            return true;
+
+        case UniversalMidiPacket::RegisteredController:
+        case UniversalMidiPacket::AssignableController:
+            event.kind = packet.status() == UniversalMidiPacket::RegisteredController
+                             ? UniversalMidiEvent::Kind::RegisteredParameter
+                             : UniversalMidiEvent::Kind::AssignableParameter;
+            event.index = static_cast<uint16_t>((index1 << 7) | (index2 & 0x7F));
+            return true;
+
+        case UniversalMidiPacket::RegisteredPerNoteController:
+        case UniversalMidiPacket::AssignablePerNoteController:
+            event.kind = UniversalMidiEvent::Kind::PerNoteController;
+            event.note = index1;
+            event.index = static_cast<uint16_t>(
+                index2 | (packet.status() == UniversalMidiPacket::AssignablePerNoteController ? 0x100 : 0));
+            return true;
+
+        case UniversalMidiPacket::PerNotePitchBend:
+            event.kind = UniversalMidiEvent::Kind::PerNotePitchBend;
+            event.note = index1;
+            return true;
+
+        case UniversalMidiPacket::ProgramChange:
+            event.kind = UniversalMidiEvent::Kind::ProgramChange;
+            event.index = static_cast<uint16_t>((packet.data() >> 24) & 0x7F);
+            event.value = 0;
+            return true;
+
+        case UniversalMidiPacket::ChannelPressure:
+            event.kind = UniversalMidiEvent::Kind::ChannelPressure;
+            return true;
+
+        case UniversalMidiPacket::PitchBend:
+            event.kind = UniversalMidiEvent::Kind::PitchBend;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+} // namespace AIMusicHardware
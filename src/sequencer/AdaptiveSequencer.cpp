@@ -1,6 +1,7 @@
 #include "../../include/sequencer/AdaptiveSequencer.h"
 #include <algorithm>
 #include <iostream>
+#include <unordered_map>
 
 namespace AIMusicHardware {
 
@@ -10,6 +11,7 @@ namespace AIMusicHardware {
 
 Parameter::Parameter(const std::string& name, float defaultValue, float minValue, float maxValue)
     : name_(name),
+      id_(internId(name)),
       value_(defaultValue),
       defaultValue_(defaultValue),
       minValue_(minValue),
@@ -17,6 +19,20 @@ Parameter::Parameter(const std::string& name, float defaultValue, float minValue
       bipolar_(false) {
 }
 
+uint32_t Parameter::internId(const std::string& name) {
+    static std::mutex registryMutex;
+    static std::unordered_map<std::string, uint32_t> registry;
+    
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = registry.find(name);
+    if (it != registry.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(registry.size());
+    registry.emplace(name, id);
+    return id;
+}
+
 std::string Parameter::getName() const {
     return name_;
 }
@@ -42,6 +58,13 @@ void Parameter::setValue(float value) {
     if (changeCallback_) {
         changeCallback_(*this, oldValue, newValue);
     }
+    
+    // Let dependents (transition conditions) know this parameter moved
+    if (newValue != oldValue) {
+        for (const auto& entry : dependencyNotifiers_) {
+            entry.second(id_);
+        }
+    }
 }
 
 float Parameter::getMin() const {
@@ -68,6 +91,28 @@ void Parameter::setChangeCallback(ChangeCallback callback) {
     changeCallback_ = callback;
 }
 
+void Parameter::addDependencyNotifier(const void* owner, DependencyNotifier notifier) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : dependencyNotifiers_) {
+        if (entry.first == owner) {
+            entry.second = std::move(notifier);
+            return;
+        }
+    }
+    dependencyNotifiers_.emplace_back(owner, std::move(notifier));
+}
+
+void Parameter::removeDependencyNotifier(const void* owner) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dependencyNotifiers_.erase(
+        std::remove_if(dependencyNotifiers_.begin(), dependencyNotifiers_.end(),
+            [owner](const std::pair<const void*, DependencyNotifier>& entry) {
+                return entry.first == owner;
+            }),
+        dependencyNotifiers_.end()
+    );
+}
+
 //------------------------------------------------------------------------------
 // EventSystem Implementation
 //------------------------------------------------------------------------------
@@ -75,112 +120,241 @@ void Parameter::setChangeCallback(ChangeCallback callback) {
 EventSystem::EventSystem() {
 }
 
-void EventSystem::registerEvent(const std::string& eventName) {
-    std::lock_guard<std::mutex> lock(mutex_);
+int EventSystem::getEventId(const std::string& eventName) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     
-    // Only register if it doesn't already exist
-    if (eventListeners_.find(eventName) == eventListeners_.end()) {
-        eventListeners_[eventName] = std::vector<EventCallback>();
+    auto it = eventIds_.find(eventName);
+    if (it != eventIds_.end()) {
+        return it->second;
     }
+    
+    int id = static_cast<int>(eventNames_.size());
+    eventIds_.emplace(eventName, id);
+    eventNames_.push_back(eventName);
+    listeners_.emplace_back();
+    registered_.push_back(false);
+    return id;
+}
+
+int EventSystem::findEventId(const std::string& eventName) const {
+    auto it = eventIds_.find(eventName);
+    return it != eventIds_.end() ? it->second : -1;
+}
+
+void EventSystem::registerEvent(const std::string& eventName) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    registered_[getEventId(eventName)] = true;
 }
 
 void EventSystem::unregisterEvent(const std::string& eventName) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    eventListeners_.erase(eventName);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    // The ID stays interned so scheduled events and cached IDs remain valid
+    int id = findEventId(eventName);
+    if (id >= 0) {
+        registered_[id] = false;
+        listeners_[id].clear();
+    }
 }
 
 bool EventSystem::isEventRegistered(const std::string& eventName) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return eventListeners_.find(eventName) != eventListeners_.end();
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    int id = findEventId(eventName);
+    return id >= 0 && registered_[id];
 }
 
 void EventSystem::addListener(const std::string& eventName, EventCallback callback) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     
     // Register the event if it doesn't exist
-    if (eventListeners_.find(eventName) == eventListeners_.end()) {
-        eventListeners_[eventName] = std::vector<EventCallback>();
-    }
+    int id = getEventId(eventName);
+    registered_[id] = true;
     
     // Add the callback
-    eventListeners_[eventName].push_back(callback);
+    listeners_[id].push_back(callback);
 }
 
 void EventSystem::removeListener(const std::string& eventName, void* owner) {
     // Note: This is a simplified implementation. In a real system, you'd need a way to 
     // identify which callbacks belong to which owner, which is beyond the scope of this example.
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     
-    if (eventListeners_.find(eventName) != eventListeners_.end()) {
+    int id = findEventId(eventName);
+    if (id >= 0) {
         // Clear all callbacks for this event (simplified)
-        eventListeners_[eventName].clear();
+        listeners_[id].clear();
     }
 }
 
 void EventSystem::triggerEvent(const std::string& eventName, const std::map<std::string, float>& eventData) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     
-    if (eventListeners_.find(eventName) != eventListeners_.end()) {
-        // Call all registered callbacks
-        for (const auto& callback : eventListeners_[eventName]) {
-            callback(eventName, eventData);
-        }
+    int id = findEventId(eventName);
+    if (id >= 0) {
+        dispatch(id, eventData);
+    }
+}
+
+void EventSystem::triggerEvent(int eventId, const std::map<std::string, float>& eventData) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    if (eventId >= 0 && eventId < static_cast<int>(listeners_.size())) {
+        dispatch(eventId, eventData);
+    }
+}
+
+void EventSystem::dispatch(int eventId, const EventData& eventData) {
+    // Index each time: a listener may add listeners or intern new events
+    const std::string& eventName = eventNames_[eventId];
+    for (size_t i = 0; i < listeners_[eventId].size(); ++i) {
+        listeners_[eventId][i](eventName, eventData);
     }
 }
 
 void EventSystem::scheduleEvent(const std::string& eventName, float delayInBeats, 
                                const std::map<std::string, float>& eventData) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    scheduleEventAt(getEventId(eventName), currentBeat_ + std::max(0.0f, delayInBeats), eventData);
+}
+
+void EventSystem::scheduleEventAt(int eventId, double beat, const std::map<std::string, float>& eventData) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     
-    // Create a scheduled event
-    ScheduledEvent event;
-    event.eventName = eventName;
-    event.triggerBeat = delayInBeats;  // This would be currentBeat + delayInBeats in a real implementation
-    event.eventData = eventData;
+    if (eventId < 0 || eventId >= static_cast<int>(listeners_.size())) {
+        return;
+    }
+    
+    // Store event data in a pooled slot; events without data carry none
+    int payload = -1;
+    if (!eventData.empty()) {
+        if (!freePayloads_.empty()) {
+            payload = freePayloads_.back();
+            freePayloads_.pop_back();
+            payloads_[payload] = eventData;
+        } else {
+            payload = static_cast<int>(payloads_.size());
+            payloads_.push_back(eventData);
+        }
+    }
     
-    // Add it to the list
-    scheduledEvents_.push_back(event);
+    scheduledEvents_.push_back({beat, nextSequence_++, eventId, payload});
+    std::push_heap(scheduledEvents_.begin(), scheduledEvents_.end(), Later());
 }
 
 void EventSystem::cancelScheduledEvents(const std::string& eventName) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    int id = findEventId(eventName);
+    if (id < 0) {
+        return;
+    }
     
     // Remove all scheduled events with the given name
     scheduledEvents_.erase(
         std::remove_if(scheduledEvents_.begin(), scheduledEvents_.end(),
-            [&eventName](const ScheduledEvent& event) {
-                return event.eventName == eventName;
+            [this, id](const ScheduledEvent& event) {
+                if (event.eventId != id) {
+                    return false;
+                }
+                if (event.payload >= 0) {
+                    payloads_[event.payload].clear();
+                    freePayloads_.push_back(event.payload);
+                }
+                return true;
             }),
         scheduledEvents_.end()
     );
+    std::make_heap(scheduledEvents_.begin(), scheduledEvents_.end(), Later());
 }
 
-void EventSystem::processTick(float beatPosition) {
-    std::lock_guard<std::mutex> lock(mutex_);
+void EventSystem::processTick(double beatPosition) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     
-    // Find events that should be triggered
-    std::vector<ScheduledEvent> eventsToTrigger;
+    // Events already queued by collectDue() fire first
+    dispatchPending();
     
-    // Copy events that should be triggered and remove them from the list
-    scheduledEvents_.erase(
-        std::remove_if(scheduledEvents_.begin(), scheduledEvents_.end(),
-            [beatPosition, &eventsToTrigger](const ScheduledEvent& event) {
-                if (event.triggerBeat <= beatPosition) {
-                    eventsToTrigger.push_back(event);
-                    return true;
-                }
-                return false;
-            }),
-        scheduledEvents_.end()
-    );
+    currentBeat_ = beatPosition;
+    
+    // Events scheduled from listeners during this tick wait for the next one
+    const uint64_t sequenceLimit = nextSequence_;
+    static const EventData noData;
+    
+    while (!scheduledEvents_.empty() && scheduledEvents_.front().triggerBeat <= beatPosition) {
+        std::pop_heap(scheduledEvents_.begin(), scheduledEvents_.end(), Later());
+        ScheduledEvent event = scheduledEvents_.back();
+        scheduledEvents_.pop_back();
+        
+        if (event.sequence >= sequenceLimit) {
+            deferredEvents_.push_back(event);
+            continue;
+        }
+        
+        dispatch(event.eventId, event.payload >= 0 ? payloads_[event.payload] : noData);
+        
+        if (event.payload >= 0) {
+            freePayloads_.push_back(event.payload);
+        }
+    }
+    
+    for (const ScheduledEvent& event : deferredEvents_) {
+        scheduledEvents_.push_back(event);
+        std::push_heap(scheduledEvents_.begin(), scheduledEvents_.end(), Later());
+    }
+    deferredEvents_.clear();
+}
+
+size_t EventSystem::collectDue(double beatPosition) {
+    std::unique_lock<std::recursive_mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return 0;  // Another thread is scheduling or dispatching; retry next block
+    }
+    
+    currentBeat_ = beatPosition;
+    
+    size_t write = dueWrite_.load(std::memory_order_relaxed);
+    const size_t read = dueRead_.load(std::memory_order_acquire);
+    size_t queued = 0;
     
-    // Trigger the events (outside the loop to avoid recursive locks)
-    for (const auto& event : eventsToTrigger) {
-        // Release the lock while triggering
-        mutex_.unlock();
-        triggerEvent(event.eventName, event.eventData);
-        mutex_.lock();
+    while (!scheduledEvents_.empty() && scheduledEvents_.front().triggerBeat <= beatPosition &&
+           write - read < kDueQueueSize) {
+        std::pop_heap(scheduledEvents_.begin(), scheduledEvents_.end(), Later());
+        const ScheduledEvent& event = scheduledEvents_.back();
+        dueEvents_[write & (kDueQueueSize - 1)] = {event.eventId, event.payload};
+        scheduledEvents_.pop_back();
+        ++write;
+        ++queued;
     }
+    
+    dueWrite_.store(write, std::memory_order_release);
+    return queued;
+}
+
+size_t EventSystem::dispatchPending() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    static const EventData noData;
+    const size_t write = dueWrite_.load(std::memory_order_acquire);
+    size_t dispatched = 0;
+    
+    // Re-read the position each time: a listener may dispatch recursively
+    for (size_t read = dueRead_.load(std::memory_order_relaxed); read != write;
+         read = dueRead_.load(std::memory_order_relaxed)) {
+        const DueEvent event = dueEvents_[read & (kDueQueueSize - 1)];
+        dueRead_.store(read + 1, std::memory_order_release);
+        
+        dispatch(event.eventId, event.payload >= 0 ? payloads_[event.payload] : noData);
+        ++dispatched;
+        
+        if (event.payload >= 0) {
+            freePayloads_.push_back(event.payload);
+        }
+    }
+    return dispatched;
+}
+
+size_t EventSystem::getScheduledEventCount() const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return scheduledEvents_.size();
 }
 
 //------------------------------------------------------------------------------
@@ -506,6 +680,24 @@ bool StateTransition::checkConditions() const {
     return true;
 }
 
+std::vector<uint32_t> StateTransition::getConditionParameterIds() const {
+    std::vector<uint32_t> ids;
+    for (const auto& param : getConditionParameters()) {
+        ids.push_back(param->getId());
+    }
+    return ids;
+}
+
+std::vector<std::shared_ptr<Parameter>> StateTransition::getConditionParameters() const {
+    std::vector<std::shared_ptr<Parameter>> params;
+    for (const auto& pair : conditions_) {
+        if (auto param = pair.second.parameter.lock()) {
+            params.push_back(param);
+        }
+    }
+    return params;
+}
+
 //------------------------------------------------------------------------------
 // TransitionManager Implementation
 //------------------------------------------------------------------------------
@@ -515,16 +707,25 @@ TransitionManager::TransitionManager()
 }
 
 TransitionManager::~TransitionManager() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    detachNotifiersLocked();
 }
 
 void TransitionManager::addTransition(std::shared_ptr<StateTransition> transition) {
     std::lock_guard<std::mutex> lock(mutex_);
     transitions_[transition->getName()] = transition;
+    rebuildIndexLocked();
 }
 
 void TransitionManager::removeTransition(const std::string& transitionName) {
     std::lock_guard<std::mutex> lock(mutex_);
     transitions_.erase(transitionName);
+    rebuildIndexLocked();
+}
+
+void TransitionManager::refreshIndex() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rebuildIndexLocked();
 }
 
 std::shared_ptr<StateTransition> TransitionManager::getTransition(const std::string& transitionName) {
@@ -608,6 +809,100 @@ void TransitionManager::update(float deltaTime) {
     }
 }
 
+std::shared_ptr<StateTransition> TransitionManager::findTriggeredTransition(
+        const std::shared_ptr<MusicState>& fromState, bool fullScan) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    // Take the changes reported since the last call; swapping keeps both buffers' capacity
+    {
+        std::lock_guard<std::mutex> changedLock(changedMutex_);
+        evaluatingParameters_.swap(changedParameters_);
+        changedParameters_.clear();
+    }
+    
+    std::shared_ptr<StateTransition> triggered;
+    auto evaluate = [&](const std::shared_ptr<StateTransition>& transition) {
+        if (transition->getFromState() != fromState) {
+            return false;
+        }
+        ++conditionEvaluations_;
+        if (transition->checkConditions()) {
+            triggered = transition;
+            return true;
+        }
+        return false;
+    };
+    
+    if (fullScan || indexChanged_) {
+        indexChanged_ = false;
+        for (const auto& pair : transitions_) {
+            if (evaluate(pair.second)) {
+                break;
+            }
+        }
+    } else {
+        // Only transitions whose conditions read a changed parameter
+        for (uint32_t parameterId : evaluatingParameters_) {
+            auto it = transitionsByParameter_.find(parameterId);
+            if (it == transitionsByParameter_.end()) {
+                continue;
+            }
+            for (const auto& transition : it->second) {
+                if (evaluate(transition)) {
+                    break;
+                }
+            }
+            if (triggered) {
+                break;
+            }
+        }
+    }
+    
+    evaluatingParameters_.clear();
+    return triggered;
+}
+
+void TransitionManager::markParameterChanged(uint32_t parameterId) {
+    std::lock_guard<std::mutex> lock(changedMutex_);
+    
+    // Usually a handful of entries; a linear check keeps it duplicate free
+    if (std::find(changedParameters_.begin(), changedParameters_.end(), parameterId) == changedParameters_.end()) {
+        changedParameters_.push_back(parameterId);
+    }
+}
+
+void TransitionManager::rebuildIndexLocked() {
+    detachNotifiersLocked();
+    transitionsByParameter_.clear();
+    
+    for (const auto& pair : transitions_) {
+        for (const auto& param : pair.second->getConditionParameters()) {
+            transitionsByParameter_[param->getId()].push_back(pair.second);
+            
+            // Different states may hold distinct parameters with the same name (and ID)
+            bool observed = std::any_of(observedParameters_.begin(), observedParameters_.end(),
+                [&param](const std::weak_ptr<Parameter>& other) { return other.lock() == param; });
+            if (!observed) {
+                param->addDependencyNotifier(this, [this](uint32_t parameterId) {
+                    markParameterChanged(parameterId);
+                });
+                observedParameters_.push_back(param);
+            }
+        }
+    }
+    
+    indexChanged_ = true;
+}
+
+void TransitionManager::detachNotifiersLocked() {
+    for (const auto& weakParam : observedParameters_) {
+        if (auto param = weakParam.lock()) {
+            param->removeDependencyNotifier(this);
+        }
+    }
+    observedParameters_.clear();
+}
+
 //------------------------------------------------------------------------------
 // AdaptiveSequencer Implementation
 //------------------------------------------------------------------------------
@@ -615,7 +910,9 @@ void TransitionManager::update(float deltaTime) {
 AdaptiveSequencer::AdaptiveSequencer()
     : isPlaying_(false),
       tempo_(120.0f),
-      currentBeat_(0.0f) {
+      currentBeat_(0.0),
+      sampleRate_(44100.0),
+      samplePosition_(0) {
     
     eventSystem_ = std::make_unique<EventSystem>();
     transitionManager_ = std::make_unique<TransitionManager>();
@@ -663,14 +960,15 @@ bool AdaptiveSequencer::initialize(std::shared_ptr<AudioEngine> audioEngine,
 }
 
 void AdaptiveSequencer::shutdown() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    // Stop playback
+    // Stop playback (takes the lock itself)
     stop();
     
+    std::lock_guard<std::mutex> lock(mutex_);
+    
     // Clean up resources
     states_.clear();
     activeState_.reset();
+    scannedState_.reset();
     globalParameters_.clear();
     
     // Release dependencies
@@ -802,6 +1100,11 @@ void AdaptiveSequencer::addEventListener(const std::string& eventName, EventSyst
     eventSystem_->addListener(eventName, callback);
 }
 
+void AdaptiveSequencer::scheduleEvent(const std::string& eventName, float delayInBeats,
+                                      const std::map<std::string, float>& data) {
+    eventSystem_->scheduleEvent(eventName, delayInBeats, data);
+}
+
 void AdaptiveSequencer::play() {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -831,7 +1134,8 @@ void AdaptiveSequencer::stop() {
         // sequencer_->stop();
         
         // Reset the beat counter
-        currentBeat_ = 0.0f;
+        currentBeat_ = 0.0;
+        samplePosition_ = 0;
         
         // Trigger event
         eventSystem_->triggerEvent("stop");
@@ -892,33 +1196,77 @@ void AdaptiveSequencer::update(float deltaTime) {
         return;
     }
     
-    // Update the beat position
-    // In a real implementation, this would be synchronized with the audio engine
+    // Wall-clock driven; prefer processBlock() when an audio clock is available
     float beatsPerSecond = tempo_ / 60.0f;
-    float beatAdvance = beatsPerSecond * deltaTime;
-    currentBeat_ += beatAdvance;
+    advance(beatsPerSecond * deltaTime, false);
+}
+
+void AdaptiveSequencer::setSampleRate(double sampleRate) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (sampleRate > 0.0) {
+        sampleRate_ = sampleRate;
+    }
+}
+
+void AdaptiveSequencer::processBlock(int numFrames) {
+    if (numFrames <= 0) {
+        return;
+    }
+    
+    // The audio thread must not wait on a control thread; keep the frames for the next block
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        pendingFrames_ += numFrames;
+        return;
+    }
+    
+    const int frames = numFrames + pendingFrames_;
+    pendingFrames_ = 0;
+    
+    if (!isPlaying_) {
+        return;
+    }
+    
+    samplePosition_ += static_cast<uint64_t>(frames);
+    advance(frames * (tempo_ / 60.0) / sampleRate_, true);
+}
+
+size_t AdaptiveSequencer::dispatchEvents() {
+    return eventSystem_->dispatchPending();
+}
+
+double AdaptiveSequencer::getCurrentBeat() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return currentBeat_;
+}
+
+uint64_t AdaptiveSequencer::getSamplePosition() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return samplePosition_;
+}
+
+void AdaptiveSequencer::advance(double beats, bool queueEvents) {
+    currentBeat_ += beats;
     
     // Process scheduled events
-    eventSystem_->processTick(currentBeat_);
+    if (queueEvents) {
+        eventSystem_->collectDue(currentBeat_);
+    } else {
+        eventSystem_->processTick(currentBeat_);
+    }
     
-    // Update transitions
-    transitionManager_->update(deltaTime);
+    // Update transitions (durations are in beats)
+    transitionManager_->update(static_cast<float>(beats));
     
-    // Check for auto-transitions
+    // Check for auto-transitions: everything out of a newly active state,
+    // otherwise only transitions whose parameters changed
     if (!transitionManager_->isTransitioning()) {
-        for (const auto& pair : transitionManager_->getAllTransitions()) {
-            auto transition = pair;
-            
-            // Skip transitions that don't start from the current state
-            if (transition->getFromState() != activeState_) {
-                continue;
-            }
-            
-            // Check if this transition's conditions are met
-            if (transition->checkConditions()) {
-                transitionManager_->startTransition(transition->getName());
-                break;
-            }
+        bool fullScan = activeState_ != scannedState_;
+        scannedState_ = activeState_;
+        
+        auto transition = transitionManager_->findTriggeredTransition(activeState_, fullScan);
+        if (transition) {
+            transitionManager_->startTransition(transition->getName());
         }
     }
 }
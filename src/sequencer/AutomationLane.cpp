@@ -0,0 +1,532 @@
+#include "../../include/sequencer/AutomationLane.h"
+#include "../../include/sequencer/Sequencer.h"
+#include "../../include/audio/ParameterStore.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace AIMusicHardware {
+
+namespace {
+
+// Segments the cursor steps over before it falls back to a binary search
+constexpr int kMaxCursorSteps = 8;
+
+// Spacing given to a recorded change at the same beat as the previous one
+constexpr double kMinRecordSpacing = 1e-6;
+
+// Rounding slack when stepping sample positions onto points; far below a
+// sample at any tempo and rate
+constexpr double kBeatEpsilon = 1e-9;
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// AutomationLane
+//------------------------------------------------------------------------------
+
+AutomationLane::AutomationLane(const std::string& parameterId, float minValue, float maxValue)
+    : parameterId_(parameterId),
+      minValue_(std::min(minValue, maxValue)),
+      maxValue_(std::max(minValue, maxValue)) {
+}
+
+AutomationLane::~AutomationLane() {
+}
+
+void AutomationLane::setMidiController(int controller, int channel) {
+    midiController_ = controller >= 0 && controller < 128 ? controller : -1;
+    midiChannel_ = std::clamp(channel, 0, 15);
+}
+
+void AutomationLane::addPoint(double beat, float value, Shape shape) {
+    value = std::clamp(value, minValue_, maxValue_);
+    cursor_ = -1;
+
+    if (beats_.empty() || beat > beats_.back()) {
+        beats_.push_back(beat);
+        values_.push_back(value);
+        shapes_.push_back(shape);
+        return;
+    }
+
+    auto it = std::lower_bound(beats_.begin(), beats_.end(), beat);
+    const size_t index = static_cast<size_t>(it - beats_.begin());
+    if (*it == beat) {
+        values_[index] = value;
+        shapes_[index] = shape;
+        return;
+    }
+    beats_.insert(it, beat);
+    values_.insert(values_.begin() + index, value);
+    shapes_.insert(shapes_.begin() + index, shape);
+}
+
+void AutomationLane::removePoints(double startBeat, double endBeat) {
+    const auto first = std::lower_bound(beats_.begin(), beats_.end(), startBeat);
+    const auto last = std::upper_bound(first, beats_.end(), endBeat);
+    const auto from = first - beats_.begin();
+    const auto to = last - beats_.begin();
+
+    beats_.erase(first, last);
+    values_.erase(values_.begin() + from, values_.begin() + to);
+    shapes_.erase(shapes_.begin() + from, shapes_.begin() + to);
+    cursor_ = -1;
+}
+
+void AutomationLane::replacePoints(double startBeat, double endBeat, const std::vector<double>& beats,
+                                   const std::vector<float>& values, const std::vector<Shape>& shapes) {
+    removePoints(startBeat, endBeat);
+
+    const auto at = std::lower_bound(beats_.begin(), beats_.end(), startBeat) - beats_.begin();
+    const size_t count = std::min(beats.size(), values.size());
+
+    beats_.insert(beats_.begin() + at, beats.begin(), beats.begin() + count);
+    values_.insert(values_.begin() + at, count, 0.0f);
+    shapes_.insert(shapes_.begin() + at, count, Shape::Linear);
+    for (size_t i = 0; i < count; ++i) {
+        values_[at + i] = std::clamp(values[i], minValue_, maxValue_);
+        if (i < shapes.size()) {
+            shapes_[at + i] = shapes[i];
+        }
+    }
+}
+
+void AutomationLane::clear() {
+    beats_.clear();
+    values_.clear();
+    shapes_.clear();
+    cursor_ = -1;
+}
+
+void AutomationLane::reserve(size_t numPoints) {
+    beats_.reserve(numPoints);
+    values_.reserve(numPoints);
+    shapes_.reserve(numPoints);
+}
+
+size_t AutomationLane::getMemoryUsage() const {
+    return beats_.capacity() * sizeof(double) + values_.capacity() * sizeof(float) +
+           shapes_.capacity() * sizeof(Shape);
+}
+
+long AutomationLane::findSegment(double beat) const {
+    return static_cast<long>(std::upper_bound(beats_.begin(), beats_.end(), beat) - beats_.begin()) - 1;
+}
+
+long AutomationLane::seek(double beat) {
+    const long count = static_cast<long>(beats_.size());
+    long segment = std::min(cursor_, count - 1);
+
+    if (segment >= 0 && beat < beats_[static_cast<size_t>(segment)]) {
+        // Looped or located backwards
+        segment = findSegment(beat);
+    } else {
+        int steps = 0;
+        while (segment + 1 < count && beats_[static_cast<size_t>(segment + 1)] <= beat) {
+            if (++steps > kMaxCursorSteps) {
+                segment = findSegment(beat);
+                break;
+            }
+            ++segment;
+        }
+    }
+
+    cursor_ = segment;
+    return segment;
+}
+
+float AutomationLane::segmentValue(long segment, double beat) const {
+    if (segment < 0) {
+        return values_.front();
+    }
+    const size_t index = static_cast<size_t>(segment);
+    if (index + 1 >= beats_.size() || shapes_[index] == Shape::Step) {
+        return values_[index];
+    }
+
+    const double start = beats_[index];
+    const double position = (beat - start) / (beats_[index + 1] - start);
+    return values_[index] + static_cast<float>(position) * (values_[index + 1] - values_[index]);
+}
+
+float AutomationLane::getValueAt(double beat) const {
+    if (beats_.empty()) {
+        return minValue_;
+    }
+    return segmentValue(findSegment(beat), beat);
+}
+
+float AutomationLane::evaluate(double beat) {
+    if (beats_.empty()) {
+        return minValue_;
+    }
+    return segmentValue(seek(beat), beat);
+}
+
+void AutomationLane::render(double startBeat, double beatsPerSample, float* output, int numFrames) {
+    if (beats_.empty()) {
+        std::fill(output, output + std::max(0, numFrames), minValue_);
+        return;
+    }
+
+    const long count = static_cast<long>(beats_.size());
+    int frame = 0;
+    while (frame < numFrames) {
+        const double beat = startBeat + frame * beatsPerSample + kBeatEpsilon;
+        const long segment = seek(beat);
+
+        // Samples before the next point belong to this segment
+        int length = numFrames - frame;
+        if (segment + 1 < count && beatsPerSample > 0.0) {
+            const double samples = std::ceil((beats_[static_cast<size_t>(segment + 1)] - beat) / beatsPerSample);
+            length = static_cast<int>(std::max(1.0, std::min(samples, static_cast<double>(length))));
+        }
+
+        float* out = output + frame;
+        if (segment < 0 || segment + 1 >= count || shapes_[static_cast<size_t>(segment)] == Shape::Step) {
+            std::fill(out, out + length, segmentValue(segment, beat));
+        } else {
+            const size_t index = static_cast<size_t>(segment);
+            const double segmentStart = beats_[index];
+            const double slope = (values_[index + 1] - values_[index]) / (beats_[index + 1] - segmentStart);
+            const double offset = startBeat - segmentStart;
+            for (int i = 0; i < length; ++i) {
+                out[i] = values_[index] + static_cast<float>(slope * (offset + (frame + i) * beatsPerSample));
+            }
+        }
+        frame += length;
+    }
+}
+
+//------------------------------------------------------------------------------
+// AutomationRecorder
+//------------------------------------------------------------------------------
+
+AutomationRecorder::AutomationRecorder(float tolerance)
+    : tolerance_(std::max(0.0f, tolerance)) {
+}
+
+void AutomationRecorder::setTolerance(float tolerance) {
+    tolerance_ = std::max(0.0f, tolerance);
+}
+
+void AutomationRecorder::begin(double beat) {
+    recording_ = true;
+    startBeat_ = beat;
+    received_ = 0;
+    beats_.clear();
+    values_.clear();
+    hasPending_ = false;
+}
+
+bool AutomationRecorder::addValue(double beat, float value) {
+    if (!recording_) {
+        return false;
+    }
+    if (beats_.empty()) {
+        if (beat < startBeat_) {
+            return false;
+        }
+        ++received_;
+        keep(beat, value);
+        return true;
+    }
+
+    const double lastBeat = hasPending_ ? pendingBeat_ : beats_.back();
+    if (beat < lastBeat) {
+        return false;
+    }
+    ++received_;
+    beat = std::max(beat, lastBeat + kMinRecordSpacing);
+
+    if (!hasPending_) {
+        hasPending_ = true;
+        pendingBeat_ = beat;
+        pendingValue_ = value;
+        slopeLow_ = -std::numeric_limits<double>::infinity();
+        slopeHigh_ = std::numeric_limits<double>::infinity();
+        return true;
+    }
+
+    // Accepting the new change drops the pending one, so the line from the
+    // anchor must pass within tolerance of it as well
+    const double anchorBeat = beats_.back();
+    const double anchorValue = values_.back();
+    const double pendingSpan = pendingBeat_ - anchorBeat;
+    const double low = std::max(slopeLow_, (pendingValue_ - tolerance_ - anchorValue) / pendingSpan);
+    const double high = std::min(slopeHigh_, (pendingValue_ + tolerance_ - anchorValue) / pendingSpan);
+    const double slope = (value - anchorValue) / (beat - anchorBeat);
+
+    if (slope >= low && slope <= high) {
+        slopeLow_ = low;
+        slopeHigh_ = high;
+    } else {
+        keep(pendingBeat_, pendingValue_);
+        slopeLow_ = -std::numeric_limits<double>::infinity();
+        slopeHigh_ = std::numeric_limits<double>::infinity();
+    }
+    pendingBeat_ = beat;
+    pendingValue_ = value;
+    return true;
+}
+
+void AutomationRecorder::finish(double endBeat, AutomationLane& lane) {
+    if (!recording_) {
+        return;
+    }
+    recording_ = false;
+    if (hasPending_) {
+        keep(pendingBeat_, pendingValue_);
+        hasPending_ = false;
+    }
+    if (beats_.empty()) {
+        return;
+    }
+
+    using Shape = AutomationLane::Shape;
+    endBeat = std::max(endBeat, beats_.back());
+
+    std::vector<double> beats;
+    std::vector<float> values;
+    std::vector<Shape> shapes;
+    beats.reserve(beats_.size() + 2);
+    values.reserve(beats_.size() + 2);
+    shapes.reserve(beats_.size() + 2);
+
+    // Hold the existing curve up to the take and pick it up again after it
+    const bool joinExisting = !lane.isEmpty();
+    const float before = lane.getValueAt(startBeat_);
+    const float after = lane.getValueAt(endBeat);
+
+    if (joinExisting && beats_.front() > startBeat_) {
+        beats.push_back(startBeat_);
+        values.push_back(before);
+        shapes.push_back(Shape::Step);
+    }
+    beats.insert(beats.end(), beats_.begin(), beats_.end());
+    values.insert(values.end(), values_.begin(), values_.end());
+    shapes.insert(shapes.end(), beats_.size(), Shape::Linear);
+    if (joinExisting && endBeat > beats_.back()) {
+        shapes.back() = Shape::Step;
+        beats.push_back(endBeat);
+        values.push_back(after);
+        shapes.push_back(Shape::Linear);
+    }
+
+    lane.replacePoints(startBeat_, endBeat, beats, values, shapes);
+    beats_.clear();
+    values_.clear();
+}
+
+void AutomationRecorder::cancel() {
+    recording_ = false;
+    hasPending_ = false;
+    beats_.clear();
+    values_.clear();
+}
+
+void AutomationRecorder::keep(double beat, float value) {
+    beats_.push_back(beat);
+    values_.push_back(value);
+}
+
+//------------------------------------------------------------------------------
+// AutomationPlayer
+//------------------------------------------------------------------------------
+
+AutomationPlayer::AutomationPlayer(int sampleRate)
+    : sampleRate_(std::max(1, sampleRate)),
+      maxBlockSize_(512) {
+}
+
+AutomationPlayer::~AutomationPlayer() {
+}
+
+int AutomationPlayer::addLane(const AutomationLane& lane) {
+    std::lock_guard<std::mutex> lock(laneMutex_);
+
+    auto slot = std::make_unique<Slot>();
+    slot->lane = lane;
+    slot->lane.resetCursor();
+    slot->storeIndex = store_ ? store_->getIndex(lane.getParameterId()) : -1;
+    slot->value = lane.getValueAt(0.0);
+    slot->buffer.assign(static_cast<size_t>(maxBlockSize_), slot->value);
+
+    slots_.push_back(std::move(slot));
+    return static_cast<int>(slots_.size()) - 1;
+}
+
+int AutomationPlayer::getLaneCount() const {
+    return static_cast<int>(slots_.size());
+}
+
+int AutomationPlayer::findLane(const std::string& parameterId) const {
+    std::lock_guard<std::mutex> lock(laneMutex_);
+    for (size_t i = 0; i < slots_.size(); ++i) {
+        if (slots_[i]->lane.getParameterId() == parameterId) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool AutomationPlayer::editLane(int index, const std::function<void(AutomationLane&)>& edit) {
+    if (!isValidLane(index) || !edit) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(laneMutex_);
+    AutomationLane& lane = slots_[static_cast<size_t>(index)]->lane;
+    edit(lane);
+    lane.resetCursor();
+    return true;
+}
+
+AutomationLane AutomationPlayer::getLane(int index) const {
+    if (!isValidLane(index)) {
+        return AutomationLane();
+    }
+    std::lock_guard<std::mutex> lock(laneMutex_);
+    return slots_[static_cast<size_t>(index)]->lane;
+}
+
+void AutomationPlayer::bindStore(ParameterStore* store) {
+    std::lock_guard<std::mutex> lock(laneMutex_);
+    store_ = store;
+    for (auto& slot : slots_) {
+        slot->storeIndex = store_ ? store_->getIndex(slot->lane.getParameterId()) : -1;
+    }
+}
+
+void AutomationPlayer::prepare(int maxBlockSize) {
+    std::lock_guard<std::mutex> lock(laneMutex_);
+    maxBlockSize_ = std::max(1, maxBlockSize);
+    for (auto& slot : slots_) {
+        slot->buffer.assign(static_cast<size_t>(maxBlockSize_), slot->value);
+    }
+}
+
+void AutomationPlayer::setSampleRate(int sampleRate) {
+    sampleRate_ = std::max(1, sampleRate);
+}
+
+bool AutomationPlayer::startRecording(int index, double beat, float tolerance) {
+    if (!isValidLane(index)) {
+        return false;
+    }
+    Slot& slot = *slots_[static_cast<size_t>(index)];
+    std::lock_guard<std::mutex> recordLock(slot.recordMutex);
+
+    float range;
+    {
+        std::lock_guard<std::mutex> lock(laneMutex_);
+        range = slot.lane.getMaxValue() - slot.lane.getMinValue();
+    }
+    slot.recorder.setTolerance(std::max(0.0f, tolerance) * range);
+    slot.recorder.begin(beat);
+    slot.recording.store(true, std::memory_order_release);
+    return true;
+}
+
+bool AutomationPlayer::recordValue(int index, double beat, float value) {
+    if (!isValidLane(index)) {
+        return false;
+    }
+    Slot& slot = *slots_[static_cast<size_t>(index)];
+    std::lock_guard<std::mutex> recordLock(slot.recordMutex);
+    if (!slot.recorder.isRecording()) {
+        return false;
+    }
+    if (slot.recorder.addValue(beat, value)) {
+        return true;
+    }
+
+    // The transport went back: keep what was recorded and start a new take
+    {
+        std::lock_guard<std::mutex> lock(laneMutex_);
+        slot.recorder.finish(beat, slot.lane);
+        slot.lane.resetCursor();
+    }
+    slot.recorder.begin(beat);
+    return slot.recorder.addValue(beat, value);
+}
+
+bool AutomationPlayer::stopRecording(int index, double beat) {
+    if (!isValidLane(index)) {
+        return false;
+    }
+    Slot& slot = *slots_[static_cast<size_t>(index)];
+    std::lock_guard<std::mutex> recordLock(slot.recordMutex);
+    if (!slot.recorder.isRecording()) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(laneMutex_);
+        slot.recorder.finish(beat, slot.lane);
+        slot.lane.resetCursor();
+    }
+    slot.recording.store(false, std::memory_order_release);
+    return true;
+}
+
+bool AutomationPlayer::isRecording(int index) const {
+    return isValidLane(index) && slots_[static_cast<size_t>(index)]->recording.load(std::memory_order_acquire);
+}
+
+void AutomationPlayer::process(double startBeat, double tempo, int numFrames) {
+    const double beatsPerSample = tempo / 60.0 / sampleRate_;
+    int offset = 0;
+    while (offset < numFrames) {
+        const int chunk = std::min(maxBlockSize_, numFrames - offset);
+        processChunk(startBeat + offset * beatsPerSample, beatsPerSample, chunk);
+        offset += chunk;
+    }
+}
+
+void AutomationPlayer::process(const Sequencer& sequencer, int numFrames) {
+    process(sequencer.getPrecisePositionInBeats(), sequencer.getTempo(), numFrames);
+}
+
+void AutomationPlayer::processChunk(double startBeat, double beatsPerSample, int numFrames) {
+    std::unique_lock<std::mutex> lock(laneMutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        // An edit is in progress; hold every lane where it was
+        ++skippedBlocks_;
+        for (auto& slot : slots_) {
+            std::fill(slot->buffer.begin(), slot->buffer.begin() + numFrames, slot->value);
+        }
+        return;
+    }
+
+    for (auto& slotPtr : slots_) {
+        Slot& slot = *slotPtr;
+        if (slot.lane.isEmpty() || slot.recording.load(std::memory_order_acquire)) {
+            slot.rendered = false;
+            continue;
+        }
+
+        slot.lane.render(startBeat, beatsPerSample, slot.buffer.data(), numFrames);
+        slot.value = slot.buffer[static_cast<size_t>(numFrames) - 1];
+        slot.rendered = true;
+        if (store_ && slot.storeIndex >= 0) {
+            store_->setValue(slot.storeIndex, slot.value);
+        }
+    }
+}
+
+const float* AutomationPlayer::getLaneBuffer(int index) const {
+    if (!isValidLane(index) || !slots_[static_cast<size_t>(index)]->rendered) {
+        return nullptr;
+    }
+    return slots_[static_cast<size_t>(index)]->buffer.data();
+}
+
+float AutomationPlayer::getLaneValue(int index) const {
+    return isValidLane(index) ? slots_[static_cast<size_t>(index)]->value : 0.0f;
+}
+
+bool AutomationPlayer::isValidLane(int index) const {
+    return index >= 0 && index < static_cast<int>(slots_.size());
+}
+
+} // namespace AIMusicHardware
@@ -1,4 +1,5 @@
 #include "../../include/sequencer/MidiFile.h"
+#include "../../include/sequencer/AutomationLane.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
@@ -17,6 +18,11 @@ bool MidiFile::exportPattern(const Pattern& pattern, const std::string& filename
 }
 
 bool MidiFile::exportPatterns(const std::vector<Pattern*>& patterns, const std::string& filename, double tempo) {
+    return exportPatterns(patterns, {}, filename, tempo);
+}
+
+bool MidiFile::exportPatterns(const std::vector<Pattern*>& patterns, const std::vector<const AutomationLane*>& lanes,
+                              const std::string& filename, double tempo) {
     // Open the output file
     std::ofstream file(filename, std::ios::binary);
     if (!file.is_open()) {
@@ -24,8 +30,16 @@ bool MidiFile::exportPatterns(const std::vector<Pattern*>& patterns, const std::
         return false;
     }
     
-    // Calculate number of tracks (one for each pattern plus one for tempo track)
-    uint16_t numTracks = patterns.size() + 1;
+    // Only lanes mapped to a controller can be written
+    std::vector<const AutomationLane*> controllerLanes;
+    for (const auto* lane : lanes) {
+        if (lane && lane->getMidiController() >= 0 && !lane->isEmpty()) {
+            controllerLanes.push_back(lane);
+        }
+    }
+    
+    // Calculate number of tracks (one for each pattern and lane plus one for tempo track)
+    uint16_t numTracks = patterns.size() + controllerLanes.size() + 1;
     
     // Write MIDI header
     writeHeader(file, 1, numTracks, PPQN); // Format 1 (multiple tracks)
@@ -52,11 +66,7 @@ bool MidiFile::exportPatterns(const std::vector<Pattern*>& patterns, const std::
     writeTrackEnd(file);
     
     // Update tempo track length
-    long currentPos = file.tellp();
-    file.seekp(tempoTrackHeaderPos + 4);
-    uint32_t tempoTrackLength = currentPos - (tempoTrackHeaderPos + 8);
-    file.write(reinterpret_cast<const char*>(&tempoTrackLength), 4);
-    file.seekp(currentPos);
+    patchTrackLength(file, tempoTrackHeaderPos);
     
     // Write each pattern as a separate track
     for (const auto& pattern : patterns) {
@@ -67,7 +77,8 @@ bool MidiFile::exportPatterns(const std::vector<Pattern*>& patterns, const std::
         writeTrackHeader(file, 0); // Placeholder value
         
         // Track name meta event
-        std::vector<uint8_t> trackNameData(pattern->getName().begin(), pattern->getName().end());
+        const std::string name = pattern->getName();
+        std::vector<uint8_t> trackNameData(name.begin(), name.end());
         writeMetaEvent(file, 0, 0x03, trackNameData);
         
         // Keep track of active notes to ensure note-offs are written
@@ -150,11 +161,16 @@ bool MidiFile::exportPatterns(const std::vector<Pattern*>& patterns, const std::
         writeTrackEnd(file);
         
         // Update track length
-        long currentPos = file.tellp();
-        file.seekp(trackStartPos + 4);
-        uint32_t trackLength = currentPos - (trackStartPos + 8);
-        file.write(reinterpret_cast<const char*>(&trackLength), 4);
-        file.seekp(currentPos);
+        patchTrackLength(file, trackStartPos);
+    }
+    
+    // Write each automation lane as a controller track
+    for (const auto* lane : controllerLanes) {
+        long trackStartPos = file.tellp();
+        writeTrackHeader(file, 0); // Placeholder value
+        writeAutomationTrack(file, *lane);
+        writeTrackEnd(file);
+        patchTrackLength(file, trackStartPos);
     }
     
     file.close();
@@ -227,6 +243,73 @@ void MidiFile::writeMetaEvent(std::ofstream& file, uint32_t deltaTime, uint8_t m
     }
 }
 
+void MidiFile::writeAutomationTrack(std::ofstream& file, const AutomationLane& lane) {
+    // Track name meta event
+    const std::string& name = lane.getParameterId();
+    writeMetaEvent(file, 0, 0x03, std::vector<uint8_t>(name.begin(), name.end()));
+    
+    const uint8_t status = 0xB0 | (lane.getMidiChannel() & 0x0F);
+    const uint8_t controller = lane.getMidiController() & 0x7F;
+    const float minValue = lane.getMinValue();
+    const float range = lane.getMaxValue() - minValue;
+    
+    auto toController = [minValue, range](float value) {
+        if (range <= 0.0f) {
+            return 0;
+        }
+        return std::clamp(static_cast<int>(std::lround((value - minValue) / range * 127.0f)), 0, 127);
+    };
+    auto toTick = [](double beat) {
+        return static_cast<uint32_t>(std::max(0.0, std::round(beat * PPQN)));
+    };
+    
+    // Only changes of the 7-bit value are written
+    uint32_t currentTick = 0;
+    int lastValue = -1;
+    auto writeValue = [&](uint32_t tick, int value) {
+        if (value == lastValue) {
+            return;
+        }
+        writeEvent(file, tick - currentTick, status, controller, static_cast<uint8_t>(value));
+        currentTick = tick;
+        lastValue = value;
+    };
+    
+    const size_t numPoints = lane.getNumPoints();
+    for (size_t i = 0; i < numPoints; ++i) {
+        const uint32_t tick = toTick(lane.getPointBeat(i));
+        const float value = lane.getPointValue(i);
+        writeValue(tick, toController(value));
+        
+        if (i + 1 == numPoints || lane.getPointShape(i) == AutomationLane::Shape::Step) {
+            continue;
+        }
+        
+        // Ramps are sampled on a fixed tick grid
+        const uint32_t nextTick = toTick(lane.getPointBeat(i + 1));
+        const float nextValue = lane.getPointValue(i + 1);
+        for (uint32_t t = tick + AUTOMATION_TICKS; t < nextTick; t += AUTOMATION_TICKS) {
+            const float position = static_cast<float>(t - tick) / static_cast<float>(nextTick - tick);
+            writeValue(t, toController(value + position * (nextValue - value)));
+        }
+    }
+}
+
+void MidiFile::patchTrackLength(std::ofstream& file, long trackStartPos) {
+    // Track lengths are big-endian like the rest of the file
+    long currentPos = file.tellp();
+    uint32_t trackLength = currentPos - (trackStartPos + 8);
+    const char bytes[4] = {
+        static_cast<char>((trackLength >> 24) & 0xFF),
+        static_cast<char>((trackLength >> 16) & 0xFF),
+        static_cast<char>((trackLength >> 8) & 0xFF),
+        static_cast<char>(trackLength & 0xFF)
+    };
+    file.seekp(trackStartPos + 4);
+    file.write(bytes, 4);
+    file.seekp(currentPos);
+}
+
 void MidiFile::writeVarLen(std::ofstream& file, uint32_t value) {
     uint8_t buffer[4];
     int bufferIndex = 0;
@@ -1,4 +1,5 @@
 #include "../../include/sequencer/Sequencer.h"
+#include "../../include/audio/TraceRecorder.h"
 #include <algorithm>
 #include <iostream>
 #include <cmath>
@@ -533,6 +534,7 @@ void Sequencer::process(double deltaTime) {
     if (!isPlaying_.load(std::memory_order_acquire)) {
         return;
     }
+    AIMUSIC_TRACE_SCOPE("Sequencer::process");
 
     // Get synchronized timing information
     double currentBeatTime;
@@ -0,0 +1,239 @@
+#include "../../include/sequencer/StemMixer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace AIMusicHardware {
+
+StemMixer::StemMixer(int sampleRate)
+    : sampleRate_(std::max(1, sampleRate)),
+      maxBlockSize_(512) {
+}
+
+StemMixer::~StemMixer() {
+}
+
+int StemMixer::bindLayer(std::shared_ptr<TrackLayer> layer, MultiTimbralEngine* engine, int channel) {
+    if (!layer || !engine || channel < 0 || channel >= 16) {
+        return -1;
+    }
+
+    // Rendering a channel twice per block would advance its voices twice
+    for (const auto& stem : stems_) {
+        if (stem.engine == engine && stem.channel == channel) {
+            return -1;
+        }
+    }
+
+    Stem stem;
+    stem.layer = std::move(layer);
+    stem.engine = engine;
+    stem.channel = channel;
+    stem.gain = stem.layer->isMuted() ? 0.0f : stem.layer->getVolume();
+    stem.target = stem.gain;
+    stem.buffer.assign(static_cast<size_t>(maxBlockSize_) * 2, 0.0f);
+
+    stems_.push_back(std::move(stem));
+    return static_cast<int>(stems_.size()) - 1;
+}
+
+void StemMixer::clear() {
+    stems_.clear();
+    renderedStems_ = 0;
+}
+
+int StemMixer::getStemCount() const {
+    return static_cast<int>(stems_.size());
+}
+
+int StemMixer::findStem(const std::string& layerName) const {
+    for (size_t i = 0; i < stems_.size(); ++i) {
+        if (stems_[i].layer->getName() == layerName) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void StemMixer::prepare(int maxBlockSize) {
+    maxBlockSize_ = std::max(1, maxBlockSize);
+    for (auto& stem : stems_) {
+        stem.buffer.assign(static_cast<size_t>(maxBlockSize_) * 2, 0.0f);
+    }
+}
+
+void StemMixer::setSampleRate(int sampleRate) {
+    sampleRate_ = std::max(1, sampleRate);
+}
+
+int StemMixer::getSampleRate() const {
+    return sampleRate_;
+}
+
+void StemMixer::applySnapshot(const MixSnapshot& snapshot, double rampSeconds, int startOffset) {
+    const bool anySolo = std::any_of(stems_.begin(), stems_.end(), [](const Stem& stem) {
+        return stem.layer->isSolo();
+    });
+
+    for (auto& stem : stems_) {
+        const TrackLayer& layer = *stem.layer;
+        float target = layer.getVolume() * snapshot.getLayerVolume(layer.getName());
+        if (layer.isMuted() || snapshot.isLayerMuted(layer.getName()) || (anySolo && !layer.isSolo())) {
+            target = 0.0f;
+        }
+        scheduleRamp(stem, target, rampSeconds, startOffset);
+    }
+}
+
+void StemMixer::setStemGain(int index, float gain, double rampSeconds, int startOffset) {
+    if (isValidStem(index)) {
+        scheduleRamp(stems_[index], std::max(0.0f, gain), rampSeconds, startOffset);
+    }
+}
+
+void StemMixer::process(float* outputBuffer, int numFrames) {
+    // Blocks larger than prepared are split rather than growing buffers here
+    for (int frame = 0; frame < numFrames; frame += maxBlockSize_) {
+        processChunk(outputBuffer + frame * 2, std::min(maxBlockSize_, numFrames - frame));
+    }
+}
+
+float StemMixer::getStemGain(int index) const {
+    return isValidStem(index) ? stems_[index].gain : 0.0f;
+}
+
+float StemMixer::getStemTargetGain(int index) const {
+    if (!isValidStem(index)) {
+        return 0.0f;
+    }
+    const Stem& stem = stems_[index];
+    return stem.pendingDelay >= 0 ? stem.pendingTarget : stem.target;
+}
+
+bool StemMixer::isStemRamping(int index) const {
+    if (!isValidStem(index)) {
+        return false;
+    }
+    const Stem& stem = stems_[index];
+    return stem.rampPosition < stem.rampLength || stem.pendingDelay >= 0;
+}
+
+const float* StemMixer::getStemBuffer(int index) const {
+    if (isValidStem(index) && stems_[index].rendered) {
+        return stems_[index].buffer.data();
+    }
+    return nullptr;
+}
+
+void StemMixer::scheduleRamp(Stem& stem, float target, double rampSeconds, int startOffset) {
+    const int length = static_cast<int>(std::lround(std::max(0.0, rampSeconds) * sampleRate_));
+
+    if (startOffset <= 0) {
+        stem.pendingDelay = -1;
+        startRamp(stem, target, length);
+        return;
+    }
+
+    // A later snapshot replaces one that has not started yet
+    stem.pendingTarget = target;
+    stem.pendingLength = length;
+    stem.pendingDelay = startOffset;
+}
+
+void StemMixer::startRamp(Stem& stem, float target, int length) {
+    stem.target = target;
+    stem.rampPosition = 0;
+
+    if (length <= 0) {
+        stem.gain = target;
+        stem.rampLength = 0;
+        return;
+    }
+
+    // Gain at ramp sample k (1-based) is rampStart + rampStep * k, so the
+    // last sample lands exactly on the target
+    stem.rampStart = stem.gain;
+    stem.rampStep = (target - stem.gain) / static_cast<float>(length);
+    stem.rampLength = length;
+}
+
+bool StemMixer::isGainSilent(const Stem& stem, int numFrames) const {
+    if (stem.gain != 0.0f || stem.target != 0.0f) {
+        return false;
+    }
+    return stem.pendingDelay < 0 || stem.pendingDelay >= numFrames || stem.pendingTarget == 0.0f;
+}
+
+void StemMixer::applyGain(Stem& stem, float* buffer, int numFrames) {
+    int frame = 0;
+    while (frame < numFrames) {
+        if (stem.pendingDelay == 0) {
+            stem.pendingDelay = -1;
+            startRamp(stem, stem.pendingTarget, stem.pendingLength);
+        }
+
+        // Run up to the next point where the gain law changes
+        int run = numFrames - frame;
+        if (stem.pendingDelay > 0) {
+            run = std::min(run, stem.pendingDelay);
+        }
+        const bool ramping = stem.rampPosition < stem.rampLength;
+        if (ramping) {
+            run = std::min(run, stem.rampLength - stem.rampPosition);
+        }
+
+        if (ramping) {
+            if (buffer) {
+                float* samples = buffer + frame * 2;
+                for (int i = 0; i < run; ++i) {
+                    const float gain = stem.rampStart + stem.rampStep * static_cast<float>(stem.rampPosition + i + 1);
+                    samples[i * 2] *= gain;
+                    samples[i * 2 + 1] *= gain;
+                }
+            }
+            stem.rampPosition += run;
+            stem.gain = stem.rampPosition == stem.rampLength
+                ? stem.target
+                : stem.rampStart + stem.rampStep * static_cast<float>(stem.rampPosition);
+        } else if (buffer && stem.gain != 1.0f) {
+            for (int i = frame * 2; i < (frame + run) * 2; ++i) {
+                buffer[i] *= stem.gain;
+            }
+        }
+
+        if (stem.pendingDelay > 0) {
+            stem.pendingDelay -= run;
+        }
+        frame += run;
+    }
+}
+
+void StemMixer::processChunk(float* outputBuffer, int numFrames) {
+    std::fill(outputBuffer, outputBuffer + numFrames * 2, 0.0f);
+    renderedStems_ = 0;
+
+    for (auto& stem : stems_) {
+        stem.rendered = !isGainSilent(stem, numFrames) &&
+                        stem.engine->renderChannel(stem.channel, stem.buffer.data(), numFrames);
+
+        if (!stem.rendered) {
+            // Keep ramps on schedule even while nothing is rendered
+            applyGain(stem, nullptr, numFrames);
+            continue;
+        }
+
+        applyGain(stem, stem.buffer.data(), numFrames);
+        for (int i = 0; i < numFrames * 2; ++i) {
+            outputBuffer[i] += stem.buffer[i];
+        }
+        ++renderedStems_;
+    }
+
+    totalRenderedStems_ += static_cast<uint64_t>(renderedStems_);
+    totalSkippedStems_ += static_cast<uint64_t>(stems_.size()) - static_cast<uint64_t>(renderedStems_);
+}
+
+bool StemMixer::isValidStem(int index) const {
+    return index >= 0 && index < static_cast<int>(stems_.size());
+}
+
+} // namespace AIMusicHardware
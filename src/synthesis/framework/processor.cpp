@@ -1,4 +1,5 @@
 #include "../../../include/synthesis/framework/processor.h"
+#include "../../../include/audio/TraceRecorder.h"
 
 namespace AIMusicHardware {
 
@@ -35,6 +36,7 @@ void ProcessorRouter::addProcessor(std::unique_ptr<Processor> processor) {
     if (processor) {
         processor->setRouter(this);
         processor->setSampleRate(sampleRate_);
+        traceNames_.push_back(TraceRecorder::getInstance().internName(processor->getName()));
         processors_.push_back(std::move(processor));
     }
 }
@@ -42,6 +44,7 @@ void ProcessorRouter::addProcessor(std::unique_ptr<Processor> processor) {
 void ProcessorRouter::removeProcessor(Processor* processor) {
     for (auto it = processors_.begin(); it != processors_.end(); ++it) {
         if (it->get() == processor) {
+            traceNames_.erase(traceNames_.begin() + (it - processors_.begin()));
             processors_.erase(it);
             return;
         }
@@ -50,6 +53,7 @@ void ProcessorRouter::removeProcessor(Processor* processor) {
 
 void ProcessorRouter::removeProcessor(size_t index) {
     if (index < processors_.size()) {
+        traceNames_.erase(traceNames_.begin() + index);
         processors_.erase(processors_.begin() + index);
     }
 }
@@ -67,6 +71,7 @@ size_t ProcessorRouter::getNumProcessors() const {
 
 void ProcessorRouter::clearProcessors() {
     processors_.clear();
+    traceNames_.clear();
 }
 
 void ProcessorRouter::process(float* buffer, int numFrames) {
@@ -80,8 +85,11 @@ void ProcessorRouter::process(float* buffer, int numFrames) {
     }
     
     // Process each processor in series
-    for (auto& processor : processors_) {
+    for (size_t i = 0; i < processors_.size(); ++i) {
+        Processor* processor = processors_[i].get();
         if (processor->isEnabled()) {
+            AIMUSIC_TRACE_SCOPE(traceNames_[i]);
+
             // Copy input buffer to temp buffer
             std::copy(buffer, buffer + numFrames * 2, tempBuffer_.data());
             
@@ -0,0 +1,283 @@
+#include "../../../include/synthesis/framework/smoothing_engine.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define AIMH_SMOOTH_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define AIMH_SMOOTH_NEON 1
+#endif
+
+namespace AIMusicHardware {
+
+namespace {
+
+inline int lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+} // namespace
+
+SmoothingEngine::SmoothingEngine(int sampleRate, int maxParameters)
+    : sampleRate_(std::max(1, sampleRate)) {
+    // Whole bitmap words, so every group of four is in bounds
+    capacity_ = (std::max(1, maxParameters) + 63) / 64 * 64;
+    const size_t size = static_cast<size_t>(capacity_);
+
+    current_.assign(size, 0.0f);
+    target_.assign(size, 0.0f);
+    blockStart_.assign(size, 0.0f);
+    linearStep_.assign(size, 0.0f);
+    logStep_.assign(size, 0.0f);
+    blockMul_.assign(size, 1.0f);
+    blockAdd_.assign(size, 0.0f);
+    remaining_.assign(size, 0);
+    rampSamples_.assign(size, 0);
+    types_.assign(size, RampType::Linear);
+    groupStamp_.assign(size / 4, 0);
+
+    active_.assign(size / 64, 0);
+    pending_.reset(new std::atomic<uint64_t>[size / 64]);
+    requested_.reset(new std::atomic<float>[size]);
+    for (size_t w = 0; w < size / 64; ++w) {
+        pending_[w].store(0, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < size; ++i) {
+        requested_[i].store(0.0f, std::memory_order_relaxed);
+    }
+}
+
+SmoothingEngine::~SmoothingEngine() {
+}
+
+int SmoothingEngine::addParameter(float initialValue, RampType type, float rampSeconds) {
+    if (count_ >= capacity_) {
+        return -1;
+    }
+
+    const int index = count_++;
+    types_[index] = type;
+    setRampTime(index, rampSeconds);
+    setImmediate(index, initialValue);
+    return index;
+}
+
+void SmoothingEngine::setRampTime(int index, float seconds) {
+    if (index >= 0 && index < count_) {
+        rampSamples_[index] = std::max(1, static_cast<int>(std::lround(std::max(0.0f, seconds) * sampleRate_)));
+    }
+}
+
+void SmoothingEngine::setSampleRate(int sampleRate) {
+    const int rate = std::max(1, sampleRate);
+    for (int i = 0; i < count_; ++i) {
+        const double seconds = static_cast<double>(rampSamples_[i]) / sampleRate_;
+        rampSamples_[i] = std::max(1, static_cast<int>(std::lround(seconds * rate)));
+    }
+    sampleRate_ = rate;
+}
+
+void SmoothingEngine::setTarget(int index, float value) {
+    if (index < 0 || index >= count_) {
+        return;
+    }
+    requested_[index].store(value, std::memory_order_relaxed);
+    pending_[index / 64].fetch_or(uint64_t{1} << (index % 64), std::memory_order_release);
+}
+
+float SmoothingEngine::getTarget(int index) const {
+    if (index < 0 || index >= count_) {
+        return 0.0f;
+    }
+    return requested_[index].load(std::memory_order_relaxed);
+}
+
+void SmoothingEngine::setImmediate(int index, float value) {
+    if (index < 0 || index >= count_) {
+        return;
+    }
+    const uint64_t bit = uint64_t{1} << (index % 64);
+    pending_[index / 64].fetch_and(~bit, std::memory_order_relaxed);
+    active_[index / 64] &= ~bit;
+
+    requested_[index].store(value, std::memory_order_relaxed);
+    current_[index] = value;
+    target_[index] = value;
+    blockStart_[index] = value;
+    remaining_[index] = 0;
+    linearStep_[index] = 0.0f;
+    logStep_[index] = 0.0f;
+    blockMul_[index] = 1.0f;
+    blockAdd_[index] = 0.0f;
+}
+
+void SmoothingEngine::process(int numFrames) {
+    if (numFrames <= 0) {
+        return;
+    }
+    ++blockCounter_;
+    const int words = capacity_ / 64;
+
+    if (numFrames != blockSize_) {
+        blockSize_ = numFrames;
+        for (int w = 0; w < words; ++w) {
+            for (uint64_t bits = active_[w]; bits; bits &= bits - 1) {
+                updateBlockFactors(w * 64 + lowestBit(bits));
+            }
+        }
+    }
+
+    // Ramps requested since the last block start from the current value
+    for (int w = 0; w < words; ++w) {
+        uint64_t bits = pending_[w].exchange(0, std::memory_order_acquire);
+        for (; bits; bits &= bits - 1) {
+            const int index = w * 64 + lowestBit(bits);
+            startRamp(index, requested_[index].load(std::memory_order_relaxed));
+        }
+    }
+
+    for (int w = 0; w < words; ++w) {
+        uint64_t groups = active_[w];
+        while (groups) {
+            const int shift = lowestBit(groups) & ~3;
+            const int base = w * 64 + shift;
+            const int finished = processGroup(base, numFrames);
+            groupStamp_[base / 4] = blockCounter_;
+            active_[w] &= ~(static_cast<uint64_t>(finished) << shift);
+            groups &= ~(uint64_t{0xF} << shift);
+        }
+    }
+}
+
+int SmoothingEngine::processGroup(int base, int numFrames) {
+    float* current = current_.data() + base;
+    const float* target = target_.data() + base;
+    int32_t* remaining = remaining_.data() + base;
+
+    // Parameters that are not moving have remaining 0 and current == target,
+    // so they pass through unchanged
+#if AIMH_SMOOTH_SSE2
+    const __m128 value = _mm_loadu_ps(current);
+    _mm_storeu_ps(blockStart_.data() + base, value);
+    __m128 next = _mm_add_ps(_mm_mul_ps(value, _mm_loadu_ps(blockMul_.data() + base)),
+                             _mm_loadu_ps(blockAdd_.data() + base));
+
+    const __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(remaining));
+    const __m128i done = _mm_cmplt_epi32(left, _mm_set1_epi32(numFrames + 1));
+    const __m128 doneMask = _mm_castsi128_ps(done);
+    next = _mm_or_ps(_mm_and_ps(doneMask, _mm_loadu_ps(target)), _mm_andnot_ps(doneMask, next));
+
+    _mm_storeu_ps(current, next);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(remaining),
+                     _mm_andnot_si128(done, _mm_sub_epi32(left, _mm_set1_epi32(numFrames))));
+    return _mm_movemask_ps(doneMask);
+#elif AIMH_SMOOTH_NEON
+    const float32x4_t value = vld1q_f32(current);
+    vst1q_f32(blockStart_.data() + base, value);
+    float32x4_t next = vmlaq_f32(vld1q_f32(blockAdd_.data() + base), value, vld1q_f32(blockMul_.data() + base));
+
+    const int32x4_t left = vld1q_s32(remaining);
+    const uint32x4_t done = vcleq_s32(left, vdupq_n_s32(numFrames));
+    next = vbslq_f32(done, vld1q_f32(target), next);
+
+    vst1q_f32(current, next);
+    vst1q_s32(remaining, vbicq_s32(vsubq_s32(left, vdupq_n_s32(numFrames)), vreinterpretq_s32_u32(done)));
+
+    const uint32x4_t bits = vandq_u32(done, (uint32x4_t){1, 2, 4, 8});
+    return static_cast<int>(vaddvq_u32(bits));
+#else
+    int finished = 0;
+    for (int lane = 0; lane < 4; ++lane) {
+        blockStart_[base + lane] = current[lane];
+        if (remaining[lane] <= numFrames) {
+            current[lane] = target[lane];
+            remaining[lane] = 0;
+            finished |= 1 << lane;
+        } else {
+            current[lane] = current[lane] * blockMul_[base + lane] + blockAdd_[base + lane];
+            remaining[lane] -= numFrames;
+        }
+    }
+    return finished;
+#endif
+}
+
+float SmoothingEngine::getBlockStartValue(int index) const {
+    // Groups not advanced in the last block have not moved
+    if (groupStamp_[static_cast<size_t>(index / 4)] != blockCounter_) {
+        return current_[static_cast<size_t>(index)];
+    }
+    return blockStart_[static_cast<size_t>(index)];
+}
+
+bool SmoothingEngine::isSmoothing(int index) const {
+    if (index < 0 || index >= count_) {
+        return false;
+    }
+    const uint64_t bit = uint64_t{1} << (index % 64);
+    return (active_[index / 64] & bit) || (pending_[index / 64].load(std::memory_order_relaxed) & bit);
+}
+
+int SmoothingEngine::getActiveCount() const {
+    int active = 0;
+    for (uint64_t word : active_) {
+        for (; word; word &= word - 1) {
+            ++active;
+        }
+    }
+    return active;
+}
+
+void SmoothingEngine::fillRamp(int index, float* output, int numFrames) const {
+    const float start = getBlockStartValue(index);
+    const float end = getValue(index);
+    if (start == end || numFrames <= 0) {
+        std::fill(output, output + std::max(0, numFrames), end);
+        return;
+    }
+    const float step = (end - start) / static_cast<float>(numFrames);
+    for (int i = 0; i < numFrames; ++i) {
+        output[i] = start + step * static_cast<float>(i + 1);
+    }
+}
+
+void SmoothingEngine::startRamp(int index, float target) {
+    const float from = current_[index];
+    const uint64_t bit = uint64_t{1} << (index % 64);
+    if (target == from) {
+        // Already there; a ramp in progress stops where it is
+        target_[index] = target;
+        remaining_[index] = 0;
+        active_[index / 64] &= ~bit;
+        return;
+    }
+
+    const int samples = rampSamples_[index];
+    const bool exponential = types_[index] == RampType::Exponential && from * target > 0.0f;
+
+    target_[index] = target;
+    remaining_[index] = samples;
+    linearStep_[index] = exponential ? 0.0f : (target - from) / static_cast<float>(samples);
+    logStep_[index] = exponential ? static_cast<float>(std::log(static_cast<double>(target) / from) / samples) : 0.0f;
+    active_[index / 64] |= bit;
+    updateBlockFactors(index);
+}
+
+void SmoothingEngine::updateBlockFactors(int index) {
+    const float frames = static_cast<float>(blockSize_);
+    blockMul_[index] = logStep_[index] != 0.0f ? std::exp(logStep_[index] * frames) : 1.0f;
+    blockAdd_[index] = linearStep_[index] * frames;
+}
+
+} // namespace AIMusicHardware
@@ -1,4 +1,5 @@
 #include "../../../include/synthesis/modulators/modulation_matrix.h"
+#include "../../../include/audio/TraceRecorder.h"
 
 namespace AIMusicHardware {
 
@@ -148,6 +149,8 @@ void ModulationMatrix::disconnect(const std::string& sourceName,
 }
 
 void ModulationMatrix::update() {
+    AIMUSIC_TRACE_SCOPE("ModulationMatrix::update");
+
     // First update all sources
     for (auto& source : sources_) {
         source->update();
@@ -1,4 +1,5 @@
 #include "../../../include/synthesis/multitimbral/MultiTimbralEngine.h"
+#include "../../../include/audio/TraceRecorder.h"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
@@ -464,6 +465,21 @@ void MultiTimbralEngine::process(float* outputBuffer, int numFrames) {
     }
 }
 
+bool MultiTimbralEngine::isChannelSounding(int channel) const {
+    return isValidChannel(channel) && channelActive_[channel] && channelSynths_[channel] &&
+           channelSynths_[channel]->isEnabled() && channelSynths_[channel]->getActiveVoiceCount() > 0;
+}
+
+bool MultiTimbralEngine::renderChannel(int channel, float* buffer, int numFrames) {
+    if (!isChannelSounding(channel)) {
+        return false;
+    }
+    
+    // Synthesizer::process clears the buffer before mixing voices into it
+    channelSynths_[channel]->process(buffer, numFrames);
+    return true;
+}
+
 void MultiTimbralEngine::setSampleRate(int sampleRate) {
     if (sampleRate_ != sampleRate) {
         sampleRate_ = sampleRate;
@@ -593,6 +609,8 @@ void MultiTimbralEngine::applyPanning(float* buffer, int numFrames, float pan) {
 }
 
 void MultiTimbralEngine::mixChannels(float* outputBuffer, int numFrames) {
+    AIMUSIC_TRACE_SCOPE("MultiTimbralEngine::mixChannels");
+
     // Ensure mix buffer is large enough
     if (mixBuffer_.size() < static_cast<size_t>(numFrames * 2)) {
         mixBuffer_.resize(numFrames * 2, 0.0f);
@@ -1,4 +1,5 @@
 #include "../../../include/synthesis/voice/MpeAwareVoiceManager.h"
+#include "../../../include/synthesis/wavetable/wavetable.h"
 #include <algorithm>
 #include <cmath>
 
@@ -10,14 +11,21 @@ MpeAwareVoiceManager::MpeAwareVoiceManager(int sampleRate, int maxVoices, const
       lowerZonePitchBendRange_(48.0f),
       upperZonePitchBendRange_(48.0f) {
 
-    // We'll rely on the base class to create voices, but we'll override createVoice()
-    // to ensure they're MPE voices
+    // The base constructor runs before our createVoice() override is in place,
+    // so replace its voices with MPE voices here
     setMaxVoices(maxVoices);
+    for (auto& voice : voices_) {
+        voice = createVoice();
+    }
+
+    auto wavetable = std::make_shared<Wavetable>();
+    wavetable->initBasicWaveforms();
+    setWavetable(wavetable);
 }
 
 MpeAwareVoiceManager::~MpeAwareVoiceManager() {
     // Clean up any channel-to-voice mappings
-    channelToVoiceMap_.clear();
+    channelVoices_.fill(nullptr);
 }
 
 void MpeAwareVoiceManager::noteOnWithExpression(int midiNote, float velocity, int channel,
@@ -44,15 +52,13 @@ void MpeAwareVoiceManager::noteOnWithExpression(int midiNote, float velocity, in
         return;  // Not an MPE voice
     }
 
-    // Add to channel map for quick lookups
-    channelToVoiceMap_[channel] = mpeVoice;
+    // Add to channel slots for quick lookups
+    if (channel >= 0 && channel < kChannelSlots) {
+        channelVoices_[channel] = mpeVoice;
+    }
 
     // Apply all expression parameters
-    float pitchBendSemitones = pitchBend * (isLowerZoneChannel(channel) ?
-                                            lowerZonePitchBendRange_ :
-                                            upperZonePitchBendRange_);
-
-    mpeVoice->updateExpression(pitchBendSemitones, timbre, pressure);
+    mpeVoice->updateExpression(pitchBendToSemitones(channel, pitchBend), timbre, pressure);
 }
 
 void MpeAwareVoiceManager::noteOn(int midiNote, float velocity, int channel) {
@@ -71,26 +77,19 @@ void MpeAwareVoiceManager::noteOff(int midiNote, int channel) {
     // Call standard noteOff
     VoiceManager::noteOff(midiNote, channel);
 
-    // If this was an MPE channel, remove it from our channel map
-    if (isMemberChannel(channel)) {
-        channelToVoiceMap_.erase(channel);
+    // If this was an MPE channel, remove it from our channel slots
+    if (isMemberChannel(channel) && channel >= 0 && channel < kChannelSlots) {
+        channelVoices_[channel] = nullptr;
     }
 }
 
 void MpeAwareVoiceManager::updateNotePitchBend(int channel, float pitchBend) {
     std::lock_guard<std::mutex> lock(mpeMutex_);
 
-    // Convert normalized pitch bend (-1.0 to 1.0) to semitones based on zone
-    float pitchBendRange = isLowerZoneChannel(channel) ?
-                          lowerZonePitchBendRange_ :
-                          upperZonePitchBendRange_;
-
-    float pitchBendSemitones = pitchBend * pitchBendRange;
-
     // Find the voice for this channel
     MpeVoice* voice = findVoiceByChannel(channel);
     if (voice) {
-        voice->setPitchBend(pitchBendSemitones);
+        voice->setPitchBend(pitchBendToSemitones(channel, pitchBend));
     }
 }
 
@@ -120,16 +119,78 @@ void MpeAwareVoiceManager::updateNoteExpression(int channel, float pitchBend, fl
     // Find the voice for this channel
     MpeVoice* voice = findVoiceByChannel(channel);
     if (voice) {
-        // Convert normalized pitch bend to semitones based on zone
-        float pitchBendRange = isLowerZoneChannel(channel) ?
-                              lowerZonePitchBendRange_ :
-                              upperZonePitchBendRange_;
+        // Update all expression parameters at once
+        voice->updateExpression(pitchBendToSemitones(channel, pitchBend), timbre, pressure);
+    }
+}
 
-        float pitchBendSemitones = pitchBend * pitchBendRange;
+bool MpeAwareVoiceManager::queueNoteExpression(int channel, ExpressionDimension dimension, float value) {
+    if (channel < 0 || channel >= kChannelSlots) {
+        return false;
+    }
 
-        // Update all expression parameters at once
-        voice->updateExpression(pitchBendSemitones, timbre, pressure);
+    const size_t write = expressionWrite_.load(std::memory_order_relaxed);
+    if (write - expressionRead_.load(std::memory_order_acquire) >= kExpressionQueueSize) {
+        return false;  // Queue full
     }
+
+    QueuedExpression& entry = expressionQueue_[write & (kExpressionQueueSize - 1)];
+    entry.channel = static_cast<uint8_t>(channel);
+    entry.dimension = static_cast<uint8_t>(dimension);
+    entry.value = value;
+    expressionWrite_.store(write + 1, std::memory_order_release);
+    return true;
+}
+
+int MpeAwareVoiceManager::applyQueuedExpression() {
+    const size_t write = expressionWrite_.load(std::memory_order_acquire);
+    size_t read = expressionRead_.load(std::memory_order_relaxed);
+    if (read == write) {
+        return 0;
+    }
+
+    // Keep only the latest value per channel and dimension
+    for (; read != write; ++read) {
+        const QueuedExpression& entry = expressionQueue_[read & (kExpressionQueueSize - 1)];
+        pendingExpression_[entry.channel][entry.dimension] = entry.value;
+        pendingMask_[entry.channel] |= static_cast<uint8_t>(1u << entry.dimension);
+    }
+    expressionRead_.store(read, std::memory_order_release);
+
+    int applied = 0;
+    for (int channel = 0; channel < kChannelSlots; ++channel) {
+        const uint8_t mask = pendingMask_[channel];
+        if (mask == 0) {
+            continue;
+        }
+        pendingMask_[channel] = 0;
+
+        MpeVoice* voice = findVoiceByChannel(channel);
+        if (!voice) {
+            continue;  // Note ended before the update was applied
+        }
+
+        const auto& values = pendingExpression_[channel];
+        if (mask & (1u << static_cast<int>(ExpressionDimension::PitchBend))) {
+            voice->setPitchBend(pitchBendToSemitones(channel,
+                values[static_cast<int>(ExpressionDimension::PitchBend)]));
+            ++applied;
+        }
+        if (mask & (1u << static_cast<int>(ExpressionDimension::Timbre))) {
+            voice->setTimbre(values[static_cast<int>(ExpressionDimension::Timbre)]);
+            ++applied;
+        }
+        if (mask & (1u << static_cast<int>(ExpressionDimension::Pressure))) {
+            voice->setPressure(values[static_cast<int>(ExpressionDimension::Pressure)]);
+            ++applied;
+        }
+    }
+    return applied;
+}
+
+void MpeAwareVoiceManager::process(float* buffer, int numFrames) {
+    applyQueuedExpression();
+    VoiceManager::process(buffer, numFrames);
 }
 
 void MpeAwareVoiceManager::setMpeConfiguration(const MpeConfiguration& mpeConfig) {
@@ -177,8 +238,24 @@ Voice* MpeAwareVoiceManager::findVoiceForMpeNote(int midiNote, int channel) {
 }
 
 MpeVoice* MpeAwareVoiceManager::findVoiceByChannel(int channel) {
-    auto it = channelToVoiceMap_.find(channel);
-    return (it != channelToVoiceMap_.end()) ? it->second : nullptr;
+    if (channel < 0 || channel >= kChannelSlots) {
+        return nullptr;
+    }
+
+    // The slot may be stale if the voice was stolen or finished its release
+    MpeVoice* voice = channelVoices_[channel];
+    if (voice && voice->isActive() && voice->getChannel() == channel) {
+        return voice;
+    }
+    return nullptr;
+}
+
+float MpeAwareVoiceManager::pitchBendToSemitones(int channel, float pitchBend) const {
+    // Convert normalized pitch bend (-1.0 to 1.0) to semitones based on zone
+    float pitchBendRange = isLowerZoneChannel(channel) ?
+                          lowerZonePitchBendRange_ :
+                          upperZonePitchBendRange_;
+    return pitchBend * pitchBendRange;
 }
 
 bool MpeAwareVoiceManager::isMasterChannel(int channel) const {
@@ -189,6 +189,15 @@ void StackedVoice::setSampleRate(int sampleRate) {
     oscillatorStack_->setSampleRate(sampleRate);
 }
 
+void StackedVoice::setRenderQuality(const RenderQuality& quality) {
+    // Call the base class implementation
+    Voice::setRenderQuality(quality);
+
+    // Update the oscillator stack
+    oscillatorStack_->setOversampling(quality.oversampling);
+    oscillatorStack_->setUnisonLimit(quality.maxUnison);
+}
+
 void StackedVoice::updateFrequency() {
     // Access the protected frequency_ member from Voice and set it in the oscillator stack
     oscillatorStack_->setFrequency(frequency_);
@@ -10,6 +10,9 @@ StackedVoiceManager::StackedVoiceManager(int sampleRate, int maxVoices, int osci
     , detuneSpread_(10.0f)
     , stereoWidth_(0.5f)
     , convergence_(0.0f) {
+    // The base constructor cannot call our createVoice(); replace its voices
+    voices_.clear();
+    setMaxVoices(maxVoices);
 }
 
 StackedVoiceManager::~StackedVoiceManager() {
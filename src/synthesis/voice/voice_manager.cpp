@@ -1,9 +1,9 @@
 #include "../../../include/synthesis/voice/voice_manager.h"
 #include "../../../include/synthesis/wavetable/wavetable.h"
 #include "../../../include/synthesis/modulators/envelope.h"
+#include "../../../include/audio/TraceRecorder.h"
 #include <algorithm>
 #include <cmath>
-#include <random>
 
 namespace AIMusicHardware {
 
@@ -129,6 +129,10 @@ void Voice::setSampleRate(int sampleRate) {
     envelope_->setSampleRate(sampleRate);
 }
 
+void Voice::setRenderQuality(const RenderQuality& quality) {
+    oscillator_->setOversampling(quality.oversampling);
+}
+
 void Voice::setPitchBend(float semitones) {
     pitchBendSemitones_ = semitones;
     
@@ -157,6 +161,7 @@ VoiceManager::VoiceManager(int sampleRate, int maxVoices)
     for (int i = 0; i < maxVoices_; ++i) {
         voices_.push_back(createVoice());
     }
+    rebuildVoiceTables();
     
     // Create a default wavetable
     currentWavetable_ = std::make_shared<Wavetable>();
@@ -166,44 +171,40 @@ VoiceManager::VoiceManager(int sampleRate, int maxVoices)
     for (auto& voice : voices_) {
         voice->setWavetable(currentWavetable_);
     }
-    
-    // Initialize default channel state for channel 0
-    channelStates_[0] = ChannelState{};
 }
 
 VoiceManager::~VoiceManager() {
 }
 
 void VoiceManager::noteOn(int midiNote, float velocity, int channel) {
-    // Ensure we have a channel state for this channel
-    if (channelStates_.find(channel) == channelStates_.end()) {
-        channelStates_[channel] = ChannelState{};
+    if (!isValidKey(midiNote, channel)) {
+        return;
     }
     
-    // Create a unique key for this note and channel
-    int noteKey = (channel << 16) | midiNote;
-    
     // Check if this note is already playing
-    Voice* voice = findVoiceForNote(midiNote, channel);
-    
-    // If not playing, find an unused voice or steal one
-    if (!voice) {
-        // First look for an inactive voice
-        for (auto& v : voices_) {
-            if (!v->isActive()) {
-                voice = v.get();
+    int index = findVoiceIndexForNote(midiNote, channel);
+    
+    // If not playing, take the least recently used free voice or steal one
+    if (index < 0) {
+        for (int i = lruHead_; i >= 0; i = lruNext_[i]) {
+            if (!voices_[i]->isActive()) {
+                index = i;
                 break;
             }
         }
         
-        // If all voices are in use, use voice stealing
-        if (!voice) {
-            voice = findVoiceToSteal();
+        // If all voices are in use, steal a fading voice when under load, then by policy
+        if (index < 0 && renderQuality_.releaseCutoff > 0.0f) {
+            index = findReleasedVoiceToSteal();
+        }
+        if (index < 0) {
+            index = findVoiceToSteal();
         }
     }
     
     // Trigger the voice with this note
-    if (voice) {
+    if (index >= 0) {
+        Voice* voice = voices_[index].get();
         voice->setChannel(channel);
         voice->noteOn(midiNote, velocity);
         
@@ -211,26 +212,25 @@ void VoiceManager::noteOn(int midiNote, float velocity, int channel) {
         float pitchBendSemitones = channelStates_[channel].pitchBendValue * pitchBendRange_;
         voice->setPitchBend(pitchBendSemitones);
         
-        activeNotes_[noteKey] = voice;
+        noteVoices_[channel][midiNote] = static_cast<int16_t>(index);
+        channelStates_[channel].sustainedNotes.reset(midiNote);
+        touchVoice(index);
     }
 }
 
 void VoiceManager::noteOff(int midiNote, int channel) {
-    // Create a unique key for this note and channel
-    int noteKey = (channel << 16) | midiNote;
-    
     // Find the voice playing this note on this channel
-    auto it = activeNotes_.find(noteKey);
-    if (it != activeNotes_.end()) {
-        // Check for sustain pedal
-        if (channelStates_[channel].sustainPedalDown) {
-            // If sustain is active, mark the note as sustained but don't release it
-            channelStates_[channel].sustainedNotes[midiNote] = true;
-        } else {
-            // Otherwise, release the note normally
-            it->second->noteOff();
-            activeNotes_.erase(it);
-        }
+    if (findVoiceIndexForNote(midiNote, channel) < 0) {
+        return;
+    }
+    
+    // Check for sustain pedal
+    if (channelStates_[channel].sustainPedalDown) {
+        // If sustain is active, mark the note as sustained but don't release it
+        channelStates_[channel].sustainedNotes.set(midiNote);
+    } else {
+        // Otherwise, release the note normally
+        releaseNote(midiNote, channel);
     }
 }
 
@@ -240,39 +240,37 @@ void VoiceManager::allNotesOff(int channel) {
         for (auto& voice : voices_) {
             voice->noteOff();
         }
-        activeNotes_.clear();
         
-        // Clear all sustained notes too
-        for (auto& channelState : channelStates_) {
-            channelState.second.sustainedNotes.clear();
+        for (int ch = 0; ch < kMaxChannels; ++ch) {
+            noteVoices_[ch].fill(kNoVoice);
+            channelStates_[ch].sustainedNotes.reset();
         }
-    } else {
+    } else if (channel < kMaxChannels) {
         // Turn off notes for a specific channel only
-        
-        // First collect keys to remove to avoid modifying during iteration
-        std::vector<int> keysToRemove;
-        
-        for (auto& pair : activeNotes_) {
-            int noteChannel = pair.first >> 16;
-            if (noteChannel == channel) {
-                pair.second->noteOff();
-                keysToRemove.push_back(pair.first);
+        for (int note = 0; note < kNumNotes; ++note) {
+            if (noteVoices_[channel][note] != kNoVoice) {
+                releaseNote(note, channel);
             }
         }
         
-        // Now remove the notes
-        for (int key : keysToRemove) {
-            activeNotes_.erase(key);
-        }
-        
         // Clear sustained notes for this channel
-        if (channelStates_.find(channel) != channelStates_.end()) {
-            channelStates_[channel].sustainedNotes.clear();
+        channelStates_[channel].sustainedNotes.reset();
+    }
+}
+
+int VoiceManager::getActiveVoiceCount() const {
+    int count = 0;
+    for (const auto& voice : voices_) {
+        if (voice->isActive()) {
+            ++count;
         }
     }
+    return count;
 }
 
 void VoiceManager::process(float* buffer, int numFrames) {
+    AIMUSIC_TRACE_SCOPE("VoiceManager::process");
+
     // Clear output buffer
     std::fill(buffer, buffer + numFrames * 2, 0.0f);
     
@@ -281,6 +279,10 @@ void VoiceManager::process(float* buffer, int numFrames) {
     
     // Process each voice
     for (auto& voice : voices_) {
+        // Under load, cut release tails once they are quiet
+        if (voice->isReleased() && voice->getCurrentAmplitude() < renderQuality_.releaseCutoff) {
+            voice->reset();
+        }
         if (voice->isActive()) {
             activeVoiceCount++;
             voice->process(buffer, numFrames);
@@ -295,14 +297,8 @@ void VoiceManager::process(float* buffer, int numFrames) {
         }
     }
     
-    // Clean up voices that have finished their release phase
-    for (auto it = activeNotes_.begin(); it != activeNotes_.end();) {
-        if (it->second->getState() == Voice::State::Finished) {
-            it = activeNotes_.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    // Finished voices leave stale note table entries; findVoiceIndexForNote()
+    // rejects them, so there is nothing to clean up here
 }
 
 void VoiceManager::setMaxVoices(int maxVoices) {
@@ -311,6 +307,8 @@ void VoiceManager::setMaxVoices(int maxVoices) {
     // Add voices if needed
     while (static_cast<int>(voices_.size()) < maxVoices_) {
         voices_.push_back(createVoice());
+        voices_.back()->setWavetable(currentWavetable_);
+        voices_.back()->setRenderQuality(renderQuality_);
     }
     
     // Or remove excess voices
@@ -328,6 +326,9 @@ void VoiceManager::setMaxVoices(int maxVoices) {
             voices_.pop_back();
         }
     }
+    
+    // Voice indices may have shifted
+    rebuildVoiceTables();
 }
 
 void VoiceManager::setSampleRate(int sampleRate) {
@@ -350,93 +351,198 @@ void VoiceManager::setWavetable(std::shared_ptr<Wavetable> wavetable) {
     }
 }
 
-Voice* VoiceManager::findVoiceToSteal() {
+void VoiceManager::setRenderQuality(const RenderQuality& quality) {
+    renderQuality_ = quality;
+    
+    // Update all voices
+    for (auto& voice : voices_) {
+        voice->setRenderQuality(quality);
+    }
+}
+
+int VoiceManager::findReleasedVoiceToSteal() const {
+    int quietest = -1;
+    float lowestAmp = 2.0f; // Higher than max amplitude (1.0)
+    
+    for (int i = 0; i < static_cast<int>(voices_.size()); ++i) {
+        const Voice& voice = *voices_[i];
+        if (voice.isReleased() && voice.getCurrentAmplitude() < lowestAmp) {
+            lowestAmp = voice.getCurrentAmplitude();
+            quietest = i;
+        }
+    }
+    return quietest;
+}
+
+int VoiceManager::findVoiceToSteal() {
+    if (voices_.empty()) {
+        return -1;
+    }
+    
     switch (stealMode_) {
         case StealMode::Oldest: {
-            // Find the oldest voice that's not in release
-            Voice* oldestVoice = nullptr;
-            int oldestAge = -1;
-            
-            for (auto& voice : voices_) {
-                if (voice->isActive() && !voice->isReleased() && voice->getAge() > oldestAge) {
-                    oldestAge = voice->getAge();
-                    oldestVoice = voice.get();
+            // The first active, non-released voice in note on order is the oldest
+            for (int i = lruHead_; i >= 0; i = lruNext_[i]) {
+                if (voices_[i]->isActive() && !voices_[i]->isReleased()) {
+                    return i;
                 }
             }
             
-            // If no active non-released voice found, use any voice
-            if (!oldestVoice && !voices_.empty()) {
-                oldestVoice = voices_[0].get();
-            }
-            
-            return oldestVoice;
+            // If no active non-released voice found, use the least recently started one
+            return lruHead_;
         }
         
         case StealMode::Quietest: {
             // Find the quietest voice that's not in release
-            Voice* quietestVoice = nullptr;
+            int quietest = -1;
             float lowestAmp = 2.0f; // Higher than max amplitude (1.0)
             
-            for (auto& voice : voices_) {
-                if (voice->isActive() && !voice->isReleased()) {
-                    float amp = voice->getCurrentAmplitude();
+            for (int i = 0; i < static_cast<int>(voices_.size()); ++i) {
+                const Voice& voice = *voices_[i];
+                if (voice.isActive() && !voice.isReleased()) {
+                    float amp = voice.getCurrentAmplitude();
                     if (amp < lowestAmp) {
                         lowestAmp = amp;
-                        quietestVoice = voice.get();
+                        quietest = i;
                     }
                 }
             }
             
             // If no active non-released voice found, use any voice
-            if (!quietestVoice && !voices_.empty()) {
-                quietestVoice = voices_[0].get();
-            }
-            
-            return quietestVoice;
+            return quietest >= 0 ? quietest : 0;
         }
         
         case StealMode::Random: {
-            // Choose a random voice that's not in release
-            std::vector<Voice*> candidates;
+            // Choose uniformly among voices not in release (reservoir sampling)
+            int chosen = -1;
+            uint32_t candidates = 0;
             
-            for (auto& voice : voices_) {
-                if (voice->isActive() && !voice->isReleased()) {
-                    candidates.push_back(voice.get());
+            for (int i = 0; i < static_cast<int>(voices_.size()); ++i) {
+                if (voices_[i]->isActive() && !voices_[i]->isReleased()) {
+                    ++candidates;
+                    if (nextRandom() % candidates == 0) {
+                        chosen = i;
+                    }
                 }
             }
             
-            if (!candidates.empty()) {
-                std::random_device rd;
-                std::mt19937 gen(rd());
-                std::uniform_int_distribution<> dist(0, static_cast<int>(candidates.size()) - 1);
-                return candidates[dist(gen)];
-            }
-            
             // If no candidates, use the first voice
-            if (!voices_.empty()) {
-                return voices_[0].get();
-            }
-            
-            return nullptr;
+            return chosen >= 0 ? chosen : 0;
         }
         
         default:
-            return !voices_.empty() ? voices_[0].get() : nullptr;
+            return 0;
     }
 }
 
 Voice* VoiceManager::findVoiceForNote(int midiNote, int channel) {
-    // Create a unique key for this note and channel
-    int noteKey = (channel << 16) | midiNote;
+    int index = findVoiceIndexForNote(midiNote, channel);
+    return index >= 0 ? voices_[index].get() : nullptr;
+}
+
+int VoiceManager::findVoiceIndexForNote(int midiNote, int channel) const {
+    if (!isValidKey(midiNote, channel)) {
+        return -1;
+    }
+    
+    int index = noteVoices_[channel][midiNote];
+    if (index < 0 || index >= static_cast<int>(voices_.size())) {
+        return -1;
+    }
     
-    auto it = activeNotes_.find(noteKey);
-    return (it != activeNotes_.end()) ? it->second : nullptr;
+    // The voice may have finished or been stolen for another note since
+    const Voice& voice = *voices_[index];
+    if (voice.isActive() && !voice.isReleased() &&
+        voice.getMidiNote() == midiNote && voice.getChannel() == channel) {
+        return index;
+    }
+    return -1;
+}
+
+void VoiceManager::releaseNote(int midiNote, int channel) {
+    int index = findVoiceIndexForNote(midiNote, channel);
+    if (index >= 0) {
+        voices_[index]->noteOff();
+    }
+    noteVoices_[channel][midiNote] = kNoVoice;
+}
+
+void VoiceManager::touchVoice(int index) {
+    if (index == lruTail_) {
+        return;
+    }
+    
+    // Unlink
+    int before = lruPrev_[index];
+    int after = lruNext_[index];
+    if (before >= 0) {
+        lruNext_[before] = static_cast<int16_t>(after);
+    } else {
+        lruHead_ = after;
+    }
+    if (after >= 0) {
+        lruPrev_[after] = static_cast<int16_t>(before);
+    }
+    
+    // Append at the most recent end
+    lruPrev_[index] = static_cast<int16_t>(lruTail_);
+    lruNext_[index] = kNoVoice;
+    if (lruTail_ >= 0) {
+        lruNext_[lruTail_] = static_cast<int16_t>(index);
+    }
+    lruTail_ = index;
+}
+
+void VoiceManager::rebuildVoiceTables() {
+    const int count = static_cast<int>(voices_.size());
+    
+    // Start in voice order, oldest (by age) first
+    std::vector<int16_t> order(count);
+    for (int i = 0; i < count; ++i) {
+        order[i] = static_cast<int16_t>(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [this](int16_t a, int16_t b) {
+        return voices_[a]->getAge() > voices_[b]->getAge();
+    });
+    
+    lruPrev_.assign(count, kNoVoice);
+    lruNext_.assign(count, kNoVoice);
+    lruHead_ = kNoVoice;
+    lruTail_ = kNoVoice;
+    for (int i = 0; i < count; ++i) {
+        int index = order[i];
+        lruPrev_[index] = static_cast<int16_t>(lruTail_);
+        if (lruTail_ >= 0) {
+            lruNext_[lruTail_] = static_cast<int16_t>(index);
+        } else {
+            lruHead_ = index;
+        }
+        lruTail_ = index;
+    }
+    
+    // Re-point held notes at their (possibly moved) voices
+    for (auto& row : noteVoices_) {
+        row.fill(kNoVoice);
+    }
+    for (int i = 0; i < count; ++i) {
+        const Voice& voice = *voices_[i];
+        if (voice.isActive() && !voice.isReleased() && isValidKey(voice.getMidiNote(), voice.getChannel())) {
+            noteVoices_[voice.getChannel()][voice.getMidiNote()] = static_cast<int16_t>(i);
+        }
+    }
+}
+
+uint32_t VoiceManager::nextRandom() {
+    // xorshift32
+    randomState_ ^= randomState_ << 13;
+    randomState_ ^= randomState_ >> 17;
+    randomState_ ^= randomState_ << 5;
+    return randomState_;
 }
 
 void VoiceManager::sustainOn(int channel) {
-    // Ensure we have a channel state for this channel
-    if (channelStates_.find(channel) == channelStates_.end()) {
-        channelStates_[channel] = ChannelState{};
+    if (channel < 0 || channel >= kMaxChannels) {
+        return;
     }
     
     // Activate sustain pedal
@@ -444,118 +550,107 @@ void VoiceManager::sustainOn(int channel) {
 }
 
 void VoiceManager::sustainOff(int channel) {
-    // Ensure we have a channel state for this channel
-    if (channelStates_.find(channel) == channelStates_.end()) {
-        return; // No active channel state
+    if (channel < 0 || channel >= kMaxChannels) {
+        return;
     }
     
     // Deactivate sustain pedal
-    channelStates_[channel].sustainPedalDown = false;
-    
-    // Release all sustained notes
-    auto& sustainedNotes = channelStates_[channel].sustainedNotes;
-    
-    // Process all sustained notes for this channel
-    for (auto& notePair : sustainedNotes) {
-        int midiNote = notePair.first;
-        int noteKey = (channel << 16) | midiNote;
-        
-        // Find and release the voice
-        auto it = activeNotes_.find(noteKey);
-        if (it != activeNotes_.end()) {
-            it->second->noteOff();
-            activeNotes_.erase(it);
+    ChannelState& state = channelStates_[channel];
+    state.sustainPedalDown = false;
+    
+    // Release all sustained notes for this channel
+    if (state.sustainedNotes.any()) {
+        for (int note = 0; note < kNumNotes; ++note) {
+            if (state.sustainedNotes.test(note)) {
+                releaseNote(note, channel);
+            }
         }
     }
     
     // Clear the sustained notes list
-    sustainedNotes.clear();
+    state.sustainedNotes.reset();
 }
 
 void VoiceManager::setPitchBend(float value, int channel) {
+    if (channel < 0 || channel >= kMaxChannels) {
+        return;
+    }
+    
     // Normalize value to range -1.0 to 1.0
     float normalizedValue = std::clamp(value, -1.0f, 1.0f);
     
-    // Ensure we have a channel state for this channel
-    if (channelStates_.find(channel) == channelStates_.end()) {
-        channelStates_[channel] = ChannelState{};
-    }
-    
     // Store pitch bend value
     channelStates_[channel].pitchBendValue = normalizedValue;
     
     // Calculate bend in semitones
     float semitones = normalizedValue * pitchBendRange_;
     
-    // Apply to all active voices for this channel
-    for (auto& pair : activeNotes_) {
-        int noteChannel = pair.first >> 16;
-        if (noteChannel == channel) {
-            pair.second->setPitchBend(semitones);
+    // Apply to all held notes on this channel
+    for (int i = 0; i < static_cast<int>(voices_.size()); ++i) {
+        Voice& voice = *voices_[i];
+        if (voice.getChannel() == channel && findVoiceIndexForNote(voice.getMidiNote(), channel) == i) {
+            voice.setPitchBend(semitones);
         }
     }
 }
 
 void VoiceManager::setAftertouch(int note, float pressure, int channel) {
+    if (!isValidKey(note, channel)) {
+        return;
+    }
+    
     // Normalize pressure to range 0.0 to 1.0
     float normalizedPressure = std::clamp(pressure, 0.0f, 1.0f);
     
-    // Ensure we have a channel state for this channel
-    if (channelStates_.find(channel) == channelStates_.end()) {
-        channelStates_[channel] = ChannelState{};
-    }
-    
     // Store aftertouch value
     channelStates_[channel].noteAftertouch[note] = normalizedPressure;
     
     // Apply to the specific voice
-    int noteKey = (channel << 16) | note;
-    auto it = activeNotes_.find(noteKey);
-    if (it != activeNotes_.end()) {
-        it->second->setPressure(normalizedPressure);
+    if (Voice* voice = findVoiceForNote(note, channel)) {
+        voice->setPressure(normalizedPressure);
     }
 }
 
 void VoiceManager::setChannelPressure(float pressure, int channel) {
+    if (channel < 0 || channel >= kMaxChannels) {
+        return;
+    }
+    
     // Normalize pressure to range 0.0 to 1.0
     float normalizedPressure = std::clamp(pressure, 0.0f, 1.0f);
     
-    // Ensure we have a channel state for this channel
-    if (channelStates_.find(channel) == channelStates_.end()) {
-        channelStates_[channel] = ChannelState{};
-    }
-    
     // Store channel pressure value
     channelStates_[channel].channelPressure = normalizedPressure;
     
-    // Apply to all active voices for this channel
-    for (auto& pair : activeNotes_) {
-        int noteChannel = pair.first >> 16;
-        if (noteChannel == channel) {
-            pair.second->setPressure(normalizedPressure);
+    // Apply to all held notes on this channel
+    for (int i = 0; i < static_cast<int>(voices_.size()); ++i) {
+        Voice& voice = *voices_[i];
+        if (voice.getChannel() == channel && findVoiceIndexForNote(voice.getMidiNote(), channel) == i) {
+            voice.setPressure(normalizedPressure);
         }
     }
 }
 
 void VoiceManager::resetAllControllers() {
     // Reset all controllers for all channels
-    for (auto& channelPair : channelStates_) {
-        ChannelState& state = channelPair.second;
-        
+    for (ChannelState& state : channelStates_) {
         // Reset pitch bend
         state.pitchBendValue = 0.0f;
         state.channelPressure = 0.0f;
         
         // Reset all note-specific aftertouch values
-        state.noteAftertouch.clear();
+        state.noteAftertouch.fill(0.0f);
         
         // Don't release sustained notes or turn off sustain - that's a separate control
     }
     
-    // Apply zero pitch bend to all active voices
-    for (auto& pair : activeNotes_) {
-        pair.second->setPitchBend(0.0f);
-        pair.second->setPressure(0.0f);
+    // Apply zero pitch bend to all held notes
+    for (int i = 0; i < static_cast<int>(voices_.size()); ++i) {
+        Voice& voice = *voices_[i];
+        if (findVoiceIndexForNote(voice.getMidiNote(), voice.getChannel()) == i) {
+            voice.setPitchBend(0.0f);
+            voice.setPressure(0.0f);
+        }
     }
 }
 
@@ -6,7 +6,7 @@
 namespace AIMusicHardware {
 
 // Constants
-constexpr int MAX_OSCILLATORS = 8;  // Maximum number of oscillators in a stack
+constexpr int MAX_OSCILLATORS = OscillatorStack::kMaxOscillators;  // Maximum number of oscillators in a stack
 
 OscillatorStack::OscillatorStack(int sampleRate, int numOscillators) 
     : sampleRate_(sampleRate), baseFrequency_(440.0f) {
@@ -19,6 +19,7 @@ OscillatorStack::OscillatorStack(int sampleRate, int numOscillators)
         oscillators_.push_back(createOscillator());
         configs_.push_back(OscillatorConfig{}); // Default config
     }
+    updateRenderedOscillators();
 }
 
 OscillatorStack::~OscillatorStack() {
@@ -30,6 +31,7 @@ std::unique_ptr<WavetableOscillator> OscillatorStack::createOscillator() {
     if (wavetable_) {
         osc->setWavetable(wavetable_);
     }
+    osc->setOversampling(oversampling_);
     return osc;
 }
 
@@ -52,6 +54,42 @@ void OscillatorStack::setOscillatorCount(int count) {
         oscillators_.pop_back();
         configs_.pop_back();
     }
+    
+    updateRenderedOscillators();
+}
+
+void OscillatorStack::setUnisonLimit(int limit) {
+    limit = std::clamp(limit, 1, MAX_OSCILLATORS);
+    if (limit != unisonLimit_) {
+        unisonLimit_ = limit;
+        updateRenderedOscillators();
+    }
+}
+
+void OscillatorStack::updateRenderedOscillators() {
+    const int count = static_cast<int>(oscillators_.size());
+    numRendered_ = std::min(count, unisonLimit_);
+    
+    if (numRendered_ == count) {
+        for (int i = 0; i < count; ++i) {
+            rendered_[i] = i;
+        }
+    } else if (numRendered_ == 1) {
+        // A single oscillator: the one nearest the centre of the spread
+        rendered_[0] = (count - 1) / 2;
+    } else {
+        // Spread evenly from the first to the last oscillator
+        for (int i = 0; i < numRendered_; ++i) {
+            rendered_[i] = static_cast<int>(std::lround(static_cast<float>(i) * (count - 1) / (numRendered_ - 1)));
+        }
+    }
+}
+
+void OscillatorStack::setOversampling(bool enabled) {
+    oversampling_ = enabled;
+    for (auto& osc : oscillators_) {
+        osc->setOversampling(enabled);
+    }
 }
 
 void OscillatorStack::setFrequency(float frequency) {
@@ -204,15 +242,16 @@ void OscillatorStack::setSampleRate(int sampleRate) {
 float OscillatorStack::generateMonoSample() {
     float sample = 0.0f;
     
-    // Mix all oscillators
-    for (size_t i = 0; i < oscillators_.size(); ++i) {
+    // Mix the rendered oscillators
+    for (int k = 0; k < numRendered_; ++k) {
+        const int i = rendered_[k];
         sample += oscillators_[i]->generateSample() * configs_[i].level;
     }
     
     // Normalize if more than one oscillator is active
-    if (oscillators_.size() > 1) {
+    if (numRendered_ > 1) {
         // Simple normalization by oscillator count
-        float normFactor = 1.0f / std::sqrt(static_cast<float>(oscillators_.size()));
+        float normFactor = 1.0f / std::sqrt(static_cast<float>(numRendered_));
         sample *= normFactor;
     }
     
@@ -223,8 +262,9 @@ void OscillatorStack::generateStereoSample(float& leftOut, float& rightOut) {
     float left = 0.0f;
     float right = 0.0f;
     
-    // Mix all oscillators with panning
-    for (size_t i = 0; i < oscillators_.size(); ++i) {
+    // Mix the rendered oscillators with panning
+    for (int k = 0; k < numRendered_; ++k) {
+        const int i = rendered_[k];
         float sample = oscillators_[i]->generateSample() * configs_[i].level;
         
         // Apply panning
@@ -237,9 +277,9 @@ void OscillatorStack::generateStereoSample(float& leftOut, float& rightOut) {
     }
     
     // Normalize if more than one oscillator is active
-    if (oscillators_.size() > 1) {
+    if (numRendered_ > 1) {
         // Simple normalization by oscillator count
-        float normFactor = 1.0f / std::sqrt(static_cast<float>(oscillators_.size()));
+        float normFactor = 1.0f / std::sqrt(static_cast<float>(numRendered_));
         left *= normFactor;
         right *= normFactor;
     }
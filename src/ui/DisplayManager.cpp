@@ -1,5 +1,6 @@
 #include "../../include/ui/DisplayManager.h"
 #include "../../include/ui/Font.h"
+#include "../../include/ui/SpanRasterizer.h"
 #include <algorithm>
 #include <cmath>
 #include <cstring>
@@ -38,7 +39,8 @@ Color Color::fromHSV(float h, float s, float v) {
 
 DisplayManager::DisplayManager()
     : width_(0), height_(0), bytesPerPixel_(4), pitch_(0),
-      blendMode_(BlendMode::Alpha), hasClipRect_(false) {
+      blendMode_(BlendMode::Alpha), hasClipRect_(false),
+      damageTracking_(false), hasDamageClip_(false) {
 }
 
 DisplayManager::~DisplayManager() {
@@ -74,22 +76,130 @@ void DisplayManager::shutdown() {
     // Free buffer memory
     frontBuffer_.clear();
     backBuffer_.clear();
+    damageRegions_.clear();
     width_ = 0;
     height_ = 0;
 }
 
 void DisplayManager::clear(const Color& color) {
-    // Fill the back buffer with the specified color
-    for (int y = 0; y < height_; y++) {
-        for (int x = 0; x < width_; x++) {
-            setPixel(x, y, color);
-        }
+    // Only the clipped area is cleared, so clearing inside a damage region
+    // leaves the rest of the frame alone
+    Rect area = drawableArea();
+    for (int y = area.y; y < area.y + area.height; y++) {
+        applySpan(&backBuffer_[static_cast<size_t>(y * pitch_ + area.x * bytesPerPixel_)],
+                  area.width, color);
     }
 }
 
 void DisplayManager::swapBuffers() {
-    // Swap front and back buffers
-    frontBuffer_.swap(backBuffer_);
+    if (!damageTracking_) {
+        // Swap front and back buffers
+        frontBuffer_.swap(backBuffer_);
+        return;
+    }
+    
+    // Present only what changed; the back buffer keeps the full frame so
+    // the next frame can again repaint just its damage
+    for (const Rect& region : damageRegions_) {
+        presentRegion(region);
+    }
+    damageRegions_.clear();
+}
+
+void DisplayManager::presentRegion(const Rect& rect) {
+    size_t rowBytes = static_cast<size_t>(rect.width * bytesPerPixel_);
+    for (int y = rect.y; y < rect.y + rect.height; y++) {
+        size_t offset = static_cast<size_t>(y * pitch_ + rect.x * bytesPerPixel_);
+        std::memcpy(frontBuffer_.data() + offset, backBuffer_.data() + offset, rowBytes);
+    }
+}
+
+void DisplayManager::setDamageTracking(bool enabled) {
+    if (enabled == damageTracking_) {
+        return;
+    }
+    
+    damageTracking_ = enabled;
+    damageRegions_.clear();
+    if (enabled) {
+        // Nothing is known to be on screen yet
+        addFullDamage();
+    }
+}
+
+void DisplayManager::addDamage(const Rect& rect) {
+    if (!damageTracking_) {
+        return;
+    }
+    
+    Rect region = rect.intersected(Rect(0, 0, width_, height_));
+    if (region.isEmpty()) {
+        return;
+    }
+    
+    // Absorb every existing region that overlaps the new one, or that is
+    // close enough that the merged rectangle wastes little area. Growing
+    // the region can bring it into contact with ones already passed, so
+    // restart the scan after each merge.
+    for (size_t i = 0; i < damageRegions_.size();) {
+        const Rect& existing = damageRegions_[i];
+        Rect merged = region.united(existing);
+        bool overlaps = region.intersects(existing);
+        bool cheap = merged.area() * 4 <= (region.area() + existing.area()) * 5;
+        if (overlaps || cheap) {
+            region = merged;
+            damageRegions_.erase(damageRegions_.begin() + i);
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+    damageRegions_.push_back(region);
+    
+    // Too many scattered regions cost more in per-region overhead than the
+    // pixels they save
+    if (damageRegions_.size() > kMaxDamageRegions) {
+        Rect bounds;
+        for (const Rect& r : damageRegions_) {
+            bounds = bounds.united(r);
+        }
+        damageRegions_.clear();
+        damageRegions_.push_back(bounds);
+    }
+}
+
+void DisplayManager::addFullDamage() {
+    if (!damageTracking_) {
+        return;
+    }
+    damageRegions_.clear();
+    if (width_ > 0 && height_ > 0) {
+        damageRegions_.push_back(Rect(0, 0, width_, height_));
+    }
+}
+
+void DisplayManager::clearDamage() {
+    damageRegions_.clear();
+}
+
+void DisplayManager::beginDamageRegion(const Rect& rect) {
+    damageClip_ = rect.intersected(Rect(0, 0, width_, height_));
+    hasDamageClip_ = true;
+    clipRect_ = damageClip_;
+    hasClipRect_ = true;
+}
+
+void DisplayManager::endDamageRegion() {
+    hasDamageClip_ = false;
+    hasClipRect_ = false;
+    clipRect_ = Rect(0, 0, width_, height_);
+}
+
+bool DisplayManager::intersectsClip(const Rect& rect) const {
+    if (!hasClipRect_) {
+        return true;
+    }
+    return rect.intersects(clipRect_);
 }
 
 void DisplayManager::setPixel(int x, int y, const Color& color) {
@@ -127,6 +237,19 @@ Color DisplayManager::getPixel(int x, int y) const {
 }
 
 void DisplayManager::drawLine(int x1, int y1, int x2, int y2, const Color& color) {
+    Rect bounds(std::min(x1, x2), std::min(y1, y2), std::abs(x2 - x1) + 1, std::abs(y2 - y1) + 1);
+    if (!intersectsClip(bounds)) {
+        return;
+    }
+    
+    // Axis-aligned lines (rect borders, grids, meter ticks) are spans
+    if (y1 == y2 || x1 == x2) {
+        for (int y = bounds.y; y < bounds.y + bounds.height; y++) {
+            fillSpan(y, bounds.x, bounds.x + bounds.width, color);
+        }
+        return;
+    }
+    
     // Bresenham's line algorithm
     int dx = std::abs(x2 - x1);
     int dy = std::abs(y2 - y1);
@@ -164,35 +287,23 @@ void DisplayManager::drawRect(int x, int y, int width, int height, const Color&
 }
 
 void DisplayManager::fillRect(int x, int y, int width, int height, const Color& color) {
-    // Apply clipping to rectangle
-    if (hasClipRect_) {
-        Rect rect(x, y, width, height);
-        if (!rect.intersects(clipRect_)) {
-            return;
-        }
-        
-        // Clip the rectangle to the clip rect
-        int x1 = std::max(x, clipRect_.x);
-        int y1 = std::max(y, clipRect_.y);
-        int x2 = std::min(x + width, clipRect_.x + clipRect_.width);
-        int y2 = std::min(y + height, clipRect_.y + clipRect_.height);
-        
-        // Update rectangle dimensions
-        x = x1;
-        y = y1;
-        width = x2 - x1;
-        height = y2 - y1;
+    // Clip once against screen and clip rect, then fill whole rows
+    Rect area = Rect(x, y, width, height).intersected(drawableArea());
+    if (area.isEmpty()) {
+        return;
     }
     
-    // Fill the rectangle
-    for (int j = 0; j < height; j++) {
-        for (int i = 0; i < width; i++) {
-            setPixel(x + i, y + j, color);
-        }
+    for (int j = area.y; j < area.y + area.height; j++) {
+        applySpan(&backBuffer_[static_cast<size_t>(j * pitch_ + area.x * bytesPerPixel_)],
+                  area.width, color);
     }
 }
 
 void DisplayManager::drawCircle(int x, int y, int radius, const Color& color) {
+    if (!intersectsClip(Rect(x - radius, y - radius, radius * 2 + 1, radius * 2 + 1))) {
+        return;
+    }
+    
     // Midpoint circle algorithm
     int f = 1 - radius;
     int ddF_x = 0;
@@ -228,18 +339,22 @@ void DisplayManager::drawCircle(int x, int y, int radius, const Color& color) {
 }
 
 void DisplayManager::fillCircle(int x, int y, int radius, const Color& color) {
-    // Filled circle algorithm based on midpoint
+    if (radius < 0 || !intersectsClip(Rect(x - radius, y - radius, radius * 2 + 1, radius * 2 + 1))) {
+        return;
+    }
+    
+    // Midpoint circle, collecting the half-width of each row so that every
+    // row is filled exactly once as a single span
+    circleSpans_.assign(static_cast<size_t>(radius * 2 + 1), 0);
+    int* halfWidth = circleSpans_.data() + radius;
+    
     int f = 1 - radius;
     int ddF_x = 0;
     int ddF_y = -2 * radius;
     int px = 0;
     int py = radius;
     
-    // Draw horizontal line through the center
-    for (int i = -radius; i <= radius; i++) {
-        setPixel(x + i, y, color);
-    }
-    
+    halfWidth[0] = radius;
     while (px < py) {
         if (f >= 0) {
             py--;
@@ -250,16 +365,14 @@ void DisplayManager::fillCircle(int x, int y, int radius, const Color& color) {
         ddF_x += 2;
         f += ddF_x + 1;
         
-        // Draw horizontal lines between points
-        for (int i = -px; i <= px; i++) {
-            setPixel(x + i, y + py, color);
-            setPixel(x + i, y - py, color);
-        }
-        
-        for (int i = -py; i <= py; i++) {
-            setPixel(x + i, y + px, color);
-            setPixel(x + i, y - px, color);
-        }
+        halfWidth[py] = std::max(halfWidth[py], px);
+        halfWidth[-py] = std::max(halfWidth[-py], px);
+        halfWidth[px] = std::max(halfWidth[px], py);
+        halfWidth[-px] = std::max(halfWidth[-px], py);
+    }
+    
+    for (int dy = -radius; dy <= radius; dy++) {
+        fillSpan(y + dy, x - halfWidth[dy], x + halfWidth[dy] + 1, color);
     }
 }
 
@@ -271,6 +384,13 @@ void DisplayManager::drawTriangle(int x1, int y1, int x2, int y2, int x3, int y3
 }
 
 void DisplayManager::fillTriangle(int x1, int y1, int x2, int y2, int x3, int y3, const Color& color) {
+    int minX = std::min({x1, x2, x3});
+    int minY = std::min({y1, y2, y3});
+    Rect bounds(minX, minY, std::max({x1, x2, x3}) - minX + 1, std::max({y1, y2, y3}) - minY + 1);
+    if (!intersectsClip(bounds)) {
+        return;
+    }
+    
     // Simple implementation using scanline algorithm
     
     // Sort vertices by y-coordinate (y1 <= y2 <= y3)
@@ -313,7 +433,9 @@ void DisplayManager::fillFlatBottomTriangle(int x1, int y1, int x2, int y2, int
     float x_end = x1;
     
     for (int y = y1; y <= y2; y++) {
-        drawLine(std::round(x_start), y, std::round(x_end), y, color);
+        int a = static_cast<int>(std::round(x_start));
+        int b = static_cast<int>(std::round(x_end));
+        fillSpan(y, std::min(a, b), std::max(a, b) + 1, color);
         x_start += slope1;
         x_end += slope2;
     }
@@ -328,7 +450,9 @@ void DisplayManager::fillFlatTopTriangle(int x1, int y1, int x2, int y2, int x3,
     float x_end = x3;
     
     for (int y = y3; y >= y1; y--) {
-        drawLine(std::round(x_start), y, std::round(x_end), y, color);
+        int a = static_cast<int>(std::round(x_start));
+        int b = static_cast<int>(std::round(x_end));
+        fillSpan(y, std::min(a, b), std::max(a, b) + 1, color);
         x_start -= slope1;
         x_end -= slope2;
     }
@@ -339,48 +463,71 @@ void DisplayManager::drawText(int x, int y, const std::string& text, Font* font,
         return;
     }
     
-    int cursorX = x;
-    int cursorY = y;
-    uint32_t prevChar = 0;
-    
-    // Process each character
-    for (char c : text) {
-        uint32_t codepoint = static_cast<uint32_t>(c);
-        
-        // Apply kerning
-        cursorX += font->getKerning(prevChar, codepoint);
-        
-        // Get the glyph for this character
-        const Glyph* glyph = font->getGlyph(codepoint);
-        if (!glyph) {
-            // Skip characters without glyphs
+    // Glyph positions come from the font's layout cache and coverage from
+    // its atlas, so each visible glyph row is a single masked span
+    const TextLayout& layout = font->layoutText(text);
+    const uint8_t* atlas = font->getAtlasPixels();
+    const int atlasWidth = font->getAtlasWidth();
+    const Rect area = drawableArea();
+    
+    for (const TextLayout::Placement& placement : layout.glyphs) {
+        const AtlasGlyph& glyph = *placement.glyph;
+        Rect glyphRect(x + placement.x, y + placement.y, glyph.width, glyph.height);
+        Rect visible = glyphRect.intersected(area);
+        if (visible.isEmpty()) {
             continue;
         }
         
-        // Calculate position for the glyph
-        int glyphX = cursorX + glyph->xOffset;
-        int glyphY = cursorY + glyph->yOffset;
-        
-        // Draw the glyph
-        if (!glyph->bitmap.empty()) {
-            for (int j = 0; j < glyph->height; j++) {
-                for (int i = 0; i < glyph->width; i++) {
-                    int index = j * glyph->width + i;
-                    if (index < glyph->bitmap.size()) {
-                        uint8_t alpha = glyph->bitmap[index];
-                        if (alpha > 0) {
-                            Color pixelColor = color;
-                            pixelColor.a = (pixelColor.a * alpha) / 255;
-                            setPixel(glyphX + i, glyphY + j, pixelColor);
-                        }
-                    }
+        int srcX = glyph.atlasX + (visible.x - glyphRect.x);
+        int srcY = glyph.atlasY + (visible.y - glyphRect.y);
+        for (int row = 0; row < visible.height; row++) {
+            const uint8_t* coverage = atlas + static_cast<size_t>(srcY + row) * atlasWidth + srcX;
+            int dstY = visible.y + row;
+            
+            if (blendMode_ == BlendMode::Alpha) {
+                uint8_t* dst = &backBuffer_[static_cast<size_t>(dstY * pitch_ + visible.x * bytesPerPixel_)];
+                SpanRasterizer::blendMask(dst, coverage, visible.width, color);
+                continue;
+            }
+            
+            // Other modes scale the color's alpha by coverage per pixel
+            for (int i = 0; i < visible.width; i++) {
+                if (coverage[i] > 0) {
+                    Color pixelColor = color;
+                    pixelColor.a = static_cast<uint8_t>((pixelColor.a * coverage[i]) / 255);
+                    blendPixel(visible.x + i, dstY, pixelColor);
                 }
             }
         }
-        
-        // Advance cursor position
-        cursorX += glyph->xAdvance;
-        prevChar = codepoint;
+    }
+}
+
+void DisplayManager::submit(const DrawBatch& batch) {
+    for (const DrawBatch::Command& command : batch.getCommands()) {
+        switch (command.type) {
+            case DrawBatch::Type::FillRect:
+                if (intersectsClip(Rect(command.x, command.y, command.x2, command.y2))) {
+                    fillRect(command.x, command.y, command.x2, command.y2, command.color);
+                }
+                break;
+            case DrawBatch::Type::DrawRect:
+                if (intersectsClip(Rect(command.x, command.y, command.x2, command.y2))) {
+                    drawRect(command.x, command.y, command.x2, command.y2, command.color);
+                }
+                break;
+            case DrawBatch::Type::FillCircle:
+                fillCircle(command.x, command.y, command.x2, command.color);
+                break;
+            case DrawBatch::Type::DrawCircle:
+                drawCircle(command.x, command.y, command.x2, command.color);
+                break;
+            case DrawBatch::Type::Line:
+                drawLine(command.x, command.y, command.x2, command.y2, command.color);
+                break;
+            case DrawBatch::Type::Text:
+                drawText(command.x, command.y, batch.getText(command), command.font, command.color);
+                break;
+        }
     }
 }
 
@@ -407,6 +554,10 @@ void DisplayManager::drawImage(int x, int y, const uint8_t* imageData, int imgWi
         return;
     }
     
+    if (!intersectsClip(Rect(x, y, srcWidth, srcHeight))) {
+        return;
+    }
+    
     // Draw the image
     for (int j = 0; j < srcHeight; j++) {
         for (int i = 0; i < srcWidth; i++) {
@@ -438,10 +589,19 @@ void DisplayManager::setClipRect(const Rect& rect) {
     clipRect_.width = std::min(width_ - clipRect_.x, clipRect_.width);
     clipRect_.height = std::min(height_ - clipRect_.y, clipRect_.height);
     
+    // Components may clip further, but never outside the region being redrawn
+    if (hasDamageClip_) {
+        clipRect_ = clipRect_.intersected(damageClip_);
+    }
+    
     hasClipRect_ = true;
 }
 
 void DisplayManager::clearClipRect() {
+    if (hasDamageClip_) {
+        clipRect_ = damageClip_;
+        return;
+    }
     hasClipRect_ = false;
 }
 
@@ -520,6 +680,43 @@ void DisplayManager::blendPixel(int x, int y, const Color& color) {
     backBuffer_[offset + 3] = resultA;
 }
 
+void DisplayManager::fillSpan(int y, int x1, int x2, const Color& color) {
+    Rect area = drawableArea();
+    if (y < area.y || y >= area.y + area.height) {
+        return;
+    }
+    
+    x1 = std::max(x1, area.x);
+    x2 = std::min(x2, area.x + area.width);
+    if (x2 <= x1) {
+        return;
+    }
+    
+    applySpan(&backBuffer_[static_cast<size_t>(y * pitch_ + x1 * bytesPerPixel_)], x2 - x1, color);
+}
+
+void DisplayManager::applySpan(uint8_t* dst, int count, const Color& color) {
+    switch (blendMode_) {
+        case BlendMode::None:
+            SpanRasterizer::fill(dst, count, color);
+            break;
+        case BlendMode::Alpha:
+            SpanRasterizer::blend(dst, count, color);
+            break;
+        case BlendMode::Add:
+            SpanRasterizer::add(dst, count, color);
+            break;
+        case BlendMode::Multiply:
+            SpanRasterizer::multiply(dst, count, color);
+            break;
+    }
+}
+
+Rect DisplayManager::drawableArea() const {
+    Rect screen(0, 0, width_, height_);
+    return hasClipRect_ ? screen.intersected(clipRect_) : screen;
+}
+
 bool DisplayManager::isInClipRect(int x, int y) const {
     if (!hasClipRect_) {
         return true;
@@ -529,4 +726,42 @@ bool DisplayManager::isInClipRect(int x, int y) const {
            y >= clipRect_.y && y < clipRect_.y + clipRect_.height;
 }
 
+//
+// DrawBatch implementation
+//
+void DrawBatch::fillRect(int x, int y, int width, int height, const Color& color) {
+    commands_.push_back({Type::FillRect, x, y, width, height, color, nullptr, 0});
+}
+
+void DrawBatch::drawRect(int x, int y, int width, int height, const Color& color) {
+    commands_.push_back({Type::DrawRect, x, y, width, height, color, nullptr, 0});
+}
+
+void DrawBatch::fillCircle(int x, int y, int radius, const Color& color) {
+    commands_.push_back({Type::FillCircle, x, y, radius, 0, color, nullptr, 0});
+}
+
+void DrawBatch::drawCircle(int x, int y, int radius, const Color& color) {
+    commands_.push_back({Type::DrawCircle, x, y, radius, 0, color, nullptr, 0});
+}
+
+void DrawBatch::drawLine(int x1, int y1, int x2, int y2, const Color& color) {
+    commands_.push_back({Type::Line, x1, y1, x2, y2, color, nullptr, 0});
+}
+
+void DrawBatch::drawText(int x, int y, const std::string& text, Font* font, const Color& color) {
+    // Reuse string slots from earlier frames to keep their capacity
+    if (textCount_ == texts_.size()) {
+        texts_.emplace_back();
+    }
+    texts_[textCount_].assign(text);
+    commands_.push_back({Type::Text, x, y, 0, 0, color, font, textCount_});
+    ++textCount_;
+}
+
+void DrawBatch::clear() {
+    commands_.clear();
+    textCount_ = 0;
+}
+
 } // namespace AIMusicHardware
\ No newline at end of file
@@ -11,21 +11,25 @@ DropdownMenu::DropdownMenu(const std::string& id, const std::string& placeholder
 
 void DropdownMenu::addItem(const std::string& item) {
     items_.push_back(item);
+    markDirty();
 }
 
 void DropdownMenu::addItems(const std::vector<std::string>& items) {
     items_.insert(items_.end(), items.begin(), items.end());
+    markDirty();
 }
 
 void DropdownMenu::clearItems() {
     items_.clear();
     selectedIndex_ = -1;
     scrollOffset_ = 0;
+    markDirty();
 }
 
 void DropdownMenu::selectItem(int index) {
     if (index >= 0 && index < static_cast<int>(items_.size())) {
         selectedIndex_ = index;
+        markDirty();
         if (selectionCallback_) {
             selectionCallback_(index, items_[index]);
         }
@@ -212,6 +216,18 @@ bool DropdownMenu::handleInput(const InputEvent& event) {
     return false;
 }
 
+Rect DropdownMenu::getPaintBounds() const {
+    Rect bounds = UIComponent::getPaintBounds();
+    if (!isOpen_ || items_.empty()) {
+        return bounds;
+    }
+    
+    // The open list is drawn outside the button, above or below it
+    int dropdownHeight = getDropdownHeight();
+    int listY = openUpwards_ ? y_ - dropdownHeight : y_ + height_;
+    return bounds.united(Rect(x_ - 2, listY - 2, width_ + 4, dropdownHeight + 4));
+}
+
 int DropdownMenu::getDropdownHeight() const {
     return std::min(static_cast<int>(items_.size()), maxVisibleItems_) * itemHeight_ + 4;
 }
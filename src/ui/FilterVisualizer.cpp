@@ -21,6 +21,7 @@ void FilterVisualizer::update(float deltaTime) {
         lastCutoff = cutoffFreq_;
         lastResonance = resonance_;
         lastType = filterType_;
+        markDirty();
     }
 }
 
@@ -32,12 +32,14 @@ bool Font::create(int fontSize) {
     // Clear existing glyphs
     glyphs_.clear();
     kerningPairs_.clear();
+    atlasValid_ = false;
     
     return true;
 }
 
 void Font::addGlyph(const Glyph& glyph) {
     glyphs_[glyph.codepoint] = glyph;
+    atlasValid_ = false;
 }
 
 const Glyph* Font::getGlyph(uint32_t codepoint) const {
@@ -123,6 +125,109 @@ int Font::getFontSize() const {
     return fontSize_;
 }
 
+const uint8_t* Font::getAtlasPixels() const {
+    buildAtlas();
+    return atlasPixels_.data();
+}
+
+int Font::getAtlasWidth() const {
+    return kAtlasWidth;
+}
+
+int Font::getAtlasHeight() const {
+    buildAtlas();
+    return atlasHeight_;
+}
+
+void Font::buildAtlas() const {
+    if (atlasValid_) {
+        return;
+    }
+    
+    atlasGlyphs_.clear();
+    atlasIndex_.clear();
+    layoutCache_.clear();
+    atlasGlyphs_.reserve(glyphs_.size());
+    
+    // Shelf packing: glyphs fill rows left to right, a new row starts when
+    // the next glyph does not fit
+    int shelfX = 0;
+    int shelfY = 0;
+    int shelfHeight = 0;
+    for (const auto& entry : glyphs_) {
+        const Glyph& glyph = entry.second;
+        int width = std::min(glyph.width, kAtlasWidth);
+        if (shelfX + width > kAtlasWidth) {
+            shelfX = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+        
+        AtlasGlyph placed{shelfX, shelfY, width, glyph.height,
+                          glyph.xOffset, glyph.yOffset, glyph.xAdvance};
+        atlasIndex_[entry.first] = atlasGlyphs_.size();
+        atlasGlyphs_.push_back(placed);
+        
+        shelfX += width;
+        shelfHeight = std::max(shelfHeight, glyph.height);
+    }
+    atlasHeight_ = shelfY + shelfHeight;
+    
+    atlasPixels_.assign(static_cast<size_t>(kAtlasWidth) * atlasHeight_, 0);
+    for (const auto& entry : glyphs_) {
+        const Glyph& glyph = entry.second;
+        const AtlasGlyph& placed = atlasGlyphs_[atlasIndex_[entry.first]];
+        for (int row = 0; row < placed.height; ++row) {
+            size_t srcRow = static_cast<size_t>(row) * glyph.width;
+            if (srcRow >= glyph.bitmap.size()) {
+                break;
+            }
+            size_t count = std::min<size_t>(placed.width, glyph.bitmap.size() - srcRow);
+            std::copy_n(glyph.bitmap.begin() + srcRow, count,
+                        atlasPixels_.begin() + (placed.atlasY + row) * kAtlasWidth + placed.atlasX);
+        }
+    }
+    
+    atlasValid_ = true;
+}
+
+const TextLayout& Font::layoutText(const std::string& text) const {
+    buildAtlas();
+    
+    auto cached = layoutCache_.find(text);
+    if (cached != layoutCache_.end()) {
+        return cached->second;
+    }
+    
+    if (layoutCache_.size() >= kMaxCachedLayouts) {
+        layoutCache_.clear();
+    }
+    
+    TextLayout& layout = layoutCache_[text];
+    layout.glyphs.reserve(text.size());
+    
+    int cursorX = 0;
+    uint32_t prevChar = 0;
+    for (char c : text) {
+        uint32_t codepoint = static_cast<uint32_t>(c);
+        cursorX += getKerning(prevChar, codepoint);
+        
+        auto it = atlasIndex_.find(codepoint);
+        if (it == atlasIndex_.end()) {
+            // Characters without glyphs take no space
+            continue;
+        }
+        
+        const AtlasGlyph& glyph = atlasGlyphs_[it->second];
+        layout.glyphs.push_back({cursorX + glyph.xOffset, glyph.yOffset, &glyph});
+        cursorX += glyph.xAdvance;
+        prevChar = codepoint;
+    }
+    layout.width = cursorX;
+    
+    return layout;
+}
+
 // Define the static data arrays with minimal placeholder data
 const uint8_t FontFactory::defaultFontData_[] = { 0 };
 const uint8_t FontFactory::monospaceFontData_[] = { 0 };
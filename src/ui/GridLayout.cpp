@@ -142,6 +142,7 @@ bool GridLayout::handleInput(const InputEvent& event) {
     for (auto& cell : cells_) {
         if (cell.component && cell.component->isVisible() && cell.component->isEnabled()) {
             if (cell.component->handleInput(event)) {
+                cell.component->markDirty();
                 return true;
             }
         }
@@ -149,6 +150,17 @@ bool GridLayout::handleInput(const InputEvent& event) {
     return false;
 }
 
+void GridLayout::collectDamage(DisplayManager* display) {
+    UIComponent::collectDamage(display);
+    
+    // Cell components are owned by cells_ rather than children_
+    for (auto& cell : cells_) {
+        if (cell.component) {
+            cell.component->collectDamage(display);
+        }
+    }
+}
+
 std::vector<std::pair<UIComponent*, Rect>> GridLayout::getAbsolutePositions() const {
     std::vector<std::pair<UIComponent*, Rect>> positions;
     
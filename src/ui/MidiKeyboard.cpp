@@ -282,6 +282,9 @@ void MidiKeyboard::update(float deltaTime) {
         
         bool isPressed = (pressedNotes_.find(note) != pressedNotes_.end());
         float target = isPressed ? 1.0f : 0.0f;
+        if (std::abs(target - animValue) > 0.001f) {
+            markDirty();
+        }
         
         // Smooth animation
         float animSpeed = 8.0f; // Animation speed
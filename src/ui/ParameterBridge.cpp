@@ -1,4 +1,5 @@
 #include "../../include/ui/ParameterBridge.h"
+#include "../../include/audio/ParameterStore.h"
 #include <cmath>
 #include <algorithm>
 #include <sstream>
@@ -122,11 +123,21 @@ float ParameterBridge::fromNormalized(float normalized) const {
     return min + (max - min) * curved;
 }
 
+void ParameterBridge::bindStore(ParameterStore* store, int index) {
+    store_ = store;
+    storeIndex_ = index;
+}
+
 void ParameterBridge::setValueFromUI(float normalized, ChangeSource source) {
     float value = fromNormalized(normalized);
     targetValue_ = value;
     hasNewValue_ = true;
     
+    if (store_) {
+        // Both enums list the sources in the same order
+        store_->push(static_cast<ParameterStore::ChangeSource>(source), storeIndex_, value);
+    }
+    
     if (!smoothingEnabled_) {
         currentValue_ = value;
         updateParameterValue(value);
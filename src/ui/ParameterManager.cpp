@@ -48,9 +48,15 @@ void ParameterManager::setParameterValue(const std::string& parameterId, float v
     // Update local cache
     parameters_[parameterId] = value;
     
+    // Later automation starts from this value
+    AutomatedParameter& bound = bindParameter(parameterId);
+    if (!bound.enabled) {
+        bound.smoother.reset(value);
+    }
+    
     // If connected to a synthesizer, update it
-    if (synth_) {
-        synth_->setParameter(parameterId, value);
+    if (synth_ && bound.synthParameter >= 0) {
+        synth_->setParameter(static_cast<SynthParamId>(bound.synthParameter), value);
     }
     
     // Notify observers
@@ -61,15 +67,10 @@ void ParameterManager::setParameterValue(const std::string& parameterId, float v
 }
 
 void ParameterManager::setParameterWithAutomation(const std::string& parameterId, float value) {
-    // Initialize smooth parameter if it doesn't exist
-    if (smooth_parameters_.find(parameterId) == smooth_parameters_.end()) {
-        float current_value = getParameterValue(parameterId);
-        smooth_parameters_.emplace(parameterId, SmoothParameter(current_value));
-    }
-    
     // Set target value for smooth transition
-    smooth_parameters_[parameterId].setTarget(value);
-    automation_enabled_[parameterId] = true;
+    AutomatedParameter& automated = bindParameter(parameterId);
+    automated.smoother.setTarget(value);
+    automated.enabled = true;
     
     // Update local cache with target value
     parameters_[parameterId] = value;
@@ -77,39 +78,33 @@ void ParameterManager::setParameterWithAutomation(const std::string& parameterId
 
 void ParameterManager::processAudioBuffer(int num_samples) {
     // Process all smooth parameters
-    for (auto& [param_id, smooth_param] : smooth_parameters_) {
-        if (!automation_enabled_[param_id]) {
+    for (auto& [param_id, automated] : smooth_parameters_) {
+        if (!automated.enabled) {
             continue;
         }
         
         // Process smoothing for this buffer
-        float smoothed_value = smooth_param.process();
+        float smoothed_value = automated.smoother.process();
         
         // Update synthesizer with smoothed value
-        if (synth_) {
-            synth_->setParameter(param_id, smoothed_value);
+        if (synth_ && automated.synthParameter >= 0) {
+            synth_->setParameter(static_cast<SynthParamId>(automated.synthParameter), smoothed_value);
         }
         
         // Check if smoothing is complete
-        if (!smooth_param.isSmoothing()) {
-            automation_enabled_[param_id] = false;
+        if (!automated.smoother.isSmoothing()) {
+            automated.enabled = false;
         }
     }
 }
 
 bool ParameterManager::isParameterAutomated(const std::string& parameterId) const {
-    auto it = automation_enabled_.find(parameterId);
-    return it != automation_enabled_.end() && it->second;
+    auto it = smooth_parameters_.find(parameterId);
+    return it != smooth_parameters_.end() && it->second.enabled;
 }
 
 void ParameterManager::setParameterSmoothingFactor(const std::string& parameterId, float factor) {
-    // Initialize smooth parameter if it doesn't exist
-    if (smooth_parameters_.find(parameterId) == smooth_parameters_.end()) {
-        float current_value = getParameterValue(parameterId);
-        smooth_parameters_.emplace(parameterId, SmoothParameter(current_value));
-    }
-    
-    smooth_parameters_[parameterId].setSmoothingFactor(factor);
+    bindParameter(parameterId).smoother.setSmoothingFactor(factor);
 }
 
 std::map<std::string, float> ParameterManager::getAllParameters() const {
@@ -348,9 +343,24 @@ void ParameterManager::initializeDefaultParameters() {
     
     // Initialize smooth parameters for all default parameters
     for (const auto& [param_id, value] : parameters_) {
-        smooth_parameters_.emplace(param_id, SmoothParameter(value));
-        automation_enabled_[param_id] = false;
+        AutomatedParameter automated;
+        automated.smoother = SmoothParameter(value);
+        automated.synthParameter = findSynthParameter(param_id);
+        smooth_parameters_.emplace(param_id, automated);
+    }
+}
+
+ParameterManager::AutomatedParameter& ParameterManager::bindParameter(const std::string& parameterId) {
+    auto it = smooth_parameters_.find(parameterId);
+    if (it != smooth_parameters_.end()) {
+        return it->second;
     }
+    
+    // First use of this ID: resolve it against the synthesizer's registry once
+    AutomatedParameter automated;
+    automated.smoother = SmoothParameter(getParameterValue(parameterId));
+    automated.synthParameter = findSynthParameter(parameterId);
+    return smooth_parameters_.emplace(parameterId, automated).first->second;
 }
 
 void ParameterManager::updateSynthesizer(const std::string& parameterId) {
@@ -361,9 +371,8 @@ void ParameterManager::updateSynthesizer(const std::string& parameterId) {
 bool ParameterManager::isValidParameter(const std::string& parameterId) const {
     // Check if a parameter is valid
     if (synth_) {
-        // If connected to a synthesizer, check its parameter list
-        auto params = synth_->getAllParameters();
-        return params.find(parameterId) != params.end();
+        // If connected to a synthesizer, check its parameter registry
+        return findSynthParameter(parameterId) >= 0;
     }
     
     // Otherwise check our parameter cache
@@ -13,7 +13,7 @@ ParameterUpdateSystem& ParameterUpdateSystem::getInstance() {
 bool ParameterUpdateSystem::pushToAudio(const Parameter::ParameterId& id, float value,
                                         ParameterUpdateQueue<>::ChangeSource source) {
     ParameterUpdateQueue<>::ParameterChange change{
-        id, value, source, getCurrentTimestamp()
+        id, value, source, getCurrentTimestamp(), findSynthParameter(id)
     };
     
     bool success = audioQueue_.push(change);
@@ -33,6 +33,67 @@ bool ParameterUpdateSystem::pushToAudio(const Parameter::ParameterId& id, float
     return success;
 }
 
+ParameterUpdateSystem::BatchProducer ParameterUpdateSystem::acquireBatchProducer() {
+    if (batchProducerHeld_.exchange(true, std::memory_order_acquire)) {
+        return BatchProducer();
+    }
+    return BatchProducer(this);
+}
+
+ParameterUpdateSystem::BatchProducer::~BatchProducer() {
+    release();
+}
+
+ParameterUpdateSystem::BatchProducer::BatchProducer(BatchProducer&& other) noexcept
+    : system_(other.system_) {
+    other.system_ = nullptr;
+}
+
+ParameterUpdateSystem::BatchProducer&
+ParameterUpdateSystem::BatchProducer::operator=(BatchProducer&& other) noexcept {
+    if (this != &other) {
+        release();
+        system_ = other.system_;
+        other.system_ = nullptr;
+    }
+    return *this;
+}
+
+size_t ParameterUpdateSystem::BatchProducer::push(const ParameterUpdateQueue<>::ParameterChange* changes,
+                                                  size_t count) {
+    return system_ ? system_->pushToAudioBatch(changes, count) : 0;
+}
+
+void ParameterUpdateSystem::BatchProducer::release() {
+    if (system_) {
+        system_->batchProducerHeld_.store(false, std::memory_order_release);
+        system_ = nullptr;
+    }
+}
+
+size_t ParameterUpdateSystem::pushToAudioBatch(const ParameterUpdateQueue<>::ParameterChange* changes,
+                                               size_t count) {
+    if (!changes || count == 0) return 0;
+    
+    size_t pushed = batchQueue_.pushBatch(changes, count);
+    
+    totalAudioUpdates_.fetch_add(pushed, std::memory_order_relaxed);
+    if (pushed < count) {
+        droppedAudioUpdates_.fetch_add(count - pushed, std::memory_order_relaxed);
+    }
+    
+    if (loggingEnabled_) {
+        for (size_t i = 0; i < pushed; ++i) {
+            logUpdate(changes[i], true);
+        }
+        if (pushed < count) {
+            std::cerr << "WARNING: Dropped " << (count - pushed) << " batched audio updates" << std::endl;
+        }
+    }
+    
+    return pushed;
+}
+
 bool ParameterUpdateSystem::pushToUI(const Parameter::ParameterId& id, float value,
                                      ParameterUpdateQueue<>::ChangeSource source) {
     ParameterUpdateQueue<>::ParameterChange change{
@@ -67,6 +128,11 @@ size_t ParameterUpdateSystem::processAudioUpdates(ChangeCallback callback, size_
         processed++;
     }
     
+    while (processed < maxUpdates && batchQueue_.pop(change)) {
+        callback(change);
+        processed++;
+    }
+    
     return processed;
 }
 
@@ -86,7 +152,7 @@ size_t ParameterUpdateSystem::processUIUpdates(ChangeCallback callback, size_t m
 
 ParameterUpdateSystem::Statistics ParameterUpdateSystem::getStatistics() const {
     return Statistics{
-        audioQueue_.size(),
+        audioQueue_.size() + batchQueue_.size(),
         uiQueue_.size(),
         totalAudioUpdates_.load(std::memory_order_relaxed),
         totalUIUpdates_.load(std::memory_order_relaxed),
@@ -50,7 +50,10 @@ bool PresetListItem::handleInput(const InputEvent& event) {
                     event.value2 >= y_ && event.value2 < y_ + height_);
     
     if (event.type == InputEventType::TouchMove) {
-        isHovered_ = inBounds;
+        if (isHovered_ != inBounds) {
+            isHovered_ = inBounds;
+            markDirty();
+        }
         return false; // Don't consume move events
     }
     
@@ -70,7 +73,7 @@ PresetListView::PresetListView(const std::string& id)
 }
 
 void PresetListView::setPresets(const std::vector<PresetInfo>& presets) {
-    items_.clear();
+    discardItems();
     
     for (size_t i = 0; i < presets.size(); ++i) {
         auto item = std::make_unique<PresetListItem>(
@@ -84,13 +87,23 @@ void PresetListView::setPresets(const std::vector<PresetInfo>& presets) {
     }
     
     updateScrollBounds();
+    layoutItems();
+    markDirty();
 }
 
 void PresetListView::clearPresets() {
-    items_.clear();
+    discardItems();
     selectedIndex_ = -1;
     scrollOffset_ = 0.0f;
     maxScroll_ = 0.0f;
+    markDirty();
+}
+
+void PresetListView::discardItems() {
+    for (const auto& item : items_) {
+        discardPaintedArea(*item);
+    }
+    items_.clear();
 }
 
 void PresetListView::selectPreset(int index) {
@@ -113,25 +126,38 @@ void PresetListView::selectPreset(int index) {
 }
 
 void PresetListView::update(float deltaTime) {
-    // Update visible items
+    layoutItems();
+    
+    // Only update visible items
+    for (auto& item : items_) {
+        if (item->isVisible()) {
+            item->update(deltaTime);
+        }
+    }
+}
+
+void PresetListView::layoutItems() {
+    // Items only get marked dirty when they move, resize or scroll in/out
     int itemY = y_ - static_cast<int>(scrollOffset_);
     
     for (auto& item : items_) {
         item->setPosition(x_, itemY);
         item->setSize(width_, PresetListItem::ITEM_HEIGHT);
-        
-        // Only update visible items
-        bool isVisible = (itemY + PresetListItem::ITEM_HEIGHT > y_) && (itemY < y_ + height_);
-        item->setVisible(isVisible);
-        
-        if (isVisible) {
-            item->update(deltaTime);
-        }
+        item->setVisible((itemY + PresetListItem::ITEM_HEIGHT > y_) && (itemY < y_ + height_));
         
         itemY += PresetListItem::ITEM_HEIGHT;
     }
 }
 
+void PresetListView::collectDamage(DisplayManager* display) {
+    UIComponent::collectDamage(display);
+    
+    // Items are owned here rather than in children_
+    for (auto& item : items_) {
+        item->collectDamage(display);
+    }
+}
+
 void PresetListView::render(DisplayManager* display) {
     if (!display) return;
     
@@ -181,7 +207,11 @@ bool PresetListView::handleInput(const InputEvent& event) {
         static int lastY = event.value2;
         if (event.id == 0) { // Only track primary touch
             int deltaY = event.value2 - lastY;
-            scrollOffset_ = std::clamp(scrollOffset_ - deltaY * 2.0f, 0.0f, maxScroll_);
+            float scrollOffset = std::clamp(scrollOffset_ - deltaY * 2.0f, 0.0f, maxScroll_);
+            if (scrollOffset != scrollOffset_) {
+                scrollOffset_ = scrollOffset;
+                markDirty(); // Scrollbar thumb moves
+            }
             lastY = event.value2;
         }
     }
@@ -210,8 +240,10 @@ void PresetListView::ensureSelectedVisible() {
     
     if (itemY < scrollOffset_) {
         scrollOffset_ = itemY;
+        markDirty();
     } else if (itemBottom > scrollOffset_ + height_) {
         scrollOffset_ = itemBottom - height_;
+        markDirty();
     }
 }
 
@@ -223,8 +255,14 @@ PresetSearchBox::PresetSearchBox(const std::string& id)
 
 void PresetSearchBox::update(float deltaTime) {
     if (hasFocus_) {
+        bool cursorShown = cursorBlink_ < 0.5f;
         cursorBlink_ += deltaTime;
         if (cursorBlink_ > 1.0f) cursorBlink_ -= 1.0f;
+        
+        // Repaint only when the cursor appears or disappears
+        if ((cursorBlink_ < 0.5f) != cursorShown) {
+            markDirty();
+        }
     }
 }
 
@@ -258,7 +296,10 @@ bool PresetSearchBox::handleInput(const InputEvent& event) {
                     event.value2 >= y_ && event.value2 < y_ + height_);
     
     if (event.type == InputEventType::TouchPress) {
-        hasFocus_ = inBounds;
+        if (hasFocus_ != inBounds) {
+            hasFocus_ = inBounds;
+            markDirty();
+        }
         return inBounds;
     }
     
@@ -268,6 +309,7 @@ bool PresetSearchBox::handleInput(const InputEvent& event) {
         if (event.id == 8) { // Backspace
             if (!searchText_.empty()) {
                 searchText_.pop_back();
+                markDirty();
                 if (textChangeCallback_) {
                     textChangeCallback_(searchText_);
                 }
@@ -275,6 +317,7 @@ bool PresetSearchBox::handleInput(const InputEvent& event) {
             return true;
         } else if (event.id >= 32 && event.id < 127) { // Printable characters
             searchText_ += static_cast<char>(event.id);
+            markDirty();
             if (textChangeCallback_) {
                 textChangeCallback_(searchText_);
             }
@@ -292,7 +335,11 @@ PresetCategoryFilter::PresetCategoryFilter(const std::string& id)
 }
 
 void PresetCategoryFilter::setCategories(const std::vector<std::string>& categories) {
+    for (const auto& button : categoryButtons_) {
+        discardPaintedArea(*button);
+    }
     categoryButtons_.clear();
+    markDirty();
     
     int buttonX = x_;
     for (const auto& category : categories) {
@@ -346,6 +393,14 @@ bool PresetCategoryFilter::handleInput(const InputEvent& event) {
     return false;
 }
 
+void PresetCategoryFilter::collectDamage(DisplayManager* display) {
+    UIComponent::collectDamage(display);
+    
+    for (auto& button : categoryButtons_) {
+        button->collectDamage(display);
+    }
+}
+
 // PresetBrowserUI implementation
 PresetBrowserUI::PresetBrowserUI(const std::string& id)
     : UIComponent(id) {
@@ -493,6 +548,19 @@ bool PresetBrowserUI::handleInput(const InputEvent& event) {
     return false;
 }
 
+void PresetBrowserUI::collectDamage(DisplayManager* display) {
+    UIComponent::collectDamage(display);
+    
+    // Sub-components are members rather than children_
+    searchBox_->collectDamage(display);
+    categoryFilter_->collectDamage(display);
+    listView_->collectDamage(display);
+    presetInfoLabel_->collectDamage(display);
+    loadButton_->collectDamage(display);
+    saveButton_->collectDamage(display);
+    deleteButton_->collectDamage(display);
+}
+
 void PresetBrowserUI::filterPresets() {
     if (!database_) return;
     
@@ -615,10 +683,12 @@ void PresetSaveDialogUI::show() {
     presetCategory_ = "User";
     presetDescription_.clear();
     focusedField_ = 0;
+    markDirty();
 }
 
 void PresetSaveDialogUI::hide() {
     visible_ = false;
+    markDirty();
 }
 
 void PresetSaveDialogUI::update(float deltaTime) {
@@ -679,6 +749,8 @@ bool PresetSaveDialogUI::handleInput(const InputEvent& event) {
         }
         
         if (currentField) {
+            markDirty();
+            
             if (event.id == 8) { // Backspace
                 if (!currentField->empty()) {
                     currentField->pop_back();
@@ -697,6 +769,18 @@ bool PresetSaveDialogUI::handleInput(const InputEvent& event) {
     return true; // Modal dialog consumes all events
 }
 
+void PresetSaveDialogUI::collectDamage(DisplayManager* display) {
+    // The dialog is drawn centred on the display rather than at its
+    // bounds, so showing, hiding or editing it repaints everything
+    if (dirty_) {
+        display->addFullDamage();
+        dirty_ = false;
+    }
+    
+    saveButton_->collectDamage(display);
+    cancelButton_->collectDamage(display);
+}
+
 void PresetSaveDialogUI::drawInputField(DisplayManager* display, const std::string& label,
                                        const std::string& value, int x, int y, int width,
                                        bool focused) {
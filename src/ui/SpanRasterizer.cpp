@@ -0,0 +1,313 @@
+#include "../../include/ui/SpanRasterizer.h"
+#include "../../include/ui/DisplayManager.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define AIMH_SPAN_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define AIMH_SPAN_NEON 1
+#endif
+
+namespace AIMusicHardware {
+
+namespace {
+
+// Exact round(x / 255) for x in [0, 255 * 255]
+inline uint32_t div255(uint32_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+inline uint32_t packColor(const Color& color) {
+    uint8_t bytes[4] = {color.r, color.g, color.b, color.a};
+    uint32_t pattern;
+    std::memcpy(&pattern, bytes, sizeof(pattern));
+    return pattern;
+}
+
+// Source-over for one pixel. Opaque destinations use integer math (the
+// vector kernels reproduce it exactly); others keep the float formula from
+// DisplayManager::blendPixel so translucent buffers composite as before.
+inline void blendPixel(uint8_t* p, uint8_t r, uint8_t g, uint8_t b, uint32_t alpha) {
+    if (alpha == 0) {
+        return;
+    }
+
+    if (p[3] == 255) {
+        uint32_t inv = 255 - alpha;
+        p[0] = static_cast<uint8_t>(div255(r * alpha + p[0] * inv));
+        p[1] = static_cast<uint8_t>(div255(g * alpha + p[1] * inv));
+        p[2] = static_cast<uint8_t>(div255(b * alpha + p[2] * inv));
+        return;
+    }
+
+    float srcAlpha = alpha / 255.0f;
+    float destAlpha = p[3] / 255.0f;
+    float outAlpha = srcAlpha + destAlpha * (1.0f - srcAlpha);
+    float destWeight = destAlpha * (1.0f - srcAlpha);
+    p[0] = static_cast<uint8_t>((r * srcAlpha + p[0] * destWeight) / outAlpha);
+    p[1] = static_cast<uint8_t>((g * srcAlpha + p[1] * destWeight) / outAlpha);
+    p[2] = static_cast<uint8_t>((b * srcAlpha + p[2] * destWeight) / outAlpha);
+    p[3] = static_cast<uint8_t>(outAlpha * 255.0f);
+}
+
+#if AIMH_SPAN_SSE2
+inline __m128i div255x8(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// True when all four pixels in v have alpha 255
+inline bool allOpaque(__m128i v) {
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    __m128i opaque = _mm_cmpeq_epi32(_mm_and_si128(v, alphaMask), alphaMask);
+    return _mm_movemask_epi8(opaque) == 0xFFFF;
+}
+#endif
+
+#if AIMH_SPAN_NEON
+inline uint8x8_t div255x8(uint16x8_t x) {
+    return vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8);
+}
+#endif
+
+} // namespace
+
+void SpanRasterizer::fill(uint8_t* dst, int count, const Color& color) {
+    uint32_t pattern = packColor(color);
+    int i = 0;
+
+#if AIMH_SPAN_SSE2
+    __m128i wide = _mm_set1_epi32(static_cast<int>(pattern));
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), wide);
+    }
+#elif AIMH_SPAN_NEON
+    uint32x4_t wide = vdupq_n_u32(pattern);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_u8(dst + i * 4, vreinterpretq_u8_u32(wide));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        std::memcpy(dst + i * 4, &pattern, sizeof(pattern));
+    }
+}
+
+void SpanRasterizer::blend(uint8_t* dst, int count, const Color& color) {
+    if (color.a == 255) {
+        fill(dst, count, color);
+        return;
+    }
+    if (color.a == 0) {
+        return;
+    }
+
+    int i = 0;
+
+#if AIMH_SPAN_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i inv = _mm_set1_epi16(static_cast<short>(255 - color.a));
+    // Alpha lane uses 255 so opaque destinations stay opaque
+    const __m128i src = _mm_mullo_epi16(
+        _mm_set_epi16(255, color.b, color.g, color.r, 255, color.b, color.g, color.r),
+        _mm_set1_epi16(color.a));
+
+    for (; i + 4 <= count; i += 4) {
+        uint8_t* p = dst + i * 4;
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        if (!allOpaque(v)) {
+            for (int k = 0; k < 4; ++k) {
+                blendPixel(p + k * 4, color.r, color.g, color.b, color.a);
+            }
+            continue;
+        }
+
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        lo = div255x8(_mm_add_epi16(_mm_mullo_epi16(lo, inv), src));
+        hi = div255x8(_mm_add_epi16(_mm_mullo_epi16(hi, inv), src));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_packus_epi16(lo, hi));
+    }
+#elif AIMH_SPAN_NEON
+    const uint8x8_t alpha = vdup_n_u8(color.a);
+    const uint8x8_t inv = vdup_n_u8(static_cast<uint8_t>(255 - color.a));
+    const uint8_t channels[3] = {color.r, color.g, color.b};
+
+    for (; i + 8 <= count; i += 8) {
+        uint8_t* p = dst + i * 4;
+        uint8x8x4_t px = vld4_u8(p);
+        if (vminv_u8(px.val[3]) != 255) {
+            for (int k = 0; k < 8; ++k) {
+                blendPixel(p + k * 4, color.r, color.g, color.b, color.a);
+            }
+            continue;
+        }
+
+        for (int c = 0; c < 3; ++c) {
+            uint16x8_t x = vmull_u8(px.val[c], inv);
+            x = vmlal_u8(x, vdup_n_u8(channels[c]), alpha);
+            px.val[c] = div255x8(x);
+        }
+        vst4_u8(p, px);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        blendPixel(dst + i * 4, color.r, color.g, color.b, color.a);
+    }
+}
+
+void SpanRasterizer::blendMask(uint8_t* dst, const uint8_t* coverage, int count, const Color& color) {
+    if (color.a == 0) {
+        return;
+    }
+
+    int i = 0;
+
+#if AIMH_SPAN_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i colorAlpha = _mm_set1_epi16(color.a);
+    const __m128i src = _mm_set_epi16(255, color.b, color.g, color.r, 255, color.b, color.g, color.r);
+
+    for (; i + 4 <= count; i += 4) {
+        uint32_t cov;
+        std::memcpy(&cov, coverage + i, sizeof(cov));
+        if (cov == 0) {
+            continue;
+        }
+
+        uint8_t* p = dst + i * 4;
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        if (!allOpaque(v)) {
+            for (int k = 0; k < 4; ++k) {
+                blendPixel(p + k * 4, color.r, color.g, color.b, div255(color.a * coverage[i + k]));
+            }
+            continue;
+        }
+
+        // Per-pixel alpha, then broadcast each pixel's alpha to its 4 lanes
+        __m128i alpha = div255x8(_mm_mullo_epi16(
+            _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(cov)), zero), colorAlpha));
+        __m128i pairs = _mm_unpacklo_epi16(alpha, alpha);
+        __m128i alphaLo = _mm_unpacklo_epi32(pairs, pairs);
+        __m128i alphaHi = _mm_unpackhi_epi32(pairs, pairs);
+
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        lo = div255x8(_mm_add_epi16(_mm_mullo_epi16(lo, _mm_sub_epi16(full, alphaLo)),
+                                    _mm_mullo_epi16(src, alphaLo)));
+        hi = div255x8(_mm_add_epi16(_mm_mullo_epi16(hi, _mm_sub_epi16(full, alphaHi)),
+                                    _mm_mullo_epi16(src, alphaHi)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_packus_epi16(lo, hi));
+    }
+#elif AIMH_SPAN_NEON
+    const uint8x8_t colorAlpha = vdup_n_u8(color.a);
+    const uint8_t channels[3] = {color.r, color.g, color.b};
+
+    for (; i + 8 <= count; i += 8) {
+        uint8x8_t cov = vld1_u8(coverage + i);
+        if (vmaxv_u8(cov) == 0) {
+            continue;
+        }
+
+        uint8_t* p = dst + i * 4;
+        uint8x8x4_t px = vld4_u8(p);
+        if (vminv_u8(px.val[3]) != 255) {
+            for (int k = 0; k < 8; ++k) {
+                blendPixel(p + k * 4, color.r, color.g, color.b, div255(color.a * coverage[i + k]));
+            }
+            continue;
+        }
+
+        uint8x8_t alpha = div255x8(vmull_u8(cov, colorAlpha));
+        uint8x8_t inv = vmvn_u8(alpha);
+        for (int c = 0; c < 3; ++c) {
+            uint16x8_t x = vmull_u8(px.val[c], inv);
+            x = vmlal_u8(x, vdup_n_u8(channels[c]), alpha);
+            px.val[c] = div255x8(x);
+        }
+        vst4_u8(p, px);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        blendPixel(dst + i * 4, color.r, color.g, color.b, div255(color.a * coverage[i]));
+    }
+}
+
+void SpanRasterizer::add(uint8_t* dst, int count, const Color& color) {
+    int i = 0;
+
+#if AIMH_SPAN_SSE2
+    // Saturating add on RGB, max on alpha
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128i src = _mm_set1_epi32(static_cast<int>(packColor(color)));
+    const __m128i srcRgb = _mm_andnot_si128(alphaMask, src);
+    for (; i + 4 <= count; i += 4) {
+        uint8_t* p = dst + i * 4;
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i rgb = _mm_andnot_si128(alphaMask, _mm_adds_epu8(v, srcRgb));
+        __m128i a = _mm_and_si128(alphaMask, _mm_max_epu8(v, src));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_or_si128(rgb, a));
+    }
+#elif AIMH_SPAN_NEON
+    const uint32x4_t alphaMask = vdupq_n_u32(0xFF000000u);
+    const uint8x16_t src = vreinterpretq_u8_u32(vdupq_n_u32(packColor(color)));
+    const uint8x16_t srcRgb = vbicq_u8(src, vreinterpretq_u8_u32(alphaMask));
+    for (; i + 4 <= count; i += 4) {
+        uint8_t* p = dst + i * 4;
+        uint8x16_t v = vld1q_u8(p);
+        uint8x16_t sum = vqaddq_u8(v, srcRgb);
+        uint8x16_t maxed = vmaxq_u8(v, src);
+        vst1q_u8(p, vbslq_u8(vreinterpretq_u8_u32(alphaMask), maxed, sum));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        uint8_t* p = dst + i * 4;
+        p[0] = static_cast<uint8_t>(std::min(255, p[0] + color.r));
+        p[1] = static_cast<uint8_t>(std::min(255, p[1] + color.g));
+        p[2] = static_cast<uint8_t>(std::min(255, p[2] + color.b));
+        p[3] = std::max(p[3], color.a);
+    }
+}
+
+void SpanRasterizer::multiply(uint8_t* dst, int count, const Color& color) {
+    for (int i = 0; i < count; ++i) {
+        uint8_t* p = dst + i * 4;
+        p[0] = static_cast<uint8_t>((p[0] * color.r) / 255);
+        p[1] = static_cast<uint8_t>((p[1] * color.g) / 255);
+        p[2] = static_cast<uint8_t>((p[2] * color.b) / 255);
+        p[3] = static_cast<uint8_t>((p[3] * color.a) / 255);
+    }
+}
+
+const char* SpanRasterizer::backendName() {
+#if AIMH_SPAN_SSE2
+    return "SSE2";
+#elif AIMH_SPAN_NEON
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+void SpanRasterizer::blendReference(uint8_t* dst, int count, const Color& color) {
+    for (int i = 0; i < count; ++i) {
+        blendPixel(dst + i * 4, color.r, color.g, color.b, color.a);
+    }
+}
+
+void SpanRasterizer::blendMaskReference(uint8_t* dst, const uint8_t* coverage, int count,
+                                        const Color& color) {
+    for (int i = 0; i < count; ++i) {
+        blendPixel(dst + i * 4, color.r, color.g, color.b, div255(color.a * coverage[i]));
+    }
+}
+
+} // namespace AIMusicHardware
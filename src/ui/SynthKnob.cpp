@@ -119,6 +119,12 @@ bool SynthKnob::handleInput(const InputEvent& event) {
 }
 
 void SynthKnob::update(float deltaTime) {
+    // Redraw while the value animates or the tooltip fades
+    if ((animateValueChanges_ && animationProgress_ < 1.0f) ||
+        (tooltipAlpha_ > 0.0f) || isRecentlyInteracted()) {
+        markDirty();
+    }
+    
     // Update animation
     if (animateValueChanges_) {
         updateAnimation(deltaTime);
@@ -135,6 +141,7 @@ void SynthKnob::update(float deltaTime) {
             isAutomated_ = false;
             is_being_automated_ = false;
             automationTimer = 0.0f;
+            markDirty();
         }
     }
 }
@@ -287,6 +294,14 @@ void SynthKnob::drawModulationRing(DisplayManager* displayManager, int centerX,
     }
 }
 
+Rect SynthKnob::getPaintBounds() const {
+    // Tooltip sits 25px above the knob and is sized from the value text
+    int tooltipHalfWidth = static_cast<int>(getValueDisplayString().length() * 4) + 8;
+    int centerX = x_ + width_ / 2;
+    return Knob::getPaintBounds().united(
+        Rect(centerX - tooltipHalfWidth, y_ - 25, tooltipHalfWidth * 2 + 1, 25));
+}
+
 void SynthKnob::drawValueTooltip(DisplayManager* displayManager) {
     std::string valueStr = getValueDisplayString();
     
@@ -20,6 +20,7 @@ Label::~Label() {
 
 void Label::setText(const std::string& text) {
     text_ = text;
+    markDirty();
 }
 
 const std::string& Label::getText() const {
@@ -28,6 +29,7 @@ const std::string& Label::getText() const {
 
 void Label::setFontName(const std::string& fontName) {
     fontName_ = fontName;
+    markDirty();
 }
 
 const std::string& Label::getFontName() const {
@@ -36,6 +38,7 @@ const std::string& Label::getFontName() const {
 
 void Label::setTextColor(const Color& color) {
     textColor_ = color;
+    markDirty();
 }
 
 const Color& Label::getTextColor() const {
@@ -44,6 +47,7 @@ const Color& Label::getTextColor() const {
 
 void Label::setTextAlignment(int alignment) {
     alignment_ = std::clamp(alignment, 0, 2);
+    markDirty();
 }
 
 int Label::getTextAlignment() const {
@@ -96,6 +100,7 @@ Icon::~Icon() {
 
 void Icon::setIconCode(int iconCode) {
     iconCode_ = iconCode;
+    markDirty();
 }
 
 int Icon::getIconCode() const {
@@ -104,6 +109,7 @@ int Icon::getIconCode() const {
 
 void Icon::setColor(const Color& color) {
     color_ = color;
+    markDirty();
 }
 
 const Color& Icon::getColor() const {
@@ -112,6 +118,7 @@ const Color& Icon::getColor() const {
 
 void Icon::setScale(float scale) {
     scale_ = std::max(0.1f, scale);
+    markDirty();
 }
 
 float Icon::getScale() const {
@@ -169,6 +176,7 @@ Button::~Button() {
 
 void Button::setText(const std::string& text) {
     text_ = text;
+    markDirty();
 }
 
 const std::string& Button::getText() const {
@@ -177,6 +185,7 @@ const std::string& Button::getText() const {
 
 void Button::setIconCode(int iconCode) {
     iconCode_ = iconCode;
+    markDirty();
 }
 
 int Button::getIconCode() const {
@@ -185,14 +194,17 @@ int Button::getIconCode() const {
 
 void Button::setTextColor(const Color& color) {
     textColor_ = color;
+    markDirty();
 }
 
 void Button::setBackgroundColor(const Color& color) {
     backgroundColor_ = color;
+    markDirty();
 }
 
 void Button::setHighlightColor(const Color& color) {
     highlightColor_ = color;
+    markDirty();
 }
 
 void Button::setClickCallback(ClickCallback callback) {
@@ -201,6 +213,7 @@ void Button::setClickCallback(ClickCallback callback) {
 
 void Button::setPressed(bool pressed) {
     pressed_ = pressed;
+    markDirty();
 }
 
 bool Button::isPressed() const {
@@ -209,6 +222,7 @@ bool Button::isPressed() const {
 
 void Button::setToggleMode(bool toggleMode) {
     toggleMode_ = toggleMode;
+    markDirty();
 }
 
 bool Button::isToggleMode() const {
@@ -217,6 +231,7 @@ bool Button::isToggleMode() const {
 
 void Button::setToggled(bool toggled) {
     toggled_ = toggled;
+    markDirty();
 }
 
 bool Button::isToggled() const {
@@ -273,6 +288,7 @@ bool Button::handleInput(const InputEvent& event) {
             event.value2 >= y_ && event.value2 < y_ + height_) {
             pressed_ = true;
             handled = true;
+            markDirty();
         }
     } else if (event.type == InputEventType::ButtonRelease ||
                event.type == InputEventType::TouchRelease) {
@@ -293,7 +309,10 @@ bool Button::handleInput(const InputEvent& event) {
             handled = true;
         }
         
-        pressed_ = false;
+        if (pressed_) {
+            pressed_ = false;
+            markDirty();
+        }
     }
     
     if (!handled) {
@@ -331,6 +350,7 @@ void Knob::setValue(float value) {
     if (valueChangeCallback_) {
         valueChangeCallback_(value_);
     }
+    markDirty();
 }
 
 float Knob::getValue() const {
@@ -343,6 +363,7 @@ void Knob::setRange(float min, float max) {
     
     // Ensure value is within new range
     setValue(value_);
+    markDirty();
 }
 
 void Knob::getRange(float& min, float& max) const {
@@ -360,6 +381,7 @@ float Knob::getStep() const {
 
 void Knob::setLabel(const std::string& label) {
     label_ = label;
+    markDirty();
 }
 
 const std::string& Knob::getLabel() const {
@@ -368,10 +390,12 @@ const std::string& Knob::getLabel() const {
 
 void Knob::setValueFormatter(std::function<std::string(float)> formatter) {
     valueFormatter_ = formatter;
+    markDirty();
 }
 
 void Knob::showValue(bool show) {
     showValue_ = show;
+    markDirty();
 }
 
 bool Knob::isShowingValue() const {
@@ -380,14 +404,17 @@ bool Knob::isShowingValue() const {
 
 void Knob::setColor(const Color& color) {
     color_ = color;
+    markDirty();
 }
 
 void Knob::setBackgroundColor(const Color& color) {
     backgroundColor_ = color;
+    markDirty();
 }
 
 void Knob::setModulationAmount(float amount) {
     modulationAmount_ = std::clamp(amount, 0.0f, 1.0f);
+    markDirty();
 }
 
 float Knob::getModulationAmount() const {
@@ -396,6 +423,7 @@ float Knob::getModulationAmount() const {
 
 void Knob::setModulationColor(const Color& color) {
     modulationColor_ = color;
+    markDirty();
 }
 
 const Color& Knob::getModulationColor() const {
@@ -412,6 +440,7 @@ const std::string& Knob::getParameterId() const {
 
 void Knob::setMidiLearnEnabled(bool enabled) {
     midiLearnEnabled_ = enabled;
+    markDirty();
 }
 
 bool Knob::isMidiLearnEnabled() const {
@@ -420,6 +449,7 @@ bool Knob::isMidiLearnEnabled() const {
 
 void Knob::setMidiControlNumber(int ccNumber) {
     midiControlNumber_ = ccNumber;
+    markDirty();
 }
 
 int Knob::getMidiControlNumber() const {
@@ -434,6 +464,16 @@ void Knob::update(float deltaTime) {
     // Knobs typically don't need per-frame updates
 }
 
+Rect Knob::getPaintBounds() const {
+    // Label, value and CC text are drawn up to ~65px below the knob and
+    // centered on it, so they can be wider than the knob itself
+    int textHalfWidth = static_cast<int>(std::max<size_t>(label_.length(), 12)) * 4 + 8;
+    int centerX = x_ + width_ / 2;
+    int left = std::min(x_, centerX - textHalfWidth);
+    int right = std::max(x_ + width_, centerX + textHalfWidth);
+    return Rect(left, y_, right - left, height_ + 70);
+}
+
 void Knob::render(DisplayManager* display) {
     if (!display) {
         return;
@@ -715,6 +755,7 @@ void WaveformDisplay::setSamples(const std::vector<float>& samples) {
     for (size_t i = 0; i < samples.size() && samples_.size() < maxSamples_; i++) {
         samples_.push_back(samples[i]);
     }
+    markDirty();
 }
 
 void WaveformDisplay::addSample(float sample) {
@@ -725,26 +766,32 @@ void WaveformDisplay::addSample(float sample) {
     if (samples_.size() > maxSamples_) {
         samples_.pop_front();
     }
+    markDirty();
 }
 
 void WaveformDisplay::clearSamples() {
     samples_.clear();
+    markDirty();
 }
 
 void WaveformDisplay::setWaveformColor(const Color& color) {
     waveformColor_ = color;
+    markDirty();
 }
 
 void WaveformDisplay::setBackgroundColor(const Color& color) {
     backgroundColor_ = color;
+    markDirty();
 }
 
 void WaveformDisplay::setGridColor(const Color& color) {
     gridColor_ = color;
+    markDirty();
 }
 
 void WaveformDisplay::showGrid(bool show) {
     showGrid_ = show;
+    markDirty();
 }
 
 void WaveformDisplay::update(float deltaTime) {
@@ -856,6 +903,7 @@ void Slider::setValue(float value) {
     if (valueChangeCallback_) {
         valueChangeCallback_(value_);
     }
+    markDirty();
 }
 
 float Slider::getValue() const {
@@ -866,6 +914,7 @@ void Slider::setRange(float min, float max) {
     minValue_ = min;
     maxValue_ = max;
     value_ = std::clamp(value_, minValue_, maxValue_);
+    markDirty();
 }
 
 void Slider::setStep(float step) {
@@ -874,6 +923,7 @@ void Slider::setStep(float step) {
 
 void Slider::setOrientation(Orientation orientation) {
     orientation_ = orientation;
+    markDirty();
 }
 
 Slider::Orientation Slider::getOrientation() const {
@@ -882,46 +932,57 @@ Slider::Orientation Slider::getOrientation() const {
 
 void Slider::setLabel(const std::string& label) {
     label_ = label;
+    markDirty();
 }
 
 void Slider::setColor(const Color& color) {
     color_ = color;
+    markDirty();
 }
 
 void Slider::setBackgroundColor(const Color& color) {
     backgroundColor_ = color;
+    markDirty();
 }
 
 void Slider::setTrackColor(const Color& color) {
     trackColor_ = color;
+    markDirty();
 }
 
 void Slider::setThumbColor(const Color& color) {
     thumbColor_ = color;
+    markDirty();
 }
 
 void Slider::setShowValue(bool show) {
     showValue_ = show;
+    markDirty();
 }
 
 void Slider::setValueFormatter(std::function<std::string(float)> formatter) {
     valueFormatter_ = formatter;
+    markDirty();
 }
 
 void Slider::setModulationAmount(float amount) {
     modulationAmount_ = amount;
+    markDirty();
 }
 
 void Slider::setModulationColor(const Color& color) {
     modulationColor_ = color;
+    markDirty();
 }
 
 void Slider::setMidiLearnEnabled(bool enabled) {
     midiLearnEnabled_ = enabled;
+    markDirty();
 }
 
 void Slider::setMidiControlNumber(int ccNumber) {
     midiControlNumber_ = ccNumber;
+    markDirty();
 }
 
 void Slider::setValueChangeCallback(ValueChangeCallback callback) {
@@ -1079,6 +1140,7 @@ void EnvelopeEditor::setAttack(float attack) {
     if (envelopeChangeCallback_) {
         envelopeChangeCallback_(attack_, decay_, sustain_, release_);
     }
+    markDirty();
 }
 
 float EnvelopeEditor::getAttack() const {
@@ -1090,6 +1152,7 @@ void EnvelopeEditor::setDecay(float decay) {
     if (envelopeChangeCallback_) {
         envelopeChangeCallback_(attack_, decay_, sustain_, release_);
     }
+    markDirty();
 }
 
 float EnvelopeEditor::getDecay() const {
@@ -1101,6 +1164,7 @@ void EnvelopeEditor::setSustain(float sustain) {
     if (envelopeChangeCallback_) {
         envelopeChangeCallback_(attack_, decay_, sustain_, release_);
     }
+    markDirty();
 }
 
 float EnvelopeEditor::getSustain() const {
@@ -1112,6 +1176,7 @@ void EnvelopeEditor::setRelease(float release) {
     if (envelopeChangeCallback_) {
         envelopeChangeCallback_(attack_, decay_, sustain_, release_);
     }
+    markDirty();
 }
 
 float EnvelopeEditor::getRelease() const {
@@ -1120,14 +1185,17 @@ float EnvelopeEditor::getRelease() const {
 
 void EnvelopeEditor::setLineColor(const Color& color) {
     lineColor_ = color;
+    markDirty();
 }
 
 void EnvelopeEditor::setBackgroundColor(const Color& color) {
     backgroundColor_ = color;
+    markDirty();
 }
 
 void EnvelopeEditor::setHandleColor(const Color& color) {
     handleColor_ = color;
+    markDirty();
 }
 
 void EnvelopeEditor::setEnvelopeChangeCallback(EnvelopeChangeCallback callback) {
@@ -1305,6 +1373,7 @@ void SequencerGrid::setGridSize(int rows, int columns) {
     if (playbackPosition_ >= columns_) {
         playbackPosition_ = -1;
     }
+    markDirty();
 }
 
 void SequencerGrid::getGridSize(int& rows, int& columns) const {
@@ -1322,6 +1391,7 @@ void SequencerGrid::setCellActive(int row, int column, bool active) {
             cellChangeCallback_(row, column, active);
         }
     }
+    markDirty();
 }
 
 bool SequencerGrid::isCellActive(int row, int column) const {
@@ -1333,26 +1403,32 @@ bool SequencerGrid::isCellActive(int row, int column) const {
 
 void SequencerGrid::clearAllCells() {
     std::fill(cells_.begin(), cells_.end(), false);
+    markDirty();
 }
 
 void SequencerGrid::setActiveColor(const Color& color) {
     activeColor_ = color;
+    markDirty();
 }
 
 void SequencerGrid::setInactiveColor(const Color& color) {
     inactiveColor_ = color;
+    markDirty();
 }
 
 void SequencerGrid::setCursorColor(const Color& color) {
     cursorColor_ = color;
+    markDirty();
 }
 
 void SequencerGrid::setGridLineColor(const Color& color) {
     gridLineColor_ = color;
+    markDirty();
 }
 
 void SequencerGrid::setPlaybackPosition(int column) {
     playbackPosition_ = column;
+    markDirty();
 }
 
 int SequencerGrid::getPlaybackPosition() const {
@@ -1488,6 +1564,7 @@ void SequencerGrid::moveCursor(int deltaRow, int deltaColumn) {
     
     cursorColumn_ = (cursorColumn_ + deltaColumn) % columns_;
     if (cursorColumn_ < 0) cursorColumn_ += columns_;
+    markDirty();
 }
 
 void SequencerGrid::toggleCurrentCell() {
@@ -1512,11 +1589,13 @@ void IconSelector::addIcon(int iconCode, const std::string& tooltip) {
     item.iconCode = iconCode;
     item.tooltip = tooltip;
     icons_.push_back(item);
+    markDirty();
 }
 
 void IconSelector::clearIcons() {
     icons_.clear();
     selectedIndex_ = 0;
+    markDirty();
 }
 
 int IconSelector::getSelectedIconIndex() const {
@@ -1532,18 +1611,22 @@ void IconSelector::setSelectedIconIndex(int index) {
             selectionChangeCallback_(selectedIndex_);
         }
     }
+    markDirty();
 }
 
 void IconSelector::setSelectedColor(const Color& color) {
     selectedColor_ = color;
+    markDirty();
 }
 
 void IconSelector::setUnselectedColor(const Color& color) {
     unselectedColor_ = color;
+    markDirty();
 }
 
 void IconSelector::setBackgroundColor(const Color& color) {
     backgroundColor_ = color;
+    markDirty();
 }
 
 void IconSelector::setSelectionChangeCallback(SelectionChangeCallback callback) {
@@ -1714,6 +1797,7 @@ void VUMeter::setLevel(float level) {
         rightPeakLevel_ = level;
         rightPeakHoldTimer_ = peakHoldTime_;
     }
+    markDirty();
 }
 
 void VUMeter::setLevels(float leftLevel, float rightLevel) {
@@ -1733,6 +1817,7 @@ void VUMeter::setLevels(float leftLevel, float rightLevel) {
         rightPeakLevel_ = rightLevel;
         rightPeakHoldTimer_ = peakHoldTime_;
     }
+    markDirty();
 }
 
 float VUMeter::getLevel() const {
@@ -1746,6 +1831,7 @@ void VUMeter::getLevels(float& leftLevel, float& rightLevel) const {
 
 void VUMeter::setStereo(bool stereo) {
     stereo_ = stereo;
+    markDirty();
 }
 
 bool VUMeter::isStereo() const {
@@ -1762,14 +1848,17 @@ float VUMeter::getPeakHoldTime() const {
 
 void VUMeter::setBackgroundColor(const Color& color) {
     backgroundColor_ = color;
+    markDirty();
 }
 
 void VUMeter::setLevelColor(const Color& color) {
     levelColor_ = color;
+    markDirty();
 }
 
 void VUMeter::setPeakColor(const Color& color) {
     peakColor_ = color;
+    markDirty();
 }
 
 void VUMeter::update(float deltaTime) {
@@ -1779,6 +1868,7 @@ void VUMeter::update(float deltaTime) {
         if (leftPeakHoldTimer_ <= 0.0f) {
             leftPeakHoldTimer_ = 0.0f;
             leftPeakLevel_ = leftLevel_; // Reset to current level
+            markDirty();
         }
     }
     
@@ -1787,6 +1877,7 @@ void VUMeter::update(float deltaTime) {
         if (rightPeakHoldTimer_ <= 0.0f) {
             rightPeakHoldTimer_ = 0.0f;
             rightPeakLevel_ = rightLevel_; // Reset to current level
+            markDirty();
         }
     }
 }
@@ -1975,6 +2066,7 @@ ParameterPanel::~ParameterPanel() {
 
 void ParameterPanel::setTitle(const std::string& title) {
     title_ = title;
+    markDirty();
 }
 
 const std::string& ParameterPanel::getTitle() const {
@@ -2087,14 +2179,17 @@ void ParameterPanel::clearAllMidiMappings() {
 
 void ParameterPanel::setBackgroundColor(const Color& color) {
     backgroundColor_ = color;
+    markDirty();
 }
 
 void ParameterPanel::setTitleColor(const Color& color) {
     titleColor_ = color;
+    markDirty();
 }
 
 void ParameterPanel::setBorderColor(const Color& color) {
     borderColor_ = color;
+    markDirty();
 }
 
 void ParameterPanel::update(float deltaTime) {
@@ -2218,6 +2313,7 @@ void TabView::addTab(const std::string& tabId, const std::string& tabName) {
     // Update layout
     updateTabLayout();
     updateContentVisibility();
+    markDirty();
 }
 
 void TabView::addComponentToTab(const std::string& tabId, UIComponent* component) {
@@ -2298,6 +2394,7 @@ void TabView::setTabName(const std::string& tabId, const std::string& newName) {
     if (tabIndex >= 0) {
         tabs_[tabIndex].name = newName;
     }
+    markDirty();
 }
 
 void TabView::setActiveTab(const std::string& tabId) {
@@ -2306,6 +2403,7 @@ void TabView::setActiveTab(const std::string& tabId) {
         activeTabIndex_ = tabIndex;
         updateContentVisibility();
     }
+    markDirty();
 }
 
 std::string TabView::getActiveTabId() const {
@@ -2339,18 +2437,22 @@ void TabView::previousTab() {
 
 void TabView::setTabBackgroundColor(const Color& color) {
     tabBackgroundColor_ = color;
+    markDirty();
 }
 
 void TabView::setTabActiveColor(const Color& color) {
     tabActiveColor_ = color;
+    markDirty();
 }
 
 void TabView::setTabTextColor(const Color& color) {
     tabTextColor_ = color;
+    markDirty();
 }
 
 void TabView::setContentBackgroundColor(const Color& color) {
     contentBackgroundColor_ = color;
+    markDirty();
 }
 
 void TabView::update(float deltaTime) {
@@ -8,7 +8,8 @@ namespace AIMusicHardware {
 // UIComponent implementation
 //
 UIComponent::UIComponent(const std::string& id)
-    : id_(id), x_(0), y_(0), width_(0), height_(0), visible_(true), enabled_(true) {
+    : id_(id), x_(0), y_(0), width_(0), height_(0), visible_(true), enabled_(true),
+      dirty_(true), removedUnbounded_(false) {
 }
 
 UIComponent::~UIComponent() {
@@ -36,15 +37,65 @@ void UIComponent::removeChild(const std::string& id) {
                            });
     
     if (it != children_.end()) {
+        for (auto removed = it; removed != children_.end(); ++removed) {
+            discardPaintedArea(**removed);
+        }
         children_.erase(it, children_.end());
     }
 }
 
+void UIComponent::discardPaintedArea(const UIComponent& removed) {
+    if (removed.width_ <= 0 || removed.height_ <= 0) {
+        removedUnbounded_ = true;
+    }
+    removedArea_ = removedArea_.united(removed.paintedBounds_);
+    removedArea_ = removedArea_.united(removed.removedArea_);
+    removedUnbounded_ = removedUnbounded_ || removed.removedUnbounded_;
+    
+    for (const auto& child : removed.children_) {
+        discardPaintedArea(*child);
+    }
+}
+
+void UIComponent::collectDamage(DisplayManager* display) {
+    if (removedUnbounded_) {
+        display->addFullDamage();
+    } else if (!removedArea_.isEmpty()) {
+        display->addDamage(removedArea_);
+    }
+    removedArea_ = Rect();
+    removedUnbounded_ = false;
+    
+    if (dirty_) {
+        if (width_ <= 0 || height_ <= 0) {
+            // No layout size to go by, so the component could draw anywhere
+            display->addFullDamage();
+        } else {
+            display->addDamage(paintedBounds_);
+            paintedBounds_ = visible_ ? getPaintBounds() : Rect();
+            display->addDamage(paintedBounds_);
+        }
+        dirty_ = false;
+    }
+    
+    for (auto& child : children_) {
+        child->collectDamage(display);
+    }
+}
+
 void UIComponent::renderChildren(DisplayManager* display) {
     for (auto& child : children_) {
-        if (child->isVisible()) {
-            child->render(display);
+        if (!child->isVisible()) {
+            continue;
+        }
+        
+        // Skip children that cannot touch the region being redrawn
+        if (!child->getBounds().isEmpty() &&
+            !display->intersectsClip(child->getPaintBounds())) {
+            continue;
         }
+        
+        child->render(display);
     }
 }
 
@@ -54,6 +105,8 @@ bool UIComponent::handleChildrenInput(const InputEvent& event) {
         auto& child = *it;
         if (child->isVisible() && child->isEnabled()) {
             if (child->handleInput(event)) {
+                // Handled input almost always changes how the child looks
+                child->markDirty();
                 return true;
             }
         }
@@ -101,7 +154,8 @@ bool Screen::handleInput(const InputEvent& event) {
 // UIContext implementation
 //
 UIContext::UIContext()
-    : activeScreenId_(""), synth_(nullptr), effectProcessor_(nullptr),
+    : activeScreenId_(""), renderedScreen_(nullptr), synth_(nullptr),
+      effectProcessor_(nullptr),
       sequencer_(nullptr), hardware_(nullptr), adaptiveSequencer_(nullptr),
       llmInterface_(nullptr) {
 }
@@ -117,6 +171,9 @@ bool UIContext::initialize(int width, int height) {
         return false;
     }
     
+    // The software framebuffer keeps the previous frame, so only redraw damage
+    displayManager_->setDamageTracking(true);
+    
     // Set up default theme colors
     themeColors_["background"] = Color(40, 40, 40);
     themeColors_["foreground"] = Color(230, 230, 230);
@@ -132,6 +189,7 @@ void UIContext::shutdown() {
     // Clean up resources
     screens_.clear();
     fonts_.clear();
+    renderedScreen_ = nullptr;
     
     if (displayManager_) {
         displayManager_->shutdown();
@@ -185,8 +243,14 @@ void UIContext::update(float deltaTime) {
 }
 
 void UIContext::render() {
-    // Clear the display
     Screen* activeScreen = getScreen(activeScreenId_);
+    if (displayManager_->isDamageTracking()) {
+        renderDamage(activeScreen);
+        displayManager_->swapBuffers();
+        return;
+    }
+    
+    // Clear the display
     if (activeScreen) {
         displayManager_->clear(activeScreen->getBackgroundColor());
         
@@ -200,6 +264,32 @@ void UIContext::render() {
     displayManager_->swapBuffers();
 }
 
+void UIContext::renderDamage(Screen* activeScreen) {
+    DisplayManager* display = displayManager_.get();
+    
+    // A different screen, or a change to the screen itself, repaints everything
+    if (activeScreen != renderedScreen_ || (activeScreen && activeScreen->isDirty())) {
+        display->addFullDamage();
+        renderedScreen_ = activeScreen;
+    }
+    
+    if (activeScreen) {
+        activeScreen->collectDamage(display);
+    }
+    
+    // Repaint each damaged region with all drawing clipped to it
+    for (const Rect& region : display->getDamageRegions()) {
+        display->beginDamageRegion(region);
+        if (activeScreen) {
+            display->clear(activeScreen->getBackgroundColor());
+            activeScreen->render(display);
+        } else {
+            display->clear();
+        }
+        display->endDamageRegion();
+    }
+}
+
 bool UIContext::handleInput(const InputEvent& event) {
     // Pass the input to the active screen
     Screen* activeScreen = getScreen(activeScreenId_);
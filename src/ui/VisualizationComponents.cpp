@@ -5,13 +5,40 @@
 namespace AIMusicHardware {
 
 // WaveformVisualizer implementation
+namespace {
+constexpr int kDefaultSpectrumBands = 64;
+
+// Map a linear magnitude onto 0-1 over a -60 dB..0 dB display range
+float normalizedLevel(float magnitude) {
+    float dB = 20.0f * std::log10(magnitude + 0.00001f);
+    return std::clamp((dB + 60.0f) / 60.0f, 0.0f, 1.0f);
+}
+
+uint32_t nextPowerOfTwo(uint32_t value) {
+    uint32_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+} // namespace
+
 WaveformVisualizer::WaveformVisualizer(const std::string& id, int bufferSize)
     : UIComponent(id)
-    , bufferSize_(bufferSize) {
+    , bufferSize_(std::max(4, bufferSize))
+    , fft_(std::max(4, bufferSize)) {
+    
+    // Headroom so the UI can fall a few frames behind without reading torn data
+    uint32_t ringFrames = nextPowerOfTwo(static_cast<uint32_t>(bufferSize_)) * 4;
+    captureRing_ = std::make_unique<CaptureFrame[]>(ringFrames);
+    captureMask_ = ringFrames - 1;
+    
+    audioBuffer_.assign(bufferSize_ * 2, 0.0f); // Stereo snapshot
+    snapshotScratch_.assign(bufferSize_ * 2, 0.0f);
+    monoBuffer_.assign(fft_.getSize(), 0.0f);
+    fftMagnitudes_.assign(fft_.getNumBins(), 0.0f);
     
-    audioBuffer_.resize(bufferSize * 2); // Stereo buffer
-    fftMagnitudes_.resize(bufferSize / 2);
-    fftPhases_.resize(bufferSize / 2);
+    setSpectrumBandCount(kDefaultSpectrumBands);
 }
 
 WaveformVisualizer::~WaveformVisualizer() = default;
@@ -19,38 +46,98 @@ WaveformVisualizer::~WaveformVisualizer() = default;
 void WaveformVisualizer::pushSamples(const float* samples, int numSamples, int channels) {
     if (!samples || numSamples <= 0) return;
     
-    std::lock_guard<std::mutex> lock(bufferMutex_);
+    uint64_t count = writeCount_.load(std::memory_order_relaxed);
     
-    int writeIdx = writePos_.load(std::memory_order_relaxed);
+    // Only the newest ring-full of a very large block can survive anyway
+    int ringFrames = static_cast<int>(captureMask_) + 1;
+    int skip = std::max(0, numSamples - ringFrames);
     
-    for (int i = 0; i < numSamples; ++i) {
-        if (channels == 2) {
-            // Stereo: interleave samples
-            audioBuffer_[writeIdx * 2] = samples[i * 2];
-            audioBuffer_[writeIdx * 2 + 1] = samples[i * 2 + 1];
-        } else {
-            // Mono: duplicate to both channels
-            audioBuffer_[writeIdx * 2] = samples[i];
-            audioBuffer_[writeIdx * 2 + 1] = samples[i];
+    for (int i = skip; i < numSamples; ++i) {
+        const uint64_t frameIndex = count + i;
+        CaptureFrame& frame = captureRing_[frameIndex & captureMask_];
+        
+        // Mark the frame as being written before touching its samples
+        frame.sequence.store(frameIndex * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        
+        // Mono input is duplicated to both channels
+        frame.left.store(samples[channels == 2 ? i * 2 : i], std::memory_order_relaxed);
+        frame.right.store(samples[channels == 2 ? i * 2 + 1 : i], std::memory_order_relaxed);
+        
+        frame.sequence.store(frameIndex * 2 + 2, std::memory_order_release);
+    }
+    
+    writeCount_.store(count + numSamples, std::memory_order_release);
+}
+
+void WaveformVisualizer::setSampleRate(float sampleRate) {
+    if (sampleRate <= 0.0f || sampleRate == sampleRate_) return;
+    sampleRate_ = sampleRate;
+    bandMapper_.configure(static_cast<int>(spectrumBands_.size()), fft_.getSize(), sampleRate_);
+}
+
+void WaveformVisualizer::setSpectrumBandCount(int bands) {
+    bands = std::max(1, bands);
+    if (static_cast<int>(spectrumBands_.size()) == bands && bandMapper_.getNumBands() == bands) return;
+    
+    bandMapper_.configure(bands, fft_.getSize(), sampleRate_);
+    spectrumBands_.assign(bands, 0.0f);
+    
+    // Resizing rows invalidates the history
+    waterfallRows_.assign(static_cast<size_t>(WATERFALL_HISTORY_SIZE) * bands, 0.0f);
+    waterfallHead_ = 0;
+    waterfallCount_ = 0;
+    markDirty();
+}
+
+bool WaveformVisualizer::captureSnapshot() {
+    uint64_t end = writeCount_.load(std::memory_order_acquire);
+    if (end == lastSnapshotCount_) return false;
+    
+    uint64_t frames = std::min<uint64_t>(end, static_cast<uint64_t>(bufferSize_));
+    uint64_t start = end - frames;
+    size_t offset = static_cast<size_t>(bufferSize_ - frames) * 2;
+    std::fill(snapshotScratch_.begin(), snapshotScratch_.begin() + offset, 0.0f);
+    
+    for (uint64_t i = 0; i < frames; ++i) {
+        const uint64_t frameIndex = start + i;
+        const CaptureFrame& frame = captureRing_[frameIndex & captureMask_];
+        
+        const uint64_t before = frame.sequence.load(std::memory_order_acquire);
+        const float left = frame.left.load(std::memory_order_relaxed);
+        const float right = frame.right.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t after = frame.sequence.load(std::memory_order_relaxed);
+        
+        // The producer lapped us and is writing (or has written) a newer
+        // frame into this slot; keep the previous snapshot and retry next frame
+        if (before != after || before != frameIndex * 2 + 2) {
+            return false;
         }
         
-        writeIdx = (writeIdx + 1) % bufferSize_;
+        snapshotScratch_[offset + i * 2] = left;
+        snapshotScratch_[offset + i * 2 + 1] = right;
     }
     
-    writePos_.store(writeIdx, std::memory_order_release);
+    audioBuffer_.swap(snapshotScratch_);
+    lastSnapshotCount_ = end;
+    return true;
 }
 
 void WaveformVisualizer::update(float deltaTime) {
-    // Update waterfall history if in waterfall mode
-    if (displayMode_ == DisplayMode::Waterfall) {
+    if (!captureSnapshot()) return;
+    
+    if (displayMode_ == DisplayMode::Spectrum || displayMode_ == DisplayMode::Waterfall) {
         performFFT();
-        
-        // Add current spectrum to history
-        waterfallHistory_.push_back(fftMagnitudes_);
-        if (waterfallHistory_.size() > WATERFALL_HISTORY_SIZE) {
-            waterfallHistory_.pop_front();
-        }
     }
+    
+    // Add current spectrum to history
+    if (displayMode_ == DisplayMode::Waterfall) {
+        pushWaterfallRow();
+    }
+    
+    // Redraw only when the audio thread delivered something new
+    markDirty();
 }
 
 void WaveformVisualizer::render(DisplayManager* display) {
@@ -70,7 +157,6 @@ void WaveformVisualizer::render(DisplayManager* display) {
             drawWaveform(display);
             break;
         case DisplayMode::Spectrum:
-            performFFT();
             drawSpectrum(display);
             break;
         case DisplayMode::Waterfall:
@@ -104,12 +190,12 @@ bool WaveformVisualizer::handleInput(const InputEvent& event) {
 }
 
 void WaveformVisualizer::drawWaveform(DisplayManager* display) {
-    std::lock_guard<std::mutex> lock(bufferMutex_);
-    
     int numPoints = width_ / std::max(1, static_cast<int>(zoomLevel_));
+    if (numPoints <= 0) return;
     float xStep = static_cast<float>(width_) / numPoints;
     
-    int readIdx = readPos_.load(std::memory_order_acquire);
+    // Show the newest samples; the snapshot is ordered oldest to newest
+    int startIdx = std::max(0, bufferSize_ - numPoints);
     int centerY = y_ + height_ / 2;
     
     // Draw left channel (or mono)
@@ -117,7 +203,7 @@ void WaveformVisualizer::drawWaveform(DisplayManager* display) {
     int prevY = centerY;
     
     for (int i = 0; i < numPoints; ++i) {
-        int bufferIdx = (readIdx + i) % bufferSize_;
+        int bufferIdx = (startIdx + i) % bufferSize_;
         float sample = audioBuffer_[bufferIdx * 2]; // Left channel
         
         int x = x_ + static_cast<int>(i * xStep);
@@ -136,44 +222,40 @@ void WaveformVisualizer::drawWaveform(DisplayManager* display) {
 }
 
 void WaveformVisualizer::drawSpectrum(DisplayManager* display) {
-    int numBins = fftMagnitudes_.size();
-    if (numBins == 0) return;
+    int numBands = spectrumBands_.size();
+    if (numBands == 0) return;
     
-    float binWidth = static_cast<float>(width_) / numBins;
+    float bandWidth = static_cast<float>(width_) / numBands;
     
-    for (int i = 0; i < numBins; ++i) {
-        float magnitude = fftMagnitudes_[i];
-        float dB = 20.0f * std::log10(magnitude + 0.00001f);
-        float normalized = (dB + 60.0f) / 60.0f; // Normalize -60dB to 0dB
-        normalized = std::clamp(normalized, 0.0f, 1.0f);
+    for (int i = 0; i < numBands; ++i) {
+        float normalized = normalizedLevel(spectrumBands_[i]);
         
         int barHeight = static_cast<int>(normalized * height_ * yScale_);
-        int barX = x_ + static_cast<int>(i * binWidth);
+        int barX = x_ + static_cast<int>(i * bandWidth);
         int barY = y_ + height_ - barHeight;
         
         // Color based on frequency (low=red, mid=yellow, high=green)
-        float hue = static_cast<float>(i) / numBins;
+        float hue = static_cast<float>(i) / numBands;
         Color barColor = Color::fromHSV(hue * 120.0f, 0.8f, 0.9f);
         
-        display->fillRect(barX, barY, static_cast<int>(binWidth - 1), barHeight, barColor);
+        display->fillRect(barX, barY, std::max(1, static_cast<int>(bandWidth - 1)), barHeight, barColor);
     }
 }
 
 void WaveformVisualizer::drawWaterfall(DisplayManager* display) {
-    if (waterfallHistory_.empty()) return;
+    if (waterfallCount_ == 0) return;
     
-    int rowHeight = std::max(1, height_ / static_cast<int>(waterfallHistory_.size()));
+    int numBands = spectrumBands_.size();
+    int rowHeight = std::max(1, height_ / waterfallCount_);
+    int w = std::max(1, width_ / numBands);
     
-    for (size_t row = 0; row < waterfallHistory_.size(); ++row) {
-        const auto& spectrum = waterfallHistory_[row];
+    for (int row = 0; row < waterfallCount_; ++row) {
+        const float* spectrum = &waterfallRows_[static_cast<size_t>((waterfallHead_ + row) % WATERFALL_HISTORY_SIZE) * numBands];
         int y = y_ + row * rowHeight;
         
-        for (size_t bin = 0; bin < spectrum.size(); ++bin) {
-            float magnitude = spectrum[bin];
-            float intensity = std::clamp(magnitude * 10.0f, 0.0f, 1.0f);
-            
-            int x = x_ + (bin * width_) / spectrum.size();
-            int w = std::max(1, width_ / static_cast<int>(spectrum.size()));
+        for (int band = 0; band < numBands; ++band) {
+            float intensity = normalizedLevel(spectrum[band]);
+            int x = x_ + (band * width_) / numBands;
             
             uint8_t brightness = static_cast<uint8_t>(intensity * 255);
             Color pixelColor(brightness, brightness * 0.5f, brightness * 0.2f);
@@ -184,16 +266,14 @@ void WaveformVisualizer::drawWaterfall(DisplayManager* display) {
 }
 
 void WaveformVisualizer::drawLissajous(DisplayManager* display) {
-    std::lock_guard<std::mutex> lock(bufferMutex_);
-    
     int numPoints = std::min(512, bufferSize_);
-    int readIdx = readPos_.load(std::memory_order_acquire);
+    int startIdx = bufferSize_ - numPoints;
     int centerX = x_ + width_ / 2;
     int centerY = y_ + height_ / 2;
     
     for (int i = 1; i < numPoints; ++i) {
-        int bufferIdx = (readIdx + i) % bufferSize_;
-        int prevIdx = (readIdx + i - 1) % bufferSize_;
+        int bufferIdx = startIdx + i;
+        int prevIdx = bufferIdx - 1;
         
         float x1 = audioBuffer_[prevIdx * 2];     // Left
         float y1 = audioBuffer_[prevIdx * 2 + 1]; // Right
@@ -205,8 +285,8 @@ void WaveformVisualizer::drawLissajous(DisplayManager* display) {
         int px2 = centerX + static_cast<int>(x2 * width_ * 0.4f);
         int py2 = centerY - static_cast<int>(y2 * height_ * 0.4f);
         
-        // Fade based on age
-        float fade = 1.0f - (static_cast<float>(i) / numPoints);
+        // Fade based on age (newest samples brightest)
+        float fade = static_cast<float>(i) / numPoints;
         Color lineColor = waveformColor_;
         lineColor.a = static_cast<uint8_t>(255 * fade);
         
@@ -241,24 +321,31 @@ void WaveformVisualizer::drawGrid(DisplayManager* display) {
 }
 
 void WaveformVisualizer::performFFT() {
-    // Simplified FFT placeholder
-    // In a real implementation, use a proper FFT library like FFTW or KissFFT
-    
-    std::lock_guard<std::mutex> lock(bufferMutex_);
-    int readIdx = readPos_.load(std::memory_order_acquire);
+    // Analyse the newest fft_.getSize() frames as a mono mix
+    int fftSize = fft_.getSize();
+    int start = bufferSize_ - fftSize;
+    for (int i = 0; i < fftSize; ++i) {
+        int idx = (start + i) * 2;
+        monoBuffer_[i] = 0.5f * (audioBuffer_[idx] + audioBuffer_[idx + 1]);
+    }
     
-    // Simple spectrum estimation (not a real FFT)
-    for (size_t i = 0; i < fftMagnitudes_.size(); ++i) {
-        float sum = 0.0f;
-        int samplesPerBin = bufferSize_ / fftMagnitudes_.size();
-        
-        for (int j = 0; j < samplesPerBin; ++j) {
-            int idx = (readIdx + i * samplesPerBin + j) % bufferSize_;
-            sum += std::abs(audioBuffer_[idx * 2]); // Left channel
-        }
-        
-        fftMagnitudes_[i] = sum / samplesPerBin;
+    fft_.computeMagnitudes(monoBuffer_.data(), fftMagnitudes_.data());
+    bandMapper_.process(fftMagnitudes_.data(), spectrumBands_.data());
+}
+
+void WaveformVisualizer::pushWaterfallRow() {
+    int numBands = spectrumBands_.size();
+    int row;
+    if (waterfallCount_ < WATERFALL_HISTORY_SIZE) {
+        row = (waterfallHead_ + waterfallCount_) % WATERFALL_HISTORY_SIZE;
+        ++waterfallCount_;
+    } else {
+        // Overwrite the oldest row in place
+        row = waterfallHead_;
+        waterfallHead_ = (waterfallHead_ + 1) % WATERFALL_HISTORY_SIZE;
     }
+    std::copy(spectrumBands_.begin(), spectrumBands_.end(),
+              waterfallRows_.begin() + static_cast<size_t>(row) * numBands);
 }
 
 // EnvelopeVisualizer implementation
@@ -605,6 +692,11 @@ void LevelMeter::update(float deltaTime) {
             peakLevel_ = 0.0f;
         }
     }
+    
+    // Only redraw while the bar or peak marker is still moving
+    if (std::abs(diff) > 0.001f || peakLevel_ > 0.0f) {
+        markDirty();
+    }
 }
 
 void LevelMeter::render(DisplayManager* display) {
@@ -712,9 +804,48 @@ float LevelMeter::todB(float linear) {
 }
 
 // SpectrumAnalyzer implementation
+void SpectrumAnalyzer::update(float deltaTime) {
+    WaveformVisualizer::update(deltaTime);
+    
+    if (bandPeaks_.size() != spectrumBands_.size()) {
+        bandPeaks_.assign(spectrumBands_.size(), 0.0f);
+        peakTimers_.assign(spectrumBands_.size(), 0.0f);
+    }
+    
+    // Hold each band's peak, then let it fall at 20 dB per second
+    bool peaksMoved = false;
+    float fall = std::pow(10.0f, -deltaTime);
+    for (size_t i = 0; i < spectrumBands_.size(); ++i) {
+        if (spectrumBands_[i] >= bandPeaks_[i]) {
+            peaksMoved |= spectrumBands_[i] != bandPeaks_[i];
+            bandPeaks_[i] = spectrumBands_[i];
+            peakTimers_[i] = 0.0f;
+        } else if ((peakTimers_[i] += deltaTime) > peakHoldTime_ && bandPeaks_[i] > 0.0f) {
+            bandPeaks_[i] = std::max(spectrumBands_[i], bandPeaks_[i] * fall);
+            peaksMoved = true;
+        }
+    }
+    
+    if (peaksMoved) {
+        markDirty();
+    }
+}
+
 void SpectrumAnalyzer::render(DisplayManager* display) {
     // Call parent render which handles spectrum drawing
     WaveformVisualizer::render(display);
+    if (!display || getDisplayMode() != DisplayMode::Spectrum || bandPeaks_.empty()) return;
+    
+    // Peak hold markers above each band
+    float bandWidth = static_cast<float>(width_) / bandPeaks_.size();
+    for (size_t i = 0; i < bandPeaks_.size(); ++i) {
+        int peakHeight = static_cast<int>(normalizedLevel(bandPeaks_[i]) * height_);
+        if (peakHeight <= 0) continue;
+        
+        int barX = x_ + static_cast<int>(i * bandWidth);
+        int peakY = std::max(y_, y_ + height_ - peakHeight);
+        display->fillRect(barX, peakY, std::max(1, static_cast<int>(bandWidth - 1)), 2, Color(255, 255, 255));
+    }
 }
 
 // PhaseMeter implementation
@@ -746,6 +877,7 @@ void PhaseMeter::update(float deltaTime) {
     for (auto& intensity : traceIntensity_) {
         intensity *= decayRate_;
     }
+    markDirty();
 }
 
 void PhaseMeter::render(DisplayManager* display) {
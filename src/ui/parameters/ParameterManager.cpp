@@ -33,6 +33,19 @@ void EnhancedParameterManager::registerParameter(Parameter* parameter) {
     // Add to global registry
     parameterRegistry_[parameter->getId()] = parameter;
     
+    // Bind to the synthesizer parameter of the same ID, replacing any
+    // parameter previously registered under it
+    synthBindings_.erase(
+        std::remove_if(synthBindings_.begin(), synthBindings_.end(),
+                     [parameter](const SynthBinding& binding) {
+                         return binding.parameter->getId() == parameter->getId();
+                     }),
+        synthBindings_.end());
+    int synthParameter = findSynthParameter(parameter->getId());
+    if (synthParameter >= 0) {
+        synthBindings_.push_back({parameter, static_cast<SynthParamId>(synthParameter)});
+    }
+    
     // If it's a float parameter with smoothing, add to smoothing list
     if (auto* floatParam = dynamic_cast<FloatParameter*>(parameter)) {
         // Note: We'd need to track whether smoothing is enabled
@@ -51,6 +64,13 @@ void EnhancedParameterManager::unregisterParameter(Parameter* parameter) {
     // Remove from global registry
     parameterRegistry_.erase(parameter->getId());
     
+    synthBindings_.erase(
+        std::remove_if(synthBindings_.begin(), synthBindings_.end(),
+                     [parameter](const SynthBinding& binding) {
+                         return binding.parameter == parameter;
+                     }),
+        synthBindings_.end());
+    
     // Remove from MIDI map
     for (auto it = midiCCMap_.begin(); it != midiCCMap_.end(); ) {
         if (it->second == parameter) {
@@ -221,43 +241,36 @@ void EnhancedParameterManager::syncFromSynthesizer() {
 void EnhancedParameterManager::syncToSynthesizer() {
     if (!synth_) return;
     
-    // Collect all parameter values to update synthesizer
-    std::map<std::string, float> synthParams;
-    
-    // Iterate through all registered parameters
-    for (const auto& [id, param] : parameterRegistry_) {
-        if (param) {
-            float value = 0.0f;
-            
-            // Convert parameter value to float based on type
-            switch (param->getType()) {
-                case Parameter::Type::FLOAT:
-                    value = static_cast<FloatParameter*>(param)->getValue();
-                    break;
-                    
-                case Parameter::Type::INT:
-                    value = static_cast<float>(static_cast<IntParameter*>(param)->getValue());
-                    break;
-                    
-                case Parameter::Type::BOOL:
-                    value = static_cast<BoolParameter*>(param)->getValue() ? 1.0f : 0.0f;
-                    break;
-                    
-                case Parameter::Type::ENUM:
-                    value = static_cast<float>(static_cast<EnumParameter*>(param)->getValue());
-                    break;
-                    
-                case Parameter::Type::TRIGGER:
-                    // Triggers are transient, not reflected in synth params
-                    continue;
-            }
-            
-            synthParams[id] = value;
+    // Only parameters the synthesizer understands, by their bound index
+    for (const auto& binding : synthBindings_) {
+        Parameter* param = binding.parameter;
+        float value = 0.0f;
+        
+        // Convert parameter value to float based on type
+        switch (param->getType()) {
+            case Parameter::Type::FLOAT:
+                value = static_cast<FloatParameter*>(param)->getValue();
+                break;
+                
+            case Parameter::Type::INT:
+                value = static_cast<float>(static_cast<IntParameter*>(param)->getValue());
+                break;
+                
+            case Parameter::Type::BOOL:
+                value = static_cast<BoolParameter*>(param)->getValue() ? 1.0f : 0.0f;
+                break;
+                
+            case Parameter::Type::ENUM:
+                value = static_cast<float>(static_cast<EnumParameter*>(param)->getValue());
+                break;
+                
+            case Parameter::Type::TRIGGER:
+                // Triggers are transient, not reflected in synth params
+                continue;
         }
+        
+        synth_->setParameter(binding.synthParameter, value);
     }
-    
-    // Update synthesizer with all parameters at once
-    synth_->setAllParameters(synthParams);
 }
 
 } // namespace AIMusicHardware
\ No newline at end of file
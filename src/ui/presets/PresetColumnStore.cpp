@@ -0,0 +1,553 @@
+#include "../../../include/ui/presets/PresetColumnStore.h"
+#include <algorithm>
+#include <cctype>
+
+namespace AIMusicHardware {
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+int64_t toTicks(Clock::time_point tp) {
+    return static_cast<int64_t>(tp.time_since_epoch().count());
+}
+
+Clock::time_point fromTicks(int64_t ticks) {
+    return Clock::time_point(Clock::duration(ticks));
+}
+
+char foldChar(char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+} // namespace
+
+// Mutation
+
+PresetColumnStore::PresetId PresetColumnStore::upsert(const PresetInfo& info, bool fileBacked) {
+    PresetId id = find(info.filePath);
+
+    if (id != kInvalidId) {
+        releaseText(id);
+        unlinkPostings(id);
+    } else {
+        if (!freeIds_.empty()) {
+            id = freeIds_.back();
+            freeIds_.pop_back();
+        } else {
+            id = static_cast<PresetId>(flags_.size());
+            size_t n = static_cast<size_t>(id) + 1;
+            names_.resize(n);
+            foldedNames_.resize(n);
+            paths_.resize(n);
+            licenses_.resize(n);
+            descriptions_.resize(n);
+            foldedDescriptions_.resize(n);
+            tagRanges_.resize(n);
+            parameterBlobs_.resize(n);
+            categories_.resize(n, kNoString);
+            authors_.resize(n, kNoString);
+            created_.resize(n);
+            modified_.resize(n);
+            lastAccessed_.resize(n);
+            fileSizes_.resize(n);
+            flags_.resize(n);
+            ratings_.resize(n);
+            playCounts_.resize(n);
+            modulationCounts_.resize(n);
+            characteristics_.resize(n);
+        }
+        pathIndex_.emplace(info.filePath, id);
+        insertSorted(liveIds_, id);
+    }
+
+    // Text columns
+    names_[id] = appendText(info.name);
+    foldedNames_[id] = appendLowercase(info.name);
+    paths_[id] = appendText(info.filePath);
+    licenses_[id] = appendText(info.license);
+    descriptions_[id] = appendText(info.description);
+    foldedDescriptions_[id] = appendLowercase(info.description);
+
+    // Interned columns and their postings
+    categories_[id] = intern(info.category);
+    authors_[id] = intern(info.author);
+    if (!info.category.empty()) insertSorted(categoryPostings_[categories_[id]], id);
+    if (!info.author.empty()) insertSorted(authorPostings_[authors_[id]], id);
+
+    tagRanges_[id] = {static_cast<uint32_t>(tagPool_.size()), static_cast<uint32_t>(info.tags.size())};
+    for (const auto& tag : info.tags) {
+        uint32_t tagId = intern(tag);
+        tagPool_.push_back(tagId);
+        insertSorted(tagPostings_[tagId], id);
+    }
+
+    // Numeric columns
+    created_[id] = toTicks(info.created);
+    modified_[id] = toTicks(info.modified);
+    lastAccessed_[id] = toTicks(info.lastAccessed);
+    fileSizes_[id] = info.fileSize;
+    ratings_[id] = static_cast<int16_t>(info.userRating);
+    playCounts_[id] = info.playCount;
+
+    const auto& ac = info.audioCharacteristics;
+    characteristics_[id] = {ac.bassContent, ac.midContent, ac.trebleContent,
+                            ac.brightness, ac.warmth, ac.complexity};
+    modulationCounts_[id] = static_cast<int16_t>(ac.modulationCount);
+
+    uint8_t flags = kLive;
+    if (info.isFavorite) flags |= kFavorite;
+    if (ac.hasArpeggiator) flags |= kHasArpeggiator;
+    if (ac.hasSequencer) flags |= kHasSequencer;
+    if (info.isMetadataCached) flags |= kMetadataCached;
+    if (info.needsParameterAnalysis) flags |= kNeedsAnalysis;
+    if (fileBacked) flags |= kFileBacked;
+    flags_[id] = flags;
+
+    if (info.isFavorite) {
+        insertSorted(favoriteIds_, id);
+    }
+
+    // Parameter data is kept packed (or left on disk) until someone asks for it
+    if (fileBacked || info.parameterData.is_null()) {
+        parameterBlobs_[id] = {};
+    } else {
+        std::vector<uint8_t> packed = nlohmann::json::to_msgpack(info.parameterData);
+        parameterBlobs_[id] = {static_cast<uint32_t>(blobArena_.size()),
+                               static_cast<uint32_t>(packed.size())};
+        blobArena_.insert(blobArena_.end(), packed.begin(), packed.end());
+    }
+
+    // Overwrites leave dead bytes behind; reclaim once they dominate
+    if (garbageBytes_ > 64 * 1024 &&
+        garbageBytes_ > (textArena_.size() + blobArena_.size()) / 2) {
+        compact();
+    }
+
+    return id;
+}
+
+bool PresetColumnStore::remove(PresetId id) {
+    if (!isLive(id)) {
+        return false;
+    }
+
+    releaseText(id);
+    unlinkPostings(id);
+
+    pathIndex_.erase(std::string(text(paths_[id])));
+    eraseSorted(liveIds_, id);
+    flags_[id] = 0;
+    names_[id] = foldedNames_[id] = paths_[id] = licenses_[id] = {};
+    descriptions_[id] = foldedDescriptions_[id] = tagRanges_[id] = parameterBlobs_[id] = {};
+    categories_[id] = authors_[id] = kNoString;
+    freeIds_.push_back(id);
+
+    return true;
+}
+
+void PresetColumnStore::clear() {
+    *this = PresetColumnStore();
+}
+
+void PresetColumnStore::compact() {
+    std::string text;
+    std::vector<uint8_t> blobs;
+    std::vector<uint32_t> tags;
+    text.reserve(textArena_.size() - std::min(garbageBytes_, textArena_.size()));
+
+    auto move = [&](TextRef& ref) {
+        TextRef moved{static_cast<uint32_t>(text.size()), ref.length};
+        text.append(textArena_, ref.offset, ref.length);
+        ref = moved;
+    };
+
+    for (PresetId id : liveIds_) {
+        move(names_[id]);
+        move(foldedNames_[id]);
+        move(paths_[id]);
+        move(licenses_[id]);
+        move(descriptions_[id]);
+        move(foldedDescriptions_[id]);
+
+        TextRef& tagRange = tagRanges_[id];
+        uint32_t tagOffset = static_cast<uint32_t>(tags.size());
+        tags.insert(tags.end(), tagPool_.begin() + tagRange.offset,
+                    tagPool_.begin() + tagRange.offset + tagRange.length);
+        tagRange.offset = tagOffset;
+
+        TextRef& blob = parameterBlobs_[id];
+        uint32_t blobOffset = static_cast<uint32_t>(blobs.size());
+        blobs.insert(blobs.end(), blobArena_.begin() + blob.offset,
+                     blobArena_.begin() + blob.offset + blob.length);
+        blob.offset = blobOffset;
+    }
+
+    textArena_.swap(text);
+    blobArena_.swap(blobs);
+    tagPool_.swap(tags);
+    textArena_.shrink_to_fit();
+    blobArena_.shrink_to_fit();
+    tagPool_.shrink_to_fit();
+    garbageBytes_ = 0;
+}
+
+// Lookup
+
+PresetColumnStore::PresetId PresetColumnStore::find(const std::string& filePath) const {
+    auto it = pathIndex_.find(filePath);
+    return it != pathIndex_.end() ? it->second : kInvalidId;
+}
+
+bool PresetColumnStore::isLive(PresetId id) const {
+    return id < flags_.size() && (flags_[id] & kLive) != 0;
+}
+
+bool PresetColumnStore::isFileBacked(PresetId id) const {
+    return (flags_[id] & kFileBacked) != 0;
+}
+
+// Column accessors
+
+std::string_view PresetColumnStore::name(PresetId id) const { return text(names_[id]); }
+std::string_view PresetColumnStore::filePath(PresetId id) const { return text(paths_[id]); }
+std::string_view PresetColumnStore::license(PresetId id) const { return text(licenses_[id]); }
+std::string_view PresetColumnStore::description(PresetId id) const { return text(descriptions_[id]); }
+
+std::string_view PresetColumnStore::category(PresetId id) const {
+    return categories_[id] != kNoString ? std::string_view(strings_[categories_[id]]) : std::string_view();
+}
+
+std::string_view PresetColumnStore::author(PresetId id) const {
+    return authors_[id] != kNoString ? std::string_view(strings_[authors_[id]]) : std::string_view();
+}
+
+size_t PresetColumnStore::tagCount(PresetId id) const {
+    return tagRanges_[id].length;
+}
+
+std::string_view PresetColumnStore::tag(PresetId id, size_t index) const {
+    return strings_[tagPool_[tagRanges_[id].offset + index]];
+}
+
+bool PresetColumnStore::isFavorite(PresetId id) const { return (flags_[id] & kFavorite) != 0; }
+int PresetColumnStore::userRating(PresetId id) const { return ratings_[id]; }
+int PresetColumnStore::playCount(PresetId id) const { return playCounts_[id]; }
+std::size_t PresetColumnStore::fileSize(PresetId id) const { return static_cast<std::size_t>(fileSizes_[id]); }
+std::chrono::system_clock::time_point PresetColumnStore::created(PresetId id) const { return fromTicks(created_[id]); }
+std::chrono::system_clock::time_point PresetColumnStore::modified(PresetId id) const { return fromTicks(modified_[id]); }
+
+PresetInfo::AudioCharacteristics PresetColumnStore::audioCharacteristics(PresetId id) const {
+    PresetInfo::AudioCharacteristics ac;
+    const auto& c = characteristics_[id];
+    ac.bassContent = c[0];
+    ac.midContent = c[1];
+    ac.trebleContent = c[2];
+    ac.brightness = c[3];
+    ac.warmth = c[4];
+    ac.complexity = c[5];
+    ac.hasArpeggiator = (flags_[id] & kHasArpeggiator) != 0;
+    ac.hasSequencer = (flags_[id] & kHasSequencer) != 0;
+    ac.modulationCount = modulationCounts_[id];
+    return ac;
+}
+
+nlohmann::json PresetColumnStore::parameters(PresetId id) const {
+    if ((flags_[id] & kFileBacked) != 0) {
+        return PresetInfo::fromFile(std::string(filePath(id))).parameterData;
+    }
+
+    const TextRef& blob = parameterBlobs_[id];
+    if (blob.length == 0) {
+        return nlohmann::json();
+    }
+    return nlohmann::json::from_msgpack(blobArena_.begin() + blob.offset,
+                                        blobArena_.begin() + blob.offset + blob.length);
+}
+
+PresetInfo PresetColumnStore::materialize(PresetId id, bool includeParameters) const {
+    PresetInfo info;
+    info.name = std::string(name(id));
+    info.filePath = std::string(filePath(id));
+    info.category = std::string(category(id));
+    info.author = std::string(author(id));
+    info.license = std::string(license(id));
+    info.description = std::string(description(id));
+
+    size_t tags = tagCount(id);
+    info.tags.reserve(tags);
+    for (size_t i = 0; i < tags; ++i) {
+        info.tags.emplace_back(tag(id, i));
+    }
+
+    info.created = created(id);
+    info.modified = modified(id);
+    info.lastAccessed = fromTicks(lastAccessed_[id]);
+    info.fileSize = fileSize(id);
+    info.isFavorite = isFavorite(id);
+    info.userRating = userRating(id);
+    info.playCount = playCount(id);
+    info.audioCharacteristics = audioCharacteristics(id);
+    info.isMetadataCached = (flags_[id] & kMetadataCached) != 0;
+    info.needsParameterAnalysis = (flags_[id] & kNeedsAnalysis) != 0;
+
+    if (includeParameters) {
+        info.parameterData = parameters(id);
+    }
+
+    return info;
+}
+
+// Indexed queries
+
+PresetColumnStore::IdSpan PresetColumnStore::byCategory(const std::string& category) const {
+    return postingSpan(categoryPostings_, lookup(category));
+}
+
+PresetColumnStore::IdSpan PresetColumnStore::byAuthor(const std::string& author) const {
+    return postingSpan(authorPostings_, lookup(author));
+}
+
+PresetColumnStore::IdSpan PresetColumnStore::byTag(const std::string& tag) const {
+    return postingSpan(tagPostings_, lookup(tag));
+}
+
+void PresetColumnStore::searchName(const std::string& query, std::vector<PresetId>& out) const {
+    out.clear();
+    foldedQuery_.assign(query);
+    std::transform(foldedQuery_.begin(), foldedQuery_.end(), foldedQuery_.begin(), foldChar);
+
+    // Exact matches first, then partial matches, without duplicates
+    for (PresetId id : liveIds_) {
+        if (text(foldedNames_[id]) == foldedQuery_) {
+            out.push_back(id);
+        }
+    }
+    for (PresetId id : liveIds_) {
+        std::string_view folded = text(foldedNames_[id]);
+        if (folded != foldedQuery_ && containsFolded(folded, foldedQuery_)) {
+            out.push_back(id);
+        }
+    }
+}
+
+void PresetColumnStore::filter(const PresetFilterCriteria& criteria, std::vector<PresetId>& out) const {
+    out.clear();
+
+    // Resolve criteria to interned IDs once; unknown values cannot match
+    auto resolve = [this](const std::vector<std::string>& values, std::vector<uint32_t>& ids) {
+        ids.clear();
+        for (const auto& value : values) {
+            uint32_t id = lookup(value);
+            if (id != kNoString) ids.push_back(id);
+        }
+        return values.empty() || !ids.empty();
+    };
+
+    if (!resolve(criteria.categories, scratchCategories_) ||
+        !resolve(criteria.authors, scratchAuthors_) ||
+        !resolve(criteria.tags, scratchTags_)) {
+        return;
+    }
+
+    bool hasSearch = !criteria.searchText.empty();
+    if (hasSearch) {
+        foldedQuery_.assign(criteria.searchText);
+        std::transform(foldedQuery_.begin(), foldedQuery_.end(), foldedQuery_.begin(), foldChar);
+    }
+
+    int64_t dateFrom = toTicks(criteria.dateFrom);
+    int64_t dateTo = toTicks(criteria.dateTo);
+
+    auto containsId = [](const std::vector<uint32_t>& ids, uint32_t id) {
+        return std::find(ids.begin(), ids.end(), id) != ids.end();
+    };
+
+    // Cheap column tests first, text search last
+    for (PresetId id : liveIds_) {
+        if (!scratchCategories_.empty() && !containsId(scratchCategories_, categories_[id])) continue;
+        if (!scratchAuthors_.empty() && !containsId(scratchAuthors_, authors_[id])) continue;
+        if (criteria.favoritesOnly && (flags_[id] & kFavorite) == 0) continue;
+        if (ratings_[id] < criteria.minRating) continue;
+
+        if (criteria.hasDateRange && (created_[id] < dateFrom || created_[id] > dateTo)) continue;
+
+        if (criteria.hasAudioFilter) {
+            float bass = characteristics_[id][0];
+            float brightness = characteristics_[id][3];
+            if (bass < criteria.minBassContent || bass > criteria.maxBassContent ||
+                brightness < criteria.minBrightness || brightness > criteria.maxBrightness) {
+                continue;
+            }
+        }
+
+        const TextRef& tags = tagRanges_[id];
+
+        if (!scratchTags_.empty()) {
+            bool found = false;
+            for (uint32_t i = 0; !found && i < tags.length; ++i) {
+                found = containsId(scratchTags_, tagPool_[tags.offset + i]);
+            }
+            if (!found) continue;
+        }
+
+        if (hasSearch) {
+            bool found = containsFolded(text(foldedNames_[id]), foldedQuery_) ||
+                         (authors_[id] != kNoString &&
+                          containsFolded(foldedStrings_[authors_[id]], foldedQuery_)) ||
+                         containsFolded(text(foldedDescriptions_[id]), foldedQuery_);
+
+            for (uint32_t i = 0; !found && i < tags.length; ++i) {
+                found = containsFolded(foldedStrings_[tagPool_[tags.offset + i]], foldedQuery_);
+            }
+            if (!found) continue;
+        }
+
+        out.push_back(id);
+    }
+}
+
+void PresetColumnStore::sort(std::vector<PresetId>& ids, PresetSortCriteria criteria,
+                             SortDirection direction) const {
+    auto less = [this, criteria](PresetId a, PresetId b) -> bool {
+        switch (criteria) {
+            case PresetSortCriteria::Name:         return name(a) < name(b);
+            case PresetSortCriteria::Author:       return author(a) < author(b);
+            case PresetSortCriteria::Category:     return category(a) < category(b);
+            case PresetSortCriteria::DateCreated:  return created_[a] < created_[b];
+            case PresetSortCriteria::DateModified: return modified_[a] < modified_[b];
+            case PresetSortCriteria::Favorites:    return isFavorite(a) && !isFavorite(b);
+            case PresetSortCriteria::Rating:       return ratings_[a] < ratings_[b];
+            case PresetSortCriteria::PlayCount:    return playCounts_[a] < playCounts_[b];
+            case PresetSortCriteria::FileSize:     return fileSizes_[a] < fileSizes_[b];
+        }
+        return false;
+    };
+
+    if (direction == SortDirection::Ascending) {
+        std::stable_sort(ids.begin(), ids.end(), less);
+    } else {
+        std::stable_sort(ids.begin(), ids.end(), [&less](PresetId a, PresetId b) { return less(b, a); });
+    }
+}
+
+size_t PresetColumnStore::memoryUsage() const {
+    auto bytes = [](const auto& v) { return v.capacity() * sizeof(v[0]); };
+
+    size_t total = textArena_.capacity() + blobArena_.capacity() + bytes(tagPool_);
+    total += bytes(names_) + bytes(foldedNames_) + bytes(paths_) + bytes(licenses_);
+    total += bytes(descriptions_) + bytes(foldedDescriptions_) + bytes(tagRanges_) + bytes(parameterBlobs_);
+    total += bytes(categories_) + bytes(authors_) + bytes(created_) + bytes(modified_);
+    total += bytes(lastAccessed_) + bytes(fileSizes_) + bytes(flags_) + bytes(ratings_);
+    total += bytes(playCounts_) + bytes(modulationCounts_) + bytes(characteristics_);
+    total += bytes(liveIds_) + bytes(favoriteIds_) + bytes(freeIds_);
+
+    for (size_t i = 0; i < strings_.size(); ++i) {
+        total += sizeof(std::string) * 2 + strings_[i].capacity() + foldedStrings_[i].capacity();
+        total += bytes(categoryPostings_[i]) + bytes(authorPostings_[i]) + bytes(tagPostings_[i]);
+    }
+
+    // Hash nodes: key string, value and bucket pointer
+    for (const auto& [path, id] : pathIndex_) {
+        total += sizeof(std::string) + path.capacity() + sizeof(PresetId) + 2 * sizeof(void*);
+    }
+
+    return total;
+}
+
+// Private helpers
+
+PresetColumnStore::TextRef PresetColumnStore::appendText(std::string_view value) {
+    TextRef ref{static_cast<uint32_t>(textArena_.size()), static_cast<uint32_t>(value.size())};
+    textArena_.append(value.data(), value.size());
+    return ref;
+}
+
+PresetColumnStore::TextRef PresetColumnStore::appendLowercase(std::string_view value) {
+    TextRef ref{static_cast<uint32_t>(textArena_.size()), static_cast<uint32_t>(value.size())};
+    for (char c : value) {
+        textArena_.push_back(foldChar(c));
+    }
+    return ref;
+}
+
+std::string_view PresetColumnStore::text(TextRef ref) const {
+    return std::string_view(textArena_.data() + ref.offset, ref.length);
+}
+
+uint32_t PresetColumnStore::intern(const std::string& value) {
+    auto it = stringIds_.find(value);
+    if (it != stringIds_.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(strings_.size());
+    strings_.push_back(value);
+    std::string folded = value;
+    std::transform(folded.begin(), folded.end(), folded.begin(), foldChar);
+    foldedStrings_.push_back(std::move(folded));
+    categoryPostings_.emplace_back();
+    authorPostings_.emplace_back();
+    tagPostings_.emplace_back();
+    stringIds_.emplace(value, id);
+    return id;
+}
+
+uint32_t PresetColumnStore::lookup(const std::string& value) const {
+    auto it = stringIds_.find(value);
+    return it != stringIds_.end() ? it->second : kNoString;
+}
+
+void PresetColumnStore::releaseText(PresetId id) {
+    garbageBytes_ += names_[id].length + foldedNames_[id].length + paths_[id].length;
+    garbageBytes_ += licenses_[id].length + descriptions_[id].length + foldedDescriptions_[id].length;
+    garbageBytes_ += tagRanges_[id].length * sizeof(uint32_t) + parameterBlobs_[id].length;
+}
+
+void PresetColumnStore::unlinkPostings(PresetId id) {
+    if (categories_[id] != kNoString) eraseSorted(categoryPostings_[categories_[id]], id);
+    if (authors_[id] != kNoString) eraseSorted(authorPostings_[authors_[id]], id);
+
+    const TextRef& tags = tagRanges_[id];
+    for (uint32_t i = 0; i < tags.length; ++i) {
+        eraseSorted(tagPostings_[tagPool_[tags.offset + i]], id);
+    }
+
+    eraseSorted(favoriteIds_, id);
+}
+
+bool PresetColumnStore::containsFolded(std::string_view haystack, std::string_view foldedNeedle) const {
+    return haystack.find(foldedNeedle) != std::string_view::npos;
+}
+
+void PresetColumnStore::insertSorted(std::vector<PresetId>& ids, PresetId id) {
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it == ids.end() || *it != id) {
+        ids.insert(it, id);
+    }
+}
+
+void PresetColumnStore::eraseSorted(std::vector<PresetId>& ids, PresetId id) {
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it != ids.end() && *it == id) {
+        ids.erase(it);
+    }
+}
+
+PresetColumnStore::IdSpan PresetColumnStore::postingSpan(
+    const std::vector<std::vector<PresetId>>& postings, uint32_t stringId) const {
+    if (stringId == kNoString || stringId >= postings.size()) {
+        return {};
+    }
+    return {postings[stringId].data(), postings[stringId].size()};
+}
+
+size_t PresetColumnStore::countPostings(const std::vector<std::vector<PresetId>>& postings) const {
+    size_t count = 0;
+    for (size_t i = 0; i < postings.size(); ++i) {
+        if (!postings[i].empty() && !strings_[i].empty()) ++count;
+    }
+    return count;
+}
+
+} // namespace AIMusicHardware
@@ -27,7 +27,7 @@ bool PresetDatabase::initialize(const std::vector<std::string>& directories) {
     std::lock_guard<std::mutex> lock(dataMutex_);
     
     // Clear existing data
-    presets_.clear();
+    store_.clear();
     watchedDirectories_.clear();
     
     // Add directories
@@ -89,30 +89,22 @@ void PresetDatabase::removeDirectory(const std::string& directory) {
     }
     
     // Remove all presets from this directory
-    auto presetIt = presets_.begin();
-    while (presetIt != presets_.end()) {
-        if (presetIt->second.filePath.find(directory) == 0) {
-            removeFromIndices(presetIt->first);
-            presetIt = presets_.erase(presetIt);
-        } else {
-            ++presetIt;
+    std::vector<PresetId> stale;
+    for (PresetId id : store_.all()) {
+        if (store_.filePath(id).compare(0, directory.size(), directory) == 0) {
+            stale.push_back(id);
         }
     }
+    for (PresetId id : stale) {
+        store_.remove(id);
+    }
     
     updateStatistics();
 }
 
 std::vector<PresetInfo> PresetDatabase::getAllPresets() const {
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    
-    std::vector<PresetInfo> result;
-    result.reserve(presets_.size());
-    
-    for (const auto& pair : presets_) {
-        result.push_back(pair.second);
-    }
-    
-    return result;
+    std::unique_lock<std::mutex> lock(dataMutex_);
+    return materializeAll(store_.all(), lock);
 }
 
 std::vector<PresetInfo> PresetDatabase::searchByName(const std::string& query) const {
@@ -120,86 +112,26 @@ std::vector<PresetInfo> PresetDatabase::searchByName(const std::string& query) c
         return getAllPresets();
     }
     
-    std::lock_guard<std::mutex> indexLock(indexMutex_);
-    std::lock_guard<std::mutex> dataLock(dataMutex_);
+    std::unique_lock<std::mutex> lock(dataMutex_);
     
-    std::vector<PresetInfo> result;
-    std::string lowerQuery = toLowercase(query);
-    
-    // Use index for fast lookup
-    auto range = nameIndex_.equal_range(lowerQuery);
-    for (auto it = range.first; it != range.second; ++it) {
-        auto presetIt = presets_.find(it->second);
-        if (presetIt != presets_.end()) {
-            result.push_back(presetIt->second);
-        }
-    }
-    
-    // Also search for partial matches
-    for (auto it = nameIndex_.begin(); it != nameIndex_.end(); ++it) {
-        if (it->first.find(lowerQuery) != std::string::npos) {
-            auto presetIt = presets_.find(it->second);
-            if (presetIt != presets_.end()) {
-                // Avoid duplicates
-                if (std::find_if(result.begin(), result.end(), 
-                    [&](const PresetInfo& p) { return p.filePath == presetIt->second.filePath; }) == result.end()) {
-                    result.push_back(presetIt->second);
-                }
-            }
-        }
-    }
-    
-    return result;
+    std::vector<PresetId> ids;
+    store_.searchName(query, ids);
+    return materializeAll({ids.data(), ids.size()}, lock);
 }
 
 std::vector<PresetInfo> PresetDatabase::getByCategory(const std::string& category) const {
-    std::lock_guard<std::mutex> indexLock(indexMutex_);
-    std::lock_guard<std::mutex> dataLock(dataMutex_);
-    
-    std::vector<PresetInfo> result;
-    
-    auto range = categoryIndex_.equal_range(category);
-    for (auto it = range.first; it != range.second; ++it) {
-        auto presetIt = presets_.find(it->second);
-        if (presetIt != presets_.end()) {
-            result.push_back(presetIt->second);
-        }
-    }
-    
-    return result;
+    std::unique_lock<std::mutex> lock(dataMutex_);
+    return materializeAll(store_.byCategory(category), lock);
 }
 
 std::vector<PresetInfo> PresetDatabase::getByAuthor(const std::string& author) const {
-    std::lock_guard<std::mutex> indexLock(indexMutex_);
-    std::lock_guard<std::mutex> dataLock(dataMutex_);
-    
-    std::vector<PresetInfo> result;
-    
-    auto range = authorIndex_.equal_range(author);
-    for (auto it = range.first; it != range.second; ++it) {
-        auto presetIt = presets_.find(it->second);
-        if (presetIt != presets_.end()) {
-            result.push_back(presetIt->second);
-        }
-    }
-    
-    return result;
+    std::unique_lock<std::mutex> lock(dataMutex_);
+    return materializeAll(store_.byAuthor(author), lock);
 }
 
 std::vector<PresetInfo> PresetDatabase::getFavorites() const {
-    std::lock_guard<std::mutex> indexLock(indexMutex_);
-    std::lock_guard<std::mutex> dataLock(dataMutex_);
-    
-    std::vector<PresetInfo> result;
-    
-    for (const auto& filePath : favoriteIndex_) {
-        auto presetIt = presets_.find(filePath);
-        if (presetIt != presets_.end()) {
-            result.push_back(presetIt->second);
-        }
-    }
-    
-    return result;
+    std::unique_lock<std::mutex> lock(dataMutex_);
+    return materializeAll(store_.favorites(), lock);
 }
 
 std::vector<PresetInfo> PresetDatabase::filter(const PresetFilterCriteria& criteria) const {
@@ -207,17 +139,11 @@ std::vector<PresetInfo> PresetDatabase::filter(const PresetFilterCriteria& crite
         return getAllPresets();
     }
     
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    
-    std::vector<PresetInfo> result;
-    
-    for (const auto& pair : presets_) {
-        if (matchesFilter(pair.second, criteria)) {
-            result.push_back(pair.second);
-        }
-    }
+    std::unique_lock<std::mutex> lock(dataMutex_);
     
-    return result;
+    std::vector<PresetId> ids;
+    store_.filter(criteria, ids);
+    return materializeAll({ids.data(), ids.size()}, lock);
 }
 
 void PresetDatabase::sort(std::vector<PresetInfo>& presets, 
@@ -264,17 +190,19 @@ void PresetDatabase::sort(std::vector<PresetInfo>& presets,
 }
 
 std::shared_ptr<PresetInfo> PresetDatabase::getPreset(const std::string& filePath) const {
-    std::lock_guard<std::mutex> lock(dataMutex_);
+    std::unique_lock<std::mutex> lock(dataMutex_);
     
-    auto it = presets_.find(filePath);
-    if (it != presets_.end()) {
-        cacheHits_++;
-        return std::make_shared<PresetInfo>(it->second);
+    PresetId id = store_.find(filePath);
+    if (id != PresetColumnStore::kInvalidId) {
+        PresetId ids[] = {id};
+        auto result = materializeAll({ids, 1}, lock);
+        return std::make_shared<PresetInfo>(std::move(result.front()));
     }
+    lock.unlock();
     
     cacheMisses_++;
     
-    // Try to load from file if not in cache
+    // Try to load from file if not in the database
     if (isValidPresetFile(filePath)) {
         PresetInfo info = PresetInfo::fromFile(filePath);
         return std::make_shared<PresetInfo>(info);
@@ -286,16 +214,13 @@ std::shared_ptr<PresetInfo> PresetDatabase::getPreset(const std::string& filePat
 bool PresetDatabase::updatePreset(const std::string& filePath, const PresetInfo& updatedInfo) {
     std::lock_guard<std::mutex> lock(dataMutex_);
     
-    auto it = presets_.find(filePath);
-    if (it != presets_.end()) {
-        // Remove from indices
-        removeFromIndices(filePath);
-        
-        // Update preset
-        it->second = updatedInfo;
-        
-        // Add back to indices
-        addToIndices(updatedInfo);
+    PresetId id = store_.find(filePath);
+    if (id != PresetColumnStore::kInvalidId) {
+        // A changed file path re-keys the preset
+        if (updatedInfo.filePath != filePath) {
+            store_.remove(id);
+        }
+        store_.upsert(updatedInfo);
         
         updateStatistics();
         return true;
@@ -307,8 +232,7 @@ bool PresetDatabase::updatePreset(const std::string& filePath, const PresetInfo&
 bool PresetDatabase::addPreset(const PresetInfo& presetInfo) {
     std::lock_guard<std::mutex> lock(dataMutex_);
     
-    presets_[presetInfo.filePath] = presetInfo;
-    addToIndices(presetInfo);
+    store_.upsert(presetInfo);
     updateStatistics();
     
     return true;
@@ -317,10 +241,7 @@ bool PresetDatabase::addPreset(const PresetInfo& presetInfo) {
 bool PresetDatabase::removePreset(const std::string& filePath) {
     std::lock_guard<std::mutex> lock(dataMutex_);
     
-    auto it = presets_.find(filePath);
-    if (it != presets_.end()) {
-        removeFromIndices(filePath);
-        presets_.erase(it);
+    if (store_.remove(store_.find(filePath))) {
         updateStatistics();
         return true;
     }
@@ -333,59 +254,95 @@ void PresetDatabase::rebuildIndices() {
 }
 
 void PresetDatabase::rebuildIndicesInternal() {
-    std::lock_guard<std::mutex> indexLock(indexMutex_);
-    std::lock_guard<std::mutex> dataLock(dataMutex_);
-    
-    // Clear existing indices
-    nameIndex_.clear();
-    categoryIndex_.clear();
-    authorIndex_.clear();
-    tagIndex_.clear();
-    favoriteIndex_.clear();
-    
-    // Rebuild indices
-    for (const auto& pair : presets_) {
-        addToIndices(pair.second);
-    }
+    std::lock_guard<std::mutex> lock(dataMutex_);
     
+    // Indices are maintained incrementally; only reclaim arena space
+    store_.compact();
     updateStatistics();
 }
 
+void PresetDatabase::queryAll(std::vector<PresetId>& out) const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    auto ids = store_.all();
+    out.assign(ids.begin(), ids.end());
+}
+
+void PresetDatabase::queryFilter(const PresetFilterCriteria& criteria, std::vector<PresetId>& out) const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    store_.filter(criteria, out);
+}
+
+void PresetDatabase::queryCategory(const std::string& category, std::vector<PresetId>& out) const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    auto ids = store_.byCategory(category);
+    out.assign(ids.begin(), ids.end());
+}
+
+void PresetDatabase::querySearch(const std::string& query, std::vector<PresetId>& out) const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    store_.searchName(query, out);
+}
+
+void PresetDatabase::sortIds(std::vector<PresetId>& ids,
+                             PresetSortCriteria criteria,
+                             SortDirection direction) const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    store_.sort(ids, criteria, direction);
+}
+
+PresetInfo PresetDatabase::materialize(PresetId id, bool includeParameters) const {
+    std::unique_lock<std::mutex> lock(dataMutex_);
+    if (!store_.isLive(id)) {
+        return PresetInfo();
+    }
+    if (!includeParameters) {
+        return store_.materialize(id, false);
+    }
+    PresetId ids[] = {id};
+    return std::move(materializeAll({ids, 1}, lock).front());
+}
+
+size_t PresetDatabase::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    return store_.memoryUsage();
+}
+
 std::set<std::string> PresetDatabase::getAllCategories() const {
-    std::lock_guard<std::mutex> lock(indexMutex_);
+    std::lock_guard<std::mutex> lock(dataMutex_);
     
     std::set<std::string> categories;
-    for (const auto& pair : categoryIndex_) {
-        categories.insert(pair.first);
-    }
+    store_.forEachCategory([&](std::string_view category) { categories.emplace(category); });
     
     return categories;
 }
 
 std::set<std::string> PresetDatabase::getAllAuthors() const {
-    std::lock_guard<std::mutex> lock(indexMutex_);
+    std::lock_guard<std::mutex> lock(dataMutex_);
     
     std::set<std::string> authors;
-    for (const auto& pair : authorIndex_) {
-        authors.insert(pair.first);
-    }
+    store_.forEachAuthor([&](std::string_view author) { authors.emplace(author); });
     
     return authors;
 }
 
 std::set<std::string> PresetDatabase::getAllTags() const {
-    std::lock_guard<std::mutex> lock(indexMutex_);
+    std::lock_guard<std::mutex> lock(dataMutex_);
     
     std::set<std::string> tags;
-    for (const auto& pair : tagIndex_) {
-        tags.insert(pair.first);
-    }
+    store_.forEachTag([&](std::string_view tag) { tags.emplace(tag); });
     
     return tags;
 }
 
 PresetDatabase::Statistics PresetDatabase::getStatistics() const {
     std::lock_guard<std::mutex> lock(dataMutex_);
+    
+    // Hit rate moves with every load, not just with mutations
+    const size_t hits = cacheHits_;
+    const size_t misses = cacheMisses_;
+    if (hits + misses > 0) {
+        stats_.cacheHitRate = (hits * 100) / (hits + misses);
+    }
     return stats_;
 }
 
@@ -446,178 +403,46 @@ void PresetDatabase::scanDirectory(const std::string& directory, bool recursive)
 
 void PresetDatabase::processPresetFile(const std::string& filePath) {
     try {
-        PresetInfo info = loadPresetMetadata(filePath);
+        PresetInfo info = PresetInfo::fromFile(filePath);
         
+        // Scanned presets reload their parameters from disk on demand
         std::lock_guard<std::mutex> lock(dataMutex_);
-        presets_[filePath] = info;
+        store_.upsert(info, true);
         
     } catch (const std::exception& e) {
         std::cerr << "Error processing preset file " << filePath << ": " << e.what() << std::endl;
     }
 }
 
-void PresetDatabase::addToIndices(const PresetInfo& preset) {
-    // Name index (lowercase for case-insensitive search)
-    nameIndex_.emplace(toLowercase(preset.name), preset.filePath);
-    
-    // Category index
-    if (!preset.category.empty()) {
-        categoryIndex_.emplace(preset.category, preset.filePath);
-    }
-    
-    // Author index
-    if (!preset.author.empty()) {
-        authorIndex_.emplace(preset.author, preset.filePath);
-    }
-    
-    // Tag index
-    for (const auto& tag : preset.tags) {
-        tagIndex_.emplace(tag, preset.filePath);
-    }
-    
-    // Favorites index
-    if (preset.isFavorite) {
-        favoriteIndex_.insert(preset.filePath);
-    }
-}
-
-void PresetDatabase::removeFromIndices(const std::string& filePath) {
-    // This is inefficient but necessary for correctness
-    // In a production system, you might want to maintain reverse indices
-    
-    auto removeFromMultimap = [&filePath](auto& multimap) {
-        auto it = multimap.begin();
-        while (it != multimap.end()) {
-            if (it->second == filePath) {
-                it = multimap.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    };
-    
-    removeFromMultimap(nameIndex_);
-    removeFromMultimap(categoryIndex_);
-    removeFromMultimap(authorIndex_);
-    removeFromMultimap(tagIndex_);
-    
-    favoriteIndex_.erase(filePath);
-}
-
-std::string PresetDatabase::toLowercase(const std::string& str) const {
-    std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
-    return result;
-}
-
-bool PresetDatabase::matchesSearch(const std::string& text, const std::string& query) const {
-    return toLowercase(text).find(toLowercase(query)) != std::string::npos;
-}
-
-bool PresetDatabase::matchesFilter(const PresetInfo& preset, const PresetFilterCriteria& criteria) const {
-    // Search text filter
-    if (!criteria.searchText.empty()) {
-        bool found = matchesSearch(preset.name, criteria.searchText) ||
-                    matchesSearch(preset.author, criteria.searchText) ||
-                    matchesSearch(preset.description, criteria.searchText);
-        
-        // Also search tags
-        for (const auto& tag : preset.tags) {
-            if (matchesSearch(tag, criteria.searchText)) {
-                found = true;
-                break;
-            }
-        }
-        
-        if (!found) return false;
-    }
-    
-    // Category filter
-    if (!criteria.categories.empty()) {
-        bool found = std::find(criteria.categories.begin(), criteria.categories.end(), 
-                              preset.category) != criteria.categories.end();
-        if (!found) return false;
-    }
-    
-    // Author filter
-    if (!criteria.authors.empty()) {
-        bool found = std::find(criteria.authors.begin(), criteria.authors.end(), 
-                              preset.author) != criteria.authors.end();
-        if (!found) return false;
-    }
-    
-    // Tags filter
-    if (!criteria.tags.empty()) {
-        bool found = false;
-        for (const auto& criteriaTag : criteria.tags) {
-            if (std::find(preset.tags.begin(), preset.tags.end(), criteriaTag) != preset.tags.end()) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) return false;
-    }
-    
-    // Favorites filter
-    if (criteria.favoritesOnly && !preset.isFavorite) {
-        return false;
-    }
-    
-    // Rating filter
-    if (preset.userRating < criteria.minRating) {
-        return false;
-    }
-    
-    // Date range filter
-    if (criteria.hasDateRange) {
-        if (preset.created < criteria.dateFrom || preset.created > criteria.dateTo) {
-            return false;
-        }
-    }
-    
-    // Audio characteristics filter
-    if (criteria.hasAudioFilter) {
-        if (preset.audioCharacteristics.bassContent < criteria.minBassContent ||
-            preset.audioCharacteristics.bassContent > criteria.maxBassContent ||
-            preset.audioCharacteristics.brightness < criteria.minBrightness ||
-            preset.audioCharacteristics.brightness > criteria.maxBrightness) {
-            return false;
-        }
-    }
-    
-    return true;
-}
-
-PresetInfo PresetDatabase::loadPresetMetadata(const std::string& filePath) const {
-    // Check cache first
-    {
-        std::lock_guard<std::mutex> cacheLock(cacheMutex_);
-        auto it = metadataCache_.find(filePath);
-        if (it != metadataCache_.end()) {
-            cacheHits_++;
-            return it->second;
+std::vector<PresetInfo> PresetDatabase::materializeAll(PresetColumnStore::IdSpan ids,
+                                                       std::unique_lock<std::mutex>& lock) const {
+    std::vector<PresetInfo> result;
+    result.reserve(ids.size);
+    
+    // Parameters held in the store are decoded now; file-backed ones are
+    // read from disk after the data lock is released
+    std::vector<size_t> fromDisk;
+    for (PresetId id : ids) {
+        const bool fileBacked = store_.isFileBacked(id);
+        result.push_back(store_.materialize(id, !fileBacked));
+        if (fileBacked) {
+            fromDisk.push_back(result.size() - 1);
         }
     }
+    lock.unlock();
     
-    cacheMisses_++;
-    
-    // Load from file
-    PresetInfo info = PresetInfo::fromFile(filePath);
-    
-    // Update cache
-    updateCache(info);
-    
-    return info;
+    cacheHits_ += result.size() - fromDisk.size();
+    loadParametersFromDisk(result, fromDisk);
+    return result;
 }
 
-void PresetDatabase::updateCache(const PresetInfo& preset) const {
-    std::lock_guard<std::mutex> cacheLock(cacheMutex_);
-    metadataCache_[preset.filePath] = preset;
+void PresetDatabase::loadParametersFromDisk(std::vector<PresetInfo>& presets,
+                                            const std::vector<size_t>& indices) const {
+    cacheMisses_ += indices.size();
     
-    // Simple cache size management (keep last 1000 entries)
-    if (metadataCache_.size() > 1000) {
-        auto it = metadataCache_.begin();
-        metadataCache_.erase(it);
+    for (size_t index : indices) {
+        PresetInfo& preset = presets[index];
+        preset.parameterData = PresetInfo::fromFile(preset.filePath).parameterData;
     }
 }
 
@@ -633,10 +458,11 @@ bool PresetDatabase::isValidPresetFile(const std::string& filePath) const {
 }
 
 void PresetDatabase::updateStatistics() const {
-    stats_.totalPresets = presets_.size();
-    stats_.totalCategories = getAllCategories().size();
-    stats_.totalAuthors = getAllAuthors().size();
-    stats_.totalFavorites = favoriteIndex_.size();
+    // Called with dataMutex_ held
+    stats_.totalPresets = store_.size();
+    stats_.totalCategories = store_.categoryCount();
+    stats_.totalAuthors = store_.authorCount();
+    stats_.totalFavorites = store_.favorites().size;
     
     if (cacheHits_ + cacheMisses_ > 0) {
         stats_.cacheHitRate = (cacheHits_ * 100) / (cacheHits_ + cacheMisses_);
@@ -291,6 +291,12 @@ void PresetLogger::log(LogLevel level, LogCategory category, const std::string&
     processLogEntry(entry);
 }
 
+void PresetLogger::log(const LogEntry& entry) {
+    if (entry.level < globalLevel_) return;
+
+    processLogEntry(entry);
+}
+
 void PresetLogger::logPerformance(LogCategory category, const std::string& operation,
                                  std::chrono::microseconds duration, size_t memoryUsage,
                                  const std::string& function, const std::string& file, int line) {
@@ -118,6 +118,9 @@ void PresetSaveDialog::render(DisplayManager* display) {
 bool PresetSaveDialog::handleInput(const InputEvent& event) {
     if (!visible_ || !enabled_) return false;
     
+    // Keys and touches change fields, focus or button states
+    markDirty();
+    
     // Handle keyboard input for text fields
     if (event.type == InputEvent::Type::KeyPress) {
         // Tab to cycle focus
@@ -247,6 +250,7 @@ bool PresetSaveDialog::handleInput(const InputEvent& event) {
 
 void PresetSaveDialog::show() {
     visible_ = true;
+    markDirty();
     
     // Initialize inputs with current preset data if available
     if (presetManager_) {
@@ -287,6 +291,7 @@ void PresetSaveDialog::show() {
 
 void PresetSaveDialog::hide() {
     visible_ = false;
+    markDirty();
 }
 
 bool PresetSaveDialog::isVisible() const {
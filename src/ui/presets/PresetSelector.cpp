@@ -53,13 +53,18 @@ void PresetSelector::render(DisplayManager* display) {
                      "Save", nullptr, Color(200, 200, 200));
     
     // Preset name
-    std::string presetName = presetManager_ ? presetManager_->getCurrentPresetName() : "No Preset";
+    displayedName_ = presetManager_ ? presetManager_->getCurrentPresetName() : "No Preset";
     display->drawText(absX + nameArea_.x + 10, absY + nameArea_.y + nameArea_.height/2 - 8,
-                     presetName, nullptr, Color(200, 200, 200));
+                     displayedName_, nullptr, Color(200, 200, 200));
 }
 
 void PresetSelector::update(float deltaTime) {
-    // Nothing to update in this component
+    // The current preset can change from elsewhere (MIDI program change,
+    // browser); repaint when the name we show is out of date
+    std::string presetName = presetManager_ ? presetManager_->getCurrentPresetName() : "No Preset";
+    if (presetName != displayedName_) {
+        markDirty();
+    }
 }
 
 bool PresetSelector::handleInput(const InputEvent& event) {
@@ -79,16 +84,19 @@ bool PresetSelector::handleInput(const InputEvent& event) {
             // Previous button
             if (prevButtonArea_.contains(Point(relX, relY))) {
                 prevButtonPressed_ = true;
+                markDirty();
                 return true;
             }
             // Next button
             else if (nextButtonArea_.contains(Point(relX, relY))) {
                 nextButtonPressed_ = true;
+                markDirty();
                 return true;
             }
             // Save button
             else if (saveButtonArea_.contains(Point(relX, relY))) {
                 saveButtonPressed_ = true;
+                markDirty();
                 return true;
             }
             break;
@@ -111,6 +119,7 @@ bool PresetSelector::handleInput(const InputEvent& event) {
             prevButtonPressed_ = false;
             nextButtonPressed_ = false;
             saveButtonPressed_ = false;
+            markDirty();
             return true;
             
         default: